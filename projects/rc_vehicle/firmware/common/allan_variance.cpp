@@ -0,0 +1,321 @@
+#include "allan_variance.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "config.hpp"
+
+namespace rc_vehicle {
+
+namespace {
+
+// σ_bias-плато = B · √(2 ln 2 / π)
+constexpr double kBiasPlateau = 0.66428247;
+constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+constexpr double kGravity = 9.80665;
+
+// Локальный наклон log σ по log τ: центральная разность, на краях —
+// односторонняя
+double LocalSlope(std::span<const AllanPoint> c, size_t i) {
+  const size_t lo = i > 0 ? i - 1 : i;
+  const size_t hi = i + 1 < c.size() ? i + 1 : i;
+  if (lo == hi) return 0.0;
+  return std::log(c[hi].adev / c[lo].adev) /
+         std::log(c[hi].tau_s / c[lo].tau_s);
+}
+
+}  // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Пакетный расчёт
+// ─────────────────────────────────────────────────────────────────────────────
+
+std::vector<size_t> AllanClusterSizes(size_t n, unsigned points_per_decade) {
+  std::vector<size_t> out;
+  if (n < 3) return out;
+  const size_t m_max = (n - 1) / 2;
+  const double step = 1.0 / std::max(1u, points_per_decade);
+  for (double e = 0.0;; e += step) {
+    const auto m = static_cast<size_t>(std::llround(std::pow(10.0, e)));
+    if (m > m_max) break;
+    if (out.empty() || m > out.back()) out.push_back(m);
+  }
+  return out;
+}
+
+void AllanPhase(std::span<const float> y, std::vector<double>& out) {
+  out.resize(y.size() + 1);
+  double mean = 0.0;
+  for (float v : y) mean += v;
+  mean = y.empty() ? 0.0 : mean / static_cast<double>(y.size());
+  double acc = 0.0;
+  out[0] = 0.0;
+  for (size_t i = 0; i < y.size(); ++i) {
+    acc += static_cast<double>(y[i]) - mean;
+    out[i + 1] = acc;
+  }
+}
+
+AllanSum OverlappingAllanSum(std::span<const double> theta,
+                             size_t m) noexcept {
+  AllanSum s;
+  if (theta.empty() || m == 0) return s;
+  const size_t n = theta.size() - 1;
+  if (2 * m > n) return s;
+  const size_t count = n - 2 * m + 1;
+  const double* t = theta.data();
+  double sum = 0.0;
+  for (size_t k = 0; k < count; ++k) {
+    const double d = t[k + 2 * m] - 2.0 * t[k + m] + t[k];
+    sum += d * d;
+  }
+  s.sum_sq = sum;
+  s.terms = count;
+  return s;
+}
+
+AllanPoint AllanPointFromSum(const AllanSum& sum, size_t m, double tau0) {
+  AllanPoint p;
+  p.tau_s = static_cast<double>(m) * tau0;
+  p.terms = sum.terms;
+  if (sum.terms > 0) {
+    const double md = static_cast<double>(m);
+    p.adev = std::sqrt(sum.sum_sq /
+                       (2.0 * md * md * static_cast<double>(sum.terms)));
+  }
+  return p;
+}
+
+std::vector<AllanPoint> OverlappingAdev(std::span<const float> y, double tau0,
+                                        unsigned points_per_decade) {
+  std::vector<double> theta;
+  AllanPhase(y, theta);
+  std::vector<AllanPoint> out;
+  for (size_t m : AllanClusterSizes(y.size(), points_per_decade)) {
+    out.push_back(AllanPointFromSum(OverlappingAllanSum(theta, m), m, tau0));
+  }
+  return out;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Подгонка
+// ─────────────────────────────────────────────────────────────────────────────
+
+AllanNoiseFit FitAllanNoise(std::span<const AllanPoint> curve) {
+  AllanNoiseFit fit;
+  std::vector<AllanPoint> c;
+  c.reserve(curve.size());
+  for (const AllanPoint& p : curve) {
+    if (p.tau_s > 0.0 && p.adev > 0.0) c.push_back(p);
+  }
+  if (c.size() < 3) return fit;
+  fit.valid = true;
+
+  size_t imin = 0;
+  for (size_t i = 1; i < c.size(); ++i) {
+    if (c[i].adev < c[imin].adev) imin = i;
+  }
+  fit.bias_instability = c[imin].adev / kBiasPlateau;
+  fit.tau_bias_s = c[imin].tau_s;
+  fit.bias_at_end = imin + 1 == c.size();
+
+  double log_sum = 0.0;
+  size_t count = 0;
+  for (size_t i = 0; i <= imin; ++i) {
+    const double slope = LocalSlope(c, i);
+    if (slope >= -0.75 && slope <= -0.25) {
+      log_sum += std::log(c[i].adev * std::sqrt(c[i].tau_s));
+      ++count;
+    }
+  }
+  if (count > 0) {
+    fit.arw = std::exp(log_sum / static_cast<double>(count));
+    fit.arw_from_slope = true;
+  } else {
+    fit.arw = c[0].adev * std::sqrt(c[0].tau_s);
+  }
+
+  log_sum = 0.0;
+  count = 0;
+  for (size_t i = imin + 1; i < c.size(); ++i) {
+    const double slope = LocalSlope(c, i);
+    if (slope >= 0.25 && slope <= 0.75) {
+      log_sum += std::log(c[i].adev * std::sqrt(3.0 / c[i].tau_s));
+      ++count;
+    }
+  }
+  if (count > 0) {
+    fit.rrw = std::exp(log_sum / static_cast<double>(count));
+    fit.has_rrw = true;
+  }
+  return fit;
+}
+
+double AllanWhiteSigma(const AllanNoiseFit& fit, double dt) noexcept {
+  return dt > 0.0 ? fit.arw / std::sqrt(dt) : 0.0;
+}
+
+NoiseTuning SuggestNoiseTuning(const ImuNoiseFits& fits, double filter_dt_s,
+                               double mag_dt_s) {
+  NoiseTuning t;
+  t.gyro_valid = std::all_of(fits.gyro_dps.begin(), fits.gyro_dps.end(),
+                             [](const AllanNoiseFit& f) { return f.valid; });
+  if (t.gyro_valid) {
+    const double sigma_z =
+        AllanWhiteSigma(fits.gyro_dps[2], filter_dt_s) * kDegToRad;
+    t.r_gz = static_cast<float>(sigma_z * sigma_z);
+    double omega = 0.0;
+    for (const AllanNoiseFit& f : fits.gyro_dps) {
+      const double w = AllanWhiteSigma(f, filter_dt_s);
+      omega += std::sqrt(w * w + f.bias_instability * f.bias_instability);
+    }
+    omega = omega / 3.0 * kDegToRad;
+    t.madgwick_beta = static_cast<float>(std::sqrt(0.75) * omega);
+  }
+
+  t.accel_valid = fits.accel_g[0].valid && fits.accel_g[1].valid;
+  if (t.accel_valid) {
+    const double na =
+        0.5 * (fits.accel_g[0].arw + fits.accel_g[1].arw) * kGravity;
+    t.q_v_floor = static_cast<float>(filter_dt_s * na * na);
+  }
+
+  t.heading_valid = fits.mag_horizontal_mg > 0.0 && fits.mag_xy_mg[0].valid &&
+                    fits.mag_xy_mg[1].valid;
+  if (t.heading_valid) {
+    const double sigma_m = 0.5 * (AllanWhiteSigma(fits.mag_xy_mg[0], mag_dt_s) +
+                                  AllanWhiteSigma(fits.mag_xy_mg[1], mag_dt_s));
+    const double r = sigma_m / fits.mag_horizontal_mg;
+    t.r_heading = static_cast<float>(r * r);
+  }
+  return t;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AllanAccumulator
+// ─────────────────────────────────────────────────────────────────────────────
+
+void AllanAccumulator::Add(float y) noexcept {
+  if (!has_offset_) {
+    offset_ = y;
+    has_offset_ = true;
+  }
+  ++samples_;
+  Push(0, y - offset_);
+}
+
+void AllanAccumulator::Push(size_t level, float y) noexcept {
+  // Каскад вверх: пара кластеров уровня k → один кластер уровня k+1
+  for (; level < kLevels; ++level) {
+    Level& l = levels_[level];
+    if (l.has_prev) {
+      const float d = y - l.prev;
+      ++l.terms;
+      l.avar += (0.5f * d * d - l.avar) / static_cast<float>(l.terms);
+    }
+    l.prev = y;
+    l.has_prev = true;
+    if (!l.has_pending) {
+      l.pending = y;
+      l.has_pending = true;
+      return;
+    }
+    l.has_pending = false;
+    y = 0.5f * (l.pending + y);
+  }
+}
+
+void AllanAccumulator::Break() noexcept {
+  for (Level& l : levels_) {
+    l.has_pending = false;
+    l.has_prev = false;
+  }
+}
+
+void AllanAccumulator::Reset() noexcept { *this = AllanAccumulator{}; }
+
+size_t AllanAccumulator::Curve(double tau0, uint32_t min_terms,
+                               std::span<AllanPoint> out) const {
+  size_t n = 0;
+  for (size_t k = 0; k < kLevels && n < out.size(); ++k) {
+    const Level& l = levels_[k];
+    if (l.terms < std::max<uint32_t>(min_terms, 1) || l.avar <= 0.0f) {
+      continue;
+    }
+    out[n].tau_s = tau0 * static_cast<double>(1u << k);
+    out[n].adev = std::sqrt(static_cast<double>(l.avar));
+    out[n].terms = l.terms;
+    ++n;
+  }
+  return n;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AllanNoiseMonitor
+// ─────────────────────────────────────────────────────────────────────────────
+
+void AllanNoiseMonitor::Update(const AllanSample& s, uint32_t now_ms) {
+  using Cfg = config::AllanConfig;
+  if (reset_requested_.exchange(false, std::memory_order_acq_rel)) {
+    for (AllanAccumulator& a : acc_) a.Reset();
+    parked_ = false;
+    feeding_ = false;
+  }
+
+  if (!s.parked) {
+    if (feeding_) {
+      for (AllanAccumulator& a : acc_) a.Break();
+    }
+    parked_ = false;
+    feeding_ = false;
+  } else {
+    if (!parked_) {
+      parked_ = true;
+      parked_since_ms_ = now_ms;
+    }
+    // Успокоение после остановки: качание на подвеске — не шум датчика
+    if (!feeding_ && now_ms - parked_since_ms_ >= Cfg::kSettleMs) {
+      feeding_ = true;
+    }
+    if (feeding_) {
+      for (size_t i = 0; i < 3; ++i) {
+        acc_[i].Add(s.gyro_dps[i]);
+        acc_[3 + i].Add(s.accel_g[i]);
+      }
+    }
+  }
+
+  if (now_ms - last_publish_ms_ >= Cfg::kPublishIntervalMs) Publish(now_ms);
+}
+
+void AllanNoiseMonitor::Publish(uint32_t now_ms) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  published_ = acc_;
+  published_parked_ = feeding_;
+  last_publish_ms_ = now_ms;
+}
+
+void AllanNoiseMonitor::GetReport(AllanReport& out) const {
+  using Cfg = config::AllanConfig;
+  {
+    // Кривые — прямо из опубликованной копии: без второй копии на стеке
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < AllanReport::kAxes; ++i) {
+      out.points[i] = published_[i].Curve(tau0_, Cfg::kMinTerms, out.curves[i]);
+    }
+    out.parked_s = static_cast<double>(published_[0].Samples()) * tau0_;
+    out.parked_now = published_parked_;
+  }
+  ImuNoiseFits fits;
+  for (size_t i = 0; i < AllanReport::kAxes; ++i) {
+    out.fits[i] = FitAllanNoise(
+        std::span<const AllanPoint>(out.curves[i].data(), out.points[i]));
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    fits.gyro_dps[i] = out.fits[i];
+    fits.accel_g[i] = out.fits[3 + i];
+  }
+  out.tuning = SuggestNoiseTuning(fits, tau0_, 0.0);
+}
+
+}  // namespace rc_vehicle
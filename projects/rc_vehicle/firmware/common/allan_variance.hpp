@@ -0,0 +1,265 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+/**
+ * @file allan_variance.hpp
+ * @brief Дисперсия Аллана для характеристики шумов IMU и магнитометра:
+ *        пакетный расчёт (хост, imu_allan), инкрементальный (устройство,
+ *        на стоянке), подгонка ARW / bias instability / RRW и перевод в
+ *        параметры шума EKF и beta Madgwick.
+ */
+
+namespace rc_vehicle {
+
+/** Точка кривой: σ(τ) в единицах входного сигнала. */
+struct AllanPoint {
+  double tau_s{0.0};
+  double adev{0.0};
+  uint64_t terms{0};  ///< Слагаемых в оценке (доверие к точке)
+};
+
+// ═════════════════════════════════════════════════════════════════════════════
+// Пакетный перекрывающийся расчёт
+// ═════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Размеры кластеров m ∈ [1, (n − 1) / 2], логарифмически по
+ *        points_per_decade на декаду, без повторов.
+ *
+ * Одна точка кривой — O(n), поэтому вся кривая — O(n log n).
+ */
+std::vector<size_t> AllanClusterSizes(size_t n, unsigned points_per_decade);
+
+/**
+ * @brief Фаза θ[k] = Σ_{i<k} (y[i] − ȳ) для перекрывающейся оценки.
+ *
+ * Среднее вычитается до суммирования: на многочасовой записи с
+ * постоянным смещением гироскопа иначе теряются младшие разряды
+ * в разностях θ. out: n + 1 значение (θ[0] = 0), в единицах y·отсчёт.
+ */
+void AllanPhase(std::span<const float> y, std::vector<double>& out);
+
+/** Сумма квадратов вторых разностей фазы и их число для одного m. */
+struct AllanSum {
+  double sum_sq{0.0};
+  uint64_t terms{0};
+};
+
+/**
+ * @brief Σ (θ[k+2m] − 2θ[k+m] + θ[k])² по k ∈ [0, n − 2m], n = theta.size()−1
+ *
+ * Суммы нескольких непрерывных участков складываются (разрыв записи не
+ * попадает в разности); AVAR = sum_sq / (2 m² · terms) в единицах y².
+ */
+AllanSum OverlappingAllanSum(std::span<const double> theta, size_t m) noexcept;
+
+/** σ(τ) по сумме: tau0 — шаг отсчётов [с]. */
+AllanPoint AllanPointFromSum(const AllanSum& sum, size_t m, double tau0);
+
+/** Кривая одного непрерывного ряда (однопоточно). */
+std::vector<AllanPoint> OverlappingAdev(std::span<const float> y, double tau0,
+                                        unsigned points_per_decade);
+
+// ═════════════════════════════════════════════════════════════════════════════
+// Подгонка шумовых составляющих
+// ═════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Коэффициенты по наклонам log σ — log τ (IEEE Std 952).
+ *
+ * - N (ARW, наклон −½): σ·√τ, среднее геометрическое по точкам с
+ *   локальным наклоном в [−¾, −¼]; нет таких — по первой точке.
+ * - B (bias instability, наклон 0): min σ / √(2 ln 2 / π).
+ * - K (RRW, наклон +½): σ·√(3/τ) по точкам правее минимума с наклоном в
+ *   [¼, ¾]; для коротких записей недоступен.
+ */
+struct AllanNoiseFit {
+  double arw{0.0};               ///< N [ед·√с] = [ед/√Гц]
+  double bias_instability{0.0};  ///< B [ед]
+  double tau_bias_s{0.0};        ///< τ минимума σ
+  double rrw{0.0};               ///< K [ед/√с]
+  bool arw_from_slope{false};    ///< false — N по первой точке (оценка)
+  bool bias_at_end{false};       ///< Минимум — последняя точка: B завышен
+  bool has_rrw{false};
+  bool valid{false};             ///< Хотя бы 3 точки кривой
+};
+
+AllanNoiseFit FitAllanNoise(std::span<const AllanPoint> curve);
+
+/** Белый шум одного отсчёта с шагом dt [с]: N / √dt. */
+double AllanWhiteSigma(const AllanNoiseFit& fit, double dt) noexcept;
+
+// ═════════════════════════════════════════════════════════════════════════════
+// Параметры фильтров по шумам
+// ═════════════════════════════════════════════════════════════════════════════
+
+/** Подгонки по осям; единицы — как в логе (dps, g, mG). */
+struct ImuNoiseFits {
+  std::array<AllanNoiseFit, 3> gyro_dps{};
+  std::array<AllanNoiseFit, 3> accel_g{};
+  std::array<AllanNoiseFit, 2> mag_xy_mg{};  ///< Для r_heading
+  double mag_horizontal_mg{0.0};  ///< |B| в плоскости XY (среднее); 0 — нет
+};
+
+/**
+ * @brief Рекомендуемые значения (config patch).
+ *
+ * - r_gz = (σ_gz на шаге EKF)² [рад²/с²].
+ * - madgwick_beta = √(¾)·ω_β, ω_β — средняя по осям ошибка гироскопа на
+ *   шаге фильтра: √(σ_белый² + B²) [рад/с] (Madgwick, 2010).
+ * - q_v_floor = dt·N_a² [м²/с²] — вклад шума акселерометра в шаг
+ *   предсказания vx/vy; нижняя граница q_vx/q_vy (остальное — ошибка
+ *   модели, её Allan не видит).
+ * - r_heading = (σ_mxy / |B_xy|)² [рад²] на шаге магнитометра.
+ */
+struct NoiseTuning {
+  float r_gz{0.0f};
+  float madgwick_beta{0.0f};
+  float q_v_floor{0.0f};
+  float r_heading{0.0f};
+  bool gyro_valid{false};
+  bool accel_valid{false};
+  bool heading_valid{false};
+};
+
+/**
+ * @param filter_dt_s Шаг EKF / Madgwick (ControlLoopConfig::kPeriodMs)
+ * @param mag_dt_s    Шаг магнитометра (ImuConfig::kMagReadIntervalMs)
+ */
+NoiseTuning SuggestNoiseTuning(const ImuNoiseFits& fits, double filter_dt_s,
+                               double mag_dt_s);
+
+// ═════════════════════════════════════════════════════════════════════════════
+// Инкрементальный расчёт (устройство)
+// ═════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Октавный каскад: m = 1, 2, 4, …, 2^(kLevels−1), O(1) на отсчёт
+ *        в среднем, память O(kLevels).
+ *
+ * Среднее кластера уровня k+1 — среднее двух соседних кластеров уровня k;
+ * на каждом уровне копится среднее ½(ȳ_{i+1} − ȳ_i)² (неперекрывающаяся
+ * оценка: дисперсия точки выше, чем у пакетной, та же подгонка). Суммы —
+ * во float, поэтому от входа вычитается первый отсчёт, а квадраты
+ * усредняются (без роста модуля).
+ */
+class AllanAccumulator {
+ public:
+  static constexpr size_t kLevels = 20;  ///< τ_max = τ0·2^19 (≈17 мин @2 мс)
+
+  /** Новый отсчёт; следующий — через tau0 после него. */
+  void Add(float y) noexcept;
+
+  /** Разрыв ряда (машина поехала): незавершённые кластеры отбрасываются,
+   *  накопленные оценки сохраняются. */
+  void Break() noexcept;
+
+  void Reset() noexcept;
+
+  /** AVAR уровня k и число разностей в ней. */
+  [[nodiscard]] float Avar(size_t level) const noexcept {
+    return levels_[level].avar;
+  }
+  [[nodiscard]] uint32_t Terms(size_t level) const noexcept {
+    return levels_[level].terms;
+  }
+  [[nodiscard]] uint64_t Samples() const noexcept { return samples_; }
+
+  /**
+   * @brief Кривая по уровням с terms ≥ min_terms
+   * @return Число записанных точек (≤ out.size())
+   */
+  size_t Curve(double tau0, uint32_t min_terms,
+               std::span<AllanPoint> out) const;
+
+ private:
+  struct Level {
+    float pending{0.0f};  ///< Первый кластер незавершённой пары
+    float prev{0.0f};     ///< Предыдущий кластер (для разности)
+    float avar{0.0f};     ///< Среднее ½·d²
+    uint32_t terms{0};
+    bool has_pending{false};
+    bool has_prev{false};
+  };
+
+  void Push(size_t level, float y) noexcept;
+
+  std::array<Level, kLevels> levels_{};
+  float offset_{0.0f};
+  bool has_offset_{false};
+  uint64_t samples_{0};
+};
+
+// ═════════════════════════════════════════════════════════════════════════════
+// AllanNoiseMonitor
+// ═════════════════════════════════════════════════════════════════════════════
+
+/** Вход одного тика control loop. */
+struct AllanSample {
+  float gyro_dps[3]{};
+  float accel_g[3]{};
+  bool parked{false};  ///< Стоит, газа нет, авто-манёвр не идёт
+};
+
+/** Снимок для WS get_allan (~3 КБ: заполняется по ссылке, не на стеке). */
+struct AllanReport {
+  static constexpr size_t kAxes = 6;  ///< gx gy gz ax ay az
+  std::array<std::array<AllanPoint, AllanAccumulator::kLevels>, kAxes>
+      curves{};
+  std::array<size_t, kAxes> points{};
+  std::array<AllanNoiseFit, kAxes> fits{};
+  NoiseTuning tuning{};
+  double parked_s{0.0};  ///< Накоплено отсчётов на стоянке, с
+  bool parked_now{false};
+};
+
+/**
+ * @brief Инкрементальная характеристика шумов на стоянке.
+ *
+ * Update() — каждый тик control loop: на стоянке (после
+ * AllanConfig::kSettleMs неподвижности) отсчёты gx..az идут в
+ * AllanAccumulator, при движении — Break(). Раз в kPublishIntervalMs
+ * оценки уровней копируются под мьютекс; GetReport() строит по копии
+ * кривые и подгонку в вызывающей задаче.
+ *
+ * Потоки: Update() — только control loop; GetReport(), RequestReset() —
+ * из любой задачи.
+ */
+class AllanNoiseMonitor {
+ public:
+  explicit AllanNoiseMonitor(double tau0_s) noexcept : tau0_(tau0_s) {}
+  AllanNoiseMonitor(const AllanNoiseMonitor&) = delete;
+  AllanNoiseMonitor& operator=(const AllanNoiseMonitor&) = delete;
+
+  void Update(const AllanSample& s, uint32_t now_ms);
+
+  void GetReport(AllanReport& out) const;
+
+  void RequestReset() noexcept {
+    reset_requested_.store(true, std::memory_order_release);
+  }
+
+ private:
+  void Publish(uint32_t now_ms);
+
+  double tau0_;
+  std::array<AllanAccumulator, AllanReport::kAxes> acc_{};
+  uint32_t parked_since_ms_{0};
+  bool parked_{false};
+  bool feeding_{false};
+  uint32_t last_publish_ms_{0};
+  std::atomic<bool> reset_requested_{false};
+
+  mutable std::mutex mutex_;
+  std::array<AllanAccumulator, AllanReport::kAxes> published_{};
+  bool published_parked_{false};
+};
+
+}  // namespace rc_vehicle
@@ -47,14 +47,23 @@ AutoDriveOutput AutoDriveCoordinator::Update(const AutoDriveInput& input) {
   if (test_runner_.IsActive() && !input.rc_active) {
     out.active = true;
     test_runner_.Update(input.fwd_accel, input.accel_mag, input.gyro_z,
-                        input.dt_sec, out.throttle, out.steering);
+                        input.dt_sec, out.throttle, out.steering,
+                        input.speed_ms, input.slip_deg);
     if (test_runner_.IsFinished() && event_log_) {
       auto status = test_runner_.GetStatus();
-      TelemetryEventType t = (status.phase == TestRunner::Phase::Done)
-                                 ? TelemetryEventType::TestDone
-                                 : TelemetryEventType::TestFailed;
-      event_log_->Push({input.ts_ms, t,
-                        static_cast<uint8_t>(status.type)});
+      if (status.phase == TestRunner::Phase::Done) {
+        // Ключевые метрики — прямо в событии (полный набор: GetTestResult)
+        const ManeuverMetrics& m = test_runner_.GetResult().metrics;
+        const bool step = status.type == TestType::Step;
+        event_log_->Push(
+            {input.ts_ms, TelemetryEventType::TestDone,
+             static_cast<uint8_t>(status.type), {},
+             step ? m.step.overshoot_pct : m.yaw_rate_mean_dps,
+             step ? m.step.settling_time_s : m.speed_mean_ms});
+      } else {
+        event_log_->Push({input.ts_ms, TelemetryEventType::TestFailed,
+                          static_cast<uint8_t>(status.type)});
+      }
     }
     return out;
   }
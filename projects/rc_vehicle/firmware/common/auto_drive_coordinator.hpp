@@ -21,6 +21,7 @@ struct AutoDriveInput {
   float    cal_ay{0.0f};
   float    dt_sec{0.0f};
   float    speed_ms{0.0f};   ///< EKF speed [m/s] (0 если IMU недоступен)
+  float    slip_deg{0.0f};   ///< EKF slip angle [°] (метрики TestRunner)
   uint32_t ts_ms{0};         ///< Текущее время [мс] — для меток событий
   bool     rc_active{false};
   bool     imu_enabled{false};
@@ -99,6 +100,9 @@ class AutoDriveCoordinator {
   [[nodiscard]] TestRunner::Status GetTestStatus() const {
     return test_runner_.GetStatus();
   }
+  [[nodiscard]] const TestRunner::Result& GetTestResult() const {
+    return test_runner_.GetResult();
+  }
   [[nodiscard]] float GetTestMarker() const {
     return test_runner_.GetTestMarker();
   }
@@ -33,6 +33,8 @@ struct RcInputConfig {
  */
 struct ImuConfig {
   static constexpr uint32_t kReadIntervalMs = 2;  ///< Интервал чтения (500 Hz)
+  static constexpr uint32_t kMagReadIntervalMs =
+      10;  ///< Интервал чтения магнетометра (100 Hz, MMC5983 CMM)
   static constexpr uint32_t kCalibSamples =
       1000;  ///< Количество семплов для калибровки gyro
   static constexpr uint32_t kCalibFullSamples =
@@ -43,6 +45,28 @@ struct ImuConfig {
       0.1f;  ///< Порог движения акселерометра (g)
 };
 
+/**
+ * @brief Конфигурация двух IMU (IMU_DUAL в esp32_s3/main/config.hpp)
+ *
+ * Пороги согласия — по разности показаний за вычетом медленно оцениваемого
+ * постоянного смещения между датчиками (разные нули, оси в пределах
+ * монтажа). Запас на разную полосу (MPU DLPF / LSM ODR 416 Hz) и вибрацию.
+ */
+struct ImuFusionConfig {
+  static constexpr float kGyroToleranceDps =
+      15.0f;  ///< Расхождение гироскопов, выше — «не согласны»
+  static constexpr float kAccelToleranceG =
+      0.5f;  ///< Расхождение акселерометров
+  static constexpr uint16_t kVoteDropSamples =
+      100;  ///< Подряд проигранных голосований до отключения (200 мс)
+  static constexpr uint16_t kMaxReadFailures =
+      50;  ///< Подряд ошибок SPI до отключения датчика (100 мс)
+  static constexpr uint16_t kStuckSamples =
+      100;  ///< Подряд бит-в-бит одинаковых семплов — датчик завис
+  static constexpr float kOffsetAlpha =
+      0.002f;  ///< Шаг оценки смещения между датчиками (τ ≈ 1 с при 500 Hz)
+};
+
 /**
  * @brief Конфигурация телеметрии
  */
@@ -60,6 +84,13 @@ struct TelemetryLogConfig {
   static constexpr size_t kCapacityFrames = 60000;  ///< Ёмкость буфера (кадров) — 10 мин при 100 Hz, ~4.1 МБ PSRAM
   static constexpr size_t kMaxExportFrames =
       200;  ///< Макс. кадров для экспорта
+  static constexpr size_t kSinceMaxHttpFrames =
+      2000;  ///< log_since по HTTP: кадров за ответ (20 с при 100 Hz)
+  static constexpr size_t kSinceMaxWsFrames =
+      200;  ///< log_since по WS: кадров за бинарное сообщение (~27 КБ)
+  /// Разрыв в полном кольце — начать на 5 с новее oldest (запас от
+  /// писателя); после перезагрузки и Clear() не применяется
+  static constexpr size_t kSinceGapSkipFrames = 500;
 };
 
 /**
@@ -95,6 +126,10 @@ struct SlewRateConfig {
 struct DiagnosticsConfig {
   static constexpr uint32_t kIntervalMs =
       5000;  ///< Интервал вывода диагностики
+  /// Бюджет: сброс → первый тик control loop (Wi‑Fi AP, HTTP, инициализация
+  /// периферии). Превышение — Warning в логе и WARN информационной
+  /// проверки self-test "boot_time" (на AllPassed и OTA не влияет)
+  static constexpr uint32_t kBootBudgetMs = 3000;
 };
 
 /**
@@ -115,6 +150,121 @@ struct PwmConfig {
       50;  ///< Частота PWM (стандарт для RC servo)
 };
 
+/**
+ * @brief Фазы периодических задач control loop (rate groups, PeriodicJob)
+ *
+ * Периоды задач кратны 10 мс, тик — 2 мс: фазы с разными остатками по
+ * модулю 10 мс гарантируют, что на одном тике срабатывает не больше одной
+ * задачи (проверяется в test_rate_group.cpp). RC (20 мс) и PWM (20 мс)
+ * разведены на 10 мс внутри общего периода.
+ */
+struct RateGroupConfig {
+  static constexpr uint32_t kPwmPhaseMs = 0;      ///< PWM slew, 20 мс
+  static constexpr uint32_t kRcPollPhaseMs = 10;  ///< Опрос RC, 20 мс
+  static constexpr uint32_t kMagPhaseMs = 2;      ///< Магнетометр, 10 мс
+  static constexpr uint32_t kWsTelemPhaseMs = 4;  ///< WS телеметрия, 50 мс
+  static constexpr uint32_t kLogPhaseMs = 6;      ///< Кольцевой лог, 10 мс
+  static constexpr uint32_t kDiagPhaseMs = 8;     ///< Диагностика, 5000 мс
+  /// Применение оценок sysid, 5000 мс: в слоте диагностики, со сдвигом
+  static constexpr uint32_t kSysIdApplyPhaseMs = 1258;
+};
+
+/**
+ * @brief Бюджет shadow-стадии стабилизации (ShadowStabilizer)
+ *
+ * Доли считаются от периода control loop по ReadCycleCounter() и
+ * сглаживаются EWMA, чтобы редкие тяжёлые тики (WS-телеметрия) не
+ * сбрасывали стадию.
+ */
+struct ShadowConfig {
+  static constexpr uint32_t kCostBudgetPermille = 50;  ///< 5 % периода
+  static constexpr uint32_t kShedLoadPct = 80;  ///< Загрузка цикла с shadow
+  static constexpr uint32_t kShedHoldMs = 1000;  ///< Пауза после сброса
+  static constexpr float kEwmaAlpha = 0.125f;  ///< Сглаживание долей периода
+};
+
+/**
+ * @brief Онлайн-идентификация динамики (OnlineSysId)
+ *
+ * RLS обновляется раз в kDecimation тиков по средним окна (шаг 20 мс):
+ * модель первого порядка не различает субмиллисекундные детали, а стоимость
+ * тика падает в kDecimation раз. Память оценки ≈ 1 / (1 − kForgetting)
+ * шагов (≈ 4 с).
+ */
+struct SysIdConfig {
+  static constexpr uint32_t kDecimation = 10;  ///< Тиков на шаг RLS
+  static constexpr float kForgetting = 0.995f;
+  static constexpr float kInitialCovariance = 100.0f;
+  static constexpr float kMaxCovarianceTrace = 1.0e4f;
+  static constexpr float kExcitationAlpha = 0.02f;  ///< EWMA дисперсии входа
+  static constexpr float kMinSteerVar = 0.005f;     ///< Порог возбуждения руля
+  static constexpr float kMinThrottleVar = 0.002f;  ///< Порог возбуждения газа
+  static constexpr float kMinSpeedMs = 1.0f;  ///< Гейтинг идентификации руля
+  static constexpr uint32_t kMinUpdates = 100;  ///< Шагов RLS до валидности
+  static constexpr float kMaxPole = 0.995f;  ///< a ≥ — интегратор, не оценка
+  static constexpr uint32_t kApplyIntervalMs = 5000;  ///< Период применения
+  static constexpr float kApplyMaxStepFrac = 0.05f;  ///< Шаг применения ≤ 5 %
+};
+
+/**
+ * @brief Дисперсия Аллана: на стоянке (AllanNoiseMonitor) и imu_allan
+ */
+struct AllanConfig {
+  static constexpr uint32_t kSettleMs =
+      2000;  ///< Неподвижности до начала накопления
+  static constexpr uint32_t kPublishIntervalMs = 1000;  ///< Копия для WS
+  static constexpr uint32_t kMinTerms = 4;  ///< Разностей на точку кривой
+  static constexpr float kParkedMaxSpeedMs = 0.05f;  ///< Скорость EKF
+  static constexpr float kParkedMaxYawRateDps = 3.0f;  ///< |gz| отфильтр.
+  static constexpr float kParkedMaxThrottle = 0.02f;  ///< |газ| команды
+  static constexpr unsigned kPointsPerDecade = 10;  ///< Пакетная кривая
+};
+
+/**
+ * @brief Потоковые метрики тестовых манёвров (ManeuverAnalyzer)
+ */
+struct ManeuverConfig {
+  static constexpr float kSteadySkipSec = 0.5f;  ///< Переход в начале Cruise
+  static constexpr float kStepSteadyFrac = 0.3f;  ///< Хвост StepExec — уст.
+  static constexpr float kRiseLoFrac = 0.1f;      ///< Rise time: от 10 %
+  static constexpr float kRiseHiFrac = 0.9f;      ///< ... до 90 % амплитуды
+  static constexpr float kSettleBandFrac = 0.05f;  ///< Полоса settling ±5 %
+  static constexpr float kMinStepDps = 5.0f;  ///< Меньше — метрики не считаем
+  static constexpr float kLevelStepDps = 0.5f;  ///< Начальный шаг сетки уровней
+};
+
+/**
+ * @brief Конфигурация обновления прошивки по Wi‑Fi (POST /api/ota)
+ *
+ * Запись во флеш блокирует кэш (и выполнение из флеша) на время операции,
+ * поэтому образ пишется небольшими порциями из задачи с низким приоритетом
+ * с паузой после каждой порции.
+ */
+struct OtaConfig {
+  static constexpr uint32_t kMaxImageBytes =
+      1920u * 1024u;  ///< Размер слота ota_0 / ota_1 (partitions.csv)
+  static constexpr size_t kWriteChunkBytes =
+      1024;  ///< Порция esp_ota_write (4 страницы флеша)
+  static constexpr uint32_t kWritePauseMs =
+      5;  ///< Пауза после порции: не более ~200 KB/s записи
+  static constexpr size_t kStreamBufferBytes =
+      8192;  ///< Буфер HTTP-обработчик → задача OTA (сжатые данные)
+  static constexpr size_t kRecvChunkBytes = 1024;  ///< Порция httpd_req_recv
+  static constexpr uint32_t kPushTimeoutMs =
+      5000;  ///< Ожидание места в буфере (задача OTA не успевает писать)
+  static constexpr uint32_t kFinishTimeoutMs =
+      30000;  ///< Дозапись хвоста буфера + проверка образа (SHA-256)
+  static constexpr size_t kTaskStack = 4096;     ///< Стек задачи OTA
+  static constexpr uint8_t kTaskPriority = 1;    ///< Ниже всех, кроме idle
+  static constexpr float kMaxSpeedMs = 0.1f;     ///< «Стоит»: |v| EKF ниже
+  static constexpr float kMaxYawRateDps = 5.0f;  ///< ... и |gz| ниже
+  static constexpr uint32_t kConfirmDelayMs =
+      15000;  ///< Первая проверка нового образа (после авто-калибровки)
+  static constexpr uint32_t kConfirmRetryMs = 2000;  ///< Шаг повторных проверок
+  static constexpr uint8_t kConfirmAttempts =
+      5;  ///< Не прошёл ни разу — откат на предыдущий образ
+};
+
 /**
  * @brief Конфигурация UDP-стриминга телеметрии
  */
@@ -129,6 +279,80 @@ struct UdpTelemConfig {
   static constexpr uint8_t kDefaultHz = 100;           ///< Частота отправки по умолчанию
   static constexpr size_t kMaxCommandLen = 64;         ///< Макс. длина UDP-команды
   static constexpr uint8_t kPacketVersion = 1;         ///< Версия протокола пакета
+  static constexpr size_t kMaxUnicastTargets = 4;      ///< Unicast-получателей (JOIN)
+  static constexpr uint8_t kMulticastTtl = 1;          ///< TTL группы: не дальше подсети
+};
+
+/**
+ * @brief Конфигурация UDP-канала команд (udp_command.hpp)
+ */
+struct UdpCommandConfig {
+  static constexpr uint16_t kPort = 5557;  ///< Порт приёма команд газ/руль
+  static constexpr size_t kTaskStack = 3072;  ///< Стек задачи udp_cmd
+  static constexpr uint8_t kTaskPriority =
+      6;  ///< Выше httpd (5): выгрузка лога не задерживает команды
+  static constexpr uint32_t kResyncMs =
+      1000;  ///< Тишина дольше — принять любой seq (перезапуск клиента)
+};
+
+/**
+ * @brief Арены cJSON (json_arena.hpp): на задачу, сброс после запроса
+ */
+struct JsonArenaConfig {
+  static constexpr size_t kHttpdBytes =
+      16384;  ///< Задача httpd: ответы WS-команд и HTTP (get_stab_config)
+  static constexpr size_t kTelemetryBytes =
+      8192;  ///< Задача control loop: JSON телеметрии (20 Hz)
+};
+
+/**
+ * @brief Быстрая математика (fast_math.hpp) по месту вызова.
+ *
+ * false — std:: (бит-в-бит как раньше), true — полином с ошибкой не больше
+ * kFast*MaxErr*. Включать по одному, сверяя bench_filters и логи.
+ */
+struct FastMathConfig {
+  static constexpr bool kMadgwickInvSqrt =
+      false;  ///< Нормировка акселя/магнитометра/градиента Madgwick
+  static constexpr bool kEuler =
+      false;  ///< Madgwick::GetEulerRad (atan2, asin)
+  static constexpr bool kSlipAngle = false;  ///< VehicleEkf: β = atan2(vy, vx)
+  static constexpr bool kEkfSpeed = false;  ///< VehicleEkf::GetSpeedMs (√)
+  static constexpr bool kEkfHeadingWrap =
+      false;  ///< Обёртка инновации курса: atan2(sin, cos)
+  static constexpr bool kMagHeading = false;  ///< Курс по магнитометру (atan2)
+  static constexpr bool kLpfTan = false;  ///< tan в пересчёте коэффициентов LPF
+};
+
+/**
+ * @brief Статистический профилировщик PC (pc_sampler.hpp, pc_profile.hpp)
+ */
+struct PcProfilerConfig {
+  static constexpr uint32_t kDefaultHz =
+      997;  ///< Простое число: не в фазе с тиком FreeRTOS и циклом 500 Hz
+  static constexpr uint32_t kMaxHz = 5000;  ///< Потолок (ISR на каждое ядро)
+  static constexpr size_t kEntriesPerCore =
+      8192;  ///< Записей на ядро (36 Б: ~288 КБ PSRAM)
+  static constexpr int kIntrPriority =
+      3;  ///< Выше ISR уровня 1–2 (Wi-Fi, lwIP): их время видно как [isr]
+};
+
+/**
+ * @brief Монитор памяти: стеки задач и кучи (mem_monitor.hpp, mem_stats.hpp)
+ */
+struct MemMonitorConfig {
+  static constexpr uint32_t kIntervalMs = 2000;  ///< Период опроса
+  static constexpr uint32_t kLogIntervalMs =
+      60000;  ///< Период строки MEM в логе
+  static constexpr size_t kTaskStack = 4096;  ///< Стек задачи mem_mon
+  static constexpr uint32_t kStackMarginPct =
+      25;  ///< Запас к наблюдённому пику: непокрытые ветви кода
+  static constexpr uint32_t kStackGuardBytes =
+      512;  ///< Сверх запаса: кадр прерывания, логирование ошибок
+  static constexpr uint32_t kStackAlignBytes = 256;  ///< Шаг рекомендации
+  static constexpr uint32_t kMinStackBytes = 2048;  ///< Не советовать меньше
+  static constexpr uint32_t kLowStackFreeBytes =
+      512;  ///< Предупреждение: свободно меньше в стеке
 };
 
 }  // namespace rc_vehicle::config
\ No newline at end of file
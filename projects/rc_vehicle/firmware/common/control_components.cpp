@@ -9,67 +9,21 @@
 
 #include "cJSON.h"
 #include "config.hpp"
+#include "fast_math.hpp"
 #include "imu_calibration.hpp"
 #include "madgwick_filter.hpp"
+#include "telemetry_json.hpp"
 
 namespace rc_vehicle {
 
-// ═════════════════════════════════════════════════════════════════════════
-// RcInputHandler
-// ═════════════════════════════════════════════════════════════════════════
-
-void RcInputHandler::Update(uint32_t now_ms, [[maybe_unused]] uint32_t dt_ms) {
-  // Опрос RC с заданной частотой
-  if (now_ms - last_poll_ms_ < poll_interval_ms_) {
-    return;
-  }
-  last_poll_ms_ = now_ms;
-
-  // Получить команду от RC-приёмника
-  last_command_ = platform_.GetRc();
-  active_ = last_command_.has_value();
-}
-
-// ═════════════════════════════════════════════════════════════════════════
-// WifiCommandHandler
-// ═════════════════════════════════════════════════════════════════════════
-
-void WifiCommandHandler::Update(uint32_t now_ms,
-                                [[maybe_unused]] uint32_t dt_ms) {
-  // Попытаться получить команду из очереди
-  auto cmd = platform_.TryReceiveWifiCommand();
-  if (cmd) {
-    last_command_ = cmd;
-    last_cmd_ms_ = now_ms;
-  }
-  // Кэшируем active-состояние: стабильно в пределах одной итерации control loop
-  active_ = last_cmd_ms_ != 0 && (now_ms - last_cmd_ms_) < timeout_ms_;
-}
-
 // ═════════════════════════════════════════════════════════════════════════
 // ImuHandler
 // ═════════════════════════════════════════════════════════════════════════
 
-void ImuHandler::Update(uint32_t now_ms, [[maybe_unused]] uint32_t dt_ms) {
-  if (!enabled_) {
-    return;
-  }
-
-  // Чтение IMU с заданной частотой
-  if (now_ms - last_read_ms_ < read_interval_ms_) {
-    return;
-  }
-
-  const uint32_t prev_read_ms = last_read_ms_;
-  last_read_ms_ = now_ms;
-
-  // Прочитать данные IMU
-  auto imu_data = platform_.ReadImu();
-  if (!imu_data) {
-    return;
-  }
-
-  data_ = *imu_data;
+void ImuHandler::ProcessSample(const ImuData& imu,
+                               const std::optional<MagData>& mag,
+                               uint32_t now_ms, uint32_t prev_read_ms) {
+  data_ = imu;
 
   // Подача семпла в калибровку (если идёт сбор)
   calib_.FeedSample(data_);
@@ -107,17 +61,11 @@ void ImuHandler::Update(uint32_t now_ms, [[maybe_unused]] uint32_t dt_ms) {
                            : (static_cast<float>(now_ms - prev_read_ms) / 1000.0f);
   first_read_ = false;
 
-  // Читаем магнетометр на 100 Hz (MMC5983 CMM rate).
-  // I2C/SPI транзакция ~350 мкс — не читаем каждые 2 мс.
   bool new_mag_sample = false;
-  if ((now_ms - last_mag_read_ms_) >= kMagReadIntervalMs) {
-    last_mag_read_ms_ = now_ms;
-    const auto mag_opt = platform_.ReadMag();
-    if (mag_opt) {
-      mag_data_ = *mag_opt;
-      mag_enabled_ = true;
-      new_mag_sample = true;
-    }
+  if (mag) {
+    mag_data_ = *mag;
+    mag_enabled_ = true;
+    new_mag_sample = true;
   }
 
   if (mag_enabled_) {
@@ -148,11 +96,16 @@ void ImuHandler::Update(uint32_t now_ms, [[maybe_unused]] uint32_t dt_ms) {
         const float comp1 = px * cd.basis1[0] + py * cd.basis1[1] + pz * cd.basis1[2];
         const float comp2 = px * cd.basis2[0] + py * cd.basis2[1] + pz * cd.basis2[2];
 
-        const float h = std::atan2(comp2, comp1) * (180.f / 3.14159265f);
+        const float h =
+            Atan2<config::FastMathConfig::kMagHeading>(comp2, comp1) *
+            (180.f / 3.14159265f);
         heading_deg_ = (h < 0.f) ? h + 360.f : h;
       } else {
         // Нет калибровки — fallback: простой atan2 без проекции
-        const float h = std::atan2(mag_cal.my, mag_cal.mx) * (180.f / 3.14159265f);
+        const float h =
+            Atan2<config::FastMathConfig::kMagHeading>(mag_cal.my,
+                                                       mag_cal.mx) *
+            (180.f / 3.14159265f);
         heading_deg_ = (h < 0.f) ? h + 360.f : h;
       }
 
@@ -214,34 +167,44 @@ void ImuHandler::SetLpfCutoff(float cutoff_hz) {
 
 void TelemetryHandler::SendTelemetry(uint32_t now_ms,
                                      const TelemetrySnapshot& snap) {
-  if (now_ms - last_send_ms_ < send_interval_ms_) {
-    return;
+  if (PollSendDue(now_ms)) {
+    SendNow(snap);
   }
-  last_send_ms_ = now_ms;
+}
 
-  if (platform_.GetWebSocketClientCount() == 0) {
-    return;
+bool TelemetryHandler::PollSendDue(uint32_t now_ms) {
+  if (!send_job_.Poll(now_ms)) {
+    return false;
   }
+  return platform_.GetWebSocketClientCount() > 0;
+}
 
+void TelemetryHandler::SendNow(const TelemetrySnapshot& snap) {
   std::string json = BuildTelemJson(snap);
   platform_.SendTelem(json);
 }
 
 std::string TelemetryHandler::BuildTelemJson(
     const TelemetrySnapshot& snap) const {
+  JsonArenaScope arena(json_arena_);
   cJSON* root = cJSON_CreateObject();
   if (!root) return "{}";
 
   cJSON_AddStringToObject(root, "type", "telem");
   // Для совместимости: "mcu_pong_ok" = "контроллер жив"
   cJSON_AddBoolToObject(root, "mcu_pong_ok", true);
-  cJSON_AddNumberToObject(root, "uptime_ms", snap.uptime_ms);
+  AddLogFrameGroupToJson(root, snap.frame, TelemetryJsonGroup::Root);
 
   // Link status
   cJSON* link = cJSON_AddObjectToObject(root, "link");
   if (link) {
     cJSON_AddBoolToObject(link, "rc_ok", snap.rc_ok);
     cJSON_AddBoolToObject(link, "wifi_ok", snap.wifi_ok);
+    if (snap.wifi_source) {
+      cJSON_AddStringToObject(
+          link, "wifi_src",
+          *snap.wifi_source == WifiCommandSource::Udp ? "udp" : "ws");
+    }
     cJSON_AddBoolToObject(link, "failsafe", platform_.FailsafeIsActive());
   }
 
@@ -249,21 +212,14 @@ std::string TelemetryHandler::BuildTelemJson(
   if (snap.imu_enabled) {
     cJSON* imu = cJSON_AddObjectToObject(root, "imu");
     if (imu) {
-      cJSON_AddNumberToObject(imu, "ax", snap.imu_data.ax);
-      cJSON_AddNumberToObject(imu, "ay", snap.imu_data.ay);
-      cJSON_AddNumberToObject(imu, "az", snap.imu_data.az);
-      cJSON_AddNumberToObject(imu, "gx", snap.imu_data.gx);
-      cJSON_AddNumberToObject(imu, "gy", snap.imu_data.gy);
-      cJSON_AddNumberToObject(imu, "gz", snap.imu_data.gz);
-      cJSON_AddNumberToObject(imu, "gyro_z_filtered", snap.filtered_gz);
+      AddLogFrameGroupToJson(imu, snap.frame, TelemetryJsonGroup::Imu);
       cJSON_AddNumberToObject(imu, "forward_accel", snap.forward_accel);
 
       // Orientation (Madgwick)
       cJSON* orientation = cJSON_AddObjectToObject(imu, "orientation");
       if (orientation) {
-        cJSON_AddNumberToObject(orientation, "pitch", snap.pitch_deg);
-        cJSON_AddNumberToObject(orientation, "roll", snap.roll_deg);
-        cJSON_AddNumberToObject(orientation, "yaw", snap.yaw_deg);
+        AddLogFrameGroupToJson(orientation, snap.frame,
+                               TelemetryJsonGroup::Orientation);
       }
     }
 
@@ -322,11 +278,7 @@ std::string TelemetryHandler::BuildTelemJson(
     if (snap.mag_enabled) {
       cJSON* mag = cJSON_AddObjectToObject(root, "mag");
       if (mag) {
-        cJSON_AddNumberToObject(mag, "mx", snap.mag_data.mx);
-        cJSON_AddNumberToObject(mag, "my", snap.mag_data.my);
-        cJSON_AddNumberToObject(mag, "mz", snap.mag_data.mz);
-        cJSON_AddNumberToObject(mag, "heading_deg", snap.heading_deg);
-        cJSON_AddNumberToObject(mag, "heading_rel_deg", snap.heading_rel_deg);
+        AddLogFrameGroupToJson(mag, snap.frame, TelemetryJsonGroup::Mag);
       }
     }
 
@@ -334,14 +286,8 @@ std::string TelemetryHandler::BuildTelemJson(
     if (snap.ekf_available) {
       cJSON* ekf = cJSON_AddObjectToObject(root, "ekf");
       if (ekf) {
-        cJSON_AddNumberToObject(ekf, "vx", snap.ekf_vx);
-        cJSON_AddNumberToObject(ekf, "vy", snap.ekf_vy);
+        AddLogFrameGroupToJson(ekf, snap.frame, TelemetryJsonGroup::Ekf);
         cJSON_AddNumberToObject(ekf, "yaw_rate", snap.ekf_yaw_rate);
-        cJSON_AddNumberToObject(ekf, "slip_deg", snap.ekf_slip_deg);
-        cJSON_AddNumberToObject(ekf, "speed_ms", snap.ekf_speed_ms);
-        cJSON_AddNumberToObject(ekf, "vx_var", snap.ekf_vx_var);
-        cJSON_AddNumberToObject(ekf, "vy_var", snap.ekf_vy_var);
-        cJSON_AddNumberToObject(ekf, "r_var", snap.ekf_r_var);
       }
     }
 
@@ -349,7 +295,8 @@ std::string TelemetryHandler::BuildTelemJson(
     if (snap.oversteer_available) {
       cJSON* warn = cJSON_AddObjectToObject(root, "warn");
       if (warn) {
-        cJSON_AddBoolToObject(warn, "oversteer", snap.oversteer_active);
+        cJSON_AddBoolToObject(warn, "oversteer",
+                              snap.frame.oversteer_active > 0.5f);
       }
     }
   }
@@ -369,30 +316,49 @@ std::string TelemetryHandler::BuildTelemJson(
   if (snap.rc_ok) {
     cJSON* rc = cJSON_AddObjectToObject(root, "rc");
     if (rc) {
-      cJSON_AddNumberToObject(rc, "throttle", snap.rc_throttle);
-      cJSON_AddNumberToObject(rc, "steering", snap.rc_steering);
+      AddLogFrameGroupToJson(rc, snap.frame, TelemetryJsonGroup::Rc);
     }
   }
 
   // Commanded (до trim/slew)
   cJSON* cmd = cJSON_AddObjectToObject(root, "cmd");
   if (cmd) {
-    cJSON_AddNumberToObject(cmd, "throttle", snap.cmd_throttle);
-    cJSON_AddNumberToObject(cmd, "steering", snap.cmd_steering);
+    AddLogFrameGroupToJson(cmd, snap.frame, TelemetryJsonGroup::Cmd);
   }
 
   // Actuators (после trim/slew)
   cJSON* act = cJSON_AddObjectToObject(root, "act");
   if (act) {
-    cJSON_AddNumberToObject(act, "throttle", snap.throttle);
-    cJSON_AddNumberToObject(act, "steering", snap.steering);
+    AddLogFrameGroupToJson(act, snap.frame, TelemetryJsonGroup::Act);
+  }
+
+  // Shadow-стадия стабилизации (только при заданном кандидате)
+  if (snap.frame.shadow_state != 0) {
+    cJSON* shadow = cJSON_AddObjectToObject(root, "shadow");
+    if (shadow) {
+      AddLogFrameGroupToJson(shadow, snap.frame, TelemetryJsonGroup::Shadow);
+    }
+  }
+
+  // Онлайн-идентификация: оценки руль → yaw rate и газ → скорость
+  if (snap.sysid_available) {
+    cJSON* sysid = cJSON_AddObjectToObject(root, "sysid");
+    if (sysid) {
+      const SysIdEstimate& e = snap.sysid;
+      cJSON_AddNumberToObject(sysid, "steer_gain_dps", e.steer_gain_dps);
+      cJSON_AddNumberToObject(sysid, "steer_tau_s", e.steer_tau_s);
+      cJSON_AddBoolToObject(sysid, "steer_valid", e.steer_valid);
+      cJSON_AddNumberToObject(sysid, "speed_gain_ms", e.speed_gain_ms);
+      cJSON_AddNumberToObject(sysid, "speed_tau_s", e.speed_tau_s);
+      cJSON_AddBoolToObject(sysid, "speed_valid", e.speed_valid);
+    }
   }
 
   char* str = cJSON_PrintUnformatted(root);
   cJSON_Delete(root);
   if (!str) return "{}";
   std::string result(str);
-  free(str);
+  cJSON_free(str);
   return result;
 }
 
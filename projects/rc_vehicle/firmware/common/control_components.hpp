@@ -5,10 +5,14 @@
 
 #include "config.hpp"
 #include "imu_calibration.hpp"
+#include "json_arena.hpp"
 #include "lpf_butterworth.hpp"
 #include "madgwick_filter.hpp"
 #include "mag_calibration.hpp"
 #include "mag_sensor.hpp"
+#include "online_sysid.hpp"
+#include "rate_group.hpp"
+#include "telemetry_log.hpp"
 #include "vehicle_control_platform.hpp"
 
 namespace rc_vehicle {
@@ -41,19 +45,37 @@ class ControlComponent {
  * Опрашивает RC-приёмник с заданной частотой и предоставляет
  * последнюю валидную команду управления.
  */
-class RcInputHandler : public ControlComponent {
+class RcInputHandler final : public ControlComponent {
  public:
   /**
    * @brief Конструктор
    * @param platform Платформа для доступа к RC-входу
    * @param poll_interval_ms Интервал опроса в миллисекундах (по умолчанию 20 ms
    * = 50 Hz)
+   * @param poll_phase_ms Фаза опроса (config::RateGroupConfig)
    */
   explicit RcInputHandler(VehicleControlPlatform& platform,
-                          uint32_t poll_interval_ms = 20)
-      : platform_(platform), poll_interval_ms_(poll_interval_ms) {}
+                          uint32_t poll_interval_ms = 20,
+                          uint32_t poll_phase_ms = 0)
+      : platform_(platform), poll_job_(poll_interval_ms, poll_phase_ms) {}
 
-  void Update(uint32_t now_ms, uint32_t dt_ms) override;
+  void Update(uint32_t now_ms, uint32_t dt_ms) override {
+    Poll(platform_, now_ms, dt_ms);
+  }
+
+  /**
+   * @brief Update() через статический тип платформы (ControlLoopProcessorT)
+   * @param platform Та же платформа, что передана в конструктор
+   */
+  template <ControlTickPlatform P>
+  void Poll(P& platform, uint32_t now_ms, [[maybe_unused]] uint32_t dt_ms) {
+    // Опрос RC в своём слоте rate group
+    if (!poll_job_.Poll(now_ms)) {
+      return;
+    }
+    last_command_ = platform.GetRc();
+    active_ = last_command_.has_value();
+  }
 
   /**
    * @brief Проверить, активен ли RC-вход
@@ -71,8 +93,7 @@ class RcInputHandler : public ControlComponent {
 
  private:
   VehicleControlPlatform& platform_;
-  uint32_t poll_interval_ms_;
-  uint32_t last_poll_ms_{0};
+  PeriodicJob poll_job_;
   bool active_{false};
   std::optional<RcCommand> last_command_;
 };
@@ -84,10 +105,12 @@ class RcInputHandler : public ControlComponent {
 /**
  * @brief Обработчик Wi-Fi команд
  *
- * Получает команды из очереди WebSocket и отслеживает их актуальность
- * (команды старше timeout_ms считаются устаревшими).
+ * Получает команды из очередей источников (WebSocket, UDP) и отслеживает
+ * актуальность каждого отдельно (команды старше timeout_ms устаревшие).
+ * Если свежи оба, побеждает UDP: по WebSocket (TCP) после потери сегмента
+ * приходит пачка задержанных команд, которые старше UDP-команды.
  */
-class WifiCommandHandler : public ControlComponent {
+class WifiCommandHandler final : public ControlComponent {
  public:
   /**
    * @brief Конструктор
@@ -98,28 +121,70 @@ class WifiCommandHandler : public ControlComponent {
                               uint32_t timeout_ms = 500)
       : platform_(platform), timeout_ms_(timeout_ms) {}
 
-  void Update(uint32_t now_ms, uint32_t dt_ms) override;
+  void Update(uint32_t now_ms, uint32_t dt_ms) override {
+    Poll(platform_, now_ms, dt_ms);
+  }
+
+  /** @brief Update() через статический тип платформы (ControlLoopProcessorT) */
+  template <ControlTickPlatform P>
+  void Poll(P& platform, uint32_t now_ms, [[maybe_unused]] uint32_t dt_ms) {
+    active_source_.reset();
+    // Порядок — приоритет: первый свежий источник выигрывает
+    for (WifiCommandSource src :
+         {WifiCommandSource::Udp, WifiCommandSource::WebSocket}) {
+      SourceState& s = sources_[static_cast<size_t>(src)];
+      // Попытаться получить команду из очереди
+      auto cmd = platform.TryReceiveWifiCommand(src);
+      if (cmd) {
+        s.last_command = cmd;
+        s.last_cmd_ms = now_ms;
+      }
+      // Кэшируем active-состояние: стабильно в пределах одной итерации
+      s.active = s.last_cmd_ms != 0 && (now_ms - s.last_cmd_ms) < timeout_ms_;
+      if (s.active && !active_source_) active_source_ = src;
+    }
+  }
 
   /**
    * @brief Проверить, активны ли Wi-Fi команды
    * @return true, если команда получена недавно (в пределах timeout)
    */
-  [[nodiscard]] bool IsActive() const noexcept { return active_; }
+  [[nodiscard]] bool IsActive() const noexcept {
+    return active_source_.has_value();
+  }
+
+  /** @brief Источник, команда которого используется (если активен) */
+  [[nodiscard]] std::optional<WifiCommandSource> GetActiveSource()
+      const noexcept {
+    return active_source_;
+  }
+
+  /** @brief Свежа ли команда источника src (независимо от приоритета) */
+  [[nodiscard]] bool IsSourceActive(WifiCommandSource src) const noexcept {
+    return sources_[static_cast<size_t>(src)].active;
+  }
 
   /**
    * @brief Получить последнюю команду
-   * @return Команда управления, если Wi-Fi активен
+   * @return Команда активного источника, если Wi-Fi активен
    */
   [[nodiscard]] std::optional<RcCommand> GetCommand() const {
-    return active_ ? last_command_ : std::nullopt;
+    return active_source_
+               ? sources_[static_cast<size_t>(*active_source_)].last_command
+               : std::nullopt;
   }
 
  private:
+  struct SourceState {
+    uint32_t last_cmd_ms{0};
+    bool active{false};
+    std::optional<RcCommand> last_command;
+  };
+
   VehicleControlPlatform& platform_;
   uint32_t timeout_ms_;
-  uint32_t last_cmd_ms_{0};
-  bool active_{false};
-  std::optional<RcCommand> last_command_;
+  SourceState sources_[kWifiCommandSourceCount];
+  std::optional<WifiCommandSource> active_source_;
 };
 
 // ═════════════════════════════════════════════════════════════════════════
@@ -134,7 +199,7 @@ class WifiCommandHandler : public ControlComponent {
  * и обновляет фильтр ориентации. Gyro Z фильтруется LPF Butterworth 2-го
  * порядка для последующего использования в ПИД контроля рыскания.
  */
-class ImuHandler : public ControlComponent {
+class ImuHandler final : public ControlComponent {
  public:
   /**
    * @brief Конструктор
@@ -154,7 +219,35 @@ class ImuHandler : public ControlComponent {
     lpf_gyro_z_.SetParams(config::LpfConfig::kDefaultCutoffHz, fs_hz);
   }
 
-  void Update(uint32_t now_ms, uint32_t dt_ms) override;
+  void Update(uint32_t now_ms, uint32_t dt_ms) override {
+    Poll(platform_, now_ms, dt_ms);
+  }
+
+  /**
+   * @brief Update() через статический тип платформы (ControlLoopProcessorT).
+   *
+   * Здесь только чтение датчиков; обработка семпла — ProcessSample().
+   */
+  template <ControlTickPlatform P>
+  void Poll(P& platform, uint32_t now_ms, [[maybe_unused]] uint32_t dt_ms) {
+    if (!enabled_ || now_ms - last_read_ms_ < read_interval_ms_) {
+      return;
+    }
+    const uint32_t prev_read_ms = last_read_ms_;
+    last_read_ms_ = now_ms;
+
+    const auto imu = platform.ReadImu();
+    if (!imu) {
+      return;
+    }
+    // Магнетометр на 100 Hz (MMC5983 CMM rate): транзакция ~350 мкс — не
+    // каждые 2 мс; фаза слота разнесена с PWM/логом/телеметрией
+    std::optional<MagData> mag;
+    if (mag_job_.Poll(now_ms)) {
+      mag = platform.ReadMag();
+    }
+    ProcessSample(*imu, mag, now_ms, prev_read_ms);
+  }
 
   /**
    * @brief Установить частоту среза LPF для gyro Z
@@ -232,6 +325,10 @@ class ImuHandler : public ControlComponent {
   void ResetHeadingRef() noexcept { heading_ref_set_ = false; }
 
  private:
+  /** Калибровка, LPF, курс и Madgwick для прочитанного семпла. */
+  void ProcessSample(const ImuData& imu, const std::optional<MagData>& mag,
+                     uint32_t now_ms, uint32_t prev_read_ms);
+
   VehicleControlPlatform& platform_;
   ImuCalibration& calib_;
   MadgwickFilter& filter_;
@@ -248,8 +345,8 @@ class ImuHandler : public ControlComponent {
   // Магнетометр (опционален)
   MagData mag_data_{};
   bool mag_enabled_{false};
-  uint32_t last_mag_read_ms_{0};
-  static constexpr uint32_t kMagReadIntervalMs = 10;  ///< 100 Hz
+  PeriodicJob mag_job_{config::ImuConfig::kMagReadIntervalMs,
+                       config::RateGroupConfig::kMagPhaseMs};
 
   // Калибровка магнитометра (не владеет)
   MagCalibration* mag_calib_{nullptr};
@@ -281,6 +378,7 @@ struct SensorSnapshot {
   // Wi-Fi
   bool wifi_active{false};
   std::optional<RcCommand> wifi_cmd;
+  std::optional<WifiCommandSource> wifi_source;
 
   // IMU
   bool imu_enabled{false};
@@ -301,28 +399,26 @@ struct SensorSnapshot {
 /**
  * @brief Снимок данных для телеметрии
  *
- * Заполняется в ControlTaskLoop() и передаётся в TelemetryHandler::SendTelemetry(),
- * устраняя прямые зависимости от отдельных компонентов.
+ * Заполняется в ControlLoopProcessor::UpdateTelemetry() за один проход и
+ * передаётся в TelemetryHandler::SendTelemetry(). Измеряемые величины лежат в
+ * frame (тот же кадр уходит в кольцевой лог и UDP без копирования в
+ * промежуточные поля), здесь — только флаги и данные, которых нет в логе.
  */
 struct TelemetrySnapshot {
+  /// Поля реестра RC_TELEMETRY_LOG_FIELDS (frame.ts_ms = uptime)
+  TelemetryLogFrame frame{};
+
   // Link status
   bool rc_ok{false};
   bool wifi_ok{false};
+  std::optional<WifiCommandSource> wifi_source;  ///< Источник при wifi_ok
 
   // IMU
   bool imu_enabled{false};
-  ImuData imu_data{};
-  float filtered_gz{0.0f};
   float forward_accel{0.0f};
-  float pitch_deg{0.0f};
-  float roll_deg{0.0f};
-  float yaw_deg{0.0f};
 
   // Магнетометр
   bool mag_enabled{false};
-  MagData mag_data{};
-  float heading_deg{0.f};      ///< Tilt-compensated heading [°, 0=N, 90=E]
-  float heading_rel_deg{0.f};  ///< Относительный курс [°, -180..180]
 
   // Calibration
   CalibStatus calib_status{CalibStatus::Idle};
@@ -332,40 +428,19 @@ struct TelemetrySnapshot {
 
   // EKF (имеет смысл только при imu_enabled)
   bool ekf_available{false};
-  float ekf_vx{0.0f};
-  float ekf_vy{0.0f};
-  float ekf_yaw_rate{0.0f};
-  float ekf_slip_deg{0.0f};
-  float ekf_speed_ms{0.0f};
+  float ekf_yaw_rate{0.0f};  ///< [рад/с]; в кадре лога — только yaw_rate_dps
 
-  // Oversteer (имеет смысл только при imu_enabled)
+  // Oversteer (имеет смысл только при imu_enabled; флаг — frame.oversteer_active)
   bool oversteer_available{false};
-  bool oversteer_active{false};
 
   // Kids Mode
   bool kids_mode_active{false};
   bool kids_anti_spin_active{false};
   float kids_throttle_limit{0.0f};
 
-  // RC input (сырые значения с пульта, до стабилизации)
-  float rc_throttle{0.0f};
-  float rc_steering{0.0f};
-
-  // Actuators (applied, после стабилизации/trim/slew rate)
-  float throttle{0.0f};
-  float steering{0.0f};
-
-  // Commanded (до trim/slew rate, после стабилизации)
-  float cmd_throttle{0.0f};
-  float cmd_steering{0.0f};
-
-  // EKF covariance (для оценки качества фильтра)
-  float ekf_vx_var{0.0f};
-  float ekf_vy_var{0.0f};
-  float ekf_r_var{0.0f};
-
-  // Uptime (ms since boot, for reboot diagnostics)
-  uint32_t uptime_ms{0};
+  // Онлайн-идентификация (только если OnlineSysId подключён)
+  bool sysid_available{false};
+  SysIdEstimate sysid{};
 };
 
 // ═════════════════════════════════════════════════════════════════════════
@@ -388,10 +463,11 @@ class TelemetryHandler {
    * @param platform Платформа для отправки телеметрии
    * @param send_interval_ms Интервал отправки в миллисекундах (по умолчанию 50
    * ms = 20 Hz)
+   * @param send_phase_ms Фаза отправки (config::RateGroupConfig)
    */
   TelemetryHandler(VehicleControlPlatform& platform,
-                   uint32_t send_interval_ms = 50)
-      : platform_(platform), send_interval_ms_(send_interval_ms) {}
+                   uint32_t send_interval_ms = 50, uint32_t send_phase_ms = 0)
+      : platform_(platform), send_job_(send_interval_ms, send_phase_ms) {}
 
   /**
    * @brief Отправить телеметрию с переданным снимком данных
@@ -400,10 +476,23 @@ class TelemetryHandler {
    */
   void SendTelemetry(uint32_t now_ms, const TelemetrySnapshot& snap);
 
+  /**
+   * @brief Наступил ли слот отправки и есть ли WS-клиенты.
+   *
+   * Позволяет строить снимок только на тиках отправки: при true вызвать
+   * SendNow(). Потребляет слот — на этом тике повторно вернёт false.
+   */
+  [[nodiscard]] bool PollSendDue(uint32_t now_ms);
+
+  /** @brief Отправить снимок без проверки интервала. */
+  void SendNow(const TelemetrySnapshot& snap);
+
  private:
   VehicleControlPlatform& platform_;
-  uint32_t send_interval_ms_;
-  uint32_t last_send_ms_{0};
+  PeriodicJob send_job_;
+  /// Узлы cJSON телеметрии: сдвиг указателя вместо ~100 malloc на кадр
+  mutable StaticBumpArena<config::JsonArenaConfig::kTelemetryBytes>
+      json_arena_;
 
   /**
    * @brief Построить JSON-строку с телеметрией
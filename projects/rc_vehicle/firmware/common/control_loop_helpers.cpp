@@ -43,6 +43,7 @@ SelfTestInput BuildSelfTestInput(const SelfTestContext& ctx) {
   SelfTestInput input;
 
   input.loop_hz = ctx.last_loop_hz.load(std::memory_order_relaxed);
+  input.boot_ms = ctx.boot_ms;
 
   if (ctx.imu_handler) {
     input.imu_enabled = ctx.imu_handler->IsEnabled();
@@ -42,6 +42,26 @@ inline bool SelectControlSource(const SensorSnapshot& sensors,
 // UpdatePwmWithSlewRate
 // ═════════════════════════════════════════════════════════════════════════
 
+/**
+ * Один шаг slew rate PWM за pwm_dt_ms. Вызывается в слоте PWM rate group
+ * (ControlLoopProcessor) — проверка интервала на стороне вызывающего.
+ */
+template <ControlTickPlatform P>
+inline void ApplyPwmSlewStep(P& platform, uint32_t pwm_dt_ms,
+                             float commanded_throttle,
+                             float commanded_steering, float& applied_throttle,
+                             float& applied_steering, float throttle_trim,
+                             float steering_trim, float slew_throttle_per_sec,
+                             float slew_steering_per_sec) {
+  applied_throttle = ApplySlewRate(commanded_throttle, applied_throttle,
+                                   slew_throttle_per_sec, pwm_dt_ms);
+  applied_steering = ApplySlewRate(commanded_steering, applied_steering,
+                                   slew_steering_per_sec, pwm_dt_ms);
+
+  platform.SetPwm(applied_throttle + throttle_trim,
+                  applied_steering + steering_trim);
+}
+
 /** Обновление PWM с ограничением скорости изменения (slew rate). */
 inline void UpdatePwmWithSlewRate(VehicleControlPlatform& platform,
                                   uint32_t now_ms, float commanded_throttle,
@@ -55,14 +75,10 @@ inline void UpdatePwmWithSlewRate(VehicleControlPlatform& platform,
   if (now_ms - last_pwm_update >= config::PwmConfig::kUpdateIntervalMs) {
     const uint32_t pwm_dt_ms = now_ms - last_pwm_update;
     last_pwm_update = now_ms;
-
-    applied_throttle = ApplySlewRate(commanded_throttle, applied_throttle,
-                                     slew_throttle_per_sec, pwm_dt_ms);
-    applied_steering = ApplySlewRate(commanded_steering, applied_steering,
-                                     slew_steering_per_sec, pwm_dt_ms);
-
-    platform.SetPwm(applied_throttle + throttle_trim,
-                    applied_steering + steering_trim);
+    ApplyPwmSlewStep(platform, pwm_dt_ms, commanded_throttle,
+                     commanded_steering, applied_throttle, applied_steering,
+                     throttle_trim, steering_trim, slew_throttle_per_sec,
+                     slew_steering_per_sec);
   }
 }
 
@@ -92,6 +108,7 @@ struct SelfTestContext {
   const TelemetryManager* telem_mgr;
   bool platform_exists;
   bool inited;
+  uint32_t boot_ms{0};  ///< Сброс → первый тик control loop
 };
 
 /** Построить SelfTestInput из текущего состояния подсистем. */
@@ -113,6 +130,7 @@ inline SensorSnapshot BuildSensorSnapshot(const RcInputHandler* rc_handler,
   s.wifi_active = wifi_handler && wifi_handler->IsActive();
   if (s.wifi_active) {
     s.wifi_cmd = wifi_handler->GetCommand();
+    s.wifi_source = wifi_handler->GetActiveSource();
   }
   s.imu_enabled = imu_handler && imu_handler->IsEnabled();
   if (s.imu_enabled) {
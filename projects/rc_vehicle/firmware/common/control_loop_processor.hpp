@@ -1,21 +1,36 @@
 #pragma once
 
 #include <atomic>
+#include <cmath>
+#include <concepts>
 #include <cstdint>
 
+#include "allan_variance.hpp"
 #include "auto_drive_coordinator.hpp"
 #include "calibration_manager.hpp"
+#include "config.hpp"
 #include "control_components.hpp"
 #include "control_loop_helpers.hpp"
+#include "cycle_counter.hpp"
+#include "diagnostics_reporter.hpp"
+#include "drive_mode_registry.hpp"
 #include "imu_calibration.hpp"
 #include "kids_mode_processor.hpp"
 #include "madgwick_filter.hpp"
+#include "online_sysid.hpp"
+#include "rate_group.hpp"
+#include "shadow_stabilizer.hpp"
 #include "stabilization_manager.hpp"
 #include "stabilization_pipeline.hpp"
+#include "telemetry_builder.hpp"
 #include "telemetry_manager.hpp"
 #include "vehicle_control_platform.hpp"
 #include "vehicle_ekf.hpp"
 
+#ifdef ESP_PLATFORM
+#include "udp_telem_sender.hpp"
+#endif
+
 namespace rc_vehicle {
 
 /**
@@ -50,6 +65,15 @@ struct ControlLoopContext {
 
   // Атомарный счётчик частоты (читается RunSelfTest из другого потока)
   std::atomic<uint32_t>& last_loop_hz;
+
+  // Shadow-стадия стабилизации (nullable: без IMU не создаётся)
+  ShadowStabilizer* shadow{nullptr};
+
+  // Онлайн-идентификация динамики (nullable)
+  OnlineSysId* sysid{nullptr};
+
+  // Характеристика шумов IMU на стоянке (nullable)
+  AllanNoiseMonitor* allan{nullptr};
 };
 
 /**
@@ -57,26 +81,57 @@ struct ControlLoopContext {
  *
  * Инкапсулирует всё тело ControlTaskLoop (кроме while и watchdog).
  * VehicleControlUnified создаёт экземпляр и вызывает Step() каждый тик.
+ *
+ * Горячие вызовы платформы (опрос RC/Wi-Fi/IMU, failsafe, PWM) идут через
+ * статический тип P (см. ControlTickPlatform): для final-платформы — прямые
+ * вызовы без vtable. ControlLoopProcessor — type-erased инстанс для тестов
+ * с моками; редкие пути (диагностика, авто-процедуры) — через
+ * ctx.platform.
  */
-class ControlLoopProcessor {
+template <ControlTickPlatform P>
+class ControlLoopProcessorT {
  public:
-  ControlLoopProcessor(const ControlLoopContext& ctx, uint32_t now_ms)
-      : ctx_(ctx),
+  /** @param platform Та же платформа, что ctx.platform, со статическим типом */
+  ControlLoopProcessorT(P& platform, const ControlLoopContext& ctx,
+                        uint32_t now_ms)
+      : platform_(platform),
+        ctx_(ctx),
         last_pwm_update_(now_ms),
-        diag_start_ms_(now_ms) {}
+        diag_start_ms_(now_ms),
+        pwm_job_(config::PwmConfig::kUpdateIntervalMs,
+                 config::RateGroupConfig::kPwmPhaseMs, now_ms),
+        log_job_(config::TelemetryLogConfig::kLogIntervalMs,
+                 config::RateGroupConfig::kLogPhaseMs, now_ms),
+        diag_job_(config::DiagnosticsConfig::kIntervalMs,
+                  config::RateGroupConfig::kDiagPhaseMs, now_ms),
+        sysid_job_(config::SysIdConfig::kApplyIntervalMs,
+                   config::RateGroupConfig::kSysIdApplyPhaseMs, now_ms) {}
+
+  /** Type-erased: платформа берётся из ctx.platform. */
+  ControlLoopProcessorT(const ControlLoopContext& ctx, uint32_t now_ms)
+    requires std::same_as<P, VehicleControlPlatform>
+      : ControlLoopProcessorT(ctx.platform, ctx, now_ms) {}
 
   /** Выполнить одну итерацию. */
   void Step(uint32_t now, uint32_t dt_ms);
 
+  /** Стоимость тиков (такты) с последнего вывода диагностики. */
+  [[nodiscard]] const CycleStats& GetTickCycles() const noexcept {
+    return tick_cycles_;
+  }
+
  private:
   void UpdateComponents(uint32_t now, uint32_t dt_ms);
   void UpdateSensorsAndEkf(uint32_t dt_ms);
   void UpdateAutoDrive(uint32_t now_ms, uint32_t dt_ms);
-  void UpdateStabilization(uint32_t dt_ms);
+  void UpdateStabilization(uint32_t now_ms, uint32_t dt_ms);
   void HandleFailsafe();
   void UpdatePwm(uint32_t now, uint32_t dt_ms);
+  void UpdateSysId(uint32_t now);
+  void UpdateNoiseMonitor(uint32_t now);
   void UpdateTelemetry(uint32_t now, uint32_t dt_ms);
 
+  P& platform_;
   const ControlLoopContext& ctx_;
 
   // Per-iteration mutable state
@@ -88,10 +143,304 @@ class ControlLoopProcessor {
   uint32_t last_pwm_update_;
   uint32_t diag_loop_count_{0};
   uint32_t diag_start_ms_;
+  uint32_t loop_cycles_{0};  ///< Стоимость прошлого тика без shadow-стадии
+  CycleStats tick_cycles_;   ///< Полная стоимость тиков (для DIAG)
+
+  // Rate groups: периодические задачи со своими фазами (RateGroupConfig).
+  // WS-телеметрия и опрос RC/магнетометра — в своих handler'ах.
+  PeriodicJob pwm_job_;
+  PeriodicJob log_job_;
+  PeriodicJob diag_job_;
+  PeriodicJob sysid_job_;
 
   // Кэшированный снимок датчиков (обновляется в UpdateSensorsAndEkf)
   SensorSnapshot sensors_;
   StabilizationConfig stab_cfg_;
+
+  // Снимок телеметрии, переиспользуемый между итерациями (без копий на стеке)
+  TelemetrySnapshot telem_snap_;
 };
 
+/** Type-erased control loop: платформа через vtable (моки, тесты). */
+using ControlLoopProcessor = ControlLoopProcessorT<VehicleControlPlatform>;
+
+// ─── Реализация ─────────────────────────────────────────────────────────────
+
+template <ControlTickPlatform P>
+void ControlLoopProcessorT<P>::Step(uint32_t now, uint32_t dt_ms) {
+  const uint32_t t0 = ReadCycleCounter();
+  ++diag_loop_count_;
+
+  UpdateComponents(now, dt_ms);
+  UpdateSensorsAndEkf(dt_ms);
+
+  if (ctx_.calib_mgr) {
+    ctx_.calib_mgr->ProcessRequest(now);
+    ctx_.calib_mgr->ProcessCompletion(now);
+  }
+
+  SelectControlSource(sensors_, commanded_throttle_, commanded_steering_);
+  UpdateAutoDrive(now, dt_ms);
+
+  stab_cfg_ =
+      ctx_.stab_mgr ? ctx_.stab_mgr->GetConfig() : StabilizationConfig{};
+
+  UpdateStabilization(now, dt_ms);
+  HandleFailsafe();
+  UpdatePwm(now, dt_ms);
+  UpdateSysId(now);
+  UpdateNoiseMonitor(now);
+  UpdateTelemetry(now, dt_ms);
+
+  if (diag_job_.Poll(now)) {
+    const DiagnosticsContext dctx{ctx_.platform, *ctx_.stab_mgr, ctx_.madgwick,
+                                  ctx_.ekf, ctx_.imu_handler,
+                                  ctx_.last_loop_hz, &ctx_.yaw_ctrl,
+                                  ctx_.shadow, &tick_cycles_};
+    PrintDiagnostics(dctx, now, diag_loop_count_, diag_start_ms_);
+  }
+
+  // Нагрузка для бюджета shadow-стадии — без её собственной стоимости
+  const uint32_t spent = ReadCycleCounter() - t0;
+  const uint32_t shadow_cost = ctx_.shadow ? ctx_.shadow->LastCostCycles() : 0;
+  loop_cycles_ = spent > shadow_cost ? spent - shadow_cost : 0;
+  tick_cycles_.Add(spent);
+}
+
+template <ControlTickPlatform P>
+void ControlLoopProcessorT<P>::UpdateComponents(uint32_t now, uint32_t dt_ms) {
+  if (ctx_.rc_handler) ctx_.rc_handler->Poll(platform_, now, dt_ms);
+  if (ctx_.wifi_handler) ctx_.wifi_handler->Poll(platform_, now, dt_ms);
+  if (ctx_.imu_handler) ctx_.imu_handler->Poll(platform_, now, dt_ms);
+}
+
+template <ControlTickPlatform P>
+void ControlLoopProcessorT<P>::UpdateSensorsAndEkf(uint32_t dt_ms) {
+  sensors_ = BuildSensorSnapshot(ctx_.rc_handler, ctx_.wifi_handler,
+                                 ctx_.imu_handler);
+  prev_gz_rad_s_ =
+      CorrectImuForComOffset(sensors_, ctx_.imu_calib, prev_gz_rad_s_, dt_ms);
+
+  const bool ekf_active =
+      ctx_.stab_mgr && ctx_.stab_mgr->GetConfig().filter.ekf_enabled;
+  if (ekf_active && sensors_.imu_enabled && dt_ms > 0) {
+    // Передаём |commanded_throttle_| для ZUPT gating:
+    // если throttle > 2%, ZUPT не применяется (машина пытается ехать).
+    ctx_.ekf.UpdateFromImu(sensors_.imu_data.ax, sensors_.imu_data.ay,
+                           sensors_.imu_data.az, sensors_.filtered_gz,
+                           static_cast<float>(dt_ms) * 0.001f,
+                           std::abs(commanded_throttle_));
+  }
+  if (ekf_active && sensors_.imu_enabled && sensors_.mag_enabled) {
+    constexpr float kDegToRad = 3.14159265358979f / 180.0f;
+    ctx_.ekf.UpdateHeading(sensors_.heading_deg * kDegToRad);
+  }
+}
+
+template <ControlTickPlatform P>
+void ControlLoopProcessorT<P>::UpdateAutoDrive(uint32_t now_ms,
+                                               uint32_t dt_ms) {
+  auto ad_input = BuildAutoDriveInput(sensors_, ctx_.imu_calib, dt_ms, now_ms);
+  if (sensors_.imu_enabled) {
+    ad_input.speed_ms = ctx_.ekf.GetSpeedMs();
+    ad_input.slip_deg = ctx_.ekf.GetSlipAngleDeg();
+  }
+  auto ad_out = ctx_.auto_drive.Update(ad_input);
+  if (ad_out.active) {
+    commanded_throttle_ = ad_out.throttle;
+    commanded_steering_ = ad_out.steering;
+  }
+  HandleAutoDriveCompletion(ad_out, ctx_.stab_mgr, ctx_.imu_calib,
+                            ctx_.platform);
+}
+
+template <ControlTickPlatform P>
+void ControlLoopProcessorT<P>::UpdateStabilization(uint32_t now_ms,
+                                                   uint32_t dt_ms) {
+  if (!ctx_.stab_mgr) return;
+
+  ctx_.stab_mgr->UpdateWeights(dt_ms);
+
+  const DriveMode drive_mode = stab_cfg_.mode;
+  const auto traits = DriveModeRegistry::Get(drive_mode).GetTraits();
+
+  if (traits.apply_input_limits) {
+    float kids_fwd_accel = 0.0f;
+    if (sensors_.imu_enabled) {
+      kids_fwd_accel = ctx_.imu_calib.GetForwardAccel(sensors_.imu_data);
+    }
+    ctx_.kids_processor.Process(commanded_throttle_, commanded_steering_,
+                                dt_ms, kids_fwd_accel);
+  }
+
+  const float sw = ctx_.stab_mgr->GetStabilizationWeight();
+  const float mw = ctx_.stab_mgr->GetModeTransitionWeight();
+  const float in_throttle = commanded_throttle_;
+  const float in_steering = commanded_steering_;
+
+  if (traits.yaw_rate_active)
+    ctx_.yaw_ctrl.Process(commanded_steering_, sw, mw, dt_ms);
+  if (traits.pitch_comp_active)
+    ctx_.pitch_ctrl.Process(commanded_throttle_, sw);
+  if (traits.slip_angle_active)
+    ctx_.slip_ctrl.Process(commanded_throttle_, sw, mw, dt_ms);
+  if (traits.oversteer_guard_active)
+    ctx_.oversteer_guard.Process(commanded_throttle_, dt_ms,
+                                 traits.oversteer_reduces_throttle);
+
+  // Кандидат получает те же входы; его выход только логируется
+  if (ctx_.shadow) {
+    ShadowStepInput shadow_in;
+    shadow_in.in_throttle = in_throttle;
+    shadow_in.in_steering = in_steering;
+    shadow_in.live_throttle = commanded_throttle_;
+    shadow_in.live_steering = commanded_steering_;
+    shadow_in.dt_ms = dt_ms;
+    shadow_in.now_ms = now_ms;
+    shadow_in.loop_cycles = loop_cycles_;
+    ctx_.shadow->Step(shadow_in);
+  }
+}
+
+template <ControlTickPlatform P>
+void ControlLoopProcessorT<P>::HandleFailsafe() {
+  if (!platform_.FailsafeUpdate(sensors_.rc_active, sensors_.wifi_active))
+    return;
+
+  commanded_throttle_ = 0.0f;
+  commanded_steering_ = 0.0f;
+  applied_throttle_ = 0.0f;
+  applied_steering_ = 0.0f;
+  ctx_.yaw_ctrl.Reset();
+  ctx_.slip_ctrl.Reset();
+  ctx_.oversteer_guard.Reset();
+  if (ctx_.shadow) ctx_.shadow->Reset();
+  ctx_.kids_processor.Reset();
+  ctx_.ekf.Reset();
+  if (ctx_.stab_mgr) ctx_.stab_mgr->ResetWeights();
+  ctx_.auto_drive.StopAll();
+  platform_.SetPwmNeutral();
+}
+
+template <ControlTickPlatform P>
+void ControlLoopProcessorT<P>::UpdatePwm(uint32_t now, uint32_t dt_ms) {
+  (void)dt_ms;
+  const float steer_trim = stab_cfg_.steering_trim;
+  const float thr_trim = stab_cfg_.throttle_trim;
+
+  const DriveMode drive_mode = stab_cfg_.mode;
+  const auto traits = DriveModeRegistry::Get(drive_mode).GetTraits();
+
+  if (traits.use_slew_rate) {
+    float effective_slew_thr = stab_cfg_.slew_throttle;
+    if (stab_cfg_.braking_mode == BrakingMode::Brake &&
+        std::abs(commanded_throttle_) < std::abs(applied_throttle_)) {
+      effective_slew_thr *= stab_cfg_.brake_slew_multiplier;
+    }
+    if (pwm_job_.Poll(now)) {
+      const uint32_t pwm_dt_ms = now - last_pwm_update_;
+      last_pwm_update_ = now;
+      ApplyPwmSlewStep(platform_, pwm_dt_ms, commanded_throttle_,
+                       commanded_steering_, applied_throttle_,
+                       applied_steering_, thr_trim, steer_trim,
+                       effective_slew_thr, stab_cfg_.slew_steering);
+    }
+  } else {
+    applied_throttle_ = commanded_throttle_ + thr_trim;
+    applied_steering_ = commanded_steering_ + steer_trim;
+    platform_.SetPwm(applied_throttle_, applied_steering_);
+  }
+}
+
+template <ControlTickPlatform P>
+void ControlLoopProcessorT<P>::UpdateSysId(uint32_t now) {
+  const bool apply_due = sysid_job_.Poll(now);
+  // Скорость нужна обеим моделям (гейтинг руля, выход газа) — только с EKF
+  if (!ctx_.sysid || !sensors_.imu_enabled || !stab_cfg_.filter.ekf_enabled)
+    return;
+
+  // Вход объекта — то, что ушло в PWM, без trim. Без slew applied_* уже
+  // содержит trim и равен commanded_* + trim
+  const bool slew = DriveModeRegistry::Get(stab_cfg_.mode)
+                        .GetTraits()
+                        .use_slew_rate;
+  SysIdSample s;
+  s.steering = slew ? applied_steering_ : commanded_steering_;
+  s.throttle = slew ? applied_throttle_ : commanded_throttle_;
+  s.yaw_rate_dps = sensors_.filtered_gz;
+  s.speed_ms = ctx_.ekf.GetSpeedMs();
+  ctx_.sysid->Update(s);
+
+  if (!apply_due || !ctx_.stab_mgr || !ctx_.sysid->IsApplyEnabled()) return;
+
+  // Опорная кривая yaw-регулятора подтягивается к измеренному коэффициенту
+  // объекта не более чем на kApplyMaxStepFrac за период (без записи в NVS)
+  const SysIdEstimate e = ctx_.sysid->GetEstimate();
+  if (!e.steer_valid || e.steer_gain_dps <= 0.0f) return;
+  // Меняется одно поле под локом менеджера: полный SetConfig из цикла
+  // откатывал бы одновременный set_stab_config и перенастраивал фильтры
+  const float k = stab_cfg_.yaw_rate.steer_to_yaw_rate_dps;
+  const float next = RateLimitedApply(k, e.steer_gain_dps,
+                                      config::SysIdConfig::kApplyMaxStepFrac);
+  if (next != k) ctx_.stab_mgr->SetSteerToYawRate(next);
+}
+
+template <ControlTickPlatform P>
+void ControlLoopProcessorT<P>::UpdateNoiseMonitor(uint32_t now) {
+  if (!ctx_.allan || !sensors_.imu_enabled) return;
+  using Cfg = config::AllanConfig;
+  // Стоянка: газа нет, EKF не видит скорости, не вращается, авто-манёвр
+  // не идёт. Скорость без EKF неизвестна — считаем по газу и gz
+  const float speed = stab_cfg_.filter.ekf_enabled ? ctx_.ekf.GetSpeedMs()
+                                                   : 0.0f;
+  AllanSample s;
+  s.parked = std::fabs(commanded_throttle_) < Cfg::kParkedMaxThrottle &&
+             std::fabs(speed) < Cfg::kParkedMaxSpeedMs &&
+             std::fabs(sensors_.filtered_gz) < Cfg::kParkedMaxYawRateDps &&
+             !ctx_.auto_drive.IsAnyActive();
+  const ImuData& d = sensors_.imu_data;
+  s.gyro_dps[0] = d.gx;
+  s.gyro_dps[1] = d.gy;
+  s.gyro_dps[2] = d.gz;
+  s.accel_g[0] = d.ax;
+  s.accel_g[1] = d.ay;
+  s.accel_g[2] = d.az;
+  ctx_.allan->Update(s, now);
+}
+
+template <ControlTickPlatform P>
+void ControlLoopProcessorT<P>::UpdateTelemetry(uint32_t now, uint32_t dt_ms) {
+  (void)dt_ms;
+  const TelemetryContext tctx{ctx_.ekf,    ctx_.madgwick,   ctx_.imu_calib,
+                               ctx_.oversteer_guard, ctx_.kids_processor,
+                               ctx_.auto_drive, ctx_.shadow, ctx_.sysid};
+  const DriveMode drive_mode = stab_cfg_.mode;
+
+  // Потребители опрашиваются в своих слотах; снимок строится только на
+  // тиках, где хотя бы один из них сработал (ленивая сборка)
+  const bool send_ws =
+      ctx_.telem_handler != nullptr && ctx_.telem_handler->PollSendDue(now);
+  const bool log_due =
+      sensors_.imu_enabled && ctx_.telem_mgr && log_job_.Poll(now);
+  if (!send_ws && !log_due) return;
+
+  BuildTelemetrySnapshot(tctx, now, sensors_, stab_cfg_, drive_mode,
+                         applied_throttle_, applied_steering_,
+                         commanded_throttle_, commanded_steering_, telem_snap_);
+
+  if (send_ws) {
+    ctx_.telem_handler->SendNow(telem_snap_);
+  }
+
+  if (log_due) {
+    ctx_.telem_mgr->Push(telem_snap_.frame);
+    ctx_.telem_mgr->SetLastLogTime(now);
+#ifdef ESP_PLATFORM
+    UdpTelemEnqueue(telem_snap_.frame);
+#endif
+  }
+}
+
+extern template class ControlLoopProcessorT<VehicleControlPlatform>;
+
 }  // namespace rc_vehicle
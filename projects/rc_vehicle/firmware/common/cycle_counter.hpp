@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef ESP_PLATFORM
+#include "esp_cpu.h"
+#include "sdkconfig.h"
+#else
+#include <chrono>
+#endif
+
+namespace rc_vehicle {
+
+/**
+ * @brief Счётчик тактов для замера стоимости коротких участков кода.
+ *
+ * На ESP32 — регистр CCOUNT ядра (такты CPU, переполнение ~18 с при 240 МГц,
+ * разность uint32_t корректна через переполнение). На хосте — наносекунды
+ * steady_clock: абсолютные значения не сопоставимы с устройством, но
+ * соотношение между участками сохраняется.
+ */
+[[nodiscard]] inline uint32_t ReadCycleCounter() noexcept {
+#ifdef ESP_PLATFORM
+  return static_cast<uint32_t>(esp_cpu_get_cycle_count());
+#else
+  return static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#endif
+}
+
+/** Частота ReadCycleCounter() [Гц] — для перевода тактов в секунды. */
+#ifdef ESP_PLATFORM
+inline constexpr uint32_t kCycleCounterHz =
+    CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ * 1000000u;
+#else
+inline constexpr uint32_t kCycleCounterHz = 1000000000u;
+#endif
+
+/**
+ * @brief Накопитель статистики стоимости (последнее, среднее, максимум).
+ *
+ * Не потокобезопасен: пишется из control loop, читается там же
+ * (PrintDiagnostics).
+ */
+struct CycleStats {
+  uint32_t last{0};
+  uint32_t max{0};
+  uint64_t sum{0};
+  uint32_t count{0};
+
+  void Add(uint32_t cycles) noexcept {
+    last = cycles;
+    if (cycles > max) max = cycles;
+    sum += cycles;
+    ++count;
+  }
+
+  [[nodiscard]] uint32_t Mean() const noexcept {
+    return count ? static_cast<uint32_t>(sum / count) : 0u;
+  }
+
+  void Reset() noexcept { *this = CycleStats{}; }
+};
+
+}  // namespace rc_vehicle
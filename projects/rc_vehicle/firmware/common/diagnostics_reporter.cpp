@@ -1,8 +1,5 @@
 #include "diagnostics_reporter.hpp"
 
-#include <iomanip>
-
-#include "config.hpp"
 #include "log_format.hpp"
 
 namespace rc_vehicle {
@@ -10,8 +7,6 @@ namespace rc_vehicle {
 void PrintDiagnostics(const DiagnosticsContext& ctx, uint32_t now_ms,
                       uint32_t& diag_loop_count, uint32_t& diag_start_ms) {
   const uint32_t elapsed = now_ms - diag_start_ms;
-  if (elapsed < config::DiagnosticsConfig::kIntervalMs) return;
-
   const uint32_t loop_hz =
       (elapsed > 0) ? (diag_loop_count * 1000u / elapsed) : 0u;
   ctx.last_loop_hz.store(loop_hz, std::memory_order_relaxed);
@@ -23,9 +18,14 @@ void PrintDiagnostics(const DiagnosticsContext& ctx, uint32_t now_ms,
     LogFormat fmt;
     fmt << "DIAG: loop=" << static_cast<unsigned>(loop_hz)
         << " Hz  stab=" << (cfg.enabled ? "ON" : "OFF")
-        << " (w=" << std::fixed << std::setprecision(2) << stab_weight << ")";
+        << " (w=" << Fixed(2) << stab_weight << ")";
+    if (ctx.tick_cycles && ctx.tick_cycles->count > 0) {
+      fmt << "  tick avg=" << ctx.tick_cycles->Mean()
+          << " max=" << ctx.tick_cycles->max << " cyc";
+    }
     ctx.platform.Log(LogLevel::Info, fmt.str());
   }
+  if (ctx.tick_cycles) ctx.tick_cycles->Reset();
 
   if (ctx.imu_handler && ctx.imu_handler->IsEnabled()) {
     float pitch_deg = 0.f, roll_deg = 0.f, yaw_deg = 0.f;
@@ -33,7 +33,7 @@ void PrintDiagnostics(const DiagnosticsContext& ctx, uint32_t now_ms,
 
     {
       LogFormat fmt;
-      fmt << "IMU: P=" << std::fixed << std::setprecision(1) << pitch_deg
+      fmt << "IMU: P=" << Fixed(1) << pitch_deg
           << " R=" << roll_deg << " Y=" << yaw_deg
           << " deg  gz=" << ctx.imu_handler->GetFilteredGyroZ() << " dps";
       ctx.platform.Log(LogLevel::Info, fmt.str());
@@ -41,14 +41,38 @@ void PrintDiagnostics(const DiagnosticsContext& ctx, uint32_t now_ms,
 
     {
       LogFormat fmt;
-      fmt << "EKF: vx=" << std::fixed << std::setprecision(2)
-          << ctx.ekf.GetVx() << " vy=" << ctx.ekf.GetVy()
-          << " m/s  slip=" << std::setprecision(1)
+      fmt << "EKF: vx=" << Fixed(2) << ctx.ekf.GetVx()
+          << " vy=" << ctx.ekf.GetVy() << " m/s  slip=" << Fixed(1)
           << ctx.ekf.GetSlipAngleDeg() << " deg";
       ctx.platform.Log(LogLevel::Info, fmt.str());
     }
   }
 
+  if (ctx.yaw_ctrl) {
+    const CycleStats& pid = ctx.yaw_ctrl->GetPidCycles();
+    const CycleStats& mpc = ctx.yaw_ctrl->GetMpcCycles();
+    if (pid.count > 0 || mpc.count > 0) {
+      LogFormat fmt;
+      fmt << "YAW: pid avg=" << pid.Mean() << " max=" << pid.max
+          << "  mpc avg=" << mpc.Mean() << " max=" << mpc.max
+          << " cyc (n=" << mpc.count << ")";
+      ctx.platform.Log(LogLevel::Info, fmt.str());
+    }
+    ctx.yaw_ctrl->ResetCycleStats();
+  }
+
+  if (ctx.shadow && ctx.shadow->GetState() != ShadowState::Off) {
+    const ShadowStats st = ctx.shadow->GetStats();
+    LogFormat fmt;
+    fmt << "SHADOW: " << (st.state == ShadowState::Shed ? "SHED" : "RUN")
+        << " rms d_thr=" << Fixed(3)
+        << st.rms_d_throttle << " d_steer=" << st.rms_d_steering
+        << "  cost avg=" << st.cost.Mean() << " max=" << st.cost.max
+        << " cyc  load=" << static_cast<unsigned>(st.loop_load_pct)
+        << "% shed=" << st.shed_events;
+    ctx.platform.Log(LogLevel::Info, fmt.str());
+  }
+
   diag_loop_count = 0;
   diag_start_ms = now_ms;
 }
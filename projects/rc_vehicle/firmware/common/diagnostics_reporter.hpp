@@ -4,8 +4,11 @@
 #include <cstdint>
 
 #include "control_components.hpp"
+#include "cycle_counter.hpp"
 #include "madgwick_filter.hpp"
+#include "shadow_stabilizer.hpp"
 #include "stabilization_manager.hpp"
+#include "stabilization_pipeline.hpp"
 #include "vehicle_control_platform.hpp"
 #include "vehicle_ekf.hpp"
 
@@ -19,13 +22,18 @@ struct DiagnosticsContext {
   const VehicleEkf& ekf;
   const ImuHandler* imu_handler;
   std::atomic<uint32_t>& last_loop_hz;
+  YawRateController* yaw_ctrl{nullptr};  ///< Стоимость ПИД/MPC (опционально)
+  const ShadowStabilizer* shadow{nullptr};  ///< Shadow-стадия (опционально)
+  CycleStats* tick_cycles{nullptr};  ///< Стоимость тика (сбрасывается)
 };
 
 /**
- * @brief Вывод диагностической информации (частота loop, IMU, EKF).
+ * @brief Вывод диагностической информации (частота и стоимость тика loop,
+ *        IMU, EKF, стоимость шага yaw-регулятора, расхождение shadow-стадии).
  *
- * Вызывается каждую итерацию loop. Выводит информацию с заданным
- * интервалом (config::DiagnosticsConfig::kIntervalMs).
+ * Вызывается в слоте диагностики rate group (ControlLoopProcessor,
+ * config::DiagnosticsConfig::kIntervalMs); частота loop считается по
+ * diag_loop_count за время с diag_start_ms.
  */
 void PrintDiagnostics(const DiagnosticsContext& ctx, uint32_t now_ms,
                       uint32_t& diag_loop_count, uint32_t& diag_start_ms);
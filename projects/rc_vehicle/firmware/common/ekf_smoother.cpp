@@ -0,0 +1,288 @@
+#include "ekf_smoother.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#include "config.hpp"
+#include "telemetry_log.hpp"
+
+namespace rc_vehicle {
+
+namespace {
+
+constexpr float kRadToDeg = 180.0f / 3.14159265358979f;
+constexpr float kDegToRad = 3.14159265358979f / 180.0f;
+
+// ─── Линейная алгебра 4×4 (double: P_pred плохо обусловлена при малых Q) ──
+
+/** Разложение Холецкого A = L·Lᵀ; false — A не положительно определена. */
+bool Cholesky4(const float A[16], double L[16]) {
+  std::fill(L, L + 16, 0.0);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      double s = A[i * 4 + j];
+      for (int k = 0; k < j; ++k) s -= L[i * 4 + k] * L[j * 4 + k];
+      if (i == j) {
+        if (!(s > 0.0)) return false;
+        L[i * 4 + i] = std::sqrt(s);
+      } else {
+        L[i * 4 + j] = s / L[j * 4 + j];
+      }
+    }
+  }
+  return true;
+}
+
+/** Решить (L·Lᵀ)·X = B для всех столбцов B; результат — в B. */
+void CholeskySolve4(const double L[16], double B[16]) {
+  for (int c = 0; c < 4; ++c) {
+    for (int i = 0; i < 4; ++i) {
+      double s = B[i * 4 + c];
+      for (int k = 0; k < i; ++k) s -= L[i * 4 + k] * B[k * 4 + c];
+      B[i * 4 + c] = s / L[i * 4 + i];
+    }
+    for (int i = 3; i >= 0; --i) {
+      double s = B[i * 4 + c];
+      for (int k = i + 1; k < 4; ++k) s -= L[k * 4 + i] * B[k * 4 + c];
+      B[i * 4 + c] = s / L[i * 4 + i];
+    }
+  }
+}
+
+// ─── Поля кадра (кадры лога не выровнены) ────────────────────────────────
+
+float ReadF32(const uint8_t* rec, uint32_t frame_size, size_t offset) {
+  float v = 0.0f;
+  if (offset + sizeof(v) <= frame_size) std::memcpy(&v, rec + offset, 4);
+  return v;
+}
+
+void WriteF32(uint8_t* rec, uint32_t frame_size, size_t offset, float v) {
+  if (offset + sizeof(v) <= frame_size) std::memcpy(rec + offset, &v, 4);
+}
+
+EkfStepInput FrameInput(const uint8_t* rec, uint32_t frame_size) {
+  EkfStepInput in;
+  in.ax_g = ReadF32(rec, frame_size, offsetof(TelemetryLogFrame, ax));
+  in.ay_g = ReadF32(rec, frame_size, offsetof(TelemetryLogFrame, ay));
+  in.az_g = ReadF32(rec, frame_size, offsetof(TelemetryLogFrame, az));
+  in.gz_dps =
+      ReadF32(rec, frame_size, offsetof(TelemetryLogFrame, yaw_rate_dps));
+  in.throttle_abs = std::abs(
+      ReadF32(rec, frame_size, offsetof(TelemetryLogFrame, cmd_throttle)));
+  // Без магнитометра mx/my/mz в кадре нулевые
+  in.has_heading =
+      ReadF32(rec, frame_size, offsetof(TelemetryLogFrame, mx)) != 0.0f ||
+      ReadF32(rec, frame_size, offsetof(TelemetryLogFrame, my)) != 0.0f ||
+      ReadF32(rec, frame_size, offsetof(TelemetryLogFrame, mz)) != 0.0f;
+  in.heading_rad =
+      ReadF32(rec, frame_size, offsetof(TelemetryLogFrame, heading_deg)) *
+      kDegToRad;
+  return in;
+}
+
+void WriteFrameState(uint8_t* rec, uint32_t frame_size,
+                     const EkfStateEstimate& s) {
+  const float vx = s.x[0], vy = s.x[1];
+  WriteF32(rec, frame_size, offsetof(TelemetryLogFrame, vx), vx);
+  WriteF32(rec, frame_size, offsetof(TelemetryLogFrame, vy), vy);
+  WriteF32(rec, frame_size, offsetof(TelemetryLogFrame, slip_deg),
+           VehicleEkf::SlipAngleRad(vx, vy) * kRadToDeg);
+  WriteF32(rec, frame_size, offsetof(TelemetryLogFrame, speed_ms),
+           std::sqrt(vx * vx + vy * vy));
+  WriteF32(rec, frame_size, offsetof(TelemetryLogFrame, ekf_vx_var),
+           s.var[0]);
+  WriteF32(rec, frame_size, offsetof(TelemetryLogFrame, ekf_vy_var),
+           s.var[1]);
+  WriteF32(rec, frame_size, offsetof(TelemetryLogFrame, ekf_r_var), s.var[2]);
+  WriteF32(rec, frame_size, offsetof(TelemetryLogFrame, ekf_yaw_deg),
+           s.x[3] * kRadToDeg);
+}
+
+}  // namespace
+
+// ─── VehicleEkfSmoother ──────────────────────────────────────────────────
+
+VehicleEkfSmoother::VehicleEkfSmoother(VehicleEkfNoiseParams params)
+    : params_(params), ekf_(params) {}
+
+void VehicleEkfSmoother::Reset() {
+  ekf_.Reset();
+  rec_.clear();
+  smoothed_.clear();
+}
+
+void VehicleEkfSmoother::Step(const EkfStepInput& in) {
+  Record r;
+  float x_prev[4];
+  ekf_.GetState(x_prev);
+  VehicleEkf::TransitionJacobian(x_prev, in.dt_sec, params_.vy_decay_hz, r.F);
+
+  ekf_.PredictFromImu(in.ax_g, in.ay_g, in.dt_sec);
+  ekf_.GetState(r.x_pred);
+  ekf_.GetCovariance(r.P_pred);
+
+  ekf_.CorrectFromImu(in.ax_g, in.ay_g, in.az_g, in.gz_dps, in.throttle_abs);
+  if (in.has_heading) ekf_.UpdateHeading(in.heading_rad);
+  ekf_.GetState(r.x_filt);
+  ekf_.GetCovariance(r.P_filt);
+
+  rec_.push_back(r);
+}
+
+EkfStateEstimate VehicleEkfSmoother::Filtered(size_t k) const noexcept {
+  EkfStateEstimate s;
+  const Record& r = rec_[k];
+  for (int i = 0; i < 4; ++i) {
+    s.x[i] = r.x_filt[i];
+    s.var[i] = r.P_filt[i * 5];
+  }
+  return s;
+}
+
+void VehicleEkfSmoother::Smooth() {
+  const size_t n = rec_.size();
+  smoothed_.resize(n);
+  if (n == 0) return;
+
+  // Последний шаг: сглаженная оценка совпадает с фильтрованной
+  smoothed_[n - 1] = Filtered(n - 1);
+  double xs[4], Ps[16];
+  for (int i = 0; i < 4; ++i) xs[i] = rec_[n - 1].x_filt[i];
+  for (int i = 0; i < 16; ++i) Ps[i] = rec_[n - 1].P_filt[i];
+
+  for (size_t k = n - 1; k-- > 0;) {
+    const Record& cur = rec_[k];
+    const Record& next = rec_[k + 1];
+
+    // Gᵀ = P_pred⁻¹ · (F · P_filt), G = P_filt · Fᵀ · P_pred⁻¹ (P симметричны)
+    double Gt[16];
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        double s = 0.0;
+        for (int m = 0; m < 4; ++m) {
+          s += static_cast<double>(next.F[i * 4 + m]) * cur.P_filt[m * 4 + j];
+        }
+        Gt[i * 4 + j] = s;
+      }
+    }
+    double L[16];
+    if (!Cholesky4(next.P_pred, L)) {
+      // Вырожденная P_pred (не должно случаться после ClampP) — шаг без
+      // сглаживания, рекурсия продолжается от фильтрованной оценки
+      smoothed_[k] = Filtered(k);
+      for (int i = 0; i < 4; ++i) xs[i] = cur.x_filt[i];
+      for (int i = 0; i < 16; ++i) Ps[i] = cur.P_filt[i];
+      continue;
+    }
+    CholeskySolve4(L, Gt);
+
+    // x_s = x_f + G·(x_s⁺ − x_pred⁺); ψ — по кратчайшей дуге
+    double dx[4];
+    for (int i = 0; i < 4; ++i) dx[i] = xs[i] - next.x_pred[i];
+    dx[3] = VehicleEkf::WrapAngle(static_cast<float>(dx[3]));
+    double xs_new[4];
+    for (int i = 0; i < 4; ++i) {
+      double s = cur.x_filt[i];
+      for (int m = 0; m < 4; ++m) s += Gt[m * 4 + i] * dx[m];
+      xs_new[i] = s;
+    }
+    xs_new[3] = VehicleEkf::WrapAngle(static_cast<float>(xs_new[3]));
+
+    // P_s = P_f + G·(P_s⁺ − P_pred⁺)·Gᵀ
+    double D[16], GD[16];
+    for (int i = 0; i < 16; ++i) D[i] = Ps[i] - next.P_pred[i];
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        double s = 0.0;
+        for (int m = 0; m < 4; ++m) s += Gt[m * 4 + i] * D[m * 4 + j];
+        GD[i * 4 + j] = s;
+      }
+    }
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        double s = cur.P_filt[i * 4 + j];
+        for (int m = 0; m < 4; ++m) s += GD[i * 4 + m] * Gt[m * 4 + j];
+        Ps[i * 4 + j] = s;
+      }
+    }
+    // Симметризация против накопления ошибок округления
+    for (int i = 0; i < 4; ++i) {
+      for (int j = i + 1; j < 4; ++j) {
+        const double avg = 0.5 * (Ps[i * 4 + j] + Ps[j * 4 + i]);
+        Ps[i * 4 + j] = Ps[j * 4 + i] = avg;
+      }
+    }
+
+    EkfStateEstimate& out = smoothed_[k];
+    for (int i = 0; i < 4; ++i) {
+      xs[i] = xs_new[i];
+      out.x[i] = static_cast<float>(xs_new[i]);
+      out.var[i] = static_cast<float>(std::max(Ps[i * 5], 0.0));
+    }
+  }
+}
+
+// ─── Лог ─────────────────────────────────────────────────────────────────
+
+LogSmoothStats SmoothLogEkf(const LogBinView& view,
+                            const VehicleEkfNoiseParams& params,
+                            uint8_t* frames) {
+  using config::ControlLoopConfig;
+  using config::TelemetryLogConfig;
+  constexpr uint32_t kMaxGapMs = 10 * TelemetryLogConfig::kLogIntervalMs;
+
+  LogSmoothStats stats;
+  const size_t n = view.frame_count;
+  const uint32_t fs = view.frame_size;
+  if (n == 0 || fs < sizeof(uint32_t)) return stats;
+
+  VehicleEkfSmoother smoother(params);
+  smoother.Reserve(n * (TelemetryLogConfig::kLogIntervalMs /
+                        ControlLoopConfig::kPeriodMs));
+  // Индекс последнего подшага каждого кадра текущего участка
+  std::vector<size_t> frame_step;
+  frame_step.reserve(n);
+
+  size_t seg_begin = 0;
+  uint32_t prev_ts = 0;
+  for (size_t i = 0; i <= n; ++i) {
+    const uint8_t* rec = view.frames + i * fs;
+    uint32_t ts = 0;
+    if (i < n) std::memcpy(&ts, rec, sizeof(ts));
+
+    const bool gap =
+        i > seg_begin && (ts < prev_ts || ts - prev_ts > kMaxGapMs);
+    if (i == n || gap) {
+      smoother.Smooth();
+      for (size_t f = seg_begin; f < i; ++f) {
+        WriteFrameState(frames + f * fs, fs,
+                        smoother.Smoothed(frame_step[f - seg_begin]));
+      }
+      ++stats.segments;
+      stats.steps += smoother.Size();
+      if (i == n) break;
+      smoother.Reset();
+      frame_step.clear();
+      seg_begin = i;
+    }
+
+    // Интервал кадра → подшаги периода control loop (Q добавляется за шаг)
+    const uint32_t dt_ms =
+        i == seg_begin ? TelemetryLogConfig::kLogIntervalMs : ts - prev_ts;
+    const uint32_t substeps = std::max<uint32_t>(
+        1, (dt_ms + ControlLoopConfig::kPeriodMs / 2) /
+               ControlLoopConfig::kPeriodMs);
+    EkfStepInput in = FrameInput(rec, fs);
+    in.dt_sec = static_cast<float>(dt_ms) * 0.001f /
+                static_cast<float>(substeps);
+    for (uint32_t s = 0; s < substeps; ++s) smoother.Step(in);
+    frame_step.push_back(smoother.Size() - 1);
+    prev_ts = ts;
+  }
+  return stats;
+}
+
+}  // namespace rc_vehicle
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "telemetry_log_decoder.hpp"
+#include "vehicle_ekf.hpp"
+
+/**
+ * @file ekf_smoother.hpp
+ * @brief Офлайн RTS-сглаживание (Rauch–Tung–Striebel) состояния VehicleEkf.
+ *
+ * Прямой проход — тот же VehicleEkf, что на устройстве (PredictFromImu /
+ * CorrectFromImu / UpdateHeading), с сохранением x/P до и после коррекции
+ * и якобиана F; обратный проход — по сохранённым данным. Модель не
+ * дублируется: F и f берутся из vehicle_ekf.cpp. Только для хоста
+ * (log_convert --smooth, unit-тесты): память — O(число шагов).
+ */
+
+namespace rc_vehicle {
+
+/** Входы одного шага — как в ControlLoopProcessor::UpdateSensorsAndEkf. */
+struct EkfStepInput {
+  float ax_g{0.0f};
+  float ay_g{0.0f};
+  float az_g{1.0f};
+  float gz_dps{0.0f};  ///< Отфильтрованный gyro Z (yaw_rate_dps в логе)
+  float dt_sec{0.0f};
+  float throttle_abs{0.0f};  ///< |commanded throttle| для ZUPT gating
+  bool has_heading{false};   ///< Есть курс магнитометра
+  float heading_rad{0.0f};
+};
+
+/** Состояние шага: [vx, vy, r, ψ] и диагональ P. */
+struct EkfStateEstimate {
+  float x[4]{};
+  float var[4]{};
+};
+
+/**
+ * @brief RTS-сглаживатель поверх VehicleEkf.
+ *
+ * @code
+ * VehicleEkfSmoother s(params);
+ * for (const auto& in : steps) s.Step(in);  // = EKF на устройстве
+ * s.Smooth();
+ * s.Smoothed(k).x[0];  // vx по всем данным, без запаздывания
+ * @endcode
+ */
+class VehicleEkfSmoother {
+ public:
+  explicit VehicleEkfSmoother(VehicleEkfNoiseParams params = {});
+
+  void Reserve(size_t steps) { rec_.reserve(steps); }
+
+  /** Сбросить EKF и записанные шаги. */
+  void Reset();
+
+  /** Прямой проход: шаг EKF с записью x/P для обратного прохода. */
+  void Step(const EkfStepInput& in);
+
+  /** Обратный проход RTS по всем записанным шагам. */
+  void Smooth();
+
+  [[nodiscard]] size_t Size() const noexcept { return rec_.size(); }
+
+  /** Оценка EKF (прямой проход) после шага k. */
+  [[nodiscard]] EkfStateEstimate Filtered(size_t k) const noexcept;
+
+  /** Сглаженная оценка шага k (после Smooth()). */
+  [[nodiscard]] const EkfStateEstimate& Smoothed(size_t k) const noexcept {
+    return smoothed_[k];
+  }
+
+ private:
+  /// Шаг k: x/P после предсказания, якобиан этого предсказания, x/P после
+  /// коррекции
+  struct Record {
+    float x_pred[4];
+    float P_pred[16];
+    float F[16];
+    float x_filt[4];
+    float P_filt[16];
+  };
+
+  VehicleEkfNoiseParams params_;
+  VehicleEkf ekf_;
+  std::vector<Record> rec_;
+  std::vector<EkfStateEstimate> smoothed_;
+};
+
+/** @brief Итог SmoothLogEkf. */
+struct LogSmoothStats {
+  uint32_t segments{0};  ///< Непрерывных участков (разрывы по ts_ms)
+  uint64_t steps{0};     ///< Шагов EKF (с подшагами control loop)
+};
+
+/**
+ * @brief Пересчитать EKF-каналы лога RTS-сглаживателем.
+ *
+ * Вход EKF — поля кадра ax/ay/az, yaw_rate_dps (отфильтрованный gz, как в
+ * control loop), |cmd_throttle| и heading_deg (если mx/my/mz не нули).
+ * Интервал между кадрами делится на подшаги периода control loop
+ * (config::ControlLoopConfig::kPeriodMs), чтобы шум процесса на секунду
+ * совпадал с устройством. Разрыв ts_ms (назад или больше 10 интервалов
+ * лога) начинает новый участок с новым EKF.
+ *
+ * @param view Исходный лог (кадры не меняются)
+ * @param frames Копия секции кадров view (frame_count × frame_size); в ней
+ *        перезаписываются vx, vy, slip_deg, speed_ms, ekf_vx_var,
+ *        ekf_vy_var, ekf_r_var, ekf_yaw_deg (поля, попадающие в frame_size)
+ */
+LogSmoothStats SmoothLogEkf(const LogBinView& view,
+                            const VehicleEkfNoiseParams& params,
+                            uint8_t* frames);
+
+}  // namespace rc_vehicle
@@ -0,0 +1,43 @@
+#include "explicit_mpc.hpp"
+
+namespace rc_vehicle {
+
+namespace {
+
+float Dot(const float (&a)[kExplicitMpcParamDim],
+          const float (&b)[kExplicitMpcParamDim]) noexcept {
+  float s = 0.0f;
+  for (int i = 0; i < kExplicitMpcParamDim; ++i) s += a[i] * b[i];
+  return s;
+}
+
+}  // namespace
+
+int ExplicitMpcLocate(const ExplicitMpcPartition& part,
+                      const float (&x)[kExplicitMpcParamDim]) noexcept {
+  if (!part.nodes || part.node_count <= 0 || !part.regions) return -1;
+
+  int idx = 0;
+  // Глубина дерева не превышает число узлов — защита от зацикливания
+  for (int depth = 0; depth < part.node_count && idx >= 0; ++depth) {
+    if (idx >= part.node_count) return -1;
+    const auto& n = part.nodes[idx];
+    idx = (Dot(n.h, x) <= n.c) ? n.yes : n.no;
+  }
+  if (idx >= 0) return -1;
+
+  const int region = -idx - 1;
+  return (region < part.region_count) ? region : -1;
+}
+
+bool ExplicitMpcEvaluate(const ExplicitMpcPartition& part,
+                         const float (&x)[kExplicitMpcParamDim],
+                         float& u) noexcept {
+  const int region = ExplicitMpcLocate(part, x);
+  if (region < 0) return false;
+  const auto& r = part.regions[region];
+  u = Dot(r.f, x) + r.g;
+  return true;
+}
+
+}  // namespace rc_vehicle
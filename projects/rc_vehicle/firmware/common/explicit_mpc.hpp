@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+namespace rc_vehicle {
+
+/** Размерность вектора параметров явного MPC: [vy, r, r_ref, u_prev, du_max] */
+inline constexpr int kExplicitMpcParamDim = 5;
+
+/**
+ * @brief Узел бинарного дерева поиска по областям явного MPC.
+ *
+ * Проверка гиперплоскости h·x ≤ c: true → yes, false → no.
+ * Индекс ≥ 0 — следующий узел, < 0 — лист, область -(index + 1).
+ */
+struct ExplicitMpcNode {
+  float h[kExplicitMpcParamDim];
+  float c;
+  int16_t yes;
+  int16_t no;
+};
+
+/** @brief Аффинный закон управления в критической области: u = f·x + g. */
+struct ExplicitMpcRegion {
+  float f[kExplicitMpcParamDim];
+  float g;
+};
+
+/**
+ * @brief Кусочно-аффинное решение параметрической QP (одна скоростная ячейка).
+ *
+ * Таблицы генерируются офлайн (tools/gen_yaw_mpc.py) и лежат во flash;
+ * на устройстве вычисление — один спуск по дереву и одно скалярное
+ * произведение, без решения QP.
+ */
+struct ExplicitMpcPartition {
+  const ExplicitMpcNode* nodes{nullptr};
+  int node_count{0};
+  const ExplicitMpcRegion* regions{nullptr};
+  int region_count{0};
+};
+
+/**
+ * @brief Найти критическую область для вектора параметров.
+ * @return Индекс области или -1 (пустая/повреждённая таблица)
+ */
+[[nodiscard]] int ExplicitMpcLocate(
+    const ExplicitMpcPartition& part,
+    const float (&x)[kExplicitMpcParamDim]) noexcept;
+
+/**
+ * @brief Вычислить управление u = f·x + g в области, содержащей x.
+ * @param[out] u Управление (не меняется, если область не найдена)
+ * @return true если область найдена
+ */
+bool ExplicitMpcEvaluate(const ExplicitMpcPartition& part,
+                         const float (&x)[kExplicitMpcParamDim],
+                         float& u) noexcept;
+
+}  // namespace rc_vehicle
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @file fast_math.hpp
+ * @brief Быстрые atan2 / asin / 1/√x / sincos для горячего пути тика.
+ *
+ * На Xtensa (ESP32-S3) std::atan2, std::asin, std::sin/cos — программные
+ * вызовы libm по сотне-другой тактов с редукцией аргумента в double.
+ * Здесь — полиномы в float без вызовов libm, с документированной
+ * максимальной ошибкой (kFast*MaxErr*, проверяются test_fast_math.cpp по
+ * всему диапазону входа).
+ *
+ * Переход — по месту вызова через config::FastMathConfig:
+ * @code
+ * return Atan2<config::FastMathConfig::kSlipAngle>(vy, vx);
+ * @endcode
+ * Atan2<false> — это std::atan2, поэтому выключенный флаг не меняет ни бита.
+ */
+
+namespace rc_vehicle {
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Границы ошибки (относительно double-эталона)
+// ═══════════════════════════════════════════════════════════════════════════
+
+/// FastAtan2: абсолютная ошибка [рад] для конечных (y, x)
+inline constexpr float kFastAtan2MaxErrRad = 4.0e-6f;
+/// FastAsin: абсолютная ошибка [рад] на [-1, 1]
+inline constexpr float kFastAsinMaxErrRad = 1.0e-6f;
+/// FastInvSqrt: относительная ошибка для нормализованных x > 0
+inline constexpr float kFastInvSqrtMaxRelErr = 5.0e-7f;
+/// FastSinCos: абсолютная ошибка sin и cos при |x| ≤ kFastSinCosMaxArg
+inline constexpr float kFastSinCosMaxErr = 2.0e-7f;
+/// Предел аргумента FastSinCos [рад]: дальше растёт ошибка редукции
+inline constexpr float kFastSinCosMaxArg = 8192.0f;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Реализации
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief atan2(y, x): редукция к октанту + минимаксный полином 11-й степени.
+ *
+ * Одно деление. (0, 0) → 0 (std::atan2 даёт ±0 или ±π по знакам нулей).
+ */
+[[nodiscard]] inline float FastAtan2(float y, float x) noexcept {
+  constexpr float kPi = 3.14159265f;
+  constexpr float kHalfPi = 1.57079633f;
+  const float ax = std::fabs(x);
+  const float ay = std::fabs(y);
+  const float hi = ax > ay ? ax : ay;
+  const float lo = ax > ay ? ay : ax;
+  if (hi == 0.0f) return 0.0f;
+
+  const float a = lo / hi;  // [0, 1]
+  const float s = a * a;
+  float r = a * (0.99997726f +
+                 s * (-0.33262347f +
+                      s * (0.19354346f +
+                           s * (-0.11643287f +
+                                s * (0.05265332f + s * -0.01172120f)))));
+  if (ay > ax) r = kHalfPi - r;
+  if (x < 0.0f) r = kPi - r;
+  return y < 0.0f ? -r : r;
+}
+
+/**
+ * @brief 1/√x: начальное приближение по битам float + 3 итерации Ньютона.
+ *
+ * x ≤ 0 → 0 (как MadgwickFilter::InvSqrt). Денормали и inf — вне гарантии.
+ */
+[[nodiscard]] inline float FastInvSqrt(float x) noexcept {
+  if (x <= 0.0f) return 0.0f;
+  const float half = 0.5f * x;
+  float y = std::bit_cast<float>(0x5F375A86u -
+                                 (std::bit_cast<uint32_t>(x) >> 1));
+  y *= 1.5f - half * y * y;
+  y *= 1.5f - half * y * y;
+  y *= 1.5f - half * y * y;
+  return y;
+}
+
+/**
+ * @brief asin(x) = π/2 − √(1−|x|)·P₇(|x|) (Abramowitz–Stegun 4.4.46).
+ *
+ * Вход вне [-1, 1] прижимается к границе (вместо NaN у std::asin).
+ */
+[[nodiscard]] inline float FastAsin(float x) noexcept {
+  constexpr float kHalfPi = 1.57079633f;
+  float a = std::fabs(x);
+  if (a > 1.0f) a = 1.0f;
+  const float t = 1.0f - a;
+  const float p =
+      1.5707963050f +
+      a * (-0.2145988016f +
+           a * (0.0889789874f +
+                a * (-0.0501743046f +
+                     a * (0.0308918810f +
+                          a * (-0.0170881256f +
+                               a * (0.0066700901f + a * -0.0012624911f))))));
+  const float r = kHalfPi - t * FastInvSqrt(t) * p;
+  return x < 0.0f ? -r : r;
+}
+
+/**
+ * @brief sin и cos одного угла: редукция по π/2 (Коди–Уэйт) + полиномы
+ * на [-π/4, π/4].
+ */
+inline void FastSinCos(float x, float& s, float& c) noexcept {
+  constexpr float kTwoOverPi = 0.636619772f;
+  // π/2 = kC1 + kC2 + kC3: kC1 и kC2 точны в float, q·kC1 — без округления
+  constexpr float kC1 = 1.5703125f;
+  constexpr float kC2 = 4.837512969970703125e-4f;
+  constexpr float kC3 = 7.549789954891882e-8f;
+
+  const float qf = x * kTwoOverPi;
+  const auto q = static_cast<int32_t>(qf + (qf < 0.0f ? -0.5f : 0.5f));
+  const float qq = static_cast<float>(q);
+  const float r = ((x - qq * kC1) - qq * kC2) - qq * kC3;
+  const float r2 = r * r;
+
+  const float sr =
+      r + r * r2 *
+              (-1.6666654611e-1f +
+               r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+  const float cr =
+      1.0f - 0.5f * r2 +
+      r2 * r2 *
+          (4.166664568298827e-2f +
+           r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+
+  switch (q & 3) {
+    case 0:
+      s = sr;
+      c = cr;
+      break;
+    case 1:
+      s = cr;
+      c = -sr;
+      break;
+    case 2:
+      s = -sr;
+      c = -cr;
+      break;
+    default:
+      s = -cr;
+      c = sr;
+      break;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Выбор реализации по месту вызова (флаги config::FastMathConfig)
+// ═══════════════════════════════════════════════════════════════════════════
+
+template <bool kFast>
+[[nodiscard]] inline float Atan2(float y, float x) noexcept {
+  if constexpr (kFast) {
+    return FastAtan2(y, x);
+  } else {
+    return std::atan2(y, x);
+  }
+}
+
+template <bool kFast>
+[[nodiscard]] inline float Asin(float x) noexcept {
+  if constexpr (kFast) {
+    return FastAsin(x);
+  } else {
+    return std::asin(x);
+  }
+}
+
+/** 1/√x; x ≤ 0 → 0 в обоих вариантах. */
+template <bool kFast>
+[[nodiscard]] inline float InvSqrt(float x) noexcept {
+  if constexpr (kFast) {
+    return FastInvSqrt(x);
+  } else {
+    return x <= 0.0f ? 0.0f : 1.0f / std::sqrt(x);
+  }
+}
+
+/** √x; быстрый вариант — x·(1/√x), x ≤ 0 → 0. */
+template <bool kFast>
+[[nodiscard]] inline float Sqrt(float x) noexcept {
+  if constexpr (kFast) {
+    return x * FastInvSqrt(x);
+  } else {
+    return std::sqrt(x);
+  }
+}
+
+template <bool kFast>
+inline void SinCos(float x, float& s, float& c) noexcept {
+  if constexpr (kFast) {
+    FastSinCos(x, s, c);
+  } else {
+    s = std::sin(x);
+    c = std::cos(x);
+  }
+}
+
+}  // namespace rc_vehicle
@@ -0,0 +1,165 @@
+#include "filter_benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "cycle_counter.hpp"
+#include "fast_math.hpp"
+#include "imu_batch.hpp"
+#include "madgwick_filter.hpp"
+#include "online_sysid.hpp"
+#include "vehicle_ekf.hpp"
+
+namespace rc_vehicle {
+
+namespace {
+
+constexpr size_t kMinSamples = 16;
+constexpr int kRepeats = 3;
+constexpr float kDt = 0.002f;  // 500 Гц, как control loop
+
+float ToSamplesPerSec(size_t samples, uint32_t cycles) {
+  if (cycles == 0) return 0.0f;
+  return static_cast<float>(static_cast<double>(samples) * kCycleCounterHz /
+                            cycles);
+}
+
+/// Лучшее (минимальное) время из kRepeats прогонов fn().
+template <typename Fn>
+uint32_t BestOf(Fn&& fn) {
+  uint32_t best = UINT32_MAX;
+  for (int r = 0; r < kRepeats; ++r) {
+    const uint32_t t0 = ReadCycleCounter();
+    fn();
+    best = std::min(best, ReadCycleCounter() - t0);
+  }
+  return best;
+}
+
+/// Набор функций горячего пути на семпле: курс, тангаж, нормировка, поворот
+template <bool kFast>
+float MathKernel(float ax, float ay, float az, float gz) {
+  const float inv = InvSqrt<kFast>(ax * ax + ay * ay + az * az);
+  float s, c;
+  SinCos<kFast>(gz * kDt, s, c);
+  return Atan2<kFast>(ay, ax) + Asin<kFast>(ax * inv) + s + c;
+}
+
+bool SameBits(const std::vector<float>& a, const std::vector<float>& b) {
+  return a.size() == b.size() &&
+         std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+}  // namespace
+
+FilterBenchResult RunFilterBenchmark(size_t samples) {
+  const size_t n = std::clamp(samples, kMinSamples, kFilterBenchMaxSamples);
+  FilterBenchResult res{};
+  res.samples = static_cast<uint32_t>(n);
+
+  // Синтетический проезд: змейка с продольным разгоном
+  std::vector<float> ax(n), ay(n), az(n), gx(n), gy(n), gz(n);
+  for (size_t i = 0; i < n; ++i) {
+    const float t = static_cast<float>(i) * kDt;
+    ax[i] = 0.15f * std::sin(0.7f * t);
+    ay[i] = 0.3f * std::sin(2.1f * t);
+    az[i] = 1.0f + 0.02f * std::cos(5.0f * t);
+    gx[i] = 1.5f * std::sin(3.0f * t);
+    gy[i] = -1.0f * std::cos(2.5f * t);
+    gz[i] = 60.0f * std::sin(2.1f * t);
+  }
+  const float dt = kDt;
+  const ImuBatch batch{ax, ay, az, gx, gy, gz, {&dt, 1}};
+
+  // ─── Madgwick ──────────────────────────────────────────────────────────
+  std::vector<float> p1(n), r1(n), y1(n), p2(n), r2(n), y2(n);
+  const uint32_t mw_single = BestOf([&] {
+    MadgwickFilter filter;
+    IOrientationFilter& f = filter;  // как в ImuHandler — через интерфейс
+    for (size_t i = 0; i < n; ++i) {
+      f.Update(ax[i], ay[i], az[i], gx[i], gy[i], gz[i], dt);
+      f.GetEulerDeg(p1[i], r1[i], y1[i]);
+    }
+  });
+  const uint32_t mw_batch = BestOf([&] {
+    MadgwickFilter filter;
+    filter.UpdateBatch(batch, p2, r2, y2);
+  });
+
+  // ─── EKF ───────────────────────────────────────────────────────────────
+  std::vector<float> vx1(n), r_1(n), vx2(n), r_2(n);
+  const uint32_t ekf_single = BestOf([&] {
+    VehicleEkf ekf;
+    for (size_t i = 0; i < n; ++i) {
+      ekf.UpdateFromImu(ax[i], ay[i], az[i], gz[i], dt);
+      vx1[i] = ekf.GetVx();
+      r_1[i] = ekf.GetYawRate();
+    }
+  });
+  const uint32_t ekf_batch = BestOf([&] {
+    VehicleEkf ekf;
+    VehicleEkfBatchOutput out{};
+    out.vx = vx2;
+    out.yaw_rate = r_2;
+    ekf.UpdateFromImuBatch(batch, {}, out);
+  });
+
+  // ─── OnlineSysId ───────────────────────────────────────────────────────
+  // Руль/газ меняются — оба RLS проходят проверку возбуждения и считаются
+  std::vector<SysIdSample> sid(n);
+  for (size_t i = 0; i < n; ++i) {
+    const float t = static_cast<float>(i) * kDt;
+    sid[i].steering = 0.5f * std::sin(2.1f * t);
+    sid[i].throttle = 0.4f + 0.2f * std::sin(0.7f * t);
+    sid[i].yaw_rate_dps = gz[i];
+    sid[i].speed_ms = 2.0f + std::sin(0.7f * t);
+  }
+  const uint32_t sysid_total = BestOf([&] {
+    OnlineSysId id;
+    for (const SysIdSample& s : sid) id.Update(s);
+  });
+  {
+    OnlineSysId id;
+    for (const SysIdSample& s : sid) {
+      const uint32_t t0 = ReadCycleCounter();
+      id.Update(s);
+      res.sysid_max_tick_cycles =
+          std::max(res.sysid_max_tick_cycles, ReadCycleCounter() - t0);
+    }
+  }
+
+  // ─── fast_math ─────────────────────────────────────────────────────────
+  // Сумма уходит в volatile — компилятор не выбросит цикл
+  volatile float sink = 0.0f;
+  const uint32_t math_std = BestOf([&] {
+    float acc = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+      acc += MathKernel<false>(ax[i], ay[i], az[i], gz[i]);
+    }
+    sink = acc;
+  });
+  const uint32_t math_fast = BestOf([&] {
+    float acc = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+      acc += MathKernel<true>(ax[i], ay[i], az[i], gz[i]);
+    }
+    sink = acc;
+  });
+  (void)sink;
+
+  res.madgwick_single_sps = ToSamplesPerSec(n, mw_single);
+  res.madgwick_batch_sps = ToSamplesPerSec(n, mw_batch);
+  res.ekf_single_sps = ToSamplesPerSec(n, ekf_single);
+  res.ekf_batch_sps = ToSamplesPerSec(n, ekf_batch);
+  res.sysid_sps = ToSamplesPerSec(n, sysid_total);
+  res.math_std_sps = ToSamplesPerSec(n, math_std);
+  res.math_fast_sps = ToSamplesPerSec(n, math_fast);
+  res.outputs_match = SameBits(p1, p2) && SameBits(r1, r2) &&
+                      SameBits(y1, y2) && SameBits(vx1, vx2) &&
+                      SameBits(r_1, r_2);
+  return res;
+}
+
+}  // namespace rc_vehicle
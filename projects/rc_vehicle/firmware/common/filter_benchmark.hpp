@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rc_vehicle {
+
+/// Пакет в heap: 16 векторов float + SysIdSample (4 float) на семпл
+inline constexpr size_t kFilterBenchBytesPerSample = 20 * sizeof(float);
+
+/// Предел samples: на ESP32 пакет делит внутреннюю кучу с Wi‑Fi/lwIP
+/// (1000 × 80 Б ≈ 80 КБ), на хосте — 8 МБ
+#ifdef ESP_PLATFORM
+inline constexpr size_t kFilterBenchMaxSamples = 1000;
+#else
+inline constexpr size_t kFilterBenchMaxSamples = 100000;
+#endif
+
+/**
+ * @brief Результат RunFilterBenchmark: пропускная способность в семплах/с.
+ *
+ * single — поштучный путь (Update через IOrientationFilter, UpdateFromImu),
+ * batch — пакетный (UpdateBatch, UpdateFromImuBatch).
+ */
+struct FilterBenchResult {
+  uint32_t samples{0};
+  float madgwick_single_sps{0.0f};
+  float madgwick_batch_sps{0.0f};
+  float ekf_single_sps{0.0f};
+  float ekf_batch_sps{0.0f};
+  float sysid_sps{0.0f};  ///< Тиков OnlineSysId::Update в секунду
+  /// Худший тик OnlineSysId (граница окна: 2 шага RLS), такты/нс
+  uint32_t sysid_max_tick_cycles{0};
+  /// Наборов atan2 + asin + 1/√x + sincos в секунду: std:: и fast_math.hpp
+  float math_std_sps{0.0f};
+  float math_fast_sps{0.0f};
+  bool outputs_match{false};  ///< Пакетный результат бит-в-бит равен поштучному
+};
+
+/**
+ * @brief Замерить Madgwick/EKF/OnlineSysId и fast_math на синтетическом
+ * пакете семплов.
+ *
+ * Платформонезависимо: на ESP32 время в тактах CCOUNT, на хосте — в нс
+ * (см. cycle_counter.hpp). Берётся лучший из нескольких прогонов.
+ * Выделяет kFilterBenchBytesPerSample × samples байт в heap (20 векторов
+ * по samples float); вызывать вне control loop.
+ *
+ * @param samples Размер пакета (ограничивается [16, kFilterBenchMaxSamples])
+ */
+[[nodiscard]] FilterBenchResult RunFilterBenchmark(size_t samples);
+
+}  // namespace rc_vehicle
@@ -3,14 +3,18 @@
 #include <cstddef>
 #include <vector>
 
+#include "allan_variance.hpp"
 #include "com_offset_calibration.hpp"
 #include "self_test.hpp"
+#include "online_sysid.hpp"
+#include "shadow_stabilizer.hpp"
 #include "speed_calibration.hpp"
 #include "stabilization_config.hpp"
 #include "steering_trim_calibration.hpp"
 #include "telemetry_event_log.hpp"
 #include "telemetry_log.hpp"
 #include "test_runner.hpp"
+#include "vehicle_control_platform.hpp"
 
 namespace rc_vehicle {
 
@@ -25,7 +29,8 @@ class IVehicleControl {
   virtual ~IVehicleControl() = default;
 
   // Команда управления
-  virtual void OnWifiCommand(float throttle, float steering) = 0;
+  virtual void OnWifiCommand(float throttle, float steering,
+                             WifiCommandSource source) = 0;
 
   // Калибровка
   virtual void StartCalibration(bool full) = 0;
@@ -40,6 +45,23 @@ class IVehicleControl {
   virtual bool SetStabilizationConfig(const StabilizationConfig& config,
                                       bool save_to_nvs = true) = 0;
 
+  // Shadow-режим: кандидатная конфигурация без выхода на PWM
+  virtual bool StartShadowStabilization(
+      const StabilizationConfig& candidate) = 0;
+  virtual void StopShadowStabilization() = 0;
+  [[nodiscard]] virtual StabilizationConfig GetShadowCandidate() const = 0;
+  [[nodiscard]] virtual ShadowStats GetShadowStats() const = 0;
+
+  // Онлайн-идентификация динамики (руль → yaw rate, газ → скорость)
+  [[nodiscard]] virtual SysIdEstimate GetSysIdEstimate() const = 0;
+  virtual void SetSysIdApply(bool enabled) = 0;
+  [[nodiscard]] virtual bool IsSysIdApplyEnabled() const = 0;
+  virtual void ResetSysId() = 0;
+
+  // Шумы IMU по дисперсии Аллана (копятся на стоянке)
+  virtual void GetAllanReport(AllanReport& out) const = 0;
+  virtual void ResetAllan() = 0;
+
   // Kids mode
   virtual void SetKidsModeActive(bool active) = 0;
   [[nodiscard]] virtual bool IsKidsModeActive() const = 0;
@@ -65,6 +87,7 @@ class IVehicleControl {
   virtual void StopTest() = 0;
   [[nodiscard]] virtual bool IsTestActive() const = 0;
   [[nodiscard]] virtual TestRunner::Status GetTestStatus() const = 0;
+  [[nodiscard]] virtual TestRunner::Result GetTestResult() const = 0;
 
   // Калибровка скорости (throttle → speed gain)
   virtual bool StartSpeedCalibration(float target_throttle = 0.3f,
@@ -88,6 +111,9 @@ class IVehicleControl {
   // Телеметрия лог (кадры)
   virtual void GetLogInfo(size_t& count_out, size_t& cap_out) const = 0;
   virtual bool GetLogFrame(size_t idx, TelemetryLogFrame& out) const = 0;
+  virtual TelemetryLogSpan ReadLogSince(uint64_t seq, TelemetryLogFrame* out,
+                                        size_t max_frames,
+                                        size_t gap_skip) const = 0;
   virtual void ClearLog() = 0;
 
   // Лог событий (старт/стоп режимов и калибровок)
@@ -98,6 +124,8 @@ class IVehicleControl {
   // Диагностика
   [[nodiscard]] virtual std::vector<SelfTestItem> RunSelfTest() const = 0;
   [[nodiscard]] virtual bool IsReady() const noexcept = 0;
+  /** Машина стоит: нет авто-манёвра, |v| и |yaw rate| ниже порогов OTA. */
+  [[nodiscard]] virtual bool IsStationary() const = 0;
 };
 
 }  // namespace rc_vehicle
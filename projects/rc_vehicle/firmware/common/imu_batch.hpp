@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace rc_vehicle {
+
+/**
+ * @brief Пакет семплов IMU в формате SoA (structure of arrays).
+ *
+ * Используется пакетными методами фильтров (MadgwickFilter::UpdateBatch,
+ * VehicleEkf::UpdateFromImuBatch) для реплея логов и обработки FIFO.
+ * Единицы те же, что у поштучного API: ускорение в g, угловая скорость в °/с.
+ *
+ * dt — либо один элемент (общий шаг для всего пакета), либо по элементу на
+ * семпл.
+ */
+struct ImuBatch {
+  std::span<const float> ax, ay, az;  ///< Ускорение [g]
+  std::span<const float> gx, gy, gz;  ///< Угловая скорость [°/с]
+  std::span<const float> dt;          ///< Шаг [с]: 1 или Size() элементов
+
+  /** Количество семплов в пакете. */
+  [[nodiscard]] size_t Size() const noexcept { return ax.size(); }
+
+  /** Шаг индекса dt: 0 для общего шага, 1 для поштучного. */
+  [[nodiscard]] size_t DtStride() const noexcept {
+    return dt.size() == 1 ? 0 : 1;
+  }
+
+  /** true если все массивы одной длины, а dt — 1 или Size() элементов. */
+  [[nodiscard]] bool IsValid() const noexcept {
+    const size_t n = ax.size();
+    return ay.size() == n && az.size() == n && gx.size() == n &&
+           gy.size() == n && gz.size() == n &&
+           (dt.size() == 1 || dt.size() == n);
+  }
+};
+
+}  // namespace rc_vehicle
@@ -0,0 +1,158 @@
+#include "imu_fusion.hpp"
+
+#include <cmath>
+
+#include "config.hpp"
+
+namespace rc_vehicle {
+
+using Cfg = config::ImuFusionConfig;
+
+namespace {
+
+std::array<float, 6> ToAxes(const ImuData& d) {
+  return {d.ax, d.ay, d.az, d.gx, d.gy, d.gz};
+}
+
+ImuData FromAxes(const std::array<float, 6>& v) {
+  ImuData d;
+  d.ax = v[0];
+  d.ay = v[1];
+  d.az = v[2];
+  d.gx = v[3];
+  d.gy = v[4];
+  d.gz = v[5];
+  return d;
+}
+
+bool SameSample(const ImuData& a, const ImuData& b) {
+  return a.ax == b.ax && a.ay == b.ay && a.az == b.az && a.gx == b.gx &&
+         a.gy == b.gy && a.gz == b.gz;
+}
+
+/** Допуск по оси: 0–2 — акселерометр (g), 3–5 — гироскоп (dps). */
+constexpr float Tolerance(size_t axis) {
+  return axis < 3 ? Cfg::kAccelToleranceG : Cfg::kGyroToleranceDps;
+}
+
+}  // namespace
+
+const char* ImuDropReasonName(ImuDropReason r) noexcept {
+  switch (r) {
+    case ImuDropReason::None:
+      return "none";
+    case ImuDropReason::ReadFailures:
+      return "read_failures";
+    case ImuDropReason::Stuck:
+      return "stuck";
+    case ImuDropReason::OutVoted:
+      return "out_voted";
+  }
+  return "unknown";
+}
+
+size_t ImuFusion::ActiveUnits() const noexcept {
+  size_t n = 0;
+  for (const auto& h : health_) {
+    if (!h.dropped) ++n;
+  }
+  return n;
+}
+
+void ImuFusion::Drop(size_t unit, ImuDropReason reason) noexcept {
+  health_[unit].dropped = true;
+  health_[unit].reason = reason;
+}
+
+bool ImuFusion::Accept(size_t unit, const ImuData* d) noexcept {
+  ImuUnitHealth& h = health_[unit];
+  if (h.dropped) return false;
+  if (!d) {
+    ++h.total_read_failures;
+    if (++h.read_failures >= Cfg::kMaxReadFailures) {
+      Drop(unit, ImuDropReason::ReadFailures);
+    }
+    return false;
+  }
+  h.read_failures = 0;
+
+  // Живой датчик шумит в младших битах — повтор бит-в-бит долго не держится
+  if (have_raw_[unit] && SameSample(*d, last_raw_[unit])) {
+    if (++h.stuck >= Cfg::kStuckSamples) {
+      Drop(unit, ImuDropReason::Stuck);
+      return false;
+    }
+  } else {
+    h.stuck = 0;
+  }
+  last_raw_[unit] = *d;
+  have_raw_[unit] = true;
+  return true;
+}
+
+ImuFusion::Axes ImuFusion::Single(size_t unit,
+                                  const Axes& v) const noexcept {
+  // a = m + off/2, b = m − off/2, где m — среднее
+  const float sign = unit == 0 ? -0.5f : 0.5f;
+  Axes out;
+  for (size_t k = 0; k < out.size(); ++k) out[k] = v[k] + sign * offset_[k];
+  return out;
+}
+
+bool ImuFusion::Update(const ImuData* a, const ImuData* b,
+                       ImuData& out) noexcept {
+  const bool use_a = Accept(0, a);
+  const bool use_b = Accept(1, b);
+
+  Axes fused;
+  if (use_a && use_b) {
+    const Axes va = ToAxes(*a);
+    const Axes vb = ToAxes(*b);
+    bool agree = true;
+    for (size_t k = 0; k < va.size(); ++k) {
+      if (std::fabs(va[k] - vb[k] - offset_[k]) > Tolerance(k)) agree = false;
+    }
+
+    if (agree || !have_out_) {
+      for (size_t k = 0; k < va.size(); ++k) {
+        offset_[k] += Cfg::kOffsetAlpha * (va[k] - vb[k] - offset_[k]);
+        fused[k] = 0.5f * (va[k] + vb[k]);
+      }
+      if (agree) {
+        health_[0].lost_votes = 0;
+        health_[1].lost_votes = 0;
+      }
+    } else {
+      ++disagreements_;
+      // Голосование двух: прав тот, кто ближе к предыдущему результату
+      // (ошибка по осям в долях допуска)
+      const Axes sa = Single(0, va);
+      const Axes sb = Single(1, vb);
+      float err_a = 0.f, err_b = 0.f;
+      for (size_t k = 0; k < sa.size(); ++k) {
+        err_a += std::fabs(sa[k] - last_out_[k]) / Tolerance(k);
+        err_b += std::fabs(sb[k] - last_out_[k]) / Tolerance(k);
+      }
+      const size_t winner = err_a <= err_b ? 0 : 1;
+      const size_t loser = 1 - winner;
+      health_[winner].lost_votes = 0;
+      if (++health_[loser].lost_votes >= Cfg::kVoteDropSamples) {
+        Drop(loser, ImuDropReason::OutVoted);
+      }
+      fused = winner == 0 ? sa : sb;
+    }
+  } else if (use_a) {
+    fused = Single(0, ToAxes(*a));
+  } else if (use_b) {
+    fused = Single(1, ToAxes(*b));
+  } else {
+    return false;
+  }
+
+  last_out_ = fused;
+  have_out_ = true;
+  out = FromAxes(fused);
+  return true;
+}
+
+}  // namespace rc_vehicle
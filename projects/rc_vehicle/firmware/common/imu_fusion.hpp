@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "imu_sensor.hpp"
+
+namespace rc_vehicle {
+
+/** Причина отключения датчика в ImuFusion. */
+enum class ImuDropReason : uint8_t {
+  None = 0,
+  ReadFailures,  ///< Подряд ошибки чтения (SPI / датчик не отвечает)
+  Stuck,         ///< Показания не меняются (бит-в-бит) — датчик завис
+  OutVoted,      ///< Долго расходится с другим и проигрывает голосование
+};
+
+[[nodiscard]] const char* ImuDropReasonName(ImuDropReason r) noexcept;
+
+/** Состояние одного датчика в ImuFusion. */
+struct ImuUnitHealth {
+  bool dropped{false};
+  ImuDropReason reason{ImuDropReason::None};
+  uint16_t read_failures{0};  ///< Подряд ошибок чтения
+  uint16_t stuck{0};          ///< Подряд одинаковых семплов
+  uint16_t lost_votes{0};     ///< Подряд проигранных голосований
+  uint32_t total_read_failures{0};
+};
+
+/**
+ * @brief Слияние двух IMU (резервирование + усреднение по осям).
+ *
+ * Оба датчика согласны (по каждой оси разность за вычетом оценки постоянного
+ * смещения между ними в пределах config::ImuFusionConfig) — результат
+ * среднее, шум некоррелированных датчиков падает в √2 раз. Не согласны —
+ * голосование: берётся датчик, ближе к предыдущему результату; проигравший
+ * kVoteDropSamples раз подряд отключается. Также отключается датчик с
+ * kMaxReadFailures ошибками чтения подряд или зависший (kStuckSamples
+ * одинаковых семплов). Отключённый датчик не возвращается до Reset().
+ *
+ * Одиночный датчик выдаётся со сдвигом на половину смещения, т.е. в шкале
+ * среднего: переход между режимами не даёт ступеньки на выходе (калибровка
+ * нуля в ImuHandler остаётся верной).
+ *
+ * Оси датчиков должны совпадать (монтаж в одной ориентации).
+ */
+class ImuFusion {
+ public:
+  static constexpr size_t kUnits = 2;
+
+  /**
+   * @brief Слить показания одного тика
+   * @param a, b Показания датчиков 0 и 1 (nullptr — чтение не удалось)
+   * @param out Результат
+   * @return false — годных датчиков нет, out не изменён
+   */
+  bool Update(const ImuData* a, const ImuData* b, ImuData& out) noexcept;
+
+  void Reset() noexcept { *this = ImuFusion{}; }
+
+  [[nodiscard]] const ImuUnitHealth& Health(size_t unit) const noexcept {
+    return health_[unit];
+  }
+  /** Сколько датчиков не отключено (0…2). */
+  [[nodiscard]] size_t ActiveUnits() const noexcept;
+  /** Тиков, на которых датчики не согласились. */
+  [[nodiscard]] uint32_t Disagreements() const noexcept {
+    return disagreements_;
+  }
+  /** Оценка смещения a − b по осям (ax, ay, az, gx, gy, gz). */
+  [[nodiscard]] const std::array<float, 6>& Offset() const noexcept {
+    return offset_;
+  }
+
+ private:
+  using Axes = std::array<float, 6>;
+
+  bool Accept(size_t unit, const ImuData* d) noexcept;
+  void Drop(size_t unit, ImuDropReason reason) noexcept;
+  Axes Single(size_t unit, const Axes& v) const noexcept;
+
+  std::array<ImuUnitHealth, kUnits> health_{};
+  std::array<ImuData, kUnits> last_raw_{};
+  std::array<bool, kUnits> have_raw_{};
+  Axes offset_{};
+  Axes last_out_{};
+  bool have_out_{false};
+  uint32_t disagreements_{0};
+};
+
+}  // namespace rc_vehicle
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
 
 /** Данные IMU: акселерометр (g), гироскоп (dps). */
 struct ImuData {
@@ -24,6 +26,20 @@ class IImuSensor {
 
   /** Последнее значение WHO_AM_I (-1 = не читали). */
   virtual int GetLastWhoAmI() const = 0;
+
+  /** Максимальная длина бёрст-транзакции (с запасом до кратности 4 для DMA). */
+  static constexpr size_t kBurstMaxLen = 16;
+
+  /**
+   * Бёрст-чтение, разделённое на подготовку и разбор: платформа может
+   * поставить транзакции нескольких датчиков в очередь SPI подряд.
+   * Read() = PrepareBurst → Transfer → ParseBurst.
+   * @return Длина транзакции (≤ kBurstMaxLen), tx.size() ≥ kBurstMaxLen
+   */
+  virtual size_t PrepareBurst(std::span<uint8_t> tx) const = 0;
+
+  /** Разбор ответа бёрст-чтения. 0 — успех, -1 — ошибка. */
+  virtual int ParseBurst(std::span<const uint8_t> rx, ImuData& data) const = 0;
 };
 
 /** Конвертация ImuData в формат телеметрии (mg, mdps → int16). */
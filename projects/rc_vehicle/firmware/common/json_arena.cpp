@@ -0,0 +1,139 @@
+#include "json_arena.hpp"
+
+#include <atomic>
+#include <cstdlib>
+
+#include "cJSON.h"
+
+namespace rc_vehicle {
+
+// ─────────────────────────────────────────────────────────────────────────────
+// BumpArena
+// ─────────────────────────────────────────────────────────────────────────────
+
+void* BumpArena::Allocate(size_t n) noexcept {
+  constexpr size_t kAlign = alignof(std::max_align_t);
+  const size_t size = (n + kAlign - 1) & ~(kAlign - 1);
+  if (size < n || size > capacity_ - used_) return nullptr;
+  last_ = used_;
+  used_ += size;
+  if (used_ > high_water_) high_water_ = used_;
+  if (used_ > peak_) peak_ = used_;
+  return base_ + last_;
+}
+
+bool BumpArena::Release(void* p) noexcept {
+  if (!Owns(p)) return false;
+  if (last_ != kNoBlock && static_cast<uint8_t*>(p) == base_ + last_) {
+    used_ = last_;
+    last_ = kNoBlock;
+  }
+  return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// cJSON hooks
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+thread_local BumpArena* t_arena = nullptr;
+
+std::atomic<uint32_t> s_scopes{0};
+std::atomic<uint32_t> s_arena_allocs{0};
+std::atomic<uint32_t> s_heap_fallbacks{0};
+std::atomic<uint32_t> s_heap_fallback_bytes{0};
+std::atomic<uint32_t> s_unscoped_allocs{0};
+std::atomic<uint32_t> s_high_water{0};
+std::atomic<uint32_t> s_capacity{0};
+
+void* ArenaMalloc(size_t n) {
+  BumpArena* arena = t_arena;
+  if (!arena) {
+    s_unscoped_allocs.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(n);
+  }
+  if (void* p = arena->Allocate(n)) {
+    s_arena_allocs.fetch_add(1, std::memory_order_relaxed);
+    return p;
+  }
+  s_heap_fallbacks.fetch_add(1, std::memory_order_relaxed);
+  s_heap_fallback_bytes.fetch_add(static_cast<uint32_t>(n),
+                                  std::memory_order_relaxed);
+  return std::malloc(n);
+}
+
+void ArenaFree(void* p) {
+  if (!p) return;
+  BumpArena* arena = t_arena;
+  if (arena && arena->Release(p)) return;
+  std::free(p);
+}
+
+}  // namespace
+
+void JsonArenaInstallHooks() noexcept {
+  cJSON_Hooks hooks{};
+  hooks.malloc_fn = &ArenaMalloc;
+  hooks.free_fn = &ArenaFree;
+  cJSON_InitHooks(&hooks);
+}
+
+void JsonArenaRemoveHooks() noexcept { cJSON_InitHooks(nullptr); }
+
+JsonArenaStats JsonArenaGetStats() noexcept {
+  JsonArenaStats s;
+  s.scopes = s_scopes.load(std::memory_order_relaxed);
+  s.arena_allocs = s_arena_allocs.load(std::memory_order_relaxed);
+  s.heap_fallbacks = s_heap_fallbacks.load(std::memory_order_relaxed);
+  s.heap_fallback_bytes =
+      s_heap_fallback_bytes.load(std::memory_order_relaxed);
+  s.unscoped_allocs = s_unscoped_allocs.load(std::memory_order_relaxed);
+  s.high_water = s_high_water.load(std::memory_order_relaxed);
+  s.capacity = s_capacity.load(std::memory_order_relaxed);
+  return s;
+}
+
+void JsonArenaResetStats() noexcept {
+  s_scopes.store(0, std::memory_order_relaxed);
+  s_arena_allocs.store(0, std::memory_order_relaxed);
+  s_heap_fallbacks.store(0, std::memory_order_relaxed);
+  s_heap_fallback_bytes.store(0, std::memory_order_relaxed);
+  s_unscoped_allocs.store(0, std::memory_order_relaxed);
+  s_high_water.store(0, std::memory_order_relaxed);
+  s_capacity.store(0, std::memory_order_relaxed);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// JsonArenaScope
+// ─────────────────────────────────────────────────────────────────────────────
+
+JsonArenaScope::JsonArenaScope(BumpArena& arena) noexcept
+    : arena_(t_arena ? nullptr : &arena) {
+  if (arena_) {
+    arena_->ResetPeak();
+    t_arena = arena_;
+  }
+}
+
+JsonArenaScope::~JsonArenaScope() {
+  if (!arena_) return;
+  // Пик запроса, а не Used(): cJSON_free последней строки откатывает
+  // указатель. HighWater() не годится — он помнит запросы до
+  // JsonArenaResetStats
+  const auto peak = static_cast<uint32_t>(arena_->Peak());
+  uint32_t prev = s_high_water.load(std::memory_order_relaxed);
+  while (peak > prev) {
+    if (s_high_water.compare_exchange_weak(prev, peak,
+                                           std::memory_order_relaxed)) {
+      s_capacity.store(static_cast<uint32_t>(arena_->Capacity()),
+                       std::memory_order_relaxed);
+      break;
+    }
+  }
+  s_scopes.fetch_add(1, std::memory_order_relaxed);
+  arena_->Reset();
+  t_arena = nullptr;
+}
+
+}  // namespace rc_vehicle
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file json_arena.hpp
+ * @brief Bump-арена для cJSON: выделение сдвигом указателя, сброс после
+ * запроса.
+ *
+ * Ответ WS-команды собирает дерево cJSON из десятков мелких узлов и строк,
+ * печатает его и сразу освобождает. Через malloc это десятки блоков на
+ * запрос во внутренней куче, которую делят Wi-Fi и lwIP, — со временем
+ * она фрагментируется. JsonArenaInstallHooks() направляет cJSON_InitHooks
+ * в арену задачи: внутри JsonArenaScope каждое выделение — сдвиг указателя
+ * в статическом буфере, free — no-op, а в конце запроса арена сбрасывается
+ * целиком. Переполнение не ломает запрос: выделение уходит в кучу и
+ * считается (heap_fallbacks), чтобы размер арены можно было подобрать по
+ * метрикам (WS get_json_arena).
+ *
+ * Арена привязывается к потоку (thread_local), поэтому задачи без
+ * JsonArenaScope и другие задачи работают с кучей как раньше. Объекты cJSON
+ * и строки cJSON_Print* не должны переживать scope; освобождать строки
+ * cJSON_Print* — только cJSON_free, не free().
+ *
+ * @code
+ * static StaticBumpArena<4096> arena;
+ * {
+ *   JsonArenaScope scope(arena);
+ *   cJSON* reply = cJSON_CreateObject();
+ *   ...
+ *   char* str = cJSON_PrintUnformatted(reply);
+ *   send(str);
+ *   cJSON_free(str);
+ *   cJSON_Delete(reply);
+ * }  // арена сброшена
+ * @endcode
+ */
+
+namespace rc_vehicle {
+
+/**
+ * @brief Линейная арена над внешним буфером. Не потокобезопасна.
+ */
+class BumpArena {
+ public:
+  BumpArena(void* buf, size_t capacity) noexcept
+      : base_(static_cast<uint8_t*>(buf)), capacity_(capacity) {}
+
+  BumpArena(const BumpArena&) = delete;
+  BumpArena& operator=(const BumpArena&) = delete;
+
+  /** Выделить n байт (выравнивание max_align_t); nullptr — не хватило. */
+  [[nodiscard]] void* Allocate(size_t n) noexcept;
+
+  /**
+   * @brief Вернуть блок арене.
+   *
+   * Последний выделенный блок откатывается (LIFO), остальные освобождаются
+   * только при Reset().
+   * @return false — p не из арены
+   */
+  bool Release(void* p) noexcept;
+
+  [[nodiscard]] bool Owns(const void* p) const noexcept {
+    const auto* b = static_cast<const uint8_t*>(p);
+    return b >= base_ && b < base_ + capacity_;
+  }
+
+  /** Освободить всё; пик использования сохраняется. */
+  void Reset() noexcept {
+    used_ = 0;
+    last_ = kNoBlock;
+  }
+
+  /** Начать окно измерения пика (Peak) с текущего использования. */
+  void ResetPeak() noexcept { peak_ = used_; }
+
+  [[nodiscard]] size_t Used() const noexcept { return used_; }
+  [[nodiscard]] size_t HighWater() const noexcept { return high_water_; }
+  /** Пик использования с последнего ResetPeak(). */
+  [[nodiscard]] size_t Peak() const noexcept { return peak_; }
+  [[nodiscard]] size_t Capacity() const noexcept { return capacity_; }
+
+ private:
+  static constexpr size_t kNoBlock = static_cast<size_t>(-1);
+
+  uint8_t* base_;
+  size_t capacity_;
+  size_t used_{0};
+  size_t last_{kNoBlock};  ///< Смещение последнего блока (для LIFO)
+  size_t high_water_{0};
+  size_t peak_{0};
+};
+
+/** Арена со встроенным буфером (для static и членов класса). */
+template <size_t N>
+class StaticBumpArena : public BumpArena {
+ public:
+  StaticBumpArena() noexcept : BumpArena(storage_, N) {}
+
+ private:
+  alignas(std::max_align_t) uint8_t storage_[N];
+};
+
+/** Счётчики хуков cJSON (все задачи). */
+struct JsonArenaStats {
+  uint32_t scopes{0};               ///< Завершённых JsonArenaScope
+  uint32_t arena_allocs{0};         ///< Выделений из арены
+  uint32_t heap_fallbacks{0};       ///< Выделений в куче: арена переполнена
+  uint32_t heap_fallback_bytes{0};  ///< Их суммарный размер
+  uint32_t unscoped_allocs{0};      ///< Выделений cJSON вне JsonArenaScope
+  uint32_t high_water{0};           ///< Пик использования арены за запрос
+  uint32_t capacity{0};  ///< Ёмкость арены, на которой достигнут пик
+};
+
+/** Направить cJSON_InitHooks в арену текущего JsonArenaScope. */
+void JsonArenaInstallHooks() noexcept;
+
+/** Вернуть cJSON к malloc/free. */
+void JsonArenaRemoveHooks() noexcept;
+
+[[nodiscard]] JsonArenaStats JsonArenaGetStats() noexcept;
+void JsonArenaResetStats() noexcept;
+
+/**
+ * @brief Привязать арену к текущему потоку на время запроса.
+ *
+ * Деструктор обновляет пик в JsonArenaStats пиком этого запроса (не всей
+ * жизни арены) и сбрасывает арену. Вложенный scope в том же потоке
+ * продолжает внешний (без сброса).
+ */
+class JsonArenaScope {
+ public:
+  explicit JsonArenaScope(BumpArena& arena) noexcept;
+  ~JsonArenaScope();
+
+  JsonArenaScope(const JsonArenaScope&) = delete;
+  JsonArenaScope& operator=(const JsonArenaScope&) = delete;
+
+ private:
+  BumpArena* arena_;  ///< nullptr — вложенный scope
+};
+
+}  // namespace rc_vehicle
@@ -0,0 +1,422 @@
+#include "json_reader.hpp"
+
+#include <charconv>
+#include <cstring>
+
+namespace rc_vehicle {
+
+namespace {
+
+// ─── Лексика ─────────────────────────────────────────────────────────────────
+
+/** Что допустимо следующим (после пропуска пробелов). */
+enum class Expect : uint8_t {
+  Value,       ///< Значение: корень, после ':' или ',' в массиве
+  ValueOrEnd,  ///< Первый элемент массива или ']'
+  Key,         ///< Ключ после ',' в объекте
+  KeyOrEnd,    ///< Первый ключ объекта или '}'
+  Colon,
+  CommaOrEnd,
+  Done,  ///< Корень разобран, дальше только пробелы
+};
+
+inline bool IsWs(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool ReadHex4(const char* buf, size_t len, size_t pos, uint32_t& out) {
+  if (pos + 4 > len) return false;
+  out = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    const char c = buf[pos + i];
+    uint32_t d;
+    if (c >= '0' && c <= '9') {
+      d = static_cast<uint32_t>(c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+      d = static_cast<uint32_t>(c - 'a' + 10);
+    } else if (c >= 'A' && c <= 'F') {
+      d = static_cast<uint32_t>(c - 'A' + 10);
+    } else {
+      return false;
+    }
+    out = (out << 4) | d;
+  }
+  return true;
+}
+
+size_t EncodeUtf8(uint32_t cp, char* out) {
+  if (cp < 0x80) {
+    out[0] = static_cast<char>(cp);
+    return 1;
+  }
+  if (cp < 0x800) {
+    out[0] = static_cast<char>(0xC0 | (cp >> 6));
+    out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 2;
+  }
+  if (cp < 0x10000) {
+    out[0] = static_cast<char>(0xE0 | (cp >> 12));
+    out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 3;
+  }
+  out[0] = static_cast<char>(0xF0 | (cp >> 18));
+  out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+  out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+  out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+  return 4;
+}
+
+/**
+ * Строка с buf[pos] (после открывающей кавычки): escape раскрываются на
+ * месте — запись никогда не обгоняет чтение (\\uXXXX → ≤ 3 байта,
+ * суррогатная пара → 4), на месте конца пишется '\0'. pos — за кавычкой.
+ */
+bool ScanString(char* buf, size_t len, size_t& pos, size_t& out_len) {
+  const size_t begin = pos;
+  size_t w = pos;
+  while (pos < len) {
+    const char c = buf[pos];
+    if (c == '"') {
+      out_len = w - begin;
+      buf[w] = '\0';
+      ++pos;
+      return true;
+    }
+    if (static_cast<unsigned char>(c) < 0x20) return false;
+    if (c != '\\') {
+      buf[w++] = c;
+      ++pos;
+      continue;
+    }
+    if (++pos >= len) return false;
+    switch (buf[pos]) {
+      case '"':
+      case '\\':
+      case '/':
+        buf[w++] = buf[pos];
+        break;
+      case 'b':
+        buf[w++] = '\b';
+        break;
+      case 'f':
+        buf[w++] = '\f';
+        break;
+      case 'n':
+        buf[w++] = '\n';
+        break;
+      case 'r':
+        buf[w++] = '\r';
+        break;
+      case 't':
+        buf[w++] = '\t';
+        break;
+      case 'u': {
+        uint32_t cp = 0;
+        if (!ReadHex4(buf, len, pos + 1, cp)) return false;
+        pos += 4;
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+          // Старший суррогат: обязателен \uDC00…\uDFFF следом
+          uint32_t lo = 0;
+          if (pos + 2 >= len || buf[pos + 1] != '\\' || buf[pos + 2] != 'u' ||
+              !ReadHex4(buf, len, pos + 3, lo) || lo < 0xDC00 || lo > 0xDFFF) {
+            return false;
+          }
+          cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+          pos += 6;
+        } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+          return false;
+        }
+        w += EncodeUtf8(cp, buf + w);
+        break;
+      }
+      default:
+        return false;
+    }
+    ++pos;
+  }
+  return false;
+}
+
+/** -?(0|[1-9]d*)(.d+)?([eE][+-]?d+)? */
+bool ScanNumber(const char* buf, size_t len, size_t& pos) {
+  size_t p = pos;
+  if (p < len && buf[p] == '-') ++p;
+  if (p >= len || !IsDigit(buf[p])) return false;
+  if (buf[p] == '0') {
+    ++p;
+  } else {
+    while (p < len && IsDigit(buf[p])) ++p;
+  }
+  if (p < len && buf[p] == '.') {
+    ++p;
+    if (p >= len || !IsDigit(buf[p])) return false;
+    while (p < len && IsDigit(buf[p])) ++p;
+  }
+  if (p < len && (buf[p] == 'e' || buf[p] == 'E')) {
+    ++p;
+    if (p < len && (buf[p] == '+' || buf[p] == '-')) ++p;
+    if (p >= len || !IsDigit(buf[p])) return false;
+    while (p < len && IsDigit(buf[p])) ++p;
+  }
+  pos = p;
+  return true;
+}
+
+bool ScanLiteral(const char* buf, size_t len, size_t pos, const char* lit,
+                 size_t lit_len) {
+  return pos + lit_len <= len && std::memcmp(buf + pos, lit, lit_len) == 0;
+}
+
+}  // namespace
+
+const char* JsonErrorName(JsonError e) noexcept {
+  switch (e) {
+    case JsonError::Empty:
+      return "empty";
+    case JsonError::Syntax:
+      return "syntax";
+    case JsonError::TooManyTokens:
+      return "too_many_tokens";
+    case JsonError::TooDeep:
+      return "too_deep";
+    case JsonError::TooLong:
+      return "too_long";
+  }
+  return "unknown";
+}
+
+// ─── Токенизатор ─────────────────────────────────────────────────────────────
+
+Result<JsonValue, JsonError> JsonParseInSitu(
+    char* buf, size_t len, std::span<JsonToken> tokens) noexcept {
+  using R = Result<JsonValue, JsonError>;
+  if (len > UINT16_MAX) return R{JsonError::TooLong};
+
+  uint16_t stack[kJsonMaxDepth];  // Индексы открытых контейнеров
+  size_t depth = 0;
+  size_t n = 0;
+  size_t pos = 0;
+  Expect st = Expect::Value;
+
+  auto push = [&](JsonType type, size_t start, size_t l) {
+    if (n >= tokens.size() || n >= UINT16_MAX) return false;
+    tokens[n] = {type, static_cast<uint16_t>(start), static_cast<uint16_t>(l),
+                 static_cast<uint16_t>(n + 1)};
+    ++n;
+    return true;
+  };
+
+  while (true) {
+    while (pos < len && IsWs(buf[pos])) ++pos;
+    if (pos >= len) break;
+    const char c = buf[pos];
+
+    if (st == Expect::Done) return R{JsonError::Syntax};
+
+    if (st == Expect::Colon) {
+      if (c != ':') return R{JsonError::Syntax};
+      ++pos;
+      st = Expect::Value;
+      continue;
+    }
+
+    if ((c == '}' || c == ']') &&
+        (st == Expect::CommaOrEnd || st == Expect::KeyOrEnd ||
+         st == Expect::ValueOrEnd)) {
+      JsonToken& open = tokens[stack[depth - 1]];
+      if (open.type != (c == '}' ? JsonType::Object : JsonType::Array)) {
+        return R{JsonError::Syntax};
+      }
+      open.len = static_cast<uint16_t>(pos + 1 - open.start);
+      open.next = static_cast<uint16_t>(n);
+      --depth;
+      ++pos;
+      st = depth == 0 ? Expect::Done : Expect::CommaOrEnd;
+      continue;
+    }
+
+    if (st == Expect::CommaOrEnd) {
+      if (c != ',') return R{JsonError::Syntax};
+      ++pos;
+      st = tokens[stack[depth - 1]].type == JsonType::Object ? Expect::Key
+                                                             : Expect::Value;
+      continue;
+    }
+
+    if (st == Expect::Key || st == Expect::KeyOrEnd) {
+      if (c != '"') return R{JsonError::Syntax};
+      const size_t start = ++pos;
+      size_t l = 0;
+      if (!ScanString(buf, len, pos, l)) return R{JsonError::Syntax};
+      if (!push(JsonType::String, start, l)) {
+        return R{JsonError::TooManyTokens};
+      }
+      st = Expect::Colon;
+      continue;
+    }
+
+    // Значение (Value / ValueOrEnd)
+    if (c == '{' || c == '[') {
+      if (depth >= kJsonMaxDepth) return R{JsonError::TooDeep};
+      if (!push(c == '{' ? JsonType::Object : JsonType::Array, pos, 0)) {
+        return R{JsonError::TooManyTokens};
+      }
+      stack[depth++] = static_cast<uint16_t>(n - 1);
+      ++pos;
+      st = c == '{' ? Expect::KeyOrEnd : Expect::ValueOrEnd;
+      continue;
+    }
+
+    const size_t start = pos;
+    if (c == '"') {
+      size_t l = 0;
+      ++pos;
+      if (!ScanString(buf, len, pos, l)) return R{JsonError::Syntax};
+      if (!push(JsonType::String, start + 1, l)) {
+        return R{JsonError::TooManyTokens};
+      }
+    } else {
+      JsonType type;
+      if (ScanLiteral(buf, len, pos, "true", 4) ||
+          ScanLiteral(buf, len, pos, "null", 4)) {
+        type = c == 'n' ? JsonType::Null : JsonType::Bool;
+        pos += 4;
+      } else if (ScanLiteral(buf, len, pos, "false", 5)) {
+        type = JsonType::Bool;
+        pos += 5;
+      } else if (ScanNumber(buf, len, pos)) {
+        type = JsonType::Number;
+      } else {
+        return R{JsonError::Syntax};
+      }
+      if (!push(type, start, pos - start)) return R{JsonError::TooManyTokens};
+    }
+    st = depth == 0 ? Expect::Done : Expect::CommaOrEnd;
+  }
+
+  if (st != Expect::Done) {
+    return R{n == 0 ? JsonError::Empty : JsonError::Syntax};
+  }
+  return R{JsonValue(buf, tokens.data(), 0)};
+}
+
+// ─── JsonValue ───────────────────────────────────────────────────────────────
+
+JsonValue JsonValue::Get(std::string_view key) const noexcept {
+  if (!IsObject()) return {};
+  const uint16_t end = tokens_[idx_].next;
+  for (uint16_t k = idx_ + 1; k < end; k = tokens_[k + 1].next) {
+    const JsonToken& t = tokens_[k];
+    if (t.len == key.size() &&
+        std::memcmp(buf_ + t.start, key.data(), key.size()) == 0) {
+      return JsonValue(buf_, tokens_, k + 1);
+    }
+  }
+  return {};
+}
+
+size_t JsonValue::Size() const noexcept {
+  const JsonType type = Type();
+  if (type != JsonType::Object && type != JsonType::Array) return 0;
+  const uint16_t end = tokens_[idx_].next;
+  const uint16_t step = type == JsonType::Object ? 1 : 0;  // Пропуск ключа
+  size_t count = 0;
+  for (uint16_t k = idx_ + 1; k < end; k = tokens_[k + step].next) ++count;
+  return count;
+}
+
+JsonValue JsonValue::At(size_t i) const noexcept {
+  if (!IsArray()) return {};
+  const uint16_t end = tokens_[idx_].next;
+  for (uint16_t k = idx_ + 1; k < end; k = tokens_[k].next) {
+    if (i-- == 0) return JsonValue(buf_, tokens_, k);
+  }
+  return {};
+}
+
+const char* JsonValue::AsString() const noexcept {
+  return IsString() ? buf_ + tokens_[idx_].start : nullptr;
+}
+
+std::string_view JsonValue::Str() const noexcept {
+  if (!IsString()) return {};
+  return {buf_ + tokens_[idx_].start, tokens_[idx_].len};
+}
+
+std::optional<double> JsonValue::AsDouble() const noexcept {
+  if (!IsNumber()) return std::nullopt;
+  const char* s = buf_ + tokens_[idx_].start;
+  double v = 0.0;
+  const auto r = std::from_chars(s, s + tokens_[idx_].len, v);
+  if (r.ec != std::errc{}) return std::nullopt;
+  return v;
+}
+
+std::optional<float> JsonValue::AsFloat() const noexcept {
+  const auto d = AsDouble();
+  if (!d) return std::nullopt;
+  return static_cast<float>(*d);
+}
+
+std::optional<int32_t> JsonValue::AsInt() const noexcept {
+  const auto d = AsDouble();
+  if (!d) return std::nullopt;
+  if (*d >= static_cast<double>(INT32_MAX)) return INT32_MAX;
+  if (*d <= static_cast<double>(INT32_MIN)) return INT32_MIN;
+  return static_cast<int32_t>(*d);
+}
+
+std::optional<uint32_t> JsonValue::AsUint() const noexcept {
+  const auto d = AsDouble();
+  if (!d || *d < 0.0) return std::nullopt;
+  if (*d >= static_cast<double>(UINT32_MAX)) return UINT32_MAX;
+  return static_cast<uint32_t>(*d);
+}
+
+std::optional<bool> JsonValue::AsBool() const noexcept {
+  if (!IsBool()) return std::nullopt;
+  return buf_[tokens_[idx_].start] == 't';
+}
+
+namespace {
+
+template <typename V>
+bool StoreIf(const std::optional<V>& v, V& out) {
+  if (!v) return false;
+  out = *v;
+  return true;
+}
+
+}  // namespace
+
+bool JsonValue::Read(std::string_view key, float& out) const noexcept {
+  return StoreIf(Get(key).AsFloat(), out);
+}
+
+bool JsonValue::Read(std::string_view key, double& out) const noexcept {
+  return StoreIf(Get(key).AsDouble(), out);
+}
+
+bool JsonValue::Read(std::string_view key, int32_t& out) const noexcept {
+  return StoreIf(Get(key).AsInt(), out);
+}
+
+bool JsonValue::Read(std::string_view key, uint32_t& out) const noexcept {
+  return StoreIf(Get(key).AsUint(), out);
+}
+
+bool JsonValue::Read(std::string_view key, bool& out) const noexcept {
+  return StoreIf(Get(key).AsBool(), out);
+}
+
+bool JsonValue::Read(std::string_view key, const char*& out) const noexcept {
+  const char* s = Get(key).AsString();
+  if (!s) return false;
+  out = s;
+  return true;
+}
+
+}  // namespace rc_vehicle
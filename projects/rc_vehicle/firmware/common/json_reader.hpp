@@ -0,0 +1,323 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "result.hpp"
+
+/**
+ * @file json_reader.hpp
+ * @brief Разбор входящего JSON на месте (in situ), без выделения памяти.
+ *
+ * Токенизатор в стиле jsmn: один проход по буферу приёма, результат —
+ * плоский массив JsonToken фиксированного размера (дерево в прямом порядке,
+ * у каждого токена — индекс первого токена за его поддеревом). Строки
+ * раскрываются (escape, \\uXXXX → UTF-8) и завершаются '\0' прямо в буфере,
+ * поэтому AsString() — указатель в буфер. Числа читаются при обращении
+ * (std::from_chars). Ни malloc, ни исключений.
+ *
+ * После разбора буфер изменён и должен жить, пока используются JsonValue.
+ *
+ * @code
+ * std::array<JsonToken, 64> tokens;
+ * auto parsed = JsonParseInSitu(buf, len, tokens);
+ * if (IsOk(parsed)) {
+ *   JsonValue json = GetValue(parsed);
+ *   float thr = json["throttle"].AsFloat().value_or(0.0f);
+ * }
+ * @endcode
+ */
+
+namespace rc_vehicle {
+
+/** Тип значения JSON. */
+enum class JsonType : uint8_t {
+  Invalid = 0,  ///< Нет значения (ключ не найден, индекс вне массива)
+  Null,
+  Bool,
+  Number,
+  String,
+  Array,
+  Object,
+};
+
+/** Токен: значение или ключ объекта (8 байт). */
+struct JsonToken {
+  JsonType type{JsonType::Invalid};
+  uint16_t start{0};  ///< Смещение в буфере (строка — после кавычки)
+  uint16_t len{0};    ///< Длина (строка — после раскрытия escape)
+  uint16_t next{0};   ///< Индекс токена за поддеревом
+};
+
+/** Ошибки JsonParseInSitu. */
+enum class JsonError : uint8_t {
+  Empty = 1,      ///< Нет значения (пустой буфер или только пробелы)
+  Syntax,         ///< Некорректный JSON
+  TooManyTokens,  ///< Не хватило массива токенов
+  TooDeep,        ///< Вложенность больше kJsonMaxDepth
+  TooLong,        ///< Буфер больше 65535 байт
+};
+
+[[nodiscard]] const char* JsonErrorName(JsonError e) noexcept;
+
+/// Максимальная вложенность объектов/массивов
+inline constexpr size_t kJsonMaxDepth = 16;
+
+/**
+ * @brief Лёгкое представление значения: буфер + токены + индекс.
+ *
+ * Копируется по значению. Отсутствующее значение — Type() == Invalid;
+ * все методы на нём безопасны и возвращают «пусто».
+ */
+class JsonValue {
+ public:
+  JsonValue() = default;
+
+  [[nodiscard]] bool Valid() const noexcept { return tokens_ != nullptr; }
+  [[nodiscard]] JsonType Type() const noexcept {
+    return Valid() ? tokens_[idx_].type : JsonType::Invalid;
+  }
+  [[nodiscard]] bool IsObject() const noexcept {
+    return Type() == JsonType::Object;
+  }
+  [[nodiscard]] bool IsArray() const noexcept {
+    return Type() == JsonType::Array;
+  }
+  [[nodiscard]] bool IsString() const noexcept {
+    return Type() == JsonType::String;
+  }
+  [[nodiscard]] bool IsNumber() const noexcept {
+    return Type() == JsonType::Number;
+  }
+  [[nodiscard]] bool IsBool() const noexcept {
+    return Type() == JsonType::Bool;
+  }
+  [[nodiscard]] bool IsNull() const noexcept {
+    return Type() == JsonType::Null;
+  }
+
+  /** Член объекта по ключу (первый при повторах); Invalid, если нет. */
+  [[nodiscard]] JsonValue Get(std::string_view key) const noexcept;
+  [[nodiscard]] JsonValue operator[](std::string_view key) const noexcept {
+    return Get(key);
+  }
+
+  /** Число элементов массива или пар объекта; 0 для прочих. */
+  [[nodiscard]] size_t Size() const noexcept;
+
+  /** Элемент массива i; Invalid вне диапазона. */
+  [[nodiscard]] JsonValue At(size_t i) const noexcept;
+
+  /** fn(std::string_view key, JsonValue value) для каждой пары объекта. */
+  template <typename Fn>
+  void ForEachMember(Fn&& fn) const {
+    if (!IsObject()) return;
+    for (uint16_t k = idx_ + 1; k < tokens_[idx_].next;
+         k = tokens_[k + 1].next) {
+      fn(std::string_view(buf_ + tokens_[k].start, tokens_[k].len),
+         JsonValue(buf_, tokens_, k + 1));
+    }
+  }
+
+  // ── Типизированное чтение ────────────────────────────────────────────────
+
+  /** Строка, завершённая '\0' в буфере; nullptr, если не строка. */
+  [[nodiscard]] const char* AsString() const noexcept;
+  /** Строка с длиной (может содержать '\0' из \\u0000); пусто, если нет. */
+  [[nodiscard]] std::string_view Str() const noexcept;
+  [[nodiscard]] std::optional<double> AsDouble() const noexcept;
+  [[nodiscard]] std::optional<float> AsFloat() const noexcept;
+  /** Целое с насыщением до int32, дробная часть отбрасывается (как cJSON). */
+  [[nodiscard]] std::optional<int32_t> AsInt() const noexcept;
+  /** То же до uint32; отрицательные — нет значения. */
+  [[nodiscard]] std::optional<uint32_t> AsUint() const noexcept;
+  [[nodiscard]] std::optional<bool> AsBool() const noexcept;
+
+  /**
+   * @brief Прочитать член key в out, если он есть и подходящего типа.
+   * @return true, если out обновлён (иначе out не меняется)
+   */
+  bool Read(std::string_view key, float& out) const noexcept;
+  bool Read(std::string_view key, double& out) const noexcept;
+  bool Read(std::string_view key, int32_t& out) const noexcept;
+  bool Read(std::string_view key, uint32_t& out) const noexcept;
+  bool Read(std::string_view key, bool& out) const noexcept;
+  bool Read(std::string_view key, const char*& out) const noexcept;
+
+ private:
+  friend Result<JsonValue, JsonError> JsonParseInSitu(
+      char* buf, size_t len, std::span<JsonToken> tokens) noexcept;
+
+  JsonValue(const char* buf, const JsonToken* tokens, uint16_t idx) noexcept
+      : buf_(buf), tokens_(tokens), idx_(idx) {}
+
+  const char* buf_{nullptr};
+  const JsonToken* tokens_{nullptr};
+  uint16_t idx_{0};
+};
+
+/**
+ * @brief Разобрать JSON в buf[0, len) на месте.
+ *
+ * Пишет только внутри buf[0, len) (раскрытые строки и их '\0'); строгий
+ * RFC 8259, без комментариев и висячих запятых. Корень — токен 0.
+ *
+ * @param tokens Массив токенов; нужен 1 токен на значение и на ключ
+ */
+[[nodiscard]] Result<JsonValue, JsonError> JsonParseInSitu(
+    char* buf, size_t len, std::span<JsonToken> tokens) noexcept;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Схемы полей
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Поле схемы: ключ JSON → член структуры аргументов T.
+ *
+ * Тип определяется типом члена: float, double, int32_t, uint32_t, bool,
+ * const char* (указатель в буфер), std::optional<float/int32_t/bool>
+ * (отличить «нет поля» от значения по умолчанию) и JsonValue (вложенный
+ * объект/массив как есть). Поле другого типа в JSON пропускается; при
+ * повторе ключа учитывается только первый (как JsonValue::Get и cJSON).
+ *
+ * @code
+ * struct Args {
+ *   const char* mode = "gyro";
+ *   float target_accel = 0.1f;
+ * };
+ * constexpr JsonField<Args> kSchema[] = {
+ *     {"mode", &Args::mode},
+ *     {"target_accel", &Args::target_accel},
+ * };
+ * Args args;
+ * JsonBind(json, kSchema, args);
+ * @endcode
+ */
+template <typename T>
+class JsonField {
+ public:
+  constexpr JsonField(const char* key, float T::*m) noexcept
+      : key_(key), kind_(Kind::Float), m_{.f = m} {}
+  constexpr JsonField(const char* key, double T::*m) noexcept
+      : key_(key), kind_(Kind::Double), m_{.d = m} {}
+  constexpr JsonField(const char* key, int32_t T::*m) noexcept
+      : key_(key), kind_(Kind::Int), m_{.i = m} {}
+  constexpr JsonField(const char* key, uint32_t T::*m) noexcept
+      : key_(key), kind_(Kind::Uint), m_{.u = m} {}
+  constexpr JsonField(const char* key, bool T::*m) noexcept
+      : key_(key), kind_(Kind::Bool), m_{.b = m} {}
+  constexpr JsonField(const char* key, const char* T::*m) noexcept
+      : key_(key), kind_(Kind::String), m_{.s = m} {}
+  constexpr JsonField(const char* key, std::optional<float> T::*m) noexcept
+      : key_(key), kind_(Kind::OptFloat), m_{.of = m} {}
+  constexpr JsonField(const char* key, std::optional<int32_t> T::*m) noexcept
+      : key_(key), kind_(Kind::OptInt), m_{.oi = m} {}
+  constexpr JsonField(const char* key, std::optional<bool> T::*m) noexcept
+      : key_(key), kind_(Kind::OptBool), m_{.ob = m} {}
+  constexpr JsonField(const char* key, JsonValue T::*m) noexcept
+      : key_(key), kind_(Kind::Value), m_{.v = m} {}
+
+  [[nodiscard]] std::string_view Key() const noexcept { return key_; }
+
+  /** Записать v в член out; false, если тип не подходит. */
+  bool Apply(JsonValue v, T& out) const noexcept {
+    switch (kind_) {
+      case Kind::Float:
+        return Store(v.AsFloat(), out.*m_.f);
+      case Kind::Double:
+        return Store(v.AsDouble(), out.*m_.d);
+      case Kind::Int:
+        return Store(v.AsInt(), out.*m_.i);
+      case Kind::Uint:
+        return Store(v.AsUint(), out.*m_.u);
+      case Kind::Bool:
+        return Store(v.AsBool(), out.*m_.b);
+      case Kind::String:
+        if (!v.IsString()) return false;
+        out.*m_.s = v.AsString();
+        return true;
+      case Kind::OptFloat:
+        return StoreOpt(v.AsFloat(), out.*m_.of);
+      case Kind::OptInt:
+        return StoreOpt(v.AsInt(), out.*m_.oi);
+      case Kind::OptBool:
+        return StoreOpt(v.AsBool(), out.*m_.ob);
+      case Kind::Value:
+        out.*m_.v = v;
+        return true;
+    }
+    return false;
+  }
+
+ private:
+  enum class Kind : uint8_t {
+    Float,
+    Double,
+    Int,
+    Uint,
+    Bool,
+    String,
+    OptFloat,
+    OptInt,
+    OptBool,
+    Value,
+  };
+
+  union Member {
+    float T::*f;
+    double T::*d;
+    int32_t T::*i;
+    uint32_t T::*u;
+    bool T::*b;
+    const char* T::*s;
+    std::optional<float> T::*of;
+    std::optional<int32_t> T::*oi;
+    std::optional<bool> T::*ob;
+    JsonValue T::*v;
+  };
+
+  template <typename V>
+  static bool Store(const std::optional<V>& v, V& out) noexcept {
+    if (!v) return false;
+    out = *v;
+    return true;
+  }
+  template <typename V>
+  static bool StoreOpt(const std::optional<V>& v,
+                       std::optional<V>& out) noexcept {
+    if (!v) return false;
+    out = v;
+    return true;
+  }
+
+  const char* key_;
+  Kind kind_;
+  Member m_;
+};
+
+/**
+ * @brief Заполнить out членами объекта obj по схеме — один проход по
+ *        объекту, без повторного поиска ключей.
+ * @return Число заполненных полей (0, если obj не объект)
+ */
+template <typename T, size_t N>
+size_t JsonBind(JsonValue obj, const JsonField<T> (&schema)[N],
+                T& out) noexcept {
+  size_t filled = 0;
+  bool seen[N] = {};  // Повторы ключа пропускаются — первый побеждает
+  obj.ForEachMember([&](std::string_view key, JsonValue v) {
+    for (size_t i = 0; i < N; ++i) {
+      if (schema[i].Key() == key) {
+        if (!seen[i] && schema[i].Apply(v, out)) ++filled;
+        seen[i] = true;
+        break;
+      }
+    }
+  });
+  return filled;
+}
+
+}  // namespace rc_vehicle
@@ -0,0 +1,236 @@
+#include "log_convert.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <thread>
+
+namespace rc_vehicle {
+
+namespace {
+
+// Меньше строк на поток не имеет смысла — накладные расходы std::thread
+constexpr size_t kMinRowsPerThread = 4096;
+
+bool IsTestEnd(TelemetryEventType t) {
+  return t == TelemetryEventType::TestDone ||
+         t == TelemetryEventType::TestFailed ||
+         t == TelemetryEventType::TestStopped;
+}
+
+unsigned ResolveThreads(unsigned threads, size_t rows) {
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  const size_t by_rows = std::max<size_t>(1, rows / kMinRowsPerThread);
+  return static_cast<unsigned>(std::min<size_t>(threads, by_rows));
+}
+
+/// fn(chunk_begin, chunk_end, chunk_idx) на n равных блоках [0, rows).
+template <typename Fn>
+void ParallelChunks(size_t rows, unsigned n, Fn&& fn) {
+  if (n <= 1) {
+    fn(size_t{0}, rows, 0u);
+    return;
+  }
+  std::vector<std::thread> pool;
+  pool.reserve(n - 1);
+  const size_t step = (rows + n - 1) / n;
+  for (unsigned t = 1; t < n; ++t) {
+    const size_t b = std::min(rows, t * step);
+    const size_t e = std::min(rows, b + step);
+    pool.emplace_back([&fn, b, e, t] { fn(b, e, t); });
+  }
+  fn(size_t{0}, std::min(rows, step), 0u);
+  for (auto& th : pool) th.join();
+}
+
+template <typename T>
+void AppendNumber(std::string& out, T v) {
+  char buf[32];
+  const auto res = std::to_chars(buf, buf + sizeof(buf), v);
+  out.append(buf, res.ptr);
+}
+
+void AppendField(std::string& out, const uint8_t* rec,
+                 const TelemetryFieldInfo& f) {
+  const uint8_t* p = rec + f.offset;
+  switch (f.type) {
+    case TelemetryFieldType::U32: {
+      uint32_t v;
+      std::memcpy(&v, p, sizeof(v));
+      AppendNumber(out, v);
+      break;
+    }
+    case TelemetryFieldType::F32: {
+      float v;
+      std::memcpy(&v, p, sizeof(v));
+      AppendNumber(out, v);
+      break;
+    }
+    case TelemetryFieldType::U8:
+      AppendNumber(out, static_cast<unsigned>(*p));
+      break;
+  }
+}
+
+}  // namespace
+
+size_t LogFieldCountForFrameSize(uint32_t frame_size) {
+  size_t n = 0;
+  for (const auto& f : kTelemetryLogFields) {
+    if (f.offset + TelemetryFieldSize(f.type) > frame_size) break;
+    ++n;
+  }
+  return n;
+}
+
+uint32_t LogFrameTimestamp(const LogBinView& view, size_t idx) {
+  uint32_t ts = 0;
+  std::memcpy(&ts, view.frames + idx * view.frame_size, sizeof(ts));
+  return ts;
+}
+
+TelemetryEvent LogEventAt(const LogBinView& view, size_t idx) {
+  TelemetryEvent e{};
+  std::memcpy(&e, view.events + idx * view.event_size,
+              std::min<size_t>(view.event_size, sizeof(e)));
+  return e;
+}
+
+std::vector<LogSegment> SegmentLogByTests(const LogBinView& view) {
+  std::vector<LogSegment> out;
+  if (view.frame_count == 0 || !view.events) return out;
+
+  // Первый кадр с ts >= t (кадры упорядочены по времени). t шире ts:
+  // конец сегмента ищется как end_ms + 1, и при end_ms = UINT32_MAX
+  // uint32_t переполнился бы в 0.
+  auto lower = [&view](uint64_t t) {
+    size_t lo = 0;
+    size_t hi = view.frame_count;
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+      if (LogFrameTimestamp(view, mid) < t) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return static_cast<uint32_t>(lo);
+  };
+  auto emit = [&](LogSegment seg) {
+    seg.first_frame = lower(seg.start_ms);
+    seg.end_frame = seg.end_event == TelemetryEventType::TestStart
+                        ? view.frame_count
+                        : lower(uint64_t{seg.end_ms} + 1);
+    if (seg.end_frame > seg.first_frame) out.push_back(seg);
+  };
+
+  bool open = false;
+  LogSegment cur{};
+  for (size_t i = 0; i < view.event_count; ++i) {
+    const TelemetryEvent e = LogEventAt(view, i);
+    if (e.type == TelemetryEventType::TestStart) {
+      if (open) {
+        // Новый старт без завершения предыдущего — закрыть по нему
+        cur.end_ms = e.ts_ms;
+        cur.end_event = TelemetryEventType::TestStopped;
+        emit(cur);
+      }
+      cur = LogSegment{};
+      cur.start_ms = e.ts_ms;
+      cur.test_type = e.param;
+      open = true;
+    } else if (open && IsTestEnd(e.type)) {
+      cur.end_ms = e.ts_ms;
+      cur.end_event = e.type;
+      emit(cur);
+      open = false;
+    }
+  }
+  if (open) {
+    cur.end_ms = LogFrameTimestamp(view, view.frame_count - 1);
+    emit(cur);
+  }
+  return out;
+}
+
+void ExtractLogColumn(const LogBinView& view, size_t field, size_t begin,
+                      size_t end, void* dst) {
+  const TelemetryFieldInfo& f = kTelemetryLogFields[field];
+  const size_t sz = TelemetryFieldSize(f.type);
+  const uint8_t* src = view.frames + begin * view.frame_size + f.offset;
+  auto* out = static_cast<uint8_t*>(dst);
+  for (size_t i = begin; i < end; ++i) {
+    std::memcpy(out, src, sz);
+    out += sz;
+    src += view.frame_size;
+  }
+}
+
+void ExtractLogColumns(const LogBinView& view, size_t begin, size_t end,
+                       std::span<void* const> dst, unsigned threads) {
+  const size_t cols =
+      std::min(dst.size(), LogFieldCountForFrameSize(view.frame_size));
+  // Каждый поток — свой набор колонок: запись в непересекающиеся буферы
+  const unsigned n = static_cast<unsigned>(std::min<size_t>(
+      ResolveThreads(threads, (end - begin) * cols), cols));
+  ParallelChunks(cols, n, [&](size_t cb, size_t ce, unsigned) {
+    for (size_t c = cb; c < ce; ++c) {
+      ExtractLogColumn(view, c, begin, end, dst[c]);
+    }
+  });
+}
+
+std::string EncodeLogFramesCsv(const LogBinView& view, size_t begin, size_t end,
+                               unsigned threads) {
+  const size_t cols = LogFieldCountForFrameSize(view.frame_size);
+  std::string out;
+  for (size_t c = 0; c < cols; ++c) {
+    if (c) out.push_back(',');
+    out.append(kTelemetryLogFields[c].name);
+  }
+  out.push_back('\n');
+  if (end <= begin || cols == 0) return out;
+
+  const size_t rows = end - begin;
+  const unsigned n = ResolveThreads(threads, rows);
+  std::vector<std::string> parts(n);
+  ParallelChunks(rows, n, [&](size_t rb, size_t re, unsigned idx) {
+    std::string& s = parts[idx];
+    s.reserve((re - rb) * cols * 10);
+    for (size_t i = begin + rb; i < begin + re; ++i) {
+      const uint8_t* rec = view.frames + i * view.frame_size;
+      for (size_t c = 0; c < cols; ++c) {
+        if (c) s.push_back(',');
+        AppendField(s, rec, kTelemetryLogFields[c]);
+      }
+      s.push_back('\n');
+    }
+  });
+
+  size_t total = out.size();
+  for (const auto& p : parts) total += p.size();
+  out.reserve(total);
+  for (const auto& p : parts) out.append(p);
+  return out;
+}
+
+std::string EncodeLogEventsCsv(const LogBinView& view) {
+  std::string out = "ts_ms,type,param,value1,value2\n";
+  if (!view.events) return out;
+  for (size_t i = 0; i < view.event_count; ++i) {
+    const TelemetryEvent e = LogEventAt(view, i);
+    AppendNumber(out, e.ts_ms);
+    out.push_back(',');
+    AppendNumber(out, static_cast<unsigned>(e.type));
+    out.push_back(',');
+    AppendNumber(out, static_cast<unsigned>(e.param));
+    out.push_back(',');
+    AppendNumber(out, e.value1);
+    out.push_back(',');
+    AppendNumber(out, e.value2);
+    out.push_back('\n');
+  }
+  return out;
+}
+
+}  // namespace rc_vehicle
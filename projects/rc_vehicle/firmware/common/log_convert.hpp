@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "telemetry_event_log.hpp"
+#include "telemetry_log_decoder.hpp"
+
+/**
+ * @file log_convert.hpp
+ * @brief Конвертация log.bin в колонки/CSV без промежуточных копий кадров.
+ *
+ * Работает поверх LogBinView (обычно mmap файла): поля читаются прямо из
+ * записей с шагом frame_size, раскладка берётся из реестра
+ * kTelemetryLogFields. Используется хостовой утилитой log_convert;
+ * платформонезависимо и покрыто unit-тестами.
+ */
+
+namespace rc_vehicle {
+
+/** @brief Диапазон кадров одного тестового манёвра [first_frame, end_frame). */
+struct LogSegment {
+  uint32_t first_frame{0};
+  uint32_t end_frame{0};
+  uint32_t start_ms{0};  ///< ts_ms события TestStart
+  uint32_t end_ms{0};    ///< ts_ms завершающего события (или последнего кадра)
+  uint8_t test_type{0};  ///< TestType из param события TestStart
+  /// TestDone / TestFailed / TestStopped; TestStart — тест не завершён в логе
+  TelemetryEventType end_event{TelemetryEventType::TestStart};
+};
+
+/**
+ * @brief Число полей реестра, целиком помещающихся в кадр frame_size.
+ *
+ * Логи старой прошивки содержат префикс полей — остальные колонки не пишутся.
+ */
+[[nodiscard]] size_t LogFieldCountForFrameSize(uint32_t frame_size);
+
+/** @brief ts_ms кадра idx (idx < view.frame_count). */
+[[nodiscard]] uint32_t LogFrameTimestamp(const LogBinView& view, size_t idx);
+
+/** @brief Событие idx (префикс event_size, остальное — нули). */
+[[nodiscard]] TelemetryEvent LogEventAt(const LogBinView& view, size_t idx);
+
+/**
+ * @brief Разбить лог на тестовые манёвры по событиям TestStart → TestDone/
+ * TestFailed/TestStopped.
+ *
+ * Кадры сопоставляются по ts_ms (кадры в логе упорядочены по времени).
+ * Тест без завершающего события тянется до конца лога. Пустые диапазоны
+ * (события вне окна кольцевого буфера кадров) пропускаются.
+ */
+[[nodiscard]] std::vector<LogSegment> SegmentLogByTests(const LogBinView& view);
+
+/**
+ * @brief Собрать поле field кадров [begin, end) в плотный массив dst.
+ *
+ * dst — (end - begin) × размер типа поля (u32/f32 — 4 байта, u8 — 1 байт).
+ * field должен быть < LogFieldCountForFrameSize(view.frame_size).
+ */
+void ExtractLogColumn(const LogBinView& view, size_t field, size_t begin,
+                      size_t end, void* dst);
+
+/**
+ * @brief ExtractLogColumn для всех колонок, распределённых по потокам.
+ *
+ * dst[i] — буфер колонки i (размер dst = LogFieldCountForFrameSize).
+ * threads = 0 — по числу ядер.
+ */
+void ExtractLogColumns(const LogBinView& view, size_t begin, size_t end,
+                       std::span<void* const> dst, unsigned threads);
+
+/**
+ * @brief CSV кадров [begin, end): заголовок из имён полей + строки.
+ *
+ * Строки форматируются параллельно блоками (std::to_chars, кратчайшее
+ * точное представление float) и склеиваются по порядку.
+ */
+[[nodiscard]] std::string EncodeLogFramesCsv(const LogBinView& view,
+                                             size_t begin, size_t end,
+                                             unsigned threads);
+
+/** @brief CSV событий: ts_ms,type,param,value1,value2. */
+[[nodiscard]] std::string EncodeLogEventsCsv(const LogBinView& view);
+
+}  // namespace rc_vehicle
@@ -1,60 +1,119 @@
 #pragma once
 
-#include <iomanip>
-#include <sstream>
-#include <string>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
 
 namespace rc_vehicle {
 
+/** Шестнадцатеричный вывод в LogFormat: Hex(value, width) */
+struct LogHex {
+  unsigned long long value;
+  int width;
+  bool upper;
+};
+
+inline constexpr LogHex Hex(unsigned long long value, int width = 0,
+                            bool upper = false) {
+  return {value, width, upper};
+}
+
+/** Точность float/double в LogFormat (аналог std::fixed + setprecision) */
+struct LogFixed {
+  int precision;
+};
+
+inline constexpr LogFixed Fixed(int precision) { return {precision}; }
+
 /**
- * @brief Простой форматтер для логирования без использования snprintf
+ * @brief Форматтер для логирования в фиксированный буфер на стеке
  *
- * Использует std::ostringstream для безопасного форматирования строк.
+ * Без iostream и без кучи: каждый operator<< дописывает через snprintf,
+ * при переполнении строка обрезается. Точность float/double по умолчанию —
+ * как у ostream (%g), после Fixed(n) — %.nf до следующего Fixed().
  * Примеры:
- *   LogFormat() << "Value: " << 42 << ", float: " << 3.14f;
- *   LogFormat() << "Hex: 0x" << std::hex << std::setw(2) << std::setfill('0')
- * << value;
+ *   LogFormat() << "Value: " << 42 << ", float: " << Fixed(2) << 3.14f;
+ *   LogFormat() << "Hex: 0x" << Hex(value, 2);
  */
 class LogFormat {
  public:
+  static constexpr size_t kCapacity = 160;
+
   LogFormat() = default;
 
-  template <typename T>
-  LogFormat& operator<<(const T& value) {
-    stream_ << value;
+  LogFormat& operator<<(std::string_view s) {
+    const size_t n = std::min(s.size(), kCapacity - 1 - len_);
+    std::memcpy(buf_ + len_, s.data(), n);
+    len_ += n;
+    buf_[len_] = '\0';
     return *this;
   }
 
-  // Поддержка манипуляторов потока (std::hex, std::setw, и т.д.)
-  LogFormat& operator<<(std::ostream& (*manip)(std::ostream&)) {
-    manip(stream_);
-    return *this;
+  LogFormat& operator<<(const char* s) {
+    return *this << std::string_view(s ? s : "(null)");
+  }
+
+  LogFormat& operator<<(char c) { return *this << std::string_view(&c, 1); }
+
+  template <typename T>
+    requires std::is_integral_v<T>
+  LogFormat& operator<<(T value) {
+    if constexpr (std::is_signed_v<T>) {
+      return Append("%lld", static_cast<long long>(value));
+    } else {
+      return Append("%llu", static_cast<unsigned long long>(value));
+    }
   }
 
   template <typename T>
-  LogFormat& operator<<(T& (*manip)(T&)) {
-    manip(stream_);
-    return *this;
+    requires std::is_floating_point_v<T>
+  LogFormat& operator<<(T value) {
+    if (precision_ < 0) return Append("%g", static_cast<double>(value));
+    return Append("%.*f", precision_, static_cast<double>(value));
   }
 
-  std::string str() const { return stream_.str(); }
+  LogFormat& operator<<(LogHex h) {
+    return Append(h.upper ? "%0*llX" : "%0*llx", h.width, h.value);
+  }
 
-  operator std::string() const { return str(); }
+  LogFormat& operator<<(LogFixed f) {
+    precision_ = f.precision;
+    return *this;
+  }
+
+  [[nodiscard]] std::string_view str() const { return {buf_, len_}; }
+  [[nodiscard]] const char* c_str() const { return buf_; }
 
  private:
-  std::ostringstream stream_;
+  template <typename... Args>
+  LogFormat& Append(const char* fmt, Args... args) {
+    const int n = std::snprintf(buf_ + len_, kCapacity - len_, fmt, args...);
+    if (n > 0) len_ = std::min(len_ + static_cast<size_t>(n), kCapacity - 1);
+    return *this;
+  }
+
+  char buf_[kCapacity]{};
+  size_t len_{0};
+  int precision_{-1};
 };
 
 /**
  * @brief Форматирование IP-адреса (для ESP32 IPSTR макроса)
- * @param ip Указатель на структуру esp_ip4_addr_t или uint32_t IP
- * @return Строка вида "192.168.4.1"
+ * @param ip IP в сетевом порядке (esp_ip4_addr_t::addr)
+ * @param out Буфер для строки вида "192.168.4.1"
+ * @param out_len Размер буфера (обрезается с завершающим '\0')
  */
-inline std::string FormatIp(uint32_t ip) {
-  LogFormat fmt;
-  fmt << ((ip >> 0) & 0xFF) << "." << ((ip >> 8) & 0xFF) << "."
-      << ((ip >> 16) & 0xFF) << "." << ((ip >> 24) & 0xFF);
-  return fmt.str();
+inline void FormatIp(uint32_t ip, char* out, size_t out_len) {
+  if (!out || out_len == 0) return;
+  std::snprintf(out, out_len, "%u.%u.%u.%u",
+                static_cast<unsigned>((ip >> 0) & 0xFF),
+                static_cast<unsigned>((ip >> 8) & 0xFF),
+                static_cast<unsigned>((ip >> 16) & 0xFF),
+                static_cast<unsigned>((ip >> 24) & 0xFF));
 }
 
-}  // namespace rc_vehicle
\ No newline at end of file
+}  // namespace rc_vehicle
@@ -2,6 +2,9 @@
 
 #include <cmath>
 
+#include "config.hpp"
+#include "fast_math.hpp"
+
 namespace {
 
 constexpr float kPi = 3.14159265358979323846f;
@@ -34,7 +37,14 @@ void LpfButterworth2::UpdateCoefficients() {
   // a0 = 1, a1 = 2*(K^2 - 1)/norm, a2 = (1 - K/Q + K^2)/norm
   const float fc = cutoff_hz_;
   const float fs = sample_rate_hz_;
-  const float K = std::tan(kPi * fc / fs);
+  float K;
+  if constexpr (rc_vehicle::config::FastMathConfig::kLpfTan) {
+    float s, c;
+    rc_vehicle::FastSinCos(kPi * fc / fs, s, c);
+    K = s / c;
+  } else {
+    K = std::tan(kPi * fc / fs);
+  }
   const float Q = kSqrt2;
   const float K2 = K * K;
   const float norm = 1.f + K / Q + K2;
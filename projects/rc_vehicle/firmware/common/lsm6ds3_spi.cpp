@@ -1,5 +1,7 @@
 #include "lsm6ds3_spi.hpp"
 
+#include <algorithm>
+
 #ifdef ESP_PLATFORM
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
@@ -96,14 +98,16 @@ int Lsm6ds3Spi::Init() {
   return 0;
 }
 
-int Lsm6ds3Spi::Read(ImuData &data) {
-  if (!initialized_)
-    return -1;
-
+size_t Lsm6ds3Spi::PrepareBurst(std::span<uint8_t> tx) const {
   // Бёрст-чтение 12 байт: 6 gyro + 6 accel (с 0x22, порядок little-endian)
-  uint8_t tx[13] = {static_cast<uint8_t>(LSM6DS3_REG_OUTX_L_G | LSM6DS3_SPI_READ_BIT)};
-  uint8_t rx[13] = {};
-  if (spi_->Transfer(std::span<const uint8_t>(tx, 13), std::span<uint8_t>(rx, 13)) != 0)
+  constexpr size_t kLen = 13;
+  std::fill(tx.begin(), tx.begin() + kLen, 0);
+  tx[0] = static_cast<uint8_t>(LSM6DS3_REG_OUTX_L_G | LSM6DS3_SPI_READ_BIT);
+  return kLen;
+}
+
+int Lsm6ds3Spi::ParseBurst(std::span<const uint8_t> rx, ImuData &data) const {
+  if (!initialized_ || rx.size() < 13)
     return -1;
 
   // LSM6DS3: little-endian (LSB first)
@@ -128,3 +132,16 @@ int Lsm6ds3Spi::Read(ImuData &data) {
 
   return 0;
 }
+
+int Lsm6ds3Spi::Read(ImuData &data) {
+  if (!initialized_)
+    return -1;
+
+  uint8_t tx[kBurstMaxLen];
+  uint8_t rx[kBurstMaxLen] = {};
+  const size_t len = PrepareBurst(tx);
+  if (spi_->Transfer(std::span<const uint8_t>(tx, len),
+                     std::span<uint8_t>(rx, len)) != 0)
+    return -1;
+  return ParseBurst(std::span<const uint8_t>(rx, len), data);
+}
@@ -23,6 +23,10 @@ class Lsm6ds3Spi : public IImuSensor {
   /** Для отладки: последнее прочитанное WHO_AM_I (0x6A/0x6C = OK, -1 = не читали). */
   int GetLastWhoAmI() const override { return last_who_am_i_; }
 
+  /** 13 байт: адрес OUTX_L_G + 6 gyro + 6 accel. */
+  size_t PrepareBurst(std::span<uint8_t> tx) const override;
+  int ParseBurst(std::span<const uint8_t> rx, ImuData &data) const override;
+
  private:
   SpiDevice *spi_;
   bool initialized_{false};
@@ -4,6 +4,8 @@
 #include <cmath>
 #include <cstring>
 
+#include "config.hpp"
+#include "fast_math.hpp"
 #include "mpu6050_spi.hpp"  // ImuData definition
 
 namespace {
@@ -23,8 +25,9 @@ void MadgwickFilter::Reset() {
   q3_ = 0.f;
 }
 
-void MadgwickFilter::Update(float ax, float ay, float az, float gx, float gy,
-                            float gz, float dt_sec) {
+template <bool kAdaptive>
+void MadgwickFilter::StepImu(float ax, float ay, float az, float gx, float gy,
+                             float gz, float dt_sec) noexcept {
   if (dt_sec <= 0.f) return;
 
   // Гироскоп: град/с → рад/с
@@ -47,7 +50,7 @@ void MadgwickFilter::Update(float ax, float ay, float az, float gx, float gy,
     // коррекцию (beta=0), чтобы не вносить ошибку в ориентацию при разгоне,
     // торможении и поворотах.
     float effective_beta = beta_;
-    if (adaptive_enabled_) {
+    if constexpr (kAdaptive) {
       const float accel_mag = std::sqrt(norm2);
       if (std::fabs(accel_mag - 1.0f) > adaptive_threshold_g_) {
         effective_beta = 0.0f;
@@ -114,6 +117,66 @@ void MadgwickFilter::Update(float ax, float ay, float az, float gx, float gy,
   q3_ *= qNorm;
 }
 
+void MadgwickFilter::Update(float ax, float ay, float az, float gx, float gy,
+                            float gz, float dt_sec) {
+  if (adaptive_enabled_) {
+    StepImu<true>(ax, ay, az, gx, gy, gz, dt_sec);
+  } else {
+    StepImu<false>(ax, ay, az, gx, gy, gz, dt_sec);
+  }
+}
+
+template <bool kAdaptive>
+void MadgwickFilter::RunBatch(const ImuBatch& batch,
+                              std::span<float> pitch_deg,
+                              std::span<float> roll_deg,
+                              std::span<float> yaw_deg) noexcept {
+  const size_t n = batch.Size();
+  const size_t dt_stride = batch.DtStride();
+  const float* ax = batch.ax.data();
+  const float* ay = batch.ay.data();
+  const float* az = batch.az.data();
+  const float* gx = batch.gx.data();
+  const float* gy = batch.gy.data();
+  const float* gz = batch.gz.data();
+  const float* dt = batch.dt.data();
+
+  if (pitch_deg.empty()) {
+    for (size_t i = 0; i < n; ++i) {
+      StepImu<kAdaptive>(ax[i], ay[i], az[i], gx[i], gy[i], gz[i],
+                         dt[i * dt_stride]);
+    }
+    return;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    StepImu<kAdaptive>(ax[i], ay[i], az[i], gx[i], gy[i], gz[i],
+                       dt[i * dt_stride]);
+    GetEulerDeg(pitch_deg[i], roll_deg[i], yaw_deg[i]);
+  }
+}
+
+bool MadgwickFilter::UpdateBatch(const ImuBatch& batch,
+                                 std::span<float> pitch_deg,
+                                 std::span<float> roll_deg,
+                                 std::span<float> yaw_deg) {
+  if (!batch.IsValid()) return false;
+  const size_t n = batch.Size();
+  const bool want_euler = !pitch_deg.empty() || !roll_deg.empty() ||
+                          !yaw_deg.empty();
+  if (want_euler && (pitch_deg.size() != n || roll_deg.size() != n ||
+                     yaw_deg.size() != n)) {
+    return false;
+  }
+  if (n == 0) return true;
+
+  if (adaptive_enabled_) {
+    RunBatch<true>(batch, pitch_deg, roll_deg, yaw_deg);
+  } else {
+    RunBatch<false>(batch, pitch_deg, roll_deg, yaw_deg);
+  }
+  return true;
+}
+
 void MadgwickFilter::Update(const ImuData& imu, float dt_sec) {
   Update(imu.ax, imu.ay, imu.az, imu.gx, imu.gy, imu.gz, dt_sec);
 }
@@ -356,11 +419,12 @@ void MadgwickFilter::GetEulerRad(float& pitch_rad, float& roll_rad,
                                  float& yaw_rad) const {
   float qw, qx, qy, qz;
   GetQuaternion(qw, qx, qy, qz);
-  roll_rad =
-      std::atan2(2.f * (qw * qx + qy * qz), 1.f - 2.f * (qx * qx + qy * qy));
-  pitch_rad = std::asin(std::clamp(2.f * (qw * qy - qz * qx), -1.f, 1.f));
-  yaw_rad =
-      std::atan2(2.f * (qw * qz + qx * qy), 1.f - 2.f * (qy * qy + qz * qz));
+  constexpr bool kFast = config::FastMathConfig::kEuler;
+  roll_rad = Atan2<kFast>(2.f * (qw * qx + qy * qz),
+                          1.f - 2.f * (qx * qx + qy * qy));
+  pitch_rad = Asin<kFast>(std::clamp(2.f * (qw * qy - qz * qx), -1.f, 1.f));
+  yaw_rad = Atan2<kFast>(2.f * (qw * qz + qx * qy),
+                         1.f - 2.f * (qy * qy + qz * qz));
 }
 
 void MadgwickFilter::GetEulerDeg(float& pitch_deg, float& roll_deg,
@@ -374,8 +438,7 @@ void MadgwickFilter::GetEulerDeg(float& pitch_deg, float& roll_deg,
 }
 
 float MadgwickFilter::InvSqrt(float x) {
-  if (x <= 0.f) return 0.f;
-  return 1.f / std::sqrt(x);
+  return rc_vehicle::InvSqrt<config::FastMathConfig::kMadgwickInvSqrt>(x);
 }
 
 }  // namespace rc_vehicle
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <span>
+
+#include "imu_batch.hpp"
 #include "orientation_filter.hpp"
 
 /**
@@ -23,7 +26,7 @@ struct ImuData;
 
 namespace rc_vehicle {
 
-class MadgwickFilter : public IOrientationFilter {
+class MadgwickFilter final : public IOrientationFilter {
  public:
   MadgwickFilter();
 
@@ -68,6 +71,23 @@ class MadgwickFilter : public IOrientationFilter {
   bool GetAdaptiveBetaEnabled() const { return adaptive_enabled_; }
   float GetAdaptiveThresholdG() const { return adaptive_threshold_g_; }
 
+  /**
+   * Пакетное 6DOF-обновление (реплей логов, FIFO IMU).
+   *
+   * Результат бит-в-бит совпадает с поштучными вызовами Update(): тот же шаг
+   * интегрирования, но без виртуального вызова на семпл и с проверкой
+   * адаптивного beta, вынесенной из цикла.
+   *
+   * @param batch SoA-массивы семплов (см. ImuBatch)
+   * @param pitch_deg, roll_deg, yaw_deg Углы Эйлера после каждого семпла;
+   *        пустой span — не записывать, иначе размер batch.Size()
+   * @return false если batch или выходные массивы несогласованы по размеру
+   *         (состояние фильтра не меняется)
+   */
+  bool UpdateBatch(const ImuBatch& batch, std::span<float> pitch_deg = {},
+                   std::span<float> roll_deg = {},
+                   std::span<float> yaw_deg = {});
+
  private:
   float q0_{1.f}, q1_{0.f}, q2_{0.f}, q3_{0.f};
   float beta_{0.1f};
@@ -82,6 +102,14 @@ class MadgwickFilter : public IOrientationFilter {
   float q_veh_to_ned_0_{1.f}, q_veh_to_ned_1_{0.f}, q_veh_to_ned_2_{0.f},
       q_veh_to_ned_3_{0.f};
 
+  /** Шаг 6DOF без виртуального вызова; kAdaptive — ветка адаптивного beta. */
+  template <bool kAdaptive>
+  void StepImu(float ax, float ay, float az, float gx, float gy, float gz,
+               float dt_sec) noexcept;
+  template <bool kAdaptive>
+  void RunBatch(const ImuBatch& batch, std::span<float> pitch_deg,
+                std::span<float> roll_deg, std::span<float> yaw_deg) noexcept;
+
   void GetQuaternionInNed(float& qw, float& qx, float& qy, float& qz) const;
   static void QuatMul(float aw, float ax, float ay, float az, float bw,
                       float bx, float by, float bz, float& ow, float& ox,
@@ -0,0 +1,200 @@
+#include "maneuver_analyzer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "config.hpp"
+
+namespace rc_vehicle {
+
+using Cfg = config::ManeuverConfig;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// RunningStats
+// ─────────────────────────────────────────────────────────────────────────────
+
+void RunningStats::Add(float x) noexcept {
+  ++n_;
+  const double delta = x - mean_;
+  mean_ += delta / n_;
+  m2_ += delta * (x - mean_);
+  max_abs_ = std::max(max_abs_, std::abs(x));
+}
+
+float RunningStats::StdDev() const noexcept {
+  if (n_ < 2) return 0.0f;
+  return static_cast<float>(std::sqrt(m2_ / (n_ - 1)));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// LevelCrossingTable
+// ─────────────────────────────────────────────────────────────────────────────
+
+void LevelCrossingTable::Reset(float initial_step) noexcept {
+  step_ = initial_step > 0.0f ? initial_step : 1.0f;
+  peak_ = 0.0f;
+  last_t_ = kNever;
+  first_above_.fill(kNever);
+  last_above_.fill(kNever);
+  last_below_.fill(kNever);
+}
+
+void LevelCrossingTable::Add(float d, float t) noexcept {
+  if (!std::isfinite(d)) return;
+  while (d >= step_ * static_cast<float>(kLevels - 1)) Rescale();
+  peak_ = std::max(peak_, d);
+
+  // Узлы не выше d — префикс сетки, строго выше — суффикс
+  const float f = d / step_;
+  const size_t n_reached =
+      d >= 0.0f ? static_cast<size_t>(std::floor(f)) + 1 : 0;
+  for (size_t i = 0; i < n_reached; ++i) {
+    last_above_[i] = t;
+    if (first_above_[i] == kNever) first_above_[i] = t;
+  }
+  for (size_t i = n_reached; i < kLevels; ++i) last_below_[i] = t;
+  last_t_ = t;
+}
+
+void LevelCrossingTable::Rescale() noexcept {
+  constexpr size_t kHalf = kLevels / 2;
+  for (size_t i = 0; i < kHalf; ++i) {
+    first_above_[i] = first_above_[2 * i];
+    last_above_[i] = last_above_[2 * i];
+    last_below_[i] = last_below_[2 * i];
+  }
+  // Новые верхние узлы выше всех прошлых отсчётов
+  for (size_t i = kHalf; i < kLevels; ++i) {
+    first_above_[i] = kNever;
+    last_above_[i] = kNever;
+    last_below_[i] = last_t_;
+  }
+  step_ *= 2.0f;
+}
+
+float LevelCrossingTable::FirstAbove(float level) const noexcept {
+  const float f = std::max(level, 0.0f) / step_;
+  const size_t i = static_cast<size_t>(f);
+  if (i >= kLevels - 1) return first_above_[kLevels - 1];
+  const float lo = first_above_[i];
+  const float hi = first_above_[i + 1];
+  if (lo == kNever) return kNever;
+  if (hi == kNever) return lo;
+  return lo + (f - static_cast<float>(i)) * (hi - lo);
+}
+
+float LevelCrossingTable::LastAbove(float level) const noexcept {
+  const float f = std::max(level, 0.0f) / step_;
+  const size_t i = std::min(static_cast<size_t>(f), kLevels - 1);
+  return last_above_[i];
+}
+
+float LevelCrossingTable::LastBelow(float level) const noexcept {
+  const float f = std::max(level, 0.0f) / step_;
+  const size_t i = static_cast<size_t>(std::ceil(f));
+  // Уровень выше сетки — выше пика: ниже него были все отсчёты
+  if (i >= kLevels) return last_t_;
+  return last_below_[i];
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// StepResponseAnalyzer
+// ─────────────────────────────────────────────────────────────────────────────
+
+void StepResponseAnalyzer::Begin(float baseline, float duration_s) noexcept {
+  baseline_ = baseline;
+  steady_from_s_ = duration_s * (1.0f - Cfg::kStepSteadyFrac);
+  t_ = 0.0f;
+  steady_.Reset();
+  pos_.Reset(Cfg::kLevelStepDps);
+  neg_.Reset(Cfg::kLevelStepDps);
+}
+
+void StepResponseAnalyzer::Add(float y, float dt_s) noexcept {
+  t_ += dt_s;
+  const float d = y - baseline_;
+  pos_.Add(d, t_);
+  neg_.Add(-d, t_);
+  if (t_ >= steady_from_s_) steady_.Add(y);
+}
+
+StepMetrics StepResponseAnalyzer::Finish() const noexcept {
+  StepMetrics m;
+  m.baseline_dps = baseline_;
+  m.steady_dps = steady_.Mean();
+  const float amp = m.steady_dps - baseline_;
+  const float sign = amp >= 0.0f ? 1.0f : -1.0f;
+  const LevelCrossingTable& tbl = amp >= 0.0f ? pos_ : neg_;
+  const float a = std::abs(amp);
+  m.peak_dps = baseline_ + sign * tbl.Peak();
+  m.valid = steady_.Count() > 0 && a >= Cfg::kMinStepDps;
+  if (!m.valid) return m;
+
+  const float t_lo = tbl.FirstAbove(Cfg::kRiseLoFrac * a);
+  const float t_hi = tbl.FirstAbove(Cfg::kRiseHiFrac * a);
+  if (t_lo != LevelCrossingTable::kNever &&
+      t_hi != LevelCrossingTable::kNever) {
+    m.rise_time_s = std::max(t_hi - t_lo, 0.0f);
+  }
+  m.overshoot_pct = std::max(tbl.Peak() - a, 0.0f) / a * 100.0f;
+
+  const float out_hi = tbl.LastAbove(a * (1.0f + Cfg::kSettleBandFrac));
+  const float out_lo = tbl.LastBelow(a * (1.0f - Cfg::kSettleBandFrac));
+  m.settling_time_s = std::max({out_hi, out_lo, 0.0f});
+  return m;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ManeuverAnalyzer
+// ─────────────────────────────────────────────────────────────────────────────
+
+void ManeuverAnalyzer::Reset() noexcept {
+  window_s_ = 0.0f;
+  yaw_.Reset();
+  slip_.Reset();
+  speed_.Reset();
+  has_step_ = false;
+}
+
+void ManeuverAnalyzer::AddCruise(const ManeuverSample& s,
+                                 float phase_elapsed_s, float dt_s) noexcept {
+  if (phase_elapsed_s < Cfg::kSteadySkipSec) return;
+  AddStats(s, dt_s);
+}
+
+void ManeuverAnalyzer::BeginStep(float duration_s) noexcept {
+  // Уровень до скачка — среднее Cruise; дальше окно статистики — StepExec
+  step_.Begin(yaw_.Mean(), duration_s);
+  has_step_ = true;
+  window_s_ = 0.0f;
+  yaw_.Reset();
+  slip_.Reset();
+  speed_.Reset();
+}
+
+void ManeuverAnalyzer::AddStep(const ManeuverSample& s, float dt_s) noexcept {
+  step_.Add(s.yaw_rate_dps, dt_s);
+  AddStats(s, dt_s);
+}
+
+void ManeuverAnalyzer::AddStats(const ManeuverSample& s, float dt_s) noexcept {
+  window_s_ += dt_s;
+  yaw_.Add(s.yaw_rate_dps);
+  slip_.Add(s.slip_deg);
+  speed_.Add(s.speed_ms);
+}
+
+ManeuverMetrics ManeuverAnalyzer::Finish() const noexcept {
+  ManeuverMetrics m;
+  m.window_s = window_s_;
+  m.yaw_rate_mean_dps = yaw_.Mean();
+  m.yaw_rate_std_dps = yaw_.StdDev();
+  m.slip_mean_deg = slip_.Mean();
+  m.slip_max_abs_deg = slip_.MaxAbs();
+  m.speed_mean_ms = speed_.Mean();
+  m.has_step = has_step_;
+  if (has_step_) m.step = step_.Finish();
+  return m;
+}
+
+}  // namespace rc_vehicle
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace rc_vehicle {
+
+// ═════════════════════════════════════════════════════════════════════════════
+// RunningStats
+// ═════════════════════════════════════════════════════════════════════════════
+
+/** Среднее / СКО / max|x| по Уэлфорду: O(1) памяти, без накопления суммы. */
+class RunningStats {
+ public:
+  void Add(float x) noexcept;
+  void Reset() noexcept { *this = RunningStats{}; }
+
+  [[nodiscard]] uint32_t Count() const noexcept { return n_; }
+  [[nodiscard]] float Mean() const noexcept {
+    return static_cast<float>(mean_);
+  }
+  [[nodiscard]] float StdDev() const noexcept;
+  [[nodiscard]] float MaxAbs() const noexcept { return max_abs_; }
+
+ private:
+  uint32_t n_{0};
+  double mean_{0.0};
+  double m2_{0.0};
+  float max_abs_{0.0f};
+};
+
+// ═════════════════════════════════════════════════════════════════════════════
+// LevelCrossingTable
+// ═════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Времена пересечения уровней отклонения d(t) на сетке фиксированного
+ *        размера — для метрик переходного процесса без хранения сигнала.
+ *
+ * Для уровней L_i = i · step (i < kLevels) хранятся: первое время d ≥ L_i,
+ * последнее d ≥ L_i и последнее d < L_i. Когда d выходит за сетку, шаг
+ * удваивается (чётные узлы сохраняются), поэтому шаг — не больше
+ * 2 · пик / (kLevels − 1) (≈ 6 % пика) при любой амплитуде. Уровень,
+ * известный только в конце (доля установившегося значения), запрашивается
+ * после прогона.
+ *
+ * Add() — O(kLevels) с постоянной границей; память — 3 × kLevels float.
+ */
+class LevelCrossingTable {
+ public:
+  static constexpr size_t kLevels = 32;
+  static constexpr float kNever = -1.0f;
+
+  /** @param initial_step Начальный шаг сетки (единицы d) */
+  void Reset(float initial_step) noexcept;
+
+  /** Отсчёт d в момент t [с] (t неубывает). */
+  void Add(float d, float t) noexcept;
+
+  /** Первый момент d ≥ level (интерполяция между узлами), kNever если нет. */
+  [[nodiscard]] float FirstAbove(float level) const noexcept;
+
+  /** Последний момент d ≥ level (оценка сверху), kNever если не было. */
+  [[nodiscard]] float LastAbove(float level) const noexcept;
+
+  /** Последний момент d < level (оценка сверху), kNever если не было. */
+  [[nodiscard]] float LastBelow(float level) const noexcept;
+
+  [[nodiscard]] float Peak() const noexcept { return peak_; }
+  [[nodiscard]] float Step() const noexcept { return step_; }
+
+ private:
+  void Rescale() noexcept;
+
+  float step_{1.0f};
+  float peak_{0.0f};
+  float last_t_{kNever};
+  std::array<float, kLevels> first_above_{};
+  std::array<float, kLevels> last_above_{};
+  std::array<float, kLevels> last_below_{};
+};
+
+// ═════════════════════════════════════════════════════════════════════════════
+// StepResponseAnalyzer
+// ═════════════════════════════════════════════════════════════════════════════
+
+/** Метрики step response (yaw rate на скачок руля). */
+struct StepMetrics {
+  bool valid{false};          ///< Амплитуда ≥ kMinStepDps, окно не пустое
+  float baseline_dps{0.0f};   ///< Уровень до скачка
+  float steady_dps{0.0f};     ///< Среднее за последние kStepSteadyFrac фазы
+  float peak_dps{0.0f};       ///< Экстремум в сторону скачка
+  float rise_time_s{0.0f};    ///< 10 % → 90 % амплитуды
+  float overshoot_pct{0.0f};  ///< (пик − уст.) / амплитуда
+  float settling_time_s{0.0f};  ///< Последний выход из полосы ±kSettleBandFrac
+};
+
+/**
+ * @brief Потоковый анализ переходного процесса: O(1) памяти.
+ *
+ * Направление скачка заранее неизвестно (знак руль → yaw rate зависит от
+ * установки), поэтому ведутся две таблицы уровней — для d = y − y0 и −d;
+ * в Finish() выбирается та, в сторону которой ушло установившееся значение.
+ */
+class StepResponseAnalyzer {
+ public:
+  /**
+   * @param baseline Уровень до скачка
+   * @param duration_s Длительность фазы скачка (окно установившегося —
+   *                   последние config::ManeuverConfig::kStepSteadyFrac)
+   */
+  void Begin(float baseline, float duration_s) noexcept;
+
+  /** Отсчёт y через dt_s после предыдущего. */
+  void Add(float y, float dt_s) noexcept;
+
+  [[nodiscard]] StepMetrics Finish() const noexcept;
+
+ private:
+  float baseline_{0.0f};
+  float steady_from_s_{0.0f};
+  float t_{0.0f};
+  RunningStats steady_;
+  LevelCrossingTable pos_;
+  LevelCrossingTable neg_;
+};
+
+// ═════════════════════════════════════════════════════════════════════════════
+// ManeuverAnalyzer
+// ═════════════════════════════════════════════════════════════════════════════
+
+/** Отсчёт датчиков для анализа манёвра. */
+struct ManeuverSample {
+  float yaw_rate_dps{0.0f};
+  float slip_deg{0.0f};
+  float speed_ms{0.0f};
+};
+
+/** Итог манёвра: статистика окна анализа и (для Step) step response. */
+struct ManeuverMetrics {
+  float window_s{0.0f};  ///< Длительность окна статистики
+  float yaw_rate_mean_dps{0.0f};
+  float yaw_rate_std_dps{0.0f};
+  float slip_mean_deg{0.0f};
+  float slip_max_abs_deg{0.0f};
+  float speed_mean_ms{0.0f};
+  bool has_step{false};
+  StepMetrics step{};
+};
+
+/**
+ * @brief Метрики TestRunner, считаемые по ходу фаз Cruise / StepExec.
+ *
+ * Straight/Circle: статистика Cruise без первых kSteadySkipSec (переход
+ * после разгона / поворота руля). Step: Cruise даёт уровень до скачка,
+ * статистика и step response — по фазе StepExec.
+ */
+class ManeuverAnalyzer {
+ public:
+  void Reset() noexcept;
+
+  /** Отсчёт фазы Cruise; phase_elapsed_s — время с начала фазы. */
+  void AddCruise(const ManeuverSample& s, float phase_elapsed_s,
+                 float dt_s) noexcept;
+
+  /** Начало скачка (переход Cruise → StepExec). */
+  void BeginStep(float duration_s) noexcept;
+
+  /** Отсчёт фазы StepExec. */
+  void AddStep(const ManeuverSample& s, float dt_s) noexcept;
+
+  [[nodiscard]] ManeuverMetrics Finish() const noexcept;
+
+ private:
+  void AddStats(const ManeuverSample& s, float dt_s) noexcept;
+
+  float window_s_{0.0f};
+  RunningStats yaw_;
+  RunningStats slip_;
+  RunningStats speed_;
+  bool has_step_{false};
+  StepResponseAnalyzer step_;
+};
+
+}  // namespace rc_vehicle
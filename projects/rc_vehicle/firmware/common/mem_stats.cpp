@@ -0,0 +1,125 @@
+#include "mem_stats.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "config.hpp"
+
+namespace rc_vehicle {
+
+const char* HeapRegionName(HeapRegion region) noexcept {
+  switch (region) {
+    case HeapRegion::Internal:
+      return "internal";
+    case HeapRegion::Dma:
+      return "dma";
+    case HeapRegion::Psram:
+      return "psram";
+    default:
+      return "?";
+  }
+}
+
+uint32_t RecommendStackBytes(uint32_t peak_used) noexcept {
+  using Cfg = config::MemMonitorConfig;
+  const uint64_t with_margin =
+      static_cast<uint64_t>(peak_used) * (100 + Cfg::kStackMarginPct) / 100 +
+      Cfg::kStackGuardBytes;
+  const uint64_t aligned = (with_margin + Cfg::kStackAlignBytes - 1) /
+                           Cfg::kStackAlignBytes * Cfg::kStackAlignBytes;
+  return static_cast<uint32_t>(
+      std::max<uint64_t>(aligned, Cfg::kMinStackBytes));
+}
+
+uint8_t FragmentationPct(uint32_t free, uint32_t largest_block) noexcept {
+  if (free == 0 || largest_block >= free) return 0;
+  return static_cast<uint8_t>(
+      100 - static_cast<uint64_t>(largest_block) * 100 / free);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// MemStats
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool MemStats::RegisterTask(const char* name, uint32_t stack_bytes) noexcept {
+  if (!name) return false;
+  for (size_t i = 0; i < task_count_; ++i) {
+    if (std::strncmp(tasks_[i].name, name, sizeof(tasks_[i].name) - 1) == 0) {
+      tasks_[i].stack_bytes = stack_bytes;
+      return true;
+    }
+  }
+  if (task_count_ >= kMaxTasks) return false;
+  StackStats& t = tasks_[task_count_++];
+  t = StackStats{};
+  std::strncpy(t.name, name, sizeof(t.name) - 1);
+  t.stack_bytes = stack_bytes;
+  return true;
+}
+
+void MemStats::UpdateStack(size_t i, uint32_t free_bytes) noexcept {
+  if (i >= task_count_) return;
+  StackStats& t = tasks_[i];
+  t.min_free_bytes = t.seen ? std::min(t.min_free_bytes, free_bytes)
+                            : free_bytes;
+  t.seen = true;
+  t.alive = true;
+}
+
+void MemStats::MarkGone(size_t i) noexcept {
+  if (i < task_count_) tasks_[i].alive = false;
+}
+
+void MemStats::UpdateHeap(HeapRegion region,
+                          const HeapSample& sample) noexcept {
+  const size_t idx = static_cast<size_t>(region);
+  if (idx >= kHeapRegionCount || sample.total == 0) return;
+  HeapStats& h = heaps_[idx];
+  // Аллокатор помнит минимум с загрузки — он точнее опроса раз в N секунд
+  const uint32_t min_free = sample.min_free > 0
+                                ? std::min(sample.free, sample.min_free)
+                                : sample.free;
+  h.min_free = h.present ? std::min(h.min_free, min_free) : min_free;
+  h.min_largest_block = h.present ? std::min(h.min_largest_block,
+                                             sample.largest_block)
+                                  : sample.largest_block;
+  h.last = sample;
+  h.present = true;
+}
+
+StackAdvice MemStats::Advise(size_t i) const noexcept {
+  StackAdvice a;
+  if (i >= task_count_) return a;
+  const StackStats& t = tasks_[i];
+  if (!t.seen || t.stack_bytes == 0) return a;
+  a.peak_used = t.stack_bytes > t.min_free_bytes
+                    ? t.stack_bytes - t.min_free_bytes
+                    : 0;
+  a.recommended = RecommendStackBytes(a.peak_used);
+  a.reclaim = static_cast<int32_t>(t.stack_bytes) -
+              static_cast<int32_t>(a.recommended);
+  return a;
+}
+
+uint32_t MemStats::ReclaimableBytes() const noexcept {
+  uint32_t total = 0;
+  for (size_t i = 0; i < task_count_; ++i) {
+    const StackAdvice a = Advise(i);
+    if (a.reclaim > 0) total += static_cast<uint32_t>(a.reclaim);
+  }
+  return total;
+}
+
+size_t MemStats::TightestTask() const noexcept {
+  size_t best = task_count_;
+  for (size_t i = 0; i < task_count_; ++i) {
+    if (!tasks_[i].seen) continue;
+    if (best == task_count_ ||
+        tasks_[i].min_free_bytes < tasks_[best].min_free_bytes) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+}  // namespace rc_vehicle
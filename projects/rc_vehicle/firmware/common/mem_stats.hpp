@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file mem_stats.hpp
+ * @brief Наблюдения за памятью: минимумы запаса стеков задач и состояния куч
+ *        по регионам, рекомендации размера стека по наблюдённому пику.
+ *
+ * Платформенный опрос (uxTaskGetStackHighWaterMark, heap_caps_get_info) —
+ * в esp32_common/mem_monitor; здесь только накопление и арифметика, чтобы
+ * её можно было проверить на хосте.
+ *
+ * Рекомендация покрывает только исполненные ветви: стек, посчитанный после
+ * короткой сессии без калибровок, OTA и ошибок, будет занижен.
+ */
+
+namespace rc_vehicle {
+
+/** Регион кучи (ESP32: MALLOC_CAP_INTERNAL / DMA / SPIRAM). */
+enum class HeapRegion : uint8_t { Internal = 0, Dma, Psram, Count };
+
+inline constexpr size_t kHeapRegionCount =
+    static_cast<size_t>(HeapRegion::Count);
+
+const char* HeapRegionName(HeapRegion region) noexcept;
+
+/** Один опрос региона кучи (байты). */
+struct HeapSample {
+  uint32_t total{0};          ///< 0 — региона нет (например, без PSRAM)
+  uint32_t free{0};
+  uint32_t largest_block{0};  ///< Крупнейший свободный блок
+  uint32_t min_free{0};       ///< Минимум свободного с загрузки (аллокатор)
+};
+
+/** Накопленное по региону кучи. */
+struct HeapStats {
+  HeapSample last{};
+  uint32_t min_free{0};           ///< Наименьший свободный объём
+  uint32_t min_largest_block{0};  ///< Наименьший крупнейший блок
+  bool present{false};
+};
+
+/** Накопленное по стеку задачи. */
+struct StackStats {
+  char name[16]{};            ///< configMAX_TASK_NAME_LEN
+  uint32_t stack_bytes{0};    ///< Заданный размер; 0 — неизвестен
+  uint32_t min_free_bytes{0};  ///< Наименьший запас (high-water mark)
+  bool seen{false};            ///< Хотя бы один опрос застал задачу
+  bool alive{false};           ///< Задача найдена на последнем опросе
+};
+
+/** Рекомендация по стеку задачи. */
+struct StackAdvice {
+  uint32_t peak_used{0};    ///< stack_bytes − min_free_bytes
+  uint32_t recommended{0};  ///< RecommendStackBytes(peak_used)
+  int32_t reclaim{0};       ///< stack_bytes − recommended (< 0 — мало)
+};
+
+/**
+ * @brief Рекомендуемый размер стека: пик + MemMonitorConfig::kStackMarginPct
+ *        + kStackGuardBytes, вверх до kStackAlignBytes, не меньше
+ *        kMinStackBytes.
+ */
+uint32_t RecommendStackBytes(uint32_t peak_used) noexcept;
+
+/** Доля свободного, недоступная одним блоком: 100 − largest·100/free. */
+uint8_t FragmentationPct(uint32_t free, uint32_t largest_block) noexcept;
+
+/**
+ * @brief Таблица наблюдений (задачи + регионы куч), фиксированной ёмкости.
+ *
+ * Без синхронизации: вызывающий сериализует доступ.
+ */
+class MemStats {
+ public:
+  static constexpr size_t kMaxTasks = 24;
+
+  /**
+   * @brief Добавить задачу по имени (повторно — обновить размер стека)
+   * @return false — таблица заполнена
+   */
+  bool RegisterTask(const char* name, uint32_t stack_bytes) noexcept;
+
+  /** Запас стека задачи i на текущем опросе; задача жива. */
+  void UpdateStack(size_t i, uint32_t free_bytes) noexcept;
+
+  /** Задача i не найдена на опросе (удалена); минимум сохраняется. */
+  void MarkGone(size_t i) noexcept;
+
+  /** Опрос региона; total == 0 — региона нет. */
+  void UpdateHeap(HeapRegion region, const HeapSample& sample) noexcept;
+
+  void NoteSample() noexcept { ++samples_; }
+
+  [[nodiscard]] size_t TaskCount() const noexcept { return task_count_; }
+  [[nodiscard]] const StackStats& Task(size_t i) const noexcept {
+    return tasks_[i];
+  }
+  [[nodiscard]] const HeapStats& Heap(HeapRegion region) const noexcept {
+    return heaps_[static_cast<size_t>(region)];
+  }
+  [[nodiscard]] uint32_t Samples() const noexcept { return samples_; }
+
+  /** Рекомендация для задачи i; нули — размер неизвестен или не видели. */
+  [[nodiscard]] StackAdvice Advise(size_t i) const noexcept;
+
+  /** Сумма положительных reclaim: сколько RAM вернут рекомендации. */
+  [[nodiscard]] uint32_t ReclaimableBytes() const noexcept;
+
+  /** Задача с наименьшим запасом среди виденных; TaskCount() — нет таких. */
+  [[nodiscard]] size_t TightestTask() const noexcept;
+
+ private:
+  StackStats tasks_[kMaxTasks]{};
+  size_t task_count_{0};
+  HeapStats heaps_[kHeapRegionCount]{};
+  uint32_t samples_{0};
+};
+
+}  // namespace rc_vehicle
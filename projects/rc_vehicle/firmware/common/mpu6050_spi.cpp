@@ -1,5 +1,7 @@
 #include "mpu6050_spi.hpp"
 
+#include <algorithm>
+
 #ifdef ESP_PLATFORM
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
@@ -10,7 +12,6 @@ static const char* MPU_TAG = "mpu6050_spi";
 // Регистры MPU-6050
 #define MPU6050_REG_PWR_MGMT_1 0x6B
 #define MPU6050_REG_ACCEL_XOUT_H 0x3B
-#define MPU6050_REG_GYRO_XOUT_H 0x43
 #define MPU6050_REG_WHO_AM_I 0x75
 
 #define MPU6050_WHO_AM_I_VALUE 0x68
@@ -38,15 +39,6 @@ int Mpu6050Spi::WriteReg(uint8_t reg, uint8_t value) {
              : -1;
 }
 
-int Mpu6050Spi::ReadReg16(uint8_t reg, int16_t &value) {
-  uint8_t tx[3] = {static_cast<uint8_t>(reg | MPU6050_SPI_READ_BIT), 0, 0};
-  uint8_t rx[3] = {0, 0, 0};
-  if (spi_->Transfer(std::span<const uint8_t>(tx), std::span<uint8_t>(rx)) != 0)
-    return -1;
-  value = static_cast<int16_t>((rx[1] << 8) | rx[2]);
-  return 0;
-}
-
 int Mpu6050Spi::Init() {
   if (initialized_)
     return 0;
@@ -89,36 +81,47 @@ int Mpu6050Spi::Init() {
   return 0;
 }
 
-int Mpu6050Spi::Read(ImuData &data) {
-  if (!initialized_)
-    return -1;
-
-  int16_t raw_ax, raw_ay, raw_az;
-  int16_t raw_gx, raw_gy, raw_gz;
+size_t Mpu6050Spi::PrepareBurst(std::span<uint8_t> tx) const {
+  // ACCEL_XOUT_H..GYRO_ZOUT_L подряд (0x3B–0x48), big-endian
+  constexpr size_t kLen = 15;
+  std::fill(tx.begin(), tx.begin() + kLen, 0);
+  tx[0] = static_cast<uint8_t>(MPU6050_REG_ACCEL_XOUT_H | MPU6050_SPI_READ_BIT);
+  return kLen;
+}
 
-  if (ReadReg16(MPU6050_REG_ACCEL_XOUT_H, raw_ax) != 0)
-    return -1;
-  if (ReadReg16(MPU6050_REG_ACCEL_XOUT_H + 2, raw_ay) != 0)
-    return -1;
-  if (ReadReg16(MPU6050_REG_ACCEL_XOUT_H + 4, raw_az) != 0)
-    return -1;
-  if (ReadReg16(MPU6050_REG_GYRO_XOUT_H, raw_gx) != 0)
-    return -1;
-  if (ReadReg16(MPU6050_REG_GYRO_XOUT_H + 2, raw_gy) != 0)
-    return -1;
-  if (ReadReg16(MPU6050_REG_GYRO_XOUT_H + 4, raw_gz) != 0)
+int Mpu6050Spi::ParseBurst(std::span<const uint8_t> rx, ImuData &data) const {
+  if (!initialized_ || rx.size() < 15)
     return -1;
 
-  data.ax = static_cast<float>(raw_ax) / MPU6050_ACCEL_SCALE;
-  data.ay = static_cast<float>(raw_ay) / MPU6050_ACCEL_SCALE;
-  data.az = static_cast<float>(raw_az) / MPU6050_ACCEL_SCALE;
-  data.gx = static_cast<float>(raw_gx) / MPU6050_GYRO_SCALE;
-  data.gy = static_cast<float>(raw_gy) / MPU6050_GYRO_SCALE;
-  data.gz = static_cast<float>(raw_gz) / MPU6050_GYRO_SCALE;
+  auto to16 = [&](int i) -> int16_t {
+    return static_cast<int16_t>((rx[i] << 8) | rx[i + 1]);
+  };
+
+  // rx[7..8] — температура, пропускаем
+  data.ax = static_cast<float>(to16(1)) / MPU6050_ACCEL_SCALE;
+  data.ay = static_cast<float>(to16(3)) / MPU6050_ACCEL_SCALE;
+  data.az = static_cast<float>(to16(5)) / MPU6050_ACCEL_SCALE;
+  data.gx = static_cast<float>(to16(9)) / MPU6050_GYRO_SCALE;
+  data.gy = static_cast<float>(to16(11)) / MPU6050_GYRO_SCALE;
+  data.gz = static_cast<float>(to16(13)) / MPU6050_GYRO_SCALE;
 
   return 0;
 }
 
+int Mpu6050Spi::Read(ImuData &data) {
+  if (!initialized_)
+    return -1;
+
+  // Одна транзакция вместо шести: все оси из одного отсчёта датчика
+  uint8_t tx[kBurstMaxLen];
+  uint8_t rx[kBurstMaxLen] = {};
+  const size_t len = PrepareBurst(tx);
+  if (spi_->Transfer(std::span<const uint8_t>(tx, len),
+                     std::span<uint8_t>(rx, len)) != 0)
+    return -1;
+  return ParseBurst(std::span<const uint8_t>(rx, len), data);
+}
+
 void Mpu6050Spi::ConvertToTelem(const ImuData &data, int16_t &ax, int16_t &ay,
                                 int16_t &az, int16_t &gx, int16_t &gy,
                                 int16_t &gz) {
@@ -26,6 +26,10 @@ class Mpu6050Spi : public IImuSensor {
   /** Для отладки: последнее прочитанное WHO_AM_I (0x68/0x70 = OK, -1 = не читали). */
   int GetLastWhoAmI() const override { return last_who_am_i_; }
 
+  /** 15 байт: адрес ACCEL_XOUT_H + 6 accel + 2 temp + 6 gyro. */
+  size_t PrepareBurst(std::span<uint8_t> tx) const override;
+  int ParseBurst(std::span<const uint8_t> rx, ImuData &data) const override;
+
  private:
   SpiDevice *spi_;
   bool initialized_{false};
@@ -33,5 +37,4 @@ class Mpu6050Spi : public IImuSensor {
 
   int ReadReg(uint8_t reg, uint8_t &value);
   int WriteReg(uint8_t reg, uint8_t value);
-  int ReadReg16(uint8_t reg, int16_t &value);
 };
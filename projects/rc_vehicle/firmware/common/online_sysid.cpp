@@ -0,0 +1,155 @@
+#include "online_sysid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "config.hpp"
+
+namespace rc_vehicle {
+
+namespace {
+
+using Cfg = config::SysIdConfig;
+
+/// Шаг RLS [с]: окно из kDecimation тиков control loop
+constexpr float kSampleS =
+    static_cast<float>(Cfg::kDecimation *
+                       config::ControlLoopConfig::kPeriodMs) *
+    0.001f;
+
+}  // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// FirstOrderIdentifier
+// ─────────────────────────────────────────────────────────────────────────────
+
+FirstOrderIdentifier::FirstOrderIdentifier(float ts_s,
+                                           float min_input_var) noexcept
+    : rls_(Cfg::kForgetting, Cfg::kInitialCovariance,
+           Cfg::kMaxCovarianceTrace),
+      ts_s_(ts_s),
+      min_input_var_(min_input_var) {}
+
+bool FirstOrderIdentifier::Update(float u, float y, bool allow) noexcept {
+  // Дисперсия входа (EWMA) — критерий возбуждения
+  const float d = u - u_mean_;
+  u_mean_ += Cfg::kExcitationAlpha * d;
+  u_var_ = (1.0f - Cfg::kExcitationAlpha) *
+           (u_var_ + Cfg::kExcitationAlpha * d * d);
+
+  bool updated = false;
+  if (!allow) {
+    // Регрессор требует непрерывного ряда внутри разрешённого режима
+    have_prev_ = false;
+  } else if (have_prev_ && IsExcited()) {
+    rls_.Update({prev_y_, u, prev_u_, 1.0f}, y);
+    ++updates_;
+    updated = true;
+  }
+  prev_u_ = u;
+  prev_y_ = y;
+  if (allow) have_prev_ = true;
+  return updated;
+}
+
+void FirstOrderIdentifier::Reset() noexcept {
+  rls_.Reset({});
+  prev_u_ = 0.0f;
+  prev_y_ = 0.0f;
+  have_prev_ = false;
+  u_mean_ = 0.0f;
+  u_var_ = 0.0f;
+  updates_ = 0;
+}
+
+float FirstOrderIdentifier::Gain() const noexcept {
+  const float a = rls_.Theta()[0];
+  if (!(a < Cfg::kMaxPole)) return 0.0f;
+  return (rls_.Theta()[1] + rls_.Theta()[2]) / (1.0f - a);
+}
+
+float FirstOrderIdentifier::TimeConstantS() const noexcept {
+  const float a = rls_.Theta()[0];
+  if (!(a > 0.0f && a < Cfg::kMaxPole)) return 0.0f;
+  return -ts_s_ / std::log(a);
+}
+
+bool FirstOrderIdentifier::IsValid() const noexcept {
+  const float a = rls_.Theta()[0];
+  return updates_ >= Cfg::kMinUpdates && a > 0.0f && a < Cfg::kMaxPole;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// OnlineSysId
+// ─────────────────────────────────────────────────────────────────────────────
+
+OnlineSysId::OnlineSysId() noexcept
+    : steer_id_(kSampleS, Cfg::kMinSteerVar),
+      speed_id_(kSampleS, Cfg::kMinThrottleVar) {}
+
+void OnlineSysId::Update(const SysIdSample& s) {
+  if (reset_requested_.exchange(false, std::memory_order_acq_rel)) Reset();
+
+  if (window_ticks_ == 0) {
+    min_speed_ = s.speed_ms;
+    min_throttle_ = s.throttle;
+  } else {
+    min_speed_ = std::min(min_speed_, s.speed_ms);
+    min_throttle_ = std::min(min_throttle_, s.throttle);
+  }
+  sum_steering_ += s.steering;
+  sum_throttle_ += s.throttle;
+  sum_yaw_rate_ += s.yaw_rate_dps;
+  sum_speed_ += s.speed_ms;
+  if (++window_ticks_ < Cfg::kDecimation) return;
+
+  const float inv_n = 1.0f / static_cast<float>(window_ticks_);
+  steer_id_.Update(sum_steering_ * inv_n, sum_yaw_rate_ * inv_n,
+                   min_speed_ > Cfg::kMinSpeedMs);
+  speed_id_.Update(sum_throttle_ * inv_n, sum_speed_ * inv_n,
+                   min_throttle_ >= 0.0f);
+
+  window_ticks_ = 0;
+  sum_steering_ = 0.0f;
+  sum_throttle_ = 0.0f;
+  sum_yaw_rate_ = 0.0f;
+  sum_speed_ = 0.0f;
+  Publish();
+}
+
+SysIdEstimate OnlineSysId::GetEstimate() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return published_;
+}
+
+void OnlineSysId::Reset() {
+  steer_id_.Reset();
+  speed_id_.Reset();
+  window_ticks_ = 0;
+  sum_steering_ = 0.0f;
+  sum_throttle_ = 0.0f;
+  sum_yaw_rate_ = 0.0f;
+  sum_speed_ = 0.0f;
+  Publish();
+}
+
+void OnlineSysId::Publish() {
+  SysIdEstimate e;
+  e.steer_gain_dps = steer_id_.Gain();
+  e.steer_tau_s = steer_id_.TimeConstantS();
+  e.steer_valid = steer_id_.IsValid();
+  e.steer_updates = steer_id_.Updates();
+  e.speed_gain_ms = speed_id_.Gain();
+  e.speed_tau_s = speed_id_.TimeConstantS();
+  e.speed_valid = speed_id_.IsValid();
+  e.speed_updates = speed_id_.Updates();
+  std::lock_guard<std::mutex> lock(mutex_);
+  published_ = e;
+}
+
+float RateLimitedApply(float current, float target, float max_frac) noexcept {
+  const float step = std::abs(current) * max_frac;
+  return std::clamp(target, current - step, current + step);
+}
+
+}  // namespace rc_vehicle
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace rc_vehicle {
+
+// ═════════════════════════════════════════════════════════════════════════════
+// RecursiveLeastSquares
+// ═════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Рекурсивный МНК с экспоненциальным забыванием, N параметров.
+ *
+ * Модель y = φᵀθ. Шаг Update() — O(N²) без аллокаций и делений, кроме
+ * одного скалярного. Ковариация P симметризуется на каждом шаге, след P
+ * ограничивается max_trace (защита от «раздувания» при забывании).
+ */
+template <size_t N>
+class RecursiveLeastSquares {
+ public:
+  using Vec = std::array<float, N>;
+
+  /**
+   * @param forgetting Коэффициент забывания λ (0 < λ ≤ 1)
+   * @param initial_cov Начальная диагональ P
+   * @param max_trace Предел следа P
+   */
+  RecursiveLeastSquares(float forgetting, float initial_cov,
+                        float max_trace) noexcept
+      : lambda_(forgetting), p0_(initial_cov), max_trace_(max_trace) {
+    Reset(Vec{});
+  }
+
+  /** Начать заново с оценки theta0 и P = initial_cov · I. */
+  void Reset(const Vec& theta0) noexcept {
+    theta_ = theta0;
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < N; ++j) P_[i][j] = (i == j) ? p0_ : 0.0f;
+    }
+  }
+
+  /**
+   * @brief Один шаг: регрессор phi, измерение y.
+   * @return Априорная ошибка предсказания y − φᵀθ
+   */
+  float Update(const Vec& phi, float y) noexcept {
+    Vec p_phi{};
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < N; ++j) p_phi[i] += P_[i][j] * phi[j];
+    }
+    float denom = lambda_;
+    float y_hat = 0.0f;
+    for (size_t i = 0; i < N; ++i) {
+      denom += phi[i] * p_phi[i];
+      y_hat += phi[i] * theta_[i];
+    }
+    const float err = y - y_hat;
+    const float inv_denom = 1.0f / denom;
+    const float inv_lambda = 1.0f / lambda_;
+
+    float trace = 0.0f;
+    for (size_t i = 0; i < N; ++i) {
+      const float k = p_phi[i] * inv_denom;
+      theta_[i] += k * err;
+      // P = (P − k·(Pφ)ᵀ) / λ; P симметрична, поэтому φᵀP = (Pφ)ᵀ
+      for (size_t j = 0; j <= i; ++j) {
+        const float v = (P_[i][j] - k * p_phi[j]) * inv_lambda;
+        P_[i][j] = v;
+        P_[j][i] = v;
+      }
+      trace += P_[i][i];
+    }
+    if (trace > max_trace_) {
+      const float s = max_trace_ / trace;
+      for (auto& row : P_) {
+        for (float& v : row) v *= s;
+      }
+    }
+    return err;
+  }
+
+  [[nodiscard]] const Vec& Theta() const noexcept { return theta_; }
+
+  [[nodiscard]] float CovTrace() const noexcept {
+    float t = 0.0f;
+    for (size_t i = 0; i < N; ++i) t += P_[i][i];
+    return t;
+  }
+
+ private:
+  float lambda_;
+  float p0_;
+  float max_trace_;
+  Vec theta_{};
+  std::array<std::array<float, N>, N> P_{};
+};
+
+// ═════════════════════════════════════════════════════════════════════════════
+// FirstOrderIdentifier
+// ═════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Идентификация звена первого порядка y' = (K·u − y) / τ по
+ *        дискретной модели y[k] = a·y[k−1] + b0·u[k] + b1·u[k−1] + c.
+ *
+ * Отсчёты — средние по окну, поэтому вход окна k уже влияет на y[k]:
+ * без члена b0 оценка K смещена. K = (b0 + b1) / (1 − a),
+ * τ = −Ts / ln(a); смещение c поглощает мёртвую зону ESC и остаточный
+ * trim. Обновление только при возбуждении: сглаженная
+ * дисперсия входа выше min_input_var. Без возбуждения оценка замораживается
+ * (забывание не применяется — ковариация не раздувается).
+ */
+class FirstOrderIdentifier {
+ public:
+  /**
+   * @param ts_s Шаг отсчётов [с]
+   * @param min_input_var Порог дисперсии входа (excitation check)
+   */
+  FirstOrderIdentifier(float ts_s, float min_input_var) noexcept;
+
+  /**
+   * @brief Один отсчёт.
+   * @param allow Разрешён ли шаг RLS (гейтинг режима движения); при false
+   *              отсчёт только запоминается как предыдущий
+   * @return true если оценка обновлена
+   */
+  bool Update(float u, float y, bool allow) noexcept;
+
+  void Reset() noexcept;
+
+  /** Статический коэффициент K [ед. y на ед. u]. */
+  [[nodiscard]] float Gain() const noexcept;
+
+  /** Постоянная времени τ [с] (0 если полюс вне (0, 1)). */
+  [[nodiscard]] float TimeConstantS() const noexcept;
+
+  /** Достаточно обновлений и устойчивый полюс. */
+  [[nodiscard]] bool IsValid() const noexcept;
+
+  [[nodiscard]] uint32_t Updates() const noexcept { return updates_; }
+  [[nodiscard]] bool IsExcited() const noexcept {
+    return u_var_ > min_input_var_;
+  }
+
+ private:
+  RecursiveLeastSquares<4> rls_;
+  float ts_s_;
+  float min_input_var_;
+  float prev_u_{0.0f};
+  float prev_y_{0.0f};
+  bool have_prev_{false};
+  float u_mean_{0.0f};
+  float u_var_{0.0f};
+  uint32_t updates_{0};
+};
+
+// ═════════════════════════════════════════════════════════════════════════════
+// OnlineSysId
+// ═════════════════════════════════════════════════════════════════════════════
+
+/** Вход одного тика control loop. */
+struct SysIdSample {
+  float steering{0.0f};      ///< Руль на входе PWM без trim [-1..1]
+  float throttle{0.0f};      ///< Газ на входе PWM без trim [-1..1]
+  float yaw_rate_dps{0.0f};  ///< Отфильтрованный gz [dps]
+  float speed_ms{0.0f};      ///< Скорость EKF [м/с]
+};
+
+/** Опубликованные оценки (WS-телеметрия, get_sysid). */
+struct SysIdEstimate {
+  float steer_gain_dps{0.0f};  ///< dps на единицу руля
+  float steer_tau_s{0.0f};
+  bool steer_valid{false};
+  uint32_t steer_updates{0};
+
+  float speed_gain_ms{0.0f};  ///< м/с на единицу газа
+  float speed_tau_s{0.0f};
+  bool speed_valid{false};
+  uint32_t speed_updates{0};
+};
+
+/**
+ * @brief Онлайн-идентификация руль → yaw rate и газ → скорость.
+ *
+ * Вызывается каждый тик control loop (Update). Отсчёты усредняются по
+ * config::SysIdConfig::kDecimation тикам (анти-алиасинг, шаг RLS 20 мс);
+ * на границе окна — по шагу RLS на каждую модель. Стоимость тика
+ * ограничена: суммирование на обычных тиках, 2 × RLS<4> на граничных
+ * (замер — RunFilterBenchmark, sysid_sps).
+ *
+ * Гейтинг: руль — только при движении вперёд быстрее kMinSpeedMs (на месте
+ * yaw rate не отвечает на руль, коэффициент зависит от скорости); газ —
+ * только окна без торможения/реверса.
+ *
+ * Потоки: Update() — только control loop; GetEstimate(), RequestReset(),
+ * SetApplyEnabled() — из любой задачи.
+ */
+class OnlineSysId {
+ public:
+  OnlineSysId() noexcept;
+  OnlineSysId(const OnlineSysId&) = delete;
+  OnlineSysId& operator=(const OnlineSysId&) = delete;
+
+  /** Один тик control loop. */
+  void Update(const SysIdSample& s);
+
+  /** Копия последних оценок (потокобезопасно). */
+  [[nodiscard]] SysIdEstimate GetEstimate() const;
+
+  /** Сбросить оценки на следующем тике. */
+  void RequestReset() noexcept {
+    reset_requested_.store(true, std::memory_order_release);
+  }
+
+  /** Применять оценку руля к yaw-регулятору (не сохраняется в NVS). */
+  void SetApplyEnabled(bool enabled) noexcept {
+    apply_enabled_.store(enabled, std::memory_order_relaxed);
+  }
+  [[nodiscard]] bool IsApplyEnabled() const noexcept {
+    return apply_enabled_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void Reset();
+  void Publish();
+
+  FirstOrderIdentifier steer_id_;
+  FirstOrderIdentifier speed_id_;
+
+  // Окно усреднения
+  uint32_t window_ticks_{0};
+  float sum_steering_{0.0f};
+  float sum_throttle_{0.0f};
+  float sum_yaw_rate_{0.0f};
+  float sum_speed_{0.0f};
+  float min_speed_{0.0f};
+  float min_throttle_{0.0f};
+
+  std::atomic<bool> reset_requested_{false};
+  std::atomic<bool> apply_enabled_{false};
+  mutable std::mutex mutex_;
+  SysIdEstimate published_;
+};
+
+/**
+ * @brief Шаг применения оценки с ограничением скорости изменения.
+ * @return current, сдвинутый к target не более чем на max_frac · current
+ */
+[[nodiscard]] float RateLimitedApply(float current, float target,
+                                     float max_frac) noexcept;
+
+}  // namespace rc_vehicle
@@ -0,0 +1,201 @@
+#include "ota_update.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#include "config.hpp"
+
+namespace rc_vehicle {
+
+// ─────────────────────────────────────────────────────────────────────────────
+// CRC-32 / имена ошибок
+// ─────────────────────────────────────────────────────────────────────────────
+
+uint32_t Crc32(const uint8_t* data, size_t len, uint32_t crc) noexcept {
+  crc = ~crc;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    for (int k = 0; k < 8; ++k) {
+      crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+  }
+  return ~crc;
+}
+
+const char* OtaErrorName(OtaError e) noexcept {
+  switch (e) {
+    case OtaError::None:
+      return "none";
+    case OtaError::BadMagic:
+      return "bad_magic";
+    case OtaError::BadVersion:
+      return "bad_version";
+    case OtaError::BadHeaderCrc:
+      return "bad_header_crc";
+    case OtaError::BadCodec:
+      return "bad_codec";
+    case OtaError::TooLarge:
+      return "too_large";
+    case OtaError::Corrupt:
+      return "corrupt";
+    case OtaError::SizeMismatch:
+      return "size_mismatch";
+    case OtaError::CrcMismatch:
+      return "crc_mismatch";
+    case OtaError::SinkFailed:
+      return "flash_failed";
+    case OtaError::Moving:
+      return "vehicle_moving";
+    case OtaError::Busy:
+      return "busy";
+    case OtaError::Aborted:
+      return "aborted";
+  }
+  return "unknown";
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// OtaImageWriter
+// ─────────────────────────────────────────────────────────────────────────────
+
+OtaImageWriter::OtaImageWriter(OtaSink& sink, uint32_t max_image_size)
+    : sink_(sink), max_image_size_(max_image_size) {
+  chunk_.reserve(config::OtaConfig::kWriteChunkBytes);
+}
+
+OtaError OtaImageWriter::Fail(OtaError e) {
+  if (error_ == OtaError::None) {
+    error_ = e;
+    if (sink_begun_) sink_.Abort();
+    sink_begun_ = false;
+  }
+  return error_;
+}
+
+void OtaImageWriter::Abort(OtaError reason) { Fail(reason); }
+
+OtaError OtaImageWriter::Feed(const uint8_t* data, size_t len) {
+  if (error_ != OtaError::None) return error_;
+  if (!HeaderParsed()) {
+    const size_t n = std::min(len, sizeof(OtaImageHeader) - header_len_);
+    std::memcpy(reinterpret_cast<uint8_t*>(&header_) + header_len_, data, n);
+    header_len_ += n;
+    data += n;
+    len -= n;
+    if (!HeaderParsed()) return OtaError::None;
+    if (const OtaError e = ParseHeader(); e != OtaError::None) return Fail(e);
+  }
+  return len > 0 ? FeedPayload(data, len) : OtaError::None;
+}
+
+OtaError OtaImageWriter::ParseHeader() {
+  if (header_.magic != OtaImageHeader::kMagic) return OtaError::BadMagic;
+  if (header_.version != OtaImageHeader::kVersion) {
+    return OtaError::BadVersion;
+  }
+  const uint32_t crc = Crc32(reinterpret_cast<const uint8_t*>(&header_),
+                             offsetof(OtaImageHeader, header_crc32));
+  if (crc != header_.header_crc32) return OtaError::BadHeaderCrc;
+  if (header_.codec != static_cast<uint8_t>(OtaCodec::Store) &&
+      header_.codec != static_cast<uint8_t>(OtaCodec::Lzss)) {
+    return OtaError::BadCodec;
+  }
+  if (header_.raw_size == 0 || header_.raw_size > max_image_size_) {
+    return OtaError::TooLarge;
+  }
+  if (!sink_.Begin(header_.raw_size)) return OtaError::SinkFailed;
+  sink_begun_ = true;
+  return OtaError::None;
+}
+
+OtaError OtaImageWriter::FeedPayload(const uint8_t* data, size_t len) {
+  if (len > header_.payload_size - payload_received_) {
+    return Fail(OtaError::SizeMismatch);
+  }
+  payload_received_ += static_cast<uint32_t>(len);
+
+  auto emit = [this](uint8_t b) { Emit(b); };
+  if (header_.codec == static_cast<uint8_t>(OtaCodec::Store)) {
+    for (size_t i = 0; i < len; ++i) emit(data[i]);
+  } else if (!lzss_.Feed(data, len, emit)) {
+    return Fail(OtaError::Corrupt);
+  }
+  if (sink_failed_) return Fail(OtaError::SinkFailed);
+  if (overflow_) return Fail(OtaError::SizeMismatch);
+  return OtaError::None;
+}
+
+void OtaImageWriter::Emit(uint8_t b) {
+  if (overflow_ || sink_failed_) return;
+  if (raw_out_ >= header_.raw_size) {
+    overflow_ = true;
+    return;
+  }
+  ++raw_out_;
+  chunk_.push_back(b);
+  // Сброс внутри распаковки: одна входная порция может дать много порций
+  if (chunk_.size() == config::OtaConfig::kWriteChunkBytes && !FlushChunk()) {
+    sink_failed_ = true;
+  }
+}
+
+bool OtaImageWriter::FlushChunk() {
+  if (chunk_.empty()) return true;
+  crc_ = Crc32(chunk_.data(), chunk_.size(), crc_);
+  if (!sink_begun_ || !sink_.Write(chunk_.data(), chunk_.size())) {
+    return false;
+  }
+  raw_written_ += static_cast<uint32_t>(chunk_.size());
+  chunk_.clear();
+  return true;
+}
+
+OtaError OtaImageWriter::Finish() {
+  if (error_ != OtaError::None) return error_;
+  if (!HeaderParsed() || payload_received_ != header_.payload_size ||
+      raw_out_ != header_.raw_size || !lzss_.AtItemBoundary()) {
+    return Fail(OtaError::SizeMismatch);
+  }
+  if (!FlushChunk()) return Fail(OtaError::SinkFailed);
+  if (crc_ != header_.raw_crc32) return Fail(OtaError::CrcMismatch);
+  sink_begun_ = false;
+  if (!sink_.Finish()) {
+    error_ = OtaError::SinkFailed;
+    sink_.Abort();
+  }
+  return error_;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// OtaConfirmGuard
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool OtaConfirmGuard::Due(uint32_t now_ms) const noexcept {
+  using Cfg = config::OtaConfig;
+  if (now_ms < Cfg::kConfirmDelayMs) return false;
+  return attempts_ == 0 || now_ms - last_ms_ >= Cfg::kConfirmRetryMs;
+}
+
+bool OtaConfirmGuard::Passed(const std::vector<SelfTestItem>& results) {
+  for (const char* name : kRequiredChecks) {
+    const auto it = std::find_if(results.begin(), results.end(),
+                                 [name](const SelfTestItem& i) {
+                                   return std::strcmp(i.name, name) == 0;
+                                 });
+    if (it == results.end() || !it->passed) return false;
+  }
+  return true;
+}
+
+OtaConfirmDecision OtaConfirmGuard::Step(
+    uint32_t now_ms, const std::vector<SelfTestItem>& results) {
+  ++attempts_;
+  last_ms_ = now_ms;
+  if (Passed(results)) return OtaConfirmDecision::Valid;
+  return attempts_ >= config::OtaConfig::kConfirmAttempts
+             ? OtaConfirmDecision::Rollback
+             : OtaConfirmDecision::Wait;
+}
+
+}  // namespace rc_vehicle
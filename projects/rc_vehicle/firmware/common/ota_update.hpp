@@ -0,0 +1,270 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "self_test.hpp"
+
+namespace rc_vehicle {
+
+// ═════════════════════════════════════════════════════════════════════════════
+// Формат образа OTA
+// ═════════════════════════════════════════════════════════════════════════════
+
+/** Кодек полезной нагрузки OtaImageHeader::codec. */
+enum class OtaCodec : uint8_t {
+  Store = 0,  ///< Без сжатия
+  Lzss = 1,   ///< LZSS, окно 4096, см. LzssDecoder
+};
+
+/**
+ * @brief Заголовок образа OTA (POST /api/ota, tools/ota_pack.py).
+ *
+ * Формат (little-endian): заголовок, затем payload_size байт нагрузки.
+ * raw_size / raw_crc32 — распакованного app-образа (ESP-IDF .bin);
+ * header_crc32 — CRC-32 первых 28 байт заголовка.
+ */
+struct OtaImageHeader {
+  static constexpr uint32_t kMagic = 0x544F4352u;  ///< "RCOT"
+  static constexpr uint16_t kVersion = 1;
+
+  uint32_t magic{kMagic};
+  uint16_t version{kVersion};
+  uint8_t codec{0};  ///< OtaCodec
+  uint8_t reserved{0};
+  uint32_t raw_size{0};
+  uint32_t payload_size{0};
+  uint32_t raw_crc32{0};
+  uint32_t reserved2{0};
+  uint32_t build_id{0};  ///< Произвольная метка сборки (для /api/ota/status)
+  uint32_t header_crc32{0};
+};
+
+static_assert(sizeof(OtaImageHeader) == 32,
+              "OtaImageHeader: wire format is 32 bytes");
+
+/** CRC-32 (IEEE 802.3, как zlib.crc32); crc — значение предыдущей части. */
+uint32_t Crc32(const uint8_t* data, size_t len, uint32_t crc = 0) noexcept;
+
+/** Ошибки приёма образа. */
+enum class OtaError : uint8_t {
+  None = 0,
+  BadMagic,
+  BadVersion,
+  BadHeaderCrc,
+  BadCodec,
+  TooLarge,      ///< raw_size больше слота OTA
+  Corrupt,       ///< Ссылка LZSS за пределы выведенных данных
+  SizeMismatch,  ///< Нагрузка или распакованный образ не того размера
+  CrcMismatch,
+  SinkFailed,  ///< Ошибка записи / проверки образа во флеше
+  Moving,      ///< Машина движется — обновление запрещено
+  Busy,        ///< Уже идёт обновление
+  Aborted,
+};
+
+[[nodiscard]] const char* OtaErrorName(OtaError e) noexcept;
+
+// ═════════════════════════════════════════════════════════════════════════════
+// LzssDecoder
+// ═════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Потоковая распаковка LZSS с окном 4096 байт.
+ *
+ * Поток — группы: байт флагов (LSB первым), за ним до 8 элементов.
+ * Бит 1 — литерал (1 байт). Бит 0 — ссылка (2 байта, LE): младшие 12 бит —
+ * offset − 1 (1…4096 назад), старшие 4 — length − 3 (3…18). Ссылка может
+ * перекрывать текущую позицию (повтор). Вход подаётся порциями любого
+ * размера, в том числе по байту.
+ */
+class LzssDecoder {
+ public:
+  static constexpr size_t kWindow = 4096;
+  static constexpr size_t kMinMatch = 3;
+
+  void Reset() noexcept { *this = LzssDecoder{}; }
+
+  /**
+   * @brief Распаковать порцию входа.
+   * @param emit Вызывается как emit(uint8_t) для каждого выходного байта
+   * @return false — поток повреждён (ссылка назад дальше начала)
+   */
+  template <typename Emit>
+  bool Feed(const uint8_t* in, size_t len, Emit&& emit) {
+    for (size_t i = 0; i < len; ++i) {
+      const uint8_t b = in[i];
+      if (flag_bits_ == 0) {
+        flags_ = b;
+        flag_bits_ = 8;
+        continue;
+      }
+      if (flags_ & 1u) {
+        Put(b, emit);
+        NextItem();
+        continue;
+      }
+      if (!have_lo_) {
+        lo_ = b;
+        have_lo_ = true;
+        continue;
+      }
+      have_lo_ = false;
+      const uint16_t ref = static_cast<uint16_t>(lo_ | (b << 8));
+      const size_t offset = (ref & 0x0FFFu) + 1;
+      const size_t length = (ref >> 12) + kMinMatch;
+      if (offset > total_) return false;
+      for (size_t k = 0; k < length; ++k) {
+        Put(window_[(pos_ + kWindow - offset) % kWindow], emit);
+      }
+      NextItem();
+    }
+    return true;
+  }
+
+  /** Поток завершён на границе элемента (не оборван посреди ссылки). */
+  [[nodiscard]] bool AtItemBoundary() const noexcept { return !have_lo_; }
+  [[nodiscard]] uint64_t TotalOut() const noexcept { return total_; }
+
+ private:
+  template <typename Emit>
+  void Put(uint8_t b, Emit& emit) {
+    window_[pos_] = b;
+    pos_ = (pos_ + 1) % kWindow;
+    ++total_;
+    emit(b);
+  }
+
+  void NextItem() noexcept {
+    flags_ >>= 1;
+    --flag_bits_;
+  }
+
+  std::array<uint8_t, kWindow> window_{};
+  size_t pos_{0};
+  uint64_t total_{0};
+  uint8_t flags_{0};
+  uint8_t flag_bits_{0};
+  uint8_t lo_{0};
+  bool have_lo_{false};
+};
+
+// ═════════════════════════════════════════════════════════════════════════════
+// OtaImageWriter
+// ═════════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Приёмник распакованного образа.
+ *
+ * ESP32: esp_ota_begin / esp_ota_write / esp_ota_end + set_boot_partition;
+ * хост-тесты — буфер в памяти.
+ */
+class OtaSink {
+ public:
+  virtual ~OtaSink() = default;
+  virtual bool Begin(uint32_t image_size) = 0;
+  virtual bool Write(const uint8_t* data, size_t len) = 0;
+  /** Проверить образ и сделать его загрузочным. */
+  virtual bool Finish() = 0;
+  virtual void Abort() = 0;
+};
+
+/**
+ * @brief Приём образа OTA: заголовок → распаковка → запись в OtaSink
+ *        порциями config::OtaConfig::kWriteChunkBytes.
+ *
+ * Feed() принимает тело запроса порциями любого размера; первая ошибка
+ * запоминается и вызывает sink.Abort(). Finish() проверяет размеры и CRC
+ * распакованного образа и только тогда вызывает sink.Finish().
+ */
+class OtaImageWriter {
+ public:
+  /** @param max_image_size Размер слота OTA (больше — TooLarge) */
+  OtaImageWriter(OtaSink& sink, uint32_t max_image_size);
+
+  OtaError Feed(const uint8_t* data, size_t len);
+  OtaError Finish();
+  void Abort(OtaError reason = OtaError::Aborted);
+
+  [[nodiscard]] OtaError Error() const noexcept { return error_; }
+  [[nodiscard]] bool HeaderParsed() const noexcept {
+    return header_len_ == sizeof(OtaImageHeader);
+  }
+  [[nodiscard]] const OtaImageHeader& Header() const noexcept {
+    return header_;
+  }
+  [[nodiscard]] uint32_t PayloadReceived() const noexcept {
+    return payload_received_;
+  }
+  [[nodiscard]] uint32_t RawWritten() const noexcept { return raw_written_; }
+
+ private:
+  OtaError ParseHeader();
+  OtaError FeedPayload(const uint8_t* data, size_t len);
+  void Emit(uint8_t b);
+  bool FlushChunk();
+  OtaError Fail(OtaError e);
+
+  OtaSink& sink_;
+  uint32_t max_image_size_;
+  OtaImageHeader header_{};
+  size_t header_len_{0};
+  uint32_t payload_received_{0};
+  uint32_t raw_out_{0};      ///< Распаковано байт (включая буфер)
+  uint32_t raw_written_{0};  ///< Передано в sink
+  uint32_t crc_{0};  ///< CRC-32 переданного в sink
+  bool overflow_{false};
+  bool sink_failed_{false};
+  bool sink_begun_{false};
+  OtaError error_{OtaError::None};
+  LzssDecoder lzss_;
+  std::vector<uint8_t> chunk_;
+};
+
+// ═════════════════════════════════════════════════════════════════════════════
+// OtaConfirmGuard
+// ═════════════════════════════════════════════════════════════════════════════
+
+/** Решение по новому образу после перезагрузки. */
+enum class OtaConfirmDecision : uint8_t {
+  Wait,      ///< Ещё рано / следующая попытка self-test
+  Valid,     ///< Образ подтверждён (отменить откат)
+  Rollback,  ///< Self-test не прошёл — откатиться на предыдущий
+};
+
+/**
+ * @brief Подтверждение нового образа по self-test.
+ *
+ * Первая проверка — через kConfirmDelayMs после загрузки (авто-калибровка
+ * IMU), затем до kConfirmAttempts попыток с шагом kConfirmRetryMs.
+ * Учитываются только проверки из kRequiredChecks — те, что доказывают
+ * работоспособность образа. Проверки среды (неподвижность, частота в окне,
+ * пульт, время загрузки) могут не пройти и на исправном образе, если машину
+ * толкнули или цикл нагружен, и откат из-за них не выполняется.
+ */
+class OtaConfirmGuard {
+ public:
+  /** Проверки self-test, обязательные для подтверждения образа. */
+  static constexpr const char* kRequiredChecks[] = {
+      "imu_available", "control_loop_running", "pwm_ok", "calib_valid"};
+
+  /** Нужна ли проверка на этом тике (не чаще kConfirmRetryMs). */
+  [[nodiscard]] bool Due(uint32_t now_ms) const noexcept;
+
+  /** Учесть результат self-test, выполненного в момент now_ms. */
+  OtaConfirmDecision Step(uint32_t now_ms,
+                          const std::vector<SelfTestItem>& results);
+
+  [[nodiscard]] uint8_t Attempts() const noexcept { return attempts_; }
+
+  /** Пройдены ли все проверки, существенные для подтверждения. */
+  [[nodiscard]] static bool Passed(const std::vector<SelfTestItem>& results);
+
+ private:
+  uint8_t attempts_{0};
+  uint32_t last_ms_{0};
+};
+
+}  // namespace rc_vehicle
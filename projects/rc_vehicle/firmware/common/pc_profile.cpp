@@ -0,0 +1,131 @@
+#include "pc_profile.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#endif
+
+namespace rc_vehicle {
+
+namespace {
+
+constexpr size_t kMinCapacity = 16;
+
+uint32_t HashSample(const PcSample& s) noexcept {
+  // Мультипликативное смешивание (Knuth): дёшево в ISR, равномерно для
+  // адресов кода, у которых младшие биты почти всегда одинаковы
+  constexpr uint32_t kGolden = 0x9E3779B1u;
+  uint32_t h = (s.task ^ (static_cast<uint32_t>(s.core) << 24)) * kGolden;
+  for (uint8_t i = 0; i < s.depth; ++i) {
+    h = ((h << 5) | (h >> 27)) ^ s.pcs[i];
+    h *= kGolden;
+  }
+  return h ^ (h >> 16);
+}
+
+bool SameStack(const PcProfileEntry& e, const PcSample& s) noexcept {
+  if (e.task != s.task || e.core != s.core || e.depth != s.depth) {
+    return false;
+  }
+  for (uint8_t i = 0; i < s.depth; ++i) {
+    if (e.pcs[i] != s.pcs[i]) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+PcProfileTable::~PcProfileTable() {
+  if (entries_) {
+#ifdef ESP_PLATFORM
+    heap_caps_free(entries_);
+#else
+    free(entries_);
+#endif
+    entries_ = nullptr;
+  }
+}
+
+bool PcProfileTable::Init(size_t capacity) {
+  if (entries_ || capacity < kMinCapacity) return false;
+  size_t pow2 = kMinCapacity;
+  while (pow2 * 2 <= capacity) pow2 *= 2;
+
+  const size_t bytes = pow2 * sizeof(PcProfileEntry);
+#ifdef ESP_PLATFORM
+  // Пробуем выделить из PSRAM; при отказе — fallback на обычную heap
+  entries_ = static_cast<PcProfileEntry*>(
+      heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  if (!entries_) {
+    entries_ = static_cast<PcProfileEntry*>(malloc(bytes));
+  }
+#else
+  entries_ = static_cast<PcProfileEntry*>(malloc(bytes));
+#endif
+  if (!entries_) return false;
+
+  capacity_ = pow2;
+  Clear();
+  return true;
+}
+
+bool PcProfileTable::Record(const PcSample& sample) noexcept {
+  if (!entries_) return false;
+  PcSample s = sample;
+  if (s.depth > kPcProfileMaxDepth) s.depth = kPcProfileMaxDepth;
+
+  const size_t mask = capacity_ - 1;
+  size_t idx = HashSample(s) & mask;
+  for (size_t probe = 0; probe < kMaxProbe; ++probe) {
+    PcProfileEntry& e = entries_[idx];
+    if (e.count == 0) {
+      e.task = s.task;
+      e.core = s.core;
+      e.depth = s.depth;
+      for (size_t i = 0; i < kPcProfileMaxDepth; ++i) {
+        e.pcs[i] = i < s.depth ? s.pcs[i] : 0;
+      }
+      e.count = 1;
+      used_.fetch_add(1, std::memory_order_relaxed);
+      samples_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+    if (SameStack(e, s)) {
+      ++e.count;
+      samples_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+    idx = (idx + 1) & mask;
+  }
+  dropped_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+bool PcProfileTable::HasTask(uint32_t task) const noexcept {
+  for (size_t i = 0; i < task_count_; ++i) {
+    if (tasks_[i].task == task) return true;
+  }
+  return false;
+}
+
+void PcProfileTable::NoteTask(uint32_t task, const char* name) noexcept {
+  if (task_count_ >= kMaxTasks || HasTask(task)) return;
+  PcProfileTask& t = tasks_[task_count_];
+  t.task = task;
+  std::memset(t.name, 0, sizeof(t.name));
+  if (name) std::strncpy(t.name, name, sizeof(t.name) - 1);
+  ++task_count_;
+}
+
+void PcProfileTable::Clear() noexcept {
+  if (entries_) std::fill(entries_, entries_ + capacity_, PcProfileEntry{});
+  used_.store(0, std::memory_order_relaxed);
+  samples_.store(0, std::memory_order_relaxed);
+  dropped_.store(0, std::memory_order_relaxed);
+  task_count_ = 0;
+}
+
+}  // namespace rc_vehicle
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file pc_profile.hpp
+ * @brief Гистограмма семплов PC для статистического профилировщика.
+ *
+ * Таймер высокой частоты прерывает ядро и снимает прерванный PC и короткий
+ * backtrace (esp32_common/pc_sampler.cpp). Одинаковые стеки одной задачи
+ * складываются в одну запись (count++), поэтому таблица остаётся маленькой
+ * даже за минуты езды. Выгрузка — GET /api/profile.bin, символизация и
+ * folded stacks для flame graph — tools/pc_profile.py.
+ *
+ * Один писатель на таблицу (ISR своего ядра): Record() без выделений и
+ * блокировок, не дольше kMaxProbe проб. Читать записи (ForEach) — только
+ * при остановленном семплировании; счётчики — в любой момент.
+ */
+
+namespace rc_vehicle {
+
+/// Кадров стека в семпле: PC + 5 вызывающих
+inline constexpr size_t kPcProfileMaxDepth = 6;
+
+/** Семпл: pcs[0] — прерванный PC, pcs[1..depth) — адреса возврата. */
+struct PcSample {
+  uint32_t task{0};  ///< Идентификатор задачи (TaskHandle_t); 0 — ISR
+  uint8_t core{0};
+  uint8_t depth{0};  ///< 0 — стек недоступен (вложенное прерывание)
+  uint32_t pcs[kPcProfileMaxDepth]{};
+};
+
+/** Запись гистограммы; в выгрузке — как есть (little-endian). */
+struct PcProfileEntry {
+  uint32_t count{0};  ///< 0 — свободный слот
+  uint32_t task{0};
+  uint8_t core{0};
+  uint8_t depth{0};
+  uint16_t reserved{0};
+  uint32_t pcs[kPcProfileMaxDepth]{};
+};
+
+static_assert(sizeof(PcProfileEntry) == 36,
+              "PcProfileEntry: wire format is 36 bytes");
+
+/** Имя задачи для выгрузки (id → pcTaskGetName). */
+struct PcProfileTask {
+  uint32_t task{0};
+  char name[16]{};
+};
+
+static_assert(sizeof(PcProfileTask) == 20,
+              "PcProfileTask: wire format is 20 bytes");
+
+/**
+ * @brief Заголовок GET /api/profile.bin.
+ *
+ * Формат (little-endian): заголовок, entry_count × entry_size байт
+ * PcProfileEntry, task_count × task_size байт PcProfileTask.
+ */
+struct PcProfileHeader {
+  static constexpr uint32_t kMagic = 0x46504350u;  ///< "PCPF"
+  static constexpr uint16_t kVersion = 1;
+
+  uint32_t magic{kMagic};
+  uint16_t version{kVersion};
+  uint16_t entry_size{sizeof(PcProfileEntry)};
+  uint32_t entry_count{0};
+  uint16_t task_size{sizeof(PcProfileTask)};
+  uint16_t task_count{0};
+  uint32_t samples{0};      ///< Семплов в записях (сумма count)
+  uint32_t dropped{0};      ///< Не поместились: таблица переполнена
+  uint32_t hz{0};           ///< Частота семплирования на ядро
+  uint32_t duration_ms{0};  ///< Длительность сессии
+  uint8_t max_depth{kPcProfileMaxDepth};
+  uint8_t cores{0};
+  uint16_t reserved{0};
+};
+
+static_assert(sizeof(PcProfileHeader) == 36,
+              "PcProfileHeader: wire format is 36 bytes");
+
+/**
+ * @brief Открытая адресация по хэшу (задача, ядро, стек) + таблица имён
+ *        задач.
+ *
+ * Буфер — в PSRAM при наличии (ESP_PLATFORM), иначе в обычной heap.
+ */
+class PcProfileTable {
+ public:
+  /// Проб на семпл; дальше — dropped (таблица близка к заполнению)
+  static constexpr size_t kMaxProbe = 16;
+  static constexpr size_t kMaxTasks = 32;
+
+  PcProfileTable() = default;
+  ~PcProfileTable();
+
+  PcProfileTable(const PcProfileTable&) = delete;
+  PcProfileTable& operator=(const PcProfileTable&) = delete;
+
+  /**
+   * @brief Выделить таблицу
+   * @param capacity Записей (округляется вниз до степени двойки, ≥ 16)
+   * @return false — нет памяти или таблица уже выделена
+   */
+  bool Init(size_t capacity);
+
+  /** Учесть семпл. false — таблица переполнена (семпл в dropped). */
+  bool Record(const PcSample& sample) noexcept;
+
+  /** Запомнить имя задачи при первом семпле (имена лишних — не хранятся). */
+  void NoteTask(uint32_t task, const char* name) noexcept;
+  [[nodiscard]] bool HasTask(uint32_t task) const noexcept;
+
+  /** Очистить записи, имена и счётчики. */
+  void Clear() noexcept;
+
+  [[nodiscard]] bool IsInitialized() const noexcept {
+    return entries_ != nullptr;
+  }
+  [[nodiscard]] size_t Capacity() const noexcept { return capacity_; }
+  [[nodiscard]] size_t Used() const noexcept {
+    return used_.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] uint32_t Samples() const noexcept {
+    return samples_.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] uint32_t Dropped() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] size_t TaskCount() const noexcept { return task_count_; }
+  [[nodiscard]] const PcProfileTask& Task(size_t i) const noexcept {
+    return tasks_[i];
+  }
+
+  /** fn(const PcProfileEntry&) для каждой занятой записи. */
+  template <typename Fn>
+  void ForEach(Fn&& fn) const {
+    for (size_t i = 0; i < capacity_; ++i) {
+      if (entries_[i].count != 0) fn(entries_[i]);
+    }
+  }
+
+ private:
+  PcProfileEntry* entries_{nullptr};
+  size_t capacity_{0};  ///< Степень двойки
+  std::atomic<size_t> used_{0};
+  std::atomic<uint32_t> samples_{0};
+  std::atomic<uint32_t> dropped_{0};
+  PcProfileTask tasks_[kMaxTasks]{};
+  size_t task_count_{0};
+};
+
+}  // namespace rc_vehicle
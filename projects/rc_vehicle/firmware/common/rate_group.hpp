@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+namespace rc_vehicle {
+
+/**
+ * @brief Периодическая задача rate-group executive: период + фаза.
+ *
+ * Время делится на окна [phase + k·period, phase + (k+1)·period); Poll()
+ * возвращает true один раз в каждом новом окне — на первом тике, попавшем в
+ * него. В отличие от проверки `now - last >= interval`, границы окон
+ * привязаны к фазе, а не к моменту последнего срабатывания: джиттер тика
+ * не накапливается, и задачи с разными фазами (config::RateGroupConfig)
+ * не срабатывают на одном тике. После долгой паузы задача срабатывает один
+ * раз, без «догоняющей» серии.
+ *
+ * Без аллокаций и зависимостей от платформы; проверяется host-тестами.
+ */
+class PeriodicJob {
+ public:
+  /**
+   * @param period_ms Период [мс] (0 трактуется как 1 — каждый новый мс)
+   * @param phase_ms Сдвиг границ окон [мс]
+   * @param start_ms Момент старта: первое срабатывание — на первой границе
+   *                 окна после него
+   */
+  constexpr PeriodicJob(uint32_t period_ms, uint32_t phase_ms = 0,
+                        uint32_t start_ms = 0) noexcept
+      : period_ms_(period_ms ? period_ms : 1u),
+        phase_ms_(phase_ms),
+        last_window_(Window(start_ms)) {}
+
+  /** true, если с прошлого срабатывания началось новое окно. */
+  [[nodiscard]] constexpr bool Poll(uint32_t now_ms) noexcept {
+    const uint32_t w = Window(now_ms);
+    if (w == last_window_) return false;
+    last_window_ = w;
+    return true;
+  }
+
+  /** Перезапустить отсчёт: следующее срабатывание — после start_ms. */
+  constexpr void Restart(uint32_t start_ms) noexcept {
+    last_window_ = Window(start_ms);
+  }
+
+  [[nodiscard]] constexpr uint32_t PeriodMs() const noexcept {
+    return period_ms_;
+  }
+  [[nodiscard]] constexpr uint32_t PhaseMs() const noexcept {
+    return phase_ms_;
+  }
+
+ private:
+  // Беззнаковая арифметика: до первой границы (now < phase) окно — «хвост»
+  // предыдущего цикла uint32, он отличается от окна 0
+  [[nodiscard]] constexpr uint32_t Window(uint32_t now_ms) const noexcept {
+    return (now_ms - phase_ms_) / period_ms_;
+  }
+
+  uint32_t period_ms_;
+  uint32_t phase_ms_;
+  uint32_t last_window_;
+};
+
+}  // namespace rc_vehicle
@@ -6,11 +6,13 @@
 #include <initializer_list>
 #include <string>
 
+#include "config.hpp"
+
 namespace rc_vehicle {
 
 std::vector<SelfTestItem> SelfTest::Run(const SelfTestInput& input) {
   std::vector<SelfTestItem> results;
-  results.reserve(10);
+  results.reserve(12);
 
   char buf[48];
 
@@ -88,12 +90,30 @@ std::vector<SelfTestItem> SelfTest::Run(const SelfTestInput& input) {
                          input.pwm_status == 0 ? "ok" : "error");
   }
 
+  // 11. Boot time within budget — информационная: долгая (или ещё не
+  //     измеренная) загрузка не признак неисправности
+  {
+    constexpr uint32_t kBudget = config::DiagnosticsConfig::kBootBudgetMs;
+    std::snprintf(buf, sizeof(buf), "%u ms (budget %u)",
+                  static_cast<unsigned>(input.boot_ms),
+                  static_cast<unsigned>(kBudget));
+    const bool ok = input.boot_ms > 0 && input.boot_ms <= kBudget;
+    results.emplace_back("boot_time", ok, buf, false);
+  }
+
+  // 12. Control loop ticks at all (OTA: образ рабочий, даже если частота
+  //     вне окна проверки 1 из-за нагрузки)
+  {
+    results.emplace_back("control_loop_running", input.loop_hz > 0,
+                         input.loop_hz > 0 ? "running" : "stopped");
+  }
+
   return results;
 }
 
 bool SelfTest::AllPassed(const std::vector<SelfTestItem>& results) {
   for (const auto& item : results) {
-    if (!item.passed) return false;
+    if (item.fatal && !item.passed) return false;
   }
   return true;
 }
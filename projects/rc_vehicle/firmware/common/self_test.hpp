@@ -13,10 +13,13 @@ struct SelfTestItem {
   const char* name{""};
   bool passed{false};
   char value[48]{};  ///< Human-readable значение (например "498 Hz")
+  /// false — информационная проверка: не влияет на AllPassed и
+  /// подтверждение OTA-образа
+  bool fatal{true};
 
   SelfTestItem() = default;
-  SelfTestItem(const char* n, bool p, const char* v = "")
-      : name(n), passed(p) {
+  SelfTestItem(const char* n, bool p, const char* v = "", bool f = true)
+      : name(n), passed(p), fatal(f) {
     std::strncpy(value, v, sizeof(value) - 1);
     value[sizeof(value) - 1] = '\0';
   }
@@ -61,6 +64,9 @@ struct SelfTestInput {
 
   // PWM (0 = ok, nonzero = error)
   int pwm_status{0};
+
+  // Boot: время от сброса до первого тика control loop (0 = ещё не было)
+  uint32_t boot_ms{0};
 };
 
 /**
@@ -77,14 +83,14 @@ class SelfTest {
   /**
    * @brief Выполнить все проверки
    * @param input Snapshot текущего состояния подсистем
-   * @return Вектор результатов (10 проверок)
+   * @return Вектор результатов (12 проверок)
    */
   static std::vector<SelfTestItem> Run(const SelfTestInput& input);
 
   /**
    * @brief Проверить, все ли тесты прошли
    * @param results Результаты Run()
-   * @return true если все passed
+   * @return true если passed все проверки с fatal (информационные — нет)
    */
   static bool AllPassed(const std::vector<SelfTestItem>& results);
 };
@@ -0,0 +1,225 @@
+#include "shadow_stabilizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "drive_mode_registry.hpp"
+
+namespace rc_vehicle {
+
+namespace {
+
+using Cfg = config::ShadowConfig;
+
+/// Период control loop в единицах ReadCycleCounter()
+constexpr float kPeriodCycles =
+    static_cast<float>(config::ControlLoopConfig::kPeriodMs) *
+    (static_cast<float>(kCycleCounterHz) / 1000.0f);
+
+uint8_t ToU8(float v) noexcept {
+  return static_cast<uint8_t>(std::clamp(std::lround(v), 0L, 255L));
+}
+
+void Smooth(float& avg, bool& seeded, float sample) noexcept {
+  // Первое значение — без разгона от нуля. Флаг, а не avg == 0: иначе
+  // честный замер 0 (простаивающий цикл) пересеивал бы среднее
+  avg = seeded ? avg + Cfg::kEwmaAlpha * (sample - avg) : sample;
+  seeded = true;
+}
+
+}  // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Настройка (WS-задача)
+// ─────────────────────────────────────────────────────────────────────────────
+
+void ShadowStabilizer::Init(const VehicleEkf& ekf,
+                            const MadgwickFilter& madgwick,
+                            const ImuHandler* imu) {
+  yaw_ctrl_.Init(cfg_, ekf, imu);
+  pitch_ctrl_.Init(cfg_, madgwick, imu);
+  slip_ctrl_.Init(cfg_, ekf, imu);
+  oversteer_guard_.Init(cfg_, ekf, imu);
+  inited_ = true;
+}
+
+bool ShadowStabilizer::SetCandidate(const StabilizationConfig& cfg) {
+  StabilizationConfig validated = cfg;
+  validated.Clamp();
+  if (!validated.IsValid()) return false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_cfg_ = validated;
+  }
+  pending_.store(Pending::Set, std::memory_order_release);
+  return true;
+}
+
+void ShadowStabilizer::Stop() {
+  pending_.store(Pending::Stop, std::memory_order_release);
+}
+
+StabilizationConfig ShadowStabilizer::GetCandidate() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_cfg_;
+}
+
+ShadowStats ShadowStabilizer::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return published_;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Шаг (control loop)
+// ─────────────────────────────────────────────────────────────────────────────
+
+void ShadowStabilizer::Step(const ShadowStepInput& in) {
+  ApplyPending();
+  last_cost_cycles_ = 0;
+  if (!inited_) return;
+
+  // Загрузка цикла отслеживается и без кандидата — поле кадра всегда валидно
+  UpdateLoad(in);
+  if (state_ == ShadowState::Off) return;
+
+  if (state_ == ShadowState::Shed) {
+    const bool holding =
+        static_cast<int32_t>(in.now_ms - shed_until_ms_) < 0;
+    // Стоимость при сбросе не меряется: решает только загрузка цикла,
+    // cost_frac_ перемеряется с первого шага после возврата
+    if (holding || LoopOverloaded(in)) {
+      ++stats_.shed_ticks;
+      Publish();
+      return;
+    }
+    // Состояние регуляторов устарело за время паузы
+    Reset();
+    cost_frac_ = 0.0f;
+    cost_seeded_ = false;
+    state_ = ShadowState::Running;
+  } else if (OverBudget(in)) {
+    state_ = ShadowState::Shed;
+    shed_until_ms_ = in.now_ms + Cfg::kShedHoldMs;
+    ++stats_.shed_events;
+    ++stats_.shed_ticks;
+    Publish();
+    return;
+  }
+
+  RunCandidate(in);
+  Publish();
+}
+
+void ShadowStabilizer::Reset() noexcept {
+  yaw_ctrl_.Reset();
+  slip_ctrl_.Reset();
+  oversteer_guard_.Reset();
+}
+
+void ShadowStabilizer::FillFrame(TelemetryLogFrame& frame) const noexcept {
+  frame.shadow_state = static_cast<uint8_t>(state_);
+  frame.shadow_load_pct = ToU8(load_frac_ * 100.0f);
+  frame.shadow_cost_pm = ToU8(cost_frac_ * 1000.0f);
+  const bool running = state_ == ShadowState::Running;
+  frame.shadow_d_throttle = running ? stats_.last_d_throttle : 0.0f;
+  frame.shadow_d_steering = running ? stats_.last_d_steering : 0.0f;
+}
+
+void ShadowStabilizer::ApplyPending() {
+  const Pending p = pending_.exchange(Pending::None, std::memory_order_acq_rel);
+  if (p == Pending::None) return;
+
+  if (p == Pending::Set) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cfg_ = pending_cfg_;
+    }
+    yaw_ctrl_.SetGains(cfg_);
+    slip_ctrl_.SetGains(cfg_);
+    Reset();
+    state_ = ShadowState::Running;
+  } else {
+    state_ = ShadowState::Off;
+  }
+
+  // Новый кандидат — новое окно статистики
+  stats_ = ShadowStats{};
+  sum_sq_d_throttle_ = 0.0;
+  sum_sq_d_steering_ = 0.0;
+  cost_frac_ = 0.0f;
+  cost_seeded_ = false;
+  out_throttle_ = 0.0f;
+  out_steering_ = 0.0f;
+  Publish();
+}
+
+void ShadowStabilizer::UpdateLoad(const ShadowStepInput& in) {
+  Smooth(load_frac_, load_seeded_,
+         static_cast<float>(in.loop_cycles) / kPeriodCycles);
+}
+
+bool ShadowStabilizer::LoopOverloaded(
+    const ShadowStepInput& in) const noexcept {
+  // Пропущенный тик: цикл уже не успевает
+  return in.dt_ms > 2 * config::ControlLoopConfig::kPeriodMs ||
+         load_frac_ * 100.0f > static_cast<float>(shed_load_pct_);
+}
+
+bool ShadowStabilizer::OverBudget(const ShadowStepInput& in) const noexcept {
+  if (in.dt_ms > 2 * config::ControlLoopConfig::kPeriodMs) return true;
+  if (cost_frac_ * 1000.0f > static_cast<float>(cost_budget_permille_)) {
+    return true;
+  }
+  return (load_frac_ + cost_frac_) * 100.0f >
+         static_cast<float>(shed_load_pct_);
+}
+
+void ShadowStabilizer::RunCandidate(const ShadowStepInput& in) {
+  const uint32_t t0 = ReadCycleCounter();
+
+  float throttle = in.in_throttle;
+  float steering = in.in_steering;
+  const float w = cfg_.enabled ? 1.0f : 0.0f;
+  const auto traits = DriveModeRegistry::Get(cfg_.mode).GetTraits();
+  if (traits.yaw_rate_active)
+    yaw_ctrl_.Process(steering, w, 1.0f, in.dt_ms);
+  if (traits.pitch_comp_active) pitch_ctrl_.Process(throttle, w);
+  if (traits.slip_angle_active)
+    slip_ctrl_.Process(throttle, w, 1.0f, in.dt_ms);
+  if (traits.oversteer_guard_active)
+    oversteer_guard_.Process(throttle, in.dt_ms,
+                             traits.oversteer_reduces_throttle);
+
+  last_cost_cycles_ = ReadCycleCounter() - t0;
+  stats_.cost.Add(last_cost_cycles_);
+  Smooth(cost_frac_, cost_seeded_,
+         static_cast<float>(last_cost_cycles_) / kPeriodCycles);
+
+  out_throttle_ = throttle;
+  out_steering_ = steering;
+  const float d_thr = throttle - in.live_throttle;
+  const float d_steer = steering - in.live_steering;
+  ++stats_.run_ticks;
+  stats_.last_d_throttle = d_thr;
+  stats_.last_d_steering = d_steer;
+  stats_.max_abs_d_throttle =
+      std::max(stats_.max_abs_d_throttle, std::abs(d_thr));
+  stats_.max_abs_d_steering =
+      std::max(stats_.max_abs_d_steering, std::abs(d_steer));
+  sum_sq_d_throttle_ += static_cast<double>(d_thr) * d_thr;
+  sum_sq_d_steering_ += static_cast<double>(d_steer) * d_steer;
+  stats_.rms_d_throttle = static_cast<float>(
+      std::sqrt(sum_sq_d_throttle_ / stats_.run_ticks));
+  stats_.rms_d_steering = static_cast<float>(
+      std::sqrt(sum_sq_d_steering_ / stats_.run_ticks));
+}
+
+void ShadowStabilizer::Publish() {
+  stats_.state = state_;
+  stats_.loop_load_pct = ToU8(load_frac_ * 100.0f);
+  stats_.cost_permille = ToU8(cost_frac_ * 1000.0f);
+  std::lock_guard<std::mutex> lock(mutex_);
+  published_ = stats_;
+}
+
+}  // namespace rc_vehicle
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "config.hpp"
+#include "control_components.hpp"
+#include "cycle_counter.hpp"
+#include "madgwick_filter.hpp"
+#include "stabilization_config.hpp"
+#include "stabilization_pipeline.hpp"
+#include "telemetry_log.hpp"
+#include "vehicle_ekf.hpp"
+
+namespace rc_vehicle {
+
+/** Состояние shadow-стадии (поле shadow_state кадра лога). */
+enum class ShadowState : uint8_t {
+  Off = 0,      ///< Кандидат не задан
+  Running = 1,  ///< Кандидат считается каждый тик
+  Shed = 2,     ///< Сброшен по нагрузке цикла, ждёт окончания удержания
+};
+
+/** Входы одного шага shadow-стадии (все — из того же тика, что и живая). */
+struct ShadowStepInput {
+  float in_throttle{0.0f};    ///< Газ на входе стадии (после Kids Mode)
+  float in_steering{0.0f};    ///< Руль на входе стадии
+  float live_throttle{0.0f};  ///< Газ на выходе живой стадии
+  float live_steering{0.0f};  ///< Руль на выходе живой стадии
+  uint32_t dt_ms{0};
+  uint32_t now_ms{0};
+  /// Стоимость предыдущего тика цикла без shadow-стадии (ReadCycleCounter)
+  uint32_t loop_cycles{0};
+};
+
+/** Накопленная статистика расхождения и стоимости с момента SetCandidate. */
+struct ShadowStats {
+  ShadowState state{ShadowState::Off};
+  uint32_t run_ticks{0};    ///< Тиков, посчитанных кандидатом
+  uint32_t shed_ticks{0};   ///< Тиков, пропущенных из-за нагрузки
+  uint32_t shed_events{0};  ///< Переходов Running → Shed
+
+  float last_d_throttle{0.0f};  ///< shadow − live, последний тик
+  float last_d_steering{0.0f};
+  float max_abs_d_throttle{0.0f};
+  float max_abs_d_steering{0.0f};
+  float rms_d_throttle{0.0f};
+  float rms_d_steering{0.0f};
+
+  CycleStats cost;              ///< Стоимость шага кандидата
+  uint8_t loop_load_pct{0};     ///< Сглаженная загрузка цикла без shadow
+  uint8_t cost_permille{0};     ///< Сглаженная стоимость shadow, ‰ периода
+};
+
+/**
+ * @brief Shadow-режим стабилизации: кандидатная StabilizationConfig
+ *        считается параллельно живой, но никогда не попадает в PWM.
+ *
+ * Владеет собственной копией конфигурации и собственными экземплярами
+ * YawRateController / PitchCompensator / SlipAngleController /
+ * OversteerGuard (их состояние — интеграторы, MPC, prev_slip — не делится
+ * с живыми). Датчики (EKF, Madgwick, ImuHandler) общие и только читаются.
+ *
+ * Каждый тик ControlLoopProcessor передаёт в Step() те же входы, что
+ * получила живая стадия, и её выходы; расхождение shadow − live пишется в
+ * кадр лога (FillFrame → поля shadow_* реестра) и копится в ShadowStats.
+ * Вес стабилизации кандидата — 1 при cfg.enabled, иначе 0: плавные
+ * переходы (fade, смена режима) — свойство живой конфигурации. Ограничения
+ * Kids Mode применяются до стадии и в кандидата не входят.
+ *
+ * Бюджет CPU: стоимость шага меряется ReadCycleCounter(). Стадия
+ * сбрасывается (Shed), если сглаженная стоимость превышает
+ * config::ShadowConfig::kCostBudgetPermille периода или загрузка цикла
+ * вместе с ней — kShedLoadPct, а также при пропуске тика (dt > 2 периодов).
+ * Через kShedHoldMs стадия возвращается со сброшенными регуляторами.
+ *
+ * Потоки: SetCandidate()/Stop()/GetStats() — из WS-задачи, применяются на
+ * следующем Step(); Step()/FillFrame()/Reset() — только из control loop.
+ *
+ * @note Не копируется и не перемещается: регуляторы держат указатель на
+ *       собственную cfg_.
+ */
+class ShadowStabilizer {
+ public:
+  ShadowStabilizer() = default;
+  ShadowStabilizer(const ShadowStabilizer&) = delete;
+  ShadowStabilizer& operator=(const ShadowStabilizer&) = delete;
+
+  /**
+   * @brief Привязать общие датчики (как у живых регуляторов).
+   * @param imu IMU handler (не nullptr — требование регуляторов)
+   */
+  void Init(const VehicleEkf& ekf, const MadgwickFilter& madgwick,
+            const ImuHandler* imu);
+
+  /**
+   * @brief Задать кандидата (Clamp + IsValid), применяется на следующем тике.
+   * @return false если конфигурация невалидна (кандидат не меняется)
+   */
+  bool SetCandidate(const StabilizationConfig& cfg);
+
+  /** Остановить shadow-стадию на следующем тике. */
+  void Stop();
+
+  /** Текущий кандидат (последний принятый SetCandidate). */
+  [[nodiscard]] StabilizationConfig GetCandidate() const;
+
+  /** Копия статистики (потокобезопасно). */
+  [[nodiscard]] ShadowStats GetStats() const;
+
+  /**
+   * @brief Переопределить бюджет (по умолчанию — config::ShadowConfig).
+   * @param cost_budget_permille Порог стоимости shadow, ‰ периода цикла
+   * @param shed_load_pct Порог загрузки цикла вместе с shadow, %
+   */
+  void SetBudget(uint32_t cost_budget_permille, uint32_t shed_load_pct) {
+    cost_budget_permille_ = cost_budget_permille;
+    shed_load_pct_ = shed_load_pct;
+  }
+
+  /** Один тик: посчитать кандидата и расхождение (только control loop). */
+  void Step(const ShadowStepInput& in);
+
+  /** Сбросить регуляторы кандидата (failsafe), статистика сохраняется. */
+  void Reset() noexcept;
+
+  /** Записать shadow_* поля кадра по последнему тику (только control loop). */
+  void FillFrame(TelemetryLogFrame& frame) const noexcept;
+
+  /** Стоимость шага на последнем тике (0 если стадия не считалась). */
+  [[nodiscard]] uint32_t LastCostCycles() const noexcept {
+    return last_cost_cycles_;
+  }
+
+  [[nodiscard]] ShadowState GetState() const noexcept { return state_; }
+
+  /** Выход кандидата на последнем посчитанном тике. */
+  [[nodiscard]] float GetThrottle() const noexcept { return out_throttle_; }
+  [[nodiscard]] float GetSteering() const noexcept { return out_steering_; }
+
+ private:
+  enum class Pending : uint8_t { None, Set, Stop };
+
+  void ApplyPending();
+  void UpdateLoad(const ShadowStepInput& in);
+  /** Пропущенный тик или загрузка цикла без стадии выше порога. */
+  [[nodiscard]] bool LoopOverloaded(const ShadowStepInput& in) const noexcept;
+  /** LoopOverloaded с учётом стоимости стадии (для Running). */
+  [[nodiscard]] bool OverBudget(const ShadowStepInput& in) const noexcept;
+  void RunCandidate(const ShadowStepInput& in);
+  void Publish();
+
+  // Рабочая копия кандидата: читается регуляторами по указателю
+  StabilizationConfig cfg_;
+  YawRateController yaw_ctrl_;
+  PitchCompensator pitch_ctrl_;
+  SlipAngleController slip_ctrl_;
+  OversteerGuard oversteer_guard_;
+  bool inited_{false};
+
+  ShadowState state_{ShadowState::Off};
+  uint32_t shed_until_ms_{0};
+  uint32_t cost_budget_permille_{config::ShadowConfig::kCostBudgetPermille};
+  uint32_t shed_load_pct_{config::ShadowConfig::kShedLoadPct};
+
+  // Сглаженные доли периода цикла (EWMA)
+  float load_frac_{0.0f};
+  float cost_frac_{0.0f};
+  bool load_seeded_{false};  ///< Был первый замер (load_frac_ валиден)
+  bool cost_seeded_{false};
+  uint32_t last_cost_cycles_{0};
+
+  float out_throttle_{0.0f};
+  float out_steering_{0.0f};
+  double sum_sq_d_throttle_{0.0};
+  double sum_sq_d_steering_{0.0};
+  ShadowStats stats_;  ///< Рабочая копия control loop
+
+  // Обмен с WS-задачей
+  mutable std::mutex mutex_;
+  StabilizationConfig pending_cfg_;
+  std::atomic<Pending> pending_{Pending::None};
+  ShadowStats published_;
+};
+
+}  // namespace rc_vehicle
@@ -195,6 +195,7 @@ void StabilizationConfig::Reset() noexcept {
   yaw_rate.pid.max_integral = 0.5f;
   yaw_rate.pid.max_correction = 0.3f;
   yaw_rate.steer_to_yaw_rate_dps = 90.0f;
+  yaw_rate.mpc_enabled = false;
 
   // Slip angle defaults
   slip_angle.pid.kp = 0.0f;
@@ -260,6 +260,12 @@ struct YawRateConfig {
    */
   float steer_to_yaw_rate_dps{90.0f};
 
+  /**
+   * Явный MPC вместо ПИД (таблица из tools/gen_yaw_mpc.py).
+   * По умолчанию выключен; ПИД остаётся запасным законом на малой скорости.
+   */
+  bool mpc_enabled{false};
+
   /**
    * @brief Проверить валидность конфигурации yaw rate
    */
@@ -119,6 +119,17 @@ bool StabilizationManager::SetConfig(const StabilizationConfig& config,
   return true;
 }
 
+void StabilizationManager::SetSteerToYawRate(float dps) {
+  float applied;
+  {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    config_.yaw_rate.steer_to_yaw_rate_dps = dps;
+    config_.yaw_rate.Clamp();
+    applied = config_.yaw_rate.steer_to_yaw_rate_dps;
+  }
+  yaw_ctrl_.SetSteerToYawRate(applied);
+}
+
 bool StabilizationManager::LoadFromNvs() {
   auto stab_cfg = platform_.LoadStabilizationConfig();
   if (stab_cfg) {
@@ -52,6 +52,16 @@ class StabilizationManager {
    */
   bool SetConfig(const StabilizationConfig& config, bool save_to_nvs = true);
 
+  /**
+   * @brief Сменить только yaw_rate.steer_to_yaw_rate_dps (онлайн-sysid)
+   *
+   * Под локом конфигурации меняется одно поле — одновременный SetConfig
+   * (set_stab_config из httpd) не откатывается. Фильтры и ПИД не
+   * перенастраиваются, в NVS не пишется.
+   * @param dps Новый коэффициент (ограничивается как в YawRateConfig::Clamp)
+   */
+  void SetSteerToYawRate(float dps);
+
   /**
    * @brief Загрузить конфигурацию из NVS при инициализации
    * @return true если конфигурация загружена успешно
@@ -4,8 +4,17 @@
 #include <cassert>
 #include <cmath>
 
+#include "config.hpp"
+#include "explicit_mpc.hpp"
+#include "yaw_mpc_table.hpp"
+
 namespace rc_vehicle {
 
+// QP таблицы решён с шагом Ts: du_max — ход руля slew-лимитера за один тик
+static_assert(yaw_mpc::kTsS * 1000.0f ==
+                  static_cast<float>(config::ControlLoopConfig::kPeriodMs),
+              "yaw_mpc_table.hpp: перегенерировать с --ts = период цикла");
+
 // ─────────────────────────────────────────────────────────────────────────────
 // YawRateController
 // ─────────────────────────────────────────────────────────────────────────────
@@ -22,13 +31,17 @@ void YawRateController::Init(const StabilizationConfig& cfg,
 void YawRateController::Process(float& steering, float stab_w, float mode_w,
                                 uint32_t dt_ms) noexcept {
   if (!cfg_ || !ekf_ || !imu_) return;
-  if (stab_w <= 0.0f) return;
-  if (!imu_->IsEnabled()) return;
-  if (dt_ms == 0) return;
+  if (stab_w <= 0.0f || !imu_->IsEnabled() || dt_ms == 0) {
+    last_steering_ = steering;
+    mpc_active_ = false;
+    return;
+  }
 
   const float dt_sec = static_cast<float>(dt_ms) * 0.001f;
-  const float omega_desired = cfg_->yaw_rate.steer_to_yaw_rate_dps * steering;
+  const float omega_desired = steer_to_yaw_rate_dps_ * steering;
   const float omega_actual = imu_->GetFilteredGyroZ();
+
+  uint32_t t0 = ReadCycleCounter();
   const float pid_out = pid_.Step(omega_desired - omega_actual, dt_sec);
 
   // Adaptive PID: масштабирование выхода ПИД по скорости из EKF (Phase 4.1)
@@ -39,14 +52,63 @@ void YawRateController::Process(float& steering, float stab_w, float mode_w,
                    cfg_->adaptive.scale_min, cfg_->adaptive.scale_max);
   }
 
-  steering = std::clamp(steering + pid_out * stab_w * mode_w * adaptive_scale,
-                        -1.0f, 1.0f);
+  const float pid_steering =
+      std::clamp(steering + pid_out * stab_w * mode_w * adaptive_scale,
+                 -1.0f, 1.0f);
+  pid_cycles_.Add(ReadCycleCounter() - t0);
+
+  mpc_active_ = false;
+  if (cfg_->yaw_rate.mpc_enabled) {
+    float mpc_steering = 0.0f;
+    t0 = ReadCycleCounter();
+    mpc_active_ = StepMpc(omega_desired, omega_actual, mpc_steering);
+    mpc_cycles_.Add(ReadCycleCounter() - t0);
+    if (mpc_active_) {
+      steering = std::clamp(
+          steering + (mpc_steering - steering) * stab_w * mode_w, -1.0f, 1.0f);
+    }
+  }
+  if (!mpc_active_) steering = pid_steering;
+  last_steering_ = steering;
+}
+
+bool YawRateController::StepMpc(float omega_desired_dps,
+                                float omega_actual_dps,
+                                float& out) const noexcept {
+  constexpr float kDegToRad = 3.14159265358979f / 180.0f;
+  const float* grid_begin = yaw_mpc::kSpeedGridMs;
+  const float* grid_end = grid_begin + yaw_mpc::kSpeedBinCount;
+
+  // Модель велосипеда вырождена при vx → 0 и неверна задним ходом
+  const float vx = ekf_->GetVx();
+  if (!(vx >= grid_begin[0])) return false;
+
+  // Ячейка: ближайший узел сетки снизу
+  const int bin =
+      static_cast<int>(std::upper_bound(grid_begin, grid_end, vx) -
+                       grid_begin) - 1;
+  const ExplicitMpcPartition part{yaw_mpc::kNodes[bin], yaw_mpc::kNodesPerBin,
+                                  yaw_mpc::kRegions[bin],
+                                  yaw_mpc::kRegionsPerBin};
+
+  const float x[kExplicitMpcParamDim] = {
+      ekf_->GetVy(),
+      omega_actual_dps * kDegToRad,
+      omega_desired_dps * kDegToRad,
+      last_steering_,
+      cfg_->slew_steering * yaw_mpc::kTsS,
+  };
+  float u = 0.0f;
+  if (!ExplicitMpcEvaluate(part, x, u)) return false;
+  out = std::clamp(u, -1.0f, 1.0f);
+  return true;
 }
 
 void YawRateController::SetGains(const StabilizationConfig& cfg) noexcept {
   pid_.SetGains({cfg.yaw_rate.pid.kp, cfg.yaw_rate.pid.ki, cfg.yaw_rate.pid.kd,
                  cfg.yaw_rate.pid.max_integral,
                  cfg.yaw_rate.pid.max_correction});
+  steer_to_yaw_rate_dps_ = cfg.yaw_rate.steer_to_yaw_rate_dps;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "control_components.hpp"
+#include "cycle_counter.hpp"
 #include "madgwick_filter.hpp"
 #include "pid_controller.hpp"
 #include "stabilization_config.hpp"
@@ -20,6 +21,13 @@ namespace rc_vehicle {
  * отключён — управление рулём остаётся за водителем, а стабилизацией
  * заноса занимается SlipAngleController.
  *
+ * При yaw_rate.mpc_enabled руль вычисляет явный MPC (таблица областей
+ * yaw_mpc_table.hpp, модель велосипеда по ячейкам скорости EKF): учитывает
+ * ограничение скорости поворота руля (slew_steering) и боковую скорость vy.
+ * Ниже минимальной скорости сетки и при движении назад работает ПИД.
+ * ПИД шагает всегда, чтобы переход MPC → ПИД был без рывка; стоимость
+ * обоих законов копится в CycleStats для сравнения в диагностике.
+ *
  * Извлечён из VehicleControlUnified::ControlTaskLoop() (строки 154–173).
  */
 class YawRateController {
@@ -52,17 +60,68 @@ class YawRateController {
    */
   void SetGains(const StabilizationConfig& cfg) noexcept;
 
-  /** @brief Сбросить интегратор и историю PID. */
-  void Reset() noexcept { pid_.Reset(); }
+  /**
+   * @brief Сменить только коэффициент опорной кривой (dps при steering=1).
+   * @param dps Новый yaw_rate.steer_to_yaw_rate_dps
+   */
+  void SetSteerToYawRate(float dps) noexcept { steer_to_yaw_rate_dps_ = dps; }
+
+  /** @brief Текущий коэффициент опорной кривой (dps при steering=1). */
+  [[nodiscard]] float GetSteerToYawRate() const noexcept {
+    return steer_to_yaw_rate_dps_;
+  }
+
+  /** @brief Сбросить интегратор, историю PID и состояние MPC. */
+  void Reset() noexcept {
+    pid_.Reset();
+    last_steering_ = 0.0f;
+    mpc_active_ = false;
+  }
 
   /** @brief Доступ к PID (для тестирования). */
   [[nodiscard]] const PidController& GetPid() const noexcept { return pid_; }
 
+  /** @brief Управлял ли рулём MPC на последнем шаге. */
+  [[nodiscard]] bool IsMpcActive() const noexcept { return mpc_active_; }
+
+  /** @brief Стоимость шага ПИД (такты CPU; на хосте — нс). */
+  [[nodiscard]] const CycleStats& GetPidCycles() const noexcept {
+    return pid_cycles_;
+  }
+
+  /** @brief Стоимость вычисления явного MPC (такты CPU; на хосте — нс). */
+  [[nodiscard]] const CycleStats& GetMpcCycles() const noexcept {
+    return mpc_cycles_;
+  }
+
+  /** @brief Начать новое окно статистики стоимости. */
+  void ResetCycleStats() noexcept {
+    pid_cycles_.Reset();
+    mpc_cycles_.Reset();
+  }
+
  private:
+  /**
+   * @brief Явный MPC: спуск по дереву областей ячейки скорости + аффинный
+   *        закон.
+   * @param omega_desired_dps Желаемая угловая скорость
+   * @param omega_actual_dps  Измеренная угловая скорость
+   * @param[out] out          Команда руля [-1..1]
+   * @return false если скорость вне сетки таблицы (работает ПИД)
+   */
+  bool StepMpc(float omega_desired_dps, float omega_actual_dps,
+               float& out) const noexcept;
+
   const StabilizationConfig* cfg_{nullptr};
   const VehicleEkf* ekf_{nullptr};
   const ImuHandler* imu_{nullptr};
   PidController pid_;
+
+  float steer_to_yaw_rate_dps_{90.0f};  ///< Опорная кривая (из SetGains)
+  float last_steering_{0.0f};  ///< Выход предыдущего шага (u_prev для MPC)
+  bool mpc_active_{false};
+  CycleStats pid_cycles_;
+  CycleStats mpc_cycles_;
 };
 
 // ═════════════════════════════════════════════════════════════════════════════
@@ -0,0 +1,460 @@
+#include "telem_relay.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace rc_vehicle {
+
+namespace {
+
+constexpr size_t kClientMaxTokens = 64;
+constexpr size_t kMaxChannels = 16;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Сканер членов объекта верхнего уровня (без построения дерева)
+// ─────────────────────────────────────────────────────────────────────────────
+
+size_t SkipWs(std::string_view s, size_t i) {
+  while (i < s.size() &&
+         (s[i] == ' ' || s[i] == '\t' || s[i] == '\n' || s[i] == '\r')) {
+    ++i;
+  }
+  return i;
+}
+
+/** Конец строки, начинающейся с '"' в позиции i (за закрывающей кавычкой). */
+size_t SkipString(std::string_view s, size_t i) {
+  for (++i; i < s.size(); ++i) {
+    if (s[i] == '\\') {
+      ++i;
+    } else if (s[i] == '"') {
+      return i + 1;
+    }
+  }
+  return std::string_view::npos;
+}
+
+/** Конец значения с позиции i: до ',' или '}' на глубине 0. */
+size_t SkipValue(std::string_view s, size_t i) {
+  int depth = 0;
+  while (i < s.size()) {
+    const char c = s[i];
+    if (c == '"') {
+      i = SkipString(s, i);
+      if (i == std::string_view::npos) return i;
+      continue;
+    }
+    if (c == '{' || c == '[') {
+      ++depth;
+    } else if (c == '}' || c == ']') {
+      if (depth == 0) return i;
+      --depth;
+    } else if (c == ',' && depth == 0) {
+      return i;
+    }
+    ++i;
+  }
+  return std::string_view::npos;
+}
+
+/**
+ * fn(key, value) для каждого члена объекта верхнего уровня; key — без
+ * кавычек и без раскрытия escape, value — исходный текст без пробелов по
+ * краям. @return false, если json — не объект.
+ */
+template <typename Fn>
+bool ForEachTopMember(std::string_view s, Fn&& fn) {
+  size_t i = SkipWs(s, 0);
+  if (i >= s.size() || s[i] != '{') return false;
+  i = SkipWs(s, i + 1);
+  if (i < s.size() && s[i] == '}') return true;
+  while (i < s.size()) {
+    if (s[i] != '"') return false;
+    const size_t key_end = SkipString(s, i);
+    if (key_end == std::string_view::npos) return false;
+    const std::string_view key = s.substr(i + 1, key_end - i - 2);
+    i = SkipWs(s, key_end);
+    if (i >= s.size() || s[i] != ':') return false;
+    const size_t value_start = SkipWs(s, i + 1);
+    const size_t value_end = SkipValue(s, value_start);
+    if (value_end == std::string_view::npos) return false;
+    std::string_view value = s.substr(value_start, value_end - value_start);
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\n' ||
+                              value.back() == '\r' || value.back() == '\t')) {
+      value.remove_suffix(1);
+    }
+    fn(key, value);
+    if (s[value_end] == '}') return true;
+    i = SkipWs(s, value_end + 1);
+  }
+  return false;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Сборка JSON
+// ─────────────────────────────────────────────────────────────────────────────
+
+void AppendNumber(std::string& out, float v) {
+  if (!std::isfinite(v)) {
+    out += "null";
+    return;
+  }
+  char buf[32];
+  const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+  out.append(buf, r.ptr);
+}
+
+void AppendNumber(std::string& out, uint64_t v) {
+  char buf[24];
+  const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+  out.append(buf, r.ptr);
+}
+
+/** Поля группы как "key":value через запятую (без скобок). */
+void AppendGroupFields(std::string& out, const TelemetryLogFrame& frame,
+                       TelemetryJsonGroup group) {
+  const auto* base = reinterpret_cast<const uint8_t*>(&frame);
+  bool first = true;
+  for (const auto& info : kTelemetryLogFields) {
+    if (info.ws_group != group) continue;
+    if (!first) out += ',';
+    first = false;
+    out += '"';
+    out += info.ws_key;
+    out += "\":";
+    switch (info.type) {
+      case TelemetryFieldType::U32: {
+        uint32_t v;
+        std::memcpy(&v, base + info.offset, sizeof(v));
+        AppendNumber(out, uint64_t{v});
+        break;
+      }
+      case TelemetryFieldType::F32: {
+        float v;
+        std::memcpy(&v, base + info.offset, sizeof(v));
+        AppendNumber(out, v);
+        break;
+      }
+      case TelemetryFieldType::U8:
+        AppendNumber(out, uint64_t{base[info.offset]});
+        break;
+    }
+  }
+}
+
+void AppendGroup(std::string& out, const char* key,
+                 const TelemetryLogFrame& frame, TelemetryJsonGroup group) {
+  out += ",\"";
+  out += key;
+  out += "\":{";
+  AppendGroupFields(out, frame, group);
+  out += '}';
+}
+
+/** Имя группы для relay_subscribe: [a-z0-9_], как ключи "telem". */
+bool IsChannelName(std::string_view s) {
+  if (s.empty() || s.size() > 32) return false;
+  return std::all_of(s.begin(), s.end(), [](char c) {
+    return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_';
+  });
+}
+
+void AppendChannels(std::string& out, const std::vector<std::string>& ch) {
+  out += '[';
+  for (size_t i = 0; i < ch.size(); ++i) {
+    if (i) out += ',';
+    out += '"';
+    out += ch[i];
+    out += '"';
+  }
+  out += ']';
+}
+
+std::string ErrorJson(std::string_view error) {
+  std::string s = "{\"type\":\"relay_error\",\"error\":\"";
+  s += error;
+  s += "\"}";
+  return s;
+}
+
+std::string ControlReply(bool ok, std::string_view error = {}) {
+  std::string s = "{\"type\":\"relay_control\",\"ok\":";
+  s += ok ? "true" : "false";
+  if (!error.empty()) {
+    s += ",\"error\":\"";
+    s += error;
+    s += '"';
+  }
+  s += '}';
+  return s;
+}
+
+}  // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Телеметрия
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool DecodeUdpTelemPacket(std::span<const uint8_t> packet, uint32_t& seq,
+                          TelemetryLogFrame& frame) noexcept {
+  if (packet.size() < kUdpTelemHeaderSize ||
+      packet[0] != kUdpTelemMagic[0] || packet[1] != kUdpTelemMagic[1] ||
+      packet[2] != kUdpTelemVersion) {
+    return false;
+  }
+  std::memcpy(&seq, packet.data() + 3, sizeof(seq));  // little-endian
+  frame = TelemetryLogFrame{};
+  const size_t n = std::min(packet.size() - kUdpTelemHeaderSize,
+                            sizeof(TelemetryLogFrame));
+  std::memcpy(&frame, packet.data() + kUdpTelemHeaderSize, n);
+  return true;
+}
+
+std::string TelemFrameToJson(const TelemetryLogFrame& frame) {
+  std::string out;
+  out.reserve(768);
+  out += "{\"type\":\"telem\",";
+  AppendGroupFields(out, frame, TelemetryJsonGroup::Root);
+
+  out += ",\"imu\":{";
+  AppendGroupFields(out, frame, TelemetryJsonGroup::Imu);
+  AppendGroup(out, "orientation", frame, TelemetryJsonGroup::Orientation);
+  out += '}';
+
+  if (frame.mx != 0.0f || frame.my != 0.0f || frame.mz != 0.0f) {
+    AppendGroup(out, "mag", frame, TelemetryJsonGroup::Mag);
+  }
+  AppendGroup(out, "ekf", frame, TelemetryJsonGroup::Ekf);
+  out += ",\"warn\":{\"oversteer\":";
+  out += frame.oversteer_active > 0.5f ? "true" : "false";
+  out += '}';
+  AppendGroup(out, "rc", frame, TelemetryJsonGroup::Rc);
+  AppendGroup(out, "cmd", frame, TelemetryJsonGroup::Cmd);
+  AppendGroup(out, "act", frame, TelemetryJsonGroup::Act);
+  if (frame.shadow_state != 0) {
+    AppendGroup(out, "shadow", frame, TelemetryJsonGroup::Shadow);
+  }
+  out += '}';
+  return out;
+}
+
+std::string FilterTelemJson(std::string_view json,
+                            std::span<const std::string> channels) {
+  if (channels.empty()) {
+    const size_t i = SkipWs(json, 0);
+    return i < json.size() && json[i] == '{' ? std::string(json)
+                                             : std::string();
+  }
+  std::string out;
+  out.reserve(json.size());
+  out += '{';
+  bool first = true;
+  const bool ok =
+      ForEachTopMember(json, [&](std::string_view key, std::string_view v) {
+        const bool group = !v.empty() && (v.front() == '{' || v.front() == '[');
+        if (group && std::find(channels.begin(), channels.end(), key) ==
+                         channels.end()) {
+          return;
+        }
+        if (!first) out += ',';
+        first = false;
+        out += '"';
+        out += key;
+        out += "\":";
+        out += v;
+      });
+  if (!ok) return {};
+  out += '}';
+  return out;
+}
+
+std::string_view TelemJsonType(std::string_view json) {
+  std::string_view type;
+  ForEachTopMember(json, [&](std::string_view key, std::string_view v) {
+    if (type.empty() && key == "type" && v.size() >= 2 && v.front() == '"') {
+      type = v.substr(1, v.size() - 2);
+    }
+  });
+  return type;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// RelayHub
+// ─────────────────────────────────────────────────────────────────────────────
+
+RelayHub::RelayHub(RelayConfig cfg) : cfg_(std::move(cfg)) {}
+
+void RelayHub::AddClient(uint32_t id) {
+  Client c;
+  c.hz = std::min(cfg_.default_hz, cfg_.max_hz);
+  clients_[id] = std::move(c);
+}
+
+void RelayHub::RemoveClient(uint32_t id) {
+  clients_.erase(id);
+  if (controller_ == id) controller_ = 0;
+}
+
+void RelayHub::SetUpstreamState(std::string_view mode, bool connected) {
+  upstream_mode_ = mode;
+  upstream_connected_ = connected;
+}
+
+RelayHub::ClientVerdict RelayHub::OnClientText(
+    uint32_t id, std::string_view text, std::vector<RelayMessage>& out) {
+  auto it = clients_.find(id);
+  if (it == clients_.end()) return ClientVerdict::Handled;
+
+  std::string buf(text);
+  std::array<JsonToken, kClientMaxTokens> tokens;
+  auto parsed = JsonParseInSitu(buf.data(), buf.size(), tokens);
+  if (!IsOk(parsed) || !GetValue(parsed).IsObject()) {
+    out.push_back({id, ErrorJson("bad_json")});
+    return ClientVerdict::Handled;
+  }
+  const JsonValue json = GetValue(parsed);
+  const std::string_view type = json["type"].Str();
+
+  if (type == "relay_subscribe") {
+    HandleSubscribe(id, it->second, json, out);
+    return ClientVerdict::Handled;
+  }
+  if (type == "relay_control") {
+    HandleControl(id, json, out);
+    return ClientVerdict::Handled;
+  }
+  if (type == "relay_release") {
+    if (controller_ == id) controller_ = 0;
+    out.push_back({id, "{\"type\":\"relay_release\",\"ok\":true}"});
+    return ClientVerdict::Handled;
+  }
+  if (type == "relay_status") {
+    out.push_back({id, StatusJson(id)});
+    return ClientVerdict::Handled;
+  }
+  if (type.starts_with("relay_")) {
+    out.push_back({id, ErrorJson("unknown_relay_command")});
+    return ClientVerdict::Handled;
+  }
+
+  if (controller_ != id) {
+    ++stats_.cmd_rejected;
+    out.push_back({id, ErrorJson("not_controller")});
+    return ClientVerdict::Handled;
+  }
+  ++stats_.cmd_forwarded;
+  return ClientVerdict::Forward;
+}
+
+void RelayHub::HandleSubscribe(uint32_t id, Client& c, const JsonValue& json,
+                               std::vector<RelayMessage>& out) {
+  uint32_t hz = c.hz;
+  if (json.Read("hz", hz)) {
+    c.hz = std::min(hz, cfg_.max_hz);
+    c.started = false;  // Новая частота — с ближайшего кадра
+  }
+  const JsonValue channels = json["channels"];
+  if (channels.IsArray()) {
+    c.channels.clear();
+    for (size_t i = 0; i < channels.Size() && i < kMaxChannels; ++i) {
+      const std::string_view name = channels.At(i).Str();
+      if (IsChannelName(name)) c.channels.emplace_back(name);
+    }
+  }
+  std::string reply = "{\"type\":\"relay_subscribe\",\"ok\":true,\"hz\":";
+  AppendNumber(reply, uint64_t{c.hz});
+  reply += ",\"channels\":";
+  AppendChannels(reply, c.channels);
+  reply += '}';
+  out.push_back({id, std::move(reply)});
+}
+
+void RelayHub::HandleControl(uint32_t id, const JsonValue& json,
+                             std::vector<RelayMessage>& out) {
+  if (cfg_.control_token.empty()) {
+    out.push_back({id, ControlReply(false, "control_disabled")});
+    return;
+  }
+  if (json["token"].Str() != cfg_.control_token) {
+    out.push_back({id, ControlReply(false, "bad_token")});
+    return;
+  }
+  // Один управляющий: перехват — только после relay_release или отключения
+  if (controller_ != 0 && controller_ != id) {
+    out.push_back({id, ControlReply(false, "busy")});
+    return;
+  }
+  controller_ = id;
+  out.push_back({id, ControlReply(true)});
+}
+
+std::string RelayHub::StatusJson(uint32_t id) const {
+  std::string s = "{\"type\":\"relay_status\",\"upstream\":\"";
+  s += upstream_mode_;
+  s += "\",\"upstream_ok\":";
+  s += upstream_connected_ ? "true" : "false";
+  s += ",\"clients\":";
+  AppendNumber(s, uint64_t{clients_.size()});
+  s += ",\"controlled\":";
+  s += controller_ != 0 ? "true" : "false";
+  s += ",\"you_control\":";
+  s += controller_ == id ? "true" : "false";
+  s += ",\"telem_in\":";
+  AppendNumber(s, stats_.telem_in);
+  const auto it = clients_.find(id);
+  if (it != clients_.end()) {
+    s += ",\"hz\":";
+    AppendNumber(s, uint64_t{it->second.hz});
+    s += ",\"channels\":";
+    AppendChannels(s, it->second.channels);
+  }
+  s += '}';
+  return s;
+}
+
+bool RelayHub::TakeTelemSlot(Client& c, uint64_t now_ms) {
+  if (c.hz == 0) return true;
+  if (!c.started) {
+    c.started = true;
+    c.last_ms = now_ms;
+    c.credit = 0.0;
+    return true;
+  }
+  // Token bucket ёмкостью 1 (без «залпа» после паузы стрима); порог ½ —
+  // джиттер прихода кадров при hz = частоте машины не теряет кадры
+  const double dt = static_cast<double>(now_ms - c.last_ms) * 0.001;
+  c.last_ms = now_ms;
+  c.credit = std::min(1.0, c.credit + dt * c.hz);
+  if (c.credit < 0.5) return false;
+  c.credit -= 1.0;
+  return true;
+}
+
+void RelayHub::OnUpstreamText(std::string_view text, uint64_t now_ms,
+                              std::vector<RelayMessage>& out) {
+  if (TelemJsonType(text) != "telem") {
+    // Ответы на команды — только тому, кто их слал
+    if (controller_ != 0) out.push_back({controller_, std::string(text)});
+    return;
+  }
+  ++stats_.telem_in;
+  std::string all;  // Без фильтра — один текст на всех без подписки групп
+  for (auto& [id, c] : clients_) {
+    if (!TakeTelemSlot(c, now_ms)) {
+      ++stats_.telem_skipped;
+      continue;
+    }
+    ++stats_.telem_out;
+    if (c.channels.empty()) {
+      if (all.empty()) all.assign(text);
+      out.push_back({id, all});
+    } else {
+      out.push_back({id, FilterTelemJson(text, c.channels)});
+    }
+  }
+}
+
+}  // namespace rc_vehicle
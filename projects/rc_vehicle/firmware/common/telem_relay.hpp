@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "json_reader.hpp"
+#include "telemetry_log.hpp"
+
+/**
+ * @file telem_relay.hpp
+ * @brief Логика хостового ретранслятора телеметрии (telem_relay).
+ *
+ * Машина держит одно соединение (WS или UDP) с ретранслятором, а он раздаёт
+ * телеметрию любому числу локальных WS-клиентов: работа машины не зависит
+ * от числа зрителей. Частота и набор групп "telem" — у каждого клиента
+ * свои (на хосте). Команды на машину — только от одного клиента, получившего
+ * управление по токену.
+ *
+ * Здесь — разбор, фильтрация и маршрутизация без сокетов (покрыто
+ * unit-тестами); цикл poll() — в telem_relay/telem_relay_main.cpp.
+ */
+
+namespace rc_vehicle {
+
+// ═════════════════════════════════════════════════════════════════════════════
+// Телеметрия
+// ═════════════════════════════════════════════════════════════════════════════
+
+/// Заголовок UdpTelemPacket (esp32_common/udp_telem_sender.cpp): "RT", v1, seq
+inline constexpr uint8_t kUdpTelemMagic[2] = {0x52, 0x54};
+inline constexpr uint8_t kUdpTelemVersion = 1;
+inline constexpr size_t kUdpTelemHeaderSize = 2 + 1 + 4;
+
+/**
+ * @brief Разобрать UDP-пакет телеметрии.
+ *
+ * Кадр короче текущего (старая прошивка) — префикс, остальное нулями.
+ * @return false, если не "RT" v1 или пакет короче заголовка
+ */
+bool DecodeUdpTelemPacket(std::span<const uint8_t> packet, uint32_t& seq,
+                          TelemetryLogFrame& frame) noexcept;
+
+/**
+ * @brief JSON "telem" из кадра в раскладке WS-телеметрии машины.
+ *
+ * Группы и ключи — из реестра полей (telemetry_fields.hpp). Поля вне кадра
+ * (link, calib, kids_mode, ekf.yaw_rate) в UDP-стриме недоступны и не
+ * выводятся; "mag" — при ненулевом поле, "shadow" — при shadow_state ≠ 0.
+ */
+[[nodiscard]] std::string TelemFrameToJson(const TelemetryLogFrame& frame);
+
+/**
+ * @brief Оставить в JSON-объекте только выбранные группы.
+ *
+ * Скалярные члены верхнего уровня ("type", "uptime_ms", …) сохраняются
+ * всегда, объекты и массивы — если их ключ есть в channels. Пустой
+ * channels — без фильтрации. Текст членов копируется как есть.
+ * @return Пустая строка, если json — не объект
+ */
+[[nodiscard]] std::string FilterTelemJson(
+    std::string_view json, std::span<const std::string> channels);
+
+/** Значение "type" верхнего уровня (без кавычек); пусто, если нет. */
+[[nodiscard]] std::string_view TelemJsonType(std::string_view json);
+
+// ═════════════════════════════════════════════════════════════════════════════
+// RelayHub — клиенты, подписки, управление
+// ═════════════════════════════════════════════════════════════════════════════
+
+/** Параметры ретранслятора. */
+struct RelayConfig {
+  std::string control_token;  ///< Пусто — управление запрещено всем
+  uint32_t default_hz{0};     ///< Частота нового клиента (0 — как у машины)
+  uint32_t max_hz{100};       ///< Потолок hz в relay_subscribe
+};
+
+/** Сообщение клиенту id. */
+struct RelayMessage {
+  uint32_t client;
+  std::string text;
+};
+
+/**
+ * @brief Клиенты ретранслятора: подписки, прореживание, право управления.
+ *
+ * Сообщения клиента с "type" relay_* обрабатываются здесь:
+ *   relay_subscribe {hz, channels} — частота и группы "telem";
+ *   relay_control {token}          — получить управление;
+ *   relay_release                  — отдать управление;
+ *   relay_status                   — состояние ретранслятора.
+ * Остальное — команды машине: пересылаются только от управляющего клиента.
+ * Ответы машины, кроме "telem", уходят только управляющему.
+ *
+ * Не потокобезопасен: вызывается из одного цикла.
+ */
+class RelayHub {
+ public:
+  enum class ClientVerdict : uint8_t {
+    Handled,  ///< Ответ (если нужен) — в out
+    Forward,  ///< Переслать текст машине как есть
+  };
+
+  struct Stats {
+    uint64_t telem_in{0};       ///< "telem" от машины
+    uint64_t telem_out{0};      ///< Отправлено клиентам (сумма)
+    uint64_t telem_skipped{0};  ///< Прорежено по hz клиентов
+    uint64_t cmd_forwarded{0};  ///< Команд машине
+    uint64_t cmd_rejected{0};   ///< Команд не от управляющего
+  };
+
+  explicit RelayHub(RelayConfig cfg);
+
+  /** id ≠ 0 (0 — «нет управляющего»). */
+  void AddClient(uint32_t id);
+  /** Отключение управляющего освобождает управление. */
+  void RemoveClient(uint32_t id);
+
+  /** Текстовое сообщение от клиента; ответы ретранслятора — в out. */
+  ClientVerdict OnClientText(uint32_t id, std::string_view text,
+                             std::vector<RelayMessage>& out);
+
+  /**
+   * @brief Текстовое сообщение от машины: разослать по подпискам.
+   * @param now_ms Монотонное время хоста (для прореживания)
+   */
+  void OnUpstreamText(std::string_view text, uint64_t now_ms,
+                      std::vector<RelayMessage>& out);
+
+  /** Состояние канала к машине (для relay_status). */
+  void SetUpstreamState(std::string_view mode, bool connected);
+
+  [[nodiscard]] bool HasController() const noexcept {
+    return controller_ != 0;
+  }
+  [[nodiscard]] uint32_t Controller() const noexcept { return controller_; }
+  [[nodiscard]] size_t ClientCount() const noexcept { return clients_.size(); }
+  [[nodiscard]] const Stats& GetStats() const noexcept { return stats_; }
+
+ private:
+  struct Client {
+    uint32_t hz{0};
+    std::vector<std::string> channels;
+    double credit{0.0};  ///< Token bucket прореживания: ≥ ½ — можно слать
+    uint64_t last_ms{0};
+    bool started{false};
+  };
+
+  void HandleSubscribe(uint32_t id, Client& c, const JsonValue& json,
+                       std::vector<RelayMessage>& out);
+  void HandleControl(uint32_t id, const JsonValue& json,
+                     std::vector<RelayMessage>& out);
+  std::string StatusJson(uint32_t id) const;
+  static bool TakeTelemSlot(Client& c, uint64_t now_ms);
+
+  RelayConfig cfg_;
+  std::unordered_map<uint32_t, Client> clients_;
+  uint32_t controller_{0};  ///< 0 — нет управляющего
+  std::string upstream_mode_;
+  bool upstream_connected_{false};
+  Stats stats_;
+};
+
+}  // namespace rc_vehicle
@@ -2,70 +2,10 @@
 
 namespace rc_vehicle {
 
-TelemetrySnapshot BuildTelemetrySnapshot(
-    const TelemetryContext& ctx, uint32_t now, const SensorSnapshot& sensors,
-    const StabilizationConfig& stab_cfg, DriveMode drive_mode,
-    float applied_throttle, float applied_steering, float commanded_throttle,
-    float commanded_steering) {
-  TelemetrySnapshot snap;
-  snap.uptime_ms = now;
-  snap.rc_ok = sensors.rc_active;
-  snap.wifi_ok = sensors.wifi_active;
-  snap.throttle = applied_throttle;
-  snap.steering = applied_steering;
-
-  if (sensors.rc_active && sensors.rc_cmd) {
-    snap.rc_throttle = sensors.rc_cmd->throttle;
-    snap.rc_steering = sensors.rc_cmd->steering;
-  }
-
-  snap.cmd_throttle = commanded_throttle;
-  snap.cmd_steering = commanded_steering;
-
-  snap.kids_mode_active = (drive_mode == DriveMode::Kids);
-  snap.kids_anti_spin_active = ctx.kids_processor.IsAntiSpinActive();
-  snap.kids_throttle_limit = stab_cfg.kids_mode.throttle_limit;
-
-  if (sensors.mag_enabled) {
-    snap.mag_enabled = true;
-    snap.mag_data = sensors.mag_data;
-    snap.heading_deg = sensors.heading_deg;
-    snap.heading_rel_deg = sensors.heading_rel_deg;
-  }
-
-  if (sensors.imu_enabled) {
-    snap.imu_enabled = true;
-    snap.imu_data = sensors.imu_data;
-    snap.filtered_gz = sensors.filtered_gz;
-    snap.forward_accel = ctx.imu_calib.GetForwardAccel(sensors.imu_data);
-    ctx.madgwick.GetEulerDeg(snap.pitch_deg, snap.roll_deg, snap.yaw_deg);
-    snap.calib_status = ctx.imu_calib.GetStatus();
-    snap.calib_stage = ctx.imu_calib.GetCalibStage();
-    snap.calib_valid = ctx.imu_calib.IsValid();
-    if (snap.calib_valid) {
-      snap.calib_data = ctx.imu_calib.GetData();
-    }
-    snap.ekf_available = true;
-    snap.ekf_vx = ctx.ekf.GetVx();
-    snap.ekf_vy = ctx.ekf.GetVy();
-    snap.ekf_yaw_rate = ctx.ekf.GetYawRate();
-    snap.ekf_slip_deg = ctx.ekf.GetSlipAngleDeg();
-    snap.ekf_speed_ms = ctx.ekf.GetSpeedMs();
-    snap.ekf_vx_var = ctx.ekf.GetVxVariance();
-    snap.ekf_vy_var = ctx.ekf.GetVyVariance();
-    snap.ekf_r_var = ctx.ekf.GetRVariance();
-    snap.oversteer_available = true;
-    snap.oversteer_active = ctx.oversteer_guard.IsActive();
-  }
-  return snap;
-}
-
-TelemetryLogFrame BuildLogFrame(const TelemetryContext& ctx, uint32_t now,
-                                const SensorSnapshot& sensors,
-                                float applied_throttle, float applied_steering,
-                                float commanded_throttle,
-                                float commanded_steering) {
-  TelemetryLogFrame frame;
+void FillLogFrame(const TelemetryContext& ctx, uint32_t now,
+                  const SensorSnapshot& sensors, float applied_throttle,
+                  float applied_steering, float commanded_throttle,
+                  float commanded_steering, TelemetryLogFrame& frame) {
   frame.ts_ms = now;
   frame.ax = sensors.imu_data.ax;
   frame.ay = sensors.imu_data.ay;
@@ -85,6 +25,9 @@ TelemetryLogFrame BuildLogFrame(const TelemetryContext& ctx, uint32_t now,
   if (sensors.rc_active && sensors.rc_cmd) {
     frame.rc_throttle = sensors.rc_cmd->throttle;
     frame.rc_steering = sensors.rc_cmd->steering;
+  } else {
+    frame.rc_throttle = 0.0f;
+    frame.rc_steering = 0.0f;
   }
   frame.cmd_throttle = commanded_throttle;
   frame.cmd_steering = commanded_steering;
@@ -98,9 +41,58 @@ TelemetryLogFrame BuildLogFrame(const TelemetryContext& ctx, uint32_t now,
     frame.mz = sensors.mag_data.mz;
     frame.heading_deg = sensors.heading_deg;
     frame.heading_rel_deg = sensors.heading_rel_deg;
+  } else {
+    frame.mx = frame.my = frame.mz = 0.0f;
+    frame.heading_deg = 0.0f;
+    frame.heading_rel_deg = 0.0f;
   }
   frame.test_marker = ctx.auto_drive.GetTestMarker();
-  return frame;
+  if (ctx.shadow) {
+    ctx.shadow->FillFrame(frame);
+  } else {
+    frame.shadow_state = 0;
+    frame.shadow_load_pct = 0;
+    frame.shadow_cost_pm = 0;
+    frame.shadow_d_throttle = 0.0f;
+    frame.shadow_d_steering = 0.0f;
+  }
+}
+
+void BuildTelemetrySnapshot(const TelemetryContext& ctx, uint32_t now,
+                            const SensorSnapshot& sensors,
+                            const StabilizationConfig& stab_cfg,
+                            DriveMode drive_mode, float applied_throttle,
+                            float applied_steering, float commanded_throttle,
+                            float commanded_steering, TelemetrySnapshot& snap) {
+  FillLogFrame(ctx, now, sensors, applied_throttle, applied_steering,
+               commanded_throttle, commanded_steering, snap.frame);
+
+  snap.rc_ok = sensors.rc_active;
+  snap.wifi_ok = sensors.wifi_active;
+  snap.wifi_source = sensors.wifi_source;
+
+  snap.kids_mode_active = (drive_mode == DriveMode::Kids);
+  snap.kids_anti_spin_active = ctx.kids_processor.IsAntiSpinActive();
+  snap.kids_throttle_limit = stab_cfg.kids_mode.throttle_limit;
+
+  snap.mag_enabled = sensors.mag_enabled;
+
+  snap.imu_enabled = sensors.imu_enabled;
+  snap.ekf_available = sensors.imu_enabled;
+  snap.oversteer_available = sensors.imu_enabled;
+  if (sensors.imu_enabled) {
+    snap.forward_accel = ctx.imu_calib.GetForwardAccel(sensors.imu_data);
+    snap.calib_status = ctx.imu_calib.GetStatus();
+    snap.calib_stage = ctx.imu_calib.GetCalibStage();
+    snap.calib_valid = ctx.imu_calib.IsValid();
+    if (snap.calib_valid) {
+      snap.calib_data = ctx.imu_calib.GetData();
+    }
+    snap.ekf_yaw_rate = ctx.ekf.GetYawRate();
+  }
+
+  snap.sysid_available = ctx.sysid != nullptr && sensors.imu_enabled;
+  if (snap.sysid_available) snap.sysid = ctx.sysid->GetEstimate();
 }
 
 }  // namespace rc_vehicle
@@ -5,6 +5,8 @@
 #include "imu_calibration.hpp"
 #include "kids_mode_processor.hpp"
 #include "madgwick_filter.hpp"
+#include "online_sysid.hpp"
+#include "shadow_stabilizer.hpp"
 #include "stabilization_config.hpp"
 #include "stabilization_pipeline.hpp"
 #include "telemetry_log.hpp"
@@ -20,20 +22,31 @@ struct TelemetryContext {
   const OversteerGuard& oversteer_guard;
   const KidsModeProcessor& kids_processor;
   const AutoDriveCoordinator& auto_drive;
+  const ShadowStabilizer* shadow{nullptr};  ///< Поля shadow_* (опционально)
+  const OnlineSysId* sysid{nullptr};  ///< Группа sysid WS (опционально)
 };
 
-/** Построить WebSocket-снимок телеметрии. */
-TelemetrySnapshot BuildTelemetrySnapshot(
-    const TelemetryContext& ctx, uint32_t now, const SensorSnapshot& sensors,
-    const StabilizationConfig& stab_cfg, DriveMode drive_mode,
-    float applied_throttle, float applied_steering, float commanded_throttle,
-    float commanded_steering);
+/**
+ * @brief Заполнить кадр лога (поля реестра RC_TELEMETRY_LOG_FIELDS).
+ *
+ * Единственное место, где поля реестра получают значения: кадр используется
+ * и для кольцевого лога/UDP, и как frame в TelemetrySnapshot.
+ */
+void FillLogFrame(const TelemetryContext& ctx, uint32_t now,
+                  const SensorSnapshot& sensors, float applied_throttle,
+                  float applied_steering, float commanded_throttle,
+                  float commanded_steering, TelemetryLogFrame& frame);
 
-/** Построить кадр для кольцевого буфера телеметрии. */
-TelemetryLogFrame BuildLogFrame(const TelemetryContext& ctx, uint32_t now,
-                                const SensorSnapshot& sensors,
-                                float applied_throttle, float applied_steering,
-                                float commanded_throttle,
-                                float commanded_steering);
+/**
+ * @brief Построить WebSocket-снимок телеметрии на месте (без копий).
+ *
+ * Заполняет snap.frame через FillLogFrame() и WS-специфичные поля.
+ */
+void BuildTelemetrySnapshot(const TelemetryContext& ctx, uint32_t now,
+                            const SensorSnapshot& sensors,
+                            const StabilizationConfig& stab_cfg,
+                            DriveMode drive_mode, float applied_throttle,
+                            float applied_steering, float commanded_throttle,
+                            float commanded_steering, TelemetrySnapshot& snap);
 
 }  // namespace rc_vehicle
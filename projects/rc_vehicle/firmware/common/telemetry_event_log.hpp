@@ -52,8 +52,10 @@ enum class TelemetryEventType : uint8_t {
  *
  * Записывается только при изменении состояния (старт или стоп).
  *
- * Семантика value1/value2 по типу события (только Start-события):
+ * Семантика value1/value2 по типу события (Start-события и TestDone):
  *   TestStart:        value1 = duration_sec,     value2 = steering [-1..1]
+ *   TestDone (Step):  value1 = overshoot_pct,    value2 = settling_time_s
+ *   TestDone (иначе): value1 = yaw_rate_mean_dps, value2 = speed_mean_ms
  *   TrimCalibStart:   value1 = target_accel_g,   value2 = 0
  *   ComCalibStart:    value1 = target_accel_g,   value2 = steering_magnitude
  *   SpeedCalibStart:  value1 = target_throttle,  value2 = cruise_duration_sec
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file telemetry_fields.hpp
+ * @brief Единый реестр полей телеметрии (X-macro).
+ *
+ * Из этого списка генерируются:
+ *   - struct TelemetryLogFrame (telemetry_log.hpp) — порядок полей = порядок
+ *     в бинарном кадре (log.bin, UDP-стрим);
+ *   - дескриптор схемы kTelemetryLogFields (имя, тип, смещение, единицы);
+ *   - JSON-кодеры кадра (WS get_log_data) и групп WS-телеметрии "telem"
+ *     (telemetry_json.hpp);
+ *   - Python-декодеры (tools/telemetry_schema.py разбирает этот файл).
+ *
+ * Новое поле = одна строка здесь + заполнение в FillLogFrame()
+ * (telemetry_builder.cpp). Поля добавлять только в конец списка: старые логи
+ * декодируются по префиксу (DecodeLogBin). Поля uint8_t группировать так,
+ * чтобы следующий float начинался с границы 4 байт без неявных дыр.
+ *
+ * Формат строки:
+ *   X(type, name, unit, ws_group, ws_key)
+ *     type     — uint32_t | float | uint8_t
+ *     name     — имя поля в кадре, CSV и get_log_data
+ *     unit     — единицы (строка для схемы)
+ *     ws_group — объект в WS "telem" (TelemetryJsonGroup без префикса),
+ *                None — поле только в логе
+ *     ws_key   — ключ внутри группы
+ *
+ * Не забудьте обновить static_assert размера в telemetry_log.hpp.
+ */
+// clang-format off
+#define RC_TELEMETRY_LOG_FIELDS(X)                                       \
+  X(uint32_t, ts_ms,            "ms",      Root,        "uptime_ms")       \
+  X(float,    ax,               "g",       Imu,         "ax")              \
+  X(float,    ay,               "g",       Imu,         "ay")              \
+  X(float,    az,               "g",       Imu,         "az")              \
+  X(float,    gx,               "dps",     Imu,         "gx")              \
+  X(float,    gy,               "dps",     Imu,         "gy")              \
+  X(float,    gz,               "dps",     Imu,         "gz")              \
+  X(float,    vx,               "m/s",     Ekf,         "vx")              \
+  X(float,    vy,               "m/s",     Ekf,         "vy")              \
+  X(float,    slip_deg,         "deg",     Ekf,         "slip_deg")        \
+  X(float,    speed_ms,         "m/s",     Ekf,         "speed_ms")        \
+  X(float,    throttle,         "",        Act,         "throttle")        \
+  X(float,    steering,         "",        Act,         "steering")        \
+  X(float,    pitch_deg,        "deg",     Orientation, "pitch")           \
+  X(float,    roll_deg,         "deg",     Orientation, "roll")            \
+  X(float,    yaw_deg,          "deg",     Orientation, "yaw")             \
+  X(float,    yaw_rate_dps,     "dps",     Imu,         "gyro_z_filtered") \
+  X(float,    oversteer_active, "",        None,        "")                \
+  X(float,    rc_throttle,      "",        Rc,          "throttle")        \
+  X(float,    rc_steering,      "",        Rc,          "steering")        \
+  X(float,    cmd_throttle,     "",        Cmd,         "throttle")        \
+  X(float,    cmd_steering,     "",        Cmd,         "steering")        \
+  X(float,    ekf_vx_var,       "m2/s2",   Ekf,         "vx_var")          \
+  X(float,    ekf_vy_var,       "m2/s2",   Ekf,         "vy_var")          \
+  X(float,    ekf_r_var,        "rad2/s2", Ekf,         "r_var")           \
+  X(float,    ekf_yaw_deg,      "deg",     None,        "")                \
+  X(float,    mx,               "mG",      Mag,         "mx")              \
+  X(float,    my,               "mG",      Mag,         "my")              \
+  X(float,    mz,               "mG",      Mag,         "mz")              \
+  X(float,    heading_deg,      "deg",     Mag,         "heading_deg")     \
+  X(float,    heading_rel_deg,  "deg",     Mag,         "heading_rel_deg") \
+  X(uint8_t,  test_marker,      "",        None,        "")                \
+  X(uint8_t,  shadow_state,     "",        Shadow,      "state")           \
+  X(uint8_t,  shadow_load_pct,  "%",       Shadow,      "load_pct")        \
+  X(uint8_t,  shadow_cost_pm,   "permille", Shadow,      "cost_pm")        \
+  X(float,    shadow_d_throttle, "",        Shadow,      "d_throttle")     \
+  X(float,    shadow_d_steering, "",        Shadow,      "d_steering")
+// clang-format on
+
+namespace rc_vehicle {
+
+/** Тип поля в бинарном кадре. */
+enum class TelemetryFieldType : uint8_t { U32, F32, U8 };
+
+/** Объект WS-телеметрии "telem", в который попадает поле. */
+enum class TelemetryJsonGroup : uint8_t {
+  None,         ///< Только в логе
+  Root,         ///< Корень сообщения
+  Imu,          ///< "imu"
+  Orientation,  ///< "imu.orientation"
+  Mag,          ///< "mag"
+  Ekf,          ///< "ekf"
+  Rc,           ///< "rc"
+  Cmd,          ///< "cmd"
+  Act,          ///< "act"
+  Shadow,       ///< "shadow" (ShadowStabilizer, только при активном кандидате)
+};
+
+/** Дескриптор поля кадра (для схемы и табличных декодеров). */
+struct TelemetryFieldInfo {
+  const char* name;
+  TelemetryFieldType type;
+  uint16_t offset;  ///< Смещение в TelemetryLogFrame [байт]
+  const char* unit;
+  TelemetryJsonGroup ws_group;
+  const char* ws_key;
+};
+
+template <typename T>
+constexpr TelemetryFieldType TelemetryFieldTypeOf();
+template <>
+constexpr TelemetryFieldType TelemetryFieldTypeOf<uint32_t>() {
+  return TelemetryFieldType::U32;
+}
+template <>
+constexpr TelemetryFieldType TelemetryFieldTypeOf<float>() {
+  return TelemetryFieldType::F32;
+}
+template <>
+constexpr TelemetryFieldType TelemetryFieldTypeOf<uint8_t>() {
+  return TelemetryFieldType::U8;
+}
+
+/** Имя типа для схемы: "u32" | "f32" | "u8". */
+constexpr const char* TelemetryFieldTypeName(TelemetryFieldType t) {
+  switch (t) {
+    case TelemetryFieldType::U32:
+      return "u32";
+    case TelemetryFieldType::F32:
+      return "f32";
+    case TelemetryFieldType::U8:
+      return "u8";
+  }
+  return "?";
+}
+
+/** Размер поля в кадре [байт]. */
+constexpr size_t TelemetryFieldSize(TelemetryFieldType t) {
+  return t == TelemetryFieldType::U8 ? 1 : 4;
+}
+
+}  // namespace rc_vehicle
@@ -0,0 +1,46 @@
+#include "telemetry_json.hpp"
+
+namespace rc_vehicle {
+
+void AddLogFrameToJson(cJSON* obj, const TelemetryLogFrame& frame) {
+  if (!obj) return;
+#define RC_TELEM_FIELD_JSON(type, name, unit, group, key) \
+  cJSON_AddNumberToObject(obj, #name, frame.name);
+  RC_TELEMETRY_LOG_FIELDS(RC_TELEM_FIELD_JSON)
+#undef RC_TELEM_FIELD_JSON
+}
+
+void AddLogFrameGroupToJson(cJSON* obj, const TelemetryLogFrame& frame,
+                            TelemetryJsonGroup group) {
+  if (!obj || group == TelemetryJsonGroup::None) return;
+#define RC_TELEM_FIELD_GROUP(type, name, unit, grp, key) \
+  if (group == TelemetryJsonGroup::grp) {                \
+    cJSON_AddNumberToObject(obj, key, frame.name);       \
+  }
+  RC_TELEMETRY_LOG_FIELDS(RC_TELEM_FIELD_GROUP)
+#undef RC_TELEM_FIELD_GROUP
+}
+
+cJSON* BuildLogSchemaJson() {
+  cJSON* root = cJSON_CreateObject();
+  if (!root) return nullptr;
+
+  cJSON_AddNumberToObject(root, "frame_size", sizeof(TelemetryLogFrame));
+  cJSON* fields = cJSON_AddArrayToObject(root, "fields");
+  if (!fields) {
+    cJSON_Delete(root);
+    return nullptr;
+  }
+  for (const auto& info : kTelemetryLogFields) {
+    cJSON* f = cJSON_CreateObject();
+    if (!f) continue;
+    cJSON_AddStringToObject(f, "name", info.name);
+    cJSON_AddStringToObject(f, "type", TelemetryFieldTypeName(info.type));
+    cJSON_AddNumberToObject(f, "offset", info.offset);
+    cJSON_AddStringToObject(f, "unit", info.unit);
+    cJSON_AddItemToArray(fields, f);
+  }
+  return root;
+}
+
+}  // namespace rc_vehicle
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "cJSON.h"
+#include "telemetry_fields.hpp"
+#include "telemetry_log.hpp"
+
+namespace rc_vehicle {
+
+/**
+ * @brief Добавить все поля кадра в объект по именам реестра.
+ *
+ * Формат кадра WS get_log_data: {"ts_ms":..,"ax":..,...,"test_marker":..}.
+ * Порядок ключей = порядок полей TelemetryLogFrame.
+ */
+void AddLogFrameToJson(cJSON* obj, const TelemetryLogFrame& frame);
+
+/**
+ * @brief Добавить в объект поля кадра, отнесённые к группе WS-телеметрии.
+ *
+ * Ключи — ws_key реестра (например, yaw_rate_dps → "gyro_z_filtered" в "imu").
+ * Создание самого объекта группы и условия его наличия — на вызывающем.
+ */
+void AddLogFrameGroupToJson(cJSON* obj, const TelemetryLogFrame& frame,
+                            TelemetryJsonGroup group);
+
+/**
+ * @brief Схема кадра для клиентов (веб-интерфейс, Python).
+ *
+ * {"frame_size":136,"fields":[{"name":"ts_ms","type":"u32","offset":0,
+ *   "unit":"ms"},...]}
+ *
+ * @return Новый объект (освобождает вызывающий) или nullptr при нехватке памяти
+ */
+cJSON* BuildLogSchemaJson();
+
+}  // namespace rc_vehicle
@@ -1,6 +1,8 @@
 #include "telemetry_log.hpp"
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <mutex>
 
 #ifdef ESP_PLATFORM
@@ -42,7 +44,7 @@ bool TelemetryLog::Init(size_t capacity_frames) {
 
   capacity_ = capacity_frames;
   count_ = 0;
-  write_pos_ = 0;
+  head_seq_ = 0;
   return true;
 }
 
@@ -57,8 +59,8 @@ void TelemetryLog::Push(const TelemetryLogFrame& frame) {
   }
 
   std::lock_guard<std::mutex> lock(mutex_);
-  buf_[write_pos_ % capacity_] = frame;
-  write_pos_++;
+  buf_[head_seq_ % capacity_] = frame;
+  head_seq_++;
   if (count_ < capacity_) {
     count_++;
   }
@@ -73,14 +75,52 @@ bool TelemetryLog::GetFrame(size_t idx, TelemetryLogFrame& out) const {
   if (idx >= count_) {
     return false;
   }
-  // Oldest frame находится по индексу: (write_pos_ - count_ + idx) % capacity_
-  const size_t real_pos = (write_pos_ - count_ + idx) % capacity_;
+  // Oldest frame находится по индексу: (head_seq_ - count_ + idx) % capacity_
+  const size_t real_pos =
+      static_cast<size_t>((head_seq_ - count_ + idx) % capacity_);
   out = buf_[real_pos];
   return true;
 }
 
+uint64_t TelemetryLog::HeadSeq() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return head_seq_;
+}
+
+rc_vehicle::TelemetryLogSpan TelemetryLog::ReadSince(uint64_t seq,
+                                                     TelemetryLogFrame* out,
+                                                     size_t max_frames,
+                                                     size_t gap_skip) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  rc_vehicle::TelemetryLogSpan span;
+  span.head_seq = head_seq_;
+  const uint64_t oldest = head_seq_ - count_;
+
+  uint64_t start = seq;
+  if (seq > head_seq_) {
+    span.cursor_ahead = true;
+    start = oldest;
+  } else if (seq < oldest) {
+    // Запас от писателя нужен, только если кольцо полно (после Clear — нет)
+    const uint64_t skip = count_ == capacity_ ? gap_skip : 0;
+    start = std::min<uint64_t>(oldest + skip, head_seq_);
+    span.dropped = start - seq;
+  }
+  span.first_seq = start;
+  if (!buf_ || !out) return span;
+
+  const size_t n =
+      static_cast<size_t>(std::min<uint64_t>(head_seq_ - start, max_frames));
+  // Не более двух непрерывных отрезков кольца
+  const size_t pos = static_cast<size_t>(start % capacity_);
+  const size_t first = std::min(n, capacity_ - pos);
+  std::memcpy(out, buf_ + pos, first * sizeof(TelemetryLogFrame));
+  std::memcpy(out + first, buf_, (n - first) * sizeof(TelemetryLogFrame));
+  span.count = n;
+  return span;
+}
+
 void TelemetryLog::Clear() {
   std::lock_guard<std::mutex> lock(mutex_);
   count_ = 0;
-  write_pos_ = 0;
 }
@@ -4,50 +4,104 @@
 #include <cstdint>
 #include <mutex>
 
+#include "telemetry_fields.hpp"
+
 /**
  * @brief Кадр телеметрии для кольцевого буфера логов
  *
- * Размер: 116 байт (27 × float + uint32_t + uint8_t + padding).
+ * Поля генерируются из реестра RC_TELEMETRY_LOG_FIELDS (telemetry_fields.hpp):
+ * uint32_t ts_ms + 30 × float + 4 × uint8_t (test_marker, shadow_*) +
+ * 2 × float (расхождение shadow-стадии).
  * Хранится в PSRAM при наличии (ESP_PLATFORM), иначе в обычной heap.
  *
- * Буфер 60000 кадров × 116 байт ≈ 6.6 МБ (PSRAM из 16 МБ).
+ * Буфер 60000 кадров × 136 байт ≈ 8.2 МБ (PSRAM из 16 МБ).
  */
 struct TelemetryLogFrame {
-  uint32_t ts_ms{0};           // Метка времени [мс]
-  float ax{0}, ay{0}, az{0};   // Ускорение IMU (откалиброванное, в g)
-  float gx{0}, gy{0}, gz{0};   // Угловая скорость IMU (dps)
-  float vx{0}, vy{0};          // EKF: скорость [м/с]
-  float slip_deg{0};            // EKF: угол заноса [градусы]
-  float speed_ms{0};            // EKF: полная скорость |v| [м/с]
-  float throttle{0};            // Применённый газ (после trim/slew) [-1..1]
-  float steering{0};            // Применённый руль (после trim/slew) [-1..1]
-  float pitch_deg{0};           // Madgwick: pitch [градусы]
-  float roll_deg{0};            // Madgwick: roll [градусы]
-  float yaw_deg{0};             // Madgwick: yaw [градусы]
-  float yaw_rate_dps{0};        // Отфильтрованный gyro Z [дпс]
-  float oversteer_active{0};    // OversteerGuard: 1.0 = занос, 0.0 = нет
-  float rc_throttle{0};         // Сырой газ с RC-приёмника [-1..1]
-  float rc_steering{0};         // Сырой руль с RC-приёмника [-1..1]
-  // --- Новые поля для программы испытаний ---
-  float cmd_throttle{0};        // Команда газа до trim/slew [-1..1]
-  float cmd_steering{0};        // Команда руля до trim/slew [-1..1]
-  float ekf_vx_var{0};          // EKF: дисперсия vx [м²/с²]
-  float ekf_vy_var{0};          // EKF: дисперсия vy [м²/с²]
-  float ekf_r_var{0};           // EKF: дисперсия yaw rate [рад²/с²]
-  float ekf_yaw_deg{0};         // EKF: курсовой угол [°, из магнитометра]
-  // --- Магнетометр MMC5983MA ---
-  float mx{0};                   // Магнитное поле X [мГс]
-  float my{0};                   // Магнитное поле Y [мГс]
-  float mz{0};                   // Магнитное поле Z [мГс]
-  float heading_deg{0};          // Tilt-compensated magnetic heading [°, 0=N, 90=E]
-  float heading_rel_deg{0};      // Относительный курс [°, -180..180]
-  uint8_t test_marker{0};       // Маркер теста (0 = нет, >0 = ID теста)
-  uint8_t _pad[3]{};            // Выравнивание до 4 байт
-};  // sizeof == 128 bytes (30 × float + uint32_t + uint8_t + 3 pad)
-
-// Compile-time проверка размера структуры
-static_assert(sizeof(TelemetryLogFrame) == 128,
+#define RC_TELEM_FIELD_DECL(type, name, unit, group, key) type name{0};
+  RC_TELEMETRY_LOG_FIELDS(RC_TELEM_FIELD_DECL)
+#undef RC_TELEM_FIELD_DECL
+};
+
+// Compile-time проверка размера структуры: без неявных дыр между полями
+static_assert(sizeof(TelemetryLogFrame) == 136,
               "TelemetryLogFrame size mismatch");
+static_assert(offsetof(TelemetryLogFrame, shadow_d_throttle) == 128,
+              "TelemetryLogFrame: uint8_t fields must fill the 4-byte slot");
+
+namespace rc_vehicle {
+
+/** Схема кадра TelemetryLogFrame в порядке полей. */
+inline constexpr TelemetryFieldInfo kTelemetryLogFields[] = {
+#define RC_TELEM_FIELD_INFO(type, name, unit, group, key)             \
+  {#name, TelemetryFieldTypeOf<type>(),                                \
+   static_cast<uint16_t>(offsetof(TelemetryLogFrame, name)), unit,    \
+   TelemetryJsonGroup::group, key},
+    RC_TELEMETRY_LOG_FIELDS(RC_TELEM_FIELD_INFO)
+#undef RC_TELEM_FIELD_INFO
+};
+
+inline constexpr size_t kTelemetryLogFieldCount =
+    sizeof(kTelemetryLogFields) / sizeof(kTelemetryLogFields[0]);
+
+/**
+ * @brief Результат TelemetryLog::ReadSince — кадры [first_seq, first_seq +
+ *        count) и положение курсора относительно кольца.
+ */
+struct TelemetryLogSpan {
+  uint64_t first_seq{0};  ///< seq первого скопированного кадра
+  uint64_t head_seq{0};   ///< seq следующего Push (всего записано кадров)
+  uint64_t dropped{0};    ///< Кадров между курсором и first_seq нет в кольце
+  size_t count{0};        ///< Скопировано кадров
+  bool cursor_ahead{false};  ///< Курсор новее head (перезагрузка устройства)
+};
+
+/** Флаги TelemetryLogSinceHeader::flags. */
+enum TelemetryLogSinceFlags : uint32_t {
+  kLogSinceGap = 1u << 0,    ///< dropped > 0: локальная копия с разрывом
+  kLogSinceReset = 1u << 1,  ///< Курсор новее head — начать копию заново
+};
+
+/**
+ * @brief Заголовок ответа log_since (GET /api/log_since, WS "log_since").
+ *
+ * Формат (little-endian): заголовок, затем frame_count × frame_size байт
+ * кадров с seq first_seq, first_seq + 1, ... Следующий запрос — с
+ * seq = next_seq.
+ */
+struct TelemetryLogSinceHeader {
+  static constexpr uint32_t kMagic = 0x434E534Cu;  ///< "LSNC"
+  static constexpr uint16_t kVersion = 1;
+
+  uint32_t magic{kMagic};
+  uint16_t version{kVersion};
+  uint16_t frame_size{sizeof(TelemetryLogFrame)};
+  uint64_t first_seq{0};
+  uint64_t next_seq{0};  ///< first_seq + frame_count — курсор клиента
+  uint64_t head_seq{0};  ///< Всего записано на устройстве (next_seq < head
+                         ///< — есть ещё кадры, запросить сразу)
+  uint64_t dropped{0};   ///< Вытеснено кольцом до first_seq
+  uint32_t frame_count{0};
+  uint32_t flags{0};     ///< TelemetryLogSinceFlags
+};
+
+static_assert(sizeof(TelemetryLogSinceHeader) == 48,
+              "TelemetryLogSinceHeader: wire format is 48 bytes");
+
+/** Заголовок для span, из которого отдаётся frame_count кадров. */
+inline TelemetryLogSinceHeader MakeLogSinceHeader(const TelemetryLogSpan& span,
+                                                  uint32_t frame_count) {
+  TelemetryLogSinceHeader h;
+  h.first_seq = span.first_seq;
+  h.next_seq = span.first_seq + frame_count;
+  h.head_seq = span.head_seq;
+  h.dropped = span.dropped;
+  h.frame_count = frame_count;
+  if (span.dropped > 0) h.flags |= kLogSinceGap;
+  if (span.cursor_ahead) h.flags |= kLogSinceReset;
+  return h;
+}
+
+}  // namespace rc_vehicle
 
 /**
  * @brief Потокобезопасный кольцевой буфер кадров телеметрии
@@ -56,6 +110,11 @@ static_assert(sizeof(TelemetryLogFrame) == 128,
  * Push() вытесняет старые данные при переполнении.
  * Чтение через GetFrame(idx=0) → oldest, idx=Count()-1 → newest.
  *
+ * Каждый кадр получает 64-битный seq (0, 1, 2, ... с Init). Seq не
+ * сбрасывается при Clear() и не переполняется, поэтому клиент синхронизирует
+ * копию курсором: ReadSince(seq) отдаёт кадры новее курсора и сообщает,
+ * сколько кадров кольцо успело вытеснить.
+ *
  * @note Не копируется и не перемещается.
  */
 class TelemetryLog {
@@ -98,14 +157,39 @@ class TelemetryLog {
   bool GetFrame(size_t idx, TelemetryLogFrame& out) const;
 
   /**
-   * @brief Очистить буфер (сбросить счётчики)
+   * @brief seq следующего записываемого кадра (= всего записано с Init)
+   */
+  [[nodiscard]] uint64_t HeadSeq() const;
+
+  /**
+   * @brief Скопировать кадры с seq ≥ seq (не более max_frames)
+   *
+   * Если кольцо уже вытеснило кадр seq, чтение начинается с самого старого
+   * кадра (в полном кольце — плюс gap_skip, чтобы последующие порции не
+   * догонял писатель), а span.dropped считает пропущенные кадры. Курсор
+   * новее head (перезагрузка) — чтение с самого старого кадра без gap_skip,
+   * span.cursor_ahead.
+   * Копирование — под одним захватом мьютекса.
+   *
+   * @param seq Курсор клиента (next_seq прошлого ответа, 0 — с начала)
+   * @param out Буфер на max_frames кадров
+   * @param max_frames Ёмкость out
+   * @param gap_skip Сдвиг от oldest при разрыве в полном кольце (кадров)
+   */
+  rc_vehicle::TelemetryLogSpan ReadSince(uint64_t seq,
+                                         TelemetryLogFrame* out,
+                                         size_t max_frames,
+                                         size_t gap_skip = 0) const;
+
+  /**
+   * @brief Очистить буфер (seq продолжает расти)
    */
   void Clear();
 
  private:
   TelemetryLogFrame* buf_{nullptr};
   size_t capacity_{0};
-  size_t write_pos_{0};
+  uint64_t head_seq_{0};
   size_t count_{0};
   mutable std::mutex mutex_;
 };
@@ -0,0 +1,132 @@
+#include "telemetry_log_decoder.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace rc_vehicle {
+
+namespace {
+
+bool ReadU32(const uint8_t* data, size_t size, size_t& pos, uint32_t& v) {
+  if (size - pos < sizeof(uint32_t)) return false;
+  std::memcpy(&v, data + pos, sizeof(v));
+  pos += sizeof(v);
+  return true;
+}
+
+/// Проверить, что count записей по rec_size помещаются, и сдвинуть pos.
+bool SkipRecords(size_t size, size_t& pos, uint32_t count, uint32_t rec_size) {
+  const size_t avail = size - pos;
+  if (rec_size != 0 && count > avail / rec_size) return false;
+  pos += static_cast<size_t>(count) * rec_size;
+  return true;
+}
+
+/// Скопировать записи секции в out (префикс min(src, dst)).
+template <typename T>
+void CopyRecords(const uint8_t* src, uint32_t count, uint32_t src_size,
+                 std::vector<T>& out) {
+  out.resize(count);
+  const size_t copy = std::min<size_t>(src_size, sizeof(T));
+  for (uint32_t i = 0; i < count; ++i) {
+    std::memcpy(&out[i], src + static_cast<size_t>(i) * src_size, copy);
+  }
+}
+
+}  // namespace
+
+LogDecodeError ParseLogBinView(const uint8_t* data, size_t size,
+                               LogBinView& out) {
+  out = LogBinView{};
+  if (!data && size != 0) return LogDecodeError::Truncated;
+
+  size_t pos = 0;
+  uint32_t frame_count = 0;
+  uint32_t frame_size = 0;
+  if (!ReadU32(data, size, pos, frame_count) ||
+      !ReadU32(data, size, pos, frame_size)) {
+    return LogDecodeError::Truncated;
+  }
+  if (frame_size < sizeof(uint32_t)) return LogDecodeError::BadFrameSize;
+  const uint8_t* frames = data + pos;
+  if (!SkipRecords(size, pos, frame_count, frame_size)) {
+    return LogDecodeError::Truncated;
+  }
+  out.frames = frames;
+  out.frame_count = frame_count;
+  out.frame_size = frame_size;
+
+  // Секция событий появилась позже — её отсутствие допустимо
+  if (pos == size) return LogDecodeError::None;
+
+  uint32_t event_count = 0;
+  uint32_t event_size = 0;
+  if (!ReadU32(data, size, pos, event_count) ||
+      !ReadU32(data, size, pos, event_size)) {
+    return LogDecodeError::Truncated;
+  }
+  if (event_size < sizeof(uint32_t)) return LogDecodeError::BadEventSize;
+  const uint8_t* events = data + pos;
+  if (!SkipRecords(size, pos, event_count, event_size)) {
+    return LogDecodeError::Truncated;
+  }
+  out.events = events;
+  out.event_count = event_count;
+  out.event_size = event_size;
+  return LogDecodeError::None;
+}
+
+LogDecodeError DecodeLogBin(const uint8_t* data, size_t size, DecodedLog& out) {
+  out = DecodedLog{};
+  LogBinView view;
+  const LogDecodeError err = ParseLogBinView(data, size, view);
+  // Кадры валидны даже при битой секции событий
+  if (view.frames) {
+    out.source_frame_size = view.frame_size;
+    CopyRecords(view.frames, view.frame_count, view.frame_size, out.frames);
+  }
+  if (view.events) {
+    out.source_event_size = view.event_size;
+    CopyRecords(view.events, view.event_count, view.event_size, out.events);
+  }
+  return err;
+}
+
+LogDecodeError DecodeLogSince(const uint8_t* data, size_t size,
+                              DecodedLogSince& out) {
+  out = DecodedLogSince{};
+  if (!data || size < sizeof(TelemetryLogSinceHeader)) {
+    return LogDecodeError::Truncated;
+  }
+  TelemetryLogSinceHeader& h = out.header;
+  std::memcpy(&h, data, sizeof(h));
+  if (h.magic != TelemetryLogSinceHeader::kMagic ||
+      h.version != TelemetryLogSinceHeader::kVersion) {
+    return LogDecodeError::BadMagic;
+  }
+  if (h.frame_size < sizeof(uint32_t)) return LogDecodeError::BadFrameSize;
+  size_t pos = sizeof(h);
+  if (!SkipRecords(size, pos, h.frame_count, h.frame_size)) {
+    return LogDecodeError::Truncated;
+  }
+  CopyRecords(data + sizeof(h), h.frame_count, h.frame_size, out.frames);
+  return LogDecodeError::None;
+}
+
+const char* LogDecodeErrorToString(LogDecodeError err) noexcept {
+  switch (err) {
+    case LogDecodeError::None:
+      return "ok";
+    case LogDecodeError::Truncated:
+      return "truncated log";
+    case LogDecodeError::BadFrameSize:
+      return "invalid frame size in header";
+    case LogDecodeError::BadEventSize:
+      return "invalid event size in header";
+    case LogDecodeError::BadMagic:
+      return "not a log_since reply";
+  }
+  return "unknown error";
+}
+
+}  // namespace rc_vehicle
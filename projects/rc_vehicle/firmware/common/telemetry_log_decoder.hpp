@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "telemetry_event_log.hpp"
+#include "telemetry_log.hpp"
+
+namespace rc_vehicle {
+
+/** @brief Результат разбора бинарного лога (GET /api/log.bin). */
+enum class LogDecodeError : uint8_t {
+  None = 0,
+  Truncated,     ///< Данных меньше, чем объявлено в заголовке секции
+  BadFrameSize,  ///< frame_size = 0 или меньше поля ts_ms
+  BadEventSize,  ///< event_size = 0 или меньше поля ts_ms
+  BadMagic,      ///< Не ответ log_since (magic / версия)
+};
+
+/** @brief Разобранный лог: кадры и события в порядке записи (oldest first). */
+struct DecodedLog {
+  std::vector<TelemetryLogFrame> frames;
+  std::vector<TelemetryEvent> events;
+  uint32_t source_frame_size{0};  ///< frame_size из заголовка (версия прошивки)
+  uint32_t source_event_size{0};  ///< event_size из заголовка
+};
+
+/**
+ * @brief Zero-copy представление бинарного лога: указатели на секции.
+ *
+ * Записи лежат с шагом frame_size / event_size исходной прошивки и могут
+ * быть невыровнены — читать поля через memcpy (см. log_convert.hpp).
+ */
+struct LogBinView {
+  const uint8_t* frames{nullptr};
+  uint32_t frame_count{0};
+  uint32_t frame_size{0};
+  const uint8_t* events{nullptr};  ///< nullptr если секции событий нет
+  uint32_t event_count{0};
+  uint32_t event_size{0};
+};
+
+/**
+ * @brief Проверить заголовки секций и построить LogBinView без копирования.
+ *
+ * Формат и правила те же, что у DecodeLogBin. data должен жить дольше view
+ * (например, mmap файла).
+ */
+LogDecodeError ParseLogBinView(const uint8_t* data, size_t size,
+                               LogBinView& out);
+
+/**
+ * @brief Разобрать бинарный лог, отданный log_bin_handler (http_server.cpp).
+ *
+ * Формат (little-endian):
+ *   [u32 frame_count][u32 frame_size][frame_count × frame_size]
+ *   [u32 event_count][u32 event_size][event_count × event_size]
+ *
+ * Кадры другого размера (старая/новая прошивка) копируются по префиксу:
+ * недостающие поля остаются нулевыми, лишние отбрасываются. Отсутствующая
+ * секция событий (логи до появления TelemetryEventLog) — не ошибка.
+ *
+ * Платформонезависимо; используется хостовыми инструментами и модулем Python.
+ *
+ * @param data Указатель на содержимое файла
+ * @param size Размер в байтах
+ * @param[out] out Результат (очищается перед разбором)
+ */
+LogDecodeError DecodeLogBin(const uint8_t* data, size_t size, DecodedLog& out);
+
+/** @brief Разобранный ответ log_since: порция кадров и курсор. */
+struct DecodedLogSince {
+  TelemetryLogSinceHeader header{};
+  std::vector<TelemetryLogFrame> frames;  ///< seq header.first_seq + i
+};
+
+/**
+ * @brief Разобрать ответ GET /api/log_since или WS "log_since".
+ *
+ * Формат — TelemetryLogSinceHeader + frame_count × frame_size (telemetry_log
+ * .hpp). Кадры другого размера копируются по префиксу, как в DecodeLogBin.
+ * Клиент дописывает frames к локальной копии, если header.first_seq равен
+ * его курсору (иначе — разрыв на header.dropped кадров), и продолжает с
+ * header.next_seq.
+ */
+LogDecodeError DecodeLogSince(const uint8_t* data, size_t size,
+                              DecodedLogSince& out);
+
+/** @brief Строковое описание ошибки разбора (для CLI/исключений Python). */
+const char* LogDecodeErrorToString(LogDecodeError err) noexcept;
+
+}  // namespace rc_vehicle
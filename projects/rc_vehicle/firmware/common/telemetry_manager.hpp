@@ -61,6 +61,14 @@ class TelemetryManager {
     return telem_log_.GetFrame(idx, out);
   }
 
+  /**
+   * @brief Кадры новее курсора seq (см. TelemetryLog::ReadSince)
+   */
+  TelemetryLogSpan ReadLogSince(uint64_t seq, TelemetryLogFrame* out,
+                                size_t max_frames, size_t gap_skip) const {
+    return telem_log_.ReadSince(seq, out, max_frames, gap_skip);
+  }
+
   /**
    * @brief Очистить буфер телеметрии
    */
@@ -30,6 +30,9 @@ bool TestRunner::Start(const TestParams& params) {
 
   type_ = params_.type;
   total_elapsed_sec_ = 0.0f;
+  analyzer_.Reset();
+  result_ = Result{};
+  result_.type = type_;
 
   TransitionTo(Phase::Accelerate);
   return true;
@@ -48,6 +51,8 @@ void TestRunner::Reset() {
   type_ = TestType::Straight;
   params_ = TestParams{};
   driver_.Reset();
+  analyzer_.Reset();
+  result_ = Result{};
   total_elapsed_sec_ = 0.0f;
   phase_elapsed_sec_ = 0.0f;
 }
@@ -64,7 +69,7 @@ TestRunner::Status TestRunner::GetStatus() const {
 
 void TestRunner::Update(float current_accel_g, float accel_magnitude,
                         float filtered_gz_dps, float dt_sec, float& throttle,
-                        float& steering) {
+                        float& steering, float speed_ms, float slip_deg) {
   throttle = 0.0f;
   steering = 0.0f;
 
@@ -79,6 +84,7 @@ void TestRunner::Update(float current_accel_g, float accel_magnitude,
                             dt_sec);
 
   MotionPhase dp = driver_.GetPhase();
+  const ManeuverSample sample{filtered_gz_dps, slip_deg, speed_ms};
 
   switch (phase_) {
     case Phase::Accelerate: {
@@ -93,12 +99,14 @@ void TestRunner::Update(float current_accel_g, float accel_magnitude,
     case Phase::Cruise: {
       phase_elapsed_sec_ += dt_sec;
       throttle = driver_.GetCruiseThrottle();
+      analyzer_.AddCruise(sample, phase_elapsed_sec_, dt_sec);
 
       switch (type_) {
         case TestType::Straight:
           steering = 0.0f;
           if (phase_elapsed_sec_ >= params_.duration_sec) {
             driver_.EndCruise();
+            FinishMetrics();
             TransitionTo(Phase::Brake);
           }
           break;
@@ -107,6 +115,7 @@ void TestRunner::Update(float current_accel_g, float accel_magnitude,
           steering = params_.steering;
           if (phase_elapsed_sec_ >= params_.duration_sec) {
             driver_.EndCruise();
+            FinishMetrics();
             TransitionTo(Phase::Brake);
           }
           break;
@@ -114,6 +123,7 @@ void TestRunner::Update(float current_accel_g, float accel_magnitude,
         case TestType::Step:
           steering = 0.0f;
           if (phase_elapsed_sec_ >= kStepSettleSec) {
+            analyzer_.BeginStep(params_.duration_sec);
             TransitionTo(Phase::StepExec);
           }
           break;
@@ -125,9 +135,11 @@ void TestRunner::Update(float current_accel_g, float accel_magnitude,
       phase_elapsed_sec_ += dt_sec;
       throttle = driver_.GetCruiseThrottle();
       steering = params_.steering;
+      analyzer_.AddStep(sample, dt_sec);
 
       if (phase_elapsed_sec_ >= params_.duration_sec) {
         driver_.EndCruise();
+        FinishMetrics();
         TransitionTo(Phase::Brake);
       }
       break;
@@ -136,6 +148,7 @@ void TestRunner::Update(float current_accel_g, float accel_magnitude,
     case Phase::Brake: {
       steering = 0.0f;
       if (dp == MotionPhase::Stopped) {
+        result_.valid = true;
         TransitionTo(Phase::Done);
       }
       break;
@@ -151,4 +164,9 @@ void TestRunner::TransitionTo(Phase next) {
   phase_elapsed_sec_ = 0.0f;
 }
 
+void TestRunner::FinishMetrics() {
+  result_.metrics = analyzer_.Finish();
+  result_.finished = true;
+}
+
 }  // namespace rc_vehicle
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 
+#include "maneuver_analyzer.hpp"
 #include "motion_driver.hpp"
 
 namespace rc_vehicle {
@@ -44,6 +45,9 @@ struct TestParams {
  *
  * Безопасность: RC override прерывает тест, failsafe → Stop().
  * Маркер test_marker проставляется в телеметрию.
+ *
+ * Метрики (ManeuverAnalyzer) считаются по ходу фаз Cruise / StepExec и
+ * фиксируются при переходе в Brake — выгружать лог для них не нужно.
  */
 class TestRunner {
  public:
@@ -65,6 +69,14 @@ class TestRunner {
     bool valid{false};             ///< Тест завершён успешно
   };
 
+  /** Итог последнего теста (GetResult). */
+  struct Result {
+    TestType type{TestType::Straight};
+    bool finished{false};  ///< Метрики зафиксированы (основная фаза пройдена)
+    bool valid{false};     ///< Тест завершён успешно (Done)
+    ManeuverMetrics metrics{};
+  };
+
   TestRunner() = default;
 
   /**
@@ -94,6 +106,9 @@ class TestRunner {
   /** Текущий статус. */
   [[nodiscard]] Status GetStatus() const;
 
+  /** Метрики последнего теста (сбрасываются при Start). */
+  [[nodiscard]] const Result& GetResult() const { return result_; }
+
   /** test_marker для телеметрии (0 если тест не активен). */
   [[nodiscard]] uint8_t GetTestMarker() const {
     return IsActive() ? static_cast<uint8_t>(type_) : 0;
@@ -108,10 +123,12 @@ class TestRunner {
    * @param dt_sec Шаг времени (с)
    * @param[out] throttle Команда газа
    * @param[out] steering Команда руля
+   * @param speed_ms Скорость EKF [м/с] — только для метрик
+   * @param slip_deg Угол заноса EKF [°] — только для метрик
    */
   void Update(float current_accel_g, float accel_magnitude,
               float filtered_gz_dps, float dt_sec, float& throttle,
-              float& steering);
+              float& steering, float speed_ms = 0.0f, float slip_deg = 0.0f);
 
   /** Сбросить в начальное состояние. */
   void Reset();
@@ -122,6 +139,8 @@ class TestRunner {
   TestParams params_{};
 
   MotionDriver driver_;
+  ManeuverAnalyzer analyzer_;
+  Result result_{};
 
   float total_elapsed_sec_{0.0f};
   float phase_elapsed_sec_{0.0f};
@@ -130,6 +149,7 @@ class TestRunner {
   static constexpr float kStepSettleSec = 1.0f;
 
   void TransitionTo(Phase next);
+  void FinishMetrics();
 };
 
 }  // namespace rc_vehicle
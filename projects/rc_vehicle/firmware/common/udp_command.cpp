@@ -0,0 +1,81 @@
+#include "udp_command.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace rc_vehicle {
+
+UdpCommandPacket MakeUdpCommand(uint32_t seq, uint32_t token, float throttle,
+                                float steering) noexcept {
+  UdpCommandPacket pkt{};
+  pkt.magic[0] = kUdpCommandMagic[0];
+  pkt.magic[1] = kUdpCommandMagic[1];
+  pkt.version = kUdpCommandVersion;
+  pkt.flags = 0;
+  pkt.seq = seq;
+  pkt.token = token;
+  pkt.throttle = throttle;
+  pkt.steering = steering;
+  return pkt;
+}
+
+const char* UdpCommandVerdictName(UdpCommandVerdict v) noexcept {
+  switch (v) {
+    case UdpCommandVerdict::Accepted:
+      return "accepted";
+    case UdpCommandVerdict::Duplicate:
+      return "duplicate";
+    case UdpCommandVerdict::Stale:
+      return "stale";
+    case UdpCommandVerdict::BadToken:
+      return "bad_token";
+    case UdpCommandVerdict::Malformed:
+      return "malformed";
+  }
+  return "unknown";
+}
+
+UdpCommandVerdict UdpCommandFilter::Accept(const void* data, size_t len,
+                                           uint32_t now_ms,
+                                           UdpCommandPacket& out) noexcept {
+  UdpCommandPacket pkt;
+  if (!data || len != sizeof(pkt)) {
+    ++stats_.malformed;
+    return UdpCommandVerdict::Malformed;
+  }
+  std::memcpy(&pkt, data, sizeof(pkt));
+  if (pkt.magic[0] != kUdpCommandMagic[0] ||
+      pkt.magic[1] != kUdpCommandMagic[1] ||
+      pkt.version != kUdpCommandVersion || !std::isfinite(pkt.throttle) ||
+      !std::isfinite(pkt.steering)) {
+    ++stats_.malformed;
+    return UdpCommandVerdict::Malformed;
+  }
+  if (pkt.token != token_) {
+    ++stats_.bad_token;
+    return UdpCommandVerdict::BadToken;
+  }
+
+  if (have_last_) {
+    const int32_t ahead = static_cast<int32_t>(pkt.seq - last_seq_);
+    const bool silent = now_ms - last_accept_ms_ > resync_ms_;
+    if (ahead == 0 && !silent) {
+      ++stats_.duplicate;
+      return UdpCommandVerdict::Duplicate;
+    }
+    if (ahead < 0 && !silent) {
+      ++stats_.stale;
+      return UdpCommandVerdict::Stale;
+    }
+    if (ahead <= 0) ++stats_.resyncs;
+  }
+
+  have_last_ = true;
+  last_seq_ = pkt.seq;
+  last_accept_ms_ = now_ms;
+  ++stats_.accepted;
+  out = pkt;
+  return UdpCommandVerdict::Accepted;
+}
+
+}  // namespace rc_vehicle
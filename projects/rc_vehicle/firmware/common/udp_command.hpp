@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "config.hpp"
+
+/**
+ * @file udp_command.hpp
+ * @brief UDP-канал команд газ/руль: формат датаграммы и фильтр приёма.
+ *
+ * WebSocket — это TCP: один потерянный сегмент задерживает все следующие
+ * команды до ретрансмиссии (head-of-line blocking), и failsafe видит
+ * устаревшую команду, хотя новые уже отправлены. По UDP каждая датаграмма
+ * самодостаточна: потеря стоит одного периода отправки, а не RTO.
+ *
+ * Семантика приёма — «побеждает последняя»: команда с seq не новее уже
+ * принятой отбрасывается (дубликат или опоздавшая). Клиент может слать
+ * каждую команду несколько раз подряд (--dup) — копии отсекаются по seq.
+ * Поле token — идентификатор сессии: случайное число, выбираемое прошивкой
+ * при загрузке и отдаваемое любому спросившему (WS get_udp_cmd, UDP
+ * CMDINFO). Он отсекает клиентов, оставшихся с прошлой загрузки, и
+ * случайный мусор на порту, но не является секретом: управлять может любой
+ * узел в той же сети.
+ */
+
+namespace rc_vehicle {
+
+inline constexpr uint8_t kUdpCommandMagic[2] = {0x52, 0x43};  // "RC"
+inline constexpr uint8_t kUdpCommandVersion = 1;
+
+/**
+ * @brief Датаграмма команды (20 байт, little-endian, как UdpTelemPacket).
+ */
+struct __attribute__((packed)) UdpCommandPacket {
+  uint8_t magic[2];
+  uint8_t version;
+  uint8_t flags;   ///< Резерв, 0
+  uint32_t seq;    ///< Растёт на 1 на каждую новую команду (копии — тот же)
+  uint32_t token;  ///< Идентификатор сессии прошивки (не секрет)
+  float throttle;  ///< Газ [-1..1]
+  float steering;  ///< Руль [-1..1]
+};
+
+static_assert(sizeof(UdpCommandPacket) == 20, "UdpCommandPacket size");
+
+/** Собрать датаграмму команды. */
+[[nodiscard]] UdpCommandPacket MakeUdpCommand(uint32_t seq, uint32_t token,
+                                              float throttle,
+                                              float steering) noexcept;
+
+/** Итог разбора одной датаграммы. */
+enum class UdpCommandVerdict : uint8_t {
+  Accepted = 0,  ///< Новая команда
+  Duplicate,     ///< seq равен последнему принятому (копия)
+  Stale,         ///< seq старше последнего принятого (опоздала)
+  BadToken,      ///< Идентификатор чужой (прошлой) сессии
+  Malformed,     ///< Размер, magic, версия или не конечные значения
+};
+
+[[nodiscard]] const char* UdpCommandVerdictName(UdpCommandVerdict v) noexcept;
+
+/** Счётчики UdpCommandFilter. */
+struct UdpCommandStats {
+  uint32_t accepted{0};
+  uint32_t duplicate{0};
+  uint32_t stale{0};
+  uint32_t bad_token{0};
+  uint32_t malformed{0};
+  uint32_t resyncs{0};  ///< Принят seq после тишины дольше resync_ms
+};
+
+/**
+ * @brief Фильтр приёма: проверка датаграммы и «побеждает последняя».
+ *
+ * seq сравнивается по модулю 2^32 (переполнение счётчика клиента не
+ * ломает порядок). После тишины дольше resync_ms принимается любой seq:
+ * клиент перезапустился и начал счёт заново. Не потокобезопасен —
+ * один владелец (задача приёма).
+ *
+ * @code
+ * UdpCommandFilter filter(token);
+ * UdpCommandPacket cmd;
+ * if (filter.Accept(buf, len, now_ms, cmd) == UdpCommandVerdict::Accepted) {
+ *   OnWifiCommand(cmd.throttle, cmd.steering, WifiCommandSource::Udp);
+ * }
+ * @endcode
+ */
+class UdpCommandFilter {
+ public:
+  explicit UdpCommandFilter(
+      uint32_t token,
+      uint32_t resync_ms = config::UdpCommandConfig::kResyncMs) noexcept
+      : token_(token), resync_ms_(resync_ms) {}
+
+  /**
+   * @brief Разобрать датаграмму data[0, len), принятую в now_ms.
+   * @param out Команда (заполняется только при Accepted)
+   */
+  UdpCommandVerdict Accept(const void* data, size_t len, uint32_t now_ms,
+                           UdpCommandPacket& out) noexcept;
+
+  [[nodiscard]] uint32_t Token() const noexcept { return token_; }
+  [[nodiscard]] const UdpCommandStats& Stats() const noexcept {
+    return stats_;
+  }
+  /** seq последней принятой команды (0 — ещё не было). */
+  [[nodiscard]] uint32_t LastSeq() const noexcept { return last_seq_; }
+
+ private:
+  uint32_t token_;
+  uint32_t resync_ms_;
+  bool have_last_{false};
+  uint32_t last_seq_{0};
+  uint32_t last_accept_ms_{0};
+  UdpCommandStats stats_;
+};
+
+}  // namespace rc_vehicle
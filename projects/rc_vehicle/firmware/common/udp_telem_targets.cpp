@@ -0,0 +1,101 @@
+#include "udp_telem_targets.hpp"
+
+#include <cstdio>
+
+namespace rc_vehicle {
+
+namespace {
+
+constexpr uint16_t kMinPort = 1024;
+constexpr uint32_t kBroadcast = 0xFFFFFFFFu;
+
+}  // namespace
+
+const char* UdpTelemTargetErrorName(UdpTelemTargetError e) noexcept {
+  switch (e) {
+    case UdpTelemTargetError::InvalidAddress:
+      return "invalid address";
+    case UdpTelemTargetError::InvalidPort:
+      return "port must be >= 1024";
+    case UdpTelemTargetError::Full:
+      return "target list full";
+    case UdpTelemTargetError::NotFound:
+      return "target not found";
+  }
+  return "unknown";
+}
+
+bool ParseIpv4(const char* s, uint32_t& out) noexcept {
+  if (!s) return false;
+  uint32_t addr = 0;
+  for (int octet = 0; octet < 4; ++octet) {
+    if (octet > 0) {
+      if (*s != '.') return false;
+      ++s;
+    }
+    uint32_t value = 0;
+    int digits = 0;
+    while (*s >= '0' && *s <= '9') {
+      value = value * 10 + static_cast<uint32_t>(*s - '0');
+      ++s;
+      if (++digits > 3 || value > 255) return false;
+    }
+    if (digits == 0) return false;
+    addr = (addr << 8) | value;
+  }
+  if (*s != '\0') return false;
+  out = addr;
+  return true;
+}
+
+void FormatIpv4(uint32_t addr, char* buf, size_t len) noexcept {
+  if (!buf || len == 0) return;
+  std::snprintf(buf, len, "%u.%u.%u.%u", (unsigned)(addr >> 24) & 0xFF,
+                (unsigned)(addr >> 16) & 0xFF, (unsigned)(addr >> 8) & 0xFF,
+                (unsigned)addr & 0xFF);
+}
+
+Result<Unit, UdpTelemTargetError> UdpTelemTargetSet::AddUnicast(
+    uint32_t addr, uint16_t port) noexcept {
+  using R = Result<Unit, UdpTelemTargetError>;
+  if (addr == 0 || addr == kBroadcast || IsMulticastIpv4(addr)) {
+    return R(UdpTelemTargetError::InvalidAddress);
+  }
+  if (port < kMinPort) return R(UdpTelemTargetError::InvalidPort);
+
+  const UdpTelemTarget target{addr, port};
+  for (size_t i = 0; i < unicast_count_; ++i) {
+    if (unicast_[i] == target) return R(Unit{});
+  }
+  if (unicast_count_ >= kMaxUnicast) return R(UdpTelemTargetError::Full);
+  unicast_[unicast_count_++] = target;
+  return R(Unit{});
+}
+
+Result<Unit, UdpTelemTargetError> UdpTelemTargetSet::RemoveUnicast(
+    uint32_t addr, uint16_t port) noexcept {
+  using R = Result<Unit, UdpTelemTargetError>;
+  const UdpTelemTarget target{addr, port};
+  for (size_t i = 0; i < unicast_count_; ++i) {
+    if (unicast_[i] == target) {
+      // Сохраняем порядок: получатели шлются в порядке подписки
+      for (size_t j = i + 1; j < unicast_count_; ++j) {
+        unicast_[j - 1] = unicast_[j];
+      }
+      --unicast_count_;
+      return R(Unit{});
+    }
+  }
+  return R(UdpTelemTargetError::NotFound);
+}
+
+Result<Unit, UdpTelemTargetError> UdpTelemTargetSet::SetGroup(
+    uint32_t addr, uint16_t port) noexcept {
+  using R = Result<Unit, UdpTelemTargetError>;
+  if (!IsMulticastIpv4(addr)) return R(UdpTelemTargetError::InvalidAddress);
+  if (port < kMinPort) return R(UdpTelemTargetError::InvalidPort);
+  group_ = UdpTelemTarget{addr, port};
+  return R(Unit{});
+}
+
+}  // namespace rc_vehicle
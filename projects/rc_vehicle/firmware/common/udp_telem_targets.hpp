@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "config.hpp"
+#include "result.hpp"
+
+/**
+ * @file udp_telem_targets.hpp
+ * @brief Получатели UDP-телеметрии: multicast-группа и до N unicast-адресов.
+ *
+ * Пакет кодируется один раз и отправляется каждому получателю из набора.
+ * Группа (224.0.0.0/4) — одна передача по радио на всех подписчиков;
+ * unicast-адреса — для получателей, которые не могут подписаться на группу
+ * (каждый стоит отдельной передачи). Управление — через порт 5556
+ * (START/JOIN/LEAVE/MCAST, см. udp_telem_sender.hpp).
+ *
+ * Адреса хранятся в порядке байт хоста: 192.168.4.2 == 0xC0A80402.
+ */
+
+namespace rc_vehicle {
+
+/** Один получатель телеметрии. */
+struct UdpTelemTarget {
+  uint32_t addr{0};  ///< IPv4, порядок байт хоста
+  uint16_t port{0};
+
+  bool operator==(const UdpTelemTarget&) const = default;
+};
+
+enum class UdpTelemTargetError : uint8_t {
+  InvalidAddress,  ///< 0.0.0.0, broadcast или не тот тип (unicast/группа)
+  InvalidPort,     ///< Порт < 1024
+  Full,            ///< Уже kMaxUnicastTargets unicast-получателей
+  NotFound,        ///< LEAVE для отсутствующего получателя
+};
+
+[[nodiscard]] const char* UdpTelemTargetErrorName(
+    UdpTelemTargetError e) noexcept;
+
+/** Разобрать "a.b.c.d" (строго четыре десятичных октета). */
+[[nodiscard]] bool ParseIpv4(const char* s, uint32_t& out) noexcept;
+
+/** Записать адрес как "a.b.c.d" (буфер не меньше 16 байт). */
+void FormatIpv4(uint32_t addr, char* buf, size_t len) noexcept;
+
+/** 224.0.0.0/4. */
+[[nodiscard]] constexpr bool IsMulticastIpv4(uint32_t addr) noexcept {
+  return (addr & 0xF0000000u) == 0xE0000000u;
+}
+
+/**
+ * @brief Набор получателей: не более одной группы и kMaxUnicast адресов.
+ *
+ * Не потокобезопасен: владелец копирует набор под своей блокировкой
+ * (тривиально копируемый, ~40 байт) и рассылает по снимку.
+ *
+ * @code
+ * UdpTelemTargetSet targets;
+ * targets.AddUnicast(0xC0A80402u, 5555);    // JOIN от 192.168.4.2
+ * targets.SetGroup(0xEF010203u, 5555);      // MCAST 239.1.2.3 5555
+ * targets.ForEach([&](const UdpTelemTarget& t) { sendto(..., t); });
+ * @endcode
+ */
+class UdpTelemTargetSet {
+ public:
+  static constexpr size_t kMaxUnicast =
+      config::UdpTelemConfig::kMaxUnicastTargets;
+
+  /** Добавить unicast-получателя; повторное добавление — no-op. */
+  Result<Unit, UdpTelemTargetError> AddUnicast(uint32_t addr,
+                                               uint16_t port) noexcept;
+
+  /** Убрать unicast-получателя. */
+  Result<Unit, UdpTelemTargetError> RemoveUnicast(uint32_t addr,
+                                                  uint16_t port) noexcept;
+
+  /** Назначить multicast-группу (заменяет предыдущую). */
+  Result<Unit, UdpTelemTargetError> SetGroup(uint32_t addr,
+                                             uint16_t port) noexcept;
+
+  void ClearGroup() noexcept { group_.reset(); }
+  void Clear() noexcept {
+    group_.reset();
+    unicast_count_ = 0;
+  }
+
+  [[nodiscard]] const std::optional<UdpTelemTarget>& Group() const noexcept {
+    return group_;
+  }
+  [[nodiscard]] size_t UnicastCount() const noexcept {
+    return unicast_count_;
+  }
+  [[nodiscard]] const UdpTelemTarget& Unicast(size_t i) const noexcept {
+    return unicast_[i];
+  }
+
+  /** Всего адресов отправки (группа + unicast). */
+  [[nodiscard]] size_t Size() const noexcept {
+    return unicast_count_ + (group_ ? 1 : 0);
+  }
+  [[nodiscard]] bool Empty() const noexcept { return Size() == 0; }
+
+  /** Обойти адреса отправки: сначала группа, затем unicast по порядку. */
+  template <typename F>
+  void ForEach(F&& fn) const {
+    if (group_) fn(*group_);
+    for (size_t i = 0; i < unicast_count_; ++i) fn(unicast_[i]);
+  }
+
+ private:
+  std::optional<UdpTelemTarget> group_;
+  std::array<UdpTelemTarget, kMaxUnicast> unicast_{};
+  size_t unicast_count_{0};
+};
+
+}  // namespace rc_vehicle
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string_view>
+#include <type_traits>
 
 #include "imu_calibration.hpp"
 #include "mag_calibration.hpp"
@@ -40,6 +43,16 @@ struct RcCommand {
   float steering{0.0f};  ///< Руль [-1..1]
 };
 
+/**
+ * @brief Источник Wi-Fi команд (у каждого — своя очередь и своя свежесть)
+ */
+enum class WifiCommandSource : uint8_t {
+  WebSocket = 0,  ///< {"type":"cmd"} по WebSocket (TCP)
+  Udp,            ///< Бинарный UDP-канал команд (udp_command.hpp)
+};
+
+inline constexpr size_t kWifiCommandSourceCount = 2;
+
 /**
  * @brief Абстрактный интерфейс платформы для VehicleControl
  *
@@ -273,17 +286,20 @@ class VehicleControlPlatform {
   // ─────────────────────────────────────────────────────────────────────────
 
   /**
-   * @brief Попытаться получить команду из очереди Wi-Fi (неблокирующе)
+   * @brief Попытаться получить команду из очереди источника (неблокирующе)
    * @return Команда, если была в очереди
    */
-  [[nodiscard]] virtual std::optional<RcCommand> TryReceiveWifiCommand() = 0;
+  [[nodiscard]] virtual std::optional<RcCommand> TryReceiveWifiCommand(
+      WifiCommandSource source) = 0;
 
   /**
-   * @brief Поставить команду в очередь Wi-Fi (вызов из потока WebSocket)
+   * @brief Поставить команду в очередь источника (вызов из потока
+   *        WebSocket / UDP; в очереди только последняя команда)
    * @param throttle Газ [-1..1]
    * @param steering Руль [-1..1]
    */
-  virtual void SendWifiCommand(float throttle, float steering) = 0;
+  virtual void SendWifiCommand(float throttle, float steering,
+                               WifiCommandSource source) = 0;
 
   // ─────────────────────────────────────────────────────────────────────────
   // Задачи и синхронизация
@@ -355,4 +371,23 @@ class VehicleControlPlatform {
   virtual void FeedTaskWdt() noexcept {}
 };
 
+/**
+ * @brief Платформа, на которой инстанцируется тик control loop.
+ *
+ * ControlLoopProcessorT<P> и Poll() обработчиков вызывают горячие методы
+ * (GetTimeMs, ReadImu, ReadMag, GetRc, TryReceiveWifiCommand, SetPwm,
+ * FailsafeUpdate, FeedTaskWdt) через статический тип P:
+ * - final-наследник (ESP32, HostPlatform бенчмарка) — прямые вызовы без
+ *   vtable, компилятор может их встраивать;
+ * - сам VehicleControlPlatform — type-erased адаптер через vtable для
+ *   gmock-моков и тестовых платформ-наследников.
+ *
+ * Для не-final наследника статический тип ничего не даёт (вызов остаётся
+ * виртуальным), поэтому он не допускается: нужен базовый адаптер.
+ */
+template <typename P>
+concept ControlTickPlatform =
+    std::derived_from<P, VehicleControlPlatform> &&
+    (std::same_as<P, VehicleControlPlatform> || std::is_final_v<P>);
+
 }  // namespace rc_vehicle
@@ -1,7 +1,11 @@
 #include "vehicle_control_unified.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #include "config.hpp"
 #include "control_loop_processor.hpp"
+#include "log_format.hpp"
 #include "rc_vehicle_common.hpp"
 
 namespace rc_vehicle {
@@ -10,43 +14,25 @@ namespace rc_vehicle {
 // VehicleControlUnified Implementation
 // ═════════════════════════════════════════════════════════════════════════
 
-void VehicleControlUnified::SetPlatform(
-    std::unique_ptr<VehicleControlPlatform> platform) {
-  platform_ = std::move(platform);
-}
-
 void VehicleControlUnified::ControlTaskEntry(void* arg) {
   auto* self = static_cast<VehicleControlUnified*>(arg);
   if (self) {
-    self->ControlTaskLoop();
+    (self->*self->control_loop_)();
   }
 }
 
-void VehicleControlUnified::ControlTaskLoop() {
-  if (!platform_) return;
-  platform_->RegisterTaskWdt();
-
-  const ControlLoopContext ctx{
-      *platform_,       imu_calib_,        madgwick_,    ekf_,
-      yaw_ctrl_,        pitch_ctrl_,        slip_ctrl_,   oversteer_guard_,
-      kids_processor_,  auto_drive_,
-      calib_mgr_.get(), stab_mgr_.get(),    telem_mgr_.get(),
-      rc_handler_.get(), wifi_handler_.get(), imu_handler_.get(),
-      telem_handler_.get(), last_loop_hz_};
-
-  const uint32_t start = platform_->GetTimeMs();
-  ControlLoopProcessor processor(ctx, start);
-
-  control_task_ready_.store(true, std::memory_order_release);
-
-  uint32_t last_loop = start;
-  while (true) {
-    platform_->DelayUntilNextTick(config::ControlLoopConfig::kPeriodMs);
-    const uint32_t now = platform_->GetTimeMs();
-    processor.Step(now, now - last_loop);
-    last_loop = now;
-    platform_->FeedTaskWdt();
-  }
+template void VehicleControlUnified::ControlTaskLoop<VehicleControlPlatform>();
+
+void VehicleControlUnified::ReportBootTime() {
+  // GetTimeUs() на ESP32 — esp_timer, отсчёт от сброса
+  const uint32_t boot_ms = std::max<uint32_t>(
+      1, static_cast<uint32_t>(platform_->GetTimeUs() / 1000));
+  boot_ms_.store(boot_ms, std::memory_order_relaxed);
+  const bool over = boot_ms > config::DiagnosticsConfig::kBootBudgetMs;
+  LogFormat fmt;
+  fmt << "Boot: first control tick at " << boot_ms << " ms (budget "
+      << config::DiagnosticsConfig::kBootBudgetMs << " ms)";
+  platform_->Log(over ? LogLevel::Warning : LogLevel::Info, fmt.str());
 }
 
 bool VehicleControlUnified::StartComOffsetCalibration(
@@ -105,18 +91,28 @@ void VehicleControlUnified::CancelMagCalibration() {
   }
 }
 
-void VehicleControlUnified::OnWifiCommand(float throttle, float steering) {
+void VehicleControlUnified::OnWifiCommand(float throttle, float steering,
+                                          WifiCommandSource source) {
   if (platform_) {
-    platform_->SendWifiCommand(throttle, steering);
+    platform_->SendWifiCommand(throttle, steering, source);
   }
 }
 
+bool VehicleControlUnified::IsStationary() const {
+  using Cfg = config::OtaConfig;
+  if (auto_drive_.IsAnyActive()) return false;
+  if (std::abs(ekf_.GetSpeedMs()) >= Cfg::kMaxSpeedMs) return false;
+  return !imu_handler_ ||
+         std::abs(imu_handler_->GetFilteredGyroZ()) < Cfg::kMaxYawRateDps;
+}
+
 std::vector<SelfTestItem> VehicleControlUnified::RunSelfTest() const {
   const SelfTestContext ctx{last_loop_hz_,   imu_handler_.get(),
                             madgwick_,       ekf_,
                             rc_handler_.get(), wifi_handler_.get(),
                             imu_calib_,      telem_mgr_.get(),
-                            platform_ != nullptr, inited_};
+                            platform_ != nullptr, inited_,
+                            boot_ms_.load(std::memory_order_relaxed)};
   return SelfTest::Run(BuildSelfTestInput(ctx));
 }
 
@@ -1,17 +1,22 @@
 #pragma once
 
 #include <atomic>
+#include <concepts>
 #include <memory>
 
+#include "allan_variance.hpp"
 #include "auto_drive_coordinator.hpp"
 #include "calibration_manager.hpp"
 #include "control_components.hpp"
+#include "control_loop_processor.hpp"
 #include "drive_mode_registry.hpp"
 #include "i_vehicle_control.hpp"
 #include "imu_calibration.hpp"
 #include "mag_calibration.hpp"
 #include "self_test.hpp"
 #include "kids_mode_processor.hpp"
+#include "online_sysid.hpp"
+#include "shadow_stabilizer.hpp"
 #include "madgwick_filter.hpp"
 #include "stabilization_config.hpp"
 #include "stabilization_manager.hpp"
@@ -42,9 +47,22 @@ class VehicleControlUnified : public IVehicleControl {
 
   /**
    * @brief Установить платформу (должно быть вызвано до Init)
+   *
+   * Тик control loop инстанцируется на статическом типе P, если он
+   * удовлетворяет ControlTickPlatform (final), иначе — на type-erased
+   * VehicleControlPlatform (моки, тестовые наследники).
    * @param platform Уникальный указатель на платформу
    */
-  void SetPlatform(std::unique_ptr<VehicleControlPlatform> platform);
+  template <std::derived_from<VehicleControlPlatform> P>
+  void SetPlatform(std::unique_ptr<P> platform) {
+    if constexpr (ControlTickPlatform<P>) {
+      control_loop_ = &VehicleControlUnified::ControlTaskLoop<P>;
+    } else {
+      control_loop_ =
+          &VehicleControlUnified::ControlTaskLoop<VehicleControlPlatform>;
+    }
+    platform_ = std::move(platform);
+  }
 
   /**
    * @brief Инициализация (PWM, RC, IMU, NVS, запуск control loop)
@@ -53,11 +71,13 @@ class VehicleControlUnified : public IVehicleControl {
   [[nodiscard]] PlatformError Init();
 
   /**
-   * @brief Команда по Wi‑Fi (WebSocket)
+   * @brief Команда по Wi‑Fi (WebSocket или UDP-канал команд)
    * @param throttle Газ [-1..1]
    * @param steering Руль [-1..1]
+   * @param source Источник: свежесть отслеживается отдельно
    */
-  void OnWifiCommand(float throttle, float steering) override;
+  void OnWifiCommand(float throttle, float steering,
+                     WifiCommandSource source) override;
 
   /**
    * @brief Запуск калибровки IMU, этап 1
@@ -211,6 +231,11 @@ class VehicleControlUnified : public IVehicleControl {
     return auto_drive_.GetTestStatus();
   }
 
+  /** Метрики последнего теста (считаются на устройстве по ходу манёвра). */
+  [[nodiscard]] TestRunner::Result GetTestResult() const override {
+    return auto_drive_.GetTestResult();
+  }
+
   /**
    * @brief Запустить калибровку скорости (throttle → speed gain)
    * @param target_throttle Целевой газ в фазе крейсера
@@ -276,6 +301,63 @@ class VehicleControlUnified : public IVehicleControl {
     return stab_mgr_->SetConfig(config, save_to_nvs);
   }
 
+  // ── Shadow-режим стабилизации ─────────────────────────────────────────────
+
+  /**
+   * @brief Запустить кандидатную конфигурацию параллельно живой
+   *
+   * Кандидат считается каждый тик на тех же входах, выход не попадает в
+   * PWM; расхождение — в полях shadow_* кадра и GetShadowStats().
+   * Повторный вызов заменяет кандидата и сбрасывает статистику.
+   *
+   * @return false если IMU не инициализирован или конфигурация невалидна
+   */
+  bool StartShadowStabilization(
+      const StabilizationConfig& candidate) override {
+    if (!stab_mgr_ || !imu_enabled_) return false;
+    return shadow_.SetCandidate(candidate);
+  }
+
+  void StopShadowStabilization() override { shadow_.Stop(); }
+
+  [[nodiscard]] StabilizationConfig GetShadowCandidate() const override {
+    return shadow_.GetCandidate();
+  }
+
+  [[nodiscard]] ShadowStats GetShadowStats() const override {
+    return shadow_.GetStats();
+  }
+
+  // ── Онлайн-идентификация ──────────────────────────────────────────────────
+
+  [[nodiscard]] SysIdEstimate GetSysIdEstimate() const override {
+    return sysid_.GetEstimate();
+  }
+
+  /**
+   * @brief Подтягивать yaw_rate.steer_to_yaw_rate_dps к оценке sysid
+   *
+   * Раз в config::SysIdConfig::kApplyIntervalMs, не более чем на
+   * kApplyMaxStepFrac за шаг, только при валидной оценке. Изменения не
+   * сохраняются в NVS (сохранение — set_stab_config).
+   */
+  void SetSysIdApply(bool enabled) override { sysid_.SetApplyEnabled(enabled); }
+
+  [[nodiscard]] bool IsSysIdApplyEnabled() const override {
+    return sysid_.IsApplyEnabled();
+  }
+
+  void ResetSysId() override { sysid_.RequestReset(); }
+
+  // ── Шумы IMU (дисперсия Аллана) ───────────────────────────────────────────
+
+  /** Кривые, подгонка и рекомендации по накопленному на стоянке. */
+  void GetAllanReport(AllanReport& out) const override {
+    allan_.GetReport(out);
+  }
+
+  void ResetAllan() override { allan_.RequestReset(); }
+
   /**
    * @brief Получить информацию о буфере телеметрии
    * @param count_out Текущее количество кадров
@@ -295,6 +377,15 @@ class VehicleControlUnified : public IVehicleControl {
     return telem_mgr_->GetLogFrame(idx, out);
   }
 
+  /**
+   * @brief Кадры новее курсора seq (инкрементальная синхронизация лога)
+   */
+  TelemetryLogSpan ReadLogSince(uint64_t seq, TelemetryLogFrame* out,
+                                size_t max_frames,
+                                size_t gap_skip) const override {
+    return telem_mgr_->ReadLogSince(seq, out, max_frames, gap_skip);
+  }
+
   /**
    * @brief Очистить буфер телеметрии
    */
@@ -330,6 +421,14 @@ class VehicleControlUnified : public IVehicleControl {
     return control_task_ready_.load(std::memory_order_acquire);
   }
 
+  /**
+   * @brief Машина стоит (условие запуска и продолжения OTA)
+   *
+   * Нет активного авто-манёвра/калибровки, |v| EKF < OtaConfig::kMaxSpeedMs,
+   * |gz| < OtaConfig::kMaxYawRateDps.
+   */
+  [[nodiscard]] bool IsStationary() const override;
+
   VehicleControlUnified(const VehicleControlUnified&) = delete;
   VehicleControlUnified& operator=(const VehicleControlUnified&) = delete;
 
@@ -342,10 +441,14 @@ class VehicleControlUnified : public IVehicleControl {
   static void ControlTaskEntry(void* arg);
 
   /**
-   * @brief Основной цикл управления
+   * @brief Основной цикл управления на платформе со статическим типом P
    */
+  template <ControlTickPlatform P>
   void ControlTaskLoop();
 
+  /** Зафиксировать и залогировать время до первого тика (один раз). */
+  void ReportBootTime();
+
   /** Инициализация IMU подсистемы (менеджеры, NVS, авто-калибровка). */
   void InitImuSubsystem();
 
@@ -361,8 +464,10 @@ class VehicleControlUnified : public IVehicleControl {
   // Члены класса
   // ─────────────────────────────────────────────────────────────────────────
 
-  // Платформа (HAL)
+  // Платформа (HAL) и инстанс цикла под её статический тип (SetPlatform)
   std::unique_ptr<VehicleControlPlatform> platform_;
+  void (VehicleControlUnified::*control_loop_)() =
+      &VehicleControlUnified::ControlTaskLoop<VehicleControlPlatform>;
 
   // Калибровка, фильтр
   ImuCalibration imu_calib_;
@@ -375,6 +480,15 @@ class VehicleControlUnified : public IVehicleControl {
   SlipAngleController slip_ctrl_;
   OversteerGuard oversteer_guard_;
 
+  // Shadow-экземпляр стадии стабилизации (кандидатная конфигурация)
+  ShadowStabilizer shadow_;
+
+  // Онлайн-идентификация динамики (RLS)
+  OnlineSysId sysid_;
+
+  // Дисперсия Аллана gx..az на стоянке (шаг — период control loop)
+  AllanNoiseMonitor allan_{config::ControlLoopConfig::kPeriodMs * 0.001};
+
   // Kids Mode процессор (ограничения газа/руля, anti-spin)
   KidsModeProcessor kids_processor_;
 
@@ -401,10 +515,48 @@ class VehicleControlUnified : public IVehicleControl {
   // Флаг готовности control task (init-ready barrier)
   std::atomic<bool> control_task_ready_{false};
 
+  // Сброс → первый тик control loop, мс (0 — тика ещё не было)
+  std::atomic<uint32_t> boot_ms_{0};
+
   // Менеджеры (управление отдельными аспектами системы)
   std::unique_ptr<CalibrationManager> calib_mgr_;
   std::unique_ptr<StabilizationManager> stab_mgr_;
   std::unique_ptr<TelemetryManager> telem_mgr_;
 };
 
+template <ControlTickPlatform P>
+void VehicleControlUnified::ControlTaskLoop() {
+  if (!platform_) return;
+  // SetPlatform выбрал P по типу переданной платформы
+  P& platform = static_cast<P&>(*platform_);
+  platform.RegisterTaskWdt();
+
+  const ControlLoopContext ctx{
+      platform,         imu_calib_,        madgwick_,    ekf_,
+      yaw_ctrl_,        pitch_ctrl_,        slip_ctrl_,   oversteer_guard_,
+      kids_processor_,  auto_drive_,
+      calib_mgr_.get(), stab_mgr_.get(),    telem_mgr_.get(),
+      rc_handler_.get(), wifi_handler_.get(), imu_handler_.get(),
+      telem_handler_.get(), last_loop_hz_,
+      &shadow_,         &sysid_,           &allan_};
+
+  const uint32_t start = platform.GetTimeMs();
+  ControlLoopProcessorT<P> processor(platform, ctx, start);
+
+  control_task_ready_.store(true, std::memory_order_release);
+
+  uint32_t last_loop = start;
+  while (true) {
+    platform.DelayUntilNextTick(config::ControlLoopConfig::kPeriodMs);
+    const uint32_t now = platform.GetTimeMs();
+    if (boot_ms_.load(std::memory_order_relaxed) == 0) ReportBootTime();
+    processor.Step(now, now - last_loop);
+    last_loop = now;
+    platform.FeedTaskWdt();
+  }
+}
+
+extern template void
+VehicleControlUnified::ControlTaskLoop<VehicleControlPlatform>();
+
 }  // namespace rc_vehicle
\ No newline at end of file
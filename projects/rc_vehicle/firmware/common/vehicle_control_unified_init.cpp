@@ -1,7 +1,5 @@
 #include "vehicle_control_unified.hpp"
 
-#include <iomanip>
-
 #include "calibration_manager.hpp"
 #include "config.hpp"
 #include "control_components.hpp"
@@ -65,8 +63,7 @@ void VehicleControlUnified::InitImuSubsystem() {
                    "IMU init failed — continuing without IMU");
     if (who >= 0) {
       LogFormat fmt;
-      fmt << "IMU WHO_AM_I = 0x" << std::hex << std::setw(2)
-          << std::setfill('0') << static_cast<unsigned>(who);
+      fmt << "IMU WHO_AM_I = 0x" << Hex(static_cast<unsigned>(who), 2);
       platform_->Log(LogLevel::Info, fmt.str());
     }
     return;
@@ -119,7 +116,8 @@ void VehicleControlUnified::InitTelemetryLog() {
 bool VehicleControlUnified::InitializeComponents() {
   if (rc_enabled_) {
     rc_handler_.reset(
-        new RcInputHandler(*platform_, config::RcInputConfig::kPollIntervalMs));
+        new RcInputHandler(*platform_, config::RcInputConfig::kPollIntervalMs,
+                           config::RateGroupConfig::kRcPollPhaseMs));
   }
   wifi_handler_.reset(
       new WifiCommandHandler(*platform_, config::WifiConfig::kCommandTimeoutMs));
@@ -153,9 +151,11 @@ bool VehicleControlUnified::InitializeComponents() {
   slip_ctrl_.Init(cfg, ekf_, imu_handler_.get());
   oversteer_guard_.Init(cfg, ekf_, imu_handler_.get());
   kids_processor_.Init(cfg, ekf_, imu_handler_.get());
+  shadow_.Init(ekf_, madgwick_, imu_handler_.get());
 
   telem_handler_.reset(new TelemetryHandler(
-      *platform_, config::TelemetryConfig::kSendIntervalMs));
+      *platform_, config::TelemetryConfig::kSendIntervalMs,
+      config::RateGroupConfig::kWsTelemPhaseMs));
   return true;
 }
 
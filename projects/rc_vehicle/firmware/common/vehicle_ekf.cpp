@@ -57,28 +57,16 @@ void VehicleEkf::Predict(float ax, float ay, float dt) noexcept {
 
   const float vy_damp = 1.0f - params_.vy_decay_hz * dt;
 
+  // Якобиан — в точке до предсказания
+  float F[16];
+  TransitionJacobian(x_, dt, params_.vy_decay_hz, F);
+
   // ── Нелинейная модель f(x, u) ─────────────────────────────────────────
   x_[0] = vx + dt * (ax + r * vy);
   x_[1] = vy * vy_damp + dt * (ay - r * vx);
   x_[2] = r;
   x_[3] = WrapAngle(psi + r * dt);
 
-  // ── Якобиан F (4×4, row-major) ────────────────────────────────────────
-  //
-  // F = [ 1,       dt·r,   dt·vy,  0 ]
-  //     [ -dt·r,   vy_dmp, -dt·vx, 0 ]
-  //     [ 0,       0,      1,      0 ]
-  //     [ 0,       0,      dt,     1 ]
-  //
-  // ∂ψ/∂r = dt, остальные частные производные ψ нулевые.
-
-  float F[16] = {
-      1.0f,    dt * r,   dt * vy,  0.0f,
-      -dt * r, vy_damp,  -dt * vx, 0.0f,
-      0.0f,    0.0f,     1.0f,     0.0f,
-      0.0f,    0.0f,     dt,       1.0f,
-  };
-
   // ── P = F * P * F^T + Q ───────────────────────────────────────────────
   float FP[16], Ft[16], FPFt[16];
   MatMul4x4(F, P_, FP);
@@ -139,8 +127,10 @@ void VehicleEkf::UpdateHeading(float heading_rad) noexcept {
   const float z = WrapAngle(heading_rad);
 
   // Инновация с обёрткой угла: корректно обрабатывает переход через ±π
-  const float innov = std::atan2(std::sin(z - x_[3]),
-                                 std::cos(z - x_[3]));
+  constexpr bool kFast = config::FastMathConfig::kEkfHeadingWrap;
+  float sin_d, cos_d;
+  SinCos<kFast>(z - x_[3], sin_d, cos_d);
+  const float innov = Atan2<kFast>(sin_d, cos_d);
 
   // S = P[3][3] + R_heading = P_[15] + r_heading
   const float S = P_[15] + params_.r_heading;
@@ -215,10 +205,19 @@ void VehicleEkf::UpdateZeroVelocity(float r_zupt) noexcept {
 void VehicleEkf::UpdateFromImu(float ax_g, float ay_g, float az_g,
                                float gz_dps, float dt_sec,
                                float throttle_abs) noexcept {
+  PredictFromImu(ax_g, ay_g, dt_sec);
+  CorrectFromImu(ax_g, ay_g, az_g, gz_dps, throttle_abs);
+}
+
+void VehicleEkf::PredictFromImu(float ax_g, float ay_g, float dt_sec) noexcept {
   constexpr float kG = 9.80665f;
+  Predict(ax_g * kG, ay_g * kG, dt_sec);
+}
+
+void VehicleEkf::CorrectFromImu(float ax_g, float ay_g, float az_g,
+                                float gz_dps, float throttle_abs) noexcept {
   constexpr float kDegToRad = kPi / 180.0f;
 
-  Predict(ax_g * kG, ay_g * kG, dt_sec);
   UpdateGyroZ(gz_dps * kDegToRad);
 
   // ZUPT: применяем только если машина реально стоит (throttle ≈ 0).
@@ -236,18 +235,53 @@ void VehicleEkf::UpdateFromImu(float ax_g, float ay_g, float az_g,
   }
 }
 
+bool VehicleEkf::UpdateFromImuBatch(const ImuBatch& batch,
+                                    std::span<const float> throttle_abs,
+                                    const VehicleEkfBatchOutput& out) noexcept {
+  if (!batch.IsValid()) return false;
+  const size_t n = batch.Size();
+  const auto size_ok = [n](size_t s) { return s == 0 || s == n; };
+  if (!size_ok(throttle_abs.size()) || !size_ok(out.vx.size()) ||
+      !size_ok(out.vy.size()) || !size_ok(out.yaw_rate.size()) ||
+      !size_ok(out.yaw_rad.size())) {
+    return false;
+  }
+
+  const size_t dt_stride = batch.DtStride();
+  const bool has_throttle = !throttle_abs.empty();
+  const bool has_out = !out.vx.empty() || !out.vy.empty() ||
+                       !out.yaw_rate.empty() || !out.yaw_rad.empty();
+  for (size_t i = 0; i < n; ++i) {
+    UpdateFromImu(batch.ax[i], batch.ay[i], batch.az[i], batch.gz[i],
+                  batch.dt[i * dt_stride],
+                  has_throttle ? throttle_abs[i] : 0.0f);
+    if (has_out) {
+      if (!out.vx.empty()) out.vx[i] = x_[0];
+      if (!out.vy.empty()) out.vy[i] = x_[1];
+      if (!out.yaw_rate.empty()) out.yaw_rate[i] = x_[2];
+      if (!out.yaw_rad.empty()) out.yaw_rad[i] = x_[3];
+    }
+  }
+  return true;
+}
+
 // ═════════════════════════════════════════════════════════════════════════
 // Угол заноса
 // ═════════════════════════════════════════════════════════════════════════
 
-float VehicleEkf::GetSlipAngleRad() const noexcept {
-  if (GetSpeedMs() < kMinSpeedThreshold) {
+float VehicleEkf::SlipAngleRad(float vx, float vy) noexcept {
+  constexpr bool kFast = config::FastMathConfig::kSlipAngle;
+  if (Sqrt<kFast>(vx * vx + vy * vy) < kMinSpeedThreshold) {
     return 0.0f;
   }
-  if (x_[0] < -kMinSpeedThreshold) {
+  if (vx < -kMinSpeedThreshold) {
     return 0.0f;
   }
-  return std::atan2(x_[1], x_[0]);
+  return Atan2<kFast>(vy, vx);
+}
+
+float VehicleEkf::GetSlipAngleRad() const noexcept {
+  return SlipAngleRad(x_[0], x_[1]);
 }
 
 float VehicleEkf::GetSlipAngleDeg() const noexcept {
@@ -262,6 +296,40 @@ float VehicleEkf::GetYawDeg() const noexcept {
 // Вспомогательные функции
 // ═════════════════════════════════════════════════════════════════════════
 
+void VehicleEkf::GetState(float x[4]) const noexcept {
+  memcpy(x, x_, sizeof(x_));
+}
+
+void VehicleEkf::GetCovariance(float P[16]) const noexcept {
+  memcpy(P, P_, sizeof(P_));
+}
+
+void VehicleEkf::TransitionJacobian(const float x[4], float dt,
+                                    float vy_decay_hz, float F[16]) noexcept {
+  if (dt <= 0.0f) {
+    for (int i = 0; i < 16; ++i) F[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+    return;
+  }
+  const float vx = x[0];
+  const float vy = x[1];
+  const float r = x[2];
+  const float vy_damp = 1.0f - vy_decay_hz * dt;
+
+  // F = [ 1,       dt·r,   dt·vy,  0 ]
+  //     [ -dt·r,   vy_dmp, -dt·vx, 0 ]
+  //     [ 0,       0,      1,      0 ]
+  //     [ 0,       0,      dt,     1 ]
+  //
+  // ∂ψ/∂r = dt, остальные частные производные ψ нулевые.
+  const float J[16] = {
+      1.0f,    dt * r,   dt * vy,  0.0f,
+      -dt * r, vy_damp,  -dt * vx, 0.0f,
+      0.0f,    0.0f,     1.0f,     0.0f,
+      0.0f,    0.0f,     dt,       1.0f,
+  };
+  memcpy(F, J, sizeof(J));
+}
+
 float VehicleEkf::WrapAngle(float a) noexcept {
   // Быстрая нормализация в [-π, π]
   while (a >  kPi) a -= 2.0f * kPi;
@@ -2,6 +2,11 @@
 
 #include <cmath>
 #include <cstdint>
+#include <span>
+
+#include "config.hpp"
+#include "fast_math.hpp"
+#include "imu_batch.hpp"
 
 namespace rc_vehicle {
 
@@ -37,6 +42,18 @@ struct VehicleEkfNoiseParams {
   float r_heading{0.01f};
 };
 
+/**
+ * @brief Выходные массивы VehicleEkf::UpdateFromImuBatch.
+ *
+ * Каждый span либо пустой (не записывать), либо размера batch.Size().
+ */
+struct VehicleEkfBatchOutput {
+  std::span<float> vx;        ///< Продольная скорость [м/с]
+  std::span<float> vy;        ///< Боковая скорость [м/с]
+  std::span<float> yaw_rate;  ///< Угловая скорость рыскания [рад/с]
+  std::span<float> yaw_rad;   ///< Курсовой угол [рад]
+};
+
 /**
  * @brief Extended Kalman Filter (EKF) для оценки динамического состояния
  *        RC-машины на основе IMU + магнитометра.
@@ -142,6 +159,36 @@ class VehicleEkf {
   void UpdateFromImu(float ax_g, float ay_g, float az_g, float gz_dps,
                      float dt_sec, float throttle_abs = 0.0f) noexcept;
 
+  /**
+   * @brief Предсказание из UpdateFromImu: Predict(ax_g·g, ay_g·g, dt_sec).
+   *
+   * UpdateFromImu = PredictFromImu + CorrectFromImu. По отдельности —
+   * для RTS-сглаживания (VehicleEkfSmoother), которому нужно состояние
+   * между предсказанием и коррекцией.
+   */
+  void PredictFromImu(float ax_g, float ay_g, float dt_sec) noexcept;
+
+  /** @brief Коррекция из UpdateFromImu: gyro_z + ZUPT (см. UpdateFromImu). */
+  void CorrectFromImu(float ax_g, float ay_g, float az_g, float gz_dps,
+                      float throttle_abs = 0.0f) noexcept;
+
+  /**
+   * @brief Пакетный UpdateFromImu для реплея логов и FIFO.
+   *
+   * Результат бит-в-бит совпадает с поштучными вызовами UpdateFromImu().
+   * Используются batch.ax/ay/az/gz/dt; gx/gy не используются, но должны
+   * иметь ту же длину (ImuBatch::IsValid()). В gz обычно передают
+   * отфильтрованный LPF gyro Z, как в control loop.
+   *
+   * @param batch SoA-массивы семплов
+   * @param throttle_abs |throttle| на семпл для ZUPT gating; пустой — 0
+   * @param out Состояние после каждого семпла (пустые span — не записывать)
+   * @return false если размеры не согласованы (состояние не меняется)
+   */
+  bool UpdateFromImuBatch(const ImuBatch& batch,
+                          std::span<const float> throttle_abs = {},
+                          const VehicleEkfBatchOutput& out = {}) noexcept;
+
   // ─── Доступ к состоянию ───────────────────────────────────────────────
 
   /** Оценка продольной скорости [м/с]. */
@@ -161,7 +208,8 @@ class VehicleEkf {
 
   /** Модуль скорости в горизонтальной плоскости [м/с]. */
   [[nodiscard]] float GetSpeedMs() const noexcept {
-    return std::sqrt(x_[0] * x_[0] + x_[1] * x_[1]);
+    return Sqrt<config::FastMathConfig::kEkfSpeed>(x_[0] * x_[0] +
+                                                   x_[1] * x_[1]);
   }
 
   /** Угол заноса [рад]: β = atan2(vy, vx). При малой скорости — 0. */
@@ -187,6 +235,32 @@ class VehicleEkf {
   /** Установить параметры шума. */
   void SetNoiseParams(NoiseParams params) noexcept { params_ = params; }
 
+  /** Текущие параметры шума. */
+  [[nodiscard]] const NoiseParams& GetNoiseParams() const noexcept {
+    return params_;
+  }
+
+  // ─── Полное состояние (RTS-сглаживание) ──────────────────────────────
+
+  /** Вектор состояния [vx, vy, r, ψ]. */
+  void GetState(float x[4]) const noexcept;
+
+  /** Ковариация P 4×4 (row-major). */
+  void GetCovariance(float P[16]) const noexcept;
+
+  /**
+   * @brief Якобиан F модели Predict в точке x (до предсказания).
+   * dt ≤ 0 — единичная матрица (Predict ничего не делает).
+   */
+  static void TransitionJacobian(const float x[4], float dt,
+                                 float vy_decay_hz, float F[16]) noexcept;
+
+  /** Угол заноса [рад] для скоростей vx, vy (как GetSlipAngleRad). */
+  [[nodiscard]] static float SlipAngleRad(float vx, float vy) noexcept;
+
+  /** Нормализация угла в [-π, π]. */
+  [[nodiscard]] static float WrapAngle(float a) noexcept;
+
  private:
   // Вектор состояния: [vx, vy, r, ψ]
   float x_[4]{0.0f, 0.0f, 0.0f, 0.0f};
@@ -217,9 +291,6 @@ class VehicleEkf {
   static void MatTranspose4x4(const float A[16], float At[16]) noexcept;
   static void SymmetrizeP(float P[16]) noexcept;
 
-  /** Нормализация угла в [-π, π]. */
-  static float WrapAngle(float a) noexcept;
-
   // Границы диагональных элементов P
   static constexpr float kPDiagMax = 1e3f;
   static constexpr float kPDiagMin = 1e-6f;
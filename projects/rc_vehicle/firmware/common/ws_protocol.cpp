@@ -0,0 +1,312 @@
+#include "ws_protocol.hpp"
+
+#include <cstring>
+
+namespace rc_vehicle {
+
+namespace {
+
+constexpr std::string_view kWsGuid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+constexpr std::string_view kHeaderEnd = "\r\n\r\n";
+
+uint32_t Rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+void Sha1Block(uint32_t h[5], const uint8_t* p) {
+  uint32_t w[80];
+  for (int i = 0; i < 16; ++i) {
+    w[i] = (uint32_t{p[4 * i]} << 24) | (uint32_t{p[4 * i + 1]} << 16) |
+           (uint32_t{p[4 * i + 2]} << 8) | uint32_t{p[4 * i + 3]};
+  }
+  for (int i = 16; i < 80; ++i) {
+    w[i] = Rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+  }
+  uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+  for (int i = 0; i < 80; ++i) {
+    uint32_t f, k;
+    if (i < 20) {
+      f = (b & c) | (~b & d);
+      k = 0x5A827999;
+    } else if (i < 40) {
+      f = b ^ c ^ d;
+      k = 0x6ED9EBA1;
+    } else if (i < 60) {
+      f = (b & c) | (b & d) | (c & d);
+      k = 0x8F1BBCDC;
+    } else {
+      f = b ^ c ^ d;
+      k = 0xCA62C1D6;
+    }
+    const uint32_t t = Rotl(a, 5) + f + e + k + w[i];
+    e = d;
+    d = c;
+    c = Rotl(b, 30);
+    b = a;
+    a = t;
+  }
+  h[0] += a;
+  h[1] += b;
+  h[2] += c;
+  h[3] += d;
+  h[4] += e;
+}
+
+char Lower(char c) { return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c; }
+
+bool EqualsNoCase(std::string_view a, std::string_view b) {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (Lower(a[i]) != Lower(b[i])) return false;
+  }
+  return true;
+}
+
+bool ContainsNoCase(std::string_view s, std::string_view what) {
+  for (size_t i = 0; i + what.size() <= s.size(); ++i) {
+    if (EqualsNoCase(s.substr(i, what.size()), what)) return true;
+  }
+  return false;
+}
+
+std::string_view Trim(std::string_view s) {
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+/** Значение заголовка name в блоке заголовков (после стартовой строки). */
+std::string_view HeaderValue(std::string_view head, std::string_view name) {
+  size_t pos = head.find("\r\n");
+  while (pos != std::string_view::npos && pos + 2 < head.size()) {
+    const size_t start = pos + 2;
+    const size_t end = head.find("\r\n", start);
+    const std::string_view line =
+        head.substr(start, end == std::string_view::npos ? end : end - start);
+    const size_t colon = line.find(':');
+    if (colon != std::string_view::npos &&
+        EqualsNoCase(Trim(line.substr(0, colon)), name)) {
+      return Trim(line.substr(colon + 1));
+    }
+    pos = end;
+  }
+  return {};
+}
+
+}  // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Рукопожатие
+// ─────────────────────────────────────────────────────────────────────────────
+
+void Sha1(std::string_view data, uint8_t out[20]) noexcept {
+  uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476,
+                   0xC3D2E1F0};
+  const auto* p = reinterpret_cast<const uint8_t*>(data.data());
+  size_t n = data.size();
+  const uint64_t bits = static_cast<uint64_t>(n) * 8;
+  for (; n >= 64; n -= 64, p += 64) Sha1Block(h, p);
+
+  // Хвост + 0x80 + нули + длина в битах (big-endian) — один или два блока
+  uint8_t tail[128] = {};
+  std::memcpy(tail, p, n);
+  tail[n] = 0x80;
+  const size_t blocks = n + 9 <= 64 ? 1 : 2;
+  for (int i = 0; i < 8; ++i) {
+    tail[blocks * 64 - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+  }
+  for (size_t b = 0; b < blocks; ++b) Sha1Block(h, tail + 64 * b);
+
+  for (int i = 0; i < 5; ++i) {
+    out[4 * i] = static_cast<uint8_t>(h[i] >> 24);
+    out[4 * i + 1] = static_cast<uint8_t>(h[i] >> 16);
+    out[4 * i + 2] = static_cast<uint8_t>(h[i] >> 8);
+    out[4 * i + 3] = static_cast<uint8_t>(h[i]);
+  }
+}
+
+std::string Base64Encode(std::span<const uint8_t> data) {
+  static constexpr char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  out.reserve((data.size() + 2) / 3 * 4);
+  size_t i = 0;
+  for (; i + 3 <= data.size(); i += 3) {
+    const uint32_t v = (uint32_t{data[i]} << 16) |
+                       (uint32_t{data[i + 1]} << 8) | data[i + 2];
+    out += kAlphabet[v >> 18];
+    out += kAlphabet[(v >> 12) & 63];
+    out += kAlphabet[(v >> 6) & 63];
+    out += kAlphabet[v & 63];
+  }
+  if (i < data.size()) {
+    const bool two = i + 1 < data.size();
+    const uint32_t v =
+        (uint32_t{data[i]} << 16) | (two ? uint32_t{data[i + 1]} << 8 : 0);
+    out += kAlphabet[v >> 18];
+    out += kAlphabet[(v >> 12) & 63];
+    out += two ? kAlphabet[(v >> 6) & 63] : '=';
+    out += '=';
+  }
+  return out;
+}
+
+std::string WsAcceptKey(std::string_view client_key) {
+  std::string s(client_key);
+  s += kWsGuid;
+  uint8_t digest[20];
+  Sha1(s, digest);
+  return Base64Encode(digest);
+}
+
+WsHandshakeStatus ParseWsUpgradeRequest(std::string_view data,
+                                        WsUpgradeRequest& out) {
+  const size_t end = data.find(kHeaderEnd);
+  if (end == std::string_view::npos) return WsHandshakeStatus::NeedMore;
+  const std::string_view head = data.substr(0, end + 2);
+  if (!head.starts_with("GET ")) return WsHandshakeStatus::BadRequest;
+  const size_t path_end = head.find(' ', 4);
+  if (path_end == std::string_view::npos) return WsHandshakeStatus::BadRequest;
+
+  out.path = head.substr(4, path_end - 4);
+  out.key = HeaderValue(head, "Sec-WebSocket-Key");
+  out.header_len = end + kHeaderEnd.size();
+  if (!ContainsNoCase(HeaderValue(head, "Upgrade"), "websocket") ||
+      out.key.empty()) {
+    return WsHandshakeStatus::BadRequest;
+  }
+  return WsHandshakeStatus::Ok;
+}
+
+std::string WsUpgradeResponse(std::string_view key) {
+  return "HTTP/1.1 101 Switching Protocols\r\n"
+         "Upgrade: websocket\r\n"
+         "Connection: Upgrade\r\n"
+         "Sec-WebSocket-Accept: " +
+         WsAcceptKey(key) + "\r\n\r\n";
+}
+
+std::string WsClientHandshake(std::string_view host, std::string_view path,
+                              std::string_view key) {
+  std::string req = "GET ";
+  req += path;
+  req += " HTTP/1.1\r\nHost: ";
+  req += host;
+  req +=
+      "\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+      "Sec-WebSocket-Version: 13\r\nSec-WebSocket-Key: ";
+  req += key;
+  req += "\r\n\r\n";
+  return req;
+}
+
+WsHandshakeStatus CheckWsUpgradeResponse(std::string_view data,
+                                         std::string_view key,
+                                         size_t& header_len) {
+  const size_t end = data.find(kHeaderEnd);
+  if (end == std::string_view::npos) return WsHandshakeStatus::NeedMore;
+  const std::string_view head = data.substr(0, end + 2);
+  header_len = end + kHeaderEnd.size();
+  const size_t sp = head.find(' ');
+  if (!head.starts_with("HTTP/1.1") || sp == std::string_view::npos ||
+      !head.substr(sp + 1).starts_with("101") ||
+      HeaderValue(head, "Sec-WebSocket-Accept") != WsAcceptKey(key)) {
+    return WsHandshakeStatus::BadRequest;
+  }
+  return WsHandshakeStatus::Ok;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Кадры
+// ─────────────────────────────────────────────────────────────────────────────
+
+WsFrameStatus DecodeWsFrame(std::span<uint8_t> buf, size_t max_payload,
+                            WsFrame& out) {
+  if (buf.size() < 2) return WsFrameStatus::NeedMore;
+  const uint8_t b0 = buf[0];
+  const uint8_t b1 = buf[1];
+  if ((b0 & 0x70) != 0) return WsFrameStatus::Protocol;  // RSV без расширений
+  const auto opcode = static_cast<WsOpcode>(b0 & 0x0F);
+  const bool fin = (b0 & 0x80) != 0;
+  const bool control = (b0 & 0x08) != 0;
+  switch (opcode) {
+    case WsOpcode::Continuation:
+    case WsOpcode::Text:
+    case WsOpcode::Binary:
+    case WsOpcode::Close:
+    case WsOpcode::Ping:
+    case WsOpcode::Pong:
+      break;
+    default:
+      return WsFrameStatus::Protocol;
+  }
+
+  size_t pos = 2;
+  uint64_t len = b1 & 0x7F;
+  if (len == 126) {
+    if (buf.size() < pos + 2) return WsFrameStatus::NeedMore;
+    len = (uint64_t{buf[2]} << 8) | buf[3];
+    pos += 2;
+  } else if (len == 127) {
+    if (buf.size() < pos + 8) return WsFrameStatus::NeedMore;
+    len = 0;
+    for (int i = 0; i < 8; ++i) len = (len << 8) | buf[2 + i];
+    pos += 8;
+  }
+  // Control-кадры: не фрагментируются, payload ≤ 125 (RFC 6455 §5.5)
+  if (control && (!fin || len > 125)) return WsFrameStatus::Protocol;
+  if (len > max_payload) return WsFrameStatus::TooLarge;
+
+  const bool masked = (b1 & 0x80) != 0;
+  uint8_t mask[4] = {};
+  if (masked) {
+    if (buf.size() < pos + 4) return WsFrameStatus::NeedMore;
+    std::memcpy(mask, buf.data() + pos, 4);
+    pos += 4;
+  }
+  if (buf.size() - pos < len) return WsFrameStatus::NeedMore;
+
+  uint8_t* payload = buf.data() + pos;
+  if (masked) {
+    for (size_t i = 0; i < len; ++i) payload[i] ^= mask[i & 3];
+  }
+  out.opcode = opcode;
+  out.fin = fin;
+  out.masked = masked;
+  out.payload = std::span<const uint8_t>(payload, static_cast<size_t>(len));
+  out.frame_len = pos + static_cast<size_t>(len);
+  return WsFrameStatus::Ok;
+}
+
+void AppendWsFrame(std::string& out, WsOpcode opcode, std::string_view payload,
+                   const uint8_t* mask) {
+  const size_t len = payload.size();
+  out += static_cast<char>(0x80 | static_cast<uint8_t>(opcode));
+  const uint8_t mask_bit = mask ? 0x80 : 0x00;
+  if (len < 126) {
+    out += static_cast<char>(mask_bit | len);
+  } else if (len <= 0xFFFF) {
+    out += static_cast<char>(mask_bit | 126);
+    out += static_cast<char>(len >> 8);
+    out += static_cast<char>(len & 0xFF);
+  } else {
+    out += static_cast<char>(mask_bit | 127);
+    for (int i = 7; i >= 0; --i) {
+      out += static_cast<char>((static_cast<uint64_t>(len) >> (8 * i)) & 0xFF);
+    }
+  }
+  if (!mask) {
+    out += payload;
+    return;
+  }
+  out.append(reinterpret_cast<const char*>(mask), 4);
+  const size_t start = out.size();
+  out += payload;
+  for (size_t i = 0; i < len; ++i) {
+    out[start + i] = static_cast<char>(out[start + i] ^ mask[i & 3]);
+  }
+}
+
+}  // namespace rc_vehicle
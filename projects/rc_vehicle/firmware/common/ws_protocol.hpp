@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+/**
+ * @file ws_protocol.hpp
+ * @brief WebSocket (RFC 6455) без зависимостей: рукопожатие, кадры.
+ *
+ * Для хостовых утилит (telem_relay): на устройстве WebSocket — у
+ * esp_http_server. Только разбор и сборка байтов — сокеты, таймауты и
+ * склейка фрагментов на вызывающем. Платформонезависимо, покрыто
+ * unit-тестами.
+ */
+
+namespace rc_vehicle {
+
+// ═════════════════════════════════════════════════════════════════════════════
+// Рукопожатие
+// ═════════════════════════════════════════════════════════════════════════════
+
+/** SHA-1 (только для Sec-WebSocket-Accept). */
+void Sha1(std::string_view data, uint8_t out[20]) noexcept;
+
+/** Base64 (RFC 4648, с дополнением '='). */
+[[nodiscard]] std::string Base64Encode(std::span<const uint8_t> data);
+
+/** Sec-WebSocket-Accept = base64(SHA-1(key + GUID)). */
+[[nodiscard]] std::string WsAcceptKey(std::string_view client_key);
+
+/** Итог разбора HTTP-запроса Upgrade. */
+enum class WsHandshakeStatus : uint8_t {
+  Ok = 0,
+  NeedMore,   ///< Заголовок ещё не дочитан до пустой строки
+  BadRequest  ///< Не GET / нет Upgrade: websocket / нет ключа
+};
+
+/** Запрос клиента: путь и Sec-WebSocket-Key (указатели в буфер). */
+struct WsUpgradeRequest {
+  std::string_view path;
+  std::string_view key;
+  size_t header_len{0};  ///< Байт до конца заголовка (включая \r\n\r\n)
+};
+
+/** Разобрать запрос Upgrade (заголовки без учёта регистра). */
+[[nodiscard]] WsHandshakeStatus ParseWsUpgradeRequest(std::string_view data,
+                                                      WsUpgradeRequest& out);
+
+/** Ответ 101 Switching Protocols на запрос с ключом key. */
+[[nodiscard]] std::string WsUpgradeResponse(std::string_view key);
+
+/** Запрос клиента к host/path с ключом key (16 байт в base64). */
+[[nodiscard]] std::string WsClientHandshake(std::string_view host,
+                                            std::string_view path,
+                                            std::string_view key);
+
+/**
+ * @brief Проверить ответ сервера: 101 и Sec-WebSocket-Accept для key.
+ * @param[out] header_len Байт заголовка (за ним — первые кадры)
+ */
+[[nodiscard]] WsHandshakeStatus CheckWsUpgradeResponse(std::string_view data,
+                                                       std::string_view key,
+                                                       size_t& header_len);
+
+// ═════════════════════════════════════════════════════════════════════════════
+// Кадры
+// ═════════════════════════════════════════════════════════════════════════════
+
+enum class WsOpcode : uint8_t {
+  Continuation = 0x0,
+  Text = 0x1,
+  Binary = 0x2,
+  Close = 0x8,
+  Ping = 0x9,
+  Pong = 0xA,
+};
+
+/** Итог разбора кадра. */
+enum class WsFrameStatus : uint8_t {
+  Ok = 0,
+  NeedMore,  ///< Кадр не дочитан
+  TooLarge,  ///< Payload больше max_payload
+  Protocol,  ///< RSV-биты, неизвестный opcode, фрагментированный control
+};
+
+/** Разобранный кадр; payload — в буфере разбора (маска уже снята). */
+struct WsFrame {
+  WsOpcode opcode{WsOpcode::Text};
+  bool fin{true};
+  bool masked{false};
+  std::span<const uint8_t> payload;
+  size_t frame_len{0};  ///< Байт кадра целиком (сдвиг к следующему)
+};
+
+/**
+ * @brief Разобрать кадр в начале buf; маска снимается на месте.
+ *
+ * Клиентские кадры обязаны быть с маской, серверные — без (RFC 6455 §5.1):
+ * проверка — на вызывающем по WsFrame::masked.
+ */
+[[nodiscard]] WsFrameStatus DecodeWsFrame(std::span<uint8_t> buf,
+                                          size_t max_payload, WsFrame& out);
+
+/**
+ * @brief Дописать в out кадр с FIN.
+ * @param mask Ключ маски (клиент → сервер) или nullptr (сервер → клиент)
+ */
+void AppendWsFrame(std::string& out, WsOpcode opcode, std::string_view payload,
+                   const uint8_t* mask = nullptr);
+
+}  // namespace rc_vehicle
@@ -0,0 +1,164 @@
+#pragma once
+
+// Сгенерировано tools/gen_yaw_mpc.py — не редактировать вручную.
+//
+// Модель: m=1.6 кг, Iz=0.025 кг·м², lf=0.13 м, lr=0.13 м,
+//         Cf=25.0 Н/рад, Cr=30.0 Н/рад, delta_max=25.0°
+// MPC:    N=50, Ts=2 мс, q_r=1.0, q_vy=0.5, rho=0.25
+
+#include "explicit_mpc.hpp"
+
+namespace rc_vehicle::yaw_mpc {
+
+/// Шаг модели, с (= период control loop): du_max = slew_steering · kTsS
+inline constexpr float kTsS = 0.002f;
+inline constexpr int kSpeedBinCount = 8;
+inline constexpr int kNodesPerBin = 6;
+inline constexpr int kRegionsPerBin = 5;
+
+/** Скорости узлов сетки (м/с), по возрастанию. */
+inline constexpr float kSpeedGridMs[kSpeedBinCount] = {0.5f, 1.0f, 1.5f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+
+inline constexpr ExplicitMpcNode kNodes[kSpeedBinCount][kNodesPerBin] = {
+    // vx = 0.5 м/с
+    {
+        {{-0.117982075f, -0.095962802f, 1.287907f, -0.991055992f, -1.0f}, 0.0f, 1, 5},
+        {{-0.117982075f, -0.095962802f, 1.287907f, 0.00894400844f, 0.0f}, 1.0f, 2, -4},
+        {{0.117982075f, 0.095962802f, -1.287907f, 0.991055992f, -1.0f}, 0.0f, 3, 4},
+        {{0.117982075f, 0.095962802f, -1.287907f, -0.00894400844f, 0.0f}, 1.0f, -1, -5},
+        {{0.0f, 0.0f, 0.0f, -1.0f, 1.0f}, 1.0f, -3, -5},
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 1.0f, -2, -4},
+    },
+    // vx = 1.0 м/с
+    {
+        {{-0.13398781f, -0.122729824f, 0.738656813f, -0.996928614f, -1.0f}, 0.0f, 1, 5},
+        {{-0.13398781f, -0.122729824f, 0.738656813f, 0.00307138557f, 0.0f}, 1.0f, 2, -4},
+        {{0.13398781f, 0.122729824f, -0.738656813f, 0.996928614f, -1.0f}, 0.0f, 3, 4},
+        {{0.13398781f, 0.122729824f, -0.738656813f, -0.00307138557f, 0.0f}, 1.0f, -1, -5},
+        {{0.0f, 0.0f, 0.0f, -1.0f, 1.0f}, 1.0f, -3, -5},
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 1.0f, -2, -4},
+    },
+    // vx = 1.5 м/с
+    {
+        {{-0.131187841f, -0.144775183f, 0.56693151f, -0.998134418f, -1.0f}, 0.0f, 1, 5},
+        {{-0.131187841f, -0.144775183f, 0.56693151f, 0.00186558248f, 0.0f}, 1.0f, 2, -4},
+        {{0.131187841f, 0.144775183f, -0.56693151f, 0.998134418f, -1.0f}, 0.0f, 3, 4},
+        {{0.131187841f, 0.144775183f, -0.56693151f, -0.00186558248f, 0.0f}, 1.0f, -1, -5},
+        {{0.0f, 0.0f, 0.0f, -1.0f, 1.0f}, 1.0f, -3, -5},
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 1.0f, -2, -4},
+    },
+    // vx = 2.0 м/с
+    {
+        {{-0.121664147f, -0.161374251f, 0.485716875f, -0.998601999f, -1.0f}, 0.0f, 1, 5},
+        {{-0.121664147f, -0.161374251f, 0.485716875f, 0.00139800139f, 0.0f}, 1.0f, 2, -4},
+        {{0.121664147f, 0.161374251f, -0.485716875f, 0.998601999f, -1.0f}, 0.0f, 3, 4},
+        {{0.121664147f, 0.161374251f, -0.485716875f, -0.00139800139f, 0.0f}, 1.0f, -1, -5},
+        {{0.0f, 0.0f, 0.0f, -1.0f, 1.0f}, 1.0f, -3, -5},
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 1.0f, -2, -4},
+    },
+    // vx = 3.0 м/с
+    {
+        {{-0.100419432f, -0.183705803f, 0.408658101f, -0.998984771f, -1.0f}, 0.0f, 1, 5},
+        {{-0.100419432f, -0.183705803f, 0.408658101f, 0.00101522892f, 0.0f}, 1.0f, 2, -4},
+        {{0.100419432f, 0.183705803f, -0.408658101f, 0.998984771f, -1.0f}, 0.0f, 3, 4},
+        {{0.100419432f, 0.183705803f, -0.408658101f, -0.00101522892f, 0.0f}, 1.0f, -1, -5},
+        {{0.0f, 0.0f, 0.0f, -1.0f, 1.0f}, 1.0f, -3, -5},
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 1.0f, -2, -4},
+    },
+    // vx = 4.0 м/с
+    {
+        {{-0.0821962503f, -0.197960927f, 0.371704911f, -0.999146774f, -1.0f}, 0.0f, 1, 5},
+        {{-0.0821962503f, -0.197960927f, 0.371704911f, 0.000853225569f, 0.0f}, 1.0f, 2, -4},
+        {{0.0821962503f, 0.197960927f, -0.371704911f, 0.999146774f, -1.0f}, 0.0f, 3, 4},
+        {{0.0821962503f, 0.197960927f, -0.371704911f, -0.000853225569f, 0.0f}, 1.0f, -1, -5},
+        {{0.0f, 0.0f, 0.0f, -1.0f, 1.0f}, 1.0f, -3, -5},
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 1.0f, -2, -4},
+    },
+    // vx = 5.0 м/с
+    {
+        {{-0.0672037207f, -0.208072753f, 0.34970801f, -0.999235891f, -1.0f}, 0.0f, 1, 5},
+        {{-0.0672037207f, -0.208072753f, 0.34970801f, 0.000764109369f, 0.0f}, 1.0f, 2, -4},
+        {{0.0672037207f, 0.208072753f, -0.34970801f, 0.999235891f, -1.0f}, 0.0f, 3, 4},
+        {{0.0672037207f, 0.208072753f, -0.34970801f, -0.000764109369f, 0.0f}, 1.0f, -1, -5},
+        {{0.0f, 0.0f, 0.0f, -1.0f, 1.0f}, 1.0f, -3, -5},
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 1.0f, -2, -4},
+    },
+    // vx = 6.0 м/с
+    {
+        {{-0.0546267405f, -0.215883511f, 0.334716007f, -0.999292871f, -1.0f}, 0.0f, 1, 5},
+        {{-0.0546267405f, -0.215883511f, 0.334716007f, 0.000707129029f, 0.0f}, 1.0f, 2, -4},
+        {{0.0546267405f, 0.215883511f, -0.334716007f, 0.999292871f, -1.0f}, 0.0f, 3, 4},
+        {{0.0546267405f, 0.215883511f, -0.334716007f, -0.000707129029f, 0.0f}, 1.0f, -1, -5},
+        {{0.0f, 0.0f, 0.0f, -1.0f, 1.0f}, 1.0f, -3, -5},
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 1.0f, -2, -4},
+    },
+};
+
+inline constexpr ExplicitMpcRegion kRegions[kSpeedBinCount][kRegionsPerBin] = {
+    // vx = 0.5 м/с
+    {
+        {{-0.117982075f, -0.095962802f, 1.287907f, 0.00894400844f, 0.0f}, 0.0f},  // interior
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 0.0f},  // rate_hi
+        {{0.0f, 0.0f, 0.0f, 1.0f, -1.0f}, 0.0f},  // rate_lo
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 1.0f},  // range_hi
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, -1.0f},  // range_lo
+    },
+    // vx = 1.0 м/с
+    {
+        {{-0.13398781f, -0.122729824f, 0.738656813f, 0.00307138557f, 0.0f}, 0.0f},  // interior
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 0.0f},  // rate_hi
+        {{0.0f, 0.0f, 0.0f, 1.0f, -1.0f}, 0.0f},  // rate_lo
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 1.0f},  // range_hi
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, -1.0f},  // range_lo
+    },
+    // vx = 1.5 м/с
+    {
+        {{-0.131187841f, -0.144775183f, 0.56693151f, 0.00186558248f, 0.0f}, 0.0f},  // interior
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 0.0f},  // rate_hi
+        {{0.0f, 0.0f, 0.0f, 1.0f, -1.0f}, 0.0f},  // rate_lo
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 1.0f},  // range_hi
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, -1.0f},  // range_lo
+    },
+    // vx = 2.0 м/с
+    {
+        {{-0.121664147f, -0.161374251f, 0.485716875f, 0.00139800139f, 0.0f}, 0.0f},  // interior
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 0.0f},  // rate_hi
+        {{0.0f, 0.0f, 0.0f, 1.0f, -1.0f}, 0.0f},  // rate_lo
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 1.0f},  // range_hi
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, -1.0f},  // range_lo
+    },
+    // vx = 3.0 м/с
+    {
+        {{-0.100419432f, -0.183705803f, 0.408658101f, 0.00101522892f, 0.0f}, 0.0f},  // interior
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 0.0f},  // rate_hi
+        {{0.0f, 0.0f, 0.0f, 1.0f, -1.0f}, 0.0f},  // rate_lo
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 1.0f},  // range_hi
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, -1.0f},  // range_lo
+    },
+    // vx = 4.0 м/с
+    {
+        {{-0.0821962503f, -0.197960927f, 0.371704911f, 0.000853225569f, 0.0f}, 0.0f},  // interior
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 0.0f},  // rate_hi
+        {{0.0f, 0.0f, 0.0f, 1.0f, -1.0f}, 0.0f},  // rate_lo
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 1.0f},  // range_hi
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, -1.0f},  // range_lo
+    },
+    // vx = 5.0 м/с
+    {
+        {{-0.0672037207f, -0.208072753f, 0.34970801f, 0.000764109369f, 0.0f}, 0.0f},  // interior
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 0.0f},  // rate_hi
+        {{0.0f, 0.0f, 0.0f, 1.0f, -1.0f}, 0.0f},  // rate_lo
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 1.0f},  // range_hi
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, -1.0f},  // range_lo
+    },
+    // vx = 6.0 м/с
+    {
+        {{-0.0546267405f, -0.215883511f, 0.334716007f, 0.000707129029f, 0.0f}, 0.0f},  // interior
+        {{0.0f, 0.0f, 0.0f, 1.0f, 1.0f}, 0.0f},  // rate_hi
+        {{0.0f, 0.0f, 0.0f, 1.0f, -1.0f}, 0.0f},  // rate_lo
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 1.0f},  // range_hi
+        {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, -1.0f},  // range_lo
+    },
+};
+
+}  // namespace rc_vehicle::yaw_mpc
@@ -7,6 +7,7 @@
 #include "freertos/task.h"
 #include "lwip/err.h"
 #include "lwip/sockets.h"
+#include "mem_monitor.hpp"
 
 static const char* TAG = "dns_server";
 
@@ -108,5 +109,6 @@ esp_err_t DnsServerStart(uint32_t ap_ip) {
   if (ret != pdPASS) {
     return ESP_FAIL;
   }
+  MemMonitorRegisterTask("dns_srv", DNS_TASK_STACK);
   return ESP_OK;
 }
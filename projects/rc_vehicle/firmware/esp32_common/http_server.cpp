@@ -4,12 +4,23 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <array>
+
 #include "cJSON.h"
 #include "config.hpp"
 #include "crash_logger.hpp"
 #include "esp_http_server.h"
 #include "esp_log.h"
+#include "esp_ota_ops.h"
+#include "freertos/FreeRTOS.h"
+#include "json_arena.hpp"
+#include "json_reader.hpp"
+#include "mem_monitor.hpp"
+#include "ota_updater.hpp"
+#include "pc_sampler.hpp"
 #include "telemetry_event_log.hpp"
+#include "telemetry_json.hpp"
 #include "telemetry_log.hpp"
 #include "vehicle_control.hpp"
 #include "wifi_ap.hpp"
@@ -19,6 +30,14 @@ static httpd_handle_t server_handle = NULL;
 
 httpd_handle_t HttpServerGetHandle(void) { return server_handle; }
 
+// Арена cJSON задачи httpd: все URI-обработчики (и WS-команды) выполняются
+// в одной задаче, поэтому одной арены достаточно.
+static rc_vehicle::StaticBumpArena<
+    rc_vehicle::config::JsonArenaConfig::kHttpdBytes>
+    s_json_arena;
+
+rc_vehicle::BumpArena& HttpServerJsonArena(void) { return s_json_arena; }
+
 // Веб-ресурсы (HTML/CSS/JS) вшиваются в прошивку через #embed.
 // Требование: GCC с поддержкой C23 #embed (обычно GCC 15+).
 static const unsigned char INDEX_HTML[] = {
@@ -505,6 +524,7 @@ static esp_err_t SendWifiStatusJson(httpd_req_t* req) {
   WiFiStaStatus sta = {};
   (void)WiFiStaGetStatus(&sta);
 
+  rc_vehicle::JsonArenaScope arena(s_json_arena);
   cJSON* root = cJSON_CreateObject();
   if (!root) {
     httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR,
@@ -540,7 +560,7 @@ static esp_err_t SendWifiStatusJson(httpd_req_t* req) {
 
   httpd_resp_set_type(req, "application/json");
   httpd_resp_send(req, json_str, HTTPD_RESP_USE_STRLEN);
-  free(json_str);
+  cJSON_free(json_str);
   return ESP_OK;
 }
 
@@ -583,25 +603,22 @@ static esp_err_t wifi_sta_connect_handler(httpd_req_t* req) {
     return ESP_FAIL;
   }
 
-  cJSON* json = cJSON_Parse(body);
-  if (!json) {
+  std::array<rc_vehicle::JsonToken, 16> tokens;
+  auto parsed = rc_vehicle::JsonParseInSitu(body, strlen(body), tokens);
+  if (!rc_vehicle::IsOk(parsed)) {
     httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid JSON");
     return ESP_FAIL;
   }
+  const rc_vehicle::JsonValue json = rc_vehicle::GetValue(parsed);
 
-  const cJSON* ssid = cJSON_GetObjectItem(json, "ssid");
-  const cJSON* password = cJSON_GetObjectItem(json, "password");
-  const cJSON* save = cJSON_GetObjectItem(json, "save");
-
-  const char* ssid_str =
-      (ssid && cJSON_IsString(ssid)) ? ssid->valuestring : "";
-  const char* pass_str =
-      (password && cJSON_IsString(password)) ? password->valuestring : "";
+  const char* ssid_str = "";
+  const char* pass_str = "";
   bool save_cfg = true;
-  if (save && cJSON_IsBool(save)) save_cfg = cJSON_IsTrue(save);
+  json.Read("ssid", ssid_str);
+  json.Read("password", pass_str);
+  json.Read("save", save_cfg);
 
   (void)WiFiStaConnect(ssid_str, pass_str, save_cfg);
-  cJSON_Delete(json);
 
   return SendWifiStatusJson(req);
 }
@@ -610,11 +627,10 @@ static esp_err_t wifi_sta_disconnect_handler(httpd_req_t* req) {
   char body[128];
   bool forget = false;
   if (ReadJsonBody(req, body, sizeof(body)) == ESP_OK && body[0] != '\0') {
-    cJSON* json = cJSON_Parse(body);
-    if (json) {
-      const cJSON* f = cJSON_GetObjectItem(json, "forget");
-      if (f && cJSON_IsBool(f)) forget = cJSON_IsTrue(f);
-      cJSON_Delete(json);
+    std::array<rc_vehicle::JsonToken, 8> tokens;
+    auto parsed = rc_vehicle::JsonParseInSitu(body, strlen(body), tokens);
+    if (rc_vehicle::IsOk(parsed)) {
+      rc_vehicle::GetValue(parsed).Read("forget", forget);
     }
   }
 
@@ -636,6 +652,7 @@ static esp_err_t wifi_scan_handler(httpd_req_t* req) {
     return ESP_FAIL;
   }
 
+  rc_vehicle::JsonArenaScope arena(s_json_arena);
   cJSON* root = cJSON_CreateObject();
   if (!root) {
     httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR,
@@ -674,7 +691,7 @@ static esp_err_t wifi_scan_handler(httpd_req_t* req) {
 
   httpd_resp_set_type(req, "application/json");
   httpd_resp_send(req, json_str, HTTPD_RESP_USE_STRLEN);
-  free(json_str);
+  cJSON_free(json_str);
   return ESP_OK;
 }
 
@@ -836,10 +853,381 @@ static esp_err_t log_bin_handler(httpd_req_t* req) {
   return ESP_OK;
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Incremental log sync: GET /api/log_since?seq=N[&max=M]
+//
+// Format (little-endian): TelemetryLogSinceHeader (48 байт, telemetry_log.hpp)
+// + frame_count × frame_size байт кадров с seq first_seq, first_seq + 1, ...
+// Клиент хранит next_seq и раз в секунду забирает только новые кадры; при
+// next_seq < head_seq — сразу следующий запрос. flags & kLogSinceGap —
+// кольцо вытеснило dropped кадров, локальная копия с разрывом.
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// Целочисленный параметр query-строки; default_value при отсутствии
+static uint64_t query_u64(const char* query, const char* key,
+                          uint64_t default_value) {
+  char value[24] = {};
+  if (!query ||
+      httpd_query_key_value(query, key, value, sizeof(value)) != ESP_OK) {
+    return default_value;
+  }
+  char* end = nullptr;
+  const unsigned long long v = strtoull(value, &end, 10);
+  return (end != value && *end == '\0') ? v : default_value;
+}
+
+static esp_err_t log_since_handler(httpd_req_t* req) {
+  using Cfg = config::TelemetryLogConfig;
+
+  char query[64] = {};
+  const bool has_query =
+      httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK;
+  const uint64_t seq = query_u64(has_query ? query : nullptr, "seq", 0);
+  const size_t max_frames = static_cast<size_t>(
+      std::min<uint64_t>(query_u64(has_query ? query : nullptr, "max",
+                                   Cfg::kSinceMaxHttpFrames),
+                         Cfg::kSinceMaxHttpFrames));
+
+  // Первая порция задаёт first_seq / dropped, head — число кадров ответа
+  constexpr size_t kFrameBatch = 32;
+  TelemetryLogFrame frame_batch[kFrameBatch];
+  const rc_vehicle::TelemetryLogSpan span =
+      VehicleControlReadLogSince(seq, frame_batch,
+                                 std::min(kFrameBatch, max_frames),
+                                 Cfg::kSinceGapSkipFrames);
+  const size_t total = static_cast<size_t>(std::min<uint64_t>(
+      span.head_seq - span.first_seq, max_frames));
+  const rc_vehicle::TelemetryLogSinceHeader header =
+      rc_vehicle::MakeLogSinceHeader(span, static_cast<uint32_t>(total));
+
+  httpd_resp_set_type(req, "application/octet-stream");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+  esp_err_t err = httpd_resp_send_chunk(
+      req, reinterpret_cast<const char*>(&header), sizeof(header));
+  if (err != ESP_OK) return err;
+
+  size_t sent = 0;
+  size_t filled = span.count;
+  while (true) {
+    if (filled > 0) {
+      err = httpd_resp_send_chunk(req,
+                                  reinterpret_cast<const char*>(frame_batch),
+                                  filled * sizeof(TelemetryLogFrame));
+      if (err != ESP_OK) return err;
+      sent += filled;
+    }
+    if (sent >= total) break;
+
+    const uint64_t next = span.first_seq + sent;
+    const rc_vehicle::TelemetryLogSpan more = VehicleControlReadLogSince(
+        next, frame_batch, std::min(kFrameBatch, total - sent), 0);
+    if (more.first_seq != next || more.count == 0) {
+      // Писатель догнал курсор (или лог очищен) — заголовок уже не верен;
+      // разрыв соединения, клиент повторит запрос с тем же seq
+      ESP_LOGW(TAG, "log_since: ring overran stream at seq %llu",
+               static_cast<unsigned long long>(next));
+      return ESP_FAIL;
+    }
+    filled = more.count;
+  }
+
+  httpd_resp_send_chunk(req, nullptr, 0);
+  ESP_LOGD(TAG, "log_since: seq %llu -> %zu frames (dropped %llu)",
+           static_cast<unsigned long long>(seq), total,
+           static_cast<unsigned long long>(span.dropped));
+  return ESP_OK;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Telemetry frame schema: GET /api/log/schema
+//
+// {"frame_size":136,"fields":[{"name","type","offset","unit"}, ...]} —
+// генерируется из реестра RC_TELEMETRY_LOG_FIELDS (telemetry_fields.hpp),
+// клиенты декодируют log.bin по нему вместо захардкоженных смещений.
+// ─────────────────────────────────────────────────────────────────────────────
+
+static esp_err_t log_schema_handler(httpd_req_t* req) {
+  rc_vehicle::JsonArenaScope arena(s_json_arena);
+  cJSON* schema = rc_vehicle::BuildLogSchemaJson();
+  char* str = schema ? cJSON_PrintUnformatted(schema) : nullptr;
+  cJSON_Delete(schema);
+  if (!str) {
+    httpd_resp_send_500(req);
+    return ESP_FAIL;
+  }
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+  httpd_resp_send(req, str, HTTPD_RESP_USE_STRLEN);
+  cJSON_free(str);
+  return ESP_OK;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Memory: GET /api/mem
+//
+// {"interval_ms","samples","heap":[{"region","total","free","min_free",
+// "largest","min_largest","frag_pct"}],"tasks":[{"name","stack","min_free",
+// "peak","recommended","reclaim","alive"}],"reclaim_bytes"} — опрос прямо
+// перед ответом (mem_monitor.hpp).
+// ─────────────────────────────────────────────────────────────────────────────
+
+static esp_err_t mem_handler(httpd_req_t* req) {
+  rc_vehicle::JsonArenaScope arena(s_json_arena);
+  MemMonitorSample();
+  cJSON* root = MemMonitorBuildJson();
+  char* str = root ? cJSON_PrintUnformatted(root) : nullptr;
+  cJSON_Delete(root);
+  if (!str) {
+    httpd_resp_send_500(req);
+    return ESP_FAIL;
+  }
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+  httpd_resp_send(req, str, HTTPD_RESP_USE_STRLEN);
+  cJSON_free(str);
+  return ESP_OK;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Firmware update: POST /api/ota   — тело: образ tools/ota_pack.py
+//                  GET  /api/ota/status
+//
+// Тело читается порциями и передаётся ota_task (низкий приоритет), которая
+// распаковывает и пишет образ в неактивный слот. Отказ (409), если машина
+// движется или обновление уже идёт; после успеха — перезагрузка через 1 с.
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void SendOtaReply(httpd_req_t* req, const char* status,
+                         rc_vehicle::OtaError error) {
+  char buf[96];
+  snprintf(buf, sizeof(buf), "{\"ok\":%s,\"error\":\"%s\"}",
+           error == rc_vehicle::OtaError::None ? "true" : "false",
+           rc_vehicle::OtaErrorName(error));
+  httpd_resp_set_status(req, status);
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_send(req, buf, HTTPD_RESP_USE_STRLEN);
+}
+
+static esp_err_t ota_post_handler(httpd_req_t* req) {
+  using rc_vehicle::OtaError;
+  const OtaError begin_err = OtaUpdaterBegin();
+  if (begin_err != OtaError::None) {
+    SendOtaReply(req, "409 Conflict", begin_err);
+    return ESP_OK;
+  }
+
+  uint8_t buf[rc_vehicle::config::OtaConfig::kRecvChunkBytes];
+  size_t remaining = req->content_len;
+  while (remaining > 0) {
+    const int n = httpd_req_recv(req, reinterpret_cast<char*>(buf),
+                                 std::min(remaining, sizeof(buf)));
+    if (n == HTTPD_SOCK_ERR_TIMEOUT) continue;
+    if (n <= 0) {
+      OtaUpdaterCancel();
+      return ESP_FAIL;  // Соединение оборвано — ответ некому отправлять
+    }
+    remaining -= static_cast<size_t>(n);
+    if (!OtaUpdaterPush(buf, static_cast<size_t>(n))) break;
+  }
+
+  // При ошибке задача OTA уже завершила сессию — End() вернёт её причину
+  if (remaining > 0) OtaUpdaterCancel();
+  const OtaError err = OtaUpdaterEnd();
+  const char* status = "200 OK";
+  if (err == OtaError::Moving || err == OtaError::Busy) {
+    status = "409 Conflict";
+  } else if (err == OtaError::SinkFailed || err == OtaError::Aborted) {
+    status = "500 Internal Server Error";
+  } else if (err != OtaError::None) {
+    status = "400 Bad Request";
+  }
+  SendOtaReply(req, status, err);
+  return ESP_OK;
+}
+
+static esp_err_t ota_status_handler(httpd_req_t* req) {
+  static const char* const kStates[] = {"idle", "receiving", "done",
+                                        "failed"};
+  const OtaUpdaterStatus st = OtaUpdaterGetStatus();
+  const esp_partition_t* running = esp_ota_get_running_partition();
+  char buf[320];
+  snprintf(buf, sizeof(buf),
+           "{\"state\":\"%s\",\"error\":\"%s\",\"received\":%u,"
+           "\"payload_size\":%u,\"written\":%u,\"raw_size\":%u,"
+           "\"build_id\":%u,\"max_write_us\":%u,\"pending_verify\":%s,"
+           "\"running\":\"%s\"}",
+           kStates[static_cast<size_t>(st.state)],
+           rc_vehicle::OtaErrorName(st.error),
+           static_cast<unsigned>(st.payload_received),
+           static_cast<unsigned>(st.payload_size),
+           static_cast<unsigned>(st.raw_written),
+           static_cast<unsigned>(st.raw_size),
+           static_cast<unsigned>(st.build_id),
+           static_cast<unsigned>(st.max_write_us),
+           st.pending_verify ? "true" : "false",
+           running ? running->label : "");
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+  httpd_resp_send(req, buf, HTTPD_RESP_USE_STRLEN);
+  return ESP_OK;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// PC-sampling profiler: POST /api/profile?action=start[&hz=N][&depth=D]
+//                       POST /api/profile?action=stop
+//                       GET  /api/profile/status
+//                       GET  /api/profile.bin  (после stop)
+//
+// profile.bin (little-endian): PcProfileHeader (36 байт, pc_profile.hpp),
+// entry_count × PcProfileEntry обоих ядер, task_count × PcProfileTask.
+// Символизация и folded stacks — tools/pc_profile.py.
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void SendProfileStatus(httpd_req_t* req, const char* status,
+                              esp_err_t err) {
+  const PcSamplerStatus st = PcSamplerGetStatus();
+  char buf[256];
+  snprintf(buf, sizeof(buf),
+           "{\"ok\":%s,\"error\":\"%s\",\"running\":%s,\"hz\":%u,"
+           "\"depth\":%u,\"cores\":%u,\"samples\":%u,\"dropped\":%u,"
+           "\"entries\":%u,\"capacity\":%u,\"duration_ms\":%u}",
+           err == ESP_OK ? "true" : "false",
+           err == ESP_OK ? "" : esp_err_to_name(err),
+           st.running ? "true" : "false", static_cast<unsigned>(st.hz),
+           static_cast<unsigned>(st.depth), static_cast<unsigned>(st.cores),
+           static_cast<unsigned>(st.samples),
+           static_cast<unsigned>(st.dropped),
+           static_cast<unsigned>(st.entries),
+           static_cast<unsigned>(st.capacity),
+           static_cast<unsigned>(st.duration_ms));
+  httpd_resp_set_status(req, status);
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+  httpd_resp_send(req, buf, HTTPD_RESP_USE_STRLEN);
+}
+
+static esp_err_t profile_post_handler(httpd_req_t* req) {
+  using Cfg = rc_vehicle::config::PcProfilerConfig;
+  char query[64] = {};
+  char action[8] = {};
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK ||
+      httpd_query_key_value(query, "action", action, sizeof(action)) !=
+          ESP_OK) {
+    SendProfileStatus(req, "400 Bad Request", ESP_ERR_INVALID_ARG);
+    return ESP_OK;
+  }
+
+  esp_err_t err = ESP_ERR_INVALID_ARG;
+  if (strcmp(action, "start") == 0) {
+    const uint64_t hz = query_u64(query, "hz", Cfg::kDefaultHz);
+    const uint64_t depth =
+        query_u64(query, "depth", rc_vehicle::kPcProfileMaxDepth);
+    err = PcSamplerStart(
+        static_cast<uint32_t>(std::min<uint64_t>(hz, Cfg::kMaxHz)),
+        static_cast<uint8_t>(
+            std::min<uint64_t>(depth, rc_vehicle::kPcProfileMaxDepth)));
+  } else if (strcmp(action, "stop") == 0) {
+    err = PcSamplerStop();
+  }
+
+  const char* status = "200 OK";
+  if (err == ESP_ERR_INVALID_ARG) {
+    status = "400 Bad Request";
+  } else if (err == ESP_ERR_INVALID_STATE) {
+    status = "409 Conflict";
+  } else if (err != ESP_OK) {
+    status = "500 Internal Server Error";
+  }
+  SendProfileStatus(req, status, err);
+  return ESP_OK;
+}
+
+static esp_err_t profile_status_handler(httpd_req_t* req) {
+  SendProfileStatus(req, "200 OK", ESP_OK);
+  return ESP_OK;
+}
+
+static esp_err_t profile_bin_handler(httpd_req_t* req) {
+  using rc_vehicle::PcProfileEntry;
+  using rc_vehicle::PcProfileTable;
+  using rc_vehicle::PcProfileTask;
+
+  const PcSamplerStatus st = PcSamplerGetStatus();
+  if (st.running) {
+    // Таблицы пишет ISR — выгрузка только после stop
+    SendProfileStatus(req, "409 Conflict", ESP_ERR_INVALID_STATE);
+    return ESP_OK;
+  }
+
+  // Имена задач: задача могла семплироваться на обоих ядрах
+  constexpr size_t kMaxTasks =
+      PcProfileTable::kMaxTasks * portNUM_PROCESSORS;
+  PcProfileTask tasks[kMaxTasks];
+  size_t task_count = 0;
+  for (size_t core = 0; core < st.cores; ++core) {
+    const PcProfileTable* table = PcSamplerTable(core);
+    if (!table) continue;
+    for (size_t i = 0; i < table->TaskCount(); ++i) {
+      const PcProfileTask& t = table->Task(i);
+      const bool seen = std::any_of(
+          tasks, tasks + task_count,
+          [&](const PcProfileTask& x) { return x.task == t.task; });
+      if (!seen && task_count < kMaxTasks) tasks[task_count++] = t;
+    }
+  }
+
+  rc_vehicle::PcProfileHeader header;
+  header.entry_count = st.entries;
+  header.task_count = static_cast<uint16_t>(task_count);
+  header.samples = st.samples;
+  header.dropped = st.dropped;
+  header.hz = st.hz;
+  header.duration_ms = st.duration_ms;
+  header.cores = st.cores;
+
+  httpd_resp_set_type(req, "application/octet-stream");
+  httpd_resp_set_hdr(req, "Content-Disposition",
+                     "attachment; filename=\"profile.bin\"");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+  esp_err_t err = httpd_resp_send_chunk(
+      req, reinterpret_cast<const char*>(&header), sizeof(header));
+  if (err != ESP_OK) return err;
+
+  constexpr size_t kEntryBatch = 32;
+  PcProfileEntry batch[kEntryBatch];
+  size_t filled = 0;
+  auto flush = [&]() {
+    if (filled > 0 && err == ESP_OK) {
+      err = httpd_resp_send_chunk(req, reinterpret_cast<const char*>(batch),
+                                  filled * sizeof(PcProfileEntry));
+    }
+    filled = 0;
+  };
+  for (size_t core = 0; core < st.cores; ++core) {
+    const PcProfileTable* table = PcSamplerTable(core);
+    if (!table) continue;
+    table->ForEach([&](const PcProfileEntry& e) {
+      batch[filled++] = e;
+      if (filled == kEntryBatch) flush();
+    });
+  }
+  flush();
+  if (err != ESP_OK) return err;
+
+  err = httpd_resp_send_chunk(req, reinterpret_cast<const char*>(tasks),
+                              task_count * sizeof(PcProfileTask));
+  if (err != ESP_OK) return err;
+  httpd_resp_send_chunk(req, nullptr, 0);
+  ESP_LOGI(TAG, "Profile download: %u stacks, %u samples, %zu tasks",
+           static_cast<unsigned>(st.entries),
+           static_cast<unsigned>(st.samples), task_count);
+  return ESP_OK;
+}
+
 esp_err_t HttpServerInit(void) {
   httpd_config_t config = HTTPD_DEFAULT_CONFIG();
   config.server_port = HTTP_SERVER_PORT;
-  config.max_uri_handlers = 18;
+  config.max_uri_handlers = 28;
   config.stack_size = 8192;
   config.max_open_sockets =
       5;  // Достаточно для 1 WS + 4 HTTP; httpd использует ещё 2 внутренних
@@ -957,6 +1345,32 @@ esp_err_t HttpServerInit(void) {
     };
     httpd_register_uri_handler(server_handle, &log_bin_uri);
 
+    httpd_uri_t log_since_uri = {
+        .uri = "/api/log_since",
+        .method = HTTP_GET,
+        .handler = log_since_handler,
+        .user_ctx = NULL,
+#if CONFIG_HTTPD_WS_SUPPORT
+        .is_websocket = false,
+        .handle_ws_control_frames = false,
+        .supported_subprotocol = NULL,
+#endif
+    };
+    httpd_register_uri_handler(server_handle, &log_since_uri);
+
+    httpd_uri_t log_schema_uri = {
+        .uri = "/api/log/schema",
+        .method = HTTP_GET,
+        .handler = log_schema_handler,
+        .user_ctx = NULL,
+#if CONFIG_HTTPD_WS_SUPPORT
+        .is_websocket = false,
+        .handle_ws_control_frames = false,
+        .supported_subprotocol = NULL,
+#endif
+    };
+    httpd_register_uri_handler(server_handle, &log_schema_uri);
+
     httpd_uri_t crash_json_get_uri = {
         .uri = "/api/crash.json",
         .method = HTTP_GET,
@@ -983,6 +1397,84 @@ esp_err_t HttpServerInit(void) {
     };
     httpd_register_uri_handler(server_handle, &crash_json_delete_uri);
 
+    httpd_uri_t ota_post_uri = {
+        .uri = "/api/ota",
+        .method = HTTP_POST,
+        .handler = ota_post_handler,
+        .user_ctx = NULL,
+#if CONFIG_HTTPD_WS_SUPPORT
+        .is_websocket = false,
+        .handle_ws_control_frames = false,
+        .supported_subprotocol = NULL,
+#endif
+    };
+    httpd_register_uri_handler(server_handle, &ota_post_uri);
+
+    httpd_uri_t ota_status_uri = {
+        .uri = "/api/ota/status",
+        .method = HTTP_GET,
+        .handler = ota_status_handler,
+        .user_ctx = NULL,
+#if CONFIG_HTTPD_WS_SUPPORT
+        .is_websocket = false,
+        .handle_ws_control_frames = false,
+        .supported_subprotocol = NULL,
+#endif
+    };
+    httpd_register_uri_handler(server_handle, &ota_status_uri);
+
+    httpd_uri_t profile_post_uri = {
+        .uri = "/api/profile",
+        .method = HTTP_POST,
+        .handler = profile_post_handler,
+        .user_ctx = NULL,
+#if CONFIG_HTTPD_WS_SUPPORT
+        .is_websocket = false,
+        .handle_ws_control_frames = false,
+        .supported_subprotocol = NULL,
+#endif
+    };
+    httpd_register_uri_handler(server_handle, &profile_post_uri);
+
+    httpd_uri_t profile_status_uri = {
+        .uri = "/api/profile/status",
+        .method = HTTP_GET,
+        .handler = profile_status_handler,
+        .user_ctx = NULL,
+#if CONFIG_HTTPD_WS_SUPPORT
+        .is_websocket = false,
+        .handle_ws_control_frames = false,
+        .supported_subprotocol = NULL,
+#endif
+    };
+    httpd_register_uri_handler(server_handle, &profile_status_uri);
+
+    httpd_uri_t profile_bin_uri = {
+        .uri = "/api/profile.bin",
+        .method = HTTP_GET,
+        .handler = profile_bin_handler,
+        .user_ctx = NULL,
+#if CONFIG_HTTPD_WS_SUPPORT
+        .is_websocket = false,
+        .handle_ws_control_frames = false,
+        .supported_subprotocol = NULL,
+#endif
+    };
+    httpd_register_uri_handler(server_handle, &profile_bin_uri);
+
+    httpd_uri_t mem_uri = {
+        .uri = "/api/mem",
+        .method = HTTP_GET,
+        .handler = mem_handler,
+        .user_ctx = NULL,
+#if CONFIG_HTTPD_WS_SUPPORT
+        .is_websocket = false,
+        .handle_ws_control_frames = false,
+        .supported_subprotocol = NULL,
+#endif
+    };
+    httpd_register_uri_handler(server_handle, &mem_uri);
+
     // Captive portal probes (iOS/Android/Windows/macOS).
     httpd_uri_t captive_android_uri = {
         .uri = "/generate_204",
@@ -1062,6 +1554,8 @@ esp_err_t HttpServerInit(void) {
     };
     httpd_register_uri_handler(server_handle, &captive_redirect_uri);
 
+    // Стек задачи httpd: на нём и буфер приёма WS (WS_RX_BUFFER_SIZE)
+    MemMonitorRegisterTask("httpd", config.stack_size);
     ESP_LOGI(TAG, "HTTP server started");
     return ESP_OK;
   }
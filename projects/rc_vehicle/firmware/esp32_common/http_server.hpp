@@ -2,6 +2,7 @@
 
 #include "esp_err.h"
 #include "esp_http_server.h"
+#include "json_arena.hpp"
 
 /**
  * Инициализация HTTP сервера для раздачи веб-интерфейса
@@ -14,3 +15,10 @@ esp_err_t HttpServerInit(void);
  * @return httpd_handle_t или NULL если сервер не запущен
  */
 httpd_handle_t HttpServerGetHandle(void);
+
+/**
+ * Арена cJSON задачи httpd (json_arena.hpp). Обработчики, вызываемые из
+ * задачи httpd (WS-команды), открывают на ней JsonArenaScope на время
+ * запроса.
+ */
+rc_vehicle::BumpArena& HttpServerJsonArena(void);
@@ -0,0 +1,256 @@
+#include "mem_monitor.hpp"
+
+#include <cstring>
+
+#include "config.hpp"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sdkconfig.h"
+
+static const char* TAG = "mem_mon";
+
+using rc_vehicle::HeapRegion;
+using rc_vehicle::HeapSample;
+using rc_vehicle::MemStats;
+using rc_vehicle::StackAdvice;
+using rc_vehicle::StackStats;
+using Cfg = rc_vehicle::config::MemMonitorConfig;
+
+// Таблицу пишут регистрация (любая задача) и опрос (mem_mon, httpd)
+static MemStats s_stats;
+static portMUX_TYPE s_stats_mux = portMUX_INITIALIZER_UNLOCKED;
+static bool s_low_warned[MemStats::kMaxTasks] = {};
+static bool s_started = false;
+
+static constexpr uint32_t kRegionCaps[rc_vehicle::kHeapRegionCount] = {
+    MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT,
+    MALLOC_CAP_DMA,
+    MALLOC_CAP_SPIRAM,
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Опрос
+// ─────────────────────────────────────────────────────────────────────────────
+
+void MemMonitorRegisterTask(const char* name, uint32_t stack_bytes) {
+  taskENTER_CRITICAL(&s_stats_mux);
+  const bool ok = s_stats.RegisterTask(name, stack_bytes);
+  taskEXIT_CRITICAL(&s_stats_mux);
+  if (!ok) ESP_LOGW(TAG, "Task table full, '%s' not monitored", name);
+}
+
+void MemMonitorSample() {
+  // Имена — копией: xTaskGetHandle и high-water вне критической секции
+  char names[MemStats::kMaxTasks][sizeof(StackStats::name)];
+  taskENTER_CRITICAL(&s_stats_mux);
+  const size_t count = s_stats.TaskCount();
+  for (size_t i = 0; i < count; ++i) {
+    memcpy(names[i], s_stats.Task(i).name, sizeof(names[i]));
+  }
+  taskEXIT_CRITICAL(&s_stats_mux);
+
+  // 0 — задачи нет (удалена или ещё не создана); у живой запас > 0
+  uint32_t free_bytes[MemStats::kMaxTasks];
+  for (size_t i = 0; i < count; ++i) {
+    TaskHandle_t task = xTaskGetHandle(names[i]);
+    // В ESP-IDF StackType_t — байт: high-water сразу в байтах
+    free_bytes[i] = task ? uxTaskGetStackHighWaterMark(task) : 0;
+  }
+
+  HeapSample heaps[rc_vehicle::kHeapRegionCount];
+  for (size_t r = 0; r < rc_vehicle::kHeapRegionCount; ++r) {
+    multi_heap_info_t info = {};
+    heap_caps_get_info(&info, kRegionCaps[r]);
+    heaps[r].total = static_cast<uint32_t>(info.total_free_bytes +
+                                           info.total_allocated_bytes);
+    heaps[r].free = static_cast<uint32_t>(info.total_free_bytes);
+    heaps[r].largest_block = static_cast<uint32_t>(info.largest_free_block);
+    heaps[r].min_free = static_cast<uint32_t>(info.minimum_free_bytes);
+  }
+
+  taskENTER_CRITICAL(&s_stats_mux);
+  for (size_t i = 0; i < count; ++i) {
+    if (free_bytes[i] > 0) {
+      s_stats.UpdateStack(i, free_bytes[i]);
+    } else {
+      s_stats.MarkGone(i);
+    }
+  }
+  for (size_t r = 0; r < rc_vehicle::kHeapRegionCount; ++r) {
+    s_stats.UpdateHeap(static_cast<HeapRegion>(r), heaps[r]);
+  }
+  s_stats.NoteSample();
+  taskEXIT_CRITICAL(&s_stats_mux);
+
+  for (size_t i = 0; i < count; ++i) {
+    if (free_bytes[i] > 0 && free_bytes[i] < Cfg::kLowStackFreeBytes &&
+        !s_low_warned[i]) {
+      s_low_warned[i] = true;
+      ESP_LOGW(TAG, "Stack of '%s' nearly exhausted: %u bytes left",
+               names[i], static_cast<unsigned>(free_bytes[i]));
+    }
+  }
+}
+
+MemStats MemMonitorGetStats() {
+  taskENTER_CRITICAL(&s_stats_mux);
+  MemStats copy = s_stats;
+  taskEXIT_CRITICAL(&s_stats_mux);
+  return copy;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Отчёты
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void LogSummary(const MemStats& stats) {
+  const rc_vehicle::HeapStats& in = stats.Heap(HeapRegion::Internal);
+  const rc_vehicle::HeapStats& ps = stats.Heap(HeapRegion::Psram);
+  char psram[64] = "psram n/a";
+  if (ps.present) {
+    snprintf(psram, sizeof(psram), "psram free=%u min=%u",
+             static_cast<unsigned>(ps.last.free),
+             static_cast<unsigned>(ps.min_free));
+  }
+  const size_t tight = stats.TightestTask();
+  char stack[48] = "";
+  if (tight < stats.TaskCount()) {
+    const StackStats& t = stats.Task(tight);
+    snprintf(stack, sizeof(stack), "  tightest %s %u/%u", t.name,
+             static_cast<unsigned>(t.min_free_bytes),
+             static_cast<unsigned>(t.stack_bytes));
+  }
+  ESP_LOGI(TAG,
+           "MEM: internal free=%u min=%u largest=%u (frag %u%%)  %s%s  "
+           "reclaim=%u",
+           static_cast<unsigned>(in.last.free),
+           static_cast<unsigned>(in.min_free),
+           static_cast<unsigned>(in.last.largest_block),
+           static_cast<unsigned>(rc_vehicle::FragmentationPct(
+               in.last.free, in.last.largest_block)),
+           psram, stack, static_cast<unsigned>(stats.ReclaimableBytes()));
+}
+
+void MemMonitorLogReport() {
+  const MemStats stats = MemMonitorGetStats();
+  ESP_LOGI(TAG, "%-16s %6s %6s %6s %6s %7s", "task", "stack", "peak",
+           "free", "advice", "reclaim");
+  for (size_t i = 0; i < stats.TaskCount(); ++i) {
+    const StackStats& t = stats.Task(i);
+    if (!t.seen) continue;
+    const StackAdvice a = stats.Advise(i);
+    ESP_LOGI(TAG, "%-16s %6u %6u %6u %6u %7d%s", t.name,
+             static_cast<unsigned>(t.stack_bytes),
+             static_cast<unsigned>(a.peak_used),
+             static_cast<unsigned>(t.min_free_bytes),
+             static_cast<unsigned>(a.recommended),
+             static_cast<int>(a.reclaim), t.alive ? "" : " (exited)");
+  }
+  LogSummary(stats);
+}
+
+cJSON* MemMonitorBuildJson() {
+  const MemStats stats = MemMonitorGetStats();
+  cJSON* root = cJSON_CreateObject();
+  if (!root) return nullptr;
+  cJSON_AddNumberToObject(root, "interval_ms", Cfg::kIntervalMs);
+  cJSON_AddNumberToObject(root, "samples", (double)stats.Samples());
+
+  cJSON* heaps = cJSON_AddArrayToObject(root, "heap");
+  for (size_t r = 0; heaps && r < rc_vehicle::kHeapRegionCount; ++r) {
+    const auto region = static_cast<HeapRegion>(r);
+    const rc_vehicle::HeapStats& h = stats.Heap(region);
+    if (!h.present) continue;
+    cJSON* item = cJSON_CreateObject();
+    if (!item) break;
+    cJSON_AddStringToObject(item, "region", rc_vehicle::HeapRegionName(region));
+    cJSON_AddNumberToObject(item, "total", (double)h.last.total);
+    cJSON_AddNumberToObject(item, "free", (double)h.last.free);
+    cJSON_AddNumberToObject(item, "min_free", (double)h.min_free);
+    cJSON_AddNumberToObject(item, "largest", (double)h.last.largest_block);
+    cJSON_AddNumberToObject(item, "min_largest",
+                            (double)h.min_largest_block);
+    cJSON_AddNumberToObject(
+        item, "frag_pct",
+        (double)rc_vehicle::FragmentationPct(h.last.free,
+                                             h.last.largest_block));
+    cJSON_AddItemToArray(heaps, item);
+  }
+
+  cJSON* tasks = cJSON_AddArrayToObject(root, "tasks");
+  for (size_t i = 0; tasks && i < stats.TaskCount(); ++i) {
+    const StackStats& t = stats.Task(i);
+    if (!t.seen) continue;
+    const StackAdvice a = stats.Advise(i);
+    cJSON* item = cJSON_CreateObject();
+    if (!item) break;
+    cJSON_AddStringToObject(item, "name", t.name);
+    cJSON_AddNumberToObject(item, "stack", (double)t.stack_bytes);
+    cJSON_AddNumberToObject(item, "min_free", (double)t.min_free_bytes);
+    cJSON_AddNumberToObject(item, "peak", (double)a.peak_used);
+    cJSON_AddNumberToObject(item, "recommended", (double)a.recommended);
+    cJSON_AddNumberToObject(item, "reclaim", (double)a.reclaim);
+    cJSON_AddBoolToObject(item, "alive", t.alive);
+    cJSON_AddItemToArray(tasks, item);
+  }
+  cJSON_AddNumberToObject(root, "reclaim_bytes",
+                          (double)stats.ReclaimableBytes());
+  return root;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Задача и инициализация
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void mem_monitor_task(void* arg) {
+  (void)arg;
+  const uint32_t log_every =
+      Cfg::kLogIntervalMs / Cfg::kIntervalMs > 0
+          ? Cfg::kLogIntervalMs / Cfg::kIntervalMs
+          : 1;
+  uint32_t n = 0;
+  TickType_t last_wake = xTaskGetTickCount();
+  while (true) {
+    vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(Cfg::kIntervalMs));
+    MemMonitorSample();
+    if (++n % log_every == 0) LogSummary(MemMonitorGetStats());
+  }
+}
+
+static void RegisterSystemTasks() {
+  // Стеки системных задач ESP-IDF — из sdkconfig; wifi — только high-water
+  MemMonitorRegisterTask("main", CONFIG_ESP_MAIN_TASK_STACK_SIZE);
+#ifdef CONFIG_ESP_TIMER_TASK_STACK_SIZE
+  MemMonitorRegisterTask("esp_timer", CONFIG_ESP_TIMER_TASK_STACK_SIZE);
+#endif
+#ifdef CONFIG_LWIP_TCPIP_TASK_STACK_SIZE
+  MemMonitorRegisterTask("tiT", CONFIG_LWIP_TCPIP_TASK_STACK_SIZE);
+#endif
+#ifdef CONFIG_ESP_SYSTEM_EVENT_TASK_STACK_SIZE
+  MemMonitorRegisterTask("sys_evt", CONFIG_ESP_SYSTEM_EVENT_TASK_STACK_SIZE);
+#endif
+#ifdef CONFIG_FREERTOS_IDLE_TASK_STACKSIZE
+  MemMonitorRegisterTask("IDLE0", CONFIG_FREERTOS_IDLE_TASK_STACKSIZE);
+  MemMonitorRegisterTask("IDLE1", CONFIG_FREERTOS_IDLE_TASK_STACKSIZE);
+#endif
+  MemMonitorRegisterTask("wifi", 0);
+}
+
+esp_err_t MemMonitorInit() {
+  if (s_started) return ESP_ERR_INVALID_STATE;
+  RegisterSystemTasks();
+  MemMonitorRegisterTask("mem_mon", Cfg::kTaskStack);
+  // Первый опрос сразу: застать стек main до выхода из app_main
+  MemMonitorSample();
+
+  if (xTaskCreate(mem_monitor_task, "mem_mon", Cfg::kTaskStack, nullptr,
+                  tskIDLE_PRIORITY + 1, nullptr) != pdPASS) {
+    ESP_LOGE(TAG, "Failed to create task");
+    return ESP_FAIL;
+  }
+  s_started = true;
+  LogSummary(MemMonitorGetStats());
+  return ESP_OK;
+}
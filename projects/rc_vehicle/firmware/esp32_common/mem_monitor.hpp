@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+#include "cJSON.h"
+#include "esp_err.h"
+#include "mem_stats.hpp"
+
+/**
+ * @file mem_monitor.hpp
+ * @brief Монитор памяти: запас стеков задач и кучи по регионам
+ *        (internal / DMA / PSRAM), рекомендации размеров стеков.
+ *
+ * Задача mem_mon раз в MemMonitorConfig::kIntervalMs опрашивает
+ * uxTaskGetStackHighWaterMark зарегистрированных задач и heap_caps_get_info;
+ * раз в kLogIntervalMs пишет строку MEM, при запасе стека меньше
+ * kLowStackFreeBytes — Warning (один раз на задачу).
+ *
+ * Размер стека FreeRTOS не сообщает — модули регистрируют свои задачи
+ * (MemMonitorRegisterTask) при создании; системные задачи ESP-IDF
+ * регистрируются в MemMonitorInit по значениям sdkconfig.
+ *
+ * Выгрузка: WS {"type":"get_mem"} → "mem_stats", GET /api/mem.
+ */
+
+/**
+ * @brief Запомнить задачу для опроса (можно до MemMonitorInit)
+ * @param name        Имя задачи (как в xTaskCreate)
+ * @param stack_bytes Размер стека; 0 — неизвестен (только high-water)
+ */
+void MemMonitorRegisterTask(const char* name, uint32_t stack_bytes);
+
+/**
+ * @brief Зарегистрировать системные задачи, сделать первый опрос и
+ *        запустить задачу mem_mon
+ */
+esp_err_t MemMonitorInit();
+
+/** Опросить сейчас (вне периода: свежие данные для выгрузки). */
+void MemMonitorSample();
+
+/** Снимок накопленного. */
+rc_vehicle::MemStats MemMonitorGetStats();
+
+/**
+ * @brief Отчёт в JSON: heap[] по регионам, tasks[] с рекомендациями,
+ *        reclaim_bytes. Вызывающий удаляет (cJSON_Delete).
+ */
+cJSON* MemMonitorBuildJson();
+
+/** Таблица «задача / стек / пик / рекомендация» в лог. */
+void MemMonitorLogReport();
@@ -0,0 +1,327 @@
+#include "ota_updater.hpp"
+
+#include <atomic>
+#include <memory>
+#include <new>
+
+#include "../common/config.hpp"
+#include "esp_log.h"
+#include "esp_ota_ops.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/stream_buffer.h"
+#include "freertos/task.h"
+#include "mem_monitor.hpp"
+#include "vehicle_control.hpp"
+
+static const char* TAG = "ota";
+
+using Cfg = rc_vehicle::config::OtaConfig;
+using rc_vehicle::OtaError;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Запись в раздел OTA
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * esp_ota_* в неактивный слот. OTA_WITH_SEQUENTIAL_WRITES стирает сектор
+ * перед первой записью в него, а не весь слот в esp_ota_begin (стирание
+ * 1.9 МБ остановило бы выполнение из флеша на секунды).
+ */
+class EspOtaSink final : public rc_vehicle::OtaSink {
+ public:
+  bool Begin(uint32_t image_size) override {
+    part_ = esp_ota_get_next_update_partition(nullptr);
+    if (!part_ || image_size > part_->size) {
+      ESP_LOGE(TAG, "No OTA slot for %u bytes",
+               static_cast<unsigned>(image_size));
+      return false;
+    }
+    const esp_err_t err =
+        esp_ota_begin(part_, OTA_WITH_SEQUENTIAL_WRITES, &handle_);
+    if (err != ESP_OK) {
+      ESP_LOGE(TAG, "esp_ota_begin: %s", esp_err_to_name(err));
+      handle_ = 0;
+      return false;
+    }
+    ESP_LOGI(TAG, "Writing %u bytes to %s", static_cast<unsigned>(image_size),
+             part_->label);
+    return true;
+  }
+
+  bool Write(const uint8_t* data, size_t len) override {
+    const int64_t t0 = esp_timer_get_time();
+    const esp_err_t err = esp_ota_write(handle_, data, len);
+    const uint32_t us = static_cast<uint32_t>(esp_timer_get_time() - t0);
+    if (us > max_write_us_) max_write_us_ = us;
+    if (err != ESP_OK) {
+      ESP_LOGE(TAG, "esp_ota_write: %s", esp_err_to_name(err));
+      return false;
+    }
+    // Ограничение скорости записи: control loop получает флеш между порциями.
+    // Саму порцию (стирание сектора — до сотен мс) пауза не укорачивает:
+    // кэш выключен, цикл стоит — худший случай в max_write_us (README, OTA)
+    vTaskDelay(pdMS_TO_TICKS(Cfg::kWritePauseMs));
+    return true;
+  }
+
+  bool Finish() override {
+    // esp_ota_end проверяет образ (сегменты, SHA-256) перед переключением
+    esp_err_t err = esp_ota_end(handle_);
+    handle_ = 0;
+    if (err == ESP_OK) err = esp_ota_set_boot_partition(part_);
+    if (err != ESP_OK) {
+      ESP_LOGE(TAG, "Image rejected: %s", esp_err_to_name(err));
+      return false;
+    }
+    return true;
+  }
+
+  void Abort() override {
+    if (handle_ != 0) esp_ota_abort(handle_);
+    handle_ = 0;
+  }
+
+  uint32_t MaxWriteUs() const { return max_write_us_; }
+  void ResetStats() { max_write_us_ = 0; }
+
+ private:
+  const esp_partition_t* part_{nullptr};
+  esp_ota_handle_t handle_{0};
+  uint32_t max_write_us_{0};
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Module state
+// ─────────────────────────────────────────────────────────────────────────────
+
+static StreamBufferHandle_t s_stream = nullptr;
+static SemaphoreHandle_t s_done = nullptr;
+static EspOtaSink s_sink;
+// Владелец — ota_task (создаётся в Begin до s_active = true)
+static std::unique_ptr<rc_vehicle::OtaImageWriter> s_writer;
+
+static std::atomic<bool> s_active{false};
+static std::atomic<bool> s_input_done{false};
+static std::atomic<bool> s_cancel{false};
+
+// Spinlock protecting s_status (writer: ota_task, readers: httpd)
+static portMUX_TYPE s_status_mux = portMUX_INITIALIZER_UNLOCKED;
+static OtaUpdaterStatus s_status;
+
+static rc_vehicle::OtaConfirmGuard s_confirm;
+static esp_timer_handle_t s_restart_timer = nullptr;
+
+static void update_status(OtaUpdaterState state, OtaError error) {
+  portENTER_CRITICAL(&s_status_mux);
+  s_status.state = state;
+  s_status.error = error;
+  if (s_writer) {
+    s_status.payload_received = s_writer->PayloadReceived();
+    s_status.raw_written = s_writer->RawWritten();
+    if (s_writer->HeaderParsed()) {
+      s_status.payload_size = s_writer->Header().payload_size;
+      s_status.raw_size = s_writer->Header().raw_size;
+      s_status.build_id = s_writer->Header().build_id;
+    }
+  }
+  s_status.max_write_us = s_sink.MaxWriteUs();
+  portEXIT_CRITICAL(&s_status_mux);
+}
+
+static void finish_session(OtaError error) {
+  update_status(error == OtaError::None ? OtaUpdaterState::Done
+                                        : OtaUpdaterState::Failed,
+                error);
+  if (error == OtaError::None) {
+    ESP_LOGI(TAG, "Update written, max flash op %u us",
+             static_cast<unsigned>(s_sink.MaxWriteUs()));
+  } else {
+    ESP_LOGW(TAG, "Update failed: %s", rc_vehicle::OtaErrorName(error));
+  }
+  s_writer.reset();
+  s_active.store(false, std::memory_order_release);
+  xSemaphoreGive(s_done);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// OTA task
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void ota_task(void* arg) {
+  (void)arg;
+  static uint8_t buf[Cfg::kRecvChunkBytes];
+  while (true) {
+    const size_t n =
+        xStreamBufferReceive(s_stream, buf, sizeof(buf), pdMS_TO_TICKS(50));
+    // Вне сессии — дочитать и выбросить остаток прерванной загрузки
+    if (!s_active.load(std::memory_order_acquire)) continue;
+
+    if (s_cancel.load()) {
+      s_writer->Abort(OtaError::Aborted);
+    } else if (n > 0) {
+      if (!VehicleControlIsStationary()) {
+        s_writer->Abort(OtaError::Moving);
+      } else {
+        s_writer->Feed(buf, n);
+      }
+      update_status(OtaUpdaterState::Receiving, s_writer->Error());
+    }
+
+    if (s_writer->Error() != OtaError::None) {
+      finish_session(s_writer->Error());
+    } else if (n == 0 && s_input_done.load() &&
+               xStreamBufferIsEmpty(s_stream) == pdTRUE) {
+      finish_session(s_writer->Finish());
+    }
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Public API
+// ─────────────────────────────────────────────────────────────────────────────
+
+esp_err_t OtaUpdaterInit() {
+  s_stream = xStreamBufferCreate(Cfg::kStreamBufferBytes, 1);
+  s_done = xSemaphoreCreateBinary();
+  if (!s_stream || !s_done) {
+    ESP_LOGE(TAG, "Failed to create stream buffer / semaphore");
+    return ESP_ERR_NO_MEM;
+  }
+
+  const esp_timer_create_args_t restart_args = {
+      .callback = [](void*) { esp_restart(); },
+      .arg = nullptr,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "ota_restart",
+      .skip_unhandled_events = false,
+  };
+  if (esp_timer_create(&restart_args, &s_restart_timer) != ESP_OK) {
+    return ESP_FAIL;
+  }
+
+  if (xTaskCreate(ota_task, "ota_task", Cfg::kTaskStack, nullptr,
+                  Cfg::kTaskPriority, nullptr) != pdPASS) {
+    ESP_LOGE(TAG, "Failed to create ota_task");
+    return ESP_FAIL;
+  }
+  MemMonitorRegisterTask("ota_task", Cfg::kTaskStack);
+
+  const esp_partition_t* running = esp_ota_get_running_partition();
+  esp_ota_img_states_t state;
+  if (running &&
+      esp_ota_get_state_partition(running, &state) == ESP_OK &&
+      state == ESP_OTA_IMG_PENDING_VERIFY) {
+    s_status.pending_verify = true;
+    ESP_LOGW(TAG, "Running new image from %s, pending self-test",
+             running->label);
+  }
+  return ESP_OK;
+}
+
+OtaError OtaUpdaterBegin() {
+  OtaUpdaterStatus st = OtaUpdaterGetStatus();
+  // До подтверждения текущего образа новый не принимаем: откат вернул бы
+  // не предыдущую рабочую прошивку, а непроверенную
+  if (s_active.load() || st.pending_verify ||
+      st.state == OtaUpdaterState::Done) {
+    return OtaError::Busy;
+  }
+  if (!VehicleControlIsStationary()) return OtaError::Moving;
+
+  // Остаток прерванной загрузки ещё не выброшен ota_task
+  for (int i = 0; i < 20 && xStreamBufferIsEmpty(s_stream) != pdTRUE; ++i) {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+  xSemaphoreTake(s_done, 0);
+
+  s_writer.reset(new (std::nothrow)
+                     rc_vehicle::OtaImageWriter(s_sink, Cfg::kMaxImageBytes));
+  if (!s_writer) return OtaError::SinkFailed;
+  s_sink.ResetStats();
+  portENTER_CRITICAL(&s_status_mux);
+  s_status = OtaUpdaterStatus{};
+  s_status.state = OtaUpdaterState::Receiving;
+  portEXIT_CRITICAL(&s_status_mux);
+
+  s_input_done.store(false);
+  s_cancel.store(false);
+  s_active.store(true, std::memory_order_release);
+  ESP_LOGI(TAG, "Update started");
+  return OtaError::None;
+}
+
+bool OtaUpdaterPush(const uint8_t* data, size_t len) {
+  while (len > 0) {
+    if (!s_active.load(std::memory_order_acquire)) return false;
+    const size_t n = xStreamBufferSend(s_stream, data, len,
+                                       pdMS_TO_TICKS(Cfg::kPushTimeoutMs));
+    if (n == 0) {
+      ESP_LOGW(TAG, "Push timeout");
+      return false;
+    }
+    data += n;
+    len -= n;
+  }
+  return true;
+}
+
+OtaError OtaUpdaterEnd() {
+  s_input_done.store(true);
+  if (xSemaphoreTake(s_done, pdMS_TO_TICKS(Cfg::kFinishTimeoutMs)) !=
+      pdTRUE) {
+    OtaUpdaterCancel();
+    return OtaError::Aborted;
+  }
+  const OtaUpdaterStatus st = OtaUpdaterGetStatus();
+  if (st.error == OtaError::None) {
+    ESP_LOGI(TAG, "Rebooting into new image (build %u)",
+             static_cast<unsigned>(st.build_id));
+    esp_timer_start_once(s_restart_timer, 1000 * 1000);
+  }
+  return st.error;
+}
+
+void OtaUpdaterCancel() {
+  if (s_active.load()) s_cancel.store(true);
+}
+
+OtaUpdaterStatus OtaUpdaterGetStatus() {
+  portENTER_CRITICAL(&s_status_mux);
+  const OtaUpdaterStatus st = s_status;
+  portEXIT_CRITICAL(&s_status_mux);
+  return st;
+}
+
+void OtaUpdaterConfirmStep() {
+  if (!OtaUpdaterGetStatus().pending_verify) return;
+  const uint32_t now_ms = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+  if (!s_confirm.Due(now_ms)) return;
+
+  const auto results = VehicleControlRunSelfTest();
+  switch (s_confirm.Step(now_ms, results)) {
+    case rc_vehicle::OtaConfirmDecision::Valid:
+      esp_ota_mark_app_valid_cancel_rollback();
+      portENTER_CRITICAL(&s_status_mux);
+      s_status.pending_verify = false;
+      portEXIT_CRITICAL(&s_status_mux);
+      ESP_LOGI(TAG, "New image confirmed by self-test (attempt %u)",
+               static_cast<unsigned>(s_confirm.Attempts()));
+      break;
+    case rc_vehicle::OtaConfirmDecision::Rollback:
+      for (const auto& item : results) {
+        if (!item.passed) {
+          ESP_LOGE(TAG, "self-test FAIL: %s (%s)", item.name, item.value);
+        }
+      }
+      ESP_LOGE(TAG, "New image failed self-test, rolling back");
+      esp_ota_mark_app_invalid_rollback_and_reboot();
+      break;
+    case rc_vehicle::OtaConfirmDecision::Wait:
+      ESP_LOGW(TAG, "Self-test attempt %u failed, retrying",
+               static_cast<unsigned>(s_confirm.Attempts()));
+      break;
+  }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+#include "ota_update.hpp"
+
+/** Состояние приёма образа (GET /api/ota/status). */
+enum class OtaUpdaterState : uint8_t {
+  Idle,
+  Receiving,  ///< Идёт приём/запись
+  Done,       ///< Образ записан и выбран для загрузки, ждёт перезагрузки
+  Failed,
+};
+
+struct OtaUpdaterStatus {
+  OtaUpdaterState state{OtaUpdaterState::Idle};
+  rc_vehicle::OtaError error{rc_vehicle::OtaError::None};
+  uint32_t payload_received{0};
+  uint32_t payload_size{0};
+  uint32_t raw_written{0};
+  uint32_t raw_size{0};
+  uint32_t build_id{0};
+  uint32_t max_write_us{0};    ///< Самая долгая esp_ota_write (простой кэша)
+  bool pending_verify{false};  ///< Текущий образ ждёт подтверждения self-test
+};
+
+/**
+ * @brief Инициализировать модуль OTA
+ *
+ * Создаёт stream buffer (HTTP → задача OTA) и задачу ota_task с низким
+ * приоритетом; определяет, ждёт ли текущий образ подтверждения
+ * (ESP_OTA_IMG_PENDING_VERIFY после обновления).
+ *
+ * @return ESP_OK при успехе
+ */
+esp_err_t OtaUpdaterInit();
+
+/**
+ * @brief Начать приём образа
+ *
+ * @return OtaError::None, Busy (уже идёт) или Moving (машина движется)
+ */
+rc_vehicle::OtaError OtaUpdaterBegin();
+
+/**
+ * @brief Передать порцию тела запроса (сжатый образ) задаче OTA
+ *
+ * Блокирует, пока в буфере нет места (не дольше OtaConfig::kPushTimeoutMs).
+ * @return false — приём прерван (ошибка, движение или тайм-аут)
+ */
+bool OtaUpdaterPush(const uint8_t* data, size_t len);
+
+/**
+ * @brief Тело запроса закончилось: дождаться записи, проверить образ и
+ *        выбрать его для загрузки
+ *
+ * @return OtaError::None — перезагрузка запланирована через ~1 с
+ */
+rc_vehicle::OtaError OtaUpdaterEnd();
+
+/** Прервать приём (обрыв соединения). */
+void OtaUpdaterCancel();
+
+OtaUpdaterStatus OtaUpdaterGetStatus();
+
+/**
+ * @brief Подтверждение нового образа по self-test (вызывать раз в ~1 с)
+ *
+ * После OTA образ загружается в состоянии PENDING_VERIFY: self-test прошёл —
+ * откат отменяется, не прошёл за OtaConfig::kConfirmAttempts попыток —
+ * откат на предыдущий образ с перезагрузкой.
+ */
+void OtaUpdaterConfirmStep();
@@ -0,0 +1,224 @@
+#include "pc_sampler.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include "config.hpp"
+#include "driver/gptimer.h"
+#include "esp_cpu_utils.h"
+#include "esp_debug_helpers.h"
+#include "esp_log.h"
+#include "esp_memory_utils.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "xtensa_context.h"
+
+// Глубина вложенности прерываний ядра (порт FreeRTOS для Xtensa): 1 — мы
+// прервали задачу, больше — другой ISR
+extern "C" volatile unsigned port_interruptNesting[];
+
+static const char* TAG = "pc_sampler";
+
+using rc_vehicle::PcProfileTable;
+using rc_vehicle::PcSample;
+using Cfg = rc_vehicle::config::PcProfilerConfig;
+
+static constexpr size_t kCores = portNUM_PROCESSORS;
+static constexpr uint32_t kTimerResolutionHz = 1000000;
+
+static PcProfileTable s_tables[kCores];
+static gptimer_handle_t s_timers[kCores] = {};
+static std::atomic<bool> s_running{false};
+static uint32_t s_hz = 0;
+static uint8_t s_depth = 1;
+static int64_t s_start_us = 0;
+static int64_t s_stop_us = 0;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ISR: один семпл прерванного контекста своего ядра
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void SampleCore(size_t core) {
+  PcProfileTable& table = s_tables[core];
+  PcSample s;
+  s.core = static_cast<uint8_t>(core);
+
+  TaskHandle_t task = xTaskGetCurrentTaskHandleForCore(core);
+  if (port_interruptNesting[core] > 1 || task == nullptr) {
+    table.Record(s);  // Вложенный ISR — стек недоступен
+    return;
+  }
+
+  // При входе в прерывание порт сохраняет SP задачи в pxTopOfStack (первое
+  // поле TCB); там лежит кадр XtExcFrame с прерванными PC/A0/A1
+  const auto* frame = *reinterpret_cast<const XtExcFrame* const*>(task);
+  s.task = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(task));
+  if (!table.HasTask(s.task)) table.NoteTask(s.task, pcTaskGetName(task));
+
+  s.pcs[0] = frame->pc;
+  s.depth = 1;
+  esp_backtrace_frame_t f = {};
+  f.pc = frame->pc;
+  f.sp = frame->a1;
+  f.next_pc = frame->a0;
+  f.exc_frame = frame;
+  while (s.depth < s_depth && f.next_pc != 0 && esp_stack_ptr_is_sane(f.sp)) {
+    if (!esp_backtrace_get_next_frame(&f)) break;
+    s.pcs[s.depth++] = esp_cpu_process_stack_pc(f.pc);
+  }
+  table.Record(s);
+}
+
+static bool OnAlarm(gptimer_handle_t /*timer*/,
+                    const gptimer_alarm_event_data_t* /*edata*/, void* ctx) {
+  SampleCore(static_cast<size_t>(reinterpret_cast<uintptr_t>(ctx)));
+  return false;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Таймеры: прерывание выделяется на ядре, которое регистрирует колбэк,
+// поэтому настройка — во временной задаче, закреплённой за ядром
+// ─────────────────────────────────────────────────────────────────────────────
+
+static esp_err_t StartCoreTimer(size_t core, uint32_t hz) {
+  gptimer_config_t cfg = {};
+  cfg.clk_src = GPTIMER_CLK_SRC_DEFAULT;
+  cfg.direction = GPTIMER_COUNT_UP;
+  cfg.resolution_hz = kTimerResolutionHz;
+  cfg.intr_priority = Cfg::kIntrPriority;
+  gptimer_handle_t timer = nullptr;
+  esp_err_t err = gptimer_new_timer(&cfg, &timer);
+  if (err != ESP_OK) return err;
+
+  gptimer_event_callbacks_t cbs = {};
+  cbs.on_alarm = OnAlarm;
+  gptimer_alarm_config_t alarm = {};
+  alarm.alarm_count = kTimerResolutionHz / hz;
+  alarm.reload_count = 0;
+  alarm.flags.auto_reload_on_alarm = true;
+
+  err = gptimer_register_event_callbacks(
+      timer, &cbs, reinterpret_cast<void*>(static_cast<uintptr_t>(core)));
+  if (err == ESP_OK) err = gptimer_set_alarm_action(timer, &alarm);
+  if (err == ESP_OK) err = gptimer_enable(timer);
+  if (err == ESP_OK) err = gptimer_start(timer);
+  if (err != ESP_OK) {
+    gptimer_del_timer(timer);
+    return err;
+  }
+  s_timers[core] = timer;
+  return ESP_OK;
+}
+
+struct TimerSetupJob {
+  size_t core;
+  uint32_t hz;
+  SemaphoreHandle_t done;
+  esp_err_t err;
+};
+
+static void TimerSetupTask(void* arg) {
+  auto* job = static_cast<TimerSetupJob*>(arg);
+  job->err = StartCoreTimer(job->core, job->hz);
+  xSemaphoreGive(job->done);
+  vTaskDelete(nullptr);
+}
+
+static void StopTimers() {
+  for (size_t core = 0; core < kCores; ++core) {
+    if (!s_timers[core]) continue;
+    // Освобождение прерывания с другого ядра esp_intr_free делает через IPC
+    gptimer_stop(s_timers[core]);
+    gptimer_disable(s_timers[core]);
+    gptimer_del_timer(s_timers[core]);
+    s_timers[core] = nullptr;
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// API
+// ─────────────────────────────────────────────────────────────────────────────
+
+esp_err_t PcSamplerStart(uint32_t hz, uint8_t depth) {
+  if (s_running.load()) return ESP_ERR_INVALID_STATE;
+  hz = std::clamp<uint32_t>(hz, 1, Cfg::kMaxHz);
+  depth = std::clamp<uint8_t>(depth, 1, rc_vehicle::kPcProfileMaxDepth);
+
+  for (PcProfileTable& table : s_tables) {
+    if (!table.IsInitialized() && !table.Init(Cfg::kEntriesPerCore)) {
+      ESP_LOGE(TAG, "No memory for %u profile entries",
+               static_cast<unsigned>(Cfg::kEntriesPerCore));
+      return ESP_ERR_NO_MEM;
+    }
+    table.Clear();
+  }
+  s_depth = depth;
+  s_hz = hz;
+
+  SemaphoreHandle_t done = xSemaphoreCreateBinary();
+  if (!done) return ESP_ERR_NO_MEM;
+  esp_err_t err = ESP_OK;
+  for (size_t core = 0; core < kCores && err == ESP_OK; ++core) {
+    TimerSetupJob job{core, hz, done, ESP_FAIL};
+    if (xTaskCreatePinnedToCore(TimerSetupTask, "pc_prof_setup", 3072, &job,
+                                tskIDLE_PRIORITY + 5, nullptr,
+                                static_cast<BaseType_t>(core)) != pdPASS) {
+      err = ESP_ERR_NO_MEM;
+      break;
+    }
+    xSemaphoreTake(done, portMAX_DELAY);
+    err = job.err;
+  }
+  vSemaphoreDelete(done);
+
+  if (err != ESP_OK) {
+    StopTimers();
+    ESP_LOGE(TAG, "Timer setup failed: %s", esp_err_to_name(err));
+    return err;
+  }
+  s_start_us = esp_timer_get_time();
+  s_running.store(true);
+  ESP_LOGI(TAG, "Profiling at %u Hz x %u cores, depth %u",
+           static_cast<unsigned>(hz), static_cast<unsigned>(kCores),
+           static_cast<unsigned>(depth));
+  return ESP_OK;
+}
+
+esp_err_t PcSamplerStop() {
+  if (!s_running.load()) return ESP_ERR_INVALID_STATE;
+  StopTimers();
+  s_stop_us = esp_timer_get_time();
+  s_running.store(false);
+
+  const PcSamplerStatus st = PcSamplerGetStatus();
+  ESP_LOGI(TAG, "Stopped: %u samples, %u stacks, %u dropped in %u ms",
+           static_cast<unsigned>(st.samples), static_cast<unsigned>(st.entries),
+           static_cast<unsigned>(st.dropped),
+           static_cast<unsigned>(st.duration_ms));
+  return ESP_OK;
+}
+
+PcSamplerStatus PcSamplerGetStatus() {
+  PcSamplerStatus st;
+  st.running = s_running.load();
+  st.hz = s_hz;
+  st.depth = s_depth;
+  st.cores = static_cast<uint8_t>(kCores);
+  for (const PcProfileTable& table : s_tables) {
+    st.samples += table.Samples();
+    st.dropped += table.Dropped();
+    st.entries += static_cast<uint32_t>(table.Used());
+    st.capacity += static_cast<uint32_t>(table.Capacity());
+  }
+  const int64_t end_us = st.running ? esp_timer_get_time() : s_stop_us;
+  st.duration_ms =
+      s_start_us > 0 ? static_cast<uint32_t>((end_us - s_start_us) / 1000) : 0;
+  return st;
+}
+
+const PcProfileTable* PcSamplerTable(size_t core) {
+  if (core >= kCores || !s_tables[core].IsInitialized()) return nullptr;
+  return &s_tables[core];
+}
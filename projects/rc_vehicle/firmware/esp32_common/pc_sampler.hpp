@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+#include "pc_profile.hpp"
+
+/**
+ * @file pc_sampler.hpp
+ * @brief Статистический профилировщик: семплы PC по таймеру на каждом ядре.
+ *
+ * На каждом ядре — свой gptimer с прерыванием на этом ядре. ISR берёт
+ * прерванную задачу (xTaskGetCurrentTaskHandleForCore), из её TCB —
+ * сохранённый кадр прерывания (XtExcFrame: PC, A0, A1) и раскручивает
+ * до kPcProfileMaxDepth кадров. Семпл уходит в PcProfileTable своего ядра
+ * (PSRAM), поэтому ядра не делят ни таблицу, ни блокировку.
+ *
+ * Семпл, попавший во вложенное прерывание (ISR уровня 1–2 под нашим
+ * уровнем 3), не имеет доступного стека — он учитывается как задача 0
+ * с depth 0 ("[isr]" в tools/pc_profile.py).
+ *
+ * HTTP: POST /api/profile?action=start[&hz=N][&depth=D] | action=stop,
+ * GET /api/profile/status, GET /api/profile.bin (только после stop).
+ */
+
+struct PcSamplerStatus {
+  bool running{false};
+  uint32_t hz{0};
+  uint8_t depth{0};
+  uint8_t cores{0};
+  uint32_t samples{0};  ///< Все ядра
+  uint32_t dropped{0};  ///< Таблица переполнена
+  uint32_t entries{0};  ///< Различных стеков
+  uint32_t capacity{0};  ///< Записей на все ядра
+  uint32_t duration_ms{0};
+};
+
+/**
+ * @brief Очистить гистограммы и запустить семплирование
+ *
+ * Таблицы выделяются при первом запуске (PcProfilerConfig::kEntriesPerCore
+ * на ядро, PSRAM) и дальше переиспользуются.
+ *
+ * @param hz    Частота на ядро, [1, PcProfilerConfig::kMaxHz]
+ * @param depth Кадров стека, [1, kPcProfileMaxDepth] (1 — только PC)
+ * @return ESP_ERR_INVALID_STATE — уже запущен, ESP_ERR_NO_MEM — нет памяти
+ */
+esp_err_t PcSamplerStart(uint32_t hz, uint8_t depth);
+
+/** Остановить таймеры; гистограммы остаются до следующего старта. */
+esp_err_t PcSamplerStop();
+
+PcSamplerStatus PcSamplerGetStatus();
+
+/**
+ * @brief Таблица ядра для выгрузки (nullptr — нет такого ядра или не
+ *        выделена). Читать только при остановленном профилировщике.
+ */
+const rc_vehicle::PcProfileTable* PcSamplerTable(size_t core);
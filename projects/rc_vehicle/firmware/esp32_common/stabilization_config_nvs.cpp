@@ -18,7 +18,8 @@ static const char* NVS_KEY = "config";
 // v4: добавлены FilterConfig::madgwick_enabled, ekf_enabled
 // v5: добавлены KidsModeConfig::speed_limit_enabled, max_speed_ms, speed_limit_gain
 // v6: добавлены StabilizationConfig::braking_mode, brake_slew_multiplier
-static constexpr uint8_t kCurrentStabConfigVersion = 6;
+// v7: добавлен YawRateConfig::mpc_enabled
+static constexpr uint8_t kCurrentStabConfigVersion = 7;
 
 /** Обёртка с версионным заголовком для NVS-хранения. */
 struct StabConfigBlob {
@@ -0,0 +1,130 @@
+#include "udp_cmd_receiver.hpp"
+
+#include <atomic>
+
+#include "../common/config.hpp"
+#include "esp_log.h"
+#include "esp_random.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lwip/sockets.h"
+#include "mem_monitor.hpp"
+
+static const char* TAG = "udp_cmd";
+
+using Cfg = rc_vehicle::config::UdpCommandConfig;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Module state
+// ─────────────────────────────────────────────────────────────────────────────
+
+static int s_sock = -1;
+static UdpCmdHandler s_handler = nullptr;
+static std::atomic<uint32_t> s_token{0};
+
+// Spinlock protecting s_stats: written by udp_cmd_task after every datagram,
+// read by UdpCmdGetStats() (WebSocket handler, other core).
+static portMUX_TYPE s_stats_mux = portMUX_INITIALIZER_UNLOCKED;
+static rc_vehicle::UdpCommandStats s_stats;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Receive task
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void udp_cmd_task(void* arg) {
+  (void)arg;
+  rc_vehicle::UdpCommandFilter filter(s_token.load());
+
+  // One byte more than a packet: oversized datagrams are not truncated into
+  // a valid-looking size.
+  uint8_t buf[sizeof(rc_vehicle::UdpCommandPacket) + 1];
+  uint32_t last_warn_ms = 0;
+
+  for (;;) {
+    struct sockaddr_in src_addr;
+    socklen_t addr_len = sizeof(src_addr);
+    int len = recvfrom(s_sock, buf, sizeof(buf), 0,
+                       (struct sockaddr*)&src_addr, &addr_len);
+    if (len < 0) {
+      vTaskDelay(pdMS_TO_TICKS(100));
+      continue;
+    }
+
+    const uint32_t now_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    rc_vehicle::UdpCommandPacket cmd;
+    const rc_vehicle::UdpCommandVerdict verdict =
+        filter.Accept(buf, (size_t)len, now_ms, cmd);
+    if (verdict == rc_vehicle::UdpCommandVerdict::Accepted && s_handler) {
+      s_handler(cmd.throttle, cmd.steering);
+    }
+
+    taskENTER_CRITICAL(&s_stats_mux);
+    s_stats = filter.Stats();
+    taskEXIT_CRITICAL(&s_stats_mux);
+
+    // Rate-limited warning: wrong token or garbage on the command port
+    if ((verdict == rc_vehicle::UdpCommandVerdict::BadToken ||
+         verdict == rc_vehicle::UdpCommandVerdict::Malformed) &&
+        now_ms - last_warn_ms >= 1000) {
+      ESP_LOGW(TAG, "%s datagram (%d bytes) from %s",
+               rc_vehicle::UdpCommandVerdictName(verdict), len,
+               inet_ntoa(src_addr.sin_addr));
+      last_warn_ms = now_ms;
+    }
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Public API
+// ─────────────────────────────────────────────────────────────────────────────
+
+esp_err_t UdpCmdInit(UdpCmdHandler handler) {
+  s_handler = handler;
+
+  // Never 0: a zero-initialised client must not match
+  uint32_t token = 0;
+  while (token == 0) {
+    token = esp_random();
+  }
+  s_token.store(token);
+
+  s_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (s_sock < 0) {
+    ESP_LOGE(TAG, "Failed to create socket: errno=%d", errno);
+    return ESP_FAIL;
+  }
+
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(Cfg::kPort);
+
+  if (bind(s_sock, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+    ESP_LOGE(TAG, "Failed to bind socket to port %u: errno=%d", Cfg::kPort,
+             errno);
+    close(s_sock);
+    s_sock = -1;
+    return ESP_FAIL;
+  }
+
+  if (xTaskCreate(udp_cmd_task, "udp_cmd", Cfg::kTaskStack, nullptr,
+                  Cfg::kTaskPriority, nullptr) != pdPASS) {
+    ESP_LOGE(TAG, "Failed to create task");
+    close(s_sock);
+    s_sock = -1;
+    return ESP_FAIL;
+  }
+  MemMonitorRegisterTask("udp_cmd", Cfg::kTaskStack);
+
+  ESP_LOGI(TAG, "Initialized. Command port: %u", Cfg::kPort);
+  return ESP_OK;
+}
+
+uint32_t UdpCmdGetToken() { return s_token.load(); }
+
+rc_vehicle::UdpCommandStats UdpCmdGetStats() {
+  taskENTER_CRITICAL(&s_stats_mux);
+  rc_vehicle::UdpCommandStats stats = s_stats;
+  taskEXIT_CRITICAL(&s_stats_mux);
+  return stats;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esp_err.h"
+#include "udp_command.hpp"
+
+/**
+ * @brief Обработчик принятой UDP-команды (газ/руль [-1..1])
+ */
+using UdpCmdHandler = void (*)(float throttle, float steering);
+
+/**
+ * @brief Инициализировать UDP-канал команд
+ *
+ * Создает:
+ * - UDP socket на порту UdpCommandConfig::kPort (5557)
+ * - Задачу udp_cmd (приём UdpCommandPacket, UdpCommandFilter)
+ *
+ * Идентификатор сессии (token) генерируется заново при каждой загрузке
+ * (esp_random); он не секрет — см. udp_command.hpp.
+ *
+ * @param handler Вызывается из задачи udp_cmd для каждой новой команды
+ * @return ESP_OK при успехе
+ */
+esp_err_t UdpCmdInit(UdpCmdHandler handler);
+
+/**
+ * @brief Идентификатор сессии, который клиент кладёт в каждую датаграмму
+ */
+uint32_t UdpCmdGetToken();
+
+/**
+ * @brief Снимок счётчиков фильтра приёма
+ */
+rc_vehicle::UdpCommandStats UdpCmdGetStats();
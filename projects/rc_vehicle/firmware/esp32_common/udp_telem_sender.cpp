@@ -11,12 +11,19 @@
 #include "freertos/task.h"
 #include "lwip/inet.h"
 #include "lwip/sockets.h"
+#include "mem_monitor.hpp"
 #include "nvs.h"
 #include "nvs_flash.h"
+#include "udp_cmd_receiver.hpp"
+#include "wifi_ap.hpp"
 
 static const char* TAG = "udp_telem";
 
 using Cfg = rc_vehicle::config::UdpTelemConfig;
+using rc_vehicle::UdpTelemTarget;
+using rc_vehicle::UdpTelemTargetError;
+using rc_vehicle::UdpTelemTargetSet;
+using TargetResult = rc_vehicle::Result<rc_vehicle::Unit, UdpTelemTargetError>;
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Packet header
@@ -46,14 +53,16 @@ static std::atomic<bool> s_streaming{false};
 static std::atomic<uint32_t> s_seq{0};
 static std::atomic<uint32_t> s_dropped{0};
 
-// Spinlock protecting s_target_addr, s_target_ip_str, s_target_port, s_hz.
-// Writer: UdpTelemStart() (called from udp_ctrl_task or WebSocket handler).
-// Reader: udp_sender_task (sendto).
-// On dual-core ESP32-S3 without this lock, sendto() could read a partially
-// written sockaddr_in when Start() is called from a different core.
+// Spinlock protecting s_targets, s_target_ip_str, s_target_port, s_hz.
+// Writers: UdpTelemStart/Join/Leave/SetGroup (udp_ctrl_task or WebSocket
+// handler). Reader: udp_sender_task, which copies s_targets under the lock
+// and sends from the snapshot. On dual-core ESP32-S3 without this lock the
+// sender could see a half-updated target list.
 static portMUX_TYPE s_target_mux = portMUX_INITIALIZER_UNLOCKED;
 
-static struct sockaddr_in s_target_addr;
+static UdpTelemTargetSet s_targets;
+// Primary target for legacy STATUS "ip"/"port" and NVS: first unicast
+// receiver, else the multicast group.
 static char s_target_ip_str[16] = {};
 static uint16_t s_target_port = Cfg::kDefaultDataPort;
 static uint8_t s_hz = Cfg::kDefaultHz;
@@ -103,6 +112,53 @@ static bool is_valid_hz(uint8_t hz) {
   return hz == 10 || hz == 20 || hz == 50 || hz == 100;
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Target set helpers (call with s_target_mux held)
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void refresh_primary_locked() {
+  const UdpTelemTarget* primary = nullptr;
+  if (s_targets.UnicastCount() > 0) {
+    primary = &s_targets.Unicast(0);
+  } else if (s_targets.Group()) {
+    primary = &*s_targets.Group();
+  }
+  if (primary) {
+    rc_vehicle::FormatIpv4(primary->addr, s_target_ip_str,
+                           sizeof(s_target_ip_str));
+    s_target_port = primary->port;
+  }
+}
+
+// Common tail of every target change: apply hz (0 = keep), start streaming
+// if the set became non-empty, stop it if the set became empty.
+static void apply_target_change(uint8_t hz, bool reset_counters) {
+  bool empty;
+  taskENTER_CRITICAL(&s_target_mux);
+  if (hz) s_hz = hz;
+  refresh_primary_locked();
+  empty = s_targets.Empty();
+  taskEXIT_CRITICAL(&s_target_mux);
+
+  if (empty) {
+    UdpTelemStop();
+    return;
+  }
+  if (reset_counters || !s_streaming.load()) {
+    s_seq.store(0, std::memory_order_relaxed);
+    s_dropped.store(0, std::memory_order_relaxed);
+  }
+  s_streaming.store(true, std::memory_order_release);
+}
+
+static sockaddr_in to_sockaddr(const UdpTelemTarget& t) {
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(t.port);
+  addr.sin_addr.s_addr = htonl(t.addr);
+  return addr;
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Sender task
 // ─────────────────────────────────────────────────────────────────────────────
@@ -144,23 +200,32 @@ static void udp_sender_task(void* arg) {
     pkt.seq = s_seq.fetch_add(1, std::memory_order_relaxed);
     memcpy(pkt.frame, &frame, sizeof(TelemetryLogFrame));
 
-    // Take a consistent snapshot of the target address under spinlock.
-    struct sockaddr_in target_snap;
+    // Take a consistent snapshot of the target set under spinlock.
     taskENTER_CRITICAL(&s_target_mux);
-    memcpy(&target_snap, &s_target_addr, sizeof(target_snap));
+    const UdpTelemTargetSet targets_snap = s_targets;
     taskEXIT_CRITICAL(&s_target_mux);
 
-    int ret = sendto(s_data_sock, &pkt, sizeof(pkt), 0,
-                     (struct sockaddr*)&target_snap, sizeof(target_snap));
-    if (ret < 0) {
-      // Rate-limited warning
-      static uint32_t last_warn_ms = 0;
-      uint32_t now_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
-      if (now_ms - last_warn_ms >= 1000) {
-        ESP_LOGW(TAG, "sendto failed: errno=%d", errno);
-        last_warn_ms = now_ms;
+    // One encoded packet, one sendto per destination. The multicast group
+    // (if any) goes first: a single radio transmission for all members.
+    bool sent = false;
+    targets_snap.ForEach([&](const UdpTelemTarget& t) {
+      struct sockaddr_in addr = to_sockaddr(t);
+      int ret = sendto(s_data_sock, &pkt, sizeof(pkt), 0,
+                       (struct sockaddr*)&addr, sizeof(addr));
+      if (ret < 0) {
+        // Rate-limited warning
+        static uint32_t last_warn_ms = 0;
+        uint32_t now_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        if (now_ms - last_warn_ms >= 1000) {
+          ESP_LOGW(TAG, "sendto %s failed: errno=%d",
+                   inet_ntoa(addr.sin_addr), errno);
+          last_warn_ms = now_ms;
+        }
+      } else {
+        sent = true;
       }
-    } else {
+    });
+    if (sent) {
       frames_sent++;
     }
 
@@ -178,7 +243,8 @@ static void udp_sender_task(void* arg) {
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-// Control task — listens on UDP 5556 for START/STOP/STATUS/PING
+// Control task — listens on UDP 5556 for
+// START/JOIN/LEAVE/MCAST/STOP/STATUS/PING/CMDINFO
 // ─────────────────────────────────────────────────────────────────────────────
 
 static void send_ctrl_reply(const char* reply, struct sockaddr_in* addr,
@@ -187,39 +253,62 @@ static void send_ctrl_reply(const char* reply, struct sockaddr_in* addr,
          addr_len);
 }
 
-static void handle_ctrl_start(const char* buf, struct sockaddr_in* src_addr,
-                              socklen_t addr_len) {
-  // Parse: "START <port> [hz]"
-  uint16_t port = Cfg::kDefaultDataPort;
-  uint8_t hz = Cfg::kDefaultHz;
+static void send_ctrl_error(const char* error, struct sockaddr_in* addr,
+                            socklen_t addr_len) {
+  char reply[128];
+  snprintf(reply, sizeof(reply), "{\"ok\":false,\"error\":\"%s\"}", error);
+  send_ctrl_reply(reply, addr, addr_len);
+}
 
-  // Skip "START "
-  const char* p = buf + 5;
+// Skip the command word and following spaces: "JOIN 5555 50" -> "5555 50"
+static const char* skip_word(const char* p) {
+  while (*p && *p != ' ') p++;
   while (*p == ' ') p++;
+  return p;
+}
 
+// Parse "<port> [hz]" (both optional). hz stays as passed in when absent.
+static void parse_port_hz(const char* p, uint16_t& port, uint8_t& hz) {
   if (*p) {
     port = (uint16_t)atoi(p);
-    // Find next space for hz
-    while (*p && *p != ' ') p++;
-    while (*p == ' ') p++;
+    p = skip_word(p);
     if (*p) {
       hz = (uint8_t)atoi(p);
     }
   }
+}
+
+static void reply_target_result(TargetResult result, const char* ip,
+                                uint16_t port, struct sockaddr_in* src_addr,
+                                socklen_t addr_len) {
+  if (!rc_vehicle::IsOk(result)) {
+    send_ctrl_error(
+        rc_vehicle::UdpTelemTargetErrorName(rc_vehicle::GetError(result)),
+        src_addr, addr_len);
+    return;
+  }
+  char reply[128];
+  snprintf(reply, sizeof(reply),
+           "{\"ok\":true,\"ip\":\"%s\",\"port\":%u,\"hz\":%u,\"targets\":%u}",
+           ip, port, (unsigned)UdpTelemGetHz(),
+           (unsigned)UdpTelemGetTargets().Size());
+  send_ctrl_reply(reply, src_addr, addr_len);
+}
+
+static void handle_ctrl_start(const char* buf, struct sockaddr_in* src_addr,
+                              socklen_t addr_len) {
+  // Parse: "START <port> [hz]"
+  uint16_t port = Cfg::kDefaultDataPort;
+  uint8_t hz = Cfg::kDefaultHz;
+  parse_port_hz(skip_word(buf), port, hz);
 
   if (port < 1024) {
-    char reply[128];
-    snprintf(reply, sizeof(reply),
-             "{\"ok\":false,\"error\":\"port must be >= 1024\"}");
-    send_ctrl_reply(reply, src_addr, addr_len);
+    send_ctrl_error("port must be >= 1024", src_addr, addr_len);
     return;
   }
 
   if (!is_valid_hz(hz)) {
-    char reply[128];
-    snprintf(reply, sizeof(reply),
-             "{\"ok\":false,\"error\":\"hz must be 10, 20, 50, or 100\"}");
-    send_ctrl_reply(reply, src_addr, addr_len);
+    send_ctrl_error("hz must be 10, 20, 50, or 100", src_addr, addr_len);
     return;
   }
 
@@ -236,6 +325,66 @@ static void handle_ctrl_start(const char* buf, struct sockaddr_in* src_addr,
   send_ctrl_reply(reply, src_addr, addr_len);
 }
 
+// "JOIN <port> [hz]": add the sender's IP to the unicast receivers without
+// disturbing the others. hz, if given, applies to the whole stream.
+static void handle_ctrl_join(const char* buf, struct sockaddr_in* src_addr,
+                             socklen_t addr_len) {
+  uint16_t port = Cfg::kDefaultDataPort;
+  uint8_t hz = 0;
+  parse_port_hz(skip_word(buf), port, hz);
+  if (hz && !is_valid_hz(hz)) {
+    send_ctrl_error("hz must be 10, 20, 50, or 100", src_addr, addr_len);
+    return;
+  }
+
+  char ip_str[16];
+  inet_ntoa_r(src_addr->sin_addr, ip_str, sizeof(ip_str));
+  reply_target_result(UdpTelemJoin(ip_str, port, hz), ip_str, port, src_addr,
+                      addr_len);
+}
+
+// "LEAVE <port>": remove the sender's IP:port; the stream stops when the
+// last receiver leaves.
+static void handle_ctrl_leave(const char* buf, struct sockaddr_in* src_addr,
+                              socklen_t addr_len) {
+  uint16_t port = Cfg::kDefaultDataPort;
+  uint8_t hz = 0;
+  parse_port_hz(skip_word(buf), port, hz);
+
+  char ip_str[16];
+  inet_ntoa_r(src_addr->sin_addr, ip_str, sizeof(ip_str));
+  reply_target_result(UdpTelemLeave(ip_str, port), ip_str, port, src_addr,
+                      addr_len);
+}
+
+// "MCAST <group> <port> [hz]" or "MCAST OFF"
+static void handle_ctrl_mcast(const char* buf, struct sockaddr_in* src_addr,
+                              socklen_t addr_len) {
+  const char* p = skip_word(buf);
+  if (strcmp(p, "OFF") == 0) {
+    UdpTelemClearGroup();
+    send_ctrl_reply("{\"ok\":true}", src_addr, addr_len);
+    return;
+  }
+
+  char group[16] = {};
+  size_t n = 0;
+  while (p[n] && p[n] != ' ' && n < sizeof(group) - 1) {
+    group[n] = p[n];
+    n++;
+  }
+  uint16_t port = Cfg::kDefaultDataPort;
+  uint8_t hz = 0;
+  parse_port_hz(skip_word(p), port, hz);
+  if (hz && !is_valid_hz(hz)) {
+    send_ctrl_error("hz must be 10, 20, 50, or 100", src_addr, addr_len);
+    return;
+  }
+
+  reply_target_result(UdpTelemSetGroup(group, port, hz), group, port,
+                      src_addr, addr_len);
+}
+
 static void handle_ctrl_stop(struct sockaddr_in* src_addr,
                              socklen_t addr_len) {
   UdpTelemStop();
@@ -252,17 +401,37 @@ static void handle_ctrl_status(struct sockaddr_in* src_addr,
   memcpy(ip_snap, s_target_ip_str, sizeof(ip_snap));
   port_snap = s_target_port;
   hz_snap = s_hz;
+  const UdpTelemTargetSet targets = s_targets;
   taskEXIT_CRITICAL(&s_target_mux);
 
-  char reply[256];
-  snprintf(reply, sizeof(reply),
-           "{\"streaming\":%s,\"ip\":\"%s\",\"port\":%u,\"hz\":%u,"
-           "\"seq\":%lu,\"dropped\":%lu}",
-           s_streaming.load() ? "true" : "false",
-           ip_snap[0] ? ip_snap : "",
-           port_snap, (unsigned)hz_snap,
-           (unsigned long)s_seq.load(std::memory_order_relaxed),
-           (unsigned long)s_dropped.load(std::memory_order_relaxed));
+  char group[24] = "null";
+  if (targets.Group()) {
+    char ip[16];
+    rc_vehicle::FormatIpv4(targets.Group()->addr, ip, sizeof(ip));
+    snprintf(group, sizeof(group), "\"%s\"", ip);
+  }
+
+  // "ip"/"port" keep the single-target meaning (primary receiver) for old
+  // clients; "targets" lists every unicast receiver.
+  char reply[512];
+  int len = snprintf(
+      reply, sizeof(reply),
+      "{\"streaming\":%s,\"ip\":\"%s\",\"port\":%u,\"hz\":%u,"
+      "\"seq\":%lu,\"dropped\":%lu,\"group\":%s,\"group_port\":%u,"
+      "\"targets\":[",
+      s_streaming.load() ? "true" : "false", ip_snap[0] ? ip_snap : "",
+      port_snap, (unsigned)hz_snap,
+      (unsigned long)s_seq.load(std::memory_order_relaxed),
+      (unsigned long)s_dropped.load(std::memory_order_relaxed), group,
+      targets.Group() ? targets.Group()->port : 0);
+  for (size_t i = 0; i < targets.UnicastCount(); ++i) {
+    char ip[16];
+    rc_vehicle::FormatIpv4(targets.Unicast(i).addr, ip, sizeof(ip));
+    len += snprintf(reply + len, sizeof(reply) - len,
+                    "%s{\"ip\":\"%s\",\"port\":%u}", i ? "," : "", ip,
+                    targets.Unicast(i).port);
+  }
+  snprintf(reply + len, sizeof(reply) - len, "]}");
   send_ctrl_reply(reply, src_addr, addr_len);
 }
 
@@ -274,6 +443,17 @@ static void handle_ctrl_ping(struct sockaddr_in* src_addr,
   send_ctrl_reply(reply, src_addr, addr_len);
 }
 
+// Port and session id of the UDP command channel (udp_cmd_receiver).
+// The id only filters out stale clients; it is not a secret.
+static void handle_ctrl_cmdinfo(struct sockaddr_in* src_addr,
+                                socklen_t addr_len) {
+  char reply[96];
+  snprintf(reply, sizeof(reply), "{\"ok\":true,\"port\":%u,\"token\":%lu}",
+           rc_vehicle::config::UdpCommandConfig::kPort,
+           (unsigned long)UdpCmdGetToken());
+  send_ctrl_reply(reply, src_addr, addr_len);
+}
+
 static void udp_ctrl_task(void* arg) {
   (void)arg;
 
@@ -305,12 +485,20 @@ static void udp_ctrl_task(void* arg) {
 
     if (strncmp(buf, "START", 5) == 0) {
       handle_ctrl_start(buf, &src_addr, addr_len);
+    } else if (strncmp(buf, "JOIN", 4) == 0) {
+      handle_ctrl_join(buf, &src_addr, addr_len);
+    } else if (strncmp(buf, "LEAVE", 5) == 0) {
+      handle_ctrl_leave(buf, &src_addr, addr_len);
+    } else if (strncmp(buf, "MCAST", 5) == 0) {
+      handle_ctrl_mcast(buf, &src_addr, addr_len);
     } else if (strcmp(buf, "STOP") == 0) {
       handle_ctrl_stop(&src_addr, addr_len);
     } else if (strcmp(buf, "STATUS") == 0) {
       handle_ctrl_status(&src_addr, addr_len);
     } else if (strcmp(buf, "PING") == 0) {
       handle_ctrl_ping(&src_addr, addr_len);
+    } else if (strcmp(buf, "CMDINFO") == 0) {
+      handle_ctrl_cmdinfo(&src_addr, addr_len);
     } else {
       char reply[64];
       snprintf(reply, sizeof(reply),
@@ -339,6 +527,10 @@ esp_err_t UdpTelemInit() {
     return ESP_FAIL;
   }
 
+  // Multicast: keep the group on the local link
+  uint8_t ttl = Cfg::kMulticastTtl;
+  setsockopt(s_data_sock, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+
   // Create control socket (for receiving commands)
   s_ctrl_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
   if (s_ctrl_sock < 0) {
@@ -376,6 +568,7 @@ esp_err_t UdpTelemInit() {
     s_ctrl_sock = -1;
     return ESP_FAIL;
   }
+  MemMonitorRegisterTask("udp_send", Cfg::kSenderTaskStack);
 
   // Create control task
   if (xTaskCreate(udp_ctrl_task, "udp_ctrl", Cfg::kControlTaskStack, nullptr,
@@ -384,6 +577,7 @@ esp_err_t UdpTelemInit() {
     // sender task is already running but will just idle
     return ESP_FAIL;
   }
+  MemMonitorRegisterTask("udp_ctrl", Cfg::kControlTaskStack);
 
   ESP_LOGI(TAG, "Initialized. Control port: %u, data port default: %u",
            Cfg::kControlPort, Cfg::kDefaultDataPort);
@@ -400,7 +594,9 @@ void UdpTelemEnqueue(const TelemetryLogFrame& frame) {
 }
 
 bool UdpTelemStart(const char* ip, uint16_t port, uint8_t hz) {
-  if (!ip || port < 1024 || !is_valid_hz(hz)) {
+  uint32_t addr = 0;
+  if (!ip || port < 1024 || !is_valid_hz(hz) ||
+      !rc_vehicle::ParseIpv4(ip, addr)) {
     ESP_LOGW(TAG, "Invalid params: ip=%s port=%u hz=%u",
              ip ? ip : "null", port, hz);
     return false;
@@ -411,12 +607,11 @@ bool UdpTelemStart(const char* ip, uint16_t port, uint8_t hz) {
     UdpTelemStop();
   }
 
-  // Build new target address in a local variable first, then copy under lock.
-  struct sockaddr_in new_addr = {};
-  new_addr.sin_family = AF_INET;
-  new_addr.sin_port = htons(port);
-  if (inet_pton(AF_INET, ip, &new_addr.sin_addr) != 1) {
-    ESP_LOGW(TAG, "Invalid IP: %s", ip);
+  // Single-receiver semantics: the new target replaces every other receiver
+  // (including the multicast group).
+  UdpTelemTargetSet single;
+  if (!rc_vehicle::IsOk(single.AddUnicast(addr, port))) {
+    ESP_LOGW(TAG, "Invalid target: %s:%u", ip, port);
     return false;
   }
 
@@ -425,38 +620,106 @@ bool UdpTelemStart(const char* ip, uint16_t port, uint8_t hz) {
   taskENTER_CRITICAL(&s_target_mux);
   config_changed = (strcmp(s_target_ip_str, ip) != 0) ||
                    (s_target_port != port) || (s_hz != hz);
-  memcpy(&s_target_addr, &new_addr, sizeof(s_target_addr));
-  strncpy(s_target_ip_str, ip, sizeof(s_target_ip_str) - 1);
-  s_target_ip_str[sizeof(s_target_ip_str) - 1] = '\0';
-  s_target_port = port;
-  s_hz = hz;
+  s_targets = single;
   taskEXIT_CRITICAL(&s_target_mux);
 
-  // Reset counters
-  s_seq.store(0, std::memory_order_relaxed);
-  s_dropped.store(0, std::memory_order_relaxed);
+  apply_target_change(hz, true);
 
   // Save to NVS only when target config changed to reduce flash wear.
   if (config_changed) {
     nvs_save();
   }
 
-  // Start streaming
-  s_streaming.store(true, std::memory_order_release);
-
   ESP_LOGI(TAG, "Started: %s:%u @ %u Hz", s_target_ip_str, s_target_port,
            s_hz);
   return true;
 }
 
+TargetResult UdpTelemJoin(const char* ip, uint16_t port, uint8_t hz) {
+  uint32_t addr = 0;
+  if (!rc_vehicle::ParseIpv4(ip, addr)) {
+    return TargetResult(UdpTelemTargetError::InvalidAddress);
+  }
+  taskENTER_CRITICAL(&s_target_mux);
+  TargetResult result = s_targets.AddUnicast(addr, port);
+  taskEXIT_CRITICAL(&s_target_mux);
+  if (rc_vehicle::IsOk(result)) {
+    apply_target_change(hz, false);
+    ESP_LOGI(TAG, "Join: %s:%u (%u targets)", ip, port,
+             (unsigned)UdpTelemGetTargets().Size());
+  }
+  return result;
+}
+
+TargetResult UdpTelemLeave(const char* ip, uint16_t port) {
+  uint32_t addr = 0;
+  if (!rc_vehicle::ParseIpv4(ip, addr)) {
+    return TargetResult(UdpTelemTargetError::InvalidAddress);
+  }
+  taskENTER_CRITICAL(&s_target_mux);
+  TargetResult result = s_targets.RemoveUnicast(addr, port);
+  taskEXIT_CRITICAL(&s_target_mux);
+  if (rc_vehicle::IsOk(result)) {
+    apply_target_change(0, false);
+    ESP_LOGI(TAG, "Leave: %s:%u", ip, port);
+  }
+  return result;
+}
+
+TargetResult UdpTelemSetGroup(const char* group, uint16_t port, uint8_t hz) {
+  uint32_t addr = 0;
+  if (!rc_vehicle::ParseIpv4(group, addr)) {
+    return TargetResult(UdpTelemTargetError::InvalidAddress);
+  }
+
+  // Receivers live on the vehicle's access point; without this lwIP routes
+  // 224/4 through the default netif, which is STA once it is connected.
+  char ap_ip[16];
+  struct in_addr iface = {};
+  if (WiFiApGetIp(ap_ip, sizeof(ap_ip)) == ESP_OK &&
+      inet_pton(AF_INET, ap_ip, &iface) == 1) {
+    setsockopt(s_data_sock, IPPROTO_IP, IP_MULTICAST_IF, &iface,
+               sizeof(iface));
+  }
+
+  taskENTER_CRITICAL(&s_target_mux);
+  TargetResult result = s_targets.SetGroup(addr, port);
+  taskEXIT_CRITICAL(&s_target_mux);
+  if (rc_vehicle::IsOk(result)) {
+    apply_target_change(hz, false);
+    ESP_LOGI(TAG, "Multicast group: %s:%u", group, port);
+  }
+  return result;
+}
+
+void UdpTelemClearGroup() {
+  taskENTER_CRITICAL(&s_target_mux);
+  s_targets.ClearGroup();
+  taskEXIT_CRITICAL(&s_target_mux);
+  apply_target_change(0, false);
+}
+
+UdpTelemTargetSet UdpTelemGetTargets() {
+  taskENTER_CRITICAL(&s_target_mux);
+  UdpTelemTargetSet targets = s_targets;
+  taskEXIT_CRITICAL(&s_target_mux);
+  return targets;
+}
+
 void UdpTelemStop() {
+  // STOP ends the stream for every receiver: a later JOIN must not revive
+  // receivers that have gone away.
+  taskENTER_CRITICAL(&s_target_mux);
+  s_targets.Clear();
+  taskEXIT_CRITICAL(&s_target_mux);
+
   if (!s_streaming.load()) {
     return;
   }
   s_streaming.store(false, std::memory_order_release);
 
   // No explicit drain needed: udp_sender_task already skips frames
-  // when s_streaming is false (line 127). Draining here would race with
+  // when s_streaming is false. Draining here would race with
   // the sender task's xQueueReceive on the other core.
 
   ESP_LOGI(TAG, "Stopped. Total seq=%lu, dropped=%lu",
@@ -476,7 +739,7 @@ uint32_t UdpTelemGetDropped() {
 }
 
 const char* UdpTelemGetTargetIp() {
-  // s_target_ip_str is only written under s_target_mux in UdpTelemStart(),
+  // s_target_ip_str is only written under s_target_mux (target changes),
   // but the returned pointer is read without lock. This is safe because
   // callers (STATUS handler, WS handler) run on the same core as the writer
   // and the string is always null-terminated before s_streaming is set.
@@ -3,7 +3,9 @@
 #include <cstdint>
 
 #include "esp_err.h"
+#include "result.hpp"
 #include "telemetry_log.hpp"
+#include "udp_telem_targets.hpp"
 
 /**
  * @brief Инициализировать модуль UDP-стриминга телеметрии
@@ -11,9 +13,14 @@
  * Создает:
  * - FreeRTOS очередь для TelemetryLogFrame
  * - UDP control socket на порту 5556
- * - Задачу udp_ctrl_task (прием команд START/STOP/STATUS/PING)
+ * - Задачу udp_ctrl_task (прием команд START/JOIN/LEAVE/MCAST/STOP/STATUS/
+ *   PING/CMDINFO)
  * - Задачу udp_sender_task (отправка телеметрии из очереди)
  *
+ * Получатели — UdpTelemTargetSet: multicast-группа и до
+ * UdpTelemConfig::kMaxUnicastTargets unicast-адресов. Пакет кодируется один
+ * раз и отправляется каждому; частота и seq общие для всех.
+ *
  * Загружает последний target из NVS (но не начинает стриминг).
  *
  * @return ESP_OK при успехе
@@ -31,7 +38,9 @@ esp_err_t UdpTelemInit();
 void UdpTelemEnqueue(const TelemetryLogFrame& frame);
 
 /**
- * @brief Запустить стриминг
+ * @brief Запустить стриминг на единственного получателя
+ *
+ * Заменяет всех получателей (и группу) одним адресом — команда START.
  *
  * @param ip IPv4 адрес получателя (строка "x.x.x.x")
  * @param port UDP порт получателя
@@ -41,7 +50,44 @@ void UdpTelemEnqueue(const TelemetryLogFrame& frame);
 bool UdpTelemStart(const char* ip, uint16_t port, uint8_t hz);
 
 /**
- * @brief Остановить стриминг
+ * @brief Добавить unicast-получателя, не трогая остальных (JOIN)
+ *
+ * Запускает стриминг, если он не был активен.
+ *
+ * @param hz Новая частота для всего потока или 0 — оставить текущую
+ */
+rc_vehicle::Result<rc_vehicle::Unit, rc_vehicle::UdpTelemTargetError>
+UdpTelemJoin(const char* ip, uint16_t port, uint8_t hz);
+
+/**
+ * @brief Убрать unicast-получателя (LEAVE); последний — стриминг стоп
+ */
+rc_vehicle::Result<rc_vehicle::Unit, rc_vehicle::UdpTelemTargetError>
+UdpTelemLeave(const char* ip, uint16_t port);
+
+/**
+ * @brief Назначить multicast-группу (MCAST <group> <port> [hz])
+ *
+ * Группа рассылается через интерфейс точки доступа, TTL = 1. Получатели
+ * подписываются сами (IP_ADD_MEMBERSHIP, `udp_telem.py listen --group`).
+ *
+ * @param hz Новая частота для всего потока или 0 — оставить текущую
+ */
+rc_vehicle::Result<rc_vehicle::Unit, rc_vehicle::UdpTelemTargetError>
+UdpTelemSetGroup(const char* group, uint16_t port, uint8_t hz);
+
+/**
+ * @brief Убрать multicast-группу (MCAST OFF)
+ */
+void UdpTelemClearGroup();
+
+/**
+ * @brief Снимок текущих получателей
+ */
+rc_vehicle::UdpTelemTargetSet UdpTelemGetTargets();
+
+/**
+ * @brief Остановить стриминг и забыть всех получателей
  */
 void UdpTelemStop();
 
@@ -61,7 +107,7 @@ uint32_t UdpTelemGetSeq();
 uint32_t UdpTelemGetDropped();
 
 /**
- * @brief Получить текущий target IP (строка "x.x.x.x") или ""
+ * @brief Основной получатель (первый unicast, иначе группа): "x.x.x.x" или ""
  */
 const char* UdpTelemGetTargetIp();
 
@@ -1102,10 +1102,11 @@ function handleLogData(frames) {
 
 function exportLogCsv(frames) {
     if (!frames || !frames.length) { alert('Нет данных'); return; }
-    const hdr = 'ts_ms,ax,ay,az,gx,gy,gz,vx,vy,slip_deg,speed_ms,throttle,steering,pitch_deg,roll_deg,yaw_deg,yaw_rate_dps,oversteer_active,rc_throttle,rc_steering,cmd_throttle,cmd_steering,ekf_vx_var,ekf_vy_var,ekf_r_var,ekf_yaw_deg,mx,my,mz,heading_deg,heading_rel_deg,test_marker\n';
-    const rows = frames.map(f =>
-        `${f.ts_ms},${f.ax},${f.ay},${f.az},${f.gx},${f.gy},${f.gz},${f.vx},${f.vy},${f.slip_deg},${f.speed_ms},${f.throttle},${f.steering},${f.pitch_deg},${f.roll_deg},${f.yaw_deg},${f.yaw_rate_dps},${f.oversteer_active},${f.rc_throttle},${f.rc_steering},${f.cmd_throttle??0},${f.cmd_steering??0},${f.ekf_vx_var??0},${f.ekf_vy_var??0},${f.ekf_r_var??0},${f.ekf_yaw_deg??0},${f.mx??0},${f.my??0},${f.mz??0},${f.heading_deg??0},${f.heading_rel_deg??0},${f.test_marker??0}`
-    ).join('\n');
+    // get_log_data отдаёт все поля кадра в порядке реестра
+    // (RC_TELEMETRY_LOG_FIELDS), поэтому колонки берём из первого кадра.
+    const cols = Object.keys(frames[0]);
+    const hdr = cols.join(',') + '\n';
+    const rows = frames.map(f => cols.map(c => f[c] ?? 0).join(',')).join('\n');
     triggerDownload(hdr + rows, 'telemetry_log.csv', 'text/csv');
 }
 
@@ -1181,40 +1182,15 @@ async function downloadBinaryLog() {
 
         if (frameCount === 0) { alert('Нет данных телеметрии'); return; }
 
-        const FIELD_OFFSETS = [
-            { name: 'ts_ms',           off: 0,   type: 'u32' },
-            { name: 'ax',              off: 4,   type: 'f32' },
-            { name: 'ay',              off: 8,   type: 'f32' },
-            { name: 'az',              off: 12,  type: 'f32' },
-            { name: 'gx',              off: 16,  type: 'f32' },
-            { name: 'gy',              off: 20,  type: 'f32' },
-            { name: 'gz',              off: 24,  type: 'f32' },
-            { name: 'vx',              off: 28,  type: 'f32' },
-            { name: 'vy',              off: 32,  type: 'f32' },
-            { name: 'slip_deg',        off: 36,  type: 'f32' },
-            { name: 'speed_ms',        off: 40,  type: 'f32' },
-            { name: 'throttle',        off: 44,  type: 'f32' },
-            { name: 'steering',        off: 48,  type: 'f32' },
-            { name: 'pitch_deg',       off: 52,  type: 'f32' },
-            { name: 'roll_deg',        off: 56,  type: 'f32' },
-            { name: 'yaw_deg',         off: 60,  type: 'f32' },
-            { name: 'yaw_rate_dps',    off: 64,  type: 'f32' },
-            { name: 'oversteer_active',off: 68,  type: 'f32' },
-            { name: 'rc_throttle',     off: 72,  type: 'f32' },
-            { name: 'rc_steering',     off: 76,  type: 'f32' },
-            { name: 'cmd_throttle',    off: 80,  type: 'f32' },
-            { name: 'cmd_steering',    off: 84,  type: 'f32' },
-            { name: 'ekf_vx_var',      off: 88,  type: 'f32' },
-            { name: 'ekf_vy_var',      off: 92,  type: 'f32' },
-            { name: 'ekf_r_var',       off: 96,  type: 'f32' },
-            { name: 'ekf_yaw_deg',     off: 100, type: 'f32' },
-            { name: 'mx',             off: 104, type: 'f32' },
-            { name: 'my',             off: 108, type: 'f32' },
-            { name: 'mz',             off: 112, type: 'f32' },
-            { name: 'heading_deg',    off: 116, type: 'f32' },
-            { name: 'heading_rel_deg',off: 120, type: 'f32' },
-            { name: 'test_marker',    off: 124, type: 'u8'  },
-        ];
+        // Раскладка кадра — из реестра полей прошивки (GET /api/log/schema).
+        // Поля за пределами frameSize (лог старой прошивки) пропускаются.
+        const FIELD_SIZES = { u32: 4, f32: 4, u8: 1 };
+        const schemaResp = await fetch('/api/log/schema', { cache: 'no-store' });
+        if (!schemaResp.ok) { alert('Ошибка схемы: ' + schemaResp.status); return; }
+        const schema = await schemaResp.json();
+        const FIELD_OFFSETS = schema.fields
+            .filter(f => f.offset + (FIELD_SIZES[f.type] || 4) <= frameSize)
+            .map(f => ({ name: f.name, off: f.offset, type: f.type }));
 
         // ── Section 2: parse events into a map keyed by ts_ms ─────────────
         // Events are sparse — join them into frame rows by closest timestamp.
@@ -1297,7 +1273,11 @@ function showSelfTestResult(data) {
     if (data.tests) {
         for (const t of data.tests) {
             const row = document.createElement('tr');
-            row.innerHTML = `<td>${escapeHtml(t.name)}</td><td class="${t.passed ? 'st-pass' : 'st-fail'}">${t.passed ? 'PASS' : 'FAIL'}</td><td>${escapeHtml(t.value || '')}</td>`;
+            // fatal: false — информационная проверка (boot_time): WARN, не FAIL
+            const warn = !t.passed && t.fatal === false;
+            const cls = t.passed ? 'st-pass' : (warn ? 'st-warn' : 'st-fail');
+            const text = t.passed ? 'PASS' : (warn ? 'WARN' : 'FAIL');
+            row.innerHTML = `<td>${escapeHtml(t.name)}</td><td class="${cls}">${text}</td><td>${escapeHtml(t.value || '')}</td>`;
             selfTestTableBody.appendChild(row);
         }
     }
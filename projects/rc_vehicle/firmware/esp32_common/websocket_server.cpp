@@ -1,15 +1,16 @@
 #include "websocket_server.hpp"
 
+#include <array>
 #include <atomic>
 #include <string.h>
 
-#include "cJSON.h"
 #include "config.hpp"
 #include "esp_http_server.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 #include "freertos/task.h"
+#include "mem_monitor.hpp"
 
 static const char* TAG = "websocket";
 static httpd_handle_t ws_server_handle = NULL;
@@ -114,31 +115,35 @@ static esp_err_t ws_handler(httpd_req_t* req) {
   }
   buf[safe_len] = '\0';
 
-  cJSON* json = cJSON_Parse(reinterpret_cast<char*>(ws_pkt.payload));
-  if (json == NULL) {
-    ESP_LOGW(TAG, "Failed to parse JSON");
+  // Разбор на месте в buf: без malloc, токены — на стеке httpd
+  std::array<rc_vehicle::JsonToken, WS_RX_MAX_TOKENS> tokens;
+  const auto parsed = rc_vehicle::JsonParseInSitu(
+      reinterpret_cast<char*>(buf), safe_len, tokens);
+  if (!rc_vehicle::IsOk(parsed)) {
+    ESP_LOGW(TAG, "Failed to parse JSON: %s",
+             rc_vehicle::JsonErrorName(rc_vehicle::GetError(parsed)));
     return ESP_OK;  // не рвём соединение из‑за битого кадра
   }
-
-  cJSON* type = cJSON_GetObjectItem(json, "type");
-  if (type && cJSON_IsString(type)) {
-    if (strcmp(type->valuestring, "cmd") == 0) {
-      cJSON* throttle = cJSON_GetObjectItem(json, "throttle");
-      cJSON* steer = cJSON_GetObjectItem(json, "steering");
-      if (!throttle) throttle = cJSON_GetObjectItem(json, "thr");
-      if (!steer) steer = cJSON_GetObjectItem(json, "steer");
-
-      if (throttle && steer && s_cmd_handler) {
-        float thr = static_cast<float>(throttle->valuedouble);
-        float str = static_cast<float>(steer->valuedouble);
-        s_cmd_handler(thr, str);
+  const rc_vehicle::JsonValue json = rc_vehicle::GetValue(parsed);
+
+  const char* type = json["type"].AsString();
+  if (type) {
+    if (strcmp(type, "cmd") == 0) {
+      rc_vehicle::JsonValue throttle = json["throttle"];
+      rc_vehicle::JsonValue steer = json["steering"];
+      if (!throttle.Valid()) throttle = json["thr"];
+      if (!steer.Valid()) steer = json["steer"];
+
+      const auto thr = throttle.AsFloat();
+      const auto str = steer.AsFloat();
+      if (thr && str && s_cmd_handler) {
+        s_cmd_handler(*thr, *str);
       }
     } else if (s_json_handler) {
-      s_json_handler(type->valuestring, json, req);
+      s_json_handler(type, json, req);
     }
   }
 
-  cJSON_Delete(json);
   return ESP_OK;
 }
 
@@ -167,6 +172,8 @@ esp_err_t WebSocketRegisterUri(httpd_handle_t server) {
           pdPASS) {
         vQueueDelete(s_telem_queue);
         s_telem_queue = NULL;
+      } else {
+        MemMonitorRegisterTask("ws_telem", 3072);
       }
     }
   }
@@ -2,9 +2,9 @@
 
 #include <stdint.h>
 
-#include "cJSON.h"
 #include "esp_err.h"
 #include "esp_http_server.h"
+#include "json_reader.hpp"
 
 /** Колбэк обработки команды управления из WebSocket. */
 using WebSocketCommandHandler = void (*)(float throttle, float steering);
@@ -13,8 +13,11 @@ using WebSocketCommandHandler = void (*)(float throttle, float steering);
  * Колбэк для обработки произвольных JSON-команд через WebSocket.
  * Вызывается для всех типов, кроме "cmd" (которые обрабатываются
  * WebSocketCommandHandler). req передаётся для возможности отправить ответ.
+ * json и строки в нём указывают в буфер приёма кадра — действительны только
+ * на время вызова.
  */
-using WebSocketJsonHandler = void (*)(const char* type, cJSON* json,
+using WebSocketJsonHandler = void (*)(const char* type,
+                                      rc_vehicle::JsonValue json,
                                       httpd_req_t* req);
 
 /** Установить обработчик команд (можно вызывать до/после регистрации). */
@@ -73,9 +73,8 @@ static void StaStatusSetConnected(bool connected) {
 
 static void StaStatusSetIp(const esp_netif_ip_info_t& ip_info) {
   portENTER_CRITICAL(&s_wifi_mux);
-  const std::string ip_str = rc_vehicle::FormatIp(ip_info.ip.addr);
-  strncpy(s_sta_status.ip, ip_str.c_str(), sizeof(s_sta_status.ip) - 1);
-  s_sta_status.ip[sizeof(s_sta_status.ip) - 1] = '\0';
+  rc_vehicle::FormatIp(ip_info.ip.addr, s_sta_status.ip,
+                       sizeof(s_sta_status.ip));
   s_sta_status.connected = true;
   portEXIT_CRITICAL(&s_wifi_mux);
 }
@@ -247,10 +246,9 @@ esp_err_t WiFiApInit(void) {
   uint8_t mac[6];
   esp_read_mac(mac, ESP_MAC_WIFI_SOFTAP);
   rc_vehicle::LogFormat fmt;
-  fmt << WIFI_AP_SSID_PREFIX << "-" << std::hex << std::setw(2)
-      << std::setfill('0') << std::uppercase << static_cast<unsigned>(mac[4])
-      << std::setw(2) << std::setfill('0') << static_cast<unsigned>(mac[5]);
-  strncpy(s_ap_ssid, fmt.str().c_str(), sizeof(s_ap_ssid) - 1);
+  fmt << WIFI_AP_SSID_PREFIX << "-" << rc_vehicle::Hex(mac[4], 2, true)
+      << rc_vehicle::Hex(mac[5], 2, true);
+  strncpy(s_ap_ssid, fmt.c_str(), sizeof(s_ap_ssid) - 1);
   s_ap_ssid[sizeof(s_ap_ssid) - 1] = '\0';
 
   // Настройка AP
@@ -348,9 +346,7 @@ esp_err_t WiFiApGetIp(char* ip_str, size_t len) {
     return ESP_FAIL;
   }
 
-  const std::string formatted_ip = rc_vehicle::FormatIp(ip_info.ip.addr);
-  strncpy(ip_str, formatted_ip.c_str(), len - 1);
-  ip_str[len - 1] = '\0';
+  rc_vehicle::FormatIp(ip_info.ip.addr, ip_str, len);
   return ESP_OK;
 }
 
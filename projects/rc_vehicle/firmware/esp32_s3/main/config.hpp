@@ -15,6 +15,9 @@
 
 // Размеры буферов WebSocket (RX — входящие команды от браузера)
 #define WS_RX_BUFFER_SIZE 1024
+// Токенов JSON на кадр (8 байт каждый, стек httpd); полный set_stab_config
+// из веб-интерфейса — ~90
+#define WS_RX_MAX_TOKENS 128
 
 // PWM конфигурация (ESC + servo), 50 Hz, 1–2 мс
 #define PWM_FREQUENCY_HZ 50
@@ -42,6 +45,12 @@
 #define IMU_SPI_MISO_PIN GPIO_NUM_13
 #define IMU_SPI_BAUD_HZ 500000  // 500 kHz (1 MHz нестабильно на длинных проводах)
 
+// Второй IMU на той же шине (резервирование + усреднение, ImuFusion):
+//   Раскомментировать IMU_DUAL → опрашиваются оба датчика (CS10 и IMU2_CS),
+//   ImuRead() отдаёт слитые данные. Оси обоих датчиков должны совпадать.
+// #define IMU_DUAL
+#define IMU2_SPI_CS_PIN GPIO_NUM_4
+
 // Магнитометр MMC5983MA — выбор интерфейса:
 //   Закомментировать MAG_USE_I2C → SPI (4-проводной, CS на GPIO5)
 //   Оставить          MAG_USE_I2C → I2C (2-проводной, SDA/SCL)
@@ -71,6 +80,11 @@
 #define TELEM_SEND_INTERVAL_MS 50  // 20 Hz
 #define FAILSAFE_TIMEOUT_MS 250    // Таймаут failsafe
 
+// Диспетчеризация платформы в control loop (A/B стоимости тика, DIAG `tick`):
+//   по умолчанию тик инстанцирован на VehicleControlPlatformEsp32 (прямые
+//   вызовы); раскомментировать → через виртуальный VehicleControlPlatform.
+// #define CONTROL_TICK_VIRTUAL
+
 // Slew-rate limiting (плавность)
 #define SLEW_RATE_THROTTLE_MAX_PER_SEC 0.5f
 #define SLEW_RATE_STEERING_MAX_PER_SEC 1.0f
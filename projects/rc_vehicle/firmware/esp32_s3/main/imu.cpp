@@ -1,6 +1,12 @@
 #include "imu.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <span>
+
 #include "config.hpp"
+#include "esp_timer.h"
+#include "imu_fusion.hpp"
 #include "lsm6ds3_spi.hpp"
 #include "mpu6050_spi.hpp"
 #include "spi_esp32.hpp"
@@ -19,37 +25,187 @@ static Mpu6050Spi g_mpu(&g_spi_imu);
 
 static IImuSensor *g_imu = nullptr;
 
+#ifdef IMU_DUAL
+static SpiDeviceEsp32 g_spi_imu2(g_spi_bus, IMU2_SPI_CS_PIN, IMU_SPI_BAUD_HZ);
+static Lsm6ds3Spi g_lsm2(&g_spi_imu2);
+static Mpu6050Spi g_mpu2(&g_spi_imu2);
+static IImuSensor *g_imu2 = nullptr;
+static rc_vehicle::ImuFusion g_fusion;
+static char g_dual_name[24];
+#endif
+
+static ImuReadStats g_stats;
+
+// Период вывода статистики чтения в лог (≈10 с при 500 Hz)
+static constexpr uint32_t kStatsLogEveryReads = 5000;
+
+static const char *SensorName(const IImuSensor *imu) {
+  if (!imu)
+    return "none";
+  switch (imu->GetLastWhoAmI()) {
+    case 0x6A: return "LSM6DS3";
+    case 0x6C: return "LSM6DSL";
+    case 0x68: return "MPU6050";
+    case 0x70: return "MPU6500";
+    default:   return "unknown";
+  }
+}
+
+/** Автодетект на одном CS: LSM6DS3/LSM6DSL, затем MPU-6050/MPU-6500. */
+static IImuSensor *Detect(Lsm6ds3Spi &lsm, Mpu6050Spi &mpu) {
+  if (lsm.Init() == 0)
+    return &lsm;
+  if (mpu.Init() == 0)
+    return &mpu;
+  return nullptr;
+}
+
+static void AccountRead(int64_t t0_us) {
+  const uint32_t us = static_cast<uint32_t>(esp_timer_get_time() - t0_us);
+  g_stats.last_us = us;
+  if (us > g_stats.max_us)
+    g_stats.max_us = us;
+  // EMA 1/64: среднее за последние ~0.1 с
+  const int32_t delta =
+      static_cast<int32_t>(us) - static_cast<int32_t>(g_stats.avg_us);
+  g_stats.avg_us = g_stats.reads == 0 ? us : g_stats.avg_us + delta / 64;
+  ++g_stats.reads;
+#ifdef ESP_PLATFORM
+  if (g_stats.reads % kStatsLogEveryReads == 0) {
+    ESP_LOGI(IMU_TAG, "read: avg %u us, max %u us, units %u, skew %d us",
+             static_cast<unsigned>(g_stats.avg_us),
+             static_cast<unsigned>(g_stats.max_us),
+             static_cast<unsigned>(g_stats.active_units),
+             static_cast<int>(g_stats.skew_us));
+  }
+#endif
+}
+
 int ImuInit(void) {
-  // Пробуем LSM6DS3/LSM6DSL первым
-  if (g_lsm.Init() == 0) {
-    g_imu = &g_lsm;
+  g_imu = Detect(g_lsm, g_mpu);
+#ifdef IMU_DUAL
+  g_imu2 = Detect(g_lsm2, g_mpu2);
+  if (!g_imu && g_imu2) {
+    // Работаем на втором как на единственном
+    g_imu = g_imu2;
+    g_imu2 = nullptr;
+  }
+  if (g_imu && g_imu2) {
+    std::snprintf(g_dual_name, sizeof(g_dual_name), "%s+%s", SensorName(g_imu),
+                  SensorName(g_imu2));
+    g_fusion.Reset();
+    g_stats.active_units = 2;
 #ifdef ESP_PLATFORM
-    ESP_LOGI(IMU_TAG, "IMU: LSM6DS3 обнаружен (WHO_AM_I=0x%02X)",
-             g_lsm.GetLastWhoAmI());
+    ESP_LOGI(IMU_TAG, "IMU: два датчика %s (CS%d + CS%d), слияние", g_dual_name,
+             static_cast<int>(IMU_SPI_CS_PIN),
+             static_cast<int>(IMU2_SPI_CS_PIN));
 #endif
     return 0;
   }
+#ifdef ESP_PLATFORM
+  ESP_LOGW(IMU_TAG, "IMU_DUAL: второй датчик не обнаружен, один датчик");
+#endif
+#endif
 
-  // Пробуем MPU-6050/MPU-6500
-  if (g_mpu.Init() == 0) {
-    g_imu = &g_mpu;
+  if (!g_imu) {
 #ifdef ESP_PLATFORM
-    ESP_LOGI(IMU_TAG, "IMU: MPU6050 обнаружен (WHO_AM_I=0x%02X)",
-             g_mpu.GetLastWhoAmI());
+    ESP_LOGE(IMU_TAG, "IMU: датчик не обнаружен");
 #endif
-    return 0;
+    return -1;
   }
+  g_stats.active_units = 1;
+#ifdef ESP_PLATFORM
+  ESP_LOGI(IMU_TAG, "IMU: %s обнаружен (WHO_AM_I=0x%02X)", SensorName(g_imu),
+           g_imu->GetLastWhoAmI());
+#endif
+  return 0;
+}
+
+#ifdef IMU_DUAL
+/**
+ * Оба бёрст-чтения ставятся в очередь SPI подряд: шина передаёт их по DMA
+ * друг за другом, разнос отсчётов — длительность одной транзакции (skew_us).
+ */
+static int ImuReadDual(ImuData &data) {
+  // DMA: статические буферы во внутренней RAM, выравнивание и длина кратны 4
+  alignas(4) static uint8_t tx[2][IImuSensor::kBurstMaxLen];
+  alignas(4) static uint8_t rx[2][IImuSensor::kBurstMaxLen];
+  IImuSensor *const units[2] = {g_imu, g_imu2};
+  SpiDeviceEsp32 *const devs[2] = {&g_spi_imu, &g_spi_imu2};
+
+  // Обмен, не завершившийся к таймауту, остаётся в очереди драйвера и
+  // пишет в rx: буферы устройства не трогаем, пока результат не забран
+  static bool pending[2] = {false, false};
+
+  const int64_t t0 = esp_timer_get_time();
+  bool queued[2] = {false, false};
+  size_t len[2] = {0, 0};
+  for (int i = 0; i < 2; ++i) {
+    if (g_fusion.Health(i).dropped)
+      continue;
+    if (pending[i]) {
+      if (devs[i]->WaitTransfer(0) != 0)
+        continue;
+      pending[i] = false;
+    }
+    // DMA: длина кратна 4, хвост — фиктивные нули
+    const size_t n = units[i]->PrepareBurst(tx[i]);
+    len[i] = (n + 3) & ~static_cast<size_t>(3);
+    std::fill(tx[i] + n, tx[i] + len[i], 0);
+    queued[i] = devs[i]->QueueTransfer(std::span<const uint8_t>(tx[i], len[i]),
+                                       std::span<uint8_t>(rx[i], len[i])) == 0;
+  }
+
+  ImuData d[2];
+  bool ok[2] = {false, false};
+  int64_t done_us[2] = {0, 0};
+  for (int i = 0; i < 2; ++i) {
+    if (!queued[i])
+      continue;
+    if (devs[i]->WaitTransfer(IMU_READ_INTERVAL_MS) != 0) {
+      pending[i] = true;
+      continue;
+    }
+    ok[i] = units[i]->ParseBurst(std::span<const uint8_t>(rx[i], len[i]),
+                                 d[i]) == 0;
+    done_us[i] = esp_timer_get_time();
+  }
+  if (ok[0] && ok[1])
+    g_stats.skew_us = static_cast<int32_t>(done_us[1] - done_us[0]);
+
+  const size_t active_before = g_fusion.ActiveUnits();
+  const bool fused = g_fusion.Update(ok[0] ? &d[0] : nullptr,
+                                     ok[1] ? &d[1] : nullptr, data);
+  g_stats.active_units = static_cast<uint8_t>(g_fusion.ActiveUnits());
+  g_stats.disagreements = g_fusion.Disagreements();
+  AccountRead(t0);
 
 #ifdef ESP_PLATFORM
-  ESP_LOGE(IMU_TAG, "IMU: датчик не обнаружен");
+  if (g_fusion.ActiveUnits() < active_before) {
+    for (size_t i = 0; i < rc_vehicle::ImuFusion::kUnits; ++i) {
+      const auto &h = g_fusion.Health(i);
+      if (h.dropped) {
+        ESP_LOGW(IMU_TAG, "IMU %s отключён: %s", SensorName(units[i]),
+                 rc_vehicle::ImuDropReasonName(h.reason));
+      }
+    }
+  }
 #endif
-  return -1;
+  return fused ? 0 : -1;
 }
+#endif
 
 int ImuRead(ImuData &data) {
   if (!g_imu)
     return -1;
-  return g_imu->Read(data);
+#ifdef IMU_DUAL
+  if (g_imu2)
+    return ImuReadDual(data);
+#endif
+  const int64_t t0 = esp_timer_get_time();
+  const int rc = g_imu->Read(data);
+  AccountRead(t0);
+  return rc;
 }
 
 void ImuConvertToTelem(const ImuData &data, int16_t &ax, int16_t &ay,
@@ -62,14 +218,13 @@ int ImuGetLastWhoAmI(void) {
 }
 
 const char *ImuGetSensorName(void) {
-  if (!g_imu)
-    return "none";
-  int who = g_imu->GetLastWhoAmI();
-  switch (who) {
-    case 0x6A: return "LSM6DS3";
-    case 0x6C: return "LSM6DSL";
-    case 0x68: return "MPU6050";
-    case 0x70: return "MPU6500";
-    default:   return "unknown";
-  }
+#ifdef IMU_DUAL
+  if (g_imu && g_imu2)
+    return g_dual_name;
+#endif
+  return SensorName(g_imu);
+}
+
+ImuReadStats ImuGetReadStats(void) {
+  return g_stats;
 }
@@ -6,10 +6,24 @@
 
 // C-API для main (реализация через IImuSensor с runtime-детектом MPU6050/LSM6DS3)
 
-/** Инициализация IMU (автодетект: LSM6DS3 → MPU6050). 0 — успех, -1 — ошибка. */
+/** Стоимость чтения IMU за тик (для IMU_DUAL — оба датчика + слияние). */
+struct ImuReadStats {
+  uint32_t reads{0};
+  uint32_t last_us{0};
+  uint32_t avg_us{0};  ///< Скользящее среднее (EMA 1/64)
+  uint32_t max_us{0};
+  int32_t skew_us{0};  ///< IMU_DUAL: разнос отсчётов датчиков
+  uint8_t active_units{0};
+  uint32_t disagreements{0};  ///< IMU_DUAL: тиков с расхождением датчиков
+};
+
+/**
+ * Инициализация IMU (автодетект: LSM6DS3 → MPU6050; с IMU_DUAL — на обоих CS).
+ * 0 — успех, -1 — ошибка.
+ */
 int ImuInit(void);
 
-/** Чтение данных с IMU. 0 — успех, -1 — ошибка. */
+/** Чтение данных с IMU (с IMU_DUAL — слитые данные). 0 — успех, -1 — ошибка. */
 int ImuRead(ImuData& data);
 
 /** Конвертация данных IMU в формат телеметрии (mg, mdps → int16). */
@@ -21,3 +35,6 @@ int ImuGetLastWhoAmI(void);
 
 /** Имя активного датчика: "LSM6DS3", "LSM6DSL", "MPU6050", "MPU6500" или "none". */
 const char* ImuGetSensorName(void);
+
+/** Статистика чтения (пишет control loop, копия без синхронизации). */
+ImuReadStats ImuGetReadStats(void);
@@ -1,7 +1,6 @@
 #include <stdio.h>
 #include <string.h>
 
-#include "cJSON.h"
 #include "config.hpp"
 #include "esp_err.h"
 #include "esp_http_server.h"
@@ -13,6 +12,10 @@
 #include "crash_logger.hpp"
 #include "dns_server.hpp"
 #include "http_server.hpp"
+#include "json_arena.hpp"
+#include "mem_monitor.hpp"
+#include "ota_updater.hpp"
+#include "udp_cmd_receiver.hpp"
 #include "udp_telem_sender.hpp"
 #include "vehicle_control.hpp"
 #include "websocket_server.hpp"
@@ -26,14 +29,23 @@ static const char* TAG = "main";
 static rc_vehicle::WsCommandRegistry g_command_registry;
 
 static void ws_cmd_handler(float throttle, float steering) {
-  VehicleControlOnWifiCommand(throttle, steering);
+  VehicleControlOnWifiCommand(throttle, steering,
+                              rc_vehicle::WifiCommandSource::WebSocket);
+}
+
+static void udp_cmd_handler(float throttle, float steering) {
+  VehicleControlOnWifiCommand(throttle, steering,
+                              rc_vehicle::WifiCommandSource::Udp);
 }
 
 /**
  * Обработчик произвольных JSON-команд через WebSocket.
  * Использует registry pattern для диспетчеризации команд.
+ * Ответ (cJSON) собирается в арене задачи httpd, сброс — по выходу.
  */
-static void ws_json_handler(const char* type, cJSON* json, httpd_req_t* req) {
+static void ws_json_handler(const char* type, rc_vehicle::JsonValue json,
+                            httpd_req_t* req) {
+  rc_vehicle::JsonArenaScope arena(HttpServerJsonArena());
   auto& vc = detail::GetVehicleControl();
   if (!g_command_registry.Handle(vc, type, json, req)) {
     ESP_LOGW(TAG, "Unknown WebSocket command type: %s", type);
@@ -43,6 +55,9 @@ static void ws_json_handler(const char* type, cJSON* json, httpd_req_t* req) {
 extern "C" void app_main(void) {
   ESP_LOGI(TAG, "RC Vehicle ESP32-S3 firmware starting...");
 
+  // cJSON → арены задач (JsonArenaScope); до первого cJSON-вызова
+  rc_vehicle::JsonArenaInstallHooks();
+
   // Инициализация Wi-Fi AP
   ESP_LOGI(TAG, "Initializing Wi-Fi AP...");
   if (WiFiApInit() != ESP_OK) {
@@ -86,6 +101,18 @@ extern "C" void app_main(void) {
     ESP_LOGW(TAG, "UDP telemetry streamer init failed (non-fatal)");
   }
 
+  // UDP-канал команд газ/руль (без head-of-line blocking TCP)
+  ESP_LOGI(TAG, "Initializing UDP command channel...");
+  if (UdpCmdInit(&udp_cmd_handler) != ESP_OK) {
+    ESP_LOGW(TAG, "UDP command channel init failed (non-fatal)");
+  }
+
+  // OTA: приём образа по POST /api/ota, подтверждение нового образа
+  ESP_LOGI(TAG, "Initializing OTA updater...");
+  if (OtaUpdaterInit() != ESP_OK) {
+    ESP_LOGW(TAG, "OTA updater init failed (non-fatal)");
+  }
+
   // Регистрация обработчиков WebSocket команд
   ESP_LOGI(TAG, "Registering WebSocket command handlers...");
   g_command_registry.Register("calibrate_imu", rc_vehicle::HandleCalibrateImu);
@@ -99,6 +126,7 @@ extern "C" void app_main(void) {
                               rc_vehicle::HandleSetStabConfig);
   g_command_registry.Register("get_log_info", rc_vehicle::HandleGetLogInfo);
   g_command_registry.Register("get_log_data", rc_vehicle::HandleGetLogData);
+  g_command_registry.Register("log_since", rc_vehicle::HandleLogSince);
   g_command_registry.Register("clear_log", rc_vehicle::HandleClearLog);
   g_command_registry.Register("set_kids_preset",
                               rc_vehicle::HandleSetKidsPreset);
@@ -117,6 +145,8 @@ extern "C" void app_main(void) {
   g_command_registry.Register("start_test", rc_vehicle::HandleStartTest);
   g_command_registry.Register("stop_test", rc_vehicle::HandleStopTest);
   g_command_registry.Register("get_test_status", rc_vehicle::HandleGetTestStatus);
+  g_command_registry.Register("get_test_result",
+                              rc_vehicle::HandleGetTestResult);
   g_command_registry.Register("start_speed_calib",
                               rc_vehicle::HandleStartSpeedCalib);
   g_command_registry.Register("stop_speed_calib",
@@ -130,11 +160,25 @@ extern "C" void app_main(void) {
                               rc_vehicle::HandleUdpStreamStop);
   g_command_registry.Register("udp_stream_status",
                               rc_vehicle::HandleUdpStreamStatus);
+  g_command_registry.Register("get_udp_cmd", rc_vehicle::HandleGetUdpCmd);
+  g_command_registry.Register("get_json_arena",
+                              rc_vehicle::HandleGetJsonArena);
+  g_command_registry.Register("get_mem", rc_vehicle::HandleGetMem);
   g_command_registry.Register("calibrate_mag", rc_vehicle::HandleCalibrateMag);
   g_command_registry.Register("get_mag_calib_status",
                               rc_vehicle::HandleGetMagCalibStatus);
   g_command_registry.Register("reset_heading_ref",
                               rc_vehicle::HandleResetHeadingRef);
+  g_command_registry.Register("bench_filters", rc_vehicle::HandleBenchFilters);
+  g_command_registry.Register("start_shadow_stab",
+                              rc_vehicle::HandleStartShadowStab);
+  g_command_registry.Register("stop_shadow_stab",
+                              rc_vehicle::HandleStopShadowStab);
+  g_command_registry.Register("get_shadow_stats",
+                              rc_vehicle::HandleGetShadowStats);
+  g_command_registry.Register("get_sysid", rc_vehicle::HandleGetSysId);
+  g_command_registry.Register("set_sysid", rc_vehicle::HandleSetSysId);
+  g_command_registry.Register("get_allan", rc_vehicle::HandleGetAllan);
   ESP_LOGI(TAG, "Registered %zu command handlers",
            g_command_registry.GetHandlerCount());
 
@@ -150,6 +194,11 @@ extern "C" void app_main(void) {
     return;
   }
 
+  // Монитор памяти: стеки задач (зарегистрированы при создании) и кучи
+  if (MemMonitorInit() != ESP_OK) {
+    ESP_LOGW(TAG, "Memory monitor init failed (non-fatal)");
+  }
+
   ESP_LOGI(TAG, "All systems initialized. Ready for connections.");
 
   if (WiFiApGetIp(ap_ip, sizeof(ap_ip)) == ESP_OK) {
@@ -160,8 +209,9 @@ extern "C" void app_main(void) {
     ESP_LOGI(TAG, "----------------------------------------");
   }
 
-  // Основной поток — idle
+  // Основной поток — idle; подтверждение образа после OTA (self-test)
   while (1) {
     vTaskDelay(pdMS_TO_TICKS(1000));
+    OtaUpdaterConfirmStep();
   }
 }
@@ -4,6 +4,7 @@
 
 #include "esp_err.h"
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
 
 static const char* TAG = "spi_esp32";
 
@@ -86,3 +87,25 @@ int SpiDeviceEsp32::Transfer(std::span<const uint8_t> tx,
   esp_err_t e = spi_device_transmit(dev_, &t);
   return (e == ESP_OK) ? 0 : -1;
 }
+
+int SpiDeviceEsp32::QueueTransfer(std::span<const uint8_t> tx,
+                                  std::span<uint8_t> rx) {
+  if (!inited_) return -1;
+  if (tx.size() == 0 || tx.size() != rx.size()) return -1;
+
+  queued_ = {};
+  queued_.length = tx.size() * 8;
+  queued_.tx_buffer = tx.data();
+  queued_.rx_buffer = rx.data();
+
+  esp_err_t e = spi_device_queue_trans(dev_, &queued_, 0);
+  return (e == ESP_OK) ? 0 : -1;
+}
+
+int SpiDeviceEsp32::WaitTransfer(uint32_t timeout_ms) {
+  if (!inited_) return -1;
+  spi_transaction_t* done = nullptr;
+  esp_err_t e =
+      spi_device_get_trans_result(dev_, &done, pdMS_TO_TICKS(timeout_ms));
+  return (e == ESP_OK && done == &queued_) ? 0 : -1;
+}
@@ -41,6 +41,17 @@ class SpiDeviceEsp32 : public SpiDevice {
   int Init() override;
   int Transfer(std::span<const uint8_t> tx, std::span<uint8_t> rx) override;
 
+  /**
+   * Поставить обмен в очередь драйвера без ожидания (результат —
+   * WaitTransfer). Обмены нескольких устройств одной шины, поставленные
+   * подряд, идут по DMA друг за другом без участия CPU. Буферы должны жить
+   * до WaitTransfer; для DMA — выровнены на 4 и длиной кратной 4.
+   */
+  int QueueTransfer(std::span<const uint8_t> tx, std::span<uint8_t> rx);
+
+  /** Дождаться обмена, поставленного QueueTransfer. 0/-1. */
+  int WaitTransfer(uint32_t timeout_ms);
+
  private:
   SpiBusEsp32& bus_;
   gpio_num_t cs_pin_;
@@ -49,6 +60,7 @@ class SpiDeviceEsp32 : public SpiDevice {
   int queue_size_;
 
   spi_device_handle_t dev_{nullptr};
+  spi_transaction_t queued_{};
   bool inited_{false};
 };
 
@@ -2,6 +2,7 @@
 
 using rc_vehicle::BrakingMode;
 using rc_vehicle::DriveMode;
+using rc_vehicle::JsonValue;
 using rc_vehicle::KidsPreset;
 using rc_vehicle::StabilizationConfig;
 
@@ -45,6 +46,7 @@ cJSON* StabilizationConfigToJson(const StabilizationConfig& cfg) {
     }
     cJSON_AddNumberToObject(yaw_rate, "steer_to_yaw_rate_dps",
                             cfg.yaw_rate.steer_to_yaw_rate_dps);
+    cJSON_AddBoolToObject(yaw_rate, "mpc_enabled", cfg.yaw_rate.mpc_enabled);
   }
 
   // Slip angle config
@@ -148,140 +150,120 @@ cJSON* StabilizationConfigToJson(const StabilizationConfig& cfg) {
   return obj;
 }
 
-void StabilizationConfigFromJson(StabilizationConfig& cfg, const cJSON* json) {
-  auto get_bool = [](const cJSON* parent, const char* key, bool& field) {
-    cJSON* item = cJSON_GetObjectItem(parent, key);
-    if (item && cJSON_IsBool(item)) field = cJSON_IsTrue(item);
-  };
-  auto get_float = [](const cJSON* parent, const char* key, float& field) {
-    cJSON* item = cJSON_GetObjectItem(parent, key);
-    if (item && cJSON_IsNumber(item))
-      field = static_cast<float>(item->valuedouble);
-  };
-  auto get_drive_mode = [](const cJSON* parent, const char* key,
-                           DriveMode& field) {
-    cJSON* item = cJSON_GetObjectItem(parent, key);
-    if (item && cJSON_IsNumber(item))
-      field = static_cast<DriveMode>(item->valueint);
-  };
-  auto get_uint32 = [](const cJSON* parent, const char* key, uint32_t& field) {
-    cJSON* item = cJSON_GetObjectItem(parent, key);
-    if (item && cJSON_IsNumber(item))
-      field = static_cast<uint32_t>(item->valueint);
-  };
-
+void StabilizationConfigFromJson(StabilizationConfig& cfg, JsonValue json) {
   // Общие параметры
-  get_bool(json, "enabled", cfg.enabled);
-  get_drive_mode(json, "mode", cfg.mode);
-  get_uint32(json, "fade_ms", cfg.fade_ms);
+  json.Read("enabled", cfg.enabled);
+  if (auto mode = json["mode"].AsInt()) {
+    cfg.mode = static_cast<DriveMode>(*mode);
+  }
+  json.Read("fade_ms", cfg.fade_ms);
 
   // Filter config
-  cJSON* filter = cJSON_GetObjectItem(json, "filter");
-  if (filter) {
-    get_float(filter, "madgwick_beta", cfg.filter.madgwick_beta);
-    get_float(filter, "lpf_cutoff_hz", cfg.filter.lpf_cutoff_hz);
-    get_float(filter, "imu_sample_rate_hz", cfg.filter.imu_sample_rate_hz);
-    get_bool(filter, "madgwick_enabled", cfg.filter.madgwick_enabled);
-    get_bool(filter, "ekf_enabled", cfg.filter.ekf_enabled);
-    get_bool(filter, "adaptive_beta_enabled", cfg.filter.adaptive_beta_enabled);
-    get_float(filter, "adaptive_accel_threshold_g",
-              cfg.filter.adaptive_accel_threshold_g);
+  const JsonValue filter = json["filter"];
+  if (filter.IsObject()) {
+    filter.Read("madgwick_beta", cfg.filter.madgwick_beta);
+    filter.Read("lpf_cutoff_hz", cfg.filter.lpf_cutoff_hz);
+    filter.Read("imu_sample_rate_hz", cfg.filter.imu_sample_rate_hz);
+    filter.Read("madgwick_enabled", cfg.filter.madgwick_enabled);
+    filter.Read("ekf_enabled", cfg.filter.ekf_enabled);
+    filter.Read("adaptive_beta_enabled", cfg.filter.adaptive_beta_enabled);
+    filter.Read("adaptive_accel_threshold_g",
+                cfg.filter.adaptive_accel_threshold_g);
   }
 
   // Yaw rate config
-  cJSON* yaw_rate = cJSON_GetObjectItem(json, "yaw_rate");
-  if (yaw_rate) {
-    cJSON* pid = cJSON_GetObjectItem(yaw_rate, "pid");
-    if (pid) {
-      get_float(pid, "kp", cfg.yaw_rate.pid.kp);
-      get_float(pid, "ki", cfg.yaw_rate.pid.ki);
-      get_float(pid, "kd", cfg.yaw_rate.pid.kd);
-      get_float(pid, "max_integral", cfg.yaw_rate.pid.max_integral);
-      get_float(pid, "max_correction", cfg.yaw_rate.pid.max_correction);
+  const JsonValue yaw_rate = json["yaw_rate"];
+  if (yaw_rate.IsObject()) {
+    const JsonValue pid = yaw_rate["pid"];
+    if (pid.IsObject()) {
+      pid.Read("kp", cfg.yaw_rate.pid.kp);
+      pid.Read("ki", cfg.yaw_rate.pid.ki);
+      pid.Read("kd", cfg.yaw_rate.pid.kd);
+      pid.Read("max_integral", cfg.yaw_rate.pid.max_integral);
+      pid.Read("max_correction", cfg.yaw_rate.pid.max_correction);
     }
-    get_float(yaw_rate, "steer_to_yaw_rate_dps",
-              cfg.yaw_rate.steer_to_yaw_rate_dps);
+    yaw_rate.Read("steer_to_yaw_rate_dps",
+                  cfg.yaw_rate.steer_to_yaw_rate_dps);
+    yaw_rate.Read("mpc_enabled", cfg.yaw_rate.mpc_enabled);
   }
 
   // Slip angle config
-  cJSON* slip_angle = cJSON_GetObjectItem(json, "slip_angle");
-  if (slip_angle) {
-    cJSON* pid = cJSON_GetObjectItem(slip_angle, "pid");
-    if (pid) {
-      get_float(pid, "kp", cfg.slip_angle.pid.kp);
-      get_float(pid, "ki", cfg.slip_angle.pid.ki);
-      get_float(pid, "kd", cfg.slip_angle.pid.kd);
-      get_float(pid, "max_integral", cfg.slip_angle.pid.max_integral);
-      get_float(pid, "max_correction", cfg.slip_angle.pid.max_correction);
+  const JsonValue slip_angle = json["slip_angle"];
+  if (slip_angle.IsObject()) {
+    const JsonValue pid = slip_angle["pid"];
+    if (pid.IsObject()) {
+      pid.Read("kp", cfg.slip_angle.pid.kp);
+      pid.Read("ki", cfg.slip_angle.pid.ki);
+      pid.Read("kd", cfg.slip_angle.pid.kd);
+      pid.Read("max_integral", cfg.slip_angle.pid.max_integral);
+      pid.Read("max_correction", cfg.slip_angle.pid.max_correction);
     }
-    get_float(slip_angle, "target_deg", cfg.slip_angle.target_deg);
+    slip_angle.Read("target_deg", cfg.slip_angle.target_deg);
   }
 
   // Adaptive config
-  cJSON* adaptive = cJSON_GetObjectItem(json, "adaptive");
-  if (adaptive) {
-    get_bool(adaptive, "enabled", cfg.adaptive.enabled);
-    get_float(adaptive, "speed_ref_ms", cfg.adaptive.speed_ref_ms);
-    get_float(adaptive, "scale_min", cfg.adaptive.scale_min);
-    get_float(adaptive, "scale_max", cfg.adaptive.scale_max);
+  const JsonValue adaptive = json["adaptive"];
+  if (adaptive.IsObject()) {
+    adaptive.Read("enabled", cfg.adaptive.enabled);
+    adaptive.Read("speed_ref_ms", cfg.adaptive.speed_ref_ms);
+    adaptive.Read("scale_min", cfg.adaptive.scale_min);
+    adaptive.Read("scale_max", cfg.adaptive.scale_max);
   }
 
   // Oversteer config
-  cJSON* oversteer = cJSON_GetObjectItem(json, "oversteer");
-  if (oversteer) {
-    get_bool(oversteer, "warn_enabled", cfg.oversteer.warn_enabled);
-    get_float(oversteer, "slip_thresh_deg", cfg.oversteer.slip_thresh_deg);
-    get_float(oversteer, "rate_thresh_deg_s", cfg.oversteer.rate_thresh_deg_s);
-    get_float(oversteer, "throttle_reduction",
-              cfg.oversteer.throttle_reduction);
+  const JsonValue oversteer = json["oversteer"];
+  if (oversteer.IsObject()) {
+    oversteer.Read("warn_enabled", cfg.oversteer.warn_enabled);
+    oversteer.Read("slip_thresh_deg", cfg.oversteer.slip_thresh_deg);
+    oversteer.Read("rate_thresh_deg_s", cfg.oversteer.rate_thresh_deg_s);
+    oversteer.Read("throttle_reduction",
+                   cfg.oversteer.throttle_reduction);
   }
 
   // Pitch compensation config
-  cJSON* pitch_comp = cJSON_GetObjectItem(json, "pitch_comp");
-  if (pitch_comp) {
-    get_bool(pitch_comp, "enabled", cfg.pitch_comp.enabled);
-    get_float(pitch_comp, "gain", cfg.pitch_comp.gain);
-    get_float(pitch_comp, "max_correction", cfg.pitch_comp.max_correction);
+  const JsonValue pitch_comp = json["pitch_comp"];
+  if (pitch_comp.IsObject()) {
+    pitch_comp.Read("enabled", cfg.pitch_comp.enabled);
+    pitch_comp.Read("gain", cfg.pitch_comp.gain);
+    pitch_comp.Read("max_correction", cfg.pitch_comp.max_correction);
   }
 
   // Kids mode config
-  cJSON* kids_mode = cJSON_GetObjectItem(json, "kids_mode");
-  if (kids_mode) {
-    get_float(kids_mode, "throttle_limit", cfg.kids_mode.throttle_limit);
-    get_float(kids_mode, "reverse_limit", cfg.kids_mode.reverse_limit);
-    get_float(kids_mode, "steering_limit", cfg.kids_mode.steering_limit);
-    get_float(kids_mode, "slew_throttle", cfg.kids_mode.slew_throttle);
-    get_float(kids_mode, "slew_steering", cfg.kids_mode.slew_steering);
-    get_bool(kids_mode, "anti_spin_enabled", cfg.kids_mode.anti_spin_enabled);
-    get_float(kids_mode, "anti_spin_threshold_deg",
-              cfg.kids_mode.anti_spin_threshold_deg);
-    get_float(kids_mode, "anti_spin_reduction",
-              cfg.kids_mode.anti_spin_reduction);
-    get_bool(kids_mode, "accel_limit_enabled",
-             cfg.kids_mode.accel_limit_enabled);
-    get_float(kids_mode, "accel_threshold_g", cfg.kids_mode.accel_threshold_g);
-    get_float(kids_mode, "accel_limit_gain", cfg.kids_mode.accel_limit_gain);
-    get_float(kids_mode, "accel_max_reduction",
-              cfg.kids_mode.accel_max_reduction);
-    get_bool(kids_mode, "speed_limit_enabled",
-             cfg.kids_mode.speed_limit_enabled);
-    get_float(kids_mode, "max_speed_ms", cfg.kids_mode.max_speed_ms);
-    get_float(kids_mode, "speed_limit_gain", cfg.kids_mode.speed_limit_gain);
+  const JsonValue kids_mode = json["kids_mode"];
+  if (kids_mode.IsObject()) {
+    kids_mode.Read("throttle_limit", cfg.kids_mode.throttle_limit);
+    kids_mode.Read("reverse_limit", cfg.kids_mode.reverse_limit);
+    kids_mode.Read("steering_limit", cfg.kids_mode.steering_limit);
+    kids_mode.Read("slew_throttle", cfg.kids_mode.slew_throttle);
+    kids_mode.Read("slew_steering", cfg.kids_mode.slew_steering);
+    kids_mode.Read("anti_spin_enabled", cfg.kids_mode.anti_spin_enabled);
+    kids_mode.Read("anti_spin_threshold_deg",
+                   cfg.kids_mode.anti_spin_threshold_deg);
+    kids_mode.Read("anti_spin_reduction",
+                   cfg.kids_mode.anti_spin_reduction);
+    kids_mode.Read("accel_limit_enabled",
+                   cfg.kids_mode.accel_limit_enabled);
+    kids_mode.Read("accel_threshold_g", cfg.kids_mode.accel_threshold_g);
+    kids_mode.Read("accel_limit_gain", cfg.kids_mode.accel_limit_gain);
+    kids_mode.Read("accel_max_reduction",
+                   cfg.kids_mode.accel_max_reduction);
+    kids_mode.Read("speed_limit_enabled",
+                   cfg.kids_mode.speed_limit_enabled);
+    kids_mode.Read("max_speed_ms", cfg.kids_mode.max_speed_ms);
+    kids_mode.Read("speed_limit_gain", cfg.kids_mode.speed_limit_gain);
   }
 
   // Slew rate
-  get_float(json, "slew_throttle", cfg.slew_throttle);
-  get_float(json, "slew_steering", cfg.slew_steering);
+  json.Read("slew_throttle", cfg.slew_throttle);
+  json.Read("slew_steering", cfg.slew_steering);
 
   // Braking
-  {
-    cJSON* item = cJSON_GetObjectItem(json, "braking_mode");
-    if (item && cJSON_IsNumber(item))
-      cfg.braking_mode = static_cast<BrakingMode>(item->valueint);
+  if (auto braking = json["braking_mode"].AsInt()) {
+    cfg.braking_mode = static_cast<BrakingMode>(*braking);
   }
-  get_float(json, "brake_slew_multiplier", cfg.brake_slew_multiplier);
+  json.Read("brake_slew_multiplier", cfg.brake_slew_multiplier);
 
   // Trim
-  get_float(json, "steering_trim", cfg.steering_trim);
-  get_float(json, "throttle_trim", cfg.throttle_trim);
+  json.Read("steering_trim", cfg.steering_trim);
+  json.Read("throttle_trim", cfg.throttle_trim);
 }
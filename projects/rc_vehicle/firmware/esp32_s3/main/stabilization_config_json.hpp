@@ -1,6 +1,7 @@
 #pragma once
 
 #include "cJSON.h"
+#include "json_reader.hpp"
 #include "stabilization_config.hpp"
 
 /**
@@ -15,13 +16,14 @@
 cJSON* StabilizationConfigToJson(const rc_vehicle::StabilizationConfig& cfg);
 
 /**
- * @brief Обновить поля StabilizationConfig из cJSON-объекта.
+ * @brief Обновить поля StabilizationConfig из разобранного JSON.
  *
  * Выполняет частичное обновление: изменяются только те поля,
  * которые присутствуют в json. Отсутствующие поля не трогаются.
  *
  * @param cfg  Конфигурация стабилизации (изменяется на месте)
- * @param json Входной JSON-объект (может содержать произвольное подмножество полей)
+ * @param json Входной JSON-объект (может содержать произвольное подмножество
+ *             полей); поле другого типа пропускается
  */
 void StabilizationConfigFromJson(rc_vehicle::StabilizationConfig& cfg,
-                                 const cJSON* json);
+                                 rc_vehicle::JsonValue json);
@@ -9,6 +9,7 @@
  * (см. ws_command_registry.hpp), а не через глобальные обёртки.
  */
 
+#include "config.hpp"
 #include "esp_err.h"
 #include "vehicle_control_platform_esp32.hpp"
 #include "vehicle_control_unified.hpp"
@@ -33,7 +34,12 @@ inline esp_err_t VehicleControlInit(void) {
   auto& vc = detail::GetVehicleControlImpl();
   static bool platform_set = false;
   if (!platform_set) {
+#ifdef CONTROL_TICK_VIRTUAL
+    std::unique_ptr<rc_vehicle::VehicleControlPlatform> platform =
+        std::make_unique<rc_vehicle::VehicleControlPlatformEsp32>();
+#else
     auto platform = std::make_unique<rc_vehicle::VehicleControlPlatformEsp32>();
+#endif
     vc.SetPlatform(std::move(platform));
     platform_set = true;
   }
@@ -41,9 +47,10 @@ inline esp_err_t VehicleControlInit(void) {
   return (result == rc_vehicle::PlatformError::Ok) ? ESP_OK : ESP_FAIL;
 }
 
-/** Передать Wi-Fi команду в control loop. */
-inline void VehicleControlOnWifiCommand(float throttle, float steering) {
-  detail::GetVehicleControl().OnWifiCommand(throttle, steering);
+/** Передать Wi-Fi команду источника source в control loop. */
+inline void VehicleControlOnWifiCommand(float throttle, float steering,
+                                        rc_vehicle::WifiCommandSource source) {
+  detail::GetVehicleControl().OnWifiCommand(throttle, steering, source);
 }
 
 /** Текущее число кадров в буфере телеметрии и его ёмкость. */
@@ -62,6 +69,13 @@ inline bool VehicleControlGetLogFrame(size_t idx, TelemetryLogFrame* out) {
   return detail::GetVehicleControl().GetLogFrame(idx, *out);
 }
 
+/** Кадры телеметрии новее курсора seq (GET /api/log_since). */
+inline rc_vehicle::TelemetryLogSpan VehicleControlReadLogSince(
+    uint64_t seq, TelemetryLogFrame* out, size_t max_frames, size_t gap_skip) {
+  return detail::GetVehicleControl().ReadLogSince(seq, out, max_frames,
+                                                  gap_skip);
+}
+
 /** Количество событий в логе событий (старт/стоп режимов и калибровок). */
 inline size_t VehicleControlGetEventCount() {
   return detail::GetVehicleControl().GetEventCount();
@@ -75,3 +89,13 @@ inline bool VehicleControlGetEvent(size_t idx,
   }
   return detail::GetVehicleControl().GetEvent(idx, *out);
 }
+
+/** Машина стоит — условие запуска и продолжения OTA. */
+inline bool VehicleControlIsStationary() {
+  return detail::GetVehicleControl().IsStationary();
+}
+
+/** Self-test (подтверждение нового образа после OTA). */
+inline std::vector<rc_vehicle::SelfTestItem> VehicleControlRunSelfTest() {
+  return detail::GetVehicleControl().RunSelfTest();
+}
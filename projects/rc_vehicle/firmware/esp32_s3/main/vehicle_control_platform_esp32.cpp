@@ -14,6 +14,7 @@
 #include "imu_calibration_nvs.hpp"
 #include "mag_calibration_nvs.hpp"
 #include "mag.hpp"
+#include "mem_monitor.hpp"
 #include "pwm_control.hpp"
 #include "rc_input.hpp"
 #include "rc_vehicle_common.hpp"
@@ -38,12 +39,16 @@ static constexpr UBaseType_t CONTROL_TASK_PRIORITY = configMAX_PRIORITIES - 1;
 
 VehicleControlPlatformEsp32::VehicleControlPlatformEsp32()
     : failsafe_(FAILSAFE_TIMEOUT_MS) {
-  cmd_queue_ = xQueueCreate(1, sizeof(WifiCmd));
+  for (auto& queue : cmd_queues_) {
+    queue = xQueueCreate(1, sizeof(WifiCmd));
+  }
 }
 
 VehicleControlPlatformEsp32::~VehicleControlPlatformEsp32() {
-  if (cmd_queue_) {
-    vQueueDelete(cmd_queue_);
+  for (auto& queue : cmd_queues_) {
+    if (queue) {
+      vQueueDelete(queue);
+    }
   }
 }
 
@@ -278,25 +283,29 @@ void VehicleControlPlatformEsp32::SendTelem(std::string_view json) {
 // Wi-Fi команды
 // ─────────────────────────────────────────────────────────────────────────
 
-std::optional<RcCommand> VehicleControlPlatformEsp32::TryReceiveWifiCommand() {
-  if (!cmd_queue_) return std::nullopt;
+std::optional<RcCommand> VehicleControlPlatformEsp32::TryReceiveWifiCommand(
+    WifiCommandSource source) {
+  QueueHandle_t queue = cmd_queues_[static_cast<size_t>(source)];
+  if (!queue) return std::nullopt;
 
   WifiCmd cmd;
-  if (xQueueReceive(cmd_queue_, &cmd, 0) == pdTRUE) {
+  if (xQueueReceive(queue, &cmd, 0) == pdTRUE) {
     return RcCommand{.throttle = cmd.throttle, .steering = cmd.steering};
   }
   return std::nullopt;
 }
 
 void VehicleControlPlatformEsp32::SendWifiCommand(float throttle,
-                                                  float steering) {
-  if (!cmd_queue_) return;
+                                                  float steering,
+                                                  WifiCommandSource source) {
+  QueueHandle_t queue = cmd_queues_[static_cast<size_t>(source)];
+  if (!queue) return;
 
   WifiCmd cmd = {
       .throttle = ClampNormalized(throttle),
       .steering = ClampNormalized(steering),
   };
-  xQueueOverwrite(cmd_queue_, &cmd);
+  xQueueOverwrite(queue, &cmd);
 }
 
 // ─────────────────────────────────────────────────────────────────────────
@@ -308,6 +317,9 @@ Result<Unit, PlatformError> VehicleControlPlatformEsp32::CreateTask(
   BaseType_t result =
       xTaskCreatePinnedToCore(entry, "vehicle_ctrl", CONTROL_TASK_STACK, arg,
                               CONTROL_TASK_PRIORITY, nullptr, 1);
+  if (result == pdPASS) {
+    MemMonitorRegisterTask("vehicle_ctrl", CONTROL_TASK_STACK);
+  }
   return (result == pdPASS)
              ? Ok<Unit, PlatformError>(Unit{})
              : Err<Unit, PlatformError>(PlatformError::TaskCreateFailed);
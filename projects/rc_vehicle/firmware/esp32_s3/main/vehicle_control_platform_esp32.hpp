@@ -26,7 +26,7 @@ struct WifiCmd {
  * - FreeRTOS для задач и синхронизации
  * - WebSocket для телеметрии и команд
  */
-class VehicleControlPlatformEsp32 : public VehicleControlPlatform {
+class VehicleControlPlatformEsp32 final : public VehicleControlPlatform {
  public:
   VehicleControlPlatformEsp32();
   ~VehicleControlPlatformEsp32() override;
@@ -90,8 +90,10 @@ class VehicleControlPlatformEsp32 : public VehicleControlPlatform {
   void SendTelem(std::string_view json) override;
 
   // Wi-Fi команды
-  [[nodiscard]] std::optional<RcCommand> TryReceiveWifiCommand() override;
-  void SendWifiCommand(float throttle, float steering) override;
+  [[nodiscard]] std::optional<RcCommand> TryReceiveWifiCommand(
+      WifiCommandSource source) override;
+  void SendWifiCommand(float throttle, float steering,
+                       WifiCommandSource source) override;
 
   // Задачи
   [[nodiscard]] Result<Unit, PlatformError> CreateTask(void (*entry)(void*),
@@ -103,7 +105,8 @@ class VehicleControlPlatformEsp32 : public VehicleControlPlatform {
   void FeedTaskWdt() noexcept override;
 
  private:
-  QueueHandle_t cmd_queue_{nullptr};
+  /// Очередь длины 1 (xQueueOverwrite) на каждый WifiCommandSource
+  QueueHandle_t cmd_queues_[kWifiCommandSourceCount]{};
   Failsafe failsafe_;
   TickType_t last_wake_time_{0};
   bool wake_time_initialized_{false};
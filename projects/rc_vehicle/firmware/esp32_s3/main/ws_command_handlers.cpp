@@ -1,15 +1,27 @@
 #include "ws_command_handlers.hpp"
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <new>
 
+#include "allan_variance.hpp"
+#include "config.hpp"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
+#include "filter_benchmark.hpp"
 #include "i_vehicle_control.hpp"
+#include "json_arena.hpp"
+#include "mem_monitor.hpp"
 #include "self_test.hpp"
 #include "stabilization_config.hpp"
 #include "stabilization_config_json.hpp"
+#include "telemetry_json.hpp"
 #include "telemetry_log.hpp"
 #include "com_offset_calibration.hpp"
 #include "test_runner.hpp"
+#include "udp_cmd_receiver.hpp"
 #include "udp_telem_sender.hpp"
 #include "ws_command_registry.hpp"
 
@@ -17,11 +29,26 @@ static const char* TAG = "ws_handlers";
 
 namespace rc_vehicle {
 
-void HandleCalibrateImu(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
-  cJSON* mode_item = cJSON_GetObjectItem(json, "mode");
-  const char* mode_str = (mode_item && cJSON_IsString(mode_item))
-                             ? mode_item->valuestring
-                             : "gyro";
+namespace {
+
+struct CalibrateImuArgs {
+  const char* mode = "gyro";
+  std::optional<float> target_accel;
+  std::optional<float> throttle;  ///< Устар.: throttle 0.25 ≈ 0.1g
+};
+
+constexpr JsonField<CalibrateImuArgs> kCalibrateImuSchema[] = {
+    {"mode", &CalibrateImuArgs::mode},
+    {"target_accel", &CalibrateImuArgs::target_accel},
+    {"throttle", &CalibrateImuArgs::throttle},
+};
+
+}  // namespace
+
+void HandleCalibrateImu(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
+  CalibrateImuArgs args;
+  JsonBind(json, kCalibrateImuSchema, args);
+  const char* mode_str = args.mode;
   bool is_forward = (strcmp(mode_str, "forward") == 0);
   bool is_auto_forward = (strcmp(mode_str, "auto_forward") == 0);
   bool full = (strcmp(mode_str, "full") == 0);
@@ -31,14 +58,12 @@ void HandleCalibrateImu(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
     cJSON_AddStringToObject(reply, "type", "calibrate_imu_ack");
     if (is_auto_forward) {
       // Поддержка target_accel (новый) и throttle (обратная совместимость)
-      cJSON* accel_item = cJSON_GetObjectItem(json, "target_accel");
-      cJSON* thr_item = cJSON_GetObjectItem(json, "throttle");
       float target_accel = 0.1f;  // default 0.1g
-      if (accel_item && cJSON_IsNumber(accel_item)) {
-        target_accel = (float)accel_item->valuedouble;
-      } else if (thr_item && cJSON_IsNumber(thr_item)) {
+      if (args.target_accel) {
+        target_accel = *args.target_accel;
+      } else if (args.throttle) {
         // Обратная совместимость: throttle 0.25 ≈ 0.1g
-        target_accel = (float)thr_item->valuedouble * 0.4f;
+        target_accel = *args.throttle * 0.4f;
       }
       bool ok = vc.StartAutoForwardCalibration(target_accel);
       cJSON_AddStringToObject(reply, "status", ok ? "collecting" : "failed");
@@ -69,7 +94,8 @@ void HandleCalibrateImu(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   }
 }
 
-void HandleGetCalibStatus(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleGetCalibStatus(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req) {
   (void)json;
 
   cJSON* reply = cJSON_CreateObject();
@@ -82,17 +108,14 @@ void HandleGetCalibStatus(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   }
 }
 
-void HandleSetForwardDirection(IVehicleControl& vc, cJSON* json,
+void HandleSetForwardDirection(IVehicleControl& vc, JsonValue json,
                                httpd_req_t* req) {
-  cJSON* vec_arr = cJSON_GetObjectItem(json, "vec");
+  JsonValue vec_arr = json["vec"];
   float fx = 1.f, fy = 0.f, fz = 0.f;
-  if (cJSON_IsArray(vec_arr) && cJSON_GetArraySize(vec_arr) >= 3) {
-    cJSON* ex = cJSON_GetArrayItem(vec_arr, 0);
-    cJSON* ey = cJSON_GetArrayItem(vec_arr, 1);
-    cJSON* ez = cJSON_GetArrayItem(vec_arr, 2);
-    if (cJSON_IsNumber(ex)) fx = (float)ex->valuedouble;
-    if (cJSON_IsNumber(ey)) fy = (float)ey->valuedouble;
-    if (cJSON_IsNumber(ez)) fz = (float)ez->valuedouble;
+  if (vec_arr.IsArray() && vec_arr.Size() >= 3) {
+    fx = vec_arr.At(0).AsFloat().value_or(fx);
+    fy = vec_arr.At(1).AsFloat().value_or(fy);
+    fz = vec_arr.At(2).AsFloat().value_or(fz);
   }
   vc.SetForwardDirection(fx, fy, fz);
 
@@ -105,7 +128,8 @@ void HandleSetForwardDirection(IVehicleControl& vc, cJSON* json,
   }
 }
 
-void HandleGetStabConfig(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleGetStabConfig(IVehicleControl& vc, JsonValue json,
+                         httpd_req_t* req) {
   (void)json;
 
   const auto& cfg = vc.GetStabilizationConfig();
@@ -117,14 +141,14 @@ void HandleGetStabConfig(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   }
 }
 
-void HandleSetStabConfig(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleSetStabConfig(IVehicleControl& vc, JsonValue json,
+                         httpd_req_t* req) {
   // Получаем текущую конфигурацию
   StabilizationConfig cfg = vc.GetStabilizationConfig();
 
   // Обновляем только переданные поля
-  cJSON* mode_item = cJSON_GetObjectItem(json, "mode");
-  if (mode_item && cJSON_IsNumber(mode_item)) {
-    cfg.mode = static_cast<DriveMode>(static_cast<int>(mode_item->valuedouble));
+  if (auto mode = json["mode"].AsInt()) {
+    cfg.mode = static_cast<DriveMode>(*mode);
   }
 
   // Остальные поля обновляем только если они есть в JSON
@@ -151,7 +175,7 @@ void HandleSetStabConfig(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
            applied.yaw_rate.pid.ki, applied.yaw_rate.pid.kd);
 }
 
-void HandleGetLogInfo(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleGetLogInfo(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
   (void)json;
 
   size_t count = 0, cap = 0;
@@ -167,16 +191,16 @@ void HandleGetLogInfo(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   }
 }
 
-void HandleGetLogData(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleGetLogData(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
   size_t total_count = 0, cap = 0;
   vc.GetLogInfo(total_count, cap);
 
-  cJSON* offset_j = cJSON_GetObjectItem(json, "offset");
-  cJSON* count_j = cJSON_GetObjectItem(json, "count");
-  size_t offset =
-      (offset_j && cJSON_IsNumber(offset_j)) ? (size_t)offset_j->valueint : 0;
-  size_t req_count =
-      (count_j && cJSON_IsNumber(count_j)) ? (size_t)count_j->valueint : 100;
+  uint32_t offset_arg = 0;
+  uint32_t count_arg = 100;
+  json.Read("offset", offset_arg);
+  json.Read("count", count_arg);
+  size_t offset = offset_arg;
+  size_t req_count = count_arg;
 
   // Limit to 200 frames per request
   if (req_count > 200) req_count = 200;
@@ -193,32 +217,7 @@ void HandleGetLogData(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
         if (vc.GetLogFrame(offset + i, frame)) {
           cJSON* f = cJSON_CreateObject();
           if (f) {
-            cJSON_AddNumberToObject(f, "ts_ms", frame.ts_ms);
-            cJSON_AddNumberToObject(f, "ax", frame.ax);
-            cJSON_AddNumberToObject(f, "ay", frame.ay);
-            cJSON_AddNumberToObject(f, "az", frame.az);
-            cJSON_AddNumberToObject(f, "gx", frame.gx);
-            cJSON_AddNumberToObject(f, "gy", frame.gy);
-            cJSON_AddNumberToObject(f, "gz", frame.gz);
-            cJSON_AddNumberToObject(f, "vx", frame.vx);
-            cJSON_AddNumberToObject(f, "vy", frame.vy);
-            cJSON_AddNumberToObject(f, "slip_deg", frame.slip_deg);
-            cJSON_AddNumberToObject(f, "speed_ms", frame.speed_ms);
-            cJSON_AddNumberToObject(f, "throttle", frame.throttle);
-            cJSON_AddNumberToObject(f, "steering", frame.steering);
-            cJSON_AddNumberToObject(f, "pitch_deg", frame.pitch_deg);
-            cJSON_AddNumberToObject(f, "roll_deg", frame.roll_deg);
-            cJSON_AddNumberToObject(f, "yaw_deg", frame.yaw_deg);
-            cJSON_AddNumberToObject(f, "yaw_rate_dps", frame.yaw_rate_dps);
-            cJSON_AddBoolToObject(f, "oversteer_active", frame.oversteer_active);
-            cJSON_AddNumberToObject(f, "rc_throttle", frame.rc_throttle);
-            cJSON_AddNumberToObject(f, "rc_steering", frame.rc_steering);
-            cJSON_AddNumberToObject(f, "cmd_throttle", frame.cmd_throttle);
-            cJSON_AddNumberToObject(f, "cmd_steering", frame.cmd_steering);
-            cJSON_AddNumberToObject(f, "ekf_vx_var", frame.ekf_vx_var);
-            cJSON_AddNumberToObject(f, "ekf_vy_var", frame.ekf_vy_var);
-            cJSON_AddNumberToObject(f, "ekf_r_var", frame.ekf_r_var);
-            cJSON_AddNumberToObject(f, "test_marker", frame.test_marker);
+            AddLogFrameToJson(f, frame);
             cJSON_AddItemToArray(frames_arr, f);
           }
         }
@@ -230,7 +229,53 @@ void HandleGetLogData(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   }
 }
 
-void HandleClearLog(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleLogSince(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
+  using Cfg = config::TelemetryLogConfig;
+
+  // double точен до 2^53 кадров — при 100 Hz это миллионы лет
+  const double seq_arg = json["seq"].AsDouble().value_or(0.0);
+  const uint64_t seq = seq_arg > 0 ? (uint64_t)seq_arg : 0;
+  const int32_t max_arg = json["max"].AsInt().value_or(0);
+  size_t max_frames =
+      max_arg > 0 ? (size_t)max_arg : Cfg::kSinceMaxWsFrames;
+  max_frames = std::min(max_frames, Cfg::kSinceMaxWsFrames);
+
+  // Бинарный ответ: TelemetryLogSinceHeader + кадры (как GET /api/log_since)
+  const size_t hdr_size = sizeof(TelemetryLogSinceHeader);
+  auto* buf = static_cast<uint8_t*>(
+      malloc(hdr_size + max_frames * sizeof(TelemetryLogFrame)));
+  if (!buf) {
+    ESP_LOGE(TAG, "log_since: no memory for %zu frames", max_frames);
+    return;
+  }
+  auto* frames = reinterpret_cast<TelemetryLogFrame*>(buf + hdr_size);
+
+  // Порциями, чтобы не держать мьютекс лога на всё копирование
+  constexpr size_t kFrameBatch = 32;
+  const TelemetryLogSpan span =
+      vc.ReadLogSince(seq, frames, std::min(kFrameBatch, max_frames),
+                      Cfg::kSinceGapSkipFrames);
+  const size_t total = (size_t)std::min<uint64_t>(
+      span.head_seq - span.first_seq, max_frames);
+  size_t filled = span.count;
+  while (filled < total) {
+    const uint64_t next = span.first_seq + filled;
+    const TelemetryLogSpan more =
+        vc.ReadLogSince(next, frames + filled,
+                        std::min(kFrameBatch, total - filled), 0);
+    // Писатель догнал курсор — отдать непрерывный префикс
+    if (more.first_seq != next || more.count == 0) break;
+    filled += more.count;
+  }
+
+  const TelemetryLogSinceHeader header =
+      MakeLogSinceHeader(span, (uint32_t)filled);
+  memcpy(buf, &header, hdr_size);
+  WsSendBinaryReply(req, buf, hdr_size + filled * sizeof(TelemetryLogFrame));
+  free(buf);
+}
+
+void HandleClearLog(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
   (void)json;
 
   vc.ClearLog();
@@ -244,9 +289,10 @@ void HandleClearLog(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   }
 }
 
-void HandleSetKidsPreset(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
-  cJSON* preset_item = cJSON_GetObjectItem(json, "preset");
-  if (!preset_item || !cJSON_IsNumber(preset_item)) {
+void HandleSetKidsPreset(IVehicleControl& vc, JsonValue json,
+                         httpd_req_t* req) {
+  const std::optional<int32_t> preset_item = json["preset"].AsInt();
+  if (!preset_item) {
     cJSON* reply = cJSON_CreateObject();
     if (reply) {
       cJSON_AddStringToObject(reply, "type", "set_kids_preset_ack");
@@ -258,7 +304,7 @@ void HandleSetKidsPreset(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
     return;
   }
 
-  int preset_val = preset_item->valueint;
+  int preset_val = *preset_item;
   if (preset_val < 0 || preset_val > 3) {
     cJSON* reply = cJSON_CreateObject();
     if (reply) {
@@ -288,11 +334,10 @@ void HandleSetKidsPreset(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
            ok ? "OK" : "FAILED");
 }
 
-void HandleToggleKidsMode(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
-  cJSON* active_item = cJSON_GetObjectItem(json, "active");
-  bool active = (active_item && cJSON_IsBool(active_item))
-                    ? cJSON_IsTrue(active_item)
-                    : false;
+void HandleToggleKidsMode(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req) {
+  bool active = false;
+  json.Read("active", active);
 
   vc.SetKidsModeActive(active);
 
@@ -307,7 +352,8 @@ void HandleToggleKidsMode(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   ESP_LOGI(TAG, "toggle_kids_mode active=%s -> OK", active ? "true" : "false");
 }
 
-void HandleGetKidsPresets(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleGetKidsPresets(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req) {
   (void)vc;
   (void)json;
 
@@ -367,13 +413,10 @@ void HandleGetKidsPresets(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   }
 }
 
-void HandleCalibrateSteeringTrim(IVehicleControl& vc, cJSON* json,
+void HandleCalibrateSteeringTrim(IVehicleControl& vc, JsonValue json,
                                  httpd_req_t* req) {
-  cJSON* accel_item = cJSON_GetObjectItem(json, "target_accel");
   float target_accel = 0.1f;
-  if (accel_item && cJSON_IsNumber(accel_item)) {
-    target_accel = (float)accel_item->valuedouble;
-  }
+  json.Read("target_accel", target_accel);
 
   bool ok = vc.StartSteeringTrimCalibration(target_accel);
 
@@ -396,7 +439,7 @@ void HandleCalibrateSteeringTrim(IVehicleControl& vc, cJSON* json,
            target_accel, ok ? "started" : "failed");
 }
 
-void HandleGetSteeringTrimStatus(IVehicleControl& vc, cJSON* json,
+void HandleGetSteeringTrimStatus(IVehicleControl& vc, JsonValue json,
                                  httpd_req_t* req) {
   (void)json;
 
@@ -422,20 +465,14 @@ void HandleGetSteeringTrimStatus(IVehicleControl& vc, cJSON* json,
   }
 }
 
-void HandleCalibrateComOffset(IVehicleControl& vc, cJSON* json,
+void HandleCalibrateComOffset(IVehicleControl& vc, JsonValue json,
                               httpd_req_t* req) {
-  cJSON* accel_item = cJSON_GetObjectItem(json, "target_accel");
-  cJSON* steer_item = cJSON_GetObjectItem(json, "steering");
-  cJSON* dur_item = cJSON_GetObjectItem(json, "duration");
   float target_accel = 0.1f;
   float steering = 0.5f;
   float duration = 5.0f;
-  if (accel_item && cJSON_IsNumber(accel_item))
-    target_accel = (float)accel_item->valuedouble;
-  if (steer_item && cJSON_IsNumber(steer_item))
-    steering = (float)steer_item->valuedouble;
-  if (dur_item && cJSON_IsNumber(dur_item))
-    duration = (float)dur_item->valuedouble;
+  json.Read("target_accel", target_accel);
+  json.Read("steering", steering);
+  json.Read("duration", duration);
 
   bool ok = vc.StartComOffsetCalibration(target_accel, steering, duration);
 
@@ -458,7 +495,7 @@ void HandleCalibrateComOffset(IVehicleControl& vc, cJSON* json,
            target_accel, steering, duration, ok ? "started" : "failed");
 }
 
-void HandleGetComOffsetStatus(IVehicleControl& vc, cJSON* json,
+void HandleGetComOffsetStatus(IVehicleControl& vc, JsonValue json,
                               httpd_req_t* req) {
   (void)json;
 
@@ -487,12 +524,20 @@ void HandleGetComOffsetStatus(IVehicleControl& vc, cJSON* json,
   }
 }
 
-void HandleStartTest(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+namespace {
+
+constexpr JsonField<TestParams> kStartTestSchema[] = {
+    {"target_accel", &TestParams::target_accel_g},
+    {"duration", &TestParams::duration_sec},
+    {"steering", &TestParams::steering},
+};
+
+}  // namespace
+
+void HandleStartTest(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
   TestParams params;
 
-  cJSON* type_item = cJSON_GetObjectItem(json, "test_type");
-  if (type_item && cJSON_IsString(type_item)) {
-    const char* t = type_item->valuestring;
+  if (const char* t = json["test_type"].AsString()) {
     if (strcmp(t, "circle") == 0)
       params.type = TestType::Circle;
     else if (strcmp(t, "step") == 0)
@@ -501,20 +546,7 @@ void HandleStartTest(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
       params.type = TestType::Straight;
   }
 
-  cJSON* accel_item = cJSON_GetObjectItem(json, "target_accel");
-  if (accel_item && cJSON_IsNumber(accel_item)) {
-    params.target_accel_g = (float)accel_item->valuedouble;
-  }
-
-  cJSON* dur_item = cJSON_GetObjectItem(json, "duration");
-  if (dur_item && cJSON_IsNumber(dur_item)) {
-    params.duration_sec = (float)dur_item->valuedouble;
-  }
-
-  cJSON* steer_item = cJSON_GetObjectItem(json, "steering");
-  if (steer_item && cJSON_IsNumber(steer_item)) {
-    params.steering = (float)steer_item->valuedouble;
-  }
+  JsonBind(json, kStartTestSchema, params);
 
   bool ok = vc.StartTest(params);
 
@@ -541,7 +573,7 @@ void HandleStartTest(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
            ok ? "started" : "failed");
 }
 
-void HandleStopTest(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleStopTest(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
   (void)json;
   vc.StopTest();
 
@@ -556,7 +588,8 @@ void HandleStopTest(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   ESP_LOGI(TAG, "stop_test");
 }
 
-void HandleGetTestStatus(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleGetTestStatus(IVehicleControl& vc, JsonValue json,
+                         httpd_req_t* req) {
   (void)json;
 
   bool active = vc.IsTestActive();
@@ -593,15 +626,57 @@ void HandleGetTestStatus(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   }
 }
 
-void HandleStartSpeedCalib(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
-  cJSON* thr_item = cJSON_GetObjectItem(json, "throttle");
-  cJSON* dur_item = cJSON_GetObjectItem(json, "duration");
+void HandleGetTestResult(IVehicleControl& vc, JsonValue json,
+                         httpd_req_t* req) {
+  (void)json;
+
+  const TestRunner::Result r = vc.GetTestResult();
+  const ManeuverMetrics& m = r.metrics;
+
+  cJSON* reply = cJSON_CreateObject();
+  if (reply) {
+    cJSON_AddStringToObject(reply, "type", "test_result");
+
+    const char* type_str = "straight";
+    if (r.type == TestType::Circle) type_str = "circle";
+    else if (r.type == TestType::Step) type_str = "step";
+    cJSON_AddStringToObject(reply, "test_type", type_str);
+    cJSON_AddBoolToObject(reply, "finished", r.finished);
+    cJSON_AddBoolToObject(reply, "valid", r.valid);
+
+    if (r.finished) {
+      cJSON_AddNumberToObject(reply, "window_s", m.window_s);
+      cJSON_AddNumberToObject(reply, "yaw_rate_mean", m.yaw_rate_mean_dps);
+      cJSON_AddNumberToObject(reply, "yaw_rate_std", m.yaw_rate_std_dps);
+      cJSON_AddNumberToObject(reply, "slip_mean", m.slip_mean_deg);
+      cJSON_AddNumberToObject(reply, "slip_max_abs", m.slip_max_abs_deg);
+      cJSON_AddNumberToObject(reply, "speed_mean", m.speed_mean_ms);
+    }
+    if (r.finished && m.has_step) {
+      cJSON* step = cJSON_AddObjectToObject(reply, "step");
+      if (step) {
+        cJSON_AddBoolToObject(step, "valid", m.step.valid);
+        cJSON_AddNumberToObject(step, "baseline", m.step.baseline_dps);
+        cJSON_AddNumberToObject(step, "steady", m.step.steady_dps);
+        cJSON_AddNumberToObject(step, "peak", m.step.peak_dps);
+        cJSON_AddNumberToObject(step, "rise_time_s", m.step.rise_time_s);
+        cJSON_AddNumberToObject(step, "overshoot_pct", m.step.overshoot_pct);
+        cJSON_AddNumberToObject(step, "settling_time_s",
+                                m.step.settling_time_s);
+      }
+    }
+
+    WsSendJsonReply(req, reply);
+    cJSON_Delete(reply);
+  }
+}
+
+void HandleStartSpeedCalib(IVehicleControl& vc, JsonValue json,
+                           httpd_req_t* req) {
   float throttle = 0.3f;
   float duration = 3.0f;
-  if (thr_item && cJSON_IsNumber(thr_item))
-    throttle = (float)thr_item->valuedouble;
-  if (dur_item && cJSON_IsNumber(dur_item))
-    duration = (float)dur_item->valuedouble;
+  json.Read("throttle", throttle);
+  json.Read("duration", duration);
 
   bool ok = vc.StartSpeedCalibration(throttle, duration);
 
@@ -625,7 +700,8 @@ void HandleStartSpeedCalib(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
            duration, ok ? "started" : "failed");
 }
 
-void HandleStopSpeedCalib(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleStopSpeedCalib(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req) {
   (void)json;
   vc.StopSpeedCalibration();
 
@@ -640,7 +716,7 @@ void HandleStopSpeedCalib(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   ESP_LOGI(TAG, "stop_speed_calib");
 }
 
-void HandleGetSpeedCalibStatus(IVehicleControl& vc, cJSON* json,
+void HandleGetSpeedCalibStatus(IVehicleControl& vc, JsonValue json,
                                 httpd_req_t* req) {
   (void)json;
 
@@ -667,7 +743,7 @@ void HandleGetSpeedCalibStatus(IVehicleControl& vc, cJSON* json,
   }
 }
 
-void HandleRunSelfTest(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleRunSelfTest(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
   (void)json;
 
   auto results = vc.RunSelfTest();
@@ -685,6 +761,7 @@ void HandleRunSelfTest(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
         if (t) {
           cJSON_AddStringToObject(t, "name", item.name);
           cJSON_AddBoolToObject(t, "passed", item.passed);
+          cJSON_AddBoolToObject(t, "fatal", item.fatal);
           cJSON_AddStringToObject(t, "value", item.value);
           cJSON_AddItemToArray(tests_arr, t);
         }
@@ -700,19 +777,17 @@ void HandleRunSelfTest(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
            all_passed ? "ALL PASS" : "FAIL", results.size());
 }
 
-void HandleUdpStreamStart(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleUdpStreamStart(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req) {
   (void)vc;
-  cJSON* ip_item = cJSON_GetObjectItem(json, "ip");
-  cJSON* port_item = cJSON_GetObjectItem(json, "port");
-  cJSON* hz_item = cJSON_GetObjectItem(json, "hz");
-
-  const char* ip = (ip_item && cJSON_IsString(ip_item)) ? ip_item->valuestring
-                                                        : nullptr;
-  uint16_t port = (port_item && cJSON_IsNumber(port_item))
-                      ? (uint16_t)port_item->valueint
-                      : 5555;
-  uint8_t hz = (hz_item && cJSON_IsNumber(hz_item)) ? (uint8_t)hz_item->valueint
-                                                    : 100;
+  const char* ip = nullptr;
+  int32_t port_arg = 5555;
+  int32_t hz_arg = 100;
+  json.Read("ip", ip);
+  json.Read("port", port_arg);
+  json.Read("hz", hz_arg);
+  uint16_t port = (uint16_t)port_arg;
+  uint8_t hz = (uint8_t)hz_arg;
 
   cJSON* reply = cJSON_CreateObject();
   if (reply) {
@@ -739,7 +814,8 @@ void HandleUdpStreamStart(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
            hz);
 }
 
-void HandleUdpStreamStop(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleUdpStreamStop(IVehicleControl& vc, JsonValue json,
+                         httpd_req_t* req) {
   (void)vc;
   (void)json;
   UdpTelemStop();
@@ -755,7 +831,7 @@ void HandleUdpStreamStop(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   ESP_LOGI(TAG, "udp_stream_stop");
 }
 
-void HandleUdpStreamStatus(IVehicleControl& vc, cJSON* json,
+void HandleUdpStreamStatus(IVehicleControl& vc, JsonValue json,
                            httpd_req_t* req) {
   (void)vc;
   (void)json;
@@ -769,16 +845,103 @@ void HandleUdpStreamStatus(IVehicleControl& vc, cJSON* json,
     cJSON_AddNumberToObject(reply, "hz", UdpTelemGetHz());
     cJSON_AddNumberToObject(reply, "seq", (double)UdpTelemGetSeq());
     cJSON_AddNumberToObject(reply, "dropped", (double)UdpTelemGetDropped());
+
+    const UdpTelemTargetSet targets = UdpTelemGetTargets();
+    char ip[16];
+    if (targets.Group()) {
+      FormatIpv4(targets.Group()->addr, ip, sizeof(ip));
+      cJSON_AddStringToObject(reply, "group", ip);
+      cJSON_AddNumberToObject(reply, "group_port", targets.Group()->port);
+    } else {
+      cJSON_AddNullToObject(reply, "group");
+    }
+    cJSON* list = cJSON_AddArrayToObject(reply, "targets");
+    for (size_t i = 0; list && i < targets.UnicastCount(); ++i) {
+      cJSON* t = cJSON_CreateObject();
+      if (!t) break;
+      FormatIpv4(targets.Unicast(i).addr, ip, sizeof(ip));
+      cJSON_AddStringToObject(t, "ip", ip);
+      cJSON_AddNumberToObject(t, "port", targets.Unicast(i).port);
+      cJSON_AddItemToArray(list, t);
+    }
     WsSendJsonReply(req, reply);
     cJSON_Delete(reply);
   }
 }
 
-void HandleCalibrateMag(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
-  cJSON* action_item = cJSON_GetObjectItem(json, "action");
-  const char* action = (action_item && cJSON_IsString(action_item))
-                           ? action_item->valuestring
-                           : "";
+void HandleGetUdpCmd(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
+  (void)vc;
+  (void)json;
+
+  const UdpCommandStats stats = UdpCmdGetStats();
+  cJSON* reply = cJSON_CreateObject();
+  if (reply) {
+    cJSON_AddStringToObject(reply, "type", "udp_cmd_info");
+    cJSON_AddNumberToObject(reply, "port", config::UdpCommandConfig::kPort);
+    cJSON_AddNumberToObject(reply, "token", (double)UdpCmdGetToken());
+    cJSON_AddNumberToObject(reply, "accepted", (double)stats.accepted);
+    cJSON_AddNumberToObject(reply, "duplicate", (double)stats.duplicate);
+    cJSON_AddNumberToObject(reply, "stale", (double)stats.stale);
+    cJSON_AddNumberToObject(reply, "bad_token", (double)stats.bad_token);
+    cJSON_AddNumberToObject(reply, "malformed", (double)stats.malformed);
+    cJSON_AddNumberToObject(reply, "resyncs", (double)stats.resyncs);
+    WsSendJsonReply(req, reply);
+    cJSON_Delete(reply);
+  }
+}
+
+void HandleGetJsonArena(IVehicleControl& vc, JsonValue json,
+                        httpd_req_t* req) {
+  (void)vc;
+  bool reset = false;
+  json.Read("reset", reset);
+
+  const JsonArenaStats stats = JsonArenaGetStats();
+  cJSON* reply = cJSON_CreateObject();
+  if (reply) {
+    cJSON_AddStringToObject(reply, "type", "json_arena_stats");
+    cJSON_AddNumberToObject(reply, "scopes", (double)stats.scopes);
+    cJSON_AddNumberToObject(reply, "arena_allocs", (double)stats.arena_allocs);
+    cJSON_AddNumberToObject(reply, "heap_fallbacks",
+                            (double)stats.heap_fallbacks);
+    cJSON_AddNumberToObject(reply, "heap_fallback_bytes",
+                            (double)stats.heap_fallback_bytes);
+    cJSON_AddNumberToObject(reply, "unscoped_allocs",
+                            (double)stats.unscoped_allocs);
+    cJSON_AddNumberToObject(reply, "high_water", (double)stats.high_water);
+    cJSON_AddNumberToObject(reply, "capacity", (double)stats.capacity);
+    // Фрагментация внутренней кучи: свободно всего vs крупнейший блок
+    cJSON_AddNumberToObject(
+        reply, "heap_internal_free",
+        (double)heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
+    cJSON_AddNumberToObject(
+        reply, "heap_internal_largest",
+        (double)heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL));
+    WsSendJsonReply(req, reply);
+    cJSON_Delete(reply);
+  }
+  if (reset) JsonArenaResetStats();
+}
+
+void HandleGetMem(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
+  (void)vc;
+  bool log = false;
+  json.Read("log", log);
+
+  MemMonitorSample();
+  cJSON* reply = MemMonitorBuildJson();
+  if (reply) {
+    cJSON_AddStringToObject(reply, "type", "mem_stats");
+    WsSendJsonReply(req, reply);
+    cJSON_Delete(reply);
+  }
+  // Таблица рекомендаций по стекам — в лог (монитор последовательного порта)
+  if (log) MemMonitorLogReport();
+}
+
+void HandleCalibrateMag(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
+  const char* action = "";
+  json.Read("action", action);
 
   bool ok = true;
   if (strcmp(action, "start") == 0) {
@@ -809,7 +972,7 @@ void HandleCalibrateMag(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   }
 }
 
-void HandleGetMagCalibStatus(IVehicleControl& vc, cJSON* json,
+void HandleGetMagCalibStatus(IVehicleControl& vc, JsonValue json,
                               httpd_req_t* req) {
   (void)json;
 
@@ -823,7 +986,8 @@ void HandleGetMagCalibStatus(IVehicleControl& vc, cJSON* json,
   }
 }
 
-void HandleResetHeadingRef(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
+void HandleResetHeadingRef(IVehicleControl& vc, JsonValue json,
+                           httpd_req_t* req) {
   (void)json;
   vc.ResetHeadingRef();
 
@@ -839,4 +1003,257 @@ void HandleResetHeadingRef(IVehicleControl& vc, cJSON* json, httpd_req_t* req) {
   ESP_LOGI(TAG, "reset_heading_ref");
 }
 
+void HandleBenchFilters(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
+  (void)vc;
+  // Пакет по умолчанию и предел — kFilterBenchMaxSamples: 1000 семплов по
+  // 20 float (16 векторов + SysIdSample) ≈ 80 КБ heap в задаче httpd
+  constexpr size_t kMax = rc_vehicle::kFilterBenchMaxSamples;
+  const double samples_arg = std::min(
+      json["samples"].AsDouble().value_or(0.0), static_cast<double>(kMax));
+  const size_t samples =
+      samples_arg > 0 ? static_cast<size_t>(samples_arg) : kMax;
+
+  const auto r = RunFilterBenchmark(samples);
+
+  cJSON* reply = cJSON_CreateObject();
+  if (reply) {
+    cJSON_AddStringToObject(reply, "type", "bench_filters_result");
+    cJSON_AddNumberToObject(reply, "samples", r.samples);
+    cJSON_AddNumberToObject(reply, "madgwick_single_sps",
+                            r.madgwick_single_sps);
+    cJSON_AddNumberToObject(reply, "madgwick_batch_sps", r.madgwick_batch_sps);
+    cJSON_AddNumberToObject(reply, "ekf_single_sps", r.ekf_single_sps);
+    cJSON_AddNumberToObject(reply, "ekf_batch_sps", r.ekf_batch_sps);
+    cJSON_AddNumberToObject(reply, "sysid_sps", r.sysid_sps);
+    cJSON_AddNumberToObject(reply, "sysid_max_tick_cyc",
+                            r.sysid_max_tick_cycles);
+    cJSON_AddNumberToObject(reply, "math_std_sps", r.math_std_sps);
+    cJSON_AddNumberToObject(reply, "math_fast_sps", r.math_fast_sps);
+    cJSON_AddBoolToObject(reply, "outputs_match", r.outputs_match);
+    WsSendJsonReply(req, reply);
+    cJSON_Delete(reply);
+  }
+
+  ESP_LOGI(TAG,
+           "bench_filters n=%u: madgwick %.0f/%.0f S/s, ekf %.0f/%.0f S/s "
+           "(single/batch), math %.0f/%.0f S/s (std/fast), match=%d",
+           static_cast<unsigned>(r.samples), r.madgwick_single_sps,
+           r.madgwick_batch_sps, r.ekf_single_sps, r.ekf_batch_sps,
+           r.math_std_sps, r.math_fast_sps, r.outputs_match);
+}
+
+namespace {
+
+const char* ShadowStateName(ShadowState state) {
+  switch (state) {
+    case ShadowState::Off:
+      return "off";
+    case ShadowState::Running:
+      return "running";
+    case ShadowState::Shed:
+      return "shed";
+  }
+  return "unknown";
+}
+
+void AddShadowStatsToJson(cJSON* obj, const ShadowStats& st) {
+  cJSON_AddStringToObject(obj, "state", ShadowStateName(st.state));
+  cJSON_AddNumberToObject(obj, "run_ticks", st.run_ticks);
+  cJSON_AddNumberToObject(obj, "shed_ticks", st.shed_ticks);
+  cJSON_AddNumberToObject(obj, "shed_events", st.shed_events);
+  cJSON_AddNumberToObject(obj, "rms_d_throttle", st.rms_d_throttle);
+  cJSON_AddNumberToObject(obj, "rms_d_steering", st.rms_d_steering);
+  cJSON_AddNumberToObject(obj, "max_d_throttle", st.max_abs_d_throttle);
+  cJSON_AddNumberToObject(obj, "max_d_steering", st.max_abs_d_steering);
+  cJSON_AddNumberToObject(obj, "cost_avg_cyc", st.cost.Mean());
+  cJSON_AddNumberToObject(obj, "cost_max_cyc", st.cost.max);
+  cJSON_AddNumberToObject(obj, "cost_pm", st.cost_permille);
+  cJSON_AddNumberToObject(obj, "load_pct", st.loop_load_pct);
+}
+
+void AddSysIdToJson(cJSON* obj, IVehicleControl& vc) {
+  const SysIdEstimate e = vc.GetSysIdEstimate();
+  cJSON_AddNumberToObject(obj, "steer_gain_dps", e.steer_gain_dps);
+  cJSON_AddNumberToObject(obj, "steer_tau_s", e.steer_tau_s);
+  cJSON_AddBoolToObject(obj, "steer_valid", e.steer_valid);
+  cJSON_AddNumberToObject(obj, "steer_updates", e.steer_updates);
+  cJSON_AddNumberToObject(obj, "speed_gain_ms", e.speed_gain_ms);
+  cJSON_AddNumberToObject(obj, "speed_tau_s", e.speed_tau_s);
+  cJSON_AddBoolToObject(obj, "speed_valid", e.speed_valid);
+  cJSON_AddNumberToObject(obj, "speed_updates", e.speed_updates);
+  cJSON_AddBoolToObject(obj, "apply", vc.IsSysIdApplyEnabled());
+  cJSON_AddNumberToObject(
+      obj, "steer_to_yaw_rate_dps",
+      vc.GetStabilizationConfig().yaw_rate.steer_to_yaw_rate_dps);
+}
+
+void AddAllanFitToJson(cJSON* obj, const AllanNoiseFit& f) {
+  cJSON_AddBoolToObject(obj, "valid", f.valid);
+  if (!f.valid) return;
+  cJSON_AddNumberToObject(obj, "arw", f.arw);
+  cJSON_AddNumberToObject(obj, "bias", f.bias_instability);
+  cJSON_AddNumberToObject(obj, "tau_bias_s", f.tau_bias_s);
+  cJSON_AddBoolToObject(obj, "bias_at_end", f.bias_at_end);
+  if (f.has_rrw) cJSON_AddNumberToObject(obj, "rrw", f.rrw);
+}
+
+void AddAllanReportToJson(cJSON* obj, const AllanReport& r) {
+  static constexpr const char* kAxisNames[AllanReport::kAxes] = {
+      "gx", "gy", "gz", "ax", "ay", "az"};
+  cJSON_AddNumberToObject(obj, "parked_s", r.parked_s);
+  cJSON_AddBoolToObject(obj, "parked", r.parked_now);
+
+  // Оси: {"gz": {"tau": [...], "adev": [...], "fit": {...}}}; dps и g
+  cJSON* axes = cJSON_AddObjectToObject(obj, "axes");
+  for (size_t i = 0; axes && i < AllanReport::kAxes; ++i) {
+    cJSON* axis = cJSON_AddObjectToObject(axes, kAxisNames[i]);
+    if (!axis) break;
+    cJSON* tau = cJSON_AddArrayToObject(axis, "tau");
+    cJSON* adev = cJSON_AddArrayToObject(axis, "adev");
+    for (size_t k = 0; tau && adev && k < r.points[i]; ++k) {
+      cJSON_AddItemToArray(tau, cJSON_CreateNumber(r.curves[i][k].tau_s));
+      cJSON_AddItemToArray(adev, cJSON_CreateNumber(r.curves[i][k].adev));
+    }
+    cJSON* fit = cJSON_AddObjectToObject(axis, "fit");
+    if (fit) AddAllanFitToJson(fit, r.fits[i]);
+  }
+
+  // Патч конфигурации: поля set_stab_config и VehicleEkfNoiseParams
+  const NoiseTuning& t = r.tuning;
+  cJSON* patch = cJSON_AddObjectToObject(obj, "patch");
+  if (!patch) return;
+  if (t.gyro_valid) {
+    cJSON* filter = cJSON_AddObjectToObject(patch, "filter");
+    if (filter) {
+      cJSON_AddNumberToObject(filter, "madgwick_beta", t.madgwick_beta);
+    }
+  }
+  cJSON* ekf = cJSON_AddObjectToObject(patch, "ekf_noise");
+  if (!ekf) return;
+  if (t.gyro_valid) cJSON_AddNumberToObject(ekf, "r_gz", t.r_gz);
+  if (t.accel_valid) cJSON_AddNumberToObject(ekf, "q_v_floor", t.q_v_floor);
+}
+
+}  // namespace
+
+void HandleStartShadowStab(IVehicleControl& vc, JsonValue json,
+                           httpd_req_t* req) {
+  // Кандидат = живая конфигурация + переданные поля (как set_stab_config).
+  // Предустановки нового режима применяются до полей из JSON, чтобы
+  // переданные коэффициенты не затирались.
+  StabilizationConfig cfg = vc.GetStabilizationConfig();
+  if (const auto mode_item = json["mode"].AsInt()) {
+    const auto mode = static_cast<DriveMode>(*mode_item);
+    if (mode != cfg.mode) {
+      cfg.mode = mode;
+      cfg.ApplyModeDefaults();
+    }
+  }
+  StabilizationConfigFromJson(cfg, json);
+
+  const bool ok = vc.StartShadowStabilization(cfg);
+
+  cJSON* reply = ok ? StabilizationConfigToJson(vc.GetShadowCandidate())
+                    : cJSON_CreateObject();
+  if (reply) {
+    cJSON_AddStringToObject(reply, "type", "start_shadow_stab_ack");
+    cJSON_AddBoolToObject(reply, "ok", ok);
+    WsSendJsonReply(req, reply);
+    cJSON_Delete(reply);
+  }
+
+  ESP_LOGI(TAG, "start_shadow_stab -> %s (mode=%s enabled=%d kp=%.3f)",
+           ok ? "OK" : "FAILED", DriveModeToString(cfg.mode), cfg.enabled,
+           cfg.yaw_rate.pid.kp);
+}
+
+void HandleStopShadowStab(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req) {
+  (void)json;
+
+  // Итог сравнения — до остановки (Stop сбрасывает статистику на тике)
+  const ShadowStats st = vc.GetShadowStats();
+  vc.StopShadowStabilization();
+
+  cJSON* reply = cJSON_CreateObject();
+  if (reply) {
+    cJSON_AddStringToObject(reply, "type", "stop_shadow_stab_ack");
+    cJSON_AddBoolToObject(reply, "ok", true);
+    AddShadowStatsToJson(reply, st);
+    WsSendJsonReply(req, reply);
+    cJSON_Delete(reply);
+  }
+}
+
+void HandleGetShadowStats(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req) {
+  (void)json;
+
+  cJSON* reply = cJSON_CreateObject();
+  if (reply) {
+    cJSON_AddStringToObject(reply, "type", "shadow_stats");
+    AddShadowStatsToJson(reply, vc.GetShadowStats());
+    WsSendJsonReply(req, reply);
+    cJSON_Delete(reply);
+  }
+}
+
+void HandleGetSysId(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
+  (void)json;
+
+  cJSON* reply = cJSON_CreateObject();
+  if (reply) {
+    cJSON_AddStringToObject(reply, "type", "sysid");
+    AddSysIdToJson(reply, vc);
+    WsSendJsonReply(req, reply);
+    cJSON_Delete(reply);
+  }
+}
+
+void HandleSetSysId(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
+  // {"apply": bool} — подтягивать yaw-регулятор к оценке;
+  // {"reset": true} — начать идентификацию заново (например, смена покрытия)
+  if (const auto apply = json["apply"].AsBool()) {
+    vc.SetSysIdApply(*apply);
+  }
+  if (json["reset"].AsBool().value_or(false)) {
+    vc.ResetSysId();
+  }
+
+  cJSON* reply = cJSON_CreateObject();
+  if (reply) {
+    cJSON_AddStringToObject(reply, "type", "set_sysid_ack");
+    cJSON_AddBoolToObject(reply, "ok", true);
+    AddSysIdToJson(reply, vc);
+    WsSendJsonReply(req, reply);
+    cJSON_Delete(reply);
+  }
+
+  ESP_LOGI(TAG, "set_sysid apply=%d", vc.IsSysIdApplyEnabled());
+}
+
+void HandleGetAllan(IVehicleControl& vc, JsonValue json, httpd_req_t* req) {
+  // {"reset": true} — начать накопление заново (другой датчик, прогрев)
+  if (json["reset"].AsBool().value_or(false)) {
+    vc.ResetAllan();
+    ESP_LOGI(TAG, "get_allan: reset");
+  }
+
+  // Снимок ~3 КБ — в куче: стек httpd занят приёмным буфером WS
+  std::unique_ptr<AllanReport> report(new (std::nothrow) AllanReport());
+  if (!report) {
+    ESP_LOGE(TAG, "get_allan: no memory");
+    return;
+  }
+  vc.GetAllanReport(*report);
+
+  cJSON* reply = cJSON_CreateObject();
+  if (reply) {
+    cJSON_AddStringToObject(reply, "type", "allan");
+    AddAllanReportToJson(reply, *report);
+    WsSendJsonReply(req, reply);
+    cJSON_Delete(reply);
+  }
+}
+
 }  // namespace rc_vehicle
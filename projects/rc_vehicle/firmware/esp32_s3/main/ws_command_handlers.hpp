@@ -1,7 +1,7 @@
 #pragma once
 
-#include "cJSON.h"
 #include "esp_http_server.h"
+#include "json_reader.hpp"
 
 namespace rc_vehicle {
 
@@ -14,40 +14,64 @@ class IVehicleControl;
  * instead of accessing the global singleton directly.
  */
 
-void HandleCalibrateImu(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleGetCalibStatus(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleSetForwardDirection(IVehicleControl& vc, cJSON* json,
+void HandleCalibrateImu(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleGetCalibStatus(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req);
+void HandleSetForwardDirection(IVehicleControl& vc, JsonValue json,
                                httpd_req_t* req);
-void HandleGetStabConfig(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleSetStabConfig(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleGetLogInfo(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleGetLogData(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleClearLog(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleSetKidsPreset(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleGetKidsPresets(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleToggleKidsMode(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleCalibrateSteeringTrim(IVehicleControl& vc, cJSON* json,
+void HandleGetStabConfig(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleSetStabConfig(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleGetLogInfo(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleGetLogData(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleLogSince(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleClearLog(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleSetKidsPreset(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleGetKidsPresets(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req);
+void HandleToggleKidsMode(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req);
+void HandleCalibrateSteeringTrim(IVehicleControl& vc, JsonValue json,
                                  httpd_req_t* req);
-void HandleGetSteeringTrimStatus(IVehicleControl& vc, cJSON* json,
+void HandleGetSteeringTrimStatus(IVehicleControl& vc, JsonValue json,
                                  httpd_req_t* req);
-void HandleCalibrateComOffset(IVehicleControl& vc, cJSON* json,
+void HandleCalibrateComOffset(IVehicleControl& vc, JsonValue json,
                               httpd_req_t* req);
-void HandleGetComOffsetStatus(IVehicleControl& vc, cJSON* json,
+void HandleGetComOffsetStatus(IVehicleControl& vc, JsonValue json,
                               httpd_req_t* req);
-void HandleStartTest(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleStopTest(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleGetTestStatus(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleStartSpeedCalib(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleStopSpeedCalib(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleGetSpeedCalibStatus(IVehicleControl& vc, cJSON* json,
+void HandleStartTest(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleStopTest(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleGetTestStatus(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleGetTestResult(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleStartSpeedCalib(IVehicleControl& vc, JsonValue json,
+                           httpd_req_t* req);
+void HandleStopSpeedCalib(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req);
+void HandleGetSpeedCalibStatus(IVehicleControl& vc, JsonValue json,
                                 httpd_req_t* req);
-void HandleRunSelfTest(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleUdpStreamStart(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleUdpStreamStop(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleUdpStreamStatus(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleCalibrateMag(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
-void HandleGetMagCalibStatus(IVehicleControl& vc, cJSON* json,
+void HandleRunSelfTest(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleUdpStreamStart(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req);
+void HandleUdpStreamStop(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleUdpStreamStatus(IVehicleControl& vc, JsonValue json,
+                           httpd_req_t* req);
+void HandleGetUdpCmd(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleGetJsonArena(IVehicleControl& vc, JsonValue json,
+                        httpd_req_t* req);
+void HandleGetMem(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleCalibrateMag(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleGetMagCalibStatus(IVehicleControl& vc, JsonValue json,
                              httpd_req_t* req);
-void HandleResetHeadingRef(IVehicleControl& vc, cJSON* json, httpd_req_t* req);
+void HandleResetHeadingRef(IVehicleControl& vc, JsonValue json,
+                           httpd_req_t* req);
+void HandleBenchFilters(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleStartShadowStab(IVehicleControl& vc, JsonValue json,
+                           httpd_req_t* req);
+void HandleStopShadowStab(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req);
+void HandleGetShadowStats(IVehicleControl& vc, JsonValue json,
+                          httpd_req_t* req);
+void HandleGetSysId(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleSetSysId(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
+void HandleGetAllan(IVehicleControl& vc, JsonValue json, httpd_req_t* req);
 
 }  // namespace rc_vehicle
@@ -9,19 +9,39 @@ static const char* TAG = "ws_cmd_registry";
 
 namespace rc_vehicle {
 
-void WsCommandRegistry::Register(const std::string& type,
-                                 WsJsonHandler handler) {
-  if (handler) {
-    handlers_[type] = std::move(handler);
-    ESP_LOGI(TAG, "Registered handler for command type: %s", type.c_str());
-  } else {
+bool WsCommandRegistry::Register(const char* type, WsJsonHandler handler) {
+  if (!type || !handler) {
     ESP_LOGW(TAG, "Attempted to register null handler for type: %s",
-             type.c_str());
+             type ? type : "(null)");
+    return false;
+  }
+  // Повторная регистрация заменяет обработчик
+  for (size_t i = 0; i < count_; ++i) {
+    if (std::strcmp(handlers_[i].type, type) == 0) {
+      handlers_[i].handler = handler;
+      return true;
+    }
+  }
+  if (count_ >= kMaxHandlers) {
+    ESP_LOGE(TAG, "Handler table full (%zu), dropped: %s", kMaxHandlers,
+             type);
+    return false;
+  }
+  handlers_[count_++] = {type, handler};
+  ESP_LOGI(TAG, "Registered handler for command type: %s", type);
+  return true;
+}
+
+const WsCommandRegistry::Entry* WsCommandRegistry::Find(
+    const char* type) const {
+  for (size_t i = 0; i < count_; ++i) {
+    if (std::strcmp(handlers_[i].type, type) == 0) return &handlers_[i];
   }
+  return nullptr;
 }
 
 bool WsCommandRegistry::Handle(IVehicleControl& vc, const char* type,
-                               cJSON* json, httpd_req_t* req) {
+                               JsonValue json, httpd_req_t* req) {
   if (!type) {
     ESP_LOGW(TAG, "Handle called with null type");
     return false;
@@ -42,10 +62,9 @@ bool WsCommandRegistry::Handle(IVehicleControl& vc, const char* type,
     return true;  // Команда обработана (отклонена)
   }
 
-  auto it = handlers_.find(type);
-  if (it != handlers_.end()) {
+  if (const Entry* e = Find(type)) {
     ESP_LOGD(TAG, "Handling command: %s", type);
-    it->second(vc, json, req);
+    e->handler(vc, json, req);
     return true;
   }
 
@@ -57,7 +76,7 @@ bool WsCommandRegistry::HasHandler(const char* type) const {
   if (!type) {
     return false;
   }
-  return handlers_.find(type) != handlers_.end();
+  return Find(type) != nullptr;
 }
 
 void WsSendJsonReply(httpd_req_t* req, cJSON* reply) {
@@ -80,10 +99,29 @@ void WsSendJsonReply(httpd_req_t* req, cJSON* reply) {
       ESP_LOGW(TAG, "Failed to send WebSocket frame: %s", esp_err_to_name(ret));
     }
 
-    free(str);
+    cJSON_free(str);
   } else {
     ESP_LOGE(TAG, "Failed to serialize JSON reply");
   }
 }
 
+void WsSendBinaryReply(httpd_req_t* req, const void* data, size_t len) {
+  if (!req || !data) {
+    ESP_LOGW(TAG, "WsSendBinaryReply called with null argument");
+    return;
+  }
+
+  httpd_ws_frame_t pkt = {};
+  pkt.final = true;
+  pkt.fragmented = false;
+  pkt.type = HTTPD_WS_TYPE_BINARY;
+  pkt.payload = static_cast<uint8_t*>(const_cast<void*>(data));
+  pkt.len = len;
+
+  esp_err_t ret = httpd_ws_send_frame(req, &pkt);
+  if (ret != ESP_OK) {
+    ESP_LOGW(TAG, "Failed to send WebSocket frame: %s", esp_err_to_name(ret));
+  }
+}
+
 }  // namespace rc_vehicle
\ No newline at end of file
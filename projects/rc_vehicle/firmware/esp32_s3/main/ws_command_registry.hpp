@@ -1,11 +1,11 @@
 #pragma once
 
-#include <functional>
-#include <string>
-#include <unordered_map>
+#include <array>
+#include <cstddef>
 
 #include "cJSON.h"
 #include "esp_http_server.h"
+#include "json_reader.hpp"
 
 namespace rc_vehicle {
 
@@ -16,11 +16,12 @@ class IVehicleControl;
  * @brief Handler function type for WebSocket JSON commands
  *
  * @param vc Reference to the vehicle control interface (DI)
- * @param json The parsed JSON object containing the command
+ * @param json The command object, parsed in place in the receive buffer
+ *             (valid only for the duration of the call)
  * @param req The HTTP request handle for sending responses
  */
-using WsJsonHandler =
-    std::function<void(IVehicleControl& vc, cJSON* json, httpd_req_t* req)>;
+using WsJsonHandler = void (*)(IVehicleControl& vc, JsonValue json,
+                              httpd_req_t* req);
 
 /**
  * @brief Registry for WebSocket JSON command handlers
@@ -29,6 +30,10 @@ using WsJsonHandler =
  * This replaces the large if-else chain with a more extensible registry-based
  * approach.
  *
+ * Storage is a fixed-size table of (name, function pointer) pairs with linear
+ * lookup: no heap, no std::function/std::unordered_map instantiations in the
+ * image. Names must outlive the registry (string literals).
+ *
  * Example usage:
  * @code
  * WsCommandRegistry registry;
@@ -44,6 +49,9 @@ class WsCommandRegistry {
   WsCommandRegistry() = default;
   ~WsCommandRegistry() = default;
 
+  /// Table capacity; Register() rejects new types beyond this
+  static constexpr size_t kMaxHandlers = 48;
+
   // Non-copyable, non-movable (contains function pointers)
   WsCommandRegistry(const WsCommandRegistry&) = delete;
   WsCommandRegistry& operator=(const WsCommandRegistry&) = delete;
@@ -53,10 +61,11 @@ class WsCommandRegistry {
   /**
    * @brief Register a handler for a specific command type
    *
-   * @param type Command type string (e.g., "calibrate_imu")
+   * @param type Command type string with static storage (e.g., a literal)
    * @param handler Function to handle this command type
+   * @return false if handler is null or the table is full
    */
-  void Register(const std::string& type, WsJsonHandler handler);
+  bool Register(const char* type, WsJsonHandler handler);
 
   /**
    * @brief Handle a command by dispatching to the registered handler
@@ -67,7 +76,7 @@ class WsCommandRegistry {
    * @param req HTTP request handle
    * @return true if handler was found and executed, false otherwise
    */
-  bool Handle(IVehicleControl& vc, const char* type, cJSON* json,
+  bool Handle(IVehicleControl& vc, const char* type, JsonValue json,
               httpd_req_t* req);
 
   /**
@@ -83,10 +92,18 @@ class WsCommandRegistry {
    *
    * @return Number of registered command handlers
    */
-  size_t GetHandlerCount() const { return handlers_.size(); }
+  size_t GetHandlerCount() const { return count_; }
 
  private:
-  std::unordered_map<std::string, WsJsonHandler> handlers_;
+  struct Entry {
+    const char* type;
+    WsJsonHandler handler;
+  };
+
+  const Entry* Find(const char* type) const;
+
+  std::array<Entry, kMaxHandlers> handlers_{};
+  size_t count_{0};
 };
 
 /**
@@ -97,4 +114,13 @@ class WsCommandRegistry {
  */
 void WsSendJsonReply(httpd_req_t* req, cJSON* reply);
 
+/**
+ * @brief Utility function to send a binary reply via WebSocket
+ *
+ * @param req HTTP request handle
+ * @param data Payload (owned by caller)
+ * @param len Payload size in bytes
+ */
+void WsSendBinaryReply(httpd_req_t* req, const void* data, size_t len);
+
 }  // namespace rc_vehicle
\ No newline at end of file
@@ -0,0 +1,446 @@
+/**
+ * @file imu_allan_main.cpp
+ * @brief imu_allan — характеристика шумов IMU и магнитометра по дисперсии
+ * Аллана из длинных логов на стоянке (log.bin, GET /api/log.bin).
+ *
+ * Кадры режутся на непрерывные участки стоянки: разрыв ts_ms или движение
+ * (газ / скорость / yaw rate выше порогов AllanConfig, как на устройстве).
+ * Для каждой оси gx..az, mx..mz считается перекрывающаяся σ(τ)
+ * (allan_variance.hpp): O(n) на точку, точки τ логарифмически — O(n log n)
+ * на ось; задания (ось, m) разбирают --threads потоков, суммы участков
+ * складываются. По кривым — ARW / bias instability / RRW и патч
+ * конфигурации: beta Madgwick (WS set_stab_config) и VehicleEkfNoiseParams.
+ *
+ *   imu_allan [--threads N] [--from MS] [--to MS] [--imu-dt-ms D]
+ *             [--curve OUT.csv] [--patch OUT.json] LOG.bin...
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "allan_variance.hpp"
+#include "config.hpp"
+#include "log_convert.hpp"
+#include "telemetry_log.hpp"
+
+using namespace rc_vehicle;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Options {
+  unsigned threads{0};  ///< 0 — по числу ядер
+  uint32_t from_ms{0};
+  uint32_t to_ms{UINT32_MAX};
+  /// Шаг отсчётов IMU на устройстве: в лог пишется каждый N-й (без
+  /// усреднения), белый шум отсчёта — как у исходного ряда
+  double imu_dt_ms{config::ControlLoopConfig::kPeriodMs};
+  unsigned points_per_decade{config::AllanConfig::kPointsPerDecade};
+  fs::path curve_out;
+  fs::path patch_out;
+  std::vector<fs::path> inputs;
+};
+
+/** Оси в порядке вывода; первые 6 — как AllanReport на устройстве. */
+enum Axis : size_t { kGx, kGy, kGz, kAx, kAy, kAz, kMx, kMy, kMz, kAxes };
+constexpr const char* kAxisNames[kAxes] = {"gx", "gy", "gz", "ax", "ay",
+                                           "az", "mx", "my", "mz"};
+constexpr const char* kAxisUnits[kAxes] = {"dps", "dps", "dps", "g", "g",
+                                           "g",   "mG",  "mG",  "mG"};
+
+/** Участок стоянки: непрерывные отсчёты всех осей. */
+struct Segment {
+  std::vector<float> y[kAxes];
+  std::vector<double> theta[kAxes];
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Чтение и нарезка
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool ReadFile(const fs::path& path, std::vector<uint8_t>& out) {
+  std::ifstream f(path, std::ios::binary | std::ios::ate);
+  if (!f) return false;
+  out.resize(static_cast<size_t>(f.tellg()));
+  f.seekg(0);
+  return static_cast<bool>(
+      f.read(reinterpret_cast<char*>(out.data()),
+             static_cast<std::streamsize>(out.size())));
+}
+
+/** Индекс поля реестра по имени; kTelemetryLogFieldCount — нет. */
+size_t FieldIndex(std::string_view name) {
+  for (size_t i = 0; i < kTelemetryLogFieldCount; ++i) {
+    if (name == kTelemetryLogFields[i].name) return i;
+  }
+  return kTelemetryLogFieldCount;
+}
+
+std::vector<float> FloatColumn(const LogBinView& view, std::string_view name) {
+  const size_t field = FieldIndex(name);
+  if (field >= LogFieldCountForFrameSize(view.frame_size)) return {};
+  std::vector<float> col(view.frame_count);
+  ExtractLogColumn(view, field, 0, view.frame_count, col.data());
+  return col;
+}
+
+/** Номинальный шаг кадров: медиана положительных Δts. */
+uint32_t MedianStepMs(const std::vector<uint32_t>& ts) {
+  std::vector<uint32_t> d;
+  d.reserve(ts.size());
+  for (size_t i = 1; i < ts.size(); ++i) {
+    if (ts[i] > ts[i - 1]) d.push_back(ts[i] - ts[i - 1]);
+  }
+  if (d.empty()) return 0;
+  std::nth_element(d.begin(), d.begin() + d.size() / 2, d.end());
+  return d[d.size() / 2];
+}
+
+struct LoadStats {
+  size_t frames{0};
+  size_t used{0};
+  uint32_t step_ms{0};
+  double mag_horizontal_sum{0.0};
+  size_t mag_count{0};
+};
+
+/**
+ * @brief Добавить участки стоянки файла в segments.
+ *
+ * Участок рвётся на разрыве ts_ms (шаг не ±½ номинального), вне
+ * [from, to] и при движении.
+ */
+bool LoadSegments(const fs::path& path, const Options& opt,
+                  std::vector<Segment>& segments, LoadStats& st) {
+  std::vector<uint8_t> data;
+  if (!ReadFile(path, data)) {
+    std::fprintf(stderr, "%s: %s\n", path.c_str(), std::strerror(errno));
+    return false;
+  }
+  LogBinView view;
+  const LogDecodeError err = ParseLogBinView(data.data(), data.size(), view);
+  if (!view.frames) {
+    std::fprintf(stderr, "%s: %s\n", path.c_str(),
+                 LogDecodeErrorToString(err));
+    return false;
+  }
+
+  std::vector<uint32_t> ts(view.frame_count);
+  for (size_t i = 0; i < ts.size(); ++i) ts[i] = LogFrameTimestamp(view, i);
+  const uint32_t step = MedianStepMs(ts);
+  if (step == 0) {
+    std::fprintf(stderr, "%s: too few frames\n", path.c_str());
+    return false;
+  }
+  if (st.step_ms != 0 && st.step_ms != step) {
+    std::fprintf(stderr, "%s: frame step %u ms != %u ms of previous logs\n",
+                 path.c_str(), step, st.step_ms);
+    return false;
+  }
+  st.step_ms = step;
+
+  std::vector<float> axes[kAxes];
+  for (size_t a = 0; a < kAxes; ++a) axes[a] = FloatColumn(view, kAxisNames[a]);
+  if (axes[kGz].empty() || axes[kAz].empty()) {
+    std::fprintf(stderr, "%s: no IMU fields\n", path.c_str());
+    return false;
+  }
+  const std::vector<float> throttle = FloatColumn(view, "cmd_throttle");
+  const std::vector<float> speed = FloatColumn(view, "speed_ms");
+  const std::vector<float> yaw_rate = FloatColumn(view, "yaw_rate_dps");
+  // Магнитометр выключен — в кадре нули: ось не считается
+  const bool has_mag =
+      !axes[kMx].empty() &&
+      std::any_of(axes[kMx].begin(), axes[kMx].end(),
+                  [](float v) { return v != 0.0f; });
+
+  using Cfg = config::AllanConfig;
+  auto parked = [&](size_t i) {
+    const auto below = [i](const std::vector<float>& c, float limit) {
+      return c.empty() || std::fabs(c[i]) < limit;
+    };
+    return below(throttle, Cfg::kParkedMaxThrottle) &&
+           below(speed, Cfg::kParkedMaxSpeedMs) &&
+           below(yaw_rate, Cfg::kParkedMaxYawRateDps);
+  };
+
+  const size_t settle = Cfg::kSettleMs / step;
+  size_t run = 0;  // Кадров подряд на стоянке (для успокоения)
+  Segment* cur = nullptr;
+  for (size_t i = 0; i < ts.size(); ++i) {
+    const bool in_window = ts[i] >= opt.from_ms && ts[i] <= opt.to_ms;
+    const bool contiguous =
+        i > 0 && ts[i] > ts[i - 1] && 2 * (ts[i] - ts[i - 1]) > step &&
+        ts[i] - ts[i - 1] < 2 * step;
+    if (!in_window || !parked(i) || !contiguous) {
+      cur = nullptr;
+      run = in_window && parked(i) ? 1 : 0;
+      continue;
+    }
+    if (++run <= settle) continue;
+    if (!cur) cur = &segments.emplace_back();
+    for (size_t a = 0; a < kAxes; ++a) {
+      if (a >= kMx && !has_mag) break;
+      cur->y[a].push_back(axes[a][i]);
+    }
+    if (has_mag) {
+      st.mag_horizontal_sum += std::hypot(axes[kMx][i], axes[kMy][i]);
+      ++st.mag_count;
+    }
+    ++st.used;
+  }
+  st.frames += view.frame_count;
+  return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Расчёт (многопоточно)
+// ─────────────────────────────────────────────────────────────────────────────
+
+/** Запустить fn(i) для i ∈ [0, n) на threads потоках. */
+template <typename Fn>
+void ParallelFor(size_t n, unsigned threads, Fn&& fn) {
+  std::atomic<size_t> next{0};
+  auto worker = [&] {
+    for (size_t i; (i = next.fetch_add(1)) < n;) fn(i);
+  };
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads && t < n; ++t) pool.emplace_back(worker);
+  worker();
+  for (auto& th : pool) th.join();
+}
+
+/** Кривые всех осей: задания (ось, m), суммы по участкам. */
+std::vector<std::vector<AllanPoint>> ComputeCurves(
+    std::vector<Segment>& segments, double tau0, const Options& opt,
+    unsigned threads) {
+  // Фазы — независимо по (участок, ось)
+  ParallelFor(segments.size() * kAxes, threads, [&](size_t job) {
+    Segment& s = segments[job / kAxes];
+    const size_t a = job % kAxes;
+    if (!s.y[a].empty()) AllanPhase(s.y[a], s.theta[a]);
+  });
+
+  size_t longest = 0;
+  for (const Segment& s : segments) {
+    longest = std::max(longest, s.y[kGz].size());
+  }
+  const std::vector<size_t> m =
+      AllanClusterSizes(longest, opt.points_per_decade);
+
+  // Задание (ось, m) — один проход O(n) по фазам всех участков оси
+  std::vector<std::vector<AllanPoint>> curves(
+      kAxes, std::vector<AllanPoint>(m.size()));
+  ParallelFor(kAxes * m.size(), threads, [&](size_t job) {
+    const size_t a = job / m.size();
+    const size_t k = job % m.size();
+    AllanSum total;
+    for (const Segment& s : segments) {
+      const AllanSum part = OverlappingAllanSum(s.theta[a], m[k]);
+      total.sum_sq += part.sum_sq;
+      total.terms += part.terms;
+    }
+    curves[a][k] = AllanPointFromSum(total, m[k], tau0);
+  });
+
+  // Точки без слагаемых (m длиннее всех участков оси) — отбросить
+  for (auto& c : curves) {
+    std::erase_if(c, [](const AllanPoint& p) { return p.terms == 0; });
+  }
+  return curves;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Вывод
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool WriteCurves(const fs::path& path,
+                 const std::vector<std::vector<AllanPoint>>& curves) {
+  FILE* f = std::fopen(path.c_str(), "w");
+  if (!f) return false;
+  std::fprintf(f, "axis,unit,tau_s,adev,terms\n");
+  for (size_t a = 0; a < kAxes; ++a) {
+    for (const AllanPoint& p : curves[a]) {
+      std::fprintf(f, "%s,%s,%.6g,%.6g,%llu\n", kAxisNames[a], kAxisUnits[a],
+                   p.tau_s, p.adev, static_cast<unsigned long long>(p.terms));
+    }
+  }
+  return std::fclose(f) == 0;
+}
+
+/** Патч: WS-команда set_stab_config + поля VehicleEkfNoiseParams. */
+std::string PatchJson(const NoiseTuning& t, double tau0, double parked_s) {
+  char buf[160];
+  std::string out = "{\n";
+  if (t.gyro_valid) {
+    std::snprintf(buf, sizeof(buf),
+                  "  \"set_stab_config\": {\"type\": \"set_stab_config\", "
+                  "\"filter\": {\"madgwick_beta\": %.6g}},\n",
+                  t.madgwick_beta);
+    out += buf;
+  }
+  out += "  \"ekf_noise\": {";
+  const char* sep = "";
+  auto field = [&](bool valid, const char* name, float v) {
+    if (!valid) return;
+    std::snprintf(buf, sizeof(buf), "%s\"%s\": %.6g", sep, name, v);
+    out += buf;
+    sep = ", ";
+  };
+  field(t.gyro_valid, "r_gz", t.r_gz);
+  field(t.heading_valid, "r_heading", t.r_heading);
+  field(t.accel_valid, "q_vx_min", t.q_v_floor);
+  field(t.accel_valid, "q_vy_min", t.q_v_floor);
+  std::snprintf(buf, sizeof(buf),
+                "},\n  \"source\": {\"tau0_s\": %.6g, \"parked_s\": %.1f}\n}\n",
+                tau0, parked_s);
+  out += buf;
+  return out;
+}
+
+void PrintFits(const std::array<AllanNoiseFit, kAxes>& fits) {
+  std::printf("%-4s %-4s %12s %12s %9s %12s\n", "axis", "unit", "N [u*sqrt s]",
+              "B [u]", "tau_B [s]", "K [u/sqrt s]");
+  for (size_t a = 0; a < kAxes; ++a) {
+    const AllanNoiseFit& f = fits[a];
+    if (!f.valid) continue;
+    char rrw[16] = "-";
+    if (f.has_rrw) std::snprintf(rrw, sizeof(rrw), "%.4g", f.rrw);
+    std::printf("%-4s %-4s %12.4g %11.4g%s %9.3g %12s%s\n", kAxisNames[a],
+                kAxisUnits[a], f.arw, f.bias_instability,
+                f.bias_at_end ? ">" : " ", f.tau_bias_s, rrw,
+                f.arw_from_slope ? "" : "  (N from first point)");
+  }
+  std::printf("  '>' — minimum at the last point: record longer for B\n");
+}
+
+void PrintUsage(const char* argv0) {
+  std::fprintf(stderr,
+               "Usage: %s [--threads N] [--from MS] [--to MS] "
+               "[--imu-dt-ms D]\n"
+               "          [--points-per-decade P] [--curve OUT.csv] "
+               "[--patch OUT.json]\n"
+               "          LOG.bin...\n",
+               argv0);
+}
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view a = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (a == "--threads" && has_value) {
+      opt.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (a == "--from" && has_value) {
+      opt.from_ms = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (a == "--to" && has_value) {
+      opt.to_ms = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (a == "--imu-dt-ms" && has_value) {
+      opt.imu_dt_ms = std::strtod(argv[++i], nullptr);
+    } else if (a == "--points-per-decade" && has_value) {
+      opt.points_per_decade =
+          static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (a == "--curve" && has_value) {
+      opt.curve_out = argv[++i];
+    } else if (a == "--patch" && has_value) {
+      opt.patch_out = argv[++i];
+    } else if (!a.empty() && a.front() == '-') {
+      return false;
+    } else {
+      opt.inputs.emplace_back(a);
+    }
+  }
+  return !opt.inputs.empty() && opt.imu_dt_ms > 0.0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  if (!ParseArgs(argc, argv, opt)) {
+    PrintUsage(argv[0]);
+    return 2;
+  }
+  const auto t0 = std::chrono::steady_clock::now();
+
+  std::vector<Segment> segments;
+  LoadStats st;
+  for (const fs::path& in : opt.inputs) {
+    if (!LoadSegments(in, opt, segments, st)) return 1;
+  }
+  const double tau0 = st.step_ms * 1e-3;
+  const double parked_s = static_cast<double>(st.used) * tau0;
+  std::printf("%zu frames, %zu parked in %zu segments (%.1f min), "
+              "tau0 %.3f s\n",
+              st.frames, st.used, segments.size(), parked_s / 60.0, tau0);
+  if (st.used == 0) {
+    std::fprintf(stderr, "no parked data\n");
+    return 1;
+  }
+
+  const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  const unsigned threads = opt.threads == 0 ? cores : opt.threads;
+  const auto curves = ComputeCurves(segments, tau0, opt, threads);
+
+  std::array<AllanNoiseFit, kAxes> fits;
+  for (size_t a = 0; a < kAxes; ++a) fits[a] = FitAllanNoise(curves[a]);
+  // IMU в логе — каждый N-й отсчёт control loop: σ(τ0) — белый шум одного
+  // отсчёта, N = σ·√dt считается по реальному шагу датчика
+  const double imu_dt = opt.imu_dt_ms * 1e-3;
+  if (imu_dt < tau0) {
+    for (size_t a = kGx; a <= kAz; ++a) fits[a].arw *= std::sqrt(imu_dt / tau0);
+  }
+  PrintFits(fits);
+
+  ImuNoiseFits in;
+  for (size_t i = 0; i < 3; ++i) {
+    in.gyro_dps[i] = fits[kGx + i];
+    in.accel_g[i] = fits[kAx + i];
+  }
+  in.mag_xy_mg = {fits[kMx], fits[kMy]};
+  if (st.mag_count > 0) {
+    in.mag_horizontal_mg = st.mag_horizontal_sum / st.mag_count;
+  }
+  const NoiseTuning t =
+      SuggestNoiseTuning(in, config::ControlLoopConfig::kPeriodMs * 1e-3,
+                         config::ImuConfig::kMagReadIntervalMs * 1e-3);
+
+  const std::string patch = PatchJson(t, tau0, parked_s);
+  std::printf("\n%s", patch.c_str());
+  std::printf("\n// VehicleEkfNoiseParams\n");
+  if (t.gyro_valid) std::printf("p.r_gz = %.6gf;\n", t.r_gz);
+  if (t.heading_valid) std::printf("p.r_heading = %.6gf;\n", t.r_heading);
+  if (t.accel_valid) {
+    std::printf("// q_vx, q_vy >= %.6gf (accel noise only)\n", t.q_v_floor);
+  }
+
+  bool ok = true;
+  if (!opt.curve_out.empty() && !WriteCurves(opt.curve_out, curves)) {
+    std::fprintf(stderr, "%s: write failed\n", opt.curve_out.c_str());
+    ok = false;
+  }
+  if (!opt.patch_out.empty()) {
+    std::ofstream f(opt.patch_out);
+    if (!(f << patch)) {
+      std::fprintf(stderr, "%s: write failed\n", opt.patch_out.c_str());
+      ok = false;
+    }
+  }
+  const double sec = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - t0)
+                         .count();
+  std::printf("\n%.3f s on %u threads\n", sec, threads);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,457 @@
+/**
+ * @file log_convert_main.cpp
+ * @brief log_convert — конвертер log.bin (GET /api/log.bin) в CSV / Arrow IPC
+ * / Parquet.
+ *
+ * Файл отображается в память (mmap) и разбирается без копирования
+ * (ParseLogBinView); колонки собираются и кодируются параллельно
+ * (log_convert.hpp). С --split-tests каждый тестовый манёвр (события
+ * TestStart → TestDone/TestFailed/TestStopped) пишется в отдельный файл.
+ * С --smooth EKF-каналы пересчитываются RTS-сглаживателем
+ * (ekf_smoother.hpp): <stem>.smoothed.bin в формате log.bin и конвертация
+ * сглаженных кадров. --jobs N обрабатывает N файлов параллельно.
+ *
+ *   log_convert [--format csv|arrow|parquet] [--split-tests] [--threads N]
+ *               [--jobs N] [--smooth] [--out-dir DIR] [--no-events]
+ *               LOG.bin...
+ *
+ * Arrow/Parquet доступны, если при сборке найдены Apache Arrow / Parquet
+ * (см. CMakeLists.txt); CSV — всегда.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "ekf_smoother.hpp"
+#include "log_convert.hpp"
+
+#if RC_LOG_CONVERT_HAVE_ARROW
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#endif
+#if RC_LOG_CONVERT_HAVE_PARQUET
+#include <parquet/arrow/writer.h>
+#endif
+
+using namespace rc_vehicle;
+namespace fs = std::filesystem;
+
+namespace {
+
+enum class OutFormat { Csv, Arrow, Parquet };
+
+struct Options {
+  OutFormat format{OutFormat::Csv};
+  bool split_tests{false};
+  bool events{true};
+  unsigned threads{0};  ///< 0 — по числу ядер
+  unsigned jobs{1};     ///< Файлов параллельно; 0 — по числу ядер
+  bool smooth{false};   ///< RTS-сглаживание EKF-каналов
+  fs::path out_dir;     ///< Пусто — рядом с исходным файлом
+  std::vector<fs::path> inputs;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Отображение файла в память (только чтение)
+// ─────────────────────────────────────────────────────────────────────────────
+
+class MappedFile {
+ public:
+  ~MappedFile() {
+    if (data_ != nullptr) munmap(data_, size_);
+  }
+
+  bool Open(const fs::path& path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+      close(fd);
+      return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+      void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        close(fd);
+        return false;
+      }
+      data_ = p;
+      // Кадры читаются последовательно: подсказка ядру для read-ahead
+      madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+    close(fd);
+    return true;
+  }
+
+  [[nodiscard]] const uint8_t* Data() const {
+    return static_cast<const uint8_t*>(data_);
+  }
+  [[nodiscard]] size_t Size() const { return size_; }
+
+ private:
+  void* data_{nullptr};
+  size_t size_{0};
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Вывод
+// ─────────────────────────────────────────────────────────────────────────────
+
+const char* FormatExtension(OutFormat f) {
+  switch (f) {
+    case OutFormat::Csv:
+      return ".csv";
+    case OutFormat::Arrow:
+      return ".arrow";
+    case OutFormat::Parquet:
+      return ".parquet";
+  }
+  return "";
+}
+
+const char* TestTypeName(uint8_t type) {
+  switch (type) {
+    case 1:
+      return "straight";
+    case 2:
+      return "circle";
+    case 3:
+      return "step";
+    default:
+      return "test";
+  }
+}
+
+bool WriteFile(const fs::path& path, const std::string& data) {
+  FILE* f = std::fopen(path.c_str(), "wb");
+  if (!f) return false;
+  const bool ok = std::fwrite(data.data(), 1, data.size(), f) == data.size();
+  return std::fclose(f) == 0 && ok;
+}
+
+/** Записать view в формате log.bin (секция событий — если есть). */
+bool WriteLogBin(const fs::path& path, const LogBinView& view) {
+  FILE* f = std::fopen(path.c_str(), "wb");
+  if (!f) return false;
+  auto put = [f](const void* p, size_t n) {
+    return std::fwrite(p, 1, n, f) == n;
+  };
+  bool ok = put(&view.frame_count, 4) && put(&view.frame_size, 4) &&
+            put(view.frames, size_t{view.frame_count} * view.frame_size);
+  if (view.events) {
+    ok = ok && put(&view.event_count, 4) && put(&view.event_size, 4) &&
+         put(view.events, size_t{view.event_count} * view.event_size);
+  }
+  return std::fclose(f) == 0 && ok;
+}
+
+#if RC_LOG_CONVERT_HAVE_ARROW
+
+std::shared_ptr<arrow::DataType> ArrowType(TelemetryFieldType t) {
+  switch (t) {
+    case TelemetryFieldType::U32:
+      return arrow::uint32();
+    case TelemetryFieldType::U8:
+      return arrow::uint8();
+    case TelemetryFieldType::F32:
+      break;
+  }
+  return arrow::float32();
+}
+
+/// Таблица кадров: буферы колонок заполняются ExtractLogColumns напрямую.
+arrow::Result<std::shared_ptr<arrow::Table>> FramesTable(
+    const LogBinView& view, size_t begin, size_t end, unsigned threads) {
+  const size_t cols = LogFieldCountForFrameSize(view.frame_size);
+  const auto rows = static_cast<int64_t>(end - begin);
+  arrow::FieldVector fields;
+  std::vector<std::shared_ptr<arrow::Buffer>> buffers;
+  std::vector<void*> dst;
+  for (size_t c = 0; c < cols; ++c) {
+    const TelemetryFieldInfo& f = kTelemetryLogFields[c];
+    fields.push_back(
+        arrow::field(f.name, ArrowType(f.type), false,
+                     arrow::key_value_metadata({"unit"}, {f.unit})));
+    ARROW_ASSIGN_OR_RAISE(
+        std::shared_ptr<arrow::Buffer> buf,
+        arrow::AllocateBuffer(rows * static_cast<int64_t>(
+                                         TelemetryFieldSize(f.type))));
+    dst.push_back(buf->mutable_data());
+    buffers.push_back(std::move(buf));
+  }
+  ExtractLogColumns(view, begin, end, dst, threads);
+
+  arrow::ArrayVector arrays;
+  for (size_t c = 0; c < cols; ++c) {
+    arrays.push_back(arrow::MakeArray(arrow::ArrayData::Make(
+        fields[c]->type(), rows, {nullptr, buffers[c]})));
+  }
+  return arrow::Table::Make(arrow::schema(fields), arrays, rows);
+}
+
+arrow::Result<std::shared_ptr<arrow::Table>> EventsTable(
+    const LogBinView& view) {
+  arrow::UInt32Builder ts;
+  arrow::UInt8Builder type;
+  arrow::UInt8Builder param;
+  arrow::FloatBuilder value1;
+  arrow::FloatBuilder value2;
+  const size_t n = view.events ? view.event_count : 0;
+  for (size_t i = 0; i < n; ++i) {
+    const TelemetryEvent e = LogEventAt(view, i);
+    ARROW_RETURN_NOT_OK(ts.Append(e.ts_ms));
+    ARROW_RETURN_NOT_OK(type.Append(static_cast<uint8_t>(e.type)));
+    ARROW_RETURN_NOT_OK(param.Append(e.param));
+    ARROW_RETURN_NOT_OK(value1.Append(e.value1));
+    ARROW_RETURN_NOT_OK(value2.Append(e.value2));
+  }
+  arrow::ArrayVector arrays(5);
+  ARROW_RETURN_NOT_OK(ts.Finish(&arrays[0]));
+  ARROW_RETURN_NOT_OK(type.Finish(&arrays[1]));
+  ARROW_RETURN_NOT_OK(param.Finish(&arrays[2]));
+  ARROW_RETURN_NOT_OK(value1.Finish(&arrays[3]));
+  ARROW_RETURN_NOT_OK(value2.Finish(&arrays[4]));
+  auto schema = arrow::schema({arrow::field("ts_ms", arrow::uint32()),
+                               arrow::field("type", arrow::uint8()),
+                               arrow::field("param", arrow::uint8()),
+                               arrow::field("value1", arrow::float32()),
+                               arrow::field("value2", arrow::float32())});
+  return arrow::Table::Make(schema, arrays);
+}
+
+arrow::Status WriteTable(const arrow::Table& table, const fs::path& path,
+                         OutFormat format) {
+  ARROW_ASSIGN_OR_RAISE(auto out,
+                        arrow::io::FileOutputStream::Open(path.string()));
+  if (format == OutFormat::Parquet) {
+#if RC_LOG_CONVERT_HAVE_PARQUET
+    // use_threads: колонки кодируются параллельно в пуле Arrow
+    auto arrow_props =
+        parquet::ArrowWriterProperties::Builder().set_use_threads(true)->build();
+    ARROW_RETURN_NOT_OK(parquet::arrow::WriteTable(
+        table, arrow::default_memory_pool(), out, table.num_rows(),
+        parquet::default_writer_properties(), arrow_props));
+#else
+    return arrow::Status::NotImplemented("built without Parquet");
+#endif
+  } else {
+    ARROW_ASSIGN_OR_RAISE(auto writer,
+                          arrow::ipc::MakeFileWriter(out, table.schema()));
+    ARROW_RETURN_NOT_OK(writer->WriteTable(table));
+    ARROW_RETURN_NOT_OK(writer->Close());
+  }
+  return out->Close();
+}
+
+#endif  // RC_LOG_CONVERT_HAVE_ARROW
+
+bool WriteFrames(const LogBinView& view, size_t begin, size_t end,
+                 const fs::path& path, const Options& opt) {
+  if (opt.format == OutFormat::Csv) {
+    return WriteFile(path, EncodeLogFramesCsv(view, begin, end, opt.threads));
+  }
+#if RC_LOG_CONVERT_HAVE_ARROW
+  auto table = FramesTable(view, begin, end, opt.threads);
+  arrow::Status st = table.ok() ? WriteTable(**table, path, opt.format)
+                                : table.status();
+  if (!st.ok()) std::fprintf(stderr, "  %s\n", st.ToString().c_str());
+  return st.ok();
+#else
+  return false;
+#endif
+}
+
+bool WriteEvents(const LogBinView& view, const fs::path& path,
+                 const Options& opt) {
+  if (opt.format == OutFormat::Csv) {
+    return WriteFile(path, EncodeLogEventsCsv(view));
+  }
+#if RC_LOG_CONVERT_HAVE_ARROW
+  auto table = EventsTable(view);
+  arrow::Status st =
+      table.ok() ? WriteTable(**table, path, opt.format) : table.status();
+  if (!st.ok()) std::fprintf(stderr, "  %s\n", st.ToString().c_str());
+  return st.ok();
+#else
+  return false;
+#endif
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Конвертация одного файла
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool ConvertFile(const fs::path& input, const Options& opt) {
+  const auto t0 = std::chrono::steady_clock::now();
+
+  MappedFile file;
+  if (!file.Open(input)) {
+    std::fprintf(stderr, "%s: %s\n", input.c_str(), std::strerror(errno));
+    return false;
+  }
+  LogBinView view;
+  const LogDecodeError err = ParseLogBinView(file.Data(), file.Size(), view);
+  if (err != LogDecodeError::None && !view.frames) {
+    std::fprintf(stderr, "%s: %s\n", input.c_str(),
+                 LogDecodeErrorToString(err));
+    return false;
+  }
+  if (err != LogDecodeError::None) {
+    // Кадры целы, секция событий битая — конвертируем кадры
+    std::fprintf(stderr, "%s: events skipped: %s\n", input.c_str(),
+                 LogDecodeErrorToString(err));
+  }
+
+  const fs::path dir = opt.out_dir.empty() ? input.parent_path() : opt.out_dir;
+  std::string stem = input.stem().string();
+  const char* ext = FormatExtension(opt.format);
+  bool ok = true;
+
+  // Сглаженная копия кадров; дальше конвертируется она
+  std::vector<uint8_t> smoothed;
+  if (opt.smooth) {
+    smoothed.assign(view.frames,
+                    view.frames + size_t{view.frame_count} * view.frame_size);
+    const LogSmoothStats st = SmoothLogEkf(view, {}, smoothed.data());
+    view.frames = smoothed.data();
+    stem += ".smoothed";
+    const fs::path out = dir / (stem + ".bin");
+    ok = WriteLogBin(out, view);
+    std::printf("  %s: %u segments, %llu EKF steps\n", out.c_str(),
+                st.segments, static_cast<unsigned long long>(st.steps));
+  }
+
+  if (opt.split_tests) {
+    const auto segments = SegmentLogByTests(view);
+    for (size_t i = 0; i < segments.size(); ++i) {
+      const LogSegment& s = segments[i];
+      char suffix[48];
+      std::snprintf(suffix, sizeof(suffix), ".test%02zu_%s", i + 1,
+                    TestTypeName(s.test_type));
+      const fs::path out = dir / (stem + suffix + ext);
+      ok = WriteFrames(view, s.first_frame, s.end_frame, out, opt) && ok;
+      std::printf("  %s: %u frames\n", out.c_str(),
+                  s.end_frame - s.first_frame);
+    }
+    if (segments.empty()) std::printf("  %s: no tests\n", input.c_str());
+  } else {
+    const fs::path out = dir / (stem + ext);
+    ok = WriteFrames(view, 0, view.frame_count, out, opt);
+    std::printf("  %s: %u frames\n", out.c_str(), view.frame_count);
+  }
+  if (opt.events && view.events) {
+    ok = WriteEvents(view, dir / (stem + ".events" + ext), opt) && ok;
+  }
+
+  const double sec = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - t0)
+                         .count();
+  std::printf("%s: %.1f MB in %.3f s (%.0f MB/s)%s\n", input.c_str(),
+              file.Size() / 1e6, sec, sec > 0 ? file.Size() / 1e6 / sec : 0.0,
+              ok ? "" : " — write failed");
+  return ok;
+}
+
+void PrintUsage(const char* argv0) {
+  std::fprintf(stderr,
+               "Usage: %s [--format csv|arrow|parquet] [--split-tests]\n"
+               "          [--threads N] [--jobs N] [--smooth] [--out-dir DIR]\n"
+               "          [--no-events] LOG.bin...\n",
+               argv0);
+}
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view a = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (a == "--format" && has_value) {
+      const std::string_view f = argv[++i];
+      if (f == "csv") {
+        opt.format = OutFormat::Csv;
+      } else if (f == "arrow") {
+        opt.format = OutFormat::Arrow;
+      } else if (f == "parquet") {
+        opt.format = OutFormat::Parquet;
+      } else {
+        return false;
+      }
+    } else if (a == "--split-tests") {
+      opt.split_tests = true;
+    } else if (a == "--no-events") {
+      opt.events = false;
+    } else if (a == "--threads" && has_value) {
+      opt.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (a == "--jobs" && has_value) {
+      opt.jobs = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (a == "--smooth") {
+      opt.smooth = true;
+    } else if (a == "--out-dir" && has_value) {
+      opt.out_dir = argv[++i];
+    } else if (!a.empty() && a.front() == '-') {
+      return false;
+    } else {
+      opt.inputs.emplace_back(a);
+    }
+  }
+  return !opt.inputs.empty();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  if (!ParseArgs(argc, argv, opt)) {
+    PrintUsage(argv[0]);
+    return 2;
+  }
+#if !RC_LOG_CONVERT_HAVE_ARROW
+  if (opt.format == OutFormat::Arrow || opt.format == OutFormat::Parquet) {
+    std::fprintf(stderr, "built without Apache Arrow: only --format csv\n");
+    return 2;
+  }
+#endif
+#if !RC_LOG_CONVERT_HAVE_PARQUET
+  if (opt.format == OutFormat::Parquet) {
+    std::fprintf(stderr, "built without Parquet\n");
+    return 2;
+  }
+#endif
+  if (!opt.out_dir.empty()) {
+    std::error_code ec;
+    fs::create_directories(opt.out_dir, ec);
+  }
+
+  // Файлы независимы: --jobs воркеров разбирают общую очередь
+  const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  const unsigned jobs = static_cast<unsigned>(std::min<size_t>(
+      opt.jobs == 0 ? cores : opt.jobs, opt.inputs.size()));
+  std::atomic<size_t> next{0};
+  std::atomic<int> failed{0};
+  auto worker = [&] {
+    for (size_t i; (i = next.fetch_add(1)) < opt.inputs.size();) {
+      if (!ConvertFile(opt.inputs[i], opt)) ++failed;
+    }
+  };
+  std::vector<std::thread> pool;
+  for (unsigned j = 1; j < jobs; ++j) pool.emplace_back(worker);
+  worker();
+  for (auto& th : pool) th.join();
+  return failed == 0 ? 0 : 1;
+}
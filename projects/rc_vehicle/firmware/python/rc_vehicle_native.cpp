@@ -0,0 +1,595 @@
+/**
+ * @file rc_vehicle_native.cpp
+ * @brief Python-модуль rc_vehicle_native: фильтры и декодер логов прошивки.
+ *
+ * Собирается из тех же исходников common/, что и прошивка, поэтому офлайн-
+ * анализ и подбор параметров (beta Madgwick, шумы EKF, срез LPF) идут на
+ * бит-в-бит том же коде, что крутится на ESP32-S3.
+ *
+ * Пакетные методы (filter/process/replay/decode_log) принимают одномерные
+ * NumPy-массивы float32 (другие dtype приводятся), считают весь массив в C++
+ * с отпущенным GIL и возвращают NumPy-массивы.
+ */
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "lpf_butterworth.hpp"
+#include "madgwick_filter.hpp"
+#include "mag_calibration.hpp"
+#include "telemetry_log_decoder.hpp"
+#include "vehicle_ekf.hpp"
+
+namespace py = pybind11;
+using namespace rc_vehicle;
+
+namespace {
+
+using FloatArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+
+// ─── Вспомогательные функции для массивов ──────────────────────────────────
+
+/// Проверить, что массив одномерный; вернуть длину.
+py::ssize_t Length1D(const FloatArray& a, const char* name) {
+  if (a.ndim() != 1) {
+    throw py::value_error(std::string(name) + ": expected 1-D array");
+  }
+  return a.shape(0);
+}
+
+/// Проверить длину массива относительно n.
+const float* Data1D(const FloatArray& a, const char* name, py::ssize_t n) {
+  if (Length1D(a, name) != n) {
+    throw py::value_error(std::string(name) + ": length mismatch");
+  }
+  return a.data();
+}
+
+/**
+ * Шаг времени: скаляр (0-D / длина 1) или массив длины n.
+ * Возвращает указатель и шаг индекса (0 для скаляра).
+ */
+std::pair<const float*, py::ssize_t> DtView(const FloatArray& dt,
+                                            py::ssize_t n) {
+  if (dt.size() == 1) return {dt.data(), 0};
+  return {Data1D(dt, "dt", n), 1};
+}
+
+FloatArray MakeArray(py::ssize_t n) { return FloatArray(n); }
+
+/// NumPy-dtype и размер элемента для поля кадра из реестра.
+std::pair<const char*, size_t> FieldDtype(TelemetryFieldType t) {
+  switch (t) {
+    case TelemetryFieldType::U32:
+      return {"uint32", 4};
+    case TelemetryFieldType::U8:
+      return {"uint8", 1};
+    case TelemetryFieldType::F32:
+      break;
+  }
+  return {"float32", 4};
+}
+
+/// DecodedLog → {"frames": {col: ndarray}, "events": {col: ndarray}, ...}
+py::dict LogToDict(const DecodedLog& log) {
+  const auto nf = static_cast<py::ssize_t>(log.frames.size());
+  const auto ne = static_cast<py::ssize_t>(log.events.size());
+
+  // Колонки кадра — по реестру RC_TELEMETRY_LOG_FIELDS (telemetry_fields.hpp)
+  std::vector<py::array> cols;
+  std::vector<unsigned char*> col_ptrs;
+  std::vector<size_t> col_sizes;
+  cols.reserve(kTelemetryLogFieldCount);
+  for (const auto& field : kTelemetryLogFields) {
+    const auto [dtype, size] = FieldDtype(field.type);
+    cols.emplace_back(py::dtype(dtype), std::vector<py::ssize_t>{nf});
+    col_ptrs.push_back(static_cast<unsigned char*>(cols.back().mutable_data()));
+    col_sizes.push_back(size);
+  }
+
+  py::array_t<uint32_t> ev_ts(ne);
+  py::array_t<uint8_t> ev_type(ne);
+  py::array_t<uint8_t> ev_param(ne);
+  FloatArray ev_v1 = MakeArray(ne);
+  FloatArray ev_v2 = MakeArray(ne);
+
+  uint32_t* ev_ts_p = ev_ts.mutable_data();
+  uint8_t* ev_type_p = ev_type.mutable_data();
+  uint8_t* ev_param_p = ev_param.mutable_data();
+  float* ev_v1_p = ev_v1.mutable_data();
+  float* ev_v2_p = ev_v2.mutable_data();
+
+  {
+    py::gil_scoped_release release;
+    for (py::ssize_t i = 0; i < nf; ++i) {
+      const auto& f = log.frames[static_cast<size_t>(i)];
+      const auto* base = reinterpret_cast<const unsigned char*>(&f);
+      for (size_t c = 0; c < col_ptrs.size(); ++c) {
+        const size_t sz = col_sizes[c];
+        std::memcpy(col_ptrs[c] + static_cast<size_t>(i) * sz,
+                    base + kTelemetryLogFields[c].offset, sz);
+      }
+    }
+    for (py::ssize_t i = 0; i < ne; ++i) {
+      const auto& e = log.events[static_cast<size_t>(i)];
+      ev_ts_p[i] = e.ts_ms;
+      ev_type_p[i] = static_cast<uint8_t>(e.type);
+      ev_param_p[i] = e.param;
+      ev_v1_p[i] = e.value1;
+      ev_v2_p[i] = e.value2;
+    }
+  }
+
+  py::dict frames;
+  for (size_t c = 0; c < cols.size(); ++c) {
+    frames[kTelemetryLogFields[c].name] = cols[c];
+  }
+
+  py::dict events;
+  events["ts_ms"] = ev_ts;
+  events["type"] = ev_type;
+  events["param"] = ev_param;
+  events["value1"] = ev_v1;
+  events["value2"] = ev_v2;
+
+  py::dict out;
+  out["frames"] = frames;
+  out["events"] = events;
+  out["frame_size"] = log.source_frame_size;
+  out["event_size"] = log.source_event_size;
+  return out;
+}
+
+py::dict DecodeBytes(const uint8_t* data, size_t size) {
+  DecodedLog log;
+  LogDecodeError err;
+  {
+    py::gil_scoped_release release;
+    err = DecodeLogBin(data, size, log);
+  }
+  if (err != LogDecodeError::None) {
+    throw py::value_error(LogDecodeErrorToString(err));
+  }
+  return LogToDict(log);
+}
+
+py::dict DecodeSinceBytes(const uint8_t* data, size_t size) {
+  DecodedLogSince since;
+  LogDecodeError err;
+  {
+    py::gil_scoped_release release;
+    err = DecodeLogSince(data, size, since);
+  }
+  if (err != LogDecodeError::None) {
+    throw py::value_error(LogDecodeErrorToString(err));
+  }
+  DecodedLog log;
+  log.frames = std::move(since.frames);
+  log.source_frame_size = since.header.frame_size;
+  py::dict out = LogToDict(log);
+  const TelemetryLogSinceHeader& h = since.header;
+  out["first_seq"] = h.first_seq;
+  out["next_seq"] = h.next_seq;
+  out["head_seq"] = h.head_seq;
+  out["dropped"] = h.dropped;
+  out["gap"] = (h.flags & kLogSinceGap) != 0;
+  out["reset"] = (h.flags & kLogSinceReset) != 0;
+  return out;
+}
+
+const char* MagStatusToString(MagCalibStatus s) {
+  switch (s) {
+    case MagCalibStatus::Idle:
+      return "idle";
+    case MagCalibStatus::Collecting:
+      return "collecting";
+    case MagCalibStatus::Done:
+      return "done";
+    case MagCalibStatus::Failed:
+      return "failed";
+  }
+  return "unknown";
+}
+
+}  // namespace
+
+PYBIND11_MODULE(rc_vehicle_native, m) {
+  m.doc() = "RC vehicle firmware filters and log decoder (common/ sources)";
+
+  // ═══════════════════════════════════════════════════════════════════════
+  // LpfButterworth2
+  // ═══════════════════════════════════════════════════════════════════════
+
+  py::class_<LpfButterworth2>(m, "LpfButterworth2")
+      .def(py::init([](float cutoff_hz, float sample_rate_hz) {
+             auto lpf = std::make_unique<LpfButterworth2>();
+             lpf->SetParams(cutoff_hz, sample_rate_hz);
+             return lpf;
+           }),
+           py::arg("cutoff_hz"), py::arg("sample_rate_hz"))
+      .def("set_params", &LpfButterworth2::SetParams, py::arg("cutoff_hz"),
+           py::arg("sample_rate_hz"))
+      .def("step", &LpfButterworth2::Step, py::arg("x"))
+      .def("reset", &LpfButterworth2::Reset)
+      .def_property_readonly("output", &LpfButterworth2::GetOutput)
+      .def_property_readonly("cutoff_hz", &LpfButterworth2::GetCutoffHz)
+      .def_property_readonly("sample_rate_hz",
+                             &LpfButterworth2::GetSampleRateHz)
+      .def(
+          "filter",
+          [](LpfButterworth2& self, const FloatArray& x) {
+            const py::ssize_t n = Length1D(x, "x");
+            const float* in = x.data();
+            FloatArray y = MakeArray(n);
+            float* out = y.mutable_data();
+            {
+              py::gil_scoped_release release;
+              for (py::ssize_t i = 0; i < n; ++i) out[i] = self.Step(in[i]);
+            }
+            return y;
+          },
+          py::arg("x"),
+          "Filter a whole array, continuing from the current state.");
+
+  // ═══════════════════════════════════════════════════════════════════════
+  // MadgwickFilter
+  // ═══════════════════════════════════════════════════════════════════════
+
+  py::class_<MadgwickFilter>(m, "MadgwickFilter")
+      .def(py::init([](float beta) {
+             auto f = std::make_unique<MadgwickFilter>();
+             f->SetBeta(beta);
+             return f;
+           }),
+           py::arg("beta") = 0.1f)
+      .def("update",
+           py::overload_cast<float, float, float, float, float, float, float>(
+               &MadgwickFilter::Update),
+           py::arg("ax"), py::arg("ay"), py::arg("az"), py::arg("gx"),
+           py::arg("gy"), py::arg("gz"), py::arg("dt"))
+      .def("update_with_mag", &MadgwickFilter::UpdateWithMag, py::arg("ax"),
+           py::arg("ay"), py::arg("az"), py::arg("gx"), py::arg("gy"),
+           py::arg("gz"), py::arg("mx"), py::arg("my"), py::arg("mz"),
+           py::arg("dt"))
+      .def("reset", &MadgwickFilter::Reset)
+      .def_property("beta", &MadgwickFilter::GetBeta, &MadgwickFilter::SetBeta)
+      .def("set_adaptive_beta", &MadgwickFilter::SetAdaptiveBeta,
+           py::arg("enabled"), py::arg("threshold_g") = 0.2f)
+      .def_property_readonly("quaternion",
+                             [](const MadgwickFilter& self) {
+                               float w, x, y, z;
+                               self.GetQuaternion(w, x, y, z);
+                               return py::make_tuple(w, x, y, z);
+                             })
+      .def_property_readonly("euler_deg",
+                             [](const MadgwickFilter& self) {
+                               float pitch, roll, yaw;
+                               self.GetEulerDeg(pitch, roll, yaw);
+                               return py::make_tuple(pitch, roll, yaw);
+                             })
+      .def(
+          "filter",
+          [](MadgwickFilter& self, const FloatArray& ax, const FloatArray& ay,
+             const FloatArray& az, const FloatArray& gx, const FloatArray& gy,
+             const FloatArray& gz, const FloatArray& dt) {
+            const py::ssize_t n = Length1D(ax, "ax");
+            const float* pax = ax.data();
+            const float* pay = Data1D(ay, "ay", n);
+            const float* paz = Data1D(az, "az", n);
+            const float* pgx = Data1D(gx, "gx", n);
+            const float* pgy = Data1D(gy, "gy", n);
+            const float* pgz = Data1D(gz, "gz", n);
+            const auto [pdt, dt_stride] = DtView(dt, n);
+
+            FloatArray pitch = MakeArray(n);
+            FloatArray roll = MakeArray(n);
+            FloatArray yaw = MakeArray(n);
+            float* pp = pitch.mutable_data();
+            float* pr = roll.mutable_data();
+            float* py_ = yaw.mutable_data();
+            const auto un = static_cast<size_t>(n);
+            const ImuBatch batch{{pax, un},
+                                 {pay, un},
+                                 {paz, un},
+                                 {pgx, un},
+                                 {pgy, un},
+                                 {pgz, un},
+                                 {pdt, dt_stride ? un : 1}};
+            {
+              py::gil_scoped_release release;
+              self.UpdateBatch(batch, {pp, un}, {pr, un}, {py_, un});
+            }
+            return py::make_tuple(pitch, roll, yaw);
+          },
+          py::arg("ax"), py::arg("ay"), py::arg("az"), py::arg("gx"),
+          py::arg("gy"), py::arg("gz"), py::arg("dt"),
+          "6DOF update over arrays (accel g, gyro dps); returns "
+          "(pitch_deg, roll_deg, yaw_deg).");
+
+  // ═══════════════════════════════════════════════════════════════════════
+  // VehicleEkf
+  // ═══════════════════════════════════════════════════════════════════════
+
+  py::class_<VehicleEkfNoiseParams>(m, "EkfNoiseParams")
+      .def(py::init<>())
+      .def_readwrite("q_vx", &VehicleEkfNoiseParams::q_vx)
+      .def_readwrite("q_vy", &VehicleEkfNoiseParams::q_vy)
+      .def_readwrite("q_r", &VehicleEkfNoiseParams::q_r)
+      .def_readwrite("r_gz", &VehicleEkfNoiseParams::r_gz)
+      .def_readwrite("vy_decay_hz", &VehicleEkfNoiseParams::vy_decay_hz)
+      .def_readwrite("q_psi", &VehicleEkfNoiseParams::q_psi)
+      .def_readwrite("r_heading", &VehicleEkfNoiseParams::r_heading);
+
+  py::class_<VehicleEkf>(m, "VehicleEkf")
+      .def(py::init<VehicleEkfNoiseParams>(),
+           py::arg("params") = VehicleEkfNoiseParams{})
+      .def("reset", &VehicleEkf::Reset)
+      .def("set_state", &VehicleEkf::SetState, py::arg("vx"), py::arg("vy"),
+           py::arg("r"))
+      .def("set_yaw", &VehicleEkf::SetYaw, py::arg("yaw_rad"))
+      .def("set_noise_params", &VehicleEkf::SetNoiseParams, py::arg("params"))
+      .def("predict", &VehicleEkf::Predict, py::arg("ax"), py::arg("ay"),
+           py::arg("dt"))
+      .def("update_gyro_z", &VehicleEkf::UpdateGyroZ, py::arg("gz"))
+      .def("update_heading", &VehicleEkf::UpdateHeading,
+           py::arg("heading_rad"))
+      .def("update_zero_velocity", &VehicleEkf::UpdateZeroVelocity,
+           py::arg("r_zupt") = 0.1f)
+      .def("update_from_imu", &VehicleEkf::UpdateFromImu, py::arg("ax_g"),
+           py::arg("ay_g"), py::arg("az_g"), py::arg("gz_dps"),
+           py::arg("dt"), py::arg("throttle_abs") = 0.0f)
+      .def_property_readonly("vx", &VehicleEkf::GetVx)
+      .def_property_readonly("vy", &VehicleEkf::GetVy)
+      .def_property_readonly("yaw_rate", &VehicleEkf::GetYawRate)
+      .def_property_readonly("yaw_rad", &VehicleEkf::GetYawRad)
+      .def_property_readonly("yaw_deg", &VehicleEkf::GetYawDeg)
+      .def_property_readonly("speed_ms", &VehicleEkf::GetSpeedMs)
+      .def_property_readonly("slip_angle_deg", &VehicleEkf::GetSlipAngleDeg)
+      .def_property_readonly("variances",
+                             [](const VehicleEkf& self) {
+                               return py::make_tuple(
+                                   self.GetVxVariance(), self.GetVyVariance(),
+                                   self.GetRVariance(), self.GetYawVariance());
+                             })
+      .def(
+          "process",
+          [](VehicleEkf& self, const FloatArray& ax, const FloatArray& ay,
+             const FloatArray& az, const FloatArray& gz, const FloatArray& dt,
+             std::optional<FloatArray> throttle_abs) {
+            const py::ssize_t n = Length1D(ax, "ax");
+            const float* pax = ax.data();
+            const float* pay = Data1D(ay, "ay", n);
+            const float* paz = Data1D(az, "az", n);
+            const float* pgz = Data1D(gz, "gz", n);
+            const auto [pdt, dt_stride] = DtView(dt, n);
+            const float* pthr =
+                throttle_abs ? Data1D(*throttle_abs, "throttle_abs", n)
+                             : nullptr;
+
+            FloatArray vx = MakeArray(n);
+            FloatArray vy = MakeArray(n);
+            FloatArray r = MakeArray(n);
+            FloatArray slip = MakeArray(n);
+            float* pvx = vx.mutable_data();
+            float* pvy = vy.mutable_data();
+            float* pr = r.mutable_data();
+            float* pslip = slip.mutable_data();
+            {
+              py::gil_scoped_release release;
+              for (py::ssize_t i = 0; i < n; ++i) {
+                self.UpdateFromImu(pax[i], pay[i], paz[i], pgz[i],
+                                   pdt[i * dt_stride], pthr ? pthr[i] : 0.0f);
+                pvx[i] = self.GetVx();
+                pvy[i] = self.GetVy();
+                pr[i] = self.GetYawRate();
+                pslip[i] = self.GetSlipAngleDeg();
+              }
+            }
+            py::dict out;
+            out["vx"] = vx;
+            out["vy"] = vy;
+            out["yaw_rate"] = r;
+            out["slip_deg"] = slip;
+            return out;
+          },
+          py::arg("ax_g"), py::arg("ay_g"), py::arg("az_g"),
+          py::arg("gz_dps"), py::arg("dt"), py::arg("throttle_abs") = py::none(),
+          "UpdateFromImu over arrays; returns dict of vx, vy, yaw_rate, "
+          "slip_deg.");
+
+  // ═══════════════════════════════════════════════════════════════════════
+  // MagCalibration
+  // ═══════════════════════════════════════════════════════════════════════
+
+  py::class_<MagCalibration>(m, "MagCalibration")
+      .def(py::init<>())
+      .def("start", &MagCalibration::Start)
+      .def("finish", &MagCalibration::Finish)
+      .def("cancel", &MagCalibration::Cancel)
+      .def(
+          "feed_sample",
+          [](MagCalibration& self, float mx, float my, float mz) {
+            self.FeedSample(MagData{mx, my, mz});
+          },
+          py::arg("mx"), py::arg("my"), py::arg("mz"))
+      .def(
+          "feed",
+          [](MagCalibration& self, const FloatArray& mx, const FloatArray& my,
+             const FloatArray& mz) {
+            const py::ssize_t n = Length1D(mx, "mx");
+            const float* pmx = mx.data();
+            const float* pmy = Data1D(my, "my", n);
+            const float* pmz = Data1D(mz, "mz", n);
+            py::gil_scoped_release release;
+            for (py::ssize_t i = 0; i < n; ++i) {
+              self.FeedSample(MagData{pmx[i], pmy[i], pmz[i]});
+            }
+          },
+          py::arg("mx"), py::arg("my"), py::arg("mz"))
+      .def(
+          "apply",
+          [](const MagCalibration& self, const FloatArray& mx,
+             const FloatArray& my, const FloatArray& mz) {
+            const py::ssize_t n = Length1D(mx, "mx");
+            const float* pmx = mx.data();
+            const float* pmy = Data1D(my, "my", n);
+            const float* pmz = Data1D(mz, "mz", n);
+            FloatArray ox = MakeArray(n);
+            FloatArray oy = MakeArray(n);
+            FloatArray oz = MakeArray(n);
+            float* pox = ox.mutable_data();
+            float* poy = oy.mutable_data();
+            float* poz = oz.mutable_data();
+            {
+              py::gil_scoped_release release;
+              for (py::ssize_t i = 0; i < n; ++i) {
+                MagData d{pmx[i], pmy[i], pmz[i]};
+                self.Apply(d);
+                pox[i] = d.mx;
+                poy[i] = d.my;
+                poz[i] = d.mz;
+              }
+            }
+            return py::make_tuple(ox, oy, oz);
+          },
+          py::arg("mx"), py::arg("my"), py::arg("mz"))
+      .def_property_readonly("status",
+                             [](const MagCalibration& self) {
+                               return MagStatusToString(self.GetStatus());
+                             })
+      .def_property_readonly("fail_reason", &MagCalibration::GetFailReasonStr)
+      .def_property_readonly("valid", &MagCalibration::IsValid)
+      .def_property_readonly("offset", [](const MagCalibration& self) {
+        const auto& d = self.GetData();
+        return py::make_tuple(d.offset[0], d.offset[1], d.offset[2]);
+      });
+
+  // ═══════════════════════════════════════════════════════════════════════
+  // Log decoder / replay
+  // ═══════════════════════════════════════════════════════════════════════
+
+  m.def(
+      "decode_log",
+      [](py::bytes data) {
+        const std::string_view view = data;
+        return DecodeBytes(reinterpret_cast<const uint8_t*>(view.data()),
+                           view.size());
+      },
+      py::arg("data"),
+      "Decode GET /api/log.bin payload into column arrays.");
+
+  m.def(
+      "decode_log_file",
+      [](const std::string& path) {
+        std::vector<uint8_t> buf;
+        {
+          py::gil_scoped_release release;
+          std::ifstream f(path, std::ios::binary);
+          if (f) {
+            buf.assign(std::istreambuf_iterator<char>(f),
+                       std::istreambuf_iterator<char>());
+          }
+        }
+        if (buf.empty()) throw py::value_error("cannot read " + path);
+        return DecodeBytes(buf.data(), buf.size());
+      },
+      py::arg("path"), "Decode a saved log.bin file into column arrays.");
+
+  m.def(
+      "decode_log_since",
+      [](py::bytes data) {
+        const std::string_view view = data;
+        return DecodeSinceBytes(
+            reinterpret_cast<const uint8_t*>(view.data()), view.size());
+      },
+      py::arg("data"),
+      "Decode a GET /api/log_since reply: frame columns plus the cursor "
+      "(first_seq, next_seq, head_seq, dropped, gap, reset).");
+
+  m.def(
+      "replay",
+      [](const FloatArray& ax, const FloatArray& ay, const FloatArray& az,
+         const FloatArray& gx, const FloatArray& gy, const FloatArray& gz,
+         const FloatArray& dt, std::optional<FloatArray> throttle_abs,
+         float lpf_cutoff_hz, float sample_rate_hz, float madgwick_beta,
+         VehicleEkfNoiseParams ekf_params) {
+        const py::ssize_t n = Length1D(ax, "ax");
+        const float* pax = ax.data();
+        const float* pay = Data1D(ay, "ay", n);
+        const float* paz = Data1D(az, "az", n);
+        const float* pgx = Data1D(gx, "gx", n);
+        const float* pgy = Data1D(gy, "gy", n);
+        const float* pgz = Data1D(gz, "gz", n);
+        const auto [pdt, dt_stride] = DtView(dt, n);
+        const float* pthr =
+            throttle_abs ? Data1D(*throttle_abs, "throttle_abs", n) : nullptr;
+
+        FloatArray gz_f = MakeArray(n);
+        FloatArray pitch = MakeArray(n);
+        FloatArray roll = MakeArray(n);
+        FloatArray yaw = MakeArray(n);
+        FloatArray vx = MakeArray(n);
+        FloatArray vy = MakeArray(n);
+        FloatArray r = MakeArray(n);
+        FloatArray slip = MakeArray(n);
+        float* o_gz = gz_f.mutable_data();
+        float* o_pitch = pitch.mutable_data();
+        float* o_roll = roll.mutable_data();
+        float* o_yaw = yaw.mutable_data();
+        float* o_vx = vx.mutable_data();
+        float* o_vy = vy.mutable_data();
+        float* o_r = r.mutable_data();
+        float* o_slip = slip.mutable_data();
+        {
+          py::gil_scoped_release release;
+          // Тот же порядок, что в ImuHandler + ControlLoopProcessor:
+          // LPF(gz) → Madgwick(raw gz) → EKF(filtered gz)
+          LpfButterworth2 lpf;
+          lpf.SetParams(lpf_cutoff_hz, sample_rate_hz);
+          MadgwickFilter madgwick;
+          madgwick.SetBeta(madgwick_beta);
+          VehicleEkf ekf(ekf_params);
+          for (py::ssize_t i = 0; i < n; ++i) {
+            const float dt_sec = pdt[i * dt_stride];
+            o_gz[i] = lpf.Step(pgz[i]);
+            madgwick.Update(pax[i], pay[i], paz[i], pgx[i], pgy[i], pgz[i],
+                            dt_sec);
+            madgwick.GetEulerDeg(o_pitch[i], o_roll[i], o_yaw[i]);
+            ekf.UpdateFromImu(pax[i], pay[i], paz[i], o_gz[i], dt_sec,
+                              pthr ? pthr[i] : 0.0f);
+            o_vx[i] = ekf.GetVx();
+            o_vy[i] = ekf.GetVy();
+            o_r[i] = ekf.GetYawRate();
+            o_slip[i] = ekf.GetSlipAngleDeg();
+          }
+        }
+        py::dict out;
+        out["yaw_rate_dps"] = gz_f;
+        out["pitch_deg"] = pitch;
+        out["roll_deg"] = roll;
+        out["yaw_deg"] = yaw;
+        out["vx"] = vx;
+        out["vy"] = vy;
+        out["yaw_rate"] = r;
+        out["slip_deg"] = slip;
+        return out;
+      },
+      py::arg("ax"), py::arg("ay"), py::arg("az"), py::arg("gx"),
+      py::arg("gy"), py::arg("gz"), py::arg("dt"),
+      py::arg("throttle_abs") = py::none(), py::arg("lpf_cutoff_hz") = 30.0f,
+      py::arg("sample_rate_hz") = 500.0f, py::arg("madgwick_beta") = 0.1f,
+      py::arg("ekf_params") = VehicleEkfNoiseParams{},
+      "Replay the estimator chain (LPF → Madgwick → EKF) over IMU arrays.");
+}
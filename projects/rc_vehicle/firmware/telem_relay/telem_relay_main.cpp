@@ -0,0 +1,856 @@
+/**
+ * @file telem_relay_main.cpp
+ * @brief telem_relay — хостовый ретранслятор телеметрии для многих зрителей.
+ *
+ * Одно соединение с машиной — WebSocket (ws://car/ws) или UDP-стрим
+ * (JOIN на порт управления 5556) — и любое число локальных WS-клиентов.
+ * Машина шлёт телеметрию одному получателю при любом числе зрителей;
+ * прореживание по hz и фильтр групп — на хосте, у каждого клиента свои
+ * (relay_subscribe). Команды машине — только от клиента, получившего
+ * управление по --control-token (relay_control). Логика маршрутизации —
+ * common/telem_relay.hpp, кадры и рукопожатие — common/ws_protocol.hpp;
+ * здесь — однопоточный цикл poll() на неблокирующих сокетах.
+ *
+ *   telem_relay [--car HOST] [--upstream ws|udp] [--listen PORT] ...
+ */
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "config.hpp"
+#include "json_reader.hpp"
+#include "telem_relay.hpp"
+#include "udp_command.hpp"
+#include "ws_protocol.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+struct Options {
+  std::string car{"192.168.4.1"};
+  bool udp{false};  ///< Upstream: false — WebSocket, true — UDP-стрим
+  uint16_t car_ws_port{80};
+  std::string ws_path{"/ws"};
+  std::string bind{"0.0.0.0"};
+  uint16_t listen_port{8080};
+  uint16_t udp_port{config::UdpTelemConfig::kDefaultDataPort};
+  unsigned udp_hz{0};  ///< 0 — не менять частоту стрима машины
+  RelayConfig relay;
+  size_t backlog_kb{256};  ///< Очередь клиента, сверх которой telem теряется
+  unsigned stats_s{10};
+};
+
+// Клиент → ретранслятор: команды и подписки маленькие
+constexpr size_t kClientMaxPayload = 64 * 1024;
+// Машина → ретранслятор: ответы вроде get_log_data бывают большими
+constexpr size_t kUpstreamMaxPayload = 4 * 1024 * 1024;
+constexpr size_t kMaxHeaderBytes = 8 * 1024;
+constexpr uint64_t kConnectTimeoutMs = 3000;
+constexpr uint64_t kUpstreamSilenceMs = 3000;  ///< Телеметрия идёт постоянно
+constexpr uint64_t kPingIntervalMs = 1000;
+constexpr uint64_t kBackoffMinMs = 250;
+constexpr uint64_t kBackoffMaxMs = 5000;
+constexpr uint64_t kUdpRejoinMs = 2000;
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void OnSignal(int) { g_stop = 1; }
+
+uint64_t NowMs() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+bool SetNonBlocking(int fd) {
+  const int flags = fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+bool ResolveIpv4(const std::string& host, uint16_t port, sockaddr_in& out) {
+  addrinfo hints{};
+  hints.ai_family = AF_INET;
+  addrinfo* res = nullptr;
+  if (getaddrinfo(host.c_str(), nullptr, &hints, &res) != 0 || !res) {
+    return false;
+  }
+  out = *reinterpret_cast<const sockaddr_in*>(res->ai_addr);
+  out.sin_port = htons(port);
+  freeaddrinfo(res);
+  return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// WebSocket-соединение (клиент или upstream)
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct Peer {
+  int fd{-1};
+  bool masks_output{false};  ///< Мы — клиент (upstream): кадры с маской
+  std::string in;
+  std::string out;
+  size_t out_off{0};
+  std::string frag;  ///< Склейка фрагментированного сообщения
+  WsOpcode frag_opcode{WsOpcode::Text};
+  bool in_frag{false};
+
+  [[nodiscard]] size_t Pending() const { return out.size() - out_off; }
+};
+
+std::mt19937& MaskRng() {
+  static std::mt19937 rng{std::random_device{}()};
+  return rng;
+}
+
+void SendFrame(Peer& p, WsOpcode opcode, std::string_view payload) {
+  if (!p.masks_output) {
+    AppendWsFrame(p.out, opcode, payload);
+    return;
+  }
+  const uint32_t r = MaskRng()();
+  uint8_t mask[4];
+  std::memcpy(mask, &r, sizeof(mask));
+  AppendWsFrame(p.out, opcode, payload, mask);
+}
+
+/** Отправить накопленное; false — соединение разорвано. */
+bool Flush(Peer& p) {
+  while (p.out_off < p.out.size()) {
+    const ssize_t n = send(p.fd, p.out.data() + p.out_off,
+                           p.out.size() - p.out_off, MSG_NOSIGNAL);
+    if (n > 0) {
+      p.out_off += static_cast<size_t>(n);
+    } else if (n < 0 && errno == EINTR) {
+      continue;
+    } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      break;
+    } else {
+      return false;
+    }
+  }
+  if (p.out_off == p.out.size()) {
+    p.out.clear();
+    p.out_off = 0;
+  } else if (p.out_off >= 64 * 1024) {
+    p.out.erase(0, p.out_off);
+    p.out_off = 0;
+  }
+  return true;
+}
+
+/** Дочитать сокет в p.in; false — закрыт или ошибка. */
+bool Receive(Peer& p) {
+  char buf[16 * 1024];
+  for (;;) {
+    const ssize_t n = recv(p.fd, buf, sizeof(buf), 0);
+    if (n > 0) {
+      p.in.append(buf, static_cast<size_t>(n));
+      continue;
+    }
+    if (n < 0 && errno == EINTR) continue;
+    return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+  }
+}
+
+/**
+ * @brief Разобрать кадры из p.in; текстовые сообщения — в on_text.
+ *
+ * Ping → Pong, Close → ответный Close. @return false — закрыть соединение.
+ */
+template <typename Fn>
+bool ProcessFrames(Peer& p, size_t max_payload, Fn&& on_text) {
+  size_t off = 0;
+  bool keep = true;
+  while (keep) {
+    auto* data = reinterpret_cast<uint8_t*>(p.in.data()) + off;
+    WsFrame f;
+    const WsFrameStatus st =
+        DecodeWsFrame({data, p.in.size() - off}, max_payload, f);
+    if (st == WsFrameStatus::NeedMore) break;
+    // Клиентские кадры — с маской, серверные — без (RFC 6455 §5.1)
+    if (st != WsFrameStatus::Ok || f.masked == p.masks_output) {
+      SendFrame(p, WsOpcode::Close,
+                st == WsFrameStatus::TooLarge ? "\x03\xF1" : "\x03\xEA");
+      return false;
+    }
+    off += f.frame_len;
+    const std::string_view payload(
+        reinterpret_cast<const char*>(f.payload.data()), f.payload.size());
+    switch (f.opcode) {
+      case WsOpcode::Text:
+      case WsOpcode::Binary:
+        if (p.in_frag) return false;
+        if (!f.fin) {
+          p.frag.assign(payload);
+          p.frag_opcode = f.opcode;
+          p.in_frag = true;
+        } else if (f.opcode == WsOpcode::Text) {
+          on_text(payload);
+        }
+        break;
+      case WsOpcode::Continuation:
+        if (!p.in_frag || p.frag.size() + payload.size() > max_payload) {
+          return false;
+        }
+        p.frag += payload;
+        if (f.fin) {
+          p.in_frag = false;
+          if (p.frag_opcode == WsOpcode::Text) on_text(p.frag);
+          p.frag.clear();
+        }
+        break;
+      case WsOpcode::Ping:
+        SendFrame(p, WsOpcode::Pong, payload);
+        break;
+      case WsOpcode::Pong:
+        break;
+      case WsOpcode::Close:
+        SendFrame(p, WsOpcode::Close, payload.substr(0, 2));
+        keep = false;
+        break;
+    }
+  }
+  p.in.erase(0, off);
+  return keep;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Ретранслятор
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct Client {
+  Peer peer;
+  bool upgraded{false};
+  bool closing{false};
+  std::string addr;
+};
+
+enum class UpstreamState : uint8_t { Idle, Connecting, Handshake, Open };
+
+class Relay {
+ public:
+  explicit Relay(const Options& opt) : opt_(opt), hub_(opt.relay) {}
+
+  bool Start();
+  void Run();
+
+ private:
+  // Локальные клиенты
+  void Accept();
+  void OnClientReadable(uint32_t id, Client& c);
+  void OnClientText(uint32_t id, std::string_view text);
+  void Deliver(std::vector<RelayMessage>& msgs, bool telem);
+  void CloseMarkedClients();
+
+  // Upstream WebSocket
+  void WsConnect(uint64_t now);
+  void WsOnEvent(short revents, uint64_t now);
+  void WsFail(const char* why, uint64_t now);
+  void WsMaintain(uint64_t now);
+
+  // Upstream UDP
+  bool UdpOpen();
+  void UdpSendControl(const char* text);
+  void UdpOnReadable(uint64_t now);
+  void UdpMaintain(uint64_t now);
+  void UdpForwardCommand(uint32_t id, std::string_view text);
+
+  void OnUpstreamText(std::string_view text, uint64_t now);
+  void PrintStats(uint64_t now);
+
+  const Options& opt_;
+  RelayHub hub_;
+  int listen_fd_{-1};
+  std::map<uint32_t, Client> clients_;
+  uint32_t next_id_{1};
+  std::vector<RelayMessage> msgs_;
+  uint64_t dropped_slow_{0};  ///< telem, не влезший в очередь клиента
+
+  sockaddr_in car_addr_{};
+  // WS
+  Peer ws_;
+  UpstreamState ws_state_{UpstreamState::Idle};
+  std::string ws_key_;
+  uint64_t ws_deadline_ms_{0};
+  uint64_t ws_next_attempt_ms_{0};
+  uint64_t ws_backoff_ms_{kBackoffMinMs};
+  uint64_t last_rx_ms_{0};
+  uint64_t last_ping_ms_{0};
+  // UDP
+  int udp_fd_{-1};
+  uint64_t last_join_ms_{0};
+  bool udp_token_valid_{false};
+  uint32_t udp_token_{0};
+  uint16_t udp_cmd_port_{config::UdpCommandConfig::kPort};
+  uint32_t udp_cmd_seq_{0};
+
+  uint64_t stats_ms_{0};
+  RelayHub::Stats stats_prev_{};
+};
+
+bool Relay::Start() {
+  if (!ResolveIpv4(opt_.car, 0, car_addr_)) {
+    std::fprintf(stderr, "cannot resolve %s\n", opt_.car.c_str());
+    return false;
+  }
+  listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+  const int one = 1;
+  setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(opt_.listen_port);
+  if (inet_pton(AF_INET, opt_.bind.c_str(), &addr.sin_addr) != 1 ||
+      bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+      listen(listen_fd_, 16) != 0 || !SetNonBlocking(listen_fd_)) {
+    std::fprintf(stderr, "listen %s:%u: %s\n", opt_.bind.c_str(),
+                 opt_.listen_port, std::strerror(errno));
+    return false;
+  }
+  if (opt_.udp && !UdpOpen()) return false;
+  hub_.SetUpstreamState(opt_.udp ? "udp" : "ws", false);
+  std::printf("relay ws://%s:%u/ <- %s %s\n", opt_.bind.c_str(),
+              opt_.listen_port, opt_.udp ? "udp" : "ws", opt_.car.c_str());
+  return true;
+}
+
+void Relay::Run() {
+  std::vector<pollfd> fds;
+  std::vector<uint32_t> ids;  ///< Клиент для fds[i]; 0 — не клиент
+  stats_ms_ = NowMs();
+  while (!g_stop) {
+    fds.clear();
+    ids.clear();
+    fds.push_back({listen_fd_, POLLIN, 0});
+    ids.push_back(0);
+    const int upstream_fd = opt_.udp ? udp_fd_ : ws_.fd;
+    if (upstream_fd >= 0) {
+      short ev = POLLIN;
+      if (!opt_.udp && (ws_state_ == UpstreamState::Connecting ||
+                        ws_.Pending() > 0)) {
+        ev |= POLLOUT;
+      }
+      fds.push_back({upstream_fd, ev, 0});
+      ids.push_back(0);
+    }
+    for (auto& [id, c] : clients_) {
+      fds.push_back(
+          {c.peer.fd,
+           static_cast<short>(POLLIN | (c.peer.Pending() ? POLLOUT : 0)), 0});
+      ids.push_back(id);
+    }
+
+    if (poll(fds.data(), fds.size(), 100) < 0 && errno != EINTR) {
+      std::perror("poll");
+      return;
+    }
+    const uint64_t now = NowMs();
+
+    for (size_t i = 0; i < fds.size(); ++i) {
+      if (!fds[i].revents) continue;
+      if (fds[i].fd == listen_fd_) {
+        Accept();
+      } else if (ids[i] == 0) {
+        if (opt_.udp) {
+          UdpOnReadable(now);
+        } else {
+          WsOnEvent(fds[i].revents, now);
+        }
+      } else {
+        auto it = clients_.find(ids[i]);
+        if (it == clients_.end() || it->second.closing) continue;
+        Client& c = it->second;
+        if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+          OnClientReadable(ids[i], c);
+        }
+        if (!c.closing && !Flush(c.peer)) c.closing = true;
+      }
+    }
+
+    if (opt_.udp) {
+      UdpMaintain(now);
+    } else {
+      WsMaintain(now);
+    }
+    CloseMarkedClients();
+    if (opt_.stats_s && now - stats_ms_ >= opt_.stats_s * 1000ull) {
+      PrintStats(now);
+    }
+  }
+
+  if (opt_.udp && udp_fd_ >= 0) {
+    char leave[32];
+    std::snprintf(leave, sizeof(leave), "LEAVE %u", opt_.udp_port);
+    UdpSendControl(leave);
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Локальные клиенты
+// ─────────────────────────────────────────────────────────────────────────────
+
+void Relay::Accept() {
+  for (;;) {
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    const int fd = accept(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+    if (fd < 0) return;
+    if (!SetNonBlocking(fd)) {
+      close(fd);
+      continue;
+    }
+    const int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    Client& c = clients_[next_id_++];
+    c.peer.fd = fd;
+    char ip[INET_ADDRSTRLEN] = {};
+    inet_ntop(AF_INET, &addr.sin_addr, ip, sizeof(ip));
+    c.addr = std::string(ip) + ":" + std::to_string(ntohs(addr.sin_port));
+  }
+}
+
+void Relay::OnClientReadable(uint32_t id, Client& c) {
+  if (!Receive(c.peer)) c.closing = true;
+  if (!c.upgraded) {
+    WsUpgradeRequest req;
+    const WsHandshakeStatus st = ParseWsUpgradeRequest(c.peer.in, req);
+    if (st == WsHandshakeStatus::NeedMore) {
+      if (c.peer.in.size() > kMaxHeaderBytes) c.closing = true;
+      return;
+    }
+    if (st == WsHandshakeStatus::BadRequest) {
+      c.peer.out += "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n";
+      Flush(c.peer);
+      c.closing = true;
+      return;
+    }
+    c.peer.out += WsUpgradeResponse(req.key);
+    c.peer.in.erase(0, req.header_len);
+    c.upgraded = true;
+    hub_.AddClient(id);
+    std::printf("client %u %s connected (%zu)\n", id, c.addr.c_str(),
+                hub_.ClientCount());
+  }
+  if (!ProcessFrames(c.peer, kClientMaxPayload, [&](std::string_view text) {
+        OnClientText(id, text);
+      })) {
+    c.closing = true;
+  }
+}
+
+void Relay::OnClientText(uint32_t id, std::string_view text) {
+  msgs_.clear();
+  const auto verdict = hub_.OnClientText(id, text, msgs_);
+  Deliver(msgs_, false);
+  if (verdict != RelayHub::ClientVerdict::Forward) return;
+
+  if (opt_.udp) {
+    UdpForwardCommand(id, text);
+  } else if (ws_state_ == UpstreamState::Open) {
+    SendFrame(ws_, WsOpcode::Text, text);
+    if (!Flush(ws_)) WsFail("send failed", NowMs());
+  } else {
+    msgs_.clear();
+    msgs_.push_back({id, R"({"type":"relay_error","error":"upstream_down"})"});
+    Deliver(msgs_, false);
+  }
+}
+
+void Relay::Deliver(std::vector<RelayMessage>& msgs, bool telem) {
+  const size_t backlog = opt_.backlog_kb * 1024;
+  for (RelayMessage& m : msgs) {
+    auto it = clients_.find(m.client);
+    if (it == clients_.end() || it->second.closing) continue;
+    Peer& p = it->second.peer;
+    // Медленный клиент теряет telem, а не задерживает остальных
+    if (telem && p.Pending() > backlog) {
+      ++dropped_slow_;
+      continue;
+    }
+    SendFrame(p, WsOpcode::Text, m.text);
+    if (p.Pending() > 4 * backlog) it->second.closing = true;
+  }
+}
+
+void Relay::CloseMarkedClients() {
+  for (auto it = clients_.begin(); it != clients_.end();) {
+    if (!it->second.closing) {
+      ++it;
+      continue;
+    }
+    Flush(it->second.peer);  // Close-кадр / 400, если влезет
+    close(it->second.peer.fd);
+    if (it->second.upgraded) {
+      const bool was_controller = hub_.Controller() == it->first;
+      hub_.RemoveClient(it->first);
+      std::printf("client %u %s disconnected%s (%zu)\n", it->first,
+                  it->second.addr.c_str(),
+                  was_controller ? ", control released" : "",
+                  hub_.ClientCount());
+    }
+    it = clients_.erase(it);
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Upstream: WebSocket машины
+// ─────────────────────────────────────────────────────────────────────────────
+
+void Relay::WsConnect(uint64_t now) {
+  ws_ = Peer{};
+  ws_.masks_output = true;
+  ws_.fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr = car_addr_;
+  addr.sin_port = htons(opt_.car_ws_port);
+  if (ws_.fd < 0 || !SetNonBlocking(ws_.fd) ||
+      (connect(ws_.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 &&
+       errno != EINPROGRESS)) {
+    WsFail(std::strerror(errno), now);
+    return;
+  }
+  const int one = 1;
+  setsockopt(ws_.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  ws_state_ = UpstreamState::Connecting;
+  ws_deadline_ms_ = now + kConnectTimeoutMs;
+}
+
+void Relay::WsOnEvent(short revents, uint64_t now) {
+  if (ws_state_ == UpstreamState::Connecting) {
+    if (!(revents & (POLLOUT | POLLERR | POLLHUP))) return;
+    int err = 0;
+    socklen_t len = sizeof(err);
+    getsockopt(ws_.fd, SOL_SOCKET, SO_ERROR, &err, &len);
+    if (err != 0) {
+      WsFail(std::strerror(err), now);
+      return;
+    }
+    uint8_t nonce[16];
+    for (size_t i = 0; i < sizeof(nonce); i += 4) {
+      const uint32_t r = MaskRng()();
+      std::memcpy(nonce + i, &r, 4);
+    }
+    ws_key_ = Base64Encode(nonce);
+    const std::string host =
+        opt_.car + ":" + std::to_string(opt_.car_ws_port);
+    ws_.out = WsClientHandshake(host, opt_.ws_path, ws_key_);
+    ws_state_ = UpstreamState::Handshake;
+  }
+
+  const bool alive = Receive(ws_);
+  if (ws_state_ == UpstreamState::Handshake && !ws_.in.empty()) {
+    size_t header_len = 0;
+    const WsHandshakeStatus st =
+        CheckWsUpgradeResponse(ws_.in, ws_key_, header_len);
+    if (st == WsHandshakeStatus::BadRequest) {
+      WsFail("handshake rejected", now);
+      return;
+    }
+    if (st == WsHandshakeStatus::Ok) {
+      ws_.in.erase(0, header_len);
+      ws_state_ = UpstreamState::Open;
+      ws_backoff_ms_ = kBackoffMinMs;
+      last_rx_ms_ = last_ping_ms_ = now;
+      hub_.SetUpstreamState("ws", true);
+      std::printf("upstream ws://%s:%u%s connected\n", opt_.car.c_str(),
+                  opt_.car_ws_port, opt_.ws_path.c_str());
+    }
+  }
+  if (ws_state_ == UpstreamState::Open) {
+    if (!ws_.in.empty()) last_rx_ms_ = now;
+    if (!ProcessFrames(ws_, kUpstreamMaxPayload, [&](std::string_view text) {
+          OnUpstreamText(text, now);
+        })) {
+      Flush(ws_);
+      WsFail("closed by car", now);
+      return;
+    }
+  }
+  if (!alive) {
+    WsFail("connection lost", now);
+    return;
+  }
+  if (!Flush(ws_)) WsFail("send failed", now);
+}
+
+void Relay::WsFail(const char* why, uint64_t now) {
+  if (ws_state_ == UpstreamState::Open) {
+    std::printf("upstream lost: %s\n", why);
+  } else if (ws_backoff_ms_ == kBackoffMinMs) {
+    std::printf("upstream connect failed: %s (retrying)\n", why);
+  }
+  if (ws_.fd >= 0) close(ws_.fd);
+  ws_.fd = -1;
+  ws_state_ = UpstreamState::Idle;
+  ws_next_attempt_ms_ = now + ws_backoff_ms_;
+  ws_backoff_ms_ = std::min(ws_backoff_ms_ * 2, kBackoffMaxMs);
+  hub_.SetUpstreamState("ws", false);
+}
+
+void Relay::WsMaintain(uint64_t now) {
+  switch (ws_state_) {
+    case UpstreamState::Idle:
+      if (now >= ws_next_attempt_ms_) WsConnect(now);
+      break;
+    case UpstreamState::Connecting:
+    case UpstreamState::Handshake:
+      if (now >= ws_deadline_ms_) WsFail("timeout", now);
+      break;
+    case UpstreamState::Open:
+      // Машина шлёт telem постоянно: тишина — обрыв Wi-Fi без FIN
+      if (now - last_rx_ms_ > kUpstreamSilenceMs) {
+        WsFail("no data", now);
+      } else if (now - last_ping_ms_ >= kPingIntervalMs) {
+        last_ping_ms_ = now;
+        SendFrame(ws_, WsOpcode::Ping, {});
+        if (!Flush(ws_)) WsFail("send failed", now);
+      }
+      break;
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Upstream: UDP-стрим машины
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool Relay::UdpOpen() {
+  udp_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(opt_.udp_port);
+  if (udp_fd_ < 0 ||
+      bind(udp_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+      !SetNonBlocking(udp_fd_)) {
+    std::fprintf(stderr, "udp bind :%u: %s\n", opt_.udp_port,
+                 std::strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+void Relay::UdpSendControl(const char* text) {
+  sockaddr_in addr = car_addr_;
+  addr.sin_port = htons(config::UdpTelemConfig::kControlPort);
+  sendto(udp_fd_, text, std::strlen(text), 0,
+         reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+}
+
+void Relay::UdpOnReadable(uint64_t now) {
+  std::array<uint8_t, 1500> buf;
+  for (;;) {
+    const ssize_t n = recv(udp_fd_, buf.data(), buf.size(), 0);
+    if (n <= 0) return;
+    const std::span<const uint8_t> pkt(buf.data(), static_cast<size_t>(n));
+    uint32_t seq = 0;
+    TelemetryLogFrame frame;
+    if (DecodeUdpTelemPacket(pkt, seq, frame)) {
+      if (now - last_rx_ms_ > kUpstreamSilenceMs) {
+        std::printf("upstream udp stream from %s\n", opt_.car.c_str());
+      }
+      last_rx_ms_ = now;
+      hub_.SetUpstreamState("udp", true);
+      OnUpstreamText(TelemFrameToJson(frame), now);
+      continue;
+    }
+    // Ответы порта управления: JOIN → {"ok":..}, CMDINFO → {.., "token"}
+    std::array<JsonToken, 16> tokens;
+    auto parsed = JsonParseInSitu(reinterpret_cast<char*>(buf.data()),
+                                  pkt.size(), tokens);
+    if (!IsOk(parsed)) continue;
+    const JsonValue reply = GetValue(parsed);
+    if (reply["ok"].AsBool() == false) {
+      const std::string_view error = reply["error"].Str();
+      std::fprintf(stderr, "car: %.*s\n", static_cast<int>(error.size()),
+                   error.data());
+    }
+    uint32_t token = 0, port = 0;
+    if (reply.Read("token", token) && reply.Read("port", port)) {
+      udp_token_valid_ = true;
+      udp_token_ = token;
+      udp_cmd_port_ = static_cast<uint16_t>(port);
+    }
+  }
+}
+
+void Relay::UdpMaintain(uint64_t now) {
+  const bool streaming = now - last_rx_ms_ <= kUpstreamSilenceMs;
+  if (!streaming) hub_.SetUpstreamState("udp", false);
+  // Перезагрузка машины стирает получателей и меняет токен команд
+  if (streaming || now - last_join_ms_ < kUdpRejoinMs) return;
+  last_join_ms_ = now;
+  char join[32];
+  if (opt_.udp_hz) {
+    std::snprintf(join, sizeof(join), "JOIN %u %u", opt_.udp_port, opt_.udp_hz);
+  } else {
+    std::snprintf(join, sizeof(join), "JOIN %u", opt_.udp_port);
+  }
+  UdpSendControl(join);
+  UdpSendControl("CMDINFO");
+  udp_token_valid_ = false;
+}
+
+void Relay::UdpForwardCommand(uint32_t id, std::string_view text) {
+  // По UDP у машины только газ/руль (udp_command.hpp)
+  std::string buf(text);
+  std::array<JsonToken, 32> tokens;
+  auto parsed = JsonParseInSitu(buf.data(), buf.size(), tokens);
+  const char* error = nullptr;
+  if (!IsOk(parsed) || GetValue(parsed)["type"].Str() != "cmd") {
+    error = "udp_upstream_cmd_only";
+  } else if (!udp_token_valid_) {
+    error = "no_cmd_token";
+  }
+  if (error) {
+    msgs_.clear();
+    msgs_.push_back({id, std::string(R"({"type":"relay_error","error":")") +
+                             error + "\"}"});
+    Deliver(msgs_, false);
+    return;
+  }
+  const JsonValue json = GetValue(parsed);
+  JsonValue throttle = json["throttle"];
+  if (!throttle.Valid()) throttle = json["thr"];
+  const UdpCommandPacket pkt = MakeUdpCommand(
+      ++udp_cmd_seq_, udp_token_, throttle.AsFloat().value_or(0.0f),
+      json["steering"].AsFloat().value_or(0.0f));
+  sockaddr_in addr = car_addr_;
+  addr.sin_port = htons(udp_cmd_port_);
+  sendto(udp_fd_, &pkt, sizeof(pkt), 0,
+         reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Общее
+// ─────────────────────────────────────────────────────────────────────────────
+
+void Relay::OnUpstreamText(std::string_view text, uint64_t now) {
+  msgs_.clear();
+  hub_.OnUpstreamText(text, now, msgs_);
+  Deliver(msgs_, TelemJsonType(text) == "telem");
+  for (auto& [id, c] : clients_) {
+    if (!c.closing && !Flush(c.peer)) c.closing = true;
+  }
+}
+
+void Relay::PrintStats(uint64_t now) {
+  const RelayHub::Stats& s = hub_.GetStats();
+  const double dt = static_cast<double>(now - stats_ms_) * 1e-3;
+  std::printf(
+      "clients %zu%s | upstream %s | telem in %.1f/s out %.1f/s "
+      "(skipped %llu, slow %llu) | cmd %llu (rejected %llu)\n",
+      hub_.ClientCount(), hub_.HasController() ? " +ctrl" : "",
+      (opt_.udp ? now - last_rx_ms_ <= kUpstreamSilenceMs
+                : ws_state_ == UpstreamState::Open)
+          ? "up"
+          : "down",
+      static_cast<double>(s.telem_in - stats_prev_.telem_in) / dt,
+      static_cast<double>(s.telem_out - stats_prev_.telem_out) / dt,
+      static_cast<unsigned long long>(s.telem_skipped),
+      static_cast<unsigned long long>(dropped_slow_),
+      static_cast<unsigned long long>(s.cmd_forwarded),
+      static_cast<unsigned long long>(s.cmd_rejected));
+  std::fflush(stdout);
+  stats_prev_ = s;
+  stats_ms_ = now;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// CLI
+// ─────────────────────────────────────────────────────────────────────────────
+
+void PrintUsage(const char* argv0) {
+  std::fprintf(stderr,
+               "Usage: %s [--car HOST] [--upstream ws|udp] [--car-port P] "
+               "[--ws-path PATH]\n"
+               "          [--bind ADDR] [--listen PORT] [--udp-port P] "
+               "[--udp-hz HZ]\n"
+               "          [--control-token TOKEN] [--default-hz HZ] "
+               "[--max-hz HZ]\n"
+               "          [--backlog-kb KB] [--stats-s S]\n",
+               argv0);
+}
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+  const auto port = [](const char* s) {
+    return static_cast<uint16_t>(std::strtoul(s, nullptr, 10));
+  };
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view a = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (a == "--car" && has_value) {
+      opt.car = argv[++i];
+    } else if (a == "--upstream" && has_value) {
+      const std::string_view v = argv[++i];
+      if (v != "ws" && v != "udp") return false;
+      opt.udp = v == "udp";
+    } else if (a == "--car-port" && has_value) {
+      opt.car_ws_port = port(argv[++i]);
+    } else if (a == "--ws-path" && has_value) {
+      opt.ws_path = argv[++i];
+    } else if (a == "--bind" && has_value) {
+      opt.bind = argv[++i];
+    } else if (a == "--listen" && has_value) {
+      opt.listen_port = port(argv[++i]);
+    } else if (a == "--udp-port" && has_value) {
+      opt.udp_port = port(argv[++i]);
+    } else if (a == "--udp-hz" && has_value) {
+      opt.udp_hz = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (a == "--control-token" && has_value) {
+      opt.relay.control_token = argv[++i];
+    } else if (a == "--default-hz" && has_value) {
+      opt.relay.default_hz =
+          static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (a == "--max-hz" && has_value) {
+      opt.relay.max_hz =
+          static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (a == "--backlog-kb" && has_value) {
+      opt.backlog_kb = std::strtoul(argv[++i], nullptr, 10);
+    } else if (a == "--stats-s" && has_value) {
+      opt.stats_s = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      return false;
+    }
+  }
+  return opt.listen_port != 0 && opt.car_ws_port != 0 &&
+         opt.udp_port >= 1024 && opt.backlog_kb > 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  if (!ParseArgs(argc, argv, opt)) {
+    PrintUsage(argv[0]);
+    return 2;
+  }
+  std::signal(SIGINT, OnSignal);
+  std::signal(SIGTERM, OnSignal);
+  std::signal(SIGPIPE, SIG_IGN);
+  std::setvbuf(stdout, nullptr, _IOLBF, 0);
+
+  Relay relay(opt);
+  if (!relay.Start()) return 1;
+  relay.Run();
+  return 0;
+}
@@ -0,0 +1,40 @@
+// Хостовый бенчмарк фильтров: поштучный vs пакетный путь Madgwick/EKF,
+// стоимость тика онлайн-идентификации (OnlineSysId), std:: против
+// fast_math.hpp (atan2 + asin + 1/√x + sincos на семпл).
+// Запуск: ./filter_bench [samples]   (по умолчанию 100000)
+// На устройстве тот же замер — WS-команда {"type":"bench_filters"}.
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "filter_benchmark.hpp"
+
+int main(int argc, char** argv) {
+  const size_t samples =
+      argc > 1 ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10))
+               : 100000;
+  const auto r = rc_vehicle::RunFilterBenchmark(samples);
+
+  std::printf("samples: %u\n", static_cast<unsigned>(r.samples));
+  std::printf("%-10s %14s %14s %8s\n", "filter", "single [S/s]", "batch [S/s]",
+              "speedup");
+  std::printf("%-10s %14.0f %14.0f %7.2fx\n", "madgwick", r.madgwick_single_sps,
+              r.madgwick_batch_sps,
+              r.madgwick_single_sps > 0.0f
+                  ? r.madgwick_batch_sps / r.madgwick_single_sps
+                  : 0.0f);
+  std::printf("%-10s %14.0f %14.0f %7.2fx\n", "ekf", r.ekf_single_sps,
+              r.ekf_batch_sps,
+              r.ekf_single_sps > 0.0f ? r.ekf_batch_sps / r.ekf_single_sps
+                                      : 0.0f);
+  std::printf("%-10s %14.0f  (%.0f ns/tick avg, %u ns worst tick)\n",
+              "sysid", r.sysid_sps,
+              r.sysid_sps > 0.0f ? 1e9f / r.sysid_sps : 0.0f,
+              static_cast<unsigned>(r.sysid_max_tick_cycles));
+  std::printf("%-10s %14.0f %14.0f %7.2fx  (std / fast)\n", "math",
+              r.math_std_sps, r.math_fast_sps,
+              r.math_std_sps > 0.0f ? r.math_fast_sps / r.math_std_sps
+                                    : 0.0f);
+  std::printf("batch == single: %s\n", r.outputs_match ? "yes" : "NO");
+  return r.outputs_match ? 0 : 1;
+}
@@ -0,0 +1,208 @@
+// Хостовый бенчмарк разбора входящих команд: cJSON_Parse + cJSON_GetObjectItem
+// (как было в ws_handler / обработчиках) против JsonParseInSitu + JsonBind.
+// Для каждого сообщения — мкс на сообщение и число malloc на сообщение.
+// Вторая таблица — сборка и печать ответа cJSON: malloc против арены
+// (json_arena.hpp).
+// Запуск: ./json_bench [iterations]   (по умолчанию 200000)
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "cJSON.h"
+#include "json_arena.hpp"
+#include "json_reader.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+size_t g_mallocs = 0;
+
+void* CountingMalloc(size_t sz) {
+  ++g_mallocs;
+  return std::malloc(sz);
+}
+
+struct Message {
+  const char* name;
+  const char* json;
+};
+
+// Реальные сообщения веб-интерфейса (app.js)
+constexpr Message kMessages[] = {
+    {"cmd", R"({"type":"cmd","throttle":0.35,"steering":-0.125})"},
+    {"log_since", R"({"type":"log_since","seq":123456,"max":200})"},
+    {"start_test",
+     R"({"type":"start_test","test_type":"circle","target_accel":0.15,)"
+     R"("duration":5,"steering":0.6})"},
+    {"set_stab_config",
+     R"({"type":"set_stab_config","mode":1,"enabled":true,"filter":{)"
+     R"("madgwick_enabled":true,"ekf_enabled":true,)"
+     R"("adaptive_beta_enabled":false,"adaptive_accel_threshold_g":0.2},)"
+     R"("yaw_rate":{"pid":{"kp":0.1,"ki":0.02,"kd":0.001,)"
+     R"("max_correction":0.3}},"adaptive":{"enabled":true,)"
+     R"("speed_ref_ms":1.5},"pitch_comp":{"enabled":false,"gain":0.5,)"
+     R"("max_correction":0.2},"oversteer":{"warn_enabled":true,)"
+     R"("slip_thresh_deg":12,"rate_thresh_deg_s":60,)"
+     R"("throttle_reduction":0.3},"kids_mode":{"throttle_limit":0.4,)"
+     R"("reverse_limit":0.4,"steering_limit":0.7,)"
+     R"("speed_limit_enabled":false,"max_speed_ms":1.5},)"
+     R"("slew_steering":3,"slew_throttle":2,"braking_mode":1,)"
+     R"("brake_slew_multiplier":2,"steering_trim":0,"throttle_trim":0})"},
+};
+
+/** Поля, которые читает обработчик (одинаково для обоих путей). */
+struct Fields {
+  const char* type = nullptr;
+  float a = 0.0f;
+  float b = 0.0f;
+  JsonValue nested;
+};
+
+constexpr JsonField<Fields> kSchema[] = {
+    {"type", &Fields::type},         {"throttle", &Fields::a},
+    {"steering", &Fields::b},        {"seq", &Fields::a},
+    {"target_accel", &Fields::a},    {"duration", &Fields::b},
+    {"yaw_rate", &Fields::nested},
+};
+
+double Checksum(const Fields& f) { return f.a + f.b + (f.type ? 1 : 0); }
+
+double RunCjson(const char* json, int iters, double& sink) {
+  const auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < iters; ++i) {
+    cJSON* root = cJSON_Parse(json);
+    Fields f;
+    const cJSON* t = cJSON_GetObjectItem(root, "type");
+    f.type = cJSON_IsString(t) ? t->valuestring : nullptr;
+    for (const char* k : {"throttle", "seq", "target_accel"}) {
+      const cJSON* it = cJSON_GetObjectItem(root, k);
+      if (cJSON_IsNumber(it)) f.a = static_cast<float>(it->valuedouble);
+    }
+    for (const char* k : {"steering", "duration"}) {
+      const cJSON* it = cJSON_GetObjectItem(root, k);
+      if (cJSON_IsNumber(it)) f.b = static_cast<float>(it->valuedouble);
+    }
+    const cJSON* yaw = cJSON_GetObjectItem(root, "yaw_rate");
+    const cJSON* kp = cJSON_GetObjectItem(cJSON_GetObjectItem(yaw, "pid"),
+                                          "kp");
+    if (cJSON_IsNumber(kp)) f.b += static_cast<float>(kp->valuedouble);
+    sink += Checksum(f);
+    cJSON_Delete(root);
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(t1 - t0).count() / iters;
+}
+
+double RunInSitu(const char* json, int iters, double& sink) {
+  const size_t len = std::strlen(json);
+  char buf[2048];
+  std::array<JsonToken, 128> tokens;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < iters; ++i) {
+    std::memcpy(buf, json, len + 1);  // Как приём кадра в буфер
+    const auto r = JsonParseInSitu(buf, len, tokens);
+    if (!IsOk(r)) std::abort();
+    Fields f;
+    JsonBind(GetValue(r), kSchema, f);
+    if (auto kp = f.nested["pid"]["kp"].AsFloat()) f.b += *kp;
+    sink += Checksum(f);
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(t1 - t0).count() / iters;
+}
+
+/** Ответ обычного размера: как udp_stream_status + вложенный объект. */
+size_t BuildAndPrintReply(int i) {
+  cJSON* reply = cJSON_CreateObject();
+  cJSON_AddStringToObject(reply, "type", "udp_stream_status");
+  cJSON_AddBoolToObject(reply, "streaming", true);
+  cJSON_AddStringToObject(reply, "ip", "192.168.4.100");
+  cJSON_AddNumberToObject(reply, "port", 5555);
+  cJSON_AddNumberToObject(reply, "hz", 100);
+  cJSON_AddNumberToObject(reply, "seq", 12345 + i);
+  cJSON_AddNumberToObject(reply, "dropped", 3);
+  cJSON* calib = cJSON_AddObjectToObject(reply, "calib");
+  for (const char* k : {"gx", "gy", "gz", "ax", "ay", "az"}) {
+    cJSON_AddNumberToObject(calib, k, 0.001 * i);
+  }
+  cJSON* targets = cJSON_AddArrayToObject(reply, "targets");
+  for (int t = 0; t < 3; ++t) {
+    cJSON* o = cJSON_CreateObject();
+    cJSON_AddStringToObject(o, "ip", "192.168.4.2");
+    cJSON_AddNumberToObject(o, "port", 5555 + t);
+    cJSON_AddItemToArray(targets, o);
+  }
+  char* str = cJSON_PrintUnformatted(reply);
+  const size_t len = str ? std::strlen(str) : 0;
+  cJSON_free(str);
+  cJSON_Delete(reply);
+  return len;
+}
+
+double RunReply(int iters, BumpArena* arena, size_t& sink) {
+  const auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < iters; ++i) {
+    if (arena) {
+      JsonArenaScope scope(*arena);
+      sink += BuildAndPrintReply(i);
+    } else {
+      sink += BuildAndPrintReply(i);
+    }
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(t1 - t0).count() / iters;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int iters = argc > 1 ? std::atoi(argv[1]) : 200000;
+  cJSON_Hooks hooks{CountingMalloc, std::free};
+  cJSON_InitHooks(&hooks);
+
+  std::printf("%-16s %6s %12s %12s %8s %12s\n", "message", "bytes",
+              "cJSON [us]", "in-situ [us]", "speedup", "cJSON malloc");
+  double sink = 0.0;
+  for (const auto& m : kMessages) {
+    g_mallocs = 0;
+    const double c = RunCjson(m.json, iters, sink);
+    const double mallocs = static_cast<double>(g_mallocs) / iters;
+    g_mallocs = 0;
+    const double s = RunInSitu(m.json, iters, sink);
+    std::printf("%-16s %6zu %12.3f %12.3f %7.1fx %12.0f\n", m.name,
+                std::strlen(m.json), c, s, s > 0.0 ? c / s : 0.0, mallocs);
+    if (g_mallocs != 0) {
+      std::printf("in-situ path allocated %zu times\n", g_mallocs);
+      return 1;
+    }
+  }
+  std::printf("(checksum %.1f)\n", sink);
+
+  // Ответы: malloc (счётчик) против арены
+  size_t reply_sink = 0;
+  g_mallocs = 0;
+  const double heap_us = RunReply(iters, nullptr, reply_sink);
+  const double heap_mallocs = static_cast<double>(g_mallocs) / iters;
+
+  static StaticBumpArena<4096> arena;
+  JsonArenaInstallHooks();
+  JsonArenaResetStats();
+  const double arena_us = RunReply(iters, &arena, reply_sink);
+  const JsonArenaStats st = JsonArenaGetStats();
+  std::printf("\n%-16s %12s %12s %8s %12s %12s\n", "reply", "malloc [us]",
+              "arena [us]", "speedup", "malloc/req", "arena peak");
+  std::printf("%-16s %12.3f %12.3f %7.1fx %12.0f %12u\n", "udp_stream_status",
+              heap_us, arena_us, arena_us > 0.0 ? heap_us / arena_us : 0.0,
+              heap_mallocs, st.high_water);
+  if (st.heap_fallbacks != 0 || st.unscoped_allocs != 0) {
+    std::printf("arena path fell back to heap %u times\n", st.heap_fallbacks);
+    return 1;
+  }
+  std::printf("(reply bytes %zu)\n", reply_sink);
+  return 0;
+}
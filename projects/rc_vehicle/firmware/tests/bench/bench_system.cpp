@@ -0,0 +1,306 @@
+// Системный бенчмарк прошивки на хосте: VehicleControlUnified целиком
+// (control task + udp_ctrl + ws_telem) на HostPlatform, датчики — SimVehicle,
+// клиенты — потоки на loopback UDP/TCP.
+//
+// Фазы:
+//   boot     — до завершения авто-калибровки IMU;
+//   drive    — команды 50 Hz по UDP, телеметрия N клиентам;
+//   drive+dl — то же плюс непрерывная выгрузка лога порциями log_since
+//              по loopback TCP (как GET /api/log_since);
+//   loss     — команды с потерей 10% датаграмм (имитация на отправителе);
+//   loss+dup — то же, каждая команда отправляется дважды.
+// Команды — UdpCommandPacket (udp_command.hpp), приём через UdpCommandFilter.
+// Для каждой фазы: опоздание тика control loop, команда → PWM, интервал
+// между принятыми командами, задержка и частота телеметрии у клиентов,
+// пропускная способность выгрузки.
+//
+// Запуск: ./system_bench [seconds_per_phase] [ws_clients] [erased]
+//   (по умолч. 5 и 2). «erased» — платформа передаётся как
+//   unique_ptr<VehicleControlPlatform>: тик через виртуальные вызовы, для
+//   сравнения стоимости тика со статической диспетчеризацией HostPlatform.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+
+#include "config.hpp"
+#include "host_platform.hpp"
+#include "vehicle_control_unified.hpp"
+
+using namespace rc_vehicle;
+using namespace rc_vehicle::bench;
+
+namespace {
+
+/// Клиент телеметрии: считает кадры и задержку SendTelem → приём
+struct TelemClient {
+  int fd{-1};
+  std::atomic<uint64_t> frames{0};
+  Samples latency;
+};
+
+void TelemClientTask(TelemClient& c, const std::atomic<bool>& stop) {
+  char buf[4096];
+  while (!stop.load()) {
+    const ssize_t n = recv(c.fd, buf, sizeof(buf), 0);
+    if (n < static_cast<ssize_t>(sizeof(int64_t))) continue;
+    int64_t sent_ns = 0;
+    std::memcpy(&sent_ns, buf, sizeof(sent_ns));
+    c.latency.Add(NowNs() - sent_ns);
+    c.frames.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+/// Параметры канала команд фазы
+struct CommandLink {
+  double loss{0.0};    ///< Доля потерянных датаграмм (каждая копия отдельно)
+  unsigned copies{1};  ///< Отправок одной команды (--dup)
+};
+
+/// Пульт: команды 50 Hz по UDP (синусоида руля, постоянный газ); seq —
+/// сквозной между фазами, как у одного клиента
+void CommandTask(HostPlatform& platform, CommandLink link, uint32_t& seq,
+                 const std::atomic<bool>& stop) {
+  const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  const sockaddr_in addr = LoopbackAddr(platform.CommandPort());
+  std::mt19937 rng(42);
+  std::bernoulli_distribution lost(link.loss);
+  auto next = Clock::now();
+  while (!stop.load()) {
+    ++seq;
+    const UdpCommandPacket pkt = MakeUdpCommand(
+        seq, platform.CommandToken(), 0.3f, 0.5f * std::sin(seq * 0.05f));
+    platform.NoteCommandSent(seq, NowNs());
+    for (unsigned i = 0; i < link.copies; ++i) {
+      if (lost(rng)) continue;
+      sendto(fd, &pkt, sizeof(pkt), 0,
+             reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    }
+    next += std::chrono::milliseconds(20);
+    std::this_thread::sleep_until(next);
+  }
+  close(fd);
+}
+
+/// Loopback TCP: пара (отправитель, приёмник) для выгрузки лога
+bool OpenTcpPair(int& tx, int& rx) {
+  const int listener = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr = LoopbackAddr(0);
+  socklen_t len = sizeof(addr);
+  if (listener < 0 ||
+      bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      listen(listener, 1) < 0 ||
+      getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len) < 0) {
+    if (listener >= 0) close(listener);
+    return false;
+  }
+  tx = socket(AF_INET, SOCK_STREAM, 0);
+  const bool ok =
+      connect(tx, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+  rx = ok ? accept(listener, nullptr, nullptr) : -1;
+  close(listener);
+  return ok && rx >= 0;
+}
+
+/// Выгрузка лога с начала порциями по 32 кадра, пока не догнали head
+void LogDownloadTask(const IVehicleControl& vc, int tx,
+                     std::atomic<uint64_t>& bytes,
+                     std::atomic<uint64_t>& frames,
+                     const std::atomic<bool>& stop) {
+  using Cfg = config::TelemetryLogConfig;
+  constexpr size_t kBatch = 32;
+  TelemetryLogFrame batch[kBatch];
+  while (!stop.load()) {
+    uint64_t seq = 0;
+    while (!stop.load()) {
+      const TelemetryLogSpan span =
+          vc.ReadLogSince(seq, batch, kBatch, Cfg::kSinceGapSkipFrames);
+      if (span.count == 0) break;
+      const size_t n = span.count * sizeof(TelemetryLogFrame);
+      if (send(tx, batch, n, MSG_NOSIGNAL) != static_cast<ssize_t>(n)) return;
+      bytes.fetch_add(n, std::memory_order_relaxed);
+      frames.fetch_add(span.count, std::memory_order_relaxed);
+      seq = span.first_seq + span.count;
+    }
+  }
+}
+
+void DrainTask(int rx, const std::atomic<bool>& stop) {
+  char buf[16384];
+  while (!stop.load()) {
+    if (recv(rx, buf, sizeof(buf), 0) <= 0) return;
+  }
+}
+
+void PrintRow(const char* name, const Samples& s) {
+  std::printf("  %-22s %9.1f %9.1f %9.1f   (n=%zu)\n", name,
+              s.PercentileUs(0.5), s.PercentileUs(0.99), s.PercentileUs(1.0),
+              s.Count());
+}
+
+struct PhaseResult {
+  double seconds{0.0};
+  UdpCommandStats cmd;  ///< Приращение счётчиков UdpCommandFilter за фазу
+  uint64_t pwm_updates{0};
+  uint64_t telem_enqueued{0};
+  uint64_t telem_overwritten{0};
+  uint64_t log_bytes{0};
+  uint64_t log_frames{0};
+};
+
+void Report(const char* phase, const PhaseResult& r, HostPlatform& p,
+            std::vector<std::unique_ptr<TelemClient>>& clients) {
+  std::printf("\n[%s] %.1f s\n", phase, r.seconds);
+  std::printf("  %-22s %9s %9s %9s\n", "latency [us]", "p50", "p99", "max");
+  PrintRow("control tick lateness", p.loop_lateness);
+  PrintRow("control tick cost", p.tick_cost);
+  PrintRow("command -> PWM", p.cmd_to_pwm);
+  PrintRow("command gap", p.cmd_gap);
+  PrintRow("telem queue -> send", p.telem_enqueue);
+  for (size_t i = 0; i < clients.size(); ++i) {
+    char name[40];  // "telem -> client " + до 20 цифр size_t
+    std::snprintf(name, sizeof(name), "telem -> client %zu", i);
+    PrintRow(name, clients[i]->latency);
+  }
+  std::printf("  PWM updates: %.0f /s\n", r.pwm_updates / r.seconds);
+  std::printf("  udp commands: %u accepted, %u duplicate, %u stale\n",
+              r.cmd.accepted, r.cmd.duplicate, r.cmd.stale);
+  std::printf("  telemetry: %.1f /s enqueued, %llu overwritten in queue\n",
+              r.telem_enqueued / r.seconds,
+              static_cast<unsigned long long>(r.telem_overwritten));
+  for (size_t i = 0; i < clients.size(); ++i) {
+    std::printf("  client %zu: %.1f frames/s\n", i,
+                clients[i]->frames.load() / r.seconds);
+  }
+  if (r.log_bytes > 0) {
+    std::printf("  log download: %.1f MB/s (%.0f frames/s)\n",
+                r.log_bytes / r.seconds / 1e6, r.log_frames / r.seconds);
+  }
+}
+
+void ResetMetrics(HostPlatform& p,
+                  std::vector<std::unique_ptr<TelemClient>>& clients) {
+  p.loop_lateness.Clear();
+  p.tick_cost.Clear();
+  p.cmd_to_pwm.Clear();
+  p.cmd_gap.Clear();
+  p.telem_enqueue.Clear();
+  for (auto& c : clients) {
+    c->latency.Clear();
+    c->frames.store(0);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const double phase_s = argc > 1 ? std::atof(argv[1]) : 5.0;
+  const unsigned n_clients =
+      argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10))
+               : 2;
+  const bool type_erased = argc > 3 && std::strcmp(argv[3], "erased") == 0;
+
+  VehicleControlUnified vc;
+  auto owned = std::make_unique<HostPlatform>(n_clients);
+  HostPlatform& platform = *owned;
+  if (!platform.SocketsOk()) {
+    std::fprintf(stderr, "loopback sockets unavailable\n");
+    return 1;
+  }
+
+  std::atomic<bool> stop_clients{false};
+  std::vector<std::unique_ptr<TelemClient>> clients;
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < n_clients; ++i) {
+    clients.push_back(std::make_unique<TelemClient>());
+    clients.back()->fd = platform.ClientFd(i);
+    threads.emplace_back(TelemClientTask, std::ref(*clients.back()),
+                         std::cref(stop_clients));
+  }
+
+  // Задачи платформы — до разрушения vc (бесконечный цикл control task)
+  auto shutdown_all = [&](int code) {
+    platform.StopTasks();
+    stop_clients.store(true);
+    for (auto& t : threads) t.join();
+    return code;
+  };
+
+  // ── boot ─────────────────────────────────────────────────────────────────
+  const int64_t boot_start = NowNs();
+  if (type_erased) {
+    vc.SetPlatform(std::unique_ptr<VehicleControlPlatform>(std::move(owned)));
+  } else {
+    vc.SetPlatform(std::move(owned));
+  }
+  std::printf("control tick dispatch: %s\n",
+              type_erased ? "virtual (VehicleControlPlatform)"
+                          : "static (HostPlatform)");
+  if (vc.Init() != PlatformError::Ok) {
+    std::fprintf(stderr, "VehicleControlUnified::Init failed\n");
+    return shutdown_all(1);
+  }
+  while (!vc.IsReady() || std::strcmp(vc.GetCalibStatus(), "done") != 0) {
+    if (NowNs() - boot_start > 10'000'000'000LL) {
+      std::fprintf(stderr, "calibration did not finish: %s\n",
+                   vc.GetCalibStatus());
+      return shutdown_all(1);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  std::printf("boot -> calibrated: %.0f ms\n", (NowNs() - boot_start) * 1e-6);
+
+  uint32_t cmd_seq = 0;
+  auto run_phase = [&](const char* name, bool download, CommandLink link) {
+    ResetMetrics(platform, clients);
+    PhaseResult r;
+    const UdpCommandStats cmd0 = platform.CommandStats();
+    const uint64_t pwm0 = platform.pwm_updates.load();
+    const uint64_t enq0 = platform.telem_enqueued.load();
+    const uint64_t ovw0 = platform.telem_overwritten.load();
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> log_bytes{0};
+    std::atomic<uint64_t> log_frames{0};
+    std::vector<std::thread> phase_threads;
+    phase_threads.emplace_back(CommandTask, std::ref(platform), link,
+                               std::ref(cmd_seq), std::cref(stop));
+    int tx = -1;
+    int rx = -1;
+    if (download && OpenTcpPair(tx, rx)) {
+      phase_threads.emplace_back(DrainTask, rx, std::cref(stop));
+      phase_threads.emplace_back(LogDownloadTask, std::cref(vc), tx,
+                                 std::ref(log_bytes), std::ref(log_frames),
+                                 std::cref(stop));
+    }
+
+    const int64_t t0 = NowNs();
+    std::this_thread::sleep_for(std::chrono::duration<double>(phase_s));
+    stop.store(true);
+    r.seconds = (NowNs() - t0) * 1e-9;
+    if (tx >= 0) shutdown(tx, SHUT_RDWR);
+    for (auto& t : phase_threads) t.join();
+    if (tx >= 0) close(tx);
+    if (rx >= 0) close(rx);
+
+    r.pwm_updates = platform.pwm_updates.load() - pwm0;
+    r.telem_enqueued = platform.telem_enqueued.load() - enq0;
+    r.telem_overwritten = platform.telem_overwritten.load() - ovw0;
+    r.log_bytes = log_bytes.load();
+    r.log_frames = log_frames.load();
+    const UdpCommandStats cmd1 = platform.CommandStats();
+    r.cmd.accepted = cmd1.accepted - cmd0.accepted;
+    r.cmd.duplicate = cmd1.duplicate - cmd0.duplicate;
+    r.cmd.stale = cmd1.stale - cmd0.stale;
+    Report(name, r, platform, clients);
+  };
+
+  run_phase("drive", false, {});
+  run_phase("drive+dl", true, {});
+  run_phase("loss 10%", false, {0.1, 1});
+  run_phase("loss 10% + dup", false, {0.1, 2});
+  return shutdown_all(0);
+}
@@ -0,0 +1,467 @@
+#pragma once
+
+// HostPlatform — VehicleControlPlatform для системного бенчмарка на Linux.
+//
+// Повторяет топологию задач прошивки потоками std::thread:
+//   control   — VehicleControlUnified::ControlTaskLoop (CreateTask), период
+//               через sleep_until по абсолютному дедлайну, как vTaskDelayUntil;
+//   udp_ctrl  — приём UdpCommandPacket по loopback UDP через UdpCommandFilter
+//               (как udp_cmd) в слот «последняя команда» (xQueueOverwrite
+//               в VehicleControlPlatformEsp32);
+//   ws_telem  — очередь глубины 1 (WebSocketEnqueueTelem) и рассылка JSON
+//               всем клиентам по loopback UDP.
+// Источник датчиков — SimVehicle (кинематика по текущему PWM).
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "failsafe.hpp"
+#include "udp_command.hpp"
+#include "vehicle_control_platform.hpp"
+
+namespace rc_vehicle {
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+inline int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             Clock::now().time_since_epoch())
+      .count();
+}
+
+// ═════════════════════════════════════════════════════════════════════════════
+// Samples — выборка задержек [нс]
+// ═════════════════════════════════════════════════════════════════════════════
+
+class Samples {
+ public:
+  void Add(int64_t ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ns_.push_back(ns);
+  }
+
+  /** Перцентиль q ∈ [0, 1] в мкс; 0 если выборка пуста. */
+  double PercentileUs(double q) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ns_.empty()) return 0.0;
+    std::vector<int64_t> v = ns_;
+    const size_t k = std::min(v.size() - 1,
+                              static_cast<size_t>(q * (v.size() - 1) + 0.5));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k] * 1e-3;
+  }
+
+  size_t Count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ns_.size();
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ns_.clear();
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<int64_t> ns_;
+};
+
+// ═════════════════════════════════════════════════════════════════════════════
+// SimVehicle — источник IMU
+// ═════════════════════════════════════════════════════════════════════════════
+
+/** Кинематика машины: газ → ускорение, руль → yaw rate (первый порядок). */
+class SimVehicle {
+ public:
+  void SetPwm(float throttle, float steering) {
+    throttle_ = throttle;
+    steering_ = steering;
+  }
+
+  ImuData Step(float dt_s) {
+    constexpr float kAccelPerThrottle = 8.0f;  // м/с² при газе 1
+    constexpr float kDrag = 0.8f;              // 1/с
+    constexpr float kYawDpsPerSteerMs = 40.0f;
+    constexpr float kYawTauS = 0.15f;
+    constexpr float kG = 9.80665f;
+
+    const float accel = kAccelPerThrottle * throttle_ - kDrag * speed_ms_;
+    speed_ms_ = std::max(0.0f, speed_ms_ + accel * dt_s);
+    const float yaw_target = kYawDpsPerSteerMs * steering_ * speed_ms_;
+    yaw_dps_ += dt_s / kYawTauS * (yaw_target - yaw_dps_);
+
+    ImuData d{};
+    d.ax = accel / kG;
+    d.ay = speed_ms_ * yaw_dps_ * 0.0174533f / kG;
+    d.az = 1.0f;
+    d.gz = yaw_dps_;
+    return d;
+  }
+
+ private:
+  float throttle_{0.0f};
+  float steering_{0.0f};
+  float speed_ms_{0.0f};
+  float yaw_dps_{0.0f};
+};
+
+// ═════════════════════════════════════════════════════════════════════════════
+// Loopback UDP
+// ═════════════════════════════════════════════════════════════════════════════
+
+/** UDP-сокет на 127.0.0.1:<ephemeral> с тайм-аутом приёма 50 мс. */
+inline int OpenLoopbackUdp(uint16_t& port_out) {
+  const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) return -1;
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  socklen_t len = sizeof(addr);
+  if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) < 0) {
+    close(fd);
+    return -1;
+  }
+  timeval tv{0, 50000};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  port_out = ntohs(addr.sin_port);
+  return fd;
+}
+
+inline sockaddr_in LoopbackAddr(uint16_t port) {
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  return addr;
+}
+
+/** Команда в слоте источника (с временем отправки для задержки). */
+struct BenchCommand {
+  uint32_t seq;
+  float throttle;
+  float steering;
+  int64_t send_ns;
+};
+
+// ═════════════════════════════════════════════════════════════════════════════
+// HostPlatform
+// ═════════════════════════════════════════════════════════════════════════════
+
+class HostPlatform final : public VehicleControlPlatform {
+ public:
+  /** Выход из ControlTaskLoop при остановке (бесконечный цикл задачи). */
+  struct StopTask : std::exception {};
+
+  explicit HostPlatform(unsigned ws_clients) : ws_clients_(ws_clients) {
+    start_ = Clock::now();
+    cmd_fd_ = OpenLoopbackUdp(cmd_port_);
+    telem_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    for (unsigned i = 0; i < ws_clients_; ++i) {
+      uint16_t port = 0;
+      client_fds_.push_back(OpenLoopbackUdp(port));
+      client_ports_.push_back(port);
+    }
+  }
+
+  ~HostPlatform() override {
+    StopTasks();
+    if (cmd_fd_ >= 0) close(cmd_fd_);
+    if (telem_fd_ >= 0) close(telem_fd_);
+    for (int fd : client_fds_) {
+      if (fd >= 0) close(fd);
+    }
+  }
+
+  HostPlatform(const HostPlatform&) = delete;
+  HostPlatform& operator=(const HostPlatform&) = delete;
+
+  [[nodiscard]] bool SocketsOk() const {
+    return cmd_fd_ >= 0 && telem_fd_ >= 0 &&
+           std::none_of(client_fds_.begin(), client_fds_.end(),
+                        [](int fd) { return fd < 0; });
+  }
+
+  [[nodiscard]] uint16_t CommandPort() const { return cmd_port_; }
+  [[nodiscard]] uint32_t CommandToken() const { return kCommandToken; }
+
+  /** Пульт: время отправки команды seq (для «команда → PWM»). */
+  void NoteCommandSent(uint32_t seq, int64_t ns) {
+    cmd_send_ns_[seq % kSendRing].store(ns, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] UdpCommandStats CommandStats() {
+    std::lock_guard<std::mutex> lock(cmd_mutex_);
+    return cmd_filter_.Stats();
+  }
+  [[nodiscard]] int ClientFd(unsigned i) const { return client_fds_[i]; }
+
+  /** Остановить и дождаться всех задач (до разрушения VehicleControl). */
+  void StopTasks() {
+    stop_.store(true);
+    telem_cv_.notify_all();
+    for (auto& t : tasks_) {
+      if (t.joinable()) t.join();
+    }
+    tasks_.clear();
+  }
+
+  // ── Метрики ──────────────────────────────────────────────────────────────
+
+  Samples loop_lateness;   ///< Опоздание пробуждения control task
+  Samples tick_cost;       ///< Тело тика: пробуждение → следующий Delay
+  Samples cmd_to_pwm;      ///< Отправка UDP-команды → SetPwm после неё
+  Samples cmd_gap;         ///< Интервал между принятыми UDP-командами
+  Samples telem_enqueue;   ///< SendTelem → отправка ws_telem
+  std::atomic<uint64_t> telem_enqueued{0};
+  std::atomic<uint64_t> telem_overwritten{0};  ///< Вытеснены в очереди
+  std::atomic<uint64_t> pwm_updates{0};
+
+  // ── Инициализация ────────────────────────────────────────────────────────
+
+  Result<Unit, PlatformError> InitPwm() override { return Unit{}; }
+  Result<Unit, PlatformError> InitRc() override {
+    return PlatformError::RcInitFailed;  // RC-приёмника на хосте нет
+  }
+  Result<Unit, PlatformError> InitImu() override { return Unit{}; }
+  Result<Unit, PlatformError> InitFailsafe() override {
+    tasks_.emplace_back([this] { UdpCtrlTask(); });
+    tasks_.emplace_back([this] { WsTelemTask(); });
+    return Unit{};
+  }
+
+  // ── Время ────────────────────────────────────────────────────────────────
+
+  uint32_t GetTimeMs() const noexcept override {
+    return static_cast<uint32_t>(GetTimeUs() / 1000);
+  }
+  uint64_t GetTimeUs() const noexcept override {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               Clock::now() - start_)
+        .count();
+  }
+
+  void Log(LogLevel level, std::string_view msg) const override {
+    if (level == LogLevel::Info) return;
+    std::fprintf(stderr, "[platform] %.*s\n", static_cast<int>(msg.size()),
+                 msg.data());
+  }
+
+  // ── IMU / NVS ────────────────────────────────────────────────────────────
+
+  std::optional<ImuData> ReadImu() override {
+    const uint64_t now = GetTimeUs();
+    const float dt = last_imu_us_ ? (now - last_imu_us_) * 1e-6f : 0.0f;
+    last_imu_us_ = now;
+    std::lock_guard<std::mutex> lock(pwm_mutex_);
+    return sim_.Step(dt);
+  }
+  int GetImuLastWhoAmI() const noexcept override { return 0x68; }
+
+  std::optional<ImuCalibData> LoadCalib() override { return std::nullopt; }
+  Result<Unit, PlatformError> SaveCalib(const ImuCalibData&) override {
+    return Unit{};
+  }
+  Result<Unit, PlatformError> SaveComOffset(const float[2]) override {
+    return Unit{};
+  }
+  bool LoadComOffset(float[2]) override { return false; }
+  std::optional<StabilizationConfig> LoadStabilizationConfig() override {
+    return std::nullopt;
+  }
+  Result<Unit, PlatformError> SaveStabilizationConfig(
+      const StabilizationConfig&) override {
+    return Unit{};
+  }
+
+  // ── RC / PWM / Failsafe ──────────────────────────────────────────────────
+
+  std::optional<RcCommand> GetRc() override { return std::nullopt; }
+
+  void SetPwm(float throttle, float steering) noexcept override {
+    const int64_t now = NowNs();
+    {
+      std::lock_guard<std::mutex> lock(pwm_mutex_);
+      sim_.SetPwm(throttle, steering);
+    }
+    pwm_updates.fetch_add(1, std::memory_order_relaxed);
+    // Первый выход на PWM после того, как control loop забрал команду
+    const int64_t sent = pending_cmd_send_ns_.exchange(0);
+    if (sent != 0) cmd_to_pwm.Add(now - sent);
+  }
+
+  void SetPwmNeutral() noexcept override { SetPwm(0.0f, 0.0f); }
+
+  bool FailsafeUpdate(bool rc_active, bool wifi_active) override {
+    return failsafe_.Update(GetTimeMs(), rc_active, wifi_active) ==
+           FailsafeState::Active;
+  }
+  bool FailsafeIsActive() const noexcept override {
+    return failsafe_.IsActive();
+  }
+
+  // ── WebSocket (ws_telem) ─────────────────────────────────────────────────
+
+  unsigned GetWebSocketClientCount() const noexcept override {
+    return ws_clients_;
+  }
+
+  void SendTelem(std::string_view json) override {
+    {
+      std::lock_guard<std::mutex> lock(telem_mutex_);
+      if (telem_full_) telem_overwritten.fetch_add(1);
+      telem_slot_.assign(json);
+      telem_slot_ns_ = NowNs();
+      telem_full_ = true;
+    }
+    telem_enqueued.fetch_add(1, std::memory_order_relaxed);
+    telem_cv_.notify_one();
+  }
+
+  // ── Wi-Fi команды (udp_ctrl) ─────────────────────────────────────────────
+
+  std::optional<RcCommand> TryReceiveWifiCommand(
+      WifiCommandSource source) override {
+    std::lock_guard<std::mutex> lock(cmd_mutex_);
+    auto& slot = cmd_[static_cast<size_t>(source)];
+    if (!slot.has_value()) return std::nullopt;
+    const BenchCommand c = *slot;
+    slot.reset();
+    if (c.send_ns != 0) pending_cmd_send_ns_.store(c.send_ns);
+    return RcCommand{c.throttle, c.steering};
+  }
+
+  void SendWifiCommand(float throttle, float steering,
+                       WifiCommandSource source) override {
+    std::lock_guard<std::mutex> lock(cmd_mutex_);
+    cmd_[static_cast<size_t>(source)] =
+        BenchCommand{0, throttle, steering, NowNs()};
+  }
+
+  // ── Задачи ───────────────────────────────────────────────────────────────
+
+  Result<Unit, PlatformError> CreateTask(void (*entry)(void*),
+                                         void* arg) override {
+    tasks_.emplace_back([entry, arg] {
+      try {
+        entry(arg);
+      } catch (const StopTask&) {
+      }
+    });
+    return Unit{};
+  }
+
+  void DelayUntilNextTick(uint32_t period_ms) override {
+    if (stop_.load()) throw StopTask{};
+    if (tick_start_ns_ != 0) tick_cost.Add(NowNs() - tick_start_ns_);
+    const auto now = Clock::now();
+    if (next_tick_ == Clock::time_point{}) next_tick_ = now;
+    next_tick_ += std::chrono::milliseconds(period_ms);
+    // Как vTaskDelayUntil: пропущенные дедлайны не копятся
+    if (next_tick_ < now) next_tick_ = now;
+    std::this_thread::sleep_until(next_tick_);
+    loop_lateness.Add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          Clock::now() - next_tick_)
+                          .count());
+    tick_start_ns_ = NowNs();
+  }
+
+ private:
+  void UdpCtrlTask() {
+    uint8_t buf[sizeof(UdpCommandPacket) + 1];
+    int64_t last_accept_ns = 0;
+    while (!stop_.load()) {
+      const ssize_t n = recv(cmd_fd_, buf, sizeof(buf), 0);
+      if (n < 0) continue;
+      const int64_t now = NowNs();
+      std::lock_guard<std::mutex> lock(cmd_mutex_);
+      UdpCommandPacket pkt;
+      if (cmd_filter_.Accept(buf, static_cast<size_t>(n), GetTimeMs(), pkt) !=
+          UdpCommandVerdict::Accepted) {
+        continue;
+      }
+      if (last_accept_ns != 0) cmd_gap.Add(now - last_accept_ns);
+      last_accept_ns = now;
+      cmd_[static_cast<size_t>(WifiCommandSource::Udp)] = BenchCommand{
+          pkt.seq, pkt.throttle, pkt.steering,
+          cmd_send_ns_[pkt.seq % kSendRing].load(std::memory_order_relaxed)};
+    }
+  }
+
+  void WsTelemTask() {
+    std::string msg;
+    while (true) {
+      int64_t enq_ns = 0;
+      {
+        std::unique_lock<std::mutex> lock(telem_mutex_);
+        telem_cv_.wait(lock, [this] { return telem_full_ || stop_.load(); });
+        if (stop_.load()) return;
+        // Кадр: [int64 время SendTelem][JSON] — клиенты считают задержку
+        msg.assign(reinterpret_cast<const char*>(&telem_slot_ns_),
+                   sizeof(telem_slot_ns_));
+        msg += telem_slot_;
+        enq_ns = telem_slot_ns_;
+        telem_full_ = false;
+      }
+      telem_enqueue.Add(NowNs() - enq_ns);
+      for (uint16_t port : client_ports_) {
+        const sockaddr_in addr = LoopbackAddr(port);
+        sendto(telem_fd_, msg.data(), msg.size(), 0,
+               reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+      }
+    }
+  }
+
+  Clock::time_point start_;
+  Clock::time_point next_tick_{};
+  int64_t tick_start_ns_{0};  ///< Только control task
+  std::atomic<bool> stop_{false};
+  std::vector<std::thread> tasks_;
+
+  uint64_t last_imu_us_{0};
+  std::mutex pwm_mutex_;
+  SimVehicle sim_;
+  Failsafe failsafe_;
+
+  static constexpr uint32_t kCommandToken = 0x5EEDC0DEu;
+  static constexpr size_t kSendRing = 1024;
+
+  int cmd_fd_{-1};
+  uint16_t cmd_port_{0};
+  std::mutex cmd_mutex_;
+  UdpCommandFilter cmd_filter_{kCommandToken};
+  std::optional<BenchCommand> cmd_[kWifiCommandSourceCount];
+  std::atomic<int64_t> cmd_send_ns_[kSendRing]{};
+  std::atomic<int64_t> pending_cmd_send_ns_{0};
+
+  unsigned ws_clients_;
+  int telem_fd_{-1};
+  std::vector<int> client_fds_;
+  std::vector<uint16_t> client_ports_;
+  std::mutex telem_mutex_;
+  std::condition_variable telem_cv_;
+  std::string telem_slot_;
+  int64_t telem_slot_ns_{0};
+  bool telem_full_{false};
+};
+
+}  // namespace bench
+}  // namespace rc_vehicle
@@ -14,7 +14,7 @@ using namespace rc_vehicle::testing;
 
 struct StopLoopException : std::exception {};
 
-class SimPlatform : public FakePlatform {
+class SimPlatform final : public FakePlatform {
  public:
   explicit SimPlatform(uint32_t max_iterations)
       : max_iterations_(max_iterations) {}
@@ -104,8 +104,10 @@ class MockPlatform : public VehicleControlPlatform {
   // Wi-Fi команды
   // ─────────────────────────────────────────────────────────────────────────
 
-  MOCK_METHOD(std::optional<RcCommand>, TryReceiveWifiCommand, (), (override));
-  MOCK_METHOD(void, SendWifiCommand, (float throttle, float steering),
+  MOCK_METHOD(std::optional<RcCommand>, TryReceiveWifiCommand,
+              (WifiCommandSource source), (override));
+  MOCK_METHOD(void, SendWifiCommand,
+              (float throttle, float steering, WifiCommandSource source),
               (override));
 
   // ─────────────────────────────────────────────────────────────────────────
@@ -282,16 +284,24 @@ class FakePlatform : public VehicleControlPlatform {
   // Wi-Fi команды
   // ─────────────────────────────────────────────────────────────────────────
 
-  std::optional<RcCommand> TryReceiveWifiCommand() override {
-    return wifi_command_;
+  std::optional<RcCommand> TryReceiveWifiCommand(
+      WifiCommandSource source) override {
+    return wifi_commands_[static_cast<size_t>(source)];
   }
 
-  void SendWifiCommand(float throttle, float steering) override {
-    wifi_command_ = RcCommand{throttle, steering};
+  void SendWifiCommand(float throttle, float steering,
+                       WifiCommandSource source) override {
+    wifi_commands_[static_cast<size_t>(source)] = RcCommand{throttle, steering};
   }
 
-  void SetWifiCommand(const RcCommand& cmd) { wifi_command_ = cmd; }
-  void ClearWifiCommand() { wifi_command_ = std::nullopt; }
+  void SetWifiCommand(const RcCommand& cmd,
+                      WifiCommandSource source = WifiCommandSource::WebSocket) {
+    wifi_commands_[static_cast<size_t>(source)] = cmd;
+  }
+  void ClearWifiCommand(
+      WifiCommandSource source = WifiCommandSource::WebSocket) {
+    wifi_commands_[static_cast<size_t>(source)] = std::nullopt;
+  }
 
   // ─────────────────────────────────────────────────────────────────────────
   // Задачи и синхронизация
@@ -337,7 +347,7 @@ class FakePlatform : public VehicleControlPlatform {
   int telem_send_count_{0};
 
   // Wi-Fi
-  std::optional<RcCommand> wifi_command_;
+  std::optional<RcCommand> wifi_commands_[kWifiCommandSourceCount];
 };
 
 }  // namespace testing
@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "allan_variance.hpp"
+#include "config.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+constexpr double kTau0 = config::ControlLoopConfig::kPeriodMs * 0.001;
+
+/// Белый шум σ на отсчёт + случайное блуждание скорости K [ед/√с]
+std::vector<float> NoiseSeries(size_t n, double sigma, double rrw,
+                               float offset = 0.0f, uint32_t seed = 1) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> normal(0.0, 1.0);
+  std::vector<float> y(n);
+  double walk = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    walk += rrw * std::sqrt(kTau0) * normal(rng);
+    y[i] = offset + static_cast<float>(sigma * normal(rng) + walk);
+  }
+  return y;
+}
+
+/// Прямое определение: средние соседних перекрывающихся кластеров
+double NaiveOverlappingAvar(const std::vector<float>& y, size_t m) {
+  double sum = 0.0;
+  size_t terms = 0;
+  for (size_t k = 0; k + 2 * m <= y.size(); ++k) {
+    double a = 0.0, b = 0.0;
+    for (size_t i = 0; i < m; ++i) {
+      a += y[k + i];
+      b += y[k + m + i];
+    }
+    const double d = (b - a) / static_cast<double>(m);
+    sum += d * d;
+    ++terms;
+  }
+  return sum / (2.0 * static_cast<double>(terms));
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Пакетный расчёт
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(AllanVarianceTest, ClusterSizesLogSpacedUniqueBounded) {
+  const auto m = AllanClusterSizes(1001, 10);
+  ASSERT_FALSE(m.empty());
+  EXPECT_EQ(m.front(), 1u);
+  EXPECT_LE(m.back(), 500u);
+  for (size_t i = 1; i < m.size(); ++i) EXPECT_GT(m[i], m[i - 1]);
+  // 10 точек на декаду: 1…500 — около 27 уникальных
+  EXPECT_GT(m.size(), 20u);
+  EXPECT_TRUE(AllanClusterSizes(2, 10).empty());
+}
+
+TEST(AllanVarianceTest, MatchesNaiveDefinitionAndIgnoresOffset) {
+  const auto y = NoiseSeries(600, 0.3, 0.0, 0.0f, 7);
+  auto shifted = y;
+  for (float& v : shifted) v += 250.0f;  // Смещение нуля гироскопа
+
+  std::vector<double> theta, theta_shifted;
+  AllanPhase(y, theta);
+  AllanPhase(shifted, theta_shifted);
+  for (size_t m : {1u, 2u, 5u, 17u, 299u}) {
+    const AllanPoint p = AllanPointFromSum(OverlappingAllanSum(theta, m), m, 1);
+    const AllanPoint q =
+        AllanPointFromSum(OverlappingAllanSum(theta_shifted, m), m, 1);
+    EXPECT_NEAR(p.adev * p.adev, NaiveOverlappingAvar(y, m), 1e-9) << m;
+    EXPECT_NEAR(p.adev, q.adev, 1e-4) << m;
+    EXPECT_EQ(p.terms, 600 - 2 * m + 1);
+  }
+  EXPECT_EQ(OverlappingAllanSum(theta, 301).terms, 0u);
+}
+
+TEST(AllanVarianceTest, WhiteNoiseGivesArw) {
+  const double sigma = 0.05;  // dps на отсчёт
+  const auto y = NoiseSeries(200000, sigma, 0.0);
+  const auto curve = OverlappingAdev(y, kTau0, 10);
+  // σ(τ) = σ·√(τ0/τ); разброс точки растёт как √(m/N)
+  for (const AllanPoint& p : curve) {
+    if (p.tau_s > 2.0) break;
+    const double expected = sigma * std::sqrt(kTau0 / p.tau_s);
+    const double tol = 0.03 + 1.5 * std::sqrt(p.tau_s / kTau0 / y.size());
+    EXPECT_NEAR(p.adev, expected, tol * expected) << p.tau_s;
+  }
+  const AllanNoiseFit fit = FitAllanNoise(curve);
+  ASSERT_TRUE(fit.valid);
+  EXPECT_TRUE(fit.arw_from_slope);
+  EXPECT_NEAR(fit.arw, sigma * std::sqrt(kTau0),
+              0.05 * sigma * std::sqrt(kTau0));
+  EXPECT_NEAR(AllanWhiteSigma(fit, kTau0), sigma, 0.05 * sigma);
+  EXPECT_TRUE(fit.bias_at_end);  // Чистый белый шум: минимума нет
+}
+
+TEST(AllanVarianceTest, WhitePlusRateRandomWalk) {
+  const double sigma = 0.05;
+  const double rrw = 0.002;  // dps/√с
+  const auto y = NoiseSeries(400000, sigma, rrw, 0.0f, 3);
+  const auto curve = OverlappingAdev(y, kTau0, 10);
+  const AllanNoiseFit fit = FitAllanNoise(curve);
+  ASSERT_TRUE(fit.valid);
+  EXPECT_FALSE(fit.bias_at_end);
+  EXPECT_NEAR(fit.arw, sigma * std::sqrt(kTau0),
+              0.1 * sigma * std::sqrt(kTau0));
+  ASSERT_TRUE(fit.has_rrw);
+  EXPECT_NEAR(fit.rrw, rrw, 0.35 * rrw);  // Мало кластеров на длинных τ
+  // Минимум между режимами: B ≈ σ_min / 0.664, τ_min — в середине
+  EXPECT_GT(fit.tau_bias_s, 0.1);
+  EXPECT_GT(fit.bias_instability, 0.0);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Инкрементальный расчёт
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(AllanAccumulatorTest, OctavesAgreeWithBatch) {
+  const double sigma = 0.05;
+  const auto y = NoiseSeries(1 << 17, sigma, 0.0, 1.5f, 11);
+  AllanAccumulator acc;
+  for (float v : y) acc.Add(v);
+  EXPECT_EQ(acc.Samples(), y.size());
+
+  std::array<AllanPoint, AllanAccumulator::kLevels> curve{};
+  const size_t n = acc.Curve(kTau0, 64, curve);
+  ASSERT_GE(n, 8u);
+  for (size_t i = 0; i < n; ++i) {
+    const double expected = sigma * std::sqrt(kTau0 / curve[i].tau_s);
+    // Неперекрывающаяся оценка: допуск шире на малом числе разностей
+    const double tol = 3.0 / std::sqrt(static_cast<double>(curve[i].terms));
+    EXPECT_NEAR(curve[i].adev, expected, (0.03 + tol) * expected)
+        << curve[i].tau_s;
+  }
+  EXPECT_DOUBLE_EQ(curve[0].tau_s, kTau0);
+  EXPECT_DOUBLE_EQ(curve[3].tau_s, 8 * kTau0);
+}
+
+TEST(AllanAccumulatorTest, BreakDropsPartialClustersKeepsEstimates) {
+  AllanAccumulator acc;
+  for (int i = 0; i < 16; ++i) acc.Add(i % 2 ? 1.0f : -1.0f);
+  const uint32_t terms0 = acc.Terms(0);
+  EXPECT_EQ(terms0, 15u);
+  EXPECT_FLOAT_EQ(acc.Avar(0), 2.0f);  // ½·(±2)²
+
+  acc.Break();
+  acc.Add(100.0f);  // Первый после разрыва — без разности с прошлым
+  EXPECT_EQ(acc.Terms(0), terms0);
+  acc.Add(100.0f);
+  EXPECT_EQ(acc.Terms(0), terms0 + 1);
+
+  acc.Reset();
+  EXPECT_EQ(acc.Samples(), 0u);
+  EXPECT_EQ(acc.Terms(0), 0u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Монитор на стоянке и рекомендации
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(AllanNoiseMonitorTest, FeedsOnlyWhenParkedAfterSettle) {
+  using Cfg = config::AllanConfig;
+  AllanNoiseMonitor mon(kTau0);
+  const double sigma = 0.1;  // dps
+  const auto noise = NoiseSeries(70000, sigma, 0.0, 0.0f, 5);
+  const uint32_t step_ms = config::ControlLoopConfig::kPeriodMs;
+
+  uint32_t now = 0;
+  AllanSample s;
+  // Едем: ничего не копится
+  for (int i = 0; i < 1000; ++i, now += step_ms) {
+    s.parked = false;
+    mon.Update(s, now);
+  }
+  // Стоим: первые kSettleMs — успокоение
+  for (size_t i = 0; i < noise.size(); ++i, now += step_ms) {
+    s.parked = true;
+    for (int a = 0; a < 3; ++a) {
+      s.gyro_dps[a] = noise[(i + 1000 * a) % noise.size()] + 0.7f * a;
+      s.accel_g[a] = 0.001f * noise[(i + 777 * a) % noise.size()];
+    }
+    s.accel_g[2] += 1.0f;
+    mon.Update(s, now);
+  }
+
+  AllanReport r;
+  mon.GetReport(r);
+  EXPECT_TRUE(r.parked_now);
+  const double fed_s =
+      static_cast<double>(noise.size()) * kTau0 - Cfg::kSettleMs * 0.001;
+  EXPECT_NEAR(r.parked_s, fed_s, 1.5);  // Публикация раз в секунду
+  ASSERT_GE(r.points[2], 3u);
+  ASSERT_TRUE(r.fits[2].valid);
+  ASSERT_TRUE(r.tuning.gyro_valid);
+
+  // r_gz = (σ на шаге EKF)², σ на отсчёт с тем же шагом = sigma
+  const double sigma_rad = sigma * 3.14159265358979 / 180.0;
+  EXPECT_NEAR(r.tuning.r_gz, sigma_rad * sigma_rad,
+              0.2 * sigma_rad * sigma_rad);
+  EXPECT_GT(r.tuning.madgwick_beta, 0.0f);
+  EXPECT_TRUE(r.tuning.accel_valid);
+  EXPECT_FALSE(r.tuning.heading_valid);  // Магнитометр — только на хосте
+
+  // Поехали — накопленное остаётся; сброс по запросу
+  s.parked = false;
+  mon.Update(s, now += 1000);
+  mon.GetReport(r);
+  EXPECT_FALSE(r.parked_now);
+  EXPECT_GE(r.points[2], 3u);
+  mon.RequestReset();
+  mon.Update(s, now += 1000);
+  mon.GetReport(r);
+  EXPECT_EQ(r.points[2], 0u);
+}
+
+TEST(AllanNoiseTuningTest, HeadingNoiseFromMagnetometer) {
+  ImuNoiseFits fits;
+  for (auto& f : fits.mag_xy_mg) {
+    f.valid = true;
+    f.arw = 2.0 * std::sqrt(0.01);  // σ = 2 mG на отсчёт 10 мс
+  }
+  fits.mag_horizontal_mg = 200.0;
+  const NoiseTuning t = SuggestNoiseTuning(fits, kTau0, 0.01);
+  ASSERT_TRUE(t.heading_valid);
+  EXPECT_NEAR(t.r_heading, (2.0 / 200.0) * (2.0 / 200.0), 1e-7);
+  EXPECT_FALSE(t.gyro_valid);
+  EXPECT_FALSE(t.accel_valid);
+}
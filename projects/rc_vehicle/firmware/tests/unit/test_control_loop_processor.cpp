@@ -167,6 +167,31 @@ TEST_F(ProcessorTest, WifiCommand_WithTrim_OffsetApplied) {
   EXPECT_NEAR(platform_.GetLastSteering(), 0.2f + 0.05f, 1e-4f);
 }
 
+TEST_F(ProcessorTest, Shadow_RunsCandidateWithoutTouchingPwm) {
+  ImuHandler imu(platform_, imu_calib_, madgwick_);
+  ShadowStabilizer shadow;
+  shadow.Init(ekf_, madgwick_, &imu);
+  ControlLoopContext ctx = *ctx_;
+  ctx.shadow = &shadow;
+  ControlLoopProcessor proc(ctx, 0);
+
+  SetDirectLaw();
+  auto candidate = stab_mgr_->GetConfig();
+  candidate.mode = DriveMode::Sport;
+  ASSERT_TRUE(shadow.SetCandidate(candidate));
+
+  platform_.SetWifiCommand({0.6f, -0.3f});
+  proc.Step(2, 2);
+  proc.Step(4, 2);
+  EXPECT_NEAR(platform_.GetLastThrottle(), 0.6f, 1e-4f);
+  EXPECT_NEAR(platform_.GetLastSteering(), -0.3f, 1e-4f);
+
+  const ShadowStats st = shadow.GetStats();
+  EXPECT_EQ(st.state, ShadowState::Running);
+  EXPECT_EQ(st.run_ticks, 2u);
+  EXPECT_FLOAT_EQ(shadow.GetThrottle(), 0.6f);
+}
+
 TEST_F(ProcessorTest, NoCommand_NeutralPwm_AfterFailsafe) {
   SetDirectLaw();
   Step();  // нет источника управления → failsafe → neutral
@@ -286,3 +311,91 @@ TEST_F(ProcessorTest, CalibMgr_Null_NoCrash) {
   ControlLoopProcessor proc(ctx, 0);
   EXPECT_NO_THROW(proc.Step(2, 2));
 }
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Статическая диспетчеризация платформы
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+class FinalFakePlatform final : public FakePlatform {};
+
+static_assert(ControlTickPlatform<VehicleControlPlatform>);
+static_assert(ControlTickPlatform<FinalFakePlatform>);
+// Не final: наследник может переопределить методы → только через базу
+static_assert(!ControlTickPlatform<FakePlatform>);
+
+/** Полный набор компонентов тика поверх платформы типа P. */
+template <ControlTickPlatform P, typename Concrete>
+struct TickStack {
+  TickStack()
+      : stab_mgr(platform, madgwick, yaw_ctrl, slip_ctrl, nullptr),
+        wifi(platform, /*timeout_ms=*/500),
+        ctx{platform,        imu_calib,   madgwick,  ekf,
+            yaw_ctrl,        pitch_ctrl,  slip_ctrl, oversteer_guard,
+            kids_processor,  auto_drive,  nullptr,   &stab_mgr,
+            nullptr,         nullptr,     &wifi,     nullptr,
+            nullptr,         last_loop_hz},
+        proc(static_cast<P&>(platform), ctx, 0) {
+    auto cfg = stab_mgr.GetConfig();
+    cfg.mode = DriveMode::DirectLaw;
+    stab_mgr.SetConfig(cfg);
+  }
+
+  Concrete platform;
+  ImuCalibration imu_calib;
+  MadgwickFilter madgwick;
+  VehicleEkf ekf;
+  YawRateController yaw_ctrl;
+  PitchCompensator pitch_ctrl;
+  SlipAngleController slip_ctrl;
+  OversteerGuard oversteer_guard;
+  KidsModeProcessor kids_processor;
+  AutoDriveCoordinator auto_drive;
+  std::atomic<uint32_t> last_loop_hz{0};
+  StabilizationManager stab_mgr;
+  WifiCommandHandler wifi;
+  ControlLoopContext ctx;
+  ControlLoopProcessorT<P> proc;
+};
+
+}  // namespace
+
+TEST(ControlLoopStaticTest, ConcretePlatformMatchesTypeErased) {
+  TickStack<VehicleControlPlatform, FakePlatform> erased;
+  TickStack<FinalFakePlatform, FinalFakePlatform> direct;
+
+  uint32_t t = 0;
+  for (int i = 0; i < 1000; ++i) {
+    t += 2;
+    // Команда меняется, потом пропадает → таймаут Wi-Fi и failsafe
+    if (i < 250) {
+      const float v = 0.002f * static_cast<float>(i);
+      erased.platform.SetWifiCommand({v, -v});
+      direct.platform.SetWifiCommand({v, -v});
+    } else {
+      erased.platform.ClearWifiCommand();
+      direct.platform.ClearWifiCommand();
+    }
+    erased.proc.Step(t, 2);
+    direct.proc.Step(t, 2);
+    ASSERT_EQ(direct.platform.GetLastThrottle(),
+              erased.platform.GetLastThrottle())
+        << "i=" << i;
+    ASSERT_EQ(direct.platform.GetLastSteering(),
+              erased.platform.GetLastSteering())
+        << "i=" << i;
+  }
+  EXPECT_EQ(direct.platform.GetPwmSetCount(),
+            erased.platform.GetPwmSetCount());
+  EXPECT_FLOAT_EQ(direct.platform.GetLastThrottle(), 0.0f);
+}
+
+TEST_F(ProcessorTest, TickCyclesCounted) {
+  // DIAG сбрасывает статистику при каждом выводе — счёт не больше шагов
+  RunSteps(10);
+  const CycleStats& stats = processor_->GetTickCycles();
+  EXPECT_GT(stats.count, 0u);
+  EXPECT_LE(stats.count, 10u);
+  EXPECT_GE(stats.max, stats.last);
+}
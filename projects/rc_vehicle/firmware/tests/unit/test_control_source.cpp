@@ -173,6 +173,43 @@ TEST_F(WifiCommandHandlerTest, RefreshesTimeout_OnNewCommand) {
   EXPECT_FALSE(handler_->IsActive());
 }
 
+TEST_F(WifiCommandHandlerTest, UdpWinsWhileFresh_WebSocketFallback) {
+  platform_.SetWifiCommand(RcCommand{0.1f, 0.0f}, WifiCommandSource::WebSocket);
+  platform_.SetWifiCommand(RcCommand{0.7f, 0.2f}, WifiCommandSource::Udp);
+  handler_->Update(100, 2);
+  EXPECT_EQ(handler_->GetActiveSource(), WifiCommandSource::Udp);
+  EXPECT_TRUE(handler_->IsSourceActive(WifiCommandSource::WebSocket));
+  EXPECT_FLOAT_EQ(handler_->GetCommand()->throttle, 0.7f);
+
+  // UDP замолчал, WebSocket продолжает — после таймаута UDP берётся WS
+  platform_.ClearWifiCommand(WifiCommandSource::Udp);
+  handler_->Update(400, 2);
+  EXPECT_EQ(handler_->GetActiveSource(), WifiCommandSource::Udp);
+  handler_->Update(601, 2);
+  EXPECT_FALSE(handler_->IsSourceActive(WifiCommandSource::Udp));
+  EXPECT_EQ(handler_->GetActiveSource(), WifiCommandSource::WebSocket);
+  EXPECT_FLOAT_EQ(handler_->GetCommand()->throttle, 0.1f);
+}
+
+TEST_F(WifiCommandHandlerTest, SourcesExpireIndependently) {
+  platform_.SetWifiCommand(RcCommand{0.4f, 0.0f}, WifiCommandSource::Udp);
+  handler_->Update(100, 2);
+  platform_.ClearWifiCommand(WifiCommandSource::Udp);
+  EXPECT_FALSE(handler_->IsSourceActive(WifiCommandSource::WebSocket));
+
+  platform_.SetWifiCommand(RcCommand{0.2f, 0.0f}, WifiCommandSource::WebSocket);
+  handler_->Update(550, 2);
+  platform_.ClearWifiCommand(WifiCommandSource::WebSocket);
+  EXPECT_EQ(handler_->GetActiveSource(), WifiCommandSource::Udp);
+
+  // UDP истёк в 600, WebSocket — в 1050
+  handler_->Update(700, 2);
+  EXPECT_EQ(handler_->GetActiveSource(), WifiCommandSource::WebSocket);
+  handler_->Update(1051, 2);
+  EXPECT_FALSE(handler_->IsActive());
+  EXPECT_FALSE(handler_->GetCommand().has_value());
+}
+
 // ══════════════════════════════════════════════════════════════════════════════
 // Control Source Priority: RC > WiFi
 // ══════════════════════════════════════════════════════════════════════════════
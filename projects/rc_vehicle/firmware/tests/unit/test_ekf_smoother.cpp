@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "ekf_smoother.hpp"
+#include "telemetry_log.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+constexpr float kDt = 0.002f;
+
+/** Манёвр: синусоидальная скорость рыскания, шумный гироскоп, без ZUPT. */
+std::vector<EkfStepInput> MakeSlalom(size_t n, float sigma_dps,
+                                     std::vector<float>& truth_r) {
+  std::mt19937 rng(42);
+  std::normal_distribution<float> noise(0.0f, sigma_dps);
+  std::vector<EkfStepInput> steps(n);
+  truth_r.resize(n);
+  for (size_t k = 0; k < n; ++k) {
+    const float t = static_cast<float>(k) * kDt;
+    truth_r[k] = std::sin(2.0f * std::numbers::pi_v<float> * 0.2f * t);
+    EkfStepInput& in = steps[k];
+    in.ax_g = 0.1f;
+    in.ay_g = 0.2f;
+    in.gz_dps = truth_r[k] * 180.0f / std::numbers::pi_v<float> + noise(rng);
+    in.dt_sec = kDt;
+    in.throttle_abs = 0.5f;
+  }
+  return steps;
+}
+
+VehicleEkfNoiseParams SlalomParams() {
+  VehicleEkfNoiseParams p;
+  p.q_r = 1e-5f;
+  p.r_gz = 0.0025f;  // σ = 0.05 рад/с ≈ 2.9 dps
+  return p;
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Прямой и обратный проход
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(EkfSmootherTest, ForwardPassMatchesOnlineEkf) {
+  std::vector<float> truth;
+  auto steps = MakeSlalom(500, 3.0f, truth);
+  for (size_t k = 0; k < steps.size(); k += 7) {
+    steps[k].has_heading = true;
+    steps[k].heading_rad = 0.01f * static_cast<float>(k);
+  }
+
+  VehicleEkf ekf(SlalomParams());
+  VehicleEkfSmoother smoother(SlalomParams());
+  for (size_t k = 0; k < steps.size(); ++k) {
+    const EkfStepInput& in = steps[k];
+    ekf.UpdateFromImu(in.ax_g, in.ay_g, in.az_g, in.gz_dps, in.dt_sec,
+                      in.throttle_abs);
+    if (in.has_heading) ekf.UpdateHeading(in.heading_rad);
+    smoother.Step(in);
+
+    const EkfStateEstimate f = smoother.Filtered(k);
+    ASSERT_EQ(f.x[0], ekf.GetVx());
+    ASSERT_EQ(f.x[1], ekf.GetVy());
+    ASSERT_EQ(f.x[2], ekf.GetYawRate());
+    ASSERT_EQ(f.x[3], ekf.GetYawRad());
+    ASSERT_EQ(f.var[0], ekf.GetVxVariance());
+  }
+}
+
+TEST(EkfSmootherTest, LastSampleEqualsFiltered) {
+  std::vector<float> truth;
+  const auto steps = MakeSlalom(200, 3.0f, truth);
+  VehicleEkfSmoother smoother(SlalomParams());
+  for (const auto& in : steps) smoother.Step(in);
+  smoother.Smooth();
+
+  const size_t last = smoother.Size() - 1;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(smoother.Smoothed(last).x[i], smoother.Filtered(last).x[i]);
+    EXPECT_EQ(smoother.Smoothed(last).var[i], smoother.Filtered(last).var[i]);
+  }
+}
+
+TEST(EkfSmootherTest, SmoothingReducesYawRateErrorAndVariance) {
+  std::vector<float> truth;
+  const auto steps = MakeSlalom(5000, 3.0f, truth);
+  VehicleEkfSmoother smoother(SlalomParams());
+  smoother.Reserve(steps.size());
+  for (const auto& in : steps) smoother.Step(in);
+  smoother.Smooth();
+
+  // Без переходного процесса в начале
+  double se_f = 0.0, se_s = 0.0;
+  for (size_t k = 500; k < steps.size(); ++k) {
+    const double ef = smoother.Filtered(k).x[2] - truth[k];
+    const double es = smoother.Smoothed(k).x[2] - truth[k];
+    se_f += ef * ef;
+    se_s += es * es;
+    ASSERT_LE(smoother.Smoothed(k).var[2],
+              smoother.Filtered(k).var[2] * 1.0001f);
+  }
+  EXPECT_LT(std::sqrt(se_s), 0.7 * std::sqrt(se_f));
+}
+
+TEST(EkfSmootherTest, YawWrapsAcrossPi) {
+  VehicleEkfNoiseParams p;
+  p.r_heading = 1e-4f;
+  VehicleEkfSmoother smoother(p);
+  // Курс медленно проходит через +π → −π
+  for (int k = 0; k < 400; ++k) {
+    EkfStepInput in;
+    in.dt_sec = kDt;
+    in.gz_dps = 0.0f;
+    in.throttle_abs = 0.5f;
+    in.has_heading = true;
+    in.heading_rad = VehicleEkf::WrapAngle(3.0f + 0.001f * k);
+    smoother.Step(in);
+  }
+  smoother.Smooth();
+  for (size_t k = 100; k < smoother.Size(); ++k) {
+    const float expected = VehicleEkf::WrapAngle(3.0f + 0.001f * k);
+    const float err =
+        VehicleEkf::WrapAngle(smoother.Smoothed(k).x[3] - expected);
+    ASSERT_NEAR(err, 0.0f, 0.02f) << "k=" << k;
+    ASSERT_LE(std::abs(smoother.Smoothed(k).x[3]), std::numbers::pi_v<float>);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Лог
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+std::vector<TelemetryLogFrame> MakeLogFrames(size_t n) {
+  std::vector<TelemetryLogFrame> frames(n);
+  for (size_t i = 0; i < n; ++i) {
+    auto& f = frames[i];
+    // Разрыв 1 с после кадра 99 — два участка
+    f.ts_ms = static_cast<uint32_t>(i * 10 + (i >= 100 ? 1000 : 0));
+    f.ax = 0.2f;
+    f.az = 1.0f;
+    f.yaw_rate_dps = 10.0f;
+    f.cmd_throttle = 0.3f;
+    f.throttle = 0.25f;
+    f.vx = -99.0f;  // Онлайн-оценка, будет перезаписана
+    f.rc_throttle = 0.4f;
+  }
+  return frames;
+}
+
+}  // namespace
+
+TEST(EkfSmootherTest, SmoothLogRewritesOnlyEkfChannels) {
+  const auto src = MakeLogFrames(150);
+  LogBinView view;
+  view.frames = reinterpret_cast<const uint8_t*>(src.data());
+  view.frame_count = static_cast<uint32_t>(src.size());
+  view.frame_size = sizeof(TelemetryLogFrame);
+
+  std::vector<TelemetryLogFrame> out = src;
+  const LogSmoothStats stats = SmoothLogEkf(
+      view, {}, reinterpret_cast<uint8_t*>(out.data()));
+  EXPECT_EQ(stats.segments, 2u);
+  // 10 мс кадра = 5 подшагов control loop; разрыв — без шагов
+  EXPECT_EQ(stats.steps, 150u * 5u);
+
+  for (size_t i = 0; i < out.size(); ++i) {
+    EXPECT_EQ(out[i].ts_ms, src[i].ts_ms);
+    EXPECT_EQ(out[i].throttle, src[i].throttle);
+    EXPECT_EQ(out[i].rc_throttle, src[i].rc_throttle);
+    EXPECT_NE(out[i].vx, -99.0f);
+    EXPECT_GT(out[i].ekf_vx_var, 0.0f);
+  }
+  // Разгон 0.2g с начала каждого участка: скорость растёт
+  EXPECT_GT(out[99].vx, out[10].vx);
+  EXPECT_GT(out[99].vx, 1.0f);
+  EXPECT_LT(out[100].vx, out[99].vx);
+  EXPECT_NEAR(out[99].speed_ms,
+              std::hypot(out[99].vx, out[99].vy), 1e-4f);
+}
+
+TEST(EkfSmootherTest, SmoothLogKeepsFieldsBeyondTruncatedFrame) {
+  // Кадр старой прошивки: поля EKF-дисперсий за пределами frame_size
+  constexpr uint32_t kSize = offsetof(TelemetryLogFrame, ekf_vx_var);
+  const auto frames = MakeLogFrames(20);
+  std::vector<uint8_t> src;
+  for (const auto& f : frames) {
+    const auto* p = reinterpret_cast<const uint8_t*>(&f);
+    src.insert(src.end(), p, p + kSize);
+  }
+  LogBinView view;
+  view.frames = src.data();
+  view.frame_count = static_cast<uint32_t>(frames.size());
+  view.frame_size = kSize;
+
+  std::vector<uint8_t> out = src;
+  out.resize(src.size() + 8, 0xAB);
+  SmoothLogEkf(view, {}, out.data());
+  // Запись не выходит за кадр: ts_ms следующих кадров и хвост буфера целы
+  for (size_t i = 0; i < frames.size(); ++i) {
+    uint32_t ts = 0;
+    std::memcpy(&ts, out.data() + i * kSize, sizeof(ts));
+    EXPECT_EQ(ts, frames[i].ts_ms);
+  }
+  EXPECT_EQ(out[src.size()], 0xAB);
+  float vx = 0.0f;
+  std::memcpy(&vx, out.data() + kSize + offsetof(TelemetryLogFrame, vx),
+              sizeof(vx));
+  EXPECT_NE(vx, -99.0f);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "explicit_mpc.hpp"
+#include "yaw_mpc_table.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+ExplicitMpcPartition BinPartition(int bin) {
+  return {yaw_mpc::kNodes[bin], yaw_mpc::kNodesPerBin, yaw_mpc::kRegions[bin],
+          yaw_mpc::kRegionsPerBin};
+}
+
+/// Прямое решение скалярной QP: u = p + clamp(K·x, lo, hi).
+/// K восстанавливается из закона внутренней области (f = K + e_p).
+float DirectSolution(int bin, const float (&x)[kExplicitMpcParamDim]) {
+  const auto& interior = yaw_mpc::kRegions[bin][0];
+  float s = 0.0f;
+  for (int i = 0; i < kExplicitMpcParamDim; ++i) {
+    const float k = interior.f[i] - (i == 3 ? 1.0f : 0.0f);
+    s += k * x[i];
+  }
+  const float p = x[3];
+  const float d = x[4];
+  const float lo = std::max(-d, -1.0f - p);
+  const float hi = std::min(d, 1.0f - p);
+  return p + std::clamp(s, lo, hi);
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Generated table
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(ExplicitMpcTest, SpeedGridIsAscendingAndPositive) {
+  EXPECT_GT(yaw_mpc::kSpeedGridMs[0], 0.0f);
+  for (int i = 1; i < yaw_mpc::kSpeedBinCount; ++i) {
+    EXPECT_GT(yaw_mpc::kSpeedGridMs[i], yaw_mpc::kSpeedGridMs[i - 1]);
+  }
+}
+
+TEST(ExplicitMpcTest, TreeMatchesDirectQpSolution) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> vy(-2.0f, 2.0f);
+  std::uniform_real_distribution<float> rate(-8.0f, 8.0f);
+  std::uniform_real_distribution<float> u_prev(-1.0f, 1.0f);
+  std::uniform_real_distribution<float> du_max(0.0f, 0.05f);
+
+  for (int bin = 0; bin < yaw_mpc::kSpeedBinCount; ++bin) {
+    const auto part = BinPartition(bin);
+    for (int i = 0; i < 2000; ++i) {
+      const float x[kExplicitMpcParamDim] = {vy(rng), rate(rng), rate(rng),
+                                             u_prev(rng), du_max(rng)};
+      float u = 0.0f;
+      ASSERT_TRUE(ExplicitMpcEvaluate(part, x, u));
+      EXPECT_NEAR(u, DirectSolution(bin, x), 1e-4f) << "bin " << bin;
+    }
+  }
+}
+
+TEST(ExplicitMpcTest, OutputRespectsRateAndRangeLimits) {
+  const auto part = BinPartition(3);
+  // Огромная ошибка по yaw rate → упор в ограничение скорости руля
+  const float x_rate[kExplicitMpcParamDim] = {0.0f, 0.0f, 6.0f, 0.2f, 0.01f};
+  float u = 0.0f;
+  ASSERT_TRUE(ExplicitMpcEvaluate(part, x_rate, u));
+  EXPECT_NEAR(u, 0.21f, 1e-6f);
+  EXPECT_EQ(ExplicitMpcLocate(part, x_rate), 1);  // rate_hi
+
+  // Руль у упора → ограничение диапазона
+  const float x_range[kExplicitMpcParamDim] = {0.0f, 0.0f, 6.0f, 0.995f, 0.01f};
+  ASSERT_TRUE(ExplicitMpcEvaluate(part, x_range, u));
+  EXPECT_FLOAT_EQ(u, 1.0f);
+  EXPECT_EQ(ExplicitMpcLocate(part, x_range), 3);  // range_hi
+}
+
+TEST(ExplicitMpcTest, ZeroErrorAtRestStaysInInteriorRegion) {
+  const auto part = BinPartition(0);
+  const float x[kExplicitMpcParamDim] = {0.0f, 0.0f, 0.0f, 0.0f, 0.01f};
+  float u = 1.0f;
+  ASSERT_TRUE(ExplicitMpcEvaluate(part, x, u));
+  EXPECT_EQ(ExplicitMpcLocate(part, x), 0);
+  EXPECT_NEAR(u, 0.0f, 1e-6f);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Malformed tables
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(ExplicitMpcTest, EmptyPartitionIsRejected) {
+  const ExplicitMpcPartition part{};
+  const float x[kExplicitMpcParamDim] = {};
+  float u = 0.5f;
+  EXPECT_EQ(ExplicitMpcLocate(part, x), -1);
+  EXPECT_FALSE(ExplicitMpcEvaluate(part, x, u));
+  EXPECT_FLOAT_EQ(u, 0.5f);
+}
+
+TEST(ExplicitMpcTest, CyclicTreeIsRejected) {
+  const ExplicitMpcNode nodes[2] = {
+      {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 1.0f, 1, 1},
+      {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 1.0f, 0, 0},
+  };
+  const ExplicitMpcRegion regions[1] = {{{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 0.0f}};
+  const ExplicitMpcPartition part{nodes, 2, regions, 1};
+  const float x[kExplicitMpcParamDim] = {};
+  EXPECT_EQ(ExplicitMpcLocate(part, x), -1);
+}
+
+TEST(ExplicitMpcTest, LeafOutOfRegionRangeIsRejected) {
+  const ExplicitMpcNode nodes[1] = {
+      {{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 1.0f, -3, -1},
+  };
+  const ExplicitMpcRegion regions[1] = {{{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, 0.0f}};
+  const ExplicitMpcPartition part{nodes, 1, regions, 1};
+  const float x[kExplicitMpcParamDim] = {};
+  EXPECT_EQ(ExplicitMpcLocate(part, x), -1);
+}
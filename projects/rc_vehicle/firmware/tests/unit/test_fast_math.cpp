@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+#include "fast_math.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+/// Разность углов с учётом обёртки ±π (atan2 у π: +π против −π)
+double AngleDiff(double a, double b) {
+  double d = std::fabs(a - b);
+  return d > kPi ? 2.0 * kPi - d : d;
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// atan2
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(FastMathTest, Atan2WithinBoundOverFullCircleAndScales) {
+  constexpr int kSteps = 200000;
+  double max_err = 0.0;
+  for (int i = 0; i <= kSteps; ++i) {
+    const double t = -kPi + 2.0 * kPi * i / kSteps;
+    const auto y = static_cast<float>(std::sin(t));
+    const auto x = static_cast<float>(std::cos(t));
+    // Малые и большие модули: результат зависит только от отношения
+    for (float k : {1e-30f, 1e-3f, 1.0f, 50.0f, 1e30f}) {
+      const float ys = y * k;
+      const float xs = x * k;
+      const double err =
+          AngleDiff(FastAtan2(ys, xs), std::atan2(double{ys}, double{xs}));
+      max_err = std::max(max_err, err);
+    }
+  }
+  EXPECT_LE(max_err, kFastAtan2MaxErrRad);
+}
+
+TEST(FastMathTest, Atan2AxesAndSigns) {
+  EXPECT_EQ(FastAtan2(0.0f, 0.0f), 0.0f);
+  EXPECT_EQ(FastAtan2(0.0f, 1.0f), 0.0f);
+  EXPECT_NEAR(FastAtan2(1.0f, 0.0f), kPi / 2, kFastAtan2MaxErrRad);
+  EXPECT_NEAR(FastAtan2(-1.0f, 0.0f), -kPi / 2, kFastAtan2MaxErrRad);
+  EXPECT_NEAR(FastAtan2(0.0f, -1.0f), kPi, kFastAtan2MaxErrRad);
+  EXPECT_NEAR(FastAtan2(-1e-7f, -1.0f), -kPi, kFastAtan2MaxErrRad);
+  EXPECT_NEAR(FastAtan2(1.0f, 1.0f), kPi / 4, kFastAtan2MaxErrRad);
+  EXPECT_NEAR(FastAtan2(-3.0f, -3.0f), -3 * kPi / 4, kFastAtan2MaxErrRad);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// asin
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(FastMathTest, AsinWithinBoundOnUnitInterval) {
+  constexpr int kSteps = 1000000;
+  double max_err = 0.0;
+  for (int i = 0; i <= kSteps; ++i) {
+    const float x = -1.0f + 2.0f * static_cast<float>(i) / kSteps;
+    const double err = std::fabs(FastAsin(x) - std::asin(double{x}));
+    max_err = std::max(max_err, err);
+  }
+  // Край |x| → 1: √(1−|x|) меняется быстрее всего — каждый float подряд
+  for (float x = 1.0f; x > 0.999f; x = std::nextafter(x, 0.0f)) {
+    const double err = std::fabs(FastAsin(x) - std::asin(double{x}));
+    max_err = std::max(max_err, err);
+  }
+  EXPECT_LE(max_err, kFastAsinMaxErrRad);
+
+  // Ошибка абсолютная: π/2 − … у нуля теряет относительную точность
+  EXPECT_NEAR(FastAsin(0.0f), 0.0f, kFastAsinMaxErrRad);
+  EXPECT_EQ(FastAsin(-0.25f), -FastAsin(0.25f));
+  EXPECT_NEAR(FastAsin(1.5f), kPi / 2, kFastAsinMaxErrRad);  // Прижат
+  EXPECT_NEAR(FastAsin(-1.5f), -kPi / 2, kFastAsinMaxErrRad);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 1/√x
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(FastMathTest, InvSqrtWithinBoundOverAllNormalFloats) {
+  // Каждый 97-й битовый шаблон от FLT_MIN до FLT_MAX: все порядки и
+  // все положения мантиссы
+  double max_rel = 0.0;
+  for (uint32_t bits = 0x00800000u; bits < 0x7F800000u; bits += 97) {
+    const float x = std::bit_cast<float>(bits);
+    const double ref = 1.0 / std::sqrt(double{x});
+    max_rel = std::max(max_rel, std::fabs(FastInvSqrt(x) - ref) / ref);
+  }
+  EXPECT_LE(max_rel, kFastInvSqrtMaxRelErr);
+
+  EXPECT_EQ(FastInvSqrt(0.0f), 0.0f);
+  EXPECT_EQ(FastInvSqrt(-4.0f), 0.0f);
+  EXPECT_NEAR(Sqrt<true>(2.0f), std::sqrt(2.0), 2.0 * kFastInvSqrtMaxRelErr);
+  EXPECT_EQ(Sqrt<true>(0.0f), 0.0f);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// sincos
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(FastMathTest, SinCosWithinBoundOverSupportedRange) {
+  constexpr int kSteps = 2000000;
+  double max_err = 0.0;
+  for (int i = 0; i <= kSteps; ++i) {
+    const float x = -kFastSinCosMaxArg +
+                    2.0f * kFastSinCosMaxArg * static_cast<float>(i) / kSteps;
+    float s, c;
+    FastSinCos(x, s, c);
+    max_err = std::max({max_err, std::fabs(s - std::sin(double{x})),
+                        std::fabs(c - std::cos(double{x}))});
+  }
+  // Один оборот мелким шагом: стыки квадрантов ±π/4 + kπ/2
+  for (int i = 0; i <= kSteps; ++i) {
+    const auto x = static_cast<float>(-kPi + 2.0 * kPi * i / kSteps);
+    float s, c;
+    FastSinCos(x, s, c);
+    max_err = std::max({max_err, std::fabs(s - std::sin(double{x})),
+                        std::fabs(c - std::cos(double{x}))});
+  }
+  EXPECT_LE(max_err, kFastSinCosMaxErr);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Выбор по флагу
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(FastMathTest, DisabledSwitchIsBitExactStd) {
+  for (float v : {-2.5f, -0.7f, 0.0f, 0.3f, 1.0f, 3.1f}) {
+    EXPECT_EQ(Atan2<false>(v, 0.6f), std::atan2(v, 0.6f));
+    EXPECT_EQ(Sqrt<false>(v * v), std::sqrt(v * v));
+    float s, c;
+    SinCos<false>(v, s, c);
+    EXPECT_EQ(s, std::sin(v));
+    EXPECT_EQ(c, std::cos(v));
+  }
+  EXPECT_EQ(Asin<false>(0.4f), std::asin(0.4f));
+  EXPECT_EQ(InvSqrt<false>(2.0f), 1.0f / std::sqrt(2.0f));
+  EXPECT_EQ(InvSqrt<false>(0.0f), 0.0f);
+  EXPECT_EQ(Atan2<true>(0.4f, 0.6f), FastAtan2(0.4f, 0.6f));
+}
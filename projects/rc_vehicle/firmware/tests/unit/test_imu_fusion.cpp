@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "config.hpp"
+#include "imu_fusion.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+using Cfg = config::ImuFusionConfig;
+
+ImuData Sample(float gz, float az = 1.0f) {
+  ImuData d;
+  d.az = az;
+  d.gz = gz;
+  return d;
+}
+
+/** Датчик с независимым гауссовым шумом по всем осям. */
+class NoisyImu {
+ public:
+  NoisyImu(uint32_t seed, float sigma_g, float sigma_dps)
+      : rng_(seed), acc_(0.f, sigma_g), gyro_(0.f, sigma_dps) {}
+
+  ImuData Read(const ImuData& truth) {
+    ImuData d = truth;
+    d.ax += acc_(rng_);
+    d.ay += acc_(rng_);
+    d.az += acc_(rng_);
+    d.gx += gyro_(rng_);
+    d.gy += gyro_(rng_);
+    d.gz += gyro_(rng_);
+    return d;
+  }
+
+ private:
+  std::mt19937 rng_;
+  std::normal_distribution<float> acc_;
+  std::normal_distribution<float> gyro_;
+};
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Усреднение
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(ImuFusionTest, AveragingReducesNoiseBySqrt2) {
+  NoisyImu a(1, 0.01f, 0.2f), b(2, 0.01f, 0.2f);
+  ImuFusion fusion;
+  const ImuData truth = Sample(0.f);
+  double sum_single = 0, sum_fused = 0;
+  constexpr int kN = 20000;
+  for (int i = 0; i < kN; ++i) {
+    const ImuData da = a.Read(truth), db = b.Read(truth);
+    ImuData out;
+    ASSERT_TRUE(fusion.Update(&da, &db, out));
+    sum_single += da.gz * da.gz;
+    sum_fused += out.gz * out.gz;
+  }
+  const double ratio = std::sqrt(sum_single / sum_fused);
+  EXPECT_NEAR(ratio, std::sqrt(2.0), 0.05);
+  EXPECT_EQ(fusion.ActiveUnits(), 2u);
+  EXPECT_EQ(fusion.Disagreements(), 0u);
+}
+
+TEST(ImuFusionTest, LearnsOffsetAndKeepsScaleOnFailover) {
+  // Разные нули гироскопов: a = +1 dps, b = −1 dps относительно истины
+  ImuFusion fusion;
+  NoisyImu na(3, 0.f, 0.05f), nb(4, 0.f, 0.05f);
+  ImuData out;
+  for (int i = 0; i < 5000; ++i) {
+    const ImuData a = na.Read(Sample(1.f)), b = nb.Read(Sample(-1.f));
+    fusion.Update(&a, &b, out);
+  }
+  EXPECT_NEAR(fusion.Offset()[5], 2.f, 0.05f);
+  EXPECT_NEAR(out.gz, 0.f, 0.2f);
+
+  // b перестал отвечать — выход остаётся в шкале среднего (без ступеньки)
+  const ImuData a = Sample(1.f);
+  ASSERT_TRUE(fusion.Update(&a, nullptr, out));
+  EXPECT_NEAR(out.gz, 0.f, 0.05f);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Отказы
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(ImuFusionTest, ReadFailuresDropUnitWithoutInterruptingOutput) {
+  ImuFusion fusion;
+  NoisyImu na(5, 0.005f, 0.1f);
+  ImuData out;
+  for (uint16_t i = 0; i < Cfg::kMaxReadFailures; ++i) {
+    const ImuData a = na.Read(Sample(10.f));
+    ASSERT_TRUE(fusion.Update(&a, nullptr, out));
+    EXPECT_NEAR(out.gz, 10.f, 1.f);
+  }
+  EXPECT_TRUE(fusion.Health(1).dropped);
+  EXPECT_EQ(fusion.Health(1).reason, ImuDropReason::ReadFailures);
+  EXPECT_FALSE(fusion.Health(0).dropped);
+
+  // Отключённый датчик больше не участвует, даже если снова отвечает
+  const ImuData a = na.Read(Sample(10.f));
+  const ImuData bad = Sample(-100.f);
+  ASSERT_TRUE(fusion.Update(&a, &bad, out));
+  EXPECT_NEAR(out.gz, 10.f, 1.f);
+}
+
+TEST(ImuFusionTest, TransientReadFailureDoesNotDrop) {
+  ImuFusion fusion;
+  NoisyImu na(6, 0.005f, 0.1f), nb(7, 0.005f, 0.1f);
+  ImuData out;
+  for (int i = 0; i < 1000; ++i) {
+    const ImuData a = na.Read(Sample(0.f)), b = nb.Read(Sample(0.f));
+    // Каждый 10-й тик — сбой SPI на b
+    fusion.Update(&a, i % 10 == 0 ? nullptr : &b, out);
+  }
+  EXPECT_EQ(fusion.ActiveUnits(), 2u);
+  EXPECT_EQ(fusion.Health(1).total_read_failures, 100u);
+}
+
+TEST(ImuFusionTest, StuckSensorIsDropped) {
+  ImuFusion fusion;
+  NoisyImu na(8, 0.005f, 0.1f);
+  const ImuData frozen = Sample(0.05f, 1.01f);
+  ImuData out;
+  for (uint16_t i = 0; i <= Cfg::kStuckSamples; ++i) {
+    const ImuData a = na.Read(Sample(0.f));
+    ASSERT_TRUE(fusion.Update(&a, &frozen, out));
+  }
+  EXPECT_TRUE(fusion.Health(1).dropped);
+  EXPECT_EQ(fusion.Health(1).reason, ImuDropReason::Stuck);
+  EXPECT_FALSE(fusion.Health(0).dropped);
+}
+
+TEST(ImuFusionTest, VotingPicksUnitConsistentWithHistory) {
+  ImuFusion fusion;
+  NoisyImu na(9, 0.005f, 0.1f), nb(10, 0.005f, 0.1f);
+  ImuData out;
+  for (int i = 0; i < 500; ++i) {
+    const ImuData a = na.Read(Sample(20.f)), b = nb.Read(Sample(20.f));
+    fusion.Update(&a, &b, out);
+  }
+
+  // Гироскоп a «улетел» (+80 dps): выход следует за b, a отключается
+  for (uint16_t i = 0; i < Cfg::kVoteDropSamples; ++i) {
+    const ImuData a = na.Read(Sample(100.f)), b = nb.Read(Sample(20.f));
+    ASSERT_TRUE(fusion.Update(&a, &b, out));
+    EXPECT_NEAR(out.gz, 20.f, 1.f);
+  }
+  EXPECT_TRUE(fusion.Health(0).dropped);
+  EXPECT_EQ(fusion.Health(0).reason, ImuDropReason::OutVoted);
+  EXPECT_EQ(fusion.Disagreements(), Cfg::kVoteDropSamples);
+  EXPECT_EQ(fusion.ActiveUnits(), 1u);
+}
+
+TEST(ImuFusionTest, ShortGlitchIsOutvotedButNotDropped) {
+  ImuFusion fusion;
+  NoisyImu na(11, 0.005f, 0.1f), nb(12, 0.005f, 0.1f);
+  ImuData out;
+  for (int i = 0; i < 300; ++i) {
+    const bool glitch = i >= 100 && i < 110;  // 10 тиков выброса акселерометра
+    const ImuData a = na.Read(Sample(0.f)),
+                  b = nb.Read(Sample(0.f, glitch ? 3.f : 1.f));
+    ASSERT_TRUE(fusion.Update(&a, &b, out));
+    EXPECT_NEAR(out.az, 1.f, 0.1f);
+  }
+  EXPECT_EQ(fusion.ActiveUnits(), 2u);
+  EXPECT_EQ(fusion.Disagreements(), 10u);
+}
+
+TEST(ImuFusionTest, NoUsableUnitsReturnsFalse) {
+  ImuFusion fusion;
+  ImuData out = Sample(42.f);
+  EXPECT_FALSE(fusion.Update(nullptr, nullptr, out));
+  EXPECT_FLOAT_EQ(out.gz, 42.f);
+  EXPECT_STREQ(ImuDropReasonName(ImuDropReason::OutVoted), "out_voted");
+}
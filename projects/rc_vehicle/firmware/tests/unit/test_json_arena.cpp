@@ -0,0 +1,251 @@
+#include <gtest/gtest.h>
+
+#include <cJSON.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "control_components.hpp"
+#include "json_arena.hpp"
+#include "mock_platform.hpp"
+#include "telemetry_json.hpp"
+
+using namespace rc_vehicle;
+using namespace rc_vehicle::testing;
+
+namespace {
+
+size_t g_heap_mallocs = 0;
+
+void* CountingMalloc(size_t n) {
+  ++g_heap_mallocs;
+  return std::malloc(n);
+}
+
+/** Типичный ответ WS-команды: вложенный объект, массив, печать. */
+size_t BuildReply() {
+  cJSON* reply = cJSON_CreateObject();
+  cJSON_AddStringToObject(reply, "type", "udp_stream_status");
+  cJSON_AddBoolToObject(reply, "streaming", true);
+  cJSON_AddStringToObject(reply, "ip", "192.168.4.100");
+  cJSON_AddNumberToObject(reply, "port", 5555);
+  cJSON* bias = cJSON_AddObjectToObject(reply, "bias");
+  for (const char* k : {"gx", "gy", "gz", "ax", "ay", "az"}) {
+    cJSON_AddNumberToObject(bias, k, 0.0125);
+  }
+  cJSON* arr = cJSON_AddArrayToObject(reply, "targets");
+  for (int i = 0; i < 4; ++i) {
+    cJSON_AddItemToArray(arr, cJSON_CreateNumber(i));
+  }
+  char* str = cJSON_PrintUnformatted(reply);
+  const size_t len = str ? std::strlen(str) : 0;
+  cJSON_free(str);
+  cJSON_Delete(reply);
+  return len;
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BumpArena
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(BumpArenaTest, AllocatesAlignedUntilFull) {
+  StaticBumpArena<256> arena;
+  constexpr size_t kAlign = alignof(std::max_align_t);
+
+  void* a = arena.Allocate(1);
+  void* b = arena.Allocate(3);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % kAlign, 0u);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % kAlign, 0u);
+  EXPECT_EQ(arena.Used(), 2 * kAlign);
+  EXPECT_TRUE(arena.Owns(a));
+
+  EXPECT_EQ(arena.Allocate(256), nullptr);  // Не помещается — арена цела
+  EXPECT_EQ(arena.Used(), 2 * kAlign);
+  EXPECT_NE(arena.Allocate(256 - 2 * kAlign), nullptr);
+  EXPECT_EQ(arena.Allocate(1), nullptr);
+  EXPECT_EQ(arena.HighWater(), 256u);
+
+  arena.Reset();
+  EXPECT_EQ(arena.Used(), 0u);
+  EXPECT_EQ(arena.HighWater(), 256u);
+}
+
+TEST(BumpArenaTest, ReleaseRollsBackOnlyLastBlock) {
+  StaticBumpArena<256> arena;
+  void* a = arena.Allocate(16);
+  void* b = arena.Allocate(16);
+  const size_t used = arena.Used();
+
+  EXPECT_TRUE(arena.Release(a));  // Не последний — освободится при Reset
+  EXPECT_EQ(arena.Used(), used);
+  EXPECT_TRUE(arena.Release(b));  // Последний — откат
+  EXPECT_LT(arena.Used(), used);
+  EXPECT_EQ(arena.Allocate(16), b);
+
+  int on_stack = 0;
+  EXPECT_FALSE(arena.Release(&on_stack));
+  EXPECT_FALSE(arena.Owns(&on_stack));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Хуки cJSON
+// ═══════════════════════════════════════════════════════════════════════════
+
+class JsonArenaHooksTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    JsonArenaInstallHooks();
+    JsonArenaResetStats();
+  }
+  void TearDown() override {
+    JsonArenaRemoveHooks();
+    JsonArenaResetStats();
+  }
+};
+
+TEST_F(JsonArenaHooksTest, NoAllocationEscapesTheArena) {
+  // Сколько malloc делает запрос через кучу
+  cJSON_Hooks counting{CountingMalloc, std::free};
+  cJSON_InitHooks(&counting);
+  g_heap_mallocs = 0;
+  const size_t expected_len = BuildReply();
+  const size_t heap_allocs = g_heap_mallocs;
+  ASSERT_GT(heap_allocs, 10u);
+
+  // Тот же запрос в арене: каждое выделение — из арены, ни одного в куче
+  JsonArenaInstallHooks();
+  StaticBumpArena<4096> arena;
+  {
+    JsonArenaScope scope(arena);
+    EXPECT_EQ(BuildReply(), expected_len);
+  }
+  const JsonArenaStats s = JsonArenaGetStats();
+  EXPECT_EQ(s.arena_allocs, heap_allocs);
+  EXPECT_EQ(s.heap_fallbacks, 0u);
+  EXPECT_EQ(s.unscoped_allocs, 0u);
+  EXPECT_EQ(s.scopes, 1u);
+  EXPECT_GT(s.high_water, 0u);
+  EXPECT_EQ(s.capacity, 4096u);
+  EXPECT_EQ(arena.Used(), 0u);  // Сброшена по выходу из scope
+}
+
+TEST_F(JsonArenaHooksTest, OverflowFallsBackToHeapAndIsCounted) {
+  StaticBumpArena<256> arena;
+  {
+    JsonArenaScope scope(arena);
+    EXPECT_GT(BuildReply(), 0u);  // Ответ собран и напечатан целиком
+  }
+  const JsonArenaStats s = JsonArenaGetStats();
+  EXPECT_GT(s.arena_allocs, 0u);
+  EXPECT_GT(s.heap_fallbacks, 0u);
+  EXPECT_GT(s.heap_fallback_bytes, 0u);
+  EXPECT_EQ(s.high_water, 256u - 256u % alignof(std::max_align_t));
+}
+
+TEST_F(JsonArenaHooksTest, ResetStatsReportsPeakOfLaterScopes) {
+  StaticBumpArena<4096> arena;
+  {
+    JsonArenaScope scope(arena);
+    EXPECT_GT(BuildReply(), 0u);
+  }
+  const uint32_t big = JsonArenaGetStats().high_water;
+  ASSERT_GT(big, 0u);
+
+  // После сброса счётчиков — пик меньшего запроса, а не всей жизни арены
+  JsonArenaResetStats();
+  {
+    JsonArenaScope scope(arena);
+    cJSON_Delete(cJSON_CreateString("small"));
+  }
+  const uint32_t small = JsonArenaGetStats().high_water;
+  EXPECT_GT(small, 0u);
+  EXPECT_LT(small, big);
+  EXPECT_EQ(arena.HighWater(), big);  // Сама арена помнит общий пик
+}
+
+TEST_F(JsonArenaHooksTest, UnscopedAndNestedScopes) {
+  EXPECT_GT(BuildReply(), 0u);
+  EXPECT_GT(JsonArenaGetStats().unscoped_allocs, 0u);
+
+  StaticBumpArena<4096> outer;
+  StaticBumpArena<4096> inner;
+  {
+    JsonArenaScope a(outer);
+    cJSON* keep = cJSON_CreateString("outer");
+    {
+      JsonArenaScope b(inner);  // Продолжает outer, не сбрасывает
+      EXPECT_GT(BuildReply(), 0u);
+    }
+    EXPECT_STREQ(keep->valuestring, "outer");
+    EXPECT_GT(outer.Used(), 0u);
+    EXPECT_EQ(inner.HighWater(), 0u);
+    cJSON_Delete(keep);
+  }
+  EXPECT_EQ(outer.Used(), 0u);
+  EXPECT_EQ(JsonArenaGetStats().scopes, 1u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Реальные документы (узлы cJSON на хосте крупнее, чем на ESP32: 64 против
+// 40 байт, выравнивание 16 против 8)
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST_F(JsonArenaHooksTest, TelemetryFitsTelemetryArena) {
+  FakePlatform platform;
+  platform.SetWebSocketClientCount(1);
+  TelemetryHandler handler(platform, 50);
+
+  TelemetrySnapshot snap{};
+  snap.rc_ok = true;
+  snap.wifi_ok = true;
+  snap.wifi_source = WifiCommandSource::Udp;
+  snap.imu_enabled = true;
+  snap.mag_enabled = true;
+  snap.calib_valid = true;
+  snap.ekf_available = true;
+  snap.oversteer_available = true;
+  snap.kids_mode_active = true;
+  snap.sysid_available = true;
+  handler.SendNow(snap);
+
+  ASSERT_EQ(platform.GetTelemSendCount(), 1);
+  const JsonArenaStats s = JsonArenaGetStats();
+  EXPECT_GT(s.arena_allocs, 50u);
+  EXPECT_EQ(s.heap_fallbacks, 0u);
+  EXPECT_EQ(s.unscoped_allocs, 0u);
+  EXPECT_LE(s.high_water, config::JsonArenaConfig::kTelemetryBytes);
+}
+
+TEST_F(JsonArenaHooksTest, LargeDocumentSpillsToHeapIntact) {
+  // Схема лога (~450 узлов) — крупнейший документ; на хосте не помещается
+  // в арену httpd, и печать идёт частью из арены, частью из кучи
+  JsonArenaRemoveHooks();
+  cJSON* ref = BuildLogSchemaJson();
+  ASSERT_NE(ref, nullptr);
+  char* ref_str = cJSON_PrintUnformatted(ref);
+  const std::string expected(ref_str);
+  cJSON_free(ref_str);
+  cJSON_Delete(ref);
+
+  JsonArenaInstallHooks();
+  StaticBumpArena<config::JsonArenaConfig::kHttpdBytes> arena;
+  {
+    JsonArenaScope scope(arena);
+    cJSON* schema = BuildLogSchemaJson();
+    ASSERT_NE(schema, nullptr);
+    char* str = cJSON_PrintUnformatted(schema);
+    ASSERT_NE(str, nullptr);
+    EXPECT_EQ(std::string(str), expected);
+    cJSON_free(str);
+    cJSON_Delete(schema);
+  }
+  const JsonArenaStats s = JsonArenaGetStats();
+  EXPECT_GT(s.arena_allocs, 0u);
+  EXPECT_GT(s.heap_fallbacks, 0u);
+}
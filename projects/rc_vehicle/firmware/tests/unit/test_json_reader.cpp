@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <string>
+
+#include "json_reader.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+/** Буфер + токены одного разбора (строка копируется: разбор её меняет). */
+struct Parsed {
+  explicit Parsed(const char* json, size_t max_tokens = 64) : text(json) {
+    const auto r = JsonParseInSitu(text.data(), text.size(),
+                                   std::span(tokens.data(), max_tokens));
+    if (IsOk(r)) {
+      root = GetValue(r);
+    } else {
+      error = GetError(r);
+    }
+  }
+
+  std::string text;
+  std::array<JsonToken, 64> tokens{};
+  JsonValue root;
+  std::optional<JsonError> error;
+};
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Токенизация
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(JsonReaderTest, ParsesCommandObject) {
+  Parsed p(R"({"type":"cmd","throttle":0.25,"steering":-1e-1,"on":true})");
+  ASSERT_FALSE(p.error);
+  ASSERT_TRUE(p.root.IsObject());
+  EXPECT_EQ(p.root.Size(), 4u);
+  EXPECT_STREQ(p.root["type"].AsString(), "cmd");
+  EXPECT_FLOAT_EQ(*p.root["throttle"].AsFloat(), 0.25f);
+  EXPECT_FLOAT_EQ(*p.root["steering"].AsFloat(), -0.1f);
+  EXPECT_EQ(p.root["on"].AsBool(), true);
+  EXPECT_FALSE(p.root["missing"].Valid());
+  EXPECT_FALSE(p.root["missing"].AsFloat());
+}
+
+TEST(JsonReaderTest, NestedAndArrays) {
+  Parsed p(R"( { "a" : [1, [2, 3], {"b": null}], "c": {"d": {"e": "x"}} } )");
+  ASSERT_FALSE(p.error);
+  const JsonValue a = p.root["a"];
+  ASSERT_TRUE(a.IsArray());
+  EXPECT_EQ(a.Size(), 3u);
+  EXPECT_EQ(a.At(0).AsInt(), 1);
+  EXPECT_EQ(a.At(1).Size(), 2u);
+  EXPECT_EQ(a.At(1).At(1).AsInt(), 3);
+  EXPECT_TRUE(a.At(2)["b"].IsNull());
+  EXPECT_FALSE(a.At(3).Valid());
+  // Поиск после вложенного массива — по индексу конца поддерева
+  EXPECT_STREQ(p.root["c"]["d"]["e"].AsString(), "x");
+}
+
+TEST(JsonReaderTest, EmptyContainers) {
+  Parsed p(R"({"o":{},"a":[],"z":0})");
+  ASSERT_FALSE(p.error);
+  EXPECT_EQ(p.root["o"].Size(), 0u);
+  EXPECT_EQ(p.root["a"].Size(), 0u);
+  EXPECT_EQ(p.root["z"].AsInt(), 0);
+}
+
+TEST(JsonReaderTest, ScalarRoot) {
+  Parsed p(" -12.5e1 ");
+  ASSERT_FALSE(p.error);
+  EXPECT_DOUBLE_EQ(*p.root.AsDouble(), -125.0);
+}
+
+TEST(JsonReaderTest, StringEscapesDecodedInPlace) {
+  Parsed p(R"({"s":"a\"b\\c\/d\n\u0041\u00e9\u20AC\ud83d\ude00",)"
+           R"("k\u0031":1})");
+  ASSERT_FALSE(p.error);
+  EXPECT_STREQ(p.root["s"].AsString(),
+               "a\"b\\c/d\nA\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+  EXPECT_EQ(p.root["k1"].AsInt(), 1);  // Ключ тоже раскрыт
+}
+
+TEST(JsonReaderTest, EmbeddedNulKeepsLength) {
+  Parsed p(R"({"s":"a\u0000b"})");
+  ASSERT_FALSE(p.error);
+  EXPECT_EQ(p.root["s"].Str(), std::string_view("a\0b", 3));
+}
+
+TEST(JsonReaderTest, RejectsMalformed) {
+  for (const char* bad :
+       {"{", "}", "[1,]", R"({"a":1,})", R"({"a" 1})", R"({a:1})", "[1 2]",
+        "01", "1.", "-", "1e", "tru", "nul", "truex", R"({"a":1}x)", "[}",
+        R"("\x")", R"("\ud800")", R"("\udc00")", "\"a\nb\"", "\"open"}) {
+    Parsed p(bad);
+    ASSERT_TRUE(p.error) << bad;
+    EXPECT_EQ(*p.error, JsonError::Syntax) << bad;
+  }
+  EXPECT_EQ(*Parsed("").error, JsonError::Empty);
+  EXPECT_EQ(*Parsed("  \n").error, JsonError::Empty);
+}
+
+TEST(JsonReaderTest, TokenAndDepthLimits) {
+  // 1 объект + 3 пары = 7 токенов
+  EXPECT_FALSE(Parsed(R"({"a":1,"b":2,"c":3})", 7).error);
+  EXPECT_EQ(*Parsed(R"({"a":1,"b":2,"c":3})", 6).error,
+            JsonError::TooManyTokens);
+
+  std::string deep(kJsonMaxDepth, '[');
+  deep += std::string(kJsonMaxDepth, ']');
+  EXPECT_FALSE(Parsed(deep.c_str()).error);
+  deep = "[" + deep + "]";
+  EXPECT_EQ(*Parsed(deep.c_str()).error, JsonError::TooDeep);
+}
+
+TEST(JsonReaderTest, IntegerConversionSaturates) {
+  Parsed p(R"({"big":1e12,"neg":-1e12,"frac":-2.9,"u":-1})");
+  ASSERT_FALSE(p.error);
+  EXPECT_EQ(p.root["big"].AsInt(), INT32_MAX);
+  EXPECT_EQ(p.root["neg"].AsInt(), INT32_MIN);
+  EXPECT_EQ(p.root["frac"].AsInt(), -2);
+  EXPECT_FALSE(p.root["u"].AsUint());
+  EXPECT_EQ(p.root["big"].AsUint(), UINT32_MAX);
+}
+
+TEST(JsonReaderTest, ReadKeepsDefaultOnTypeMismatch) {
+  Parsed p(R"({"f":"1.5","b":1,"s":2,"ok":1.5})");
+  ASSERT_FALSE(p.error);
+  float f = 7.0f;
+  bool b = true;
+  const char* s = "def";
+  EXPECT_FALSE(p.root.Read("f", f));
+  EXPECT_FALSE(p.root.Read("b", b));
+  EXPECT_FALSE(p.root.Read("s", s));
+  EXPECT_FALSE(p.root.Read("none", f));
+  EXPECT_EQ(f, 7.0f);
+  EXPECT_TRUE(b);
+  EXPECT_STREQ(s, "def");
+  EXPECT_TRUE(p.root.Read("ok", f));
+  EXPECT_EQ(f, 1.5f);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Схемы
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+struct TestArgs {
+  const char* mode = "gyro";
+  float target_accel = 0.1f;
+  std::optional<float> throttle;
+  int32_t count = 100;
+  uint32_t seq = 0;
+  bool save = true;
+  std::optional<bool> apply;
+  JsonValue vec;
+};
+
+constexpr JsonField<TestArgs> kTestSchema[] = {
+    {"mode", &TestArgs::mode},   {"target_accel", &TestArgs::target_accel},
+    {"throttle", &TestArgs::throttle}, {"count", &TestArgs::count},
+    {"seq", &TestArgs::seq},     {"save", &TestArgs::save},
+    {"apply", &TestArgs::apply}, {"vec", &TestArgs::vec},
+};
+
+}  // namespace
+
+TEST(JsonReaderTest, BindFillsDeclaredFields) {
+  Parsed p(R"({"type":"x","mode":"full","throttle":0.5,"count":7.9,)"
+           R"("seq":4000000000,"save":false,"vec":[1,2,3],"extra":{"a":1}})");
+  ASSERT_FALSE(p.error);
+  TestArgs args;
+  EXPECT_EQ(JsonBind(p.root, kTestSchema, args), 6u);
+  EXPECT_STREQ(args.mode, "full");
+  EXPECT_EQ(args.target_accel, 0.1f);  // Нет в JSON — по умолчанию
+  ASSERT_TRUE(args.throttle);
+  EXPECT_EQ(*args.throttle, 0.5f);
+  EXPECT_EQ(args.count, 7);
+  EXPECT_EQ(args.seq, 4000000000u);
+  EXPECT_FALSE(args.save);
+  EXPECT_FALSE(args.apply);
+  ASSERT_TRUE(args.vec.IsArray());
+  EXPECT_EQ(args.vec.At(2).AsInt(), 3);
+}
+
+TEST(JsonReaderTest, BindSkipsWrongTypes) {
+  Parsed p(R"({"mode":1,"target_accel":"fast","apply":"yes","seq":-5})");
+  ASSERT_FALSE(p.error);
+  TestArgs args;
+  EXPECT_EQ(JsonBind(p.root, kTestSchema, args), 0u);
+  EXPECT_STREQ(args.mode, "gyro");
+  EXPECT_EQ(args.target_accel, 0.1f);
+  EXPECT_FALSE(args.apply);
+  EXPECT_EQ(args.seq, 0u);
+
+  // Не объект — ничего
+  Parsed arr("[1,2]");
+  EXPECT_EQ(JsonBind(arr.root, kTestSchema, args), 0u);
+}
+
+TEST(JsonReaderTest, DuplicateKeyFirstWinsInGetAndBind) {
+  Parsed p(R"({"mode":"full","count":1,"mode":"fast","count":2,)"
+           R"("save":"no","save":false})");
+  ASSERT_FALSE(p.error);
+  EXPECT_STREQ(p.root.Get("mode").AsString(), "full");
+  EXPECT_EQ(p.root.Get("count").AsInt(), 1);
+
+  TestArgs args;
+  EXPECT_EQ(JsonBind(p.root, kTestSchema, args), 2u);
+  EXPECT_STREQ(args.mode, "full");
+  EXPECT_EQ(args.count, 1);
+  // Первый save не того типа — повтор всё равно не учитывается, как в Get
+  EXPECT_FALSE(p.root.Get("save").AsBool().has_value());
+  EXPECT_TRUE(args.save);
+}
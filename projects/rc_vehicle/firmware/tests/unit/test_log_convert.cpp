@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "log_convert.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+void AppendU32(std::vector<uint8_t>& buf, uint32_t v) {
+  const auto* p = reinterpret_cast<const uint8_t*>(&v);
+  buf.insert(buf.end(), p, p + sizeof(v));
+}
+
+/// Лог в формате log_bin_handler; frame_size позволяет сымитировать
+/// старую прошивку (кадр усечён до префикса).
+std::vector<uint8_t> BuildLog(const std::vector<TelemetryLogFrame>& frames,
+                              const std::vector<TelemetryEvent>& events,
+                              uint32_t frame_size = sizeof(TelemetryLogFrame)) {
+  std::vector<uint8_t> buf;
+  AppendU32(buf, static_cast<uint32_t>(frames.size()));
+  AppendU32(buf, frame_size);
+  for (const auto& f : frames) {
+    const auto* p = reinterpret_cast<const uint8_t*>(&f);
+    buf.insert(buf.end(), p, p + frame_size);
+  }
+  AppendU32(buf, static_cast<uint32_t>(events.size()));
+  AppendU32(buf, sizeof(TelemetryEvent));
+  for (const auto& e : events) {
+    const auto* p = reinterpret_cast<const uint8_t*>(&e);
+    buf.insert(buf.end(), p, p + sizeof(e));
+  }
+  return buf;
+}
+
+std::vector<TelemetryLogFrame> MakeFrames(uint32_t n, uint32_t dt_ms = 10) {
+  std::vector<TelemetryLogFrame> frames(n);
+  for (uint32_t i = 0; i < n; ++i) {
+    frames[i].ts_ms = i * dt_ms;
+    frames[i].gz = static_cast<float>(i) * 0.25f;
+    frames[i].heading_rel_deg = -0.1f * static_cast<float>(i);
+    frames[i].test_marker = static_cast<uint8_t>(i % 4);
+  }
+  return frames;
+}
+
+TelemetryEvent MakeEvent(uint32_t ts, TelemetryEventType type,
+                         uint8_t param = 0) {
+  TelemetryEvent e{};
+  e.ts_ms = ts;
+  e.type = type;
+  e.param = param;
+  return e;
+}
+
+size_t FieldIndex(const char* name) {
+  for (size_t i = 0; i < kTelemetryLogFieldCount; ++i) {
+    if (std::strcmp(kTelemetryLogFields[i].name, name) == 0) return i;
+  }
+  return kTelemetryLogFieldCount;
+}
+
+}  // namespace
+
+TEST(LogConvertTest, ParseViewPointsIntoBuffer) {
+  const auto buf = BuildLog(MakeFrames(3), {});
+  LogBinView view;
+  ASSERT_EQ(ParseLogBinView(buf.data(), buf.size(), view),
+            LogDecodeError::None);
+  EXPECT_EQ(view.frames, buf.data() + 8);
+  EXPECT_EQ(view.frame_count, 3u);
+  EXPECT_EQ(view.frame_size, sizeof(TelemetryLogFrame));
+  EXPECT_NE(view.events, nullptr);
+  EXPECT_EQ(view.event_count, 0u);
+  EXPECT_EQ(LogFrameTimestamp(view, 2), 20u);
+}
+
+TEST(LogConvertTest, FieldCountFollowsFrameSize) {
+  EXPECT_EQ(LogFieldCountForFrameSize(sizeof(TelemetryLogFrame)),
+            kTelemetryLogFieldCount);
+  // Прошивка с 80-байтным кадром: ts_ms + 19 float
+  EXPECT_EQ(LogFieldCountForFrameSize(80), 20u);
+  EXPECT_EQ(LogFieldCountForFrameSize(4), 1u);
+}
+
+TEST(LogConvertTest, ExtractColumnsMatchesFrames) {
+  const auto frames = MakeFrames(10000);
+  const auto buf = BuildLog(frames, {});
+  LogBinView view;
+  ASSERT_EQ(ParseLogBinView(buf.data(), buf.size(), view),
+            LogDecodeError::None);
+
+  const size_t cols = LogFieldCountForFrameSize(view.frame_size);
+  std::vector<std::vector<uint8_t>> storage(cols);
+  std::vector<void*> dst(cols);
+  for (size_t c = 0; c < cols; ++c) {
+    storage[c].resize(frames.size() * 4);
+    dst[c] = storage[c].data();
+  }
+  ExtractLogColumns(view, 0, frames.size(), dst, 4);
+
+  const size_t gz = FieldIndex("gz");
+  const size_t marker = FieldIndex("test_marker");
+  for (size_t i = 0; i < frames.size(); ++i) {
+    uint32_t ts;
+    float g;
+    std::memcpy(&ts, storage[0].data() + i * 4, 4);
+    std::memcpy(&g, storage[gz].data() + i * 4, 4);
+    ASSERT_EQ(ts, frames[i].ts_ms);
+    ASSERT_EQ(g, frames[i].gz);
+    ASSERT_EQ(storage[marker][i], frames[i].test_marker);
+  }
+}
+
+TEST(LogConvertTest, CsvIsIndependentOfThreadCount) {
+  const auto frames = MakeFrames(20000);
+  const auto buf = BuildLog(frames, {});
+  LogBinView view;
+  ASSERT_EQ(ParseLogBinView(buf.data(), buf.size(), view),
+            LogDecodeError::None);
+
+  const std::string one = EncodeLogFramesCsv(view, 0, frames.size(), 1);
+  const std::string many = EncodeLogFramesCsv(view, 0, frames.size(), 8);
+  EXPECT_EQ(one, many);
+
+  std::istringstream in(one);
+  std::string header, row;
+  std::getline(in, header);
+  EXPECT_EQ(header.rfind("ts_ms,ax,ay,az,", 0), 0u);
+  EXPECT_NE(header.find(",test_marker"), std::string::npos);
+  std::getline(in, row);  // кадр 0
+  std::getline(in, row);  // кадр 1: ts_ms=10, test_marker=1
+  EXPECT_EQ(row.rfind("10,", 0), 0u);
+  std::vector<std::string> cells;
+  std::istringstream cols(row);
+  for (std::string cell; std::getline(cols, cell, ',');) cells.push_back(cell);
+  ASSERT_EQ(cells.size(), kTelemetryLogFieldCount);
+  EXPECT_EQ(cells[FieldIndex("test_marker")], "1");
+}
+
+TEST(LogConvertTest, CsvOfOldFrameHasPrefixColumns) {
+  const auto buf = BuildLog(MakeFrames(2), {}, 80);
+  LogBinView view;
+  ASSERT_EQ(ParseLogBinView(buf.data(), buf.size(), view),
+            LogDecodeError::None);
+  const std::string csv = EncodeLogFramesCsv(view, 0, 2, 0);
+  const std::string header = csv.substr(0, csv.find('\n'));
+  EXPECT_EQ(header.substr(header.size() - 12), ",rc_steering");
+}
+
+TEST(LogConvertTest, SegmentsByTestEvents) {
+  // 0..990 мс, шаг 10 мс
+  const auto frames = MakeFrames(100);
+  const std::vector<TelemetryEvent> events = {
+      MakeEvent(5, TelemetryEventType::ImuCalibStart),
+      MakeEvent(100, TelemetryEventType::TestStart, 1),
+      MakeEvent(300, TelemetryEventType::TestDone, 1),
+      MakeEvent(500, TelemetryEventType::TestStart, 3),
+      MakeEvent(650, TelemetryEventType::TestFailed, 3),
+      MakeEvent(800, TelemetryEventType::TestStart, 2),  // без завершения
+  };
+  const auto buf = BuildLog(frames, events);
+  LogBinView view;
+  ASSERT_EQ(ParseLogBinView(buf.data(), buf.size(), view),
+            LogDecodeError::None);
+
+  const auto segs = SegmentLogByTests(view);
+  ASSERT_EQ(segs.size(), 3u);
+  EXPECT_EQ(segs[0].test_type, 1);
+  EXPECT_EQ(segs[0].first_frame, 10u);
+  EXPECT_EQ(segs[0].end_frame, 31u);  // кадр 300 мс включительно
+  EXPECT_EQ(segs[0].end_event, TelemetryEventType::TestDone);
+  EXPECT_EQ(segs[1].test_type, 3);
+  EXPECT_EQ(segs[1].first_frame, 50u);
+  EXPECT_EQ(segs[1].end_frame, 66u);
+  EXPECT_EQ(segs[1].end_event, TelemetryEventType::TestFailed);
+  EXPECT_EQ(segs[2].first_frame, 80u);
+  EXPECT_EQ(segs[2].end_frame, 100u);
+  EXPECT_EQ(segs[2].end_event, TelemetryEventType::TestStart);
+}
+
+TEST(LogConvertTest, SegmentOutsideFrameWindowIsSkipped) {
+  // Кольцевой буфер кадров уже вытеснил тест: кадры с 1000 мс
+  auto frames = MakeFrames(10);
+  for (auto& f : frames) f.ts_ms += 1000;
+  const auto buf =
+      BuildLog(frames, {MakeEvent(100, TelemetryEventType::TestStart),
+                        MakeEvent(200, TelemetryEventType::TestDone)});
+  LogBinView view;
+  ASSERT_EQ(ParseLogBinView(buf.data(), buf.size(), view),
+            LogDecodeError::None);
+  EXPECT_TRUE(SegmentLogByTests(view).empty());
+}
+
+TEST(LogConvertTest, SegmentEndingAtMaxTimestampKeepsFrames) {
+  // end_ms = UINT32_MAX: end_ms + 1 не должен переполниться в 0
+  auto frames = MakeFrames(10);
+  frames.back().ts_ms = UINT32_MAX;
+  const auto buf =
+      BuildLog(frames, {MakeEvent(20, TelemetryEventType::TestStart),
+                        MakeEvent(UINT32_MAX, TelemetryEventType::TestDone)});
+  LogBinView view;
+  ASSERT_EQ(ParseLogBinView(buf.data(), buf.size(), view),
+            LogDecodeError::None);
+  const auto segs = SegmentLogByTests(view);
+  ASSERT_EQ(segs.size(), 1u);
+  EXPECT_EQ(segs[0].first_frame, 2u);
+  EXPECT_EQ(segs[0].end_frame, 10u);  // Кадр UINT32_MAX включительно
+}
+
+TEST(LogConvertTest, EventsCsv) {
+  auto ev = MakeEvent(42, TelemetryEventType::TestStart, 2);
+  ev.value1 = 1.5f;
+  const auto buf = BuildLog(MakeFrames(1), {ev});
+  LogBinView view;
+  ASSERT_EQ(ParseLogBinView(buf.data(), buf.size(), view),
+            LogDecodeError::None);
+  EXPECT_EQ(EncodeLogEventsCsv(view),
+            "ts_ms,type,param,value1,value2\n42,13,2,1.5,0\n");
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include "log_format.hpp"
+
+using namespace rc_vehicle;
+
+TEST(LogFormatTest, MixedValues) {
+  LogFormat fmt;
+  fmt << "loop=" << 500u << " err=" << -3 << ' ' << std::string_view("ok");
+  EXPECT_EQ(fmt.str(), "loop=500 err=-3 ok");
+}
+
+TEST(LogFormatTest, FloatDefaultAndFixed) {
+  LogFormat fmt;
+  fmt << 0.5f << " " << Fixed(2) << 3.14159f << " " << 2.0 << " "
+      << Fixed(0) << 7.6f;
+  EXPECT_EQ(fmt.str(), "0.5 3.14 2.00 8");
+}
+
+TEST(LogFormatTest, HexWidthAndCase) {
+  LogFormat fmt;
+  fmt << "0x" << Hex(0x6a, 2) << "-" << Hex(0xb, 2, true) << Hex(0x1f, 0, true);
+  EXPECT_EQ(fmt.str(), "0x6a-0B1F");
+}
+
+TEST(LogFormatTest, TruncatesAtCapacity) {
+  LogFormat fmt;
+  for (int i = 0; i < 100; ++i) fmt << "abcd" << i;
+  EXPECT_EQ(fmt.str().size(), LogFormat::kCapacity - 1);
+  EXPECT_EQ(std::strlen(fmt.c_str()), LogFormat::kCapacity - 1);
+}
+
+TEST(LogFormatTest, FormatIpNetworkOrder) {
+  char buf[16];
+  FormatIp(0x0104A8C0u, buf, sizeof(buf));  // 192.168.4.1
+  EXPECT_STREQ(buf, "192.168.4.1");
+  char small[8];
+  FormatIp(0x0104A8C0u, small, sizeof(small));
+  EXPECT_STREQ(small, "192.168");
+}
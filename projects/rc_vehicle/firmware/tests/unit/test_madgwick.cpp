@@ -4,6 +4,7 @@
 #include <cmath>
 #include <vector>
 
+#include "filter_benchmark.hpp"
 #include "madgwick_filter.hpp"
 #include "mpu6050_spi.hpp"
 #include "test_helpers.hpp"
@@ -1052,4 +1053,107 @@ TEST(MadgwickTest, NegativeBeta) {
 
   EXPECT_TRUE(IsQuaternionNormalized(qw, qx, qy, qz))
       << "Filter should not crash with negative beta";
-}
\ No newline at end of file
+}
+// ═══════════════════════════════════════════════════════════════════════════
+// Batch API
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+struct ImuSeries {
+  std::vector<float> ax, ay, az, gx, gy, gz, dt;
+
+  explicit ImuSeries(size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      const float t = static_cast<float>(i) * 0.002f;
+      ax.push_back(0.4f * std::sin(1.3f * t));
+      ay.push_back(0.6f * std::sin(2.7f * t));
+      az.push_back(1.0f + 0.3f * std::cos(4.0f * t));
+      gx.push_back(5.0f * std::sin(3.0f * t));
+      gy.push_back(-4.0f * std::cos(2.0f * t));
+      gz.push_back(90.0f * std::sin(2.7f * t));
+      dt.push_back(0.002f + 0.0001f * static_cast<float>(i % 3));
+    }
+  }
+
+  ImuBatch Batch() const { return {ax, ay, az, gx, gy, gz, dt}; }
+};
+
+void ExpectSameQuaternion(const MadgwickFilter& a, const MadgwickFilter& b) {
+  float aw, ax, ay, az, bw, bx, by, bz;
+  a.GetQuaternion(aw, ax, ay, az);
+  b.GetQuaternion(bw, bx, by, bz);
+  EXPECT_EQ(aw, bw);
+  EXPECT_EQ(ax, bx);
+  EXPECT_EQ(ay, by);
+  EXPECT_EQ(az, bz);
+}
+
+}  // namespace
+
+TEST(MadgwickTest, UpdateBatch_MatchesPerSampleExactly) {
+  const ImuSeries s(1000);
+  MadgwickFilter single, batch;
+
+  std::vector<float> pitch(1000), roll(1000), yaw(1000);
+  ASSERT_TRUE(batch.UpdateBatch(s.Batch(), pitch, roll, yaw));
+
+  for (size_t i = 0; i < 1000; ++i) {
+    single.Update(s.ax[i], s.ay[i], s.az[i], s.gx[i], s.gy[i], s.gz[i],
+                  s.dt[i]);
+    float p, r, y;
+    single.GetEulerDeg(p, r, y);
+    ASSERT_EQ(p, pitch[i]) << "sample " << i;
+    ASSERT_EQ(r, roll[i]) << "sample " << i;
+    ASSERT_EQ(y, yaw[i]) << "sample " << i;
+  }
+  ExpectSameQuaternion(single, batch);
+}
+
+TEST(MadgwickTest, UpdateBatch_AdaptiveBetaAndVehicleFrameMatch) {
+  const ImuSeries s(500);
+  const float gravity[3] = {0.0f, 0.1f, 0.99f};
+  const float forward[3] = {1.0f, 0.0f, 0.0f};
+
+  MadgwickFilter single, batch;
+  for (auto* f : {&single, &batch}) {
+    f->SetBeta(0.2f);
+    f->SetAdaptiveBeta(true, 0.15f);
+    f->SetVehicleFrame(gravity, forward, true);
+  }
+
+  const float dt = 0.002f;
+  ImuBatch b = s.Batch();
+  b.dt = {&dt, 1};
+  ASSERT_TRUE(batch.UpdateBatch(b));
+  for (size_t i = 0; i < 500; ++i) {
+    single.Update(s.ax[i], s.ay[i], s.az[i], s.gx[i], s.gy[i], s.gz[i], dt);
+  }
+  ExpectSameQuaternion(single, batch);
+}
+
+TEST(MadgwickTest, UpdateBatch_RejectsMismatchedSizes) {
+  const ImuSeries s(10);
+  MadgwickFilter filter;
+  filter.Update(0.0f, 0.0f, 1.0f, 10.0f, 0.0f, 0.0f, 0.01f);
+  MadgwickFilter reference = filter;
+
+  ImuBatch b = s.Batch();
+  b.gz = b.gz.first(9);
+  EXPECT_FALSE(filter.UpdateBatch(b));
+
+  std::vector<float> short_out(5);
+  EXPECT_FALSE(filter.UpdateBatch(s.Batch(), short_out, short_out, short_out));
+
+  ExpectSameQuaternion(filter, reference);
+}
+
+TEST(MadgwickTest, FilterBenchmark_BatchOutputsMatch) {
+  const auto r = RunFilterBenchmark(256);
+  EXPECT_EQ(r.samples, 256u);
+  EXPECT_TRUE(r.outputs_match);
+  EXPECT_GT(r.madgwick_batch_sps, 0.0f);
+  EXPECT_GT(r.ekf_batch_sps, 0.0f);
+  EXPECT_GT(r.math_std_sps, 0.0f);
+  EXPECT_GT(r.math_fast_sps, 0.0f);
+}
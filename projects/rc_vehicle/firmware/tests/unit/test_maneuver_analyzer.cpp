@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "config.hpp"
+#include "maneuver_analyzer.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+constexpr float kDt = 0.002f;  // 500 Гц
+constexpr float kDuration = 3.0f;
+
+/// Прогнать step response y(t) через StepResponseAnalyzer
+template <typename Fn>
+StepMetrics RunStep(float baseline, Fn&& response) {
+  StepResponseAnalyzer a;
+  a.Begin(baseline, kDuration);
+  const int n = static_cast<int>(kDuration / kDt);
+  for (int i = 1; i <= n; ++i) a.Add(baseline + response(i * kDt), kDt);
+  return a.Finish();
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RunningStats / LevelCrossingTable
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(RunningStatsTest, MeanStdMaxAbs) {
+  RunningStats s;
+  for (float x : {2.0f, 4.0f, 4.0f, 4.0f, 5.0f, 5.0f, 7.0f, -9.0f}) s.Add(x);
+  EXPECT_EQ(s.Count(), 8u);
+  EXPECT_NEAR(s.Mean(), 2.75f, 1e-5f);
+  EXPECT_NEAR(s.StdDev(), 4.9497f, 1e-3f);
+  EXPECT_FLOAT_EQ(s.MaxAbs(), 9.0f);
+}
+
+TEST(LevelCrossingTableTest, RampCrossingsExactOnGrid) {
+  LevelCrossingTable t;
+  t.Reset(1.0f);
+  for (int i = 0; i <= 20; ++i) t.Add(static_cast<float>(i), i * 0.1f);
+  EXPECT_NEAR(t.FirstAbove(5.0f), 0.5f, 1e-5f);
+  EXPECT_NEAR(t.FirstAbove(5.5f), 0.55f, 1e-5f);  // интерполяция
+  EXPECT_FLOAT_EQ(t.Peak(), 20.0f);
+  EXPECT_EQ(t.FirstAbove(25.0f), LevelCrossingTable::kNever);
+}
+
+TEST(LevelCrossingTableTest, GrowingAmplitudeRescalesGrid) {
+  LevelCrossingTable t;
+  t.Reset(0.5f);
+  for (int i = 0; i <= 1000; ++i) t.Add(static_cast<float>(i), i * 0.001f);
+  // Сетка выросла, шаг ≤ 2 · пик / (kLevels − 1)
+  EXPECT_GT(t.Step(), 0.5f);
+  EXPECT_LE(t.Step(), 2.0f * 1000.0f / (LevelCrossingTable::kLevels - 1));
+  EXPECT_NEAR(t.FirstAbove(500.0f), 0.5f, t.Step() * 0.001f);
+  EXPECT_NEAR(t.LastBelow(999.0f), 1.0f, 1e-6f);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// StepResponseAnalyzer
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(StepResponseAnalyzerTest, FirstOrder_RiseAndSettlingMatchAnalytic) {
+  constexpr float kTau = 0.1f;
+  const StepMetrics m = RunStep(
+      5.0f, [](float t) { return 100.0f * (1.0f - std::exp(-t / kTau)); });
+  ASSERT_TRUE(m.valid);
+  EXPECT_NEAR(m.steady_dps, 105.0f, 0.5f);
+  EXPECT_NEAR(m.rise_time_s, kTau * std::log(9.0f), 0.01f);
+  // Выход из полосы — оценка сверху с точностью до шага сетки уровней
+  EXPECT_GE(m.settling_time_s, kTau * std::log(20.0f) - 1e-3f);
+  EXPECT_LT(m.settling_time_s, kTau * std::log(20.0f) + 0.03f);
+  EXPECT_NEAR(m.overshoot_pct, 0.0f, 0.5f);
+}
+
+TEST(StepResponseAnalyzerTest, Underdamped_OvershootMatchesAnalytic) {
+  // ζ = 0.5: перерегулирование exp(−πζ/√(1−ζ²)) ≈ 16.3 %
+  constexpr float kZeta = 0.5f;
+  constexpr float kWn = 20.0f;
+  const float wd = kWn * std::sqrt(1.0f - kZeta * kZeta);
+  const float phi = std::acos(kZeta);
+  const StepMetrics m = RunStep(0.0f, [&](float t) {
+    const float e = std::exp(-kZeta * kWn * t) / std::sin(phi);
+    return -80.0f * (1.0f - e * std::sin(wd * t + phi));
+  });
+  ASSERT_TRUE(m.valid);
+  EXPECT_NEAR(m.steady_dps, -80.0f, 0.5f);  // отрицательный скачок
+  EXPECT_NEAR(m.overshoot_pct, 16.3f, 1.0f);
+  EXPECT_NEAR(m.peak_dps, -80.0f * 1.163f, 1.0f);
+  // Огибающая выходит из ±5 % при t ≈ ln(20 / sin φ) / (ζ ωn)
+  EXPECT_GT(m.settling_time_s, 0.1f);
+  EXPECT_LT(m.settling_time_s, 0.35f);
+}
+
+TEST(StepResponseAnalyzerTest, TooSmallStep_Invalid) {
+  const StepMetrics m = RunStep(10.0f, [](float) { return 1.0f; });
+  EXPECT_FALSE(m.valid);
+  EXPECT_NEAR(m.steady_dps, 11.0f, 1e-4f);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ManeuverAnalyzer
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(ManeuverAnalyzerTest, Cruise_SkipsTransientAtPhaseStart) {
+  ManeuverAnalyzer a;
+  float elapsed = 0.0f;
+  for (int i = 0; i < 1000; ++i) {
+    elapsed += kDt;
+    // Первые kSteadySkipSec — переход, дальше — установившийся круг
+    const bool transient = elapsed < config::ManeuverConfig::kSteadySkipSec;
+    a.AddCruise({transient ? 300.0f : 60.0f, 4.0f, 2.0f}, elapsed, kDt);
+  }
+  const ManeuverMetrics m = a.Finish();
+  EXPECT_FALSE(m.has_step);
+  EXPECT_NEAR(m.yaw_rate_mean_dps, 60.0f, 1e-3f);
+  EXPECT_NEAR(m.yaw_rate_std_dps, 0.0f, 1e-3f);
+  EXPECT_NEAR(m.slip_mean_deg, 4.0f, 1e-4f);
+  EXPECT_NEAR(m.speed_mean_ms, 2.0f, 1e-4f);
+  EXPECT_NEAR(m.window_s, 2.0f - config::ManeuverConfig::kSteadySkipSec,
+              2 * kDt);
+}
+
+TEST(ManeuverAnalyzerTest, Step_BaselineFromCruise) {
+  ManeuverAnalyzer a;
+  float elapsed = 0.0f;
+  for (int i = 0; i < 500; ++i) {
+    elapsed += kDt;
+    a.AddCruise({2.0f, 0.0f, 2.0f}, elapsed, kDt);
+  }
+  a.BeginStep(kDuration);
+  for (int i = 0; i < 1500; ++i) a.AddStep({52.0f, 1.0f, 2.0f}, kDt);
+
+  const ManeuverMetrics m = a.Finish();
+  ASSERT_TRUE(m.has_step);
+  EXPECT_TRUE(m.step.valid);
+  EXPECT_NEAR(m.step.baseline_dps, 2.0f, 1e-4f);
+  EXPECT_NEAR(m.step.steady_dps, 52.0f, 1e-4f);
+  EXPECT_NEAR(m.yaw_rate_mean_dps, 52.0f, 1e-4f);  // окно — StepExec
+  EXPECT_NEAR(m.window_s, kDuration, 2 * kDt);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "config.hpp"
+#include "mem_stats.hpp"
+
+using namespace rc_vehicle;
+using Cfg = rc_vehicle::config::MemMonitorConfig;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Рекомендация размера стека и фрагментация
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(MemStatsTest, RecommendAddsMarginGuardAndAligns) {
+  // 4000 · 1.25 + 512 = 5512 → 5632 (шаг 256)
+  EXPECT_EQ(RecommendStackBytes(4000), 5632u);
+  EXPECT_EQ(RecommendStackBytes(4000) % Cfg::kStackAlignBytes, 0u);
+  // Маленький пик — не меньше минимума
+  EXPECT_EQ(RecommendStackBytes(0), Cfg::kMinStackBytes);
+  EXPECT_EQ(RecommendStackBytes(600), Cfg::kMinStackBytes);
+  // Монотонность
+  EXPECT_LE(RecommendStackBytes(3000), RecommendStackBytes(3001));
+}
+
+TEST(MemStatsTest, FragmentationPct) {
+  EXPECT_EQ(FragmentationPct(0, 0), 0u);
+  EXPECT_EQ(FragmentationPct(100000, 100000), 0u);
+  EXPECT_EQ(FragmentationPct(100000, 25000), 75u);
+  EXPECT_EQ(FragmentationPct(100000, 200000), 0u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Стеки задач
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(MemStatsTest, StackKeepsMinimumAcrossSamplesAndAfterExit) {
+  MemStats stats;
+  ASSERT_TRUE(stats.RegisterTask("vehicle_ctrl", 12288));
+  ASSERT_TRUE(stats.RegisterTask("ota_task", 4096));
+  EXPECT_EQ(stats.TaskCount(), 2u);
+  EXPECT_FALSE(stats.Task(0).seen);
+
+  stats.UpdateStack(0, 9000);
+  stats.UpdateStack(0, 7800);
+  stats.UpdateStack(0, 8500);
+  EXPECT_EQ(stats.Task(0).min_free_bytes, 7800u);
+  EXPECT_TRUE(stats.Task(0).alive);
+
+  stats.UpdateStack(1, 900);
+  stats.MarkGone(1);
+  EXPECT_FALSE(stats.Task(1).alive);
+  EXPECT_TRUE(stats.Task(1).seen);
+  EXPECT_EQ(stats.Task(1).min_free_bytes, 900u);
+  EXPECT_EQ(stats.TightestTask(), 1u);
+
+  // Повторная регистрация обновляет размер, не добавляет строку
+  ASSERT_TRUE(stats.RegisterTask("ota_task", 5120));
+  EXPECT_EQ(stats.TaskCount(), 2u);
+  EXPECT_EQ(stats.Task(1).stack_bytes, 5120u);
+}
+
+TEST(MemStatsTest, AdviseAndReclaimable) {
+  MemStats stats;
+  ASSERT_TRUE(stats.RegisterTask("vehicle_ctrl", 12288));
+  ASSERT_TRUE(stats.RegisterTask("udp_cmd", 3072));
+  ASSERT_TRUE(stats.RegisterTask("sys_unknown", 0));
+  ASSERT_TRUE(stats.RegisterTask("never_run", 4096));
+
+  stats.UpdateStack(0, 12288 - 4000);  // пик 4000 → 5632
+  stats.UpdateStack(1, 200);           // пик 2872 → 4352: стек мал
+  stats.UpdateStack(2, 1000);
+
+  const StackAdvice ctrl = stats.Advise(0);
+  EXPECT_EQ(ctrl.peak_used, 4000u);
+  EXPECT_EQ(ctrl.recommended, 5632u);
+  EXPECT_EQ(ctrl.reclaim, 12288 - 5632);
+
+  const StackAdvice cmd = stats.Advise(1);
+  EXPECT_EQ(cmd.peak_used, 2872u);
+  EXPECT_LT(cmd.reclaim, 0);
+
+  // Размер неизвестен / задачу не видели — без рекомендации
+  EXPECT_EQ(stats.Advise(2).recommended, 0u);
+  EXPECT_EQ(stats.Advise(3).recommended, 0u);
+
+  EXPECT_EQ(stats.ReclaimableBytes(), static_cast<uint32_t>(12288 - 5632));
+}
+
+TEST(MemStatsTest, TableFullAndLongNames) {
+  MemStats stats;
+  char name[8];
+  for (size_t i = 0; i < MemStats::kMaxTasks; ++i) {
+    std::snprintf(name, sizeof(name), "t%zu", i);
+    ASSERT_TRUE(stats.RegisterTask(name, 2048));
+  }
+  EXPECT_FALSE(stats.RegisterTask("one_more", 2048));
+  EXPECT_FALSE(stats.RegisterTask(nullptr, 2048));
+
+  MemStats other;
+  ASSERT_TRUE(other.RegisterTask("a_very_long_task_name_here", 2048));
+  EXPECT_EQ(std::strlen(other.Task(0).name), 15u);
+  EXPECT_EQ(other.TightestTask(), other.TaskCount());  // никого не видели
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Кучи
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(MemStatsTest, HeapTracksMinimaAndAbsentRegion) {
+  MemStats stats;
+  stats.UpdateHeap(HeapRegion::Internal, {300000, 180000, 110000, 170000});
+  stats.UpdateHeap(HeapRegion::Internal, {300000, 190000, 90000, 165000});
+  stats.UpdateHeap(HeapRegion::Psram, {0, 0, 0, 0});  // без PSRAM
+
+  const HeapStats& in = stats.Heap(HeapRegion::Internal);
+  ASSERT_TRUE(in.present);
+  EXPECT_EQ(in.last.free, 190000u);
+  EXPECT_EQ(in.min_free, 165000u);  // минимум аллокатора
+  EXPECT_EQ(in.min_largest_block, 90000u);
+  EXPECT_FALSE(stats.Heap(HeapRegion::Psram).present);
+  EXPECT_FALSE(stats.Heap(HeapRegion::Dma).present);
+  EXPECT_STREQ(HeapRegionName(HeapRegion::Psram), "psram");
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "config.hpp"
+#include "online_sysid.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+constexpr float kDtS = config::ControlLoopConfig::kPeriodMs * 0.001f;
+
+/// Звено первого порядка y' = (K·u − y) / τ, шаг control loop
+struct FirstOrderPlant {
+  float gain;
+  float tau_s;
+  float y{0.0f};
+
+  float Step(float u) {
+    y += kDtS / tau_s * (gain * u - y);
+    return y;
+  }
+};
+
+/// Меандр ±amp с полупериодом half_period_ticks (возбуждение для RLS)
+float Square(int tick, int half_period_ticks, float amp) {
+  return ((tick / half_period_ticks) % 2 == 0) ? amp : -amp;
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RecursiveLeastSquares
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(RecursiveLeastSquaresTest, RecoversLinearModel) {
+  RecursiveLeastSquares<3> rls(1.0f, 100.0f, 1.0e6f);
+  for (int i = 0; i < 200; ++i) {
+    const float x1 = std::sin(0.3f * i);
+    const float x2 = std::cos(0.17f * i);
+    rls.Update({x1, x2, 1.0f}, 2.0f * x1 - 3.0f * x2 + 0.5f);
+  }
+  EXPECT_NEAR(rls.Theta()[0], 2.0f, 1e-3f);
+  EXPECT_NEAR(rls.Theta()[1], -3.0f, 1e-3f);
+  EXPECT_NEAR(rls.Theta()[2], 0.5f, 1e-3f);
+}
+
+TEST(RecursiveLeastSquaresTest, CovarianceTraceBounded) {
+  // Без возбуждения по x2 забывание раздувает P — след ограничен
+  RecursiveLeastSquares<2> rls(0.9f, 1.0f, 50.0f);
+  for (int i = 0; i < 500; ++i) rls.Update({1.0f, 0.0f}, 1.0f);
+  EXPECT_LE(rls.CovTrace(), 50.0f * 1.0001f);
+  EXPECT_TRUE(std::isfinite(rls.Theta()[0]));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OnlineSysId: руль → yaw rate
+// ═══════════════════════════════════════════════════════════════════════════
+
+class OnlineSysIdTest : public ::testing::Test {
+ protected:
+  /// ticks тиков: меандр руля, yaw rate — звено steer, скорость speed_ms
+  void DriveSteering(int ticks, float speed_ms, float steer_amp = 0.4f) {
+    for (int i = 0; i < ticks; ++i, ++tick_) {
+      SysIdSample s;
+      s.steering = Square(tick_, 250, steer_amp);
+      s.yaw_rate_dps = steer_.Step(s.steering);
+      s.throttle = 0.3f;
+      s.speed_ms = speed_ms;
+      id_.Update(s);
+    }
+  }
+
+  OnlineSysId id_;
+  FirstOrderPlant steer_{120.0f, 0.15f};
+  int tick_{0};
+};
+
+TEST_F(OnlineSysIdTest, SteeringPlant_GainAndTauRecovered) {
+  DriveSteering(10000, 3.0f);  // 20 с
+  const SysIdEstimate e = id_.GetEstimate();
+  ASSERT_TRUE(e.steer_valid);
+  EXPECT_NEAR(e.steer_gain_dps, 120.0f, 6.0f);
+  EXPECT_NEAR(e.steer_tau_s, 0.15f, 0.03f);
+  EXPECT_GE(e.steer_updates, config::SysIdConfig::kMinUpdates);
+}
+
+TEST_F(OnlineSysIdTest, NoExcitation_EstimateFrozen) {
+  DriveSteering(5000, 3.0f, /*steer_amp=*/0.0f);
+  const SysIdEstimate e = id_.GetEstimate();
+  EXPECT_EQ(e.steer_updates, 0u);
+  EXPECT_FALSE(e.steer_valid);
+}
+
+TEST_F(OnlineSysIdTest, LowSpeed_SteeringNotIdentified) {
+  DriveSteering(5000, config::SysIdConfig::kMinSpeedMs * 0.5f);
+  EXPECT_EQ(id_.GetEstimate().steer_updates, 0u);
+}
+
+TEST_F(OnlineSysIdTest, Forgetting_TracksGainChange) {
+  DriveSteering(10000, 3.0f);
+  ASSERT_NEAR(id_.GetEstimate().steer_gain_dps, 120.0f, 6.0f);
+
+  // Сменилось покрытие: коэффициент упал вдвое
+  steer_.gain = 60.0f;
+  DriveSteering(10000, 3.0f);
+  EXPECT_NEAR(id_.GetEstimate().steer_gain_dps, 60.0f, 3.0f);
+}
+
+TEST_F(OnlineSysIdTest, RequestReset_ClearsOnNextTick) {
+  DriveSteering(5000, 3.0f);
+  ASSERT_GT(id_.GetEstimate().steer_updates, 0u);
+  id_.RequestReset();
+  DriveSteering(1, 3.0f);
+  const SysIdEstimate e = id_.GetEstimate();
+  EXPECT_EQ(e.steer_updates, 0u);
+  EXPECT_FALSE(e.steer_valid);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OnlineSysId: газ → скорость
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(OnlineSysIdSpeedTest, ThrottlePlant_GainRecovered) {
+  OnlineSysId id;
+  FirstOrderPlant speed{6.0f, 0.5f};
+  for (int i = 0; i < 15000; ++i) {
+    SysIdSample s;
+    s.throttle = 0.4f + Square(i, 500, 0.2f);
+    s.speed_ms = speed.Step(s.throttle);
+    id.Update(s);
+  }
+  const SysIdEstimate e = id.GetEstimate();
+  ASSERT_TRUE(e.speed_valid);
+  EXPECT_NEAR(e.speed_gain_ms, 6.0f, 0.3f);
+  EXPECT_NEAR(e.speed_tau_s, 0.5f, 0.1f);
+  // Скорость ниже порога — руль не идентифицируется
+  EXPECT_EQ(e.steer_updates, 0u);
+}
+
+TEST(OnlineSysIdSpeedTest, BrakingWindows_Skipped) {
+  OnlineSysId id;
+  FirstOrderPlant speed{6.0f, 0.5f};
+  for (int i = 0; i < 5000; ++i) {
+    SysIdSample s;
+    s.throttle = Square(i, 500, 0.3f);  // половина времени — тормоз/реверс
+    s.speed_ms = speed.Step(s.throttle);
+    id.Update(s);
+  }
+  const uint32_t windows = 5000 / config::SysIdConfig::kDecimation;
+  EXPECT_GT(id.GetEstimate().speed_updates, 0u);
+  EXPECT_LT(id.GetEstimate().speed_updates, windows / 2 + 1);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Применение к регулятору
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(RateLimitedApplyTest, StepBoundedByFraction) {
+  EXPECT_FLOAT_EQ(RateLimitedApply(100.0f, 200.0f, 0.05f), 105.0f);
+  EXPECT_FLOAT_EQ(RateLimitedApply(100.0f, 10.0f, 0.05f), 95.0f);
+  EXPECT_FLOAT_EQ(RateLimitedApply(100.0f, 102.0f, 0.05f), 102.0f);
+}
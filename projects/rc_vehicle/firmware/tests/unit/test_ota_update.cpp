@@ -0,0 +1,359 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "config.hpp"
+#include "ota_update.hpp"
+#include "self_test.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+using Cfg = config::OtaConfig;
+
+/// Эталонный LZSS-кодер (жадный, полный перебор окна) — как tools/ota_pack.py
+Bytes LzssCompress(const Bytes& in) {
+  Bytes out;
+  size_t flags_pos = 0;
+  int bit = 8;
+  for (size_t i = 0; i < in.size();) {
+    if (bit == 8) {
+      flags_pos = out.size();
+      out.push_back(0);
+      bit = 0;
+    }
+    size_t best_len = 0, best_off = 0;
+    const size_t limit = std::min<size_t>(18, in.size() - i);
+    for (size_t off = 1; off <= std::min<size_t>(i, 4096); ++off) {
+      size_t len = 0;
+      while (len < limit && in[i - off + len] == in[i + len]) ++len;
+      if (len > best_len) best_len = len, best_off = off;
+    }
+    if (best_len >= 3) {
+      const uint16_t ref =
+          static_cast<uint16_t>(((best_len - 3) << 12) | (best_off - 1));
+      out.push_back(ref & 0xFF);
+      out.push_back(ref >> 8);
+      i += best_len;
+    } else {
+      out[flags_pos] |= static_cast<uint8_t>(1u << bit);
+      out.push_back(in[i++]);
+    }
+    ++bit;
+  }
+  return out;
+}
+
+Bytes Pack(const Bytes& raw, OtaCodec codec) {
+  const Bytes payload = codec == OtaCodec::Lzss ? LzssCompress(raw) : raw;
+  OtaImageHeader h;
+  h.codec = static_cast<uint8_t>(codec);
+  h.raw_size = static_cast<uint32_t>(raw.size());
+  h.payload_size = static_cast<uint32_t>(payload.size());
+  h.raw_crc32 = Crc32(raw.data(), raw.size());
+  h.header_crc32 = Crc32(reinterpret_cast<const uint8_t*>(&h),
+                         offsetof(OtaImageHeader, header_crc32));
+  Bytes img(sizeof(h));
+  std::memcpy(img.data(), &h, sizeof(h));
+  img.insert(img.end(), payload.begin(), payload.end());
+  return img;
+}
+
+/// Образ: повторяющиеся блоки (как код) вперемешку с псевдослучайными
+Bytes MakeRaw(size_t size) {
+  Bytes raw(size);
+  uint32_t x = 12345;
+  for (size_t i = 0; i < size; ++i) {
+    x = x * 1103515245u + 12345u;
+    raw[i] = (i / 64) % 3 == 0 ? static_cast<uint8_t>(x >> 24)
+                               : static_cast<uint8_t>(i % 29);
+  }
+  return raw;
+}
+
+class MemorySink : public OtaSink {
+ public:
+  bool Begin(uint32_t size) override {
+    begun = true;
+    expected = size;
+    return true;
+  }
+  bool Write(const uint8_t* d, size_t n) override {
+    if (fail_after_bytes >= 0 &&
+        data.size() + n > static_cast<size_t>(fail_after_bytes)) {
+      return false;
+    }
+    writes.push_back(n);
+    data.insert(data.end(), d, d + n);
+    return true;
+  }
+  bool Finish() override {
+    finished = true;
+    return true;
+  }
+  void Abort() override { aborted = true; }
+
+  Bytes data;
+  std::vector<size_t> writes;
+  uint32_t expected{0};
+  long fail_after_bytes{-1};
+  bool begun{false};
+  bool finished{false};
+  bool aborted{false};
+};
+
+OtaError FeedInChunks(OtaImageWriter& w, const Bytes& img, size_t chunk) {
+  for (size_t i = 0; i < img.size(); i += chunk) {
+    const OtaError e =
+        w.Feed(img.data() + i, std::min(chunk, img.size() - i));
+    if (e != OtaError::None) return e;
+  }
+  return w.Finish();
+}
+
+SelfTestItem Item(const char* name, bool passed) {
+  return SelfTestItem(name, passed, "x");
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CRC / LzssDecoder
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(OtaCrc32Test, MatchesZlibCheckValue) {
+  const char* s = "123456789";
+  EXPECT_EQ(Crc32(reinterpret_cast<const uint8_t*>(s), 9), 0xCBF43926u);
+  // Продолжение по частям = целиком
+  const uint32_t part = Crc32(reinterpret_cast<const uint8_t*>(s), 4);
+  EXPECT_EQ(Crc32(reinterpret_cast<const uint8_t*>(s) + 4, 5, part),
+            0xCBF43926u);
+}
+
+TEST(LzssDecoderTest, OverlappingReferenceRepeats) {
+  // флаги 0b0111: 3 литерала, затем ссылка offset 3, length 6
+  const Bytes in = {0x07, 'a', 'b', 'c', 0x02, 0x30};
+  Bytes out;
+  LzssDecoder d;
+  ASSERT_TRUE(
+      d.Feed(in.data(), in.size(), [&](uint8_t b) { out.push_back(b); }));
+  EXPECT_EQ(std::string(out.begin(), out.end()), "abcabcabc");
+  EXPECT_TRUE(d.AtItemBoundary());
+}
+
+TEST(LzssDecoderTest, ByteAtATimeMatchesWhole) {
+  const Bytes raw = MakeRaw(10000);
+  const Bytes packed = LzssCompress(raw);
+  Bytes out;
+  LzssDecoder d;
+  for (uint8_t b : packed) {
+    ASSERT_TRUE(d.Feed(&b, 1, [&](uint8_t v) { out.push_back(v); }));
+  }
+  EXPECT_EQ(out, raw);
+}
+
+TEST(LzssDecoderTest, ReferenceBeforeStartIsCorrupt) {
+  const Bytes in = {0x01, 'a', 0x05, 0x00};  // offset 6 при 1 байте вывода
+  LzssDecoder d;
+  EXPECT_FALSE(d.Feed(in.data(), in.size(), [](uint8_t) {}));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OtaImageWriter
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(OtaImageWriterTest, LzssRoundTripInSectorChunks) {
+  const Bytes raw = MakeRaw(3 * Cfg::kWriteChunkBytes + 100);
+  const Bytes img = Pack(raw, OtaCodec::Lzss);
+  ASSERT_LT(img.size(), raw.size());
+
+  MemorySink sink;
+  OtaImageWriter w(sink, Cfg::kMaxImageBytes);
+  EXPECT_EQ(FeedInChunks(w, img, 333), OtaError::None);
+  EXPECT_TRUE(sink.finished);
+  EXPECT_FALSE(sink.aborted);
+  EXPECT_EQ(sink.data, raw);
+  // Все порции, кроме последней, — ровно kWriteChunkBytes
+  ASSERT_EQ(sink.writes.size(), 4u);
+  for (size_t i = 0; i + 1 < sink.writes.size(); ++i) {
+    EXPECT_EQ(sink.writes[i], Cfg::kWriteChunkBytes);
+  }
+  EXPECT_EQ(w.RawWritten(), raw.size());
+}
+
+TEST(OtaImageWriterTest, StoreCodecRoundTrip) {
+  const Bytes raw = MakeRaw(5000);
+  MemorySink sink;
+  OtaImageWriter w(sink, Cfg::kMaxImageBytes);
+  EXPECT_EQ(FeedInChunks(w, Pack(raw, OtaCodec::Store), 1000), OtaError::None);
+  EXPECT_EQ(sink.data, raw);
+}
+
+TEST(OtaImageWriterTest, HeaderErrorsRejectedBeforeSinkBegin) {
+  const Bytes raw = MakeRaw(1000);
+  struct Case {
+    size_t offset;
+    uint8_t value;
+    OtaError expected;
+  };
+  for (const Case& c : {Case{0, 0x00, OtaError::BadMagic},
+                        Case{4, 0x02, OtaError::BadVersion},
+                        Case{8, 0xFF, OtaError::BadHeaderCrc}}) {
+    Bytes img = Pack(raw, OtaCodec::Lzss);
+    img[c.offset] = c.value;
+    MemorySink sink;
+    OtaImageWriter w(sink, Cfg::kMaxImageBytes);
+    EXPECT_EQ(w.Feed(img.data(), img.size()), c.expected);
+    EXPECT_FALSE(sink.begun);
+  }
+
+  MemorySink sink;
+  OtaImageWriter w(sink, 999);  // слот меньше образа
+  const Bytes img = Pack(raw, OtaCodec::Lzss);
+  EXPECT_EQ(w.Feed(img.data(), img.size()), OtaError::TooLarge);
+  EXPECT_FALSE(sink.begun);
+}
+
+TEST(OtaImageWriterTest, CorruptedPayloadFailsCrcAndAborts) {
+  const Bytes raw = MakeRaw(6000);
+  Bytes img = Pack(raw, OtaCodec::Store);
+  img[sizeof(OtaImageHeader) + 4321] ^= 0x40;
+  MemorySink sink;
+  OtaImageWriter w(sink, Cfg::kMaxImageBytes);
+  EXPECT_EQ(FeedInChunks(w, img, 512), OtaError::CrcMismatch);
+  EXPECT_TRUE(sink.aborted);
+  EXPECT_FALSE(sink.finished);
+}
+
+TEST(OtaImageWriterTest, TruncatedOrOversizedBodyIsSizeMismatch) {
+  const Bytes img = Pack(MakeRaw(6000), OtaCodec::Lzss);
+  {
+    MemorySink sink;
+    OtaImageWriter w(sink, Cfg::kMaxImageBytes);
+    const Bytes cut(img.begin(), img.end() - 7);
+    EXPECT_EQ(FeedInChunks(w, cut, 256), OtaError::SizeMismatch);
+    EXPECT_TRUE(sink.aborted);
+  }
+  {
+    MemorySink sink;
+    OtaImageWriter w(sink, Cfg::kMaxImageBytes);
+    Bytes longer = img;
+    longer.push_back(0);
+    EXPECT_EQ(FeedInChunks(w, longer, 256), OtaError::SizeMismatch);
+    EXPECT_FALSE(sink.finished);
+  }
+}
+
+TEST(OtaImageWriterTest, SinkWriteFailureStopsAndAborts) {
+  const Bytes img = Pack(MakeRaw(4 * Cfg::kWriteChunkBytes), OtaCodec::Lzss);
+  MemorySink sink;
+  sink.fail_after_bytes = static_cast<long>(Cfg::kWriteChunkBytes);
+  OtaImageWriter w(sink, Cfg::kMaxImageBytes);
+  EXPECT_EQ(FeedInChunks(w, img, 4096), OtaError::SinkFailed);
+  EXPECT_TRUE(sink.aborted);
+  EXPECT_EQ(sink.data.size(), Cfg::kWriteChunkBytes);
+}
+
+TEST(OtaImageWriterTest, AbortIsStickyAndCallsSinkAbort) {
+  const Bytes img = Pack(MakeRaw(2000), OtaCodec::Lzss);
+  MemorySink sink;
+  OtaImageWriter w(sink, Cfg::kMaxImageBytes);
+  ASSERT_EQ(w.Feed(img.data(), 100), OtaError::None);
+  w.Abort(OtaError::Moving);
+  EXPECT_TRUE(sink.aborted);
+  EXPECT_EQ(w.Feed(img.data() + 100, img.size() - 100), OtaError::Moving);
+  EXPECT_EQ(w.Finish(), OtaError::Moving);
+  EXPECT_FALSE(sink.finished);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OtaConfirmGuard
+// ═══════════════════════════════════════════════════════════════════════════
+
+/// Все обязательные проверки пройдены, остальные — как задано
+std::vector<SelfTestItem> RequiredPassed(bool others) {
+  std::vector<SelfTestItem> r;
+  for (const char* name : {"control_loop", "gyro_stable", "accel_1g",
+                           "madgwick_level", "ekf_zupt", "failsafe_inactive",
+                           "telemetry_log", "boot_time"}) {
+    r.push_back(Item(name, others));
+  }
+  for (const char* name : OtaConfirmGuard::kRequiredChecks) {
+    r.push_back(Item(name, true));
+  }
+  return r;
+}
+
+TEST(OtaConfirmGuardTest, RequiresExactlyWhitelistedChecks) {
+  const std::vector<std::string> expected = {
+      "imu_available", "control_loop_running", "pwm_ok", "calib_valid"};
+  ASSERT_EQ(std::size(OtaConfirmGuard::kRequiredChecks), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(OtaConfirmGuard::kRequiredChecks[i], expected[i]);
+  }
+
+  // Проверки среды (машину толкнули, цикл нагружен) не мешают
+  EXPECT_TRUE(OtaConfirmGuard::Passed(RequiredPassed(false)));
+  EXPECT_TRUE(OtaConfirmGuard::Passed(RequiredPassed(true)));
+
+  // Любая обязательная — провал; отсутствующая — тоже
+  for (const auto& name : expected) {
+    auto r = RequiredPassed(true);
+    for (auto& item : r) {
+      if (name == item.name) item.passed = false;
+    }
+    EXPECT_FALSE(OtaConfirmGuard::Passed(r)) << name;
+
+    std::erase_if(r, [&](const SelfTestItem& i) { return name == i.name; });
+    EXPECT_FALSE(OtaConfirmGuard::Passed(r)) << name;
+  }
+  EXPECT_FALSE(OtaConfirmGuard::Passed({}));
+}
+
+TEST(OtaConfirmGuardTest, SlowBootDoesNotRollBack) {
+  // Исправный образ на столе, загрузка дольше бюджета, пульт не подключён
+  SelfTestInput in;
+  in.loop_hz = 500;
+  in.imu_enabled = true;
+  in.accel_z_g = 1.0f;
+  in.failsafe_active = true;
+  in.calib_valid = true;
+  in.log_capacity = 5000;
+  in.boot_ms = config::DiagnosticsConfig::kBootBudgetMs + 100;
+  const auto results = SelfTest::Run(in);
+  EXPECT_TRUE(OtaConfirmGuard::Passed(results));
+
+  OtaConfirmGuard g;
+  EXPECT_EQ(g.Step(Cfg::kConfirmDelayMs, results),
+            OtaConfirmDecision::Valid);
+}
+
+TEST(OtaConfirmGuardTest, WaitsThenValidates) {
+  OtaConfirmGuard g;
+  EXPECT_FALSE(g.Due(Cfg::kConfirmDelayMs - 1));
+  ASSERT_TRUE(g.Due(Cfg::kConfirmDelayMs));
+  const uint32_t t0 = Cfg::kConfirmDelayMs;
+  EXPECT_EQ(g.Step(t0, {Item("imu_available", false)}),
+            OtaConfirmDecision::Wait);
+  EXPECT_FALSE(g.Due(t0 + Cfg::kConfirmRetryMs - 1));
+  ASSERT_TRUE(g.Due(t0 + Cfg::kConfirmRetryMs));
+  EXPECT_EQ(g.Step(t0 + Cfg::kConfirmRetryMs, RequiredPassed(false)),
+            OtaConfirmDecision::Valid);
+}
+
+TEST(OtaConfirmGuardTest, RollsBackAfterAllAttemptsFail) {
+  OtaConfirmGuard g;
+  OtaConfirmDecision d = OtaConfirmDecision::Wait;
+  uint32_t t = Cfg::kConfirmDelayMs;
+  for (uint8_t i = 0; i < Cfg::kConfirmAttempts; ++i) {
+    ASSERT_EQ(d, OtaConfirmDecision::Wait);
+    d = g.Step(t, {Item("pwm_ok", false)});
+    t += Cfg::kConfirmRetryMs;
+  }
+  EXPECT_EQ(d, OtaConfirmDecision::Rollback);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+#include "pc_profile.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+constexpr uint32_t kCtrlTask = 0x3FC9A000u;
+constexpr uint32_t kHttpdTask = 0x3FCA1000u;
+
+PcSample Sample(uint32_t task, uint8_t core,
+                std::initializer_list<uint32_t> pcs) {
+  PcSample s;
+  s.task = task;
+  s.core = core;
+  for (uint32_t pc : pcs) s.pcs[s.depth++] = pc;
+  return s;
+}
+
+std::vector<PcProfileEntry> Entries(const PcProfileTable& t) {
+  std::vector<PcProfileEntry> out;
+  t.ForEach([&](const PcProfileEntry& e) { out.push_back(e); });
+  return out;
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Агрегация
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(PcProfileTest, SameStackAccumulatesDistinctStacksSplit) {
+  PcProfileTable table;
+  ASSERT_TRUE(table.Init(64));
+
+  const PcSample madgwick = Sample(kCtrlTask, 1, {0x42001000u, 0x42002000u});
+  for (int i = 0; i < 5; ++i) ASSERT_TRUE(table.Record(madgwick));
+  // Тот же PC, другой вызывающий / задача / ядро / глубина — отдельно
+  ASSERT_TRUE(table.Record(Sample(kCtrlTask, 1, {0x42001000u, 0x42003000u})));
+  ASSERT_TRUE(table.Record(Sample(kHttpdTask, 1, {0x42001000u, 0x42002000u})));
+  ASSERT_TRUE(table.Record(Sample(kCtrlTask, 0, {0x42001000u, 0x42002000u})));
+  ASSERT_TRUE(table.Record(Sample(kCtrlTask, 1, {0x42001000u})));
+
+  EXPECT_EQ(table.Used(), 5u);
+  EXPECT_EQ(table.Samples(), 9u);
+  EXPECT_EQ(table.Dropped(), 0u);
+
+  uint32_t total = 0;
+  uint32_t madgwick_count = 0;
+  for (const PcProfileEntry& e : Entries(table)) {
+    total += e.count;
+    if (e.task == kCtrlTask && e.core == 1 && e.depth == 2 &&
+        e.pcs[1] == 0x42002000u) {
+      madgwick_count = e.count;
+      EXPECT_EQ(e.pcs[2], 0u);  // Хвост за depth обнулён
+    }
+  }
+  EXPECT_EQ(total, 9u);
+  EXPECT_EQ(madgwick_count, 5u);
+}
+
+TEST(PcProfileTest, IsrSampleWithoutStack) {
+  PcProfileTable table;
+  ASSERT_TRUE(table.Init(16));
+  ASSERT_TRUE(table.Record(Sample(0, 0, {})));
+  ASSERT_TRUE(table.Record(Sample(0, 0, {})));
+  const auto entries = Entries(table);
+  ASSERT_EQ(entries.size(), 1u);
+  EXPECT_EQ(entries[0].depth, 0u);
+  EXPECT_EQ(entries[0].count, 2u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Переполнение и ёмкость
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(PcProfileTest, FullTableDropsAndCounts) {
+  PcProfileTable table;
+  ASSERT_TRUE(table.Init(40));  // → 32
+  EXPECT_EQ(table.Capacity(), 32u);
+
+  size_t recorded = 0;
+  for (uint32_t i = 0; i < 100; ++i) {
+    if (table.Record(Sample(kCtrlTask, 0, {0x42000000u + 4 * i}))) {
+      ++recorded;
+    }
+  }
+  EXPECT_LE(table.Used(), table.Capacity());
+  EXPECT_EQ(table.Used(), recorded);
+  EXPECT_EQ(table.Samples() + table.Dropped(), 100u);
+  EXPECT_GT(table.Dropped(), 0u);
+
+  // Уже учтённый стек продолжает считаться и в полной таблице
+  const auto entries = Entries(table);
+  ASSERT_FALSE(entries.empty());
+  PcSample again = Sample(entries[0].task, entries[0].core,
+                          {entries[0].pcs[0]});
+  EXPECT_TRUE(table.Record(again));
+
+  table.Clear();
+  EXPECT_EQ(table.Used(), 0u);
+  EXPECT_EQ(table.Samples(), 0u);
+  EXPECT_EQ(table.Dropped(), 0u);
+  EXPECT_TRUE(Entries(table).empty());
+}
+
+TEST(PcProfileTest, InitRejectsTinyAndSecondCall) {
+  PcProfileTable table;
+  EXPECT_FALSE(table.Record(Sample(kCtrlTask, 0, {1})));
+  EXPECT_FALSE(table.Init(8));
+  ASSERT_TRUE(table.Init(16));
+  EXPECT_FALSE(table.Init(1024));
+  EXPECT_EQ(table.Capacity(), 16u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Имена задач и формат выгрузки
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(PcProfileTest, TaskNamesStoredOnceAndTruncated) {
+  PcProfileTable table;
+  ASSERT_TRUE(table.Init(16));
+  table.NoteTask(kCtrlTask, "vehicle_ctrl");
+  table.NoteTask(kCtrlTask, "renamed");
+  table.NoteTask(kHttpdTask, "a_very_long_task_name_here");
+  ASSERT_EQ(table.TaskCount(), 2u);
+  EXPECT_TRUE(table.HasTask(kHttpdTask));
+  EXPECT_STREQ(table.Task(0).name, "vehicle_ctrl");
+  EXPECT_EQ(std::strlen(table.Task(1).name), 15u);
+
+  for (uint32_t i = 0; i < 2 * PcProfileTable::kMaxTasks; ++i) {
+    table.NoteTask(0x3FD00000u + i, "t");
+  }
+  EXPECT_EQ(table.TaskCount(), PcProfileTable::kMaxTasks);
+}
+
+TEST(PcProfileTest, HeaderWireLayout) {
+  PcProfileHeader h;
+  uint8_t raw[sizeof(h)];
+  std::memcpy(raw, &h, sizeof(h));
+  EXPECT_EQ(std::memcmp(raw, "PCPF", 4), 0);
+  EXPECT_EQ(h.entry_size, 36u);
+  EXPECT_EQ(h.task_size, 20u);
+  EXPECT_EQ(h.max_depth, kPcProfileMaxDepth);
+  EXPECT_EQ(offsetof(PcProfileEntry, pcs), 12u);
+  EXPECT_EQ(offsetof(PcProfileHeader, max_depth), 32u);
+}
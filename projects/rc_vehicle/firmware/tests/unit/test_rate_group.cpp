@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "config.hpp"
+#include "rate_group.hpp"
+
+using namespace rc_vehicle;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PeriodicJob
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(PeriodicJobTest, FiresOncePerWindow) {
+  PeriodicJob job(10);
+  EXPECT_FALSE(job.Poll(0));
+  EXPECT_FALSE(job.Poll(8));
+  EXPECT_TRUE(job.Poll(10));
+  EXPECT_FALSE(job.Poll(10));
+  EXPECT_FALSE(job.Poll(18));
+  EXPECT_TRUE(job.Poll(20));
+}
+
+TEST(PeriodicJobTest, PhaseShiftsWindowBoundaries) {
+  PeriodicJob job(10, 4);
+  EXPECT_FALSE(job.Poll(2));
+  EXPECT_TRUE(job.Poll(4));
+  EXPECT_FALSE(job.Poll(12));
+  EXPECT_TRUE(job.Poll(14));
+}
+
+TEST(PeriodicJobTest, JitterDoesNotAccumulate) {
+  // Тик опоздал на 3 мс: следующее окно всё равно начинается в 20 мс,
+  // а не в 13 + 10
+  PeriodicJob job(10);
+  EXPECT_TRUE(job.Poll(13));
+  EXPECT_FALSE(job.Poll(18));
+  EXPECT_TRUE(job.Poll(20));
+}
+
+TEST(PeriodicJobTest, LongGapFiresOnce) {
+  PeriodicJob job(10);
+  EXPECT_TRUE(job.Poll(600));
+  EXPECT_FALSE(job.Poll(602));
+  EXPECT_TRUE(job.Poll(610));
+}
+
+TEST(PeriodicJobTest, StartTimeDelaysFirstFire) {
+  PeriodicJob job(20, 0, 1005);
+  EXPECT_FALSE(job.Poll(1010));
+  EXPECT_TRUE(job.Poll(1020));
+}
+
+TEST(PeriodicJobTest, RestartResetsWindow) {
+  PeriodicJob job(10);
+  EXPECT_TRUE(job.Poll(10));
+  job.Restart(15);
+  EXPECT_FALSE(job.Poll(15));
+  EXPECT_TRUE(job.Poll(20));
+}
+
+TEST(PeriodicJobTest, ZeroPeriodFiresOnEveryNewMs) {
+  PeriodicJob job(0);
+  EXPECT_EQ(job.PeriodMs(), 1u);
+  EXPECT_TRUE(job.Poll(1));
+  EXPECT_FALSE(job.Poll(1));
+  EXPECT_TRUE(job.Poll(2));
+}
+
+TEST(PeriodicJobTest, SurvivesTimerWrap) {
+  PeriodicJob job(10, 0, UINT32_MAX - 25);
+  int fired = 0;
+  for (uint32_t t = UINT32_MAX - 24, i = 0; i < 50; ++i, t += 2) {
+    if (job.Poll(t)) ++fired;
+  }
+  // 100 мс через переполнение: ~10 окон, без залпа
+  EXPECT_GE(fired, 9);
+  EXPECT_LE(fired, 11);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Расписание control loop (config::RateGroupConfig)
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(RateGroupScheduleTest, JobsNeverShareATick) {
+  using namespace config;
+  std::array<PeriodicJob, 7> jobs = {
+      PeriodicJob(PwmConfig::kUpdateIntervalMs, RateGroupConfig::kPwmPhaseMs),
+      PeriodicJob(RcInputConfig::kPollIntervalMs,
+                  RateGroupConfig::kRcPollPhaseMs),
+      PeriodicJob(ImuConfig::kMagReadIntervalMs, RateGroupConfig::kMagPhaseMs),
+      PeriodicJob(TelemetryConfig::kSendIntervalMs,
+                  RateGroupConfig::kWsTelemPhaseMs),
+      PeriodicJob(TelemetryLogConfig::kLogIntervalMs,
+                  RateGroupConfig::kLogPhaseMs),
+      PeriodicJob(DiagnosticsConfig::kIntervalMs,
+                  RateGroupConfig::kDiagPhaseMs),
+      PeriodicJob(SysIdConfig::kApplyIntervalMs,
+                  RateGroupConfig::kSysIdApplyPhaseMs),
+  };
+  std::array<uint32_t, 7> counts{};
+
+  constexpr uint32_t kDurationMs = 20000;
+  int max_per_tick = 0;
+  for (uint32_t t = ControlLoopConfig::kPeriodMs; t <= kDurationMs;
+       t += ControlLoopConfig::kPeriodMs) {
+    int fired = 0;
+    for (size_t j = 0; j < jobs.size(); ++j) {
+      if (jobs[j].Poll(t)) {
+        ++fired;
+        ++counts[j];
+      }
+    }
+    max_per_tick = std::max(max_per_tick, fired);
+  }
+
+  EXPECT_EQ(max_per_tick, 1);
+  // Фазы не меняют частоту: каждое задание срабатывает duration / period раз
+  for (size_t j = 0; j < jobs.size(); ++j) {
+    EXPECT_EQ(counts[j], kDurationMs / jobs[j].PeriodMs()) << "job " << j;
+  }
+}
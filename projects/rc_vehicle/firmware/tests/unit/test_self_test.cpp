@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include "config.hpp"
 #include "self_test.hpp"
 
 using rc_vehicle::SelfTest;
@@ -27,6 +28,7 @@ SelfTestInput MakeIdealInput() {
   in.calib_valid = true;
   in.log_capacity = 5000;
   in.pwm_status = 0;
+  in.boot_ms = 1200;
   return in;
 }
 
@@ -38,7 +40,7 @@ SelfTestInput MakeIdealInput() {
 
 TEST(SelfTestTest, AllPassOnIdealInput) {
   auto results = SelfTest::Run(MakeIdealInput());
-  ASSERT_EQ(results.size(), 10u);
+  ASSERT_EQ(results.size(), 12u);
   EXPECT_TRUE(SelfTest::AllPassed(results));
   for (const auto& r : results) {
     EXPECT_TRUE(r.passed) << "FAILED: " << r.name << " value=" << r.value;
@@ -184,6 +186,36 @@ TEST(SelfTestTest, AccelBoundary11) {
   EXPECT_TRUE(results[3].passed);
 }
 
+TEST(SelfTestTest, BootTimeOverBudgetWarnsButAllPassed) {
+  auto in = MakeIdealInput();
+  in.boot_ms = rc_vehicle::config::DiagnosticsConfig::kBootBudgetMs + 1;
+  auto results = SelfTest::Run(in);
+  EXPECT_STREQ(results[10].name, "boot_time");
+  EXPECT_FALSE(results[10].passed);
+  EXPECT_FALSE(results[10].fatal);
+  EXPECT_TRUE(SelfTest::AllPassed(results));
+}
+
+TEST(SelfTestTest, BootTimeNotMeasuredWarnsButAllPassed) {
+  auto in = MakeIdealInput();
+  in.boot_ms = 0;  // control loop ещё не тикнул
+  auto results = SelfTest::Run(in);
+  EXPECT_FALSE(results[10].passed);
+  EXPECT_TRUE(SelfTest::AllPassed(results));
+}
+
+TEST(SelfTestTest, ControlLoopRunningOutsideFrequencyWindow) {
+  auto in = MakeIdealInput();
+  in.loop_hz = 450;  // Цикл нагружен, но тикает
+  auto results = SelfTest::Run(in);
+  EXPECT_FALSE(results[0].passed);
+  EXPECT_STREQ(results[11].name, "control_loop_running");
+  EXPECT_TRUE(results[11].passed);
+
+  in.loop_hz = 0;
+  EXPECT_FALSE(SelfTest::Run(in)[11].passed);
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // Множественные ошибки
 // ═══════════════════════════════════════════════════════════════════════════
@@ -205,7 +237,7 @@ TEST(SelfTestTest, MultipleFailures) {
 
 TEST(SelfTestTest, ResultCount) {
   auto results = SelfTest::Run(MakeIdealInput());
-  EXPECT_EQ(results.size(), 10u);
+  EXPECT_EQ(results.size(), 12u);
 }
 
 TEST(SelfTestTest, ValueStringsNotEmpty) {
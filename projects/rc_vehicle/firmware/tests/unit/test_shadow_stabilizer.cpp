@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "config.hpp"
+#include "control_components.hpp"
+#include "imu_calibration.hpp"
+#include "madgwick_filter.hpp"
+#include "mock_platform.hpp"
+#include "shadow_stabilizer.hpp"
+#include "stabilization_config.hpp"
+#include "stabilization_pipeline.hpp"
+#include "vehicle_ekf.hpp"
+
+using namespace rc_vehicle;
+using namespace rc_vehicle::testing;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Fixture: живой YawRateController + shadow на тех же датчиках
+// ═══════════════════════════════════════════════════════════════════════════
+
+class ShadowStabilizerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Машина вращается: 30 dps, руль 0 → yaw PID даёт коррекцию
+    ImuData data{};
+    data.az = 1.0f;
+    data.gz = 30.0f;
+    platform_.SetImuData(data);
+    imu_handler_.SetEnabled(true);
+    for (int i = 0; i < 100; ++i) {
+      platform_.AdvanceTimeMs(2);
+      imu_handler_.Update(platform_.GetTimeMs(), 2);
+    }
+
+    live_cfg_.enabled = true;
+    live_cfg_.mode = DriveMode::Normal;
+    live_cfg_.yaw_rate.pid.kp = 0.005f;
+    live_cfg_.yaw_rate.pid.ki = 0.0f;
+    live_cfg_.yaw_rate.pid.kd = 0.0f;
+    live_cfg_.adaptive.enabled = false;
+    live_cfg_.pitch_comp.enabled = false;
+    live_yaw_.Init(live_cfg_, ekf_, &imu_handler_);
+
+    shadow_.Init(ekf_, madgwick_, &imu_handler_);
+  }
+
+  /// Тик: живой yaw-регулятор и shadow на одних входах; load — доля периода
+  ShadowStepInput Tick(float load_frac = 0.0f, uint32_t dt_ms = 2) {
+    now_ms_ += dt_ms;
+    float steering = 0.0f;
+    live_yaw_.Process(steering, 1.0f, 1.0f, dt_ms);
+
+    ShadowStepInput in;
+    in.in_throttle = 0.3f;
+    in.in_steering = 0.0f;
+    in.live_throttle = 0.3f;
+    in.live_steering = steering;
+    in.dt_ms = dt_ms;
+    in.now_ms = now_ms_;
+    in.loop_cycles = static_cast<uint32_t>(load_frac * kPeriodCycles);
+    shadow_.Step(in);
+    return in;
+  }
+
+  static constexpr float kPeriodCycles =
+      static_cast<float>(config::ControlLoopConfig::kPeriodMs) *
+      (static_cast<float>(kCycleCounterHz) / 1000.0f);
+
+  FakePlatform platform_;
+  ImuCalibration calib_;
+  MadgwickFilter madgwick_;
+  ImuHandler imu_handler_{platform_, calib_, madgwick_};
+  VehicleEkf ekf_;
+
+  StabilizationConfig live_cfg_;
+  YawRateController live_yaw_;
+  ShadowStabilizer shadow_;
+  uint32_t now_ms_{0};
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Кандидат и расхождение
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST_F(ShadowStabilizerTest, OffByDefault_NoCostNoFrameFields) {
+  Tick();
+  EXPECT_EQ(shadow_.GetState(), ShadowState::Off);
+  EXPECT_EQ(shadow_.LastCostCycles(), 0u);
+
+  TelemetryLogFrame frame;
+  shadow_.FillFrame(frame);
+  EXPECT_EQ(frame.shadow_state, 0);
+  EXPECT_FLOAT_EQ(frame.shadow_d_steering, 0.0f);
+}
+
+TEST_F(ShadowStabilizerTest, SameConfig_NoDivergence) {
+  ASSERT_TRUE(shadow_.SetCandidate(live_cfg_));
+  for (int i = 0; i < 50; ++i) Tick();
+
+  const ShadowStats st = shadow_.GetStats();
+  EXPECT_EQ(st.state, ShadowState::Running);
+  EXPECT_EQ(st.run_ticks, 50u);
+  EXPECT_LT(shadow_.GetSteering(), 0.0f) << "кандидат должен корректировать";
+  EXPECT_NEAR(st.max_abs_d_steering, 0.0f, 1e-6f);
+  EXPECT_NEAR(st.max_abs_d_throttle, 0.0f, 1e-6f);
+  EXPECT_GT(st.cost.count, 0u);
+}
+
+TEST_F(ShadowStabilizerTest, DifferentGains_DivergenceRecorded) {
+  StabilizationConfig candidate = live_cfg_;
+  candidate.yaw_rate.pid.kp = 0.01f;
+  ASSERT_TRUE(shadow_.SetCandidate(candidate));
+  ShadowStepInput in;
+  for (int i = 0; i < 20; ++i) in = Tick();
+
+  // Выход кандидата сильнее живого; вход стадии не изменён
+  EXPECT_LT(shadow_.GetSteering(), in.live_steering);
+  EXPECT_FLOAT_EQ(in.in_steering, 0.0f);
+
+  const ShadowStats st = shadow_.GetStats();
+  EXPECT_NEAR(st.last_d_steering, shadow_.GetSteering() - in.live_steering,
+              1e-6f);
+  EXPECT_GT(st.rms_d_steering, 0.0f);
+  EXPECT_GE(st.max_abs_d_steering, st.rms_d_steering);
+
+  TelemetryLogFrame frame;
+  shadow_.FillFrame(frame);
+  EXPECT_EQ(frame.shadow_state, static_cast<uint8_t>(ShadowState::Running));
+  EXPECT_FLOAT_EQ(frame.shadow_d_steering, st.last_d_steering);
+}
+
+TEST_F(ShadowStabilizerTest, DisabledCandidate_PassesInputsThrough) {
+  StabilizationConfig candidate = live_cfg_;
+  candidate.enabled = false;
+  ASSERT_TRUE(shadow_.SetCandidate(candidate));
+  const ShadowStepInput in = Tick();
+  EXPECT_FLOAT_EQ(shadow_.GetSteering(), in.in_steering);
+  EXPECT_FLOAT_EQ(shadow_.GetThrottle(), in.in_throttle);
+}
+
+TEST_F(ShadowStabilizerTest, InvalidCandidate_Rejected) {
+  StabilizationConfig candidate = live_cfg_;
+  candidate.magic = 0;
+  EXPECT_FALSE(shadow_.SetCandidate(candidate));
+  Tick();
+  EXPECT_EQ(shadow_.GetState(), ShadowState::Off);
+}
+
+TEST_F(ShadowStabilizerTest, Stop_ReturnsToOffAndClearsStats) {
+  ASSERT_TRUE(shadow_.SetCandidate(live_cfg_));
+  for (int i = 0; i < 5; ++i) Tick();
+  shadow_.Stop();
+  Tick();
+  EXPECT_EQ(shadow_.GetState(), ShadowState::Off);
+  EXPECT_EQ(shadow_.GetStats().run_ticks, 0u);
+  EXPECT_EQ(shadow_.LastCostCycles(), 0u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Бюджет CPU и сброс по нагрузке
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST_F(ShadowStabilizerTest, OverloadedLoop_ShedsAndResumesAfterHold) {
+  ASSERT_TRUE(shadow_.SetCandidate(live_cfg_));
+  Tick(0.1f);
+  ASSERT_EQ(shadow_.GetState(), ShadowState::Running);
+
+  // Цикл занимает весь период — стадия сбрасывается и не считается
+  for (int i = 0; i < 50; ++i) Tick(1.0f);
+  EXPECT_EQ(shadow_.GetState(), ShadowState::Shed);
+  EXPECT_EQ(shadow_.LastCostCycles(), 0u);
+  ShadowStats st = shadow_.GetStats();
+  EXPECT_EQ(st.shed_events, 1u);
+  EXPECT_GT(st.shed_ticks, 0u);
+  EXPECT_GT(st.loop_load_pct, config::ShadowConfig::kShedLoadPct);
+
+  // Нагрузка спала, но удержание ещё не истекло
+  for (int i = 0; i < 50; ++i) Tick(0.1f);
+  EXPECT_EQ(shadow_.GetState(), ShadowState::Shed);
+
+  const uint32_t ticks_to_hold = config::ShadowConfig::kShedHoldMs / 2;
+  for (uint32_t i = 0; i < ticks_to_hold; ++i) Tick(0.1f);
+  EXPECT_EQ(shadow_.GetState(), ShadowState::Running);
+  st = shadow_.GetStats();
+  EXPECT_EQ(st.shed_events, 1u);
+  EXPECT_GT(st.run_ticks, 1u);
+}
+
+TEST_F(ShadowStabilizerTest, CostOverBudget_Sheds) {
+  shadow_.SetBudget(/*cost_budget_permille=*/0, /*shed_load_pct=*/80);
+  ASSERT_TRUE(shadow_.SetCandidate(live_cfg_));
+  Tick();  // первый шаг меряет стоимость
+  EXPECT_GT(shadow_.LastCostCycles(), 0u);
+  Tick();
+  EXPECT_EQ(shadow_.GetState(), ShadowState::Shed);
+  EXPECT_EQ(shadow_.GetStats().shed_events, 1u);
+}
+
+TEST_F(ShadowStabilizerTest, CostOverBudget_ResumesAfterHoldAndRemeasures) {
+  shadow_.SetBudget(/*cost_budget_permille=*/0, /*shed_load_pct=*/80);
+  ASSERT_TRUE(shadow_.SetCandidate(live_cfg_));
+  Tick();
+  Tick();
+  ASSERT_EQ(shadow_.GetState(), ShadowState::Shed);
+
+  // По истечении удержания стадия возвращается и перемеряет стоимость
+  const uint32_t ticks_to_hold = config::ShadowConfig::kShedHoldMs / 2;
+  for (uint32_t i = 0; i <= ticks_to_hold; ++i) {
+    Tick();
+    if (shadow_.GetState() != ShadowState::Shed) break;
+  }
+  EXPECT_EQ(shadow_.GetState(), ShadowState::Running);
+  EXPECT_GT(shadow_.LastCostCycles(), 0u);
+
+  // Бюджет по-прежнему 0 — свежая стоимость снова сбрасывает стадию
+  Tick();
+  EXPECT_EQ(shadow_.GetState(), ShadowState::Shed);
+  EXPECT_EQ(shadow_.GetStats().shed_events, 2u);
+
+  // Бюджет поднят — после удержания стадия остаётся в работе
+  shadow_.SetBudget(/*cost_budget_permille=*/1000, /*shed_load_pct=*/80);
+  for (uint32_t i = 0; i <= ticks_to_hold + 10; ++i) Tick();
+  EXPECT_EQ(shadow_.GetState(), ShadowState::Running);
+  EXPECT_EQ(shadow_.GetStats().shed_events, 2u);
+}
+
+TEST_F(ShadowStabilizerTest, ZeroLoadDoesNotReseedAverage) {
+  ASSERT_TRUE(shadow_.SetCandidate(live_cfg_));
+  // Простаивающий цикл: среднее ровно 0, но уже засеяно
+  for (int i = 0; i < 10; ++i) Tick(0.0f);
+  ASSERT_EQ(shadow_.GetState(), ShadowState::Running);
+
+  // Одиночный всплеск сглаживается, а не становится средним целиком
+  Tick(1.0f);
+  Tick();
+  EXPECT_EQ(shadow_.GetState(), ShadowState::Running);
+  EXPECT_LT(shadow_.GetStats().loop_load_pct,
+            config::ShadowConfig::kShedLoadPct);
+}
+
+TEST_F(ShadowStabilizerTest, SkippedTick_Sheds) {
+  ASSERT_TRUE(shadow_.SetCandidate(live_cfg_));
+  Tick();
+  Tick(0.0f, 5 * config::ControlLoopConfig::kPeriodMs);
+  EXPECT_EQ(shadow_.GetState(), ShadowState::Shed);
+}
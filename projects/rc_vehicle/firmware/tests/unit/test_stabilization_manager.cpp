@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+
 #include "mock_platform.hpp"
 #include "stabilization_manager.hpp"
 
@@ -75,6 +78,53 @@ TEST_F(StabilizationManagerTest, SetConfig_NoSaveToNvs_DoesNotPersist) {
   EXPECT_FALSE(saved.has_value());
 }
 
+TEST_F(StabilizationManagerTest, SetSteerToYawRate_ChangesOnlyThatField) {
+  StabilizationConfig cfg;
+  cfg.Reset();
+  cfg.yaw_rate.pid.kp = 0.3f;
+  ASSERT_TRUE(mgr_->SetConfig(cfg, false));
+
+  mgr_->SetSteerToYawRate(123.0f);
+  auto read_back = mgr_->GetConfig();
+  EXPECT_FLOAT_EQ(read_back.yaw_rate.steer_to_yaw_rate_dps, 123.0f);
+  EXPECT_FLOAT_EQ(read_back.yaw_rate.pid.kp, 0.3f);
+  EXPECT_FLOAT_EQ(yaw_ctrl_.GetSteerToYawRate(), 123.0f);
+  EXPECT_FALSE(platform_.LoadStabilizationConfig().has_value());
+
+  mgr_->SetSteerToYawRate(1000.0f);  // Ограничение YawRateConfig::Clamp
+  EXPECT_FLOAT_EQ(mgr_->GetConfig().yaw_rate.steer_to_yaw_rate_dps, 360.0f);
+}
+
+TEST_F(StabilizationManagerTest, ConcurrentSetConfig_SurvivesSysIdUpdate) {
+  StabilizationConfig cfg;
+  cfg.Reset();
+  ASSERT_TRUE(mgr_->SetConfig(cfg, false));
+
+  // Цикл управления подтягивает коэффициент, httpd тем временем меняет kp
+  std::atomic<bool> stop{false};
+  std::thread loop([&] {
+    float k = 90.0f;
+    while (!stop.load()) {
+      k = k >= 100.0f ? 90.0f : k + 0.5f;
+      mgr_->SetSteerToYawRate(k);
+    }
+  });
+  StabilizationConfig user = cfg;
+  user.enabled = true;
+  for (int i = 0; i < 200; ++i) {
+    user.yaw_rate.pid.kp = 0.2f + 0.001f * static_cast<float>(i);
+    ASSERT_TRUE(mgr_->SetConfig(user, false));
+  }
+  stop.store(true);
+  loop.join();
+
+  // Последняя запись пользователя не откатана шагом sysid
+  auto read_back = mgr_->GetConfig();
+  EXPECT_FLOAT_EQ(read_back.yaw_rate.pid.kp, user.yaw_rate.pid.kp);
+  EXPECT_TRUE(read_back.enabled);
+  EXPECT_GE(read_back.yaw_rate.steer_to_yaw_rate_dps, 90.0f);
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // LoadFromNvs
 // ═══════════════════════════════════════════════════════════════════════════
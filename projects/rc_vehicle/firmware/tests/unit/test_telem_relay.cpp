@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "json_reader.hpp"
+#include "telem_relay.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+constexpr uint32_t kA = 1;
+constexpr uint32_t kB = 2;
+
+/// Разобрать JSON и вызвать fn(JsonValue); false — невалидный JSON
+template <typename Fn>
+bool WithJson(const std::string& text, Fn&& fn) {
+  std::string buf = text;
+  std::array<JsonToken, 256> tokens;
+  auto parsed = JsonParseInSitu(buf.data(), buf.size(), tokens);
+  if (!IsOk(parsed)) return false;
+  fn(GetValue(parsed));
+  return true;
+}
+
+std::string TelemText(uint32_t uptime_ms) {
+  TelemetryLogFrame f{};
+  f.ts_ms = uptime_ms;
+  f.ax = 0.5f;
+  f.pitch_deg = -2.25f;
+  f.speed_ms = 1.5f;
+  f.cmd_throttle = 0.25f;
+  return TelemFrameToJson(f);
+}
+
+size_t CountFor(const std::vector<RelayMessage>& out, uint32_t id) {
+  size_t n = 0;
+  for (const auto& m : out) n += m.client == id;
+  return n;
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Телеметрия: UDP-кадр → JSON, фильтр групп
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(TelemRelayTest, DecodesUdpPacketIncludingShortFrame) {
+  TelemetryLogFrame src{};
+  src.ts_ms = 1234;
+  src.gz = 12.5f;
+  src.shadow_d_steering = 0.75f;
+  std::vector<uint8_t> pkt = {'R', 'T', 1, 0x2A, 0, 0, 0};
+  pkt.resize(kUdpTelemHeaderSize + sizeof(src));
+  std::memcpy(pkt.data() + kUdpTelemHeaderSize, &src, sizeof(src));
+
+  uint32_t seq = 0;
+  TelemetryLogFrame f;
+  ASSERT_TRUE(DecodeUdpTelemPacket(pkt, seq, f));
+  EXPECT_EQ(seq, 42u);
+  EXPECT_EQ(f.ts_ms, 1234u);
+  EXPECT_EQ(f.gz, 12.5f);
+  EXPECT_EQ(f.shadow_d_steering, 0.75f);
+
+  // Старая прошивка: кадр без хвостовых полей — нули
+  pkt.resize(pkt.size() - 8);
+  ASSERT_TRUE(DecodeUdpTelemPacket(pkt, seq, f));
+  EXPECT_EQ(f.gz, 12.5f);
+  EXPECT_EQ(f.shadow_d_steering, 0.0f);
+
+  pkt[2] = 2;
+  EXPECT_FALSE(DecodeUdpTelemPacket(pkt, seq, f));
+  EXPECT_FALSE(DecodeUdpTelemPacket(std::span(pkt.data(), 6), seq, f));
+}
+
+TEST(TelemRelayTest, FrameJsonHasCarLayout) {
+  TelemetryLogFrame f{};
+  f.ts_ms = 777;
+  f.yaw_rate_dps = 3.5f;
+  f.roll_deg = -1.0f;
+  f.vy = std::numeric_limits<float>::quiet_NaN();
+  f.rc_steering = 0.5f;
+  const std::string text = TelemFrameToJson(f);
+  EXPECT_EQ(TelemJsonType(text), "telem");
+  ASSERT_TRUE(WithJson(text, [](const JsonValue& j) {
+    EXPECT_EQ(j["uptime_ms"].AsUint(), 777u);
+    EXPECT_EQ(j["imu"]["gyro_z_filtered"].AsFloat(), 3.5f);
+    EXPECT_EQ(j["imu"]["orientation"]["roll"].AsFloat(), -1.0f);
+    EXPECT_TRUE(j["ekf"]["vy"].IsNull());
+    EXPECT_EQ(j["rc"]["steering"].AsFloat(), 0.5f);
+    EXPECT_EQ(j["warn"]["oversteer"].AsBool(), false);
+    EXPECT_FALSE(j["mag"].Valid());     // Нет магнитометра
+    EXPECT_FALSE(j["shadow"].Valid());  // Нет кандидата
+  })) << text;
+
+  f.mz = 400.0f;
+  f.shadow_state = 2;
+  ASSERT_TRUE(WithJson(TelemFrameToJson(f), [](const JsonValue& j) {
+    EXPECT_EQ(j["mag"]["mz"].AsFloat(), 400.0f);
+    EXPECT_EQ(j["shadow"]["state"].AsUint(), 2u);
+  }));
+}
+
+TEST(TelemRelayTest, FilterKeepsScalarsAndSelectedGroups) {
+  const std::string text =
+      R"({ "type":"telem", "uptime_ms":5, "imu":{"ax":1,"s":"},{"},)"
+      R"( "ekf" : {"vx":2}, "arr":[1,{"a":[2]}], "ok":true })";
+  const std::vector<std::string> ch = {"ekf"};
+  const std::string out = FilterTelemJson(text, ch);
+  EXPECT_EQ(out, R"({"type":"telem","uptime_ms":5,"ekf":{"vx":2},"ok":true})");
+
+  const std::vector<std::string> two = {"imu", "arr"};
+  ASSERT_TRUE(WithJson(FilterTelemJson(text, two), [](const JsonValue& j) {
+    EXPECT_EQ(j["imu"]["s"].Str(), "},{");
+    EXPECT_EQ(j["arr"].Size(), 2u);
+    EXPECT_FALSE(j["ekf"].Valid());
+  }));
+
+  EXPECT_EQ(FilterTelemJson(text, {}), text);
+  EXPECT_EQ(FilterTelemJson("[1,2]", ch), "");
+  EXPECT_EQ(FilterTelemJson(R"({"a":{)", ch), "");
+  EXPECT_EQ(TelemJsonType(R"({"x":{"type":"no"},"type":"yes"})"), "yes");
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RelayHub
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(RelayHubTest, PerClientRateDecimatesUpstream) {
+  RelayHub hub({});
+  hub.AddClient(kA);
+  hub.AddClient(kB);
+  std::vector<RelayMessage> out;
+  EXPECT_EQ(hub.OnClientText(kB, R"({"type":"relay_subscribe","hz":10})", out),
+            RelayHub::ClientVerdict::Handled);
+  ASSERT_EQ(out.size(), 1u);
+  EXPECT_NE(out[0].text.find("\"hz\":10"), std::string::npos);
+  out.clear();
+
+  // 50 Гц от машины с джиттером ±2 мс, 2 с
+  uint64_t now = 1000;
+  for (int i = 0; i < 100; ++i) {
+    now += (i % 2) ? 18 : 22;
+    hub.OnUpstreamText(TelemText(static_cast<uint32_t>(now)), now, out);
+  }
+  EXPECT_EQ(CountFor(out, kA), 100u);  // Без подписки — каждый кадр
+  EXPECT_NEAR(static_cast<double>(CountFor(out, kB)), 20.0, 1.0);
+  EXPECT_EQ(hub.GetStats().telem_in, 100u);
+  EXPECT_EQ(hub.GetStats().telem_out, out.size());
+
+  // hz = частоте машины: джиттер не теряет кадры
+  out.clear();
+  hub.OnClientText(kB, R"({"type":"relay_subscribe","hz":50})", out);
+  out.clear();
+  for (int i = 0; i < 50; ++i) {
+    now += (i % 2) ? 19 : 21;
+    hub.OnUpstreamText(TelemText(0), now, out);
+  }
+  EXPECT_EQ(CountFor(out, kB), 50u);
+}
+
+TEST(RelayHubTest, ChannelSubscriptionFiltersTelem) {
+  RelayHub hub({});
+  hub.AddClient(kA);
+  std::vector<RelayMessage> out;
+  hub.OnClientText(
+      kA, R"({"type":"relay_subscribe","channels":["ekf","BAD!","cmd"]})",
+      out);
+  ASSERT_EQ(out.size(), 1u);
+  EXPECT_NE(out[0].text.find(R"("channels":["ekf","cmd"])"),
+            std::string::npos);
+  out.clear();
+
+  hub.OnUpstreamText(TelemText(9), 0, out);
+  ASSERT_EQ(out.size(), 1u);
+  ASSERT_TRUE(WithJson(out[0].text, [](const JsonValue& j) {
+    EXPECT_EQ(j["uptime_ms"].AsUint(), 9u);
+    EXPECT_EQ(j["ekf"]["speed_ms"].AsFloat(), 1.5f);
+    EXPECT_EQ(j["cmd"]["throttle"].AsFloat(), 0.25f);
+    EXPECT_FALSE(j["imu"].Valid());
+  }));
+}
+
+TEST(RelayHubTest, OnlyAuthorisedControllerForwardsCommands) {
+  RelayConfig cfg;
+  cfg.control_token = "s3cret";
+  RelayHub hub(cfg);
+  hub.AddClient(kA);
+  hub.AddClient(kB);
+  std::vector<RelayMessage> out;
+  const std::string cmd = R"({"type":"cmd","throttle":0.3,"steering":0})";
+
+  EXPECT_EQ(hub.OnClientText(kA, cmd, out), RelayHub::ClientVerdict::Handled);
+  EXPECT_NE(out.back().text.find("not_controller"), std::string::npos);
+
+  hub.OnClientText(kA, R"({"type":"relay_control","token":"nope"})", out);
+  EXPECT_NE(out.back().text.find("bad_token"), std::string::npos);
+  hub.OnClientText(kA, R"({"type":"relay_control","token":"s3cret"})", out);
+  EXPECT_NE(out.back().text.find("\"ok\":true"), std::string::npos);
+  EXPECT_EQ(hub.Controller(), kA);
+  hub.OnClientText(kB, R"({"type":"relay_control","token":"s3cret"})", out);
+  EXPECT_NE(out.back().text.find("busy"), std::string::npos);
+
+  EXPECT_EQ(hub.OnClientText(kA, cmd, out), RelayHub::ClientVerdict::Forward);
+  EXPECT_EQ(hub.OnClientText(kB, cmd, out), RelayHub::ClientVerdict::Handled);
+  EXPECT_EQ(hub.GetStats().cmd_forwarded, 1u);
+  EXPECT_EQ(hub.GetStats().cmd_rejected, 2u);
+
+  // Ответы машины (не telem) — только управляющему
+  out.clear();
+  hub.OnUpstreamText(R"({"type":"ack","ok":true})", 0, out);
+  ASSERT_EQ(out.size(), 1u);
+  EXPECT_EQ(out[0].client, kA);
+
+  // Отключение управляющего освобождает управление
+  hub.RemoveClient(kA);
+  EXPECT_FALSE(hub.HasController());
+  out.clear();
+  hub.OnUpstreamText(R"({"type":"ack"})", 0, out);
+  EXPECT_TRUE(out.empty());
+  hub.OnClientText(kB, R"({"type":"relay_control","token":"s3cret"})", out);
+  EXPECT_EQ(hub.Controller(), kB);
+  hub.OnClientText(kB, R"({"type":"relay_release"})", out);
+  EXPECT_FALSE(hub.HasController());
+}
+
+TEST(RelayHubTest, ControlDisabledWithoutTokenAndStatusReply) {
+  RelayHub hub({});
+  hub.AddClient(kA);
+  hub.SetUpstreamState("udp", true);
+  std::vector<RelayMessage> out;
+  hub.OnClientText(kA, R"({"type":"relay_control","token":""})", out);
+  EXPECT_NE(out.back().text.find("control_disabled"), std::string::npos);
+  EXPECT_FALSE(hub.HasController());
+
+  hub.OnClientText(kA, "not json", out);
+  EXPECT_NE(out.back().text.find("bad_json"), std::string::npos);
+  hub.OnClientText(kA, R"({"type":"relay_nope"})", out);
+  EXPECT_NE(out.back().text.find("unknown_relay_command"), std::string::npos);
+
+  hub.OnClientText(kA, R"({"type":"relay_status"})", out);
+  ASSERT_TRUE(WithJson(out.back().text, [](const JsonValue& j) {
+    EXPECT_EQ(j["type"].Str(), "relay_status");
+    EXPECT_EQ(j["upstream"].Str(), "udp");
+    EXPECT_EQ(j["upstream_ok"].AsBool(), true);
+    EXPECT_EQ(j["clients"].AsUint(), 1u);
+    EXPECT_EQ(j["you_control"].AsBool(), false);
+  }));
+}
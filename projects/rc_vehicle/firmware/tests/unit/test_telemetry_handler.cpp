@@ -23,8 +23,8 @@ class TelemetryHandlerTest : public ::testing::Test {
     TelemetrySnapshot snap{};
     snap.rc_ok = true;
     snap.wifi_ok = false;
-    snap.throttle = 0.5f;
-    snap.steering = -0.3f;
+    snap.frame.throttle = 0.5f;
+    snap.frame.steering = -0.3f;
     return snap;
   }
 
@@ -106,11 +106,11 @@ TEST_F(TelemetryHandlerTest, JsonContainsLinkStatus) {
 TEST_F(TelemetryHandlerTest, JsonContainsImu_WhenEnabled) {
   auto snap = MakeSnap();
   snap.imu_enabled = true;
-  snap.imu_data.ax = 0.01f;
-  snap.imu_data.ay = 0.02f;
-  snap.imu_data.az = 9.81f;
-  snap.pitch_deg = 5.0f;
-  snap.roll_deg = -2.0f;
+  snap.frame.ax = 0.01f;
+  snap.frame.ay = 0.02f;
+  snap.frame.az = 9.81f;
+  snap.frame.pitch_deg = 5.0f;
+  snap.frame.roll_deg = -2.0f;
 
   handler_->SendTelemetry(50, snap);
   cJSON* root = cJSON_Parse(platform_.GetLastTelem().c_str());
@@ -145,9 +145,9 @@ TEST_F(TelemetryHandlerTest, JsonContainsEkf_WhenAvailable) {
   auto snap = MakeSnap();
   snap.imu_enabled = true;
   snap.ekf_available = true;
-  snap.ekf_vx = 1.5f;
-  snap.ekf_vy = 0.1f;
-  snap.ekf_speed_ms = 1.503f;
+  snap.frame.vx = 1.5f;
+  snap.frame.vy = 0.1f;
+  snap.frame.speed_ms = 1.503f;
 
   handler_->SendTelemetry(50, snap);
   cJSON* root = cJSON_Parse(platform_.GetLastTelem().c_str());
@@ -178,3 +178,41 @@ TEST_F(TelemetryHandlerTest, JsonContainsKidsMode) {
 
   cJSON_Delete(root);
 }
+
+TEST_F(TelemetryHandlerTest, JsonGroupsUseRegistryKeys) {
+  auto snap = MakeSnap();
+  snap.imu_enabled = true;
+  snap.frame.ts_ms = 1234;
+  snap.frame.yaw_rate_dps = 42.0f;
+  snap.frame.rc_throttle = 0.7f;
+  snap.frame.cmd_steering = 0.25f;
+  snap.frame.oversteer_active = 1.0f;
+  snap.oversteer_available = true;
+
+  handler_->SendTelemetry(50, snap);
+  cJSON* root = cJSON_Parse(platform_.GetLastTelem().c_str());
+  ASSERT_NE(root, nullptr);
+
+  EXPECT_EQ(cJSON_GetObjectItem(root, "uptime_ms")->valueint, 1234);
+  cJSON* imu = cJSON_GetObjectItem(root, "imu");
+  ASSERT_NE(imu, nullptr);
+  EXPECT_NEAR(cJSON_GetObjectItem(imu, "gyro_z_filtered")->valuedouble, 42.0,
+              1e-6);
+  EXPECT_EQ(cJSON_GetObjectItem(imu, "yaw_rate_dps"), nullptr);
+  EXPECT_NEAR(
+      cJSON_GetObjectItem(cJSON_GetObjectItem(root, "rc"), "throttle")
+          ->valuedouble,
+      0.7, 1e-6);
+  EXPECT_NEAR(
+      cJSON_GetObjectItem(cJSON_GetObjectItem(root, "cmd"), "steering")
+          ->valuedouble,
+      0.25, 1e-6);
+  EXPECT_NEAR(
+      cJSON_GetObjectItem(cJSON_GetObjectItem(root, "act"), "throttle")
+          ->valuedouble,
+      0.5, 1e-6);
+  EXPECT_TRUE(cJSON_IsTrue(
+      cJSON_GetObjectItem(cJSON_GetObjectItem(root, "warn"), "oversteer")));
+
+  cJSON_Delete(root);
+}
@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <cJSON.h>
+
+#include <cstring>
+
+#include "telemetry_json.hpp"
 #include "telemetry_log.hpp"
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -156,3 +161,203 @@ TEST(TelemetryLogTest, Clear_ThenPush_Works) {
   ASSERT_TRUE(log.GetFrame(0, out));
   EXPECT_EQ(out.ts_ms, 42u);
 }
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ReadSince (курсор seq)
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+void PushTs(TelemetryLog& log, uint32_t from, uint32_t to) {
+  TelemetryLogFrame frame;
+  for (uint32_t ts = from; ts < to; ++ts) {
+    frame.ts_ms = ts;
+    log.Push(frame);
+  }
+}
+
+}  // namespace
+
+TEST(TelemetryLogTest, ReadSince_DeltaAfterCursor) {
+  TelemetryLog log;
+  ASSERT_TRUE(log.Init(8));
+  PushTs(log, 0, 5);  // seq = ts
+
+  TelemetryLogFrame out[8];
+  rc_vehicle::TelemetryLogSpan span = log.ReadSince(0, out, 8);
+  EXPECT_EQ(span.first_seq, 0u);
+  EXPECT_EQ(span.head_seq, 5u);
+  EXPECT_EQ(span.count, 5u);
+  EXPECT_EQ(span.dropped, 0u);
+
+  PushTs(log, 5, 7);
+  span = log.ReadSince(5, out, 8);
+  ASSERT_EQ(span.count, 2u);
+  EXPECT_EQ(out[0].ts_ms, 5u);
+  EXPECT_EQ(out[1].ts_ms, 6u);
+
+  // Курсор на head — пусто
+  EXPECT_EQ(log.ReadSince(7, out, 8).count, 0u);
+}
+
+TEST(TelemetryLogTest, ReadSince_WrappedRing_ContiguousAcrossEnd) {
+  TelemetryLog log;
+  ASSERT_TRUE(log.Init(4));
+  PushTs(log, 0, 6);  // в кольце seq 2..5, физически разорваны
+
+  TelemetryLogFrame out[4];
+  const rc_vehicle::TelemetryLogSpan span = log.ReadSince(3, out, 4);
+  ASSERT_EQ(span.count, 3u);
+  EXPECT_EQ(out[0].ts_ms, 3u);
+  EXPECT_EQ(out[2].ts_ms, 5u);
+}
+
+TEST(TelemetryLogTest, ReadSince_OverwrittenRange_ReportsGap) {
+  TelemetryLog log;
+  ASSERT_TRUE(log.Init(4));
+  PushTs(log, 0, 10);  // в кольце seq 6..9
+
+  TelemetryLogFrame out[4];
+  rc_vehicle::TelemetryLogSpan span = log.ReadSince(2, out, 4);
+  EXPECT_EQ(span.first_seq, 6u);
+  EXPECT_EQ(span.dropped, 4u);
+  ASSERT_EQ(span.count, 4u);
+  EXPECT_EQ(out[0].ts_ms, 6u);
+
+  // gap_skip: начать новее oldest, пропущенное тоже считается в dropped
+  span = log.ReadSince(2, out, 4, /*gap_skip=*/3);
+  EXPECT_EQ(span.first_seq, 9u);
+  EXPECT_EQ(span.dropped, 7u);
+  EXPECT_EQ(span.count, 1u);
+
+  const rc_vehicle::TelemetryLogSinceHeader h =
+      rc_vehicle::MakeLogSinceHeader(span, 1);
+  EXPECT_EQ(h.next_seq, 10u);
+  EXPECT_TRUE(h.flags & rc_vehicle::kLogSinceGap);
+}
+
+TEST(TelemetryLogTest, ReadSince_MaxFramesLimitsBatch) {
+  TelemetryLog log;
+  ASSERT_TRUE(log.Init(16));
+  PushTs(log, 0, 10);
+
+  TelemetryLogFrame out[3];
+  const rc_vehicle::TelemetryLogSpan span = log.ReadSince(1, out, 3);
+  EXPECT_EQ(span.count, 3u);
+  EXPECT_EQ(span.head_seq, 10u);
+  EXPECT_EQ(out[2].ts_ms, 3u);
+}
+
+TEST(TelemetryLogTest, ReadSince_SeqSurvivesClear) {
+  TelemetryLog log;
+  ASSERT_TRUE(log.Init(8));
+  PushTs(log, 0, 5);
+  log.Clear();
+  EXPECT_EQ(log.HeadSeq(), 5u);
+  PushTs(log, 100, 102);
+
+  TelemetryLogFrame out[8];
+  // Очищенные кадры 3, 4 — разрыв, новые получают seq 5, 6
+  const rc_vehicle::TelemetryLogSpan span = log.ReadSince(3, out, 8);
+  EXPECT_EQ(span.first_seq, 5u);
+  EXPECT_EQ(span.dropped, 2u);
+  ASSERT_EQ(span.count, 2u);
+  EXPECT_EQ(out[0].ts_ms, 100u);
+
+  // Кольцо не полно — писатель не догонит, gap_skip не применяется
+  EXPECT_EQ(log.ReadSince(3, out, 8, /*gap_skip=*/4).first_seq, 5u);
+}
+
+TEST(TelemetryLogTest, ReadSince_CursorAhead_ResetFromOldest) {
+  TelemetryLog log;
+  ASSERT_TRUE(log.Init(8));
+  PushTs(log, 0, 3);
+
+  // Курсор от прошлой загрузки устройства
+  TelemetryLogFrame out[8];
+  const rc_vehicle::TelemetryLogSpan span = log.ReadSince(1000, out, 8);
+  EXPECT_TRUE(span.cursor_ahead);
+  EXPECT_EQ(span.first_seq, 0u);
+  EXPECT_EQ(span.count, 3u);
+  EXPECT_TRUE(rc_vehicle::MakeLogSinceHeader(span, 3).flags &
+              rc_vehicle::kLogSinceReset);
+}
+
+TEST(TelemetryLogTest, ReadSince_CursorAhead_GapSkipKeepsNewSession) {
+  TelemetryLog log;
+  ASSERT_TRUE(log.Init(64));
+  PushTs(log, 0, 10);
+
+  // После перезагрузки начало новой сессии не теряется (как на устройстве,
+  // gap_skip = kSinceGapSkipFrames)
+  TelemetryLogFrame out[16];
+  const rc_vehicle::TelemetryLogSpan span =
+      log.ReadSince(5000, out, 16, /*gap_skip=*/500);
+  EXPECT_TRUE(span.cursor_ahead);
+  EXPECT_EQ(span.first_seq, 0u);
+  EXPECT_EQ(span.dropped, 0u);
+  ASSERT_EQ(span.count, 10u);
+  EXPECT_EQ(out[0].ts_ms, 0u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Реестр полей (RC_TELEMETRY_LOG_FIELDS)
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(TelemetryLogSchemaTest, FieldsAreContiguousAndCoverFrame) {
+  using rc_vehicle::TelemetryFieldType;
+  ASSERT_EQ(rc_vehicle::kTelemetryLogFieldCount, 37u);
+  size_t expected_offset = 0;
+  for (const auto& f : rc_vehicle::kTelemetryLogFields) {
+    EXPECT_EQ(f.offset, expected_offset) << f.name;
+    expected_offset += (f.type == TelemetryFieldType::U8) ? 1 : 4;
+  }
+  // Без хвостового выравнивания: uint8_t-поля заполняют слот до float
+  EXPECT_EQ(expected_offset, sizeof(TelemetryLogFrame));
+  EXPECT_STREQ(rc_vehicle::kTelemetryLogFields[0].name, "ts_ms");
+  EXPECT_STREQ(
+      rc_vehicle::kTelemetryLogFields[rc_vehicle::kTelemetryLogFieldCount - 1]
+          .name,
+      "shadow_d_steering");
+}
+
+TEST(TelemetryLogSchemaTest, FrameJsonHasEveryField) {
+  TelemetryLogFrame frame;
+  frame.ts_ms = 77;
+  frame.heading_rel_deg = -3.5f;
+  frame.test_marker = 2;
+
+  cJSON* obj = cJSON_CreateObject();
+  rc_vehicle::AddLogFrameToJson(obj, frame);
+  for (const auto& f : rc_vehicle::kTelemetryLogFields) {
+    EXPECT_NE(cJSON_GetObjectItem(obj, f.name), nullptr) << f.name;
+  }
+  EXPECT_EQ(cJSON_GetObjectItem(obj, "ts_ms")->valueint, 77);
+  EXPECT_NEAR(cJSON_GetObjectItem(obj, "heading_rel_deg")->valuedouble, -3.5,
+              1e-6);
+  EXPECT_EQ(cJSON_GetObjectItem(obj, "test_marker")->valueint, 2);
+  cJSON_Delete(obj);
+}
+
+TEST(TelemetryLogSchemaTest, SchemaJsonDescribesFrame) {
+  cJSON* schema = rc_vehicle::BuildLogSchemaJson();
+  ASSERT_NE(schema, nullptr);
+  EXPECT_EQ(cJSON_GetObjectItem(schema, "frame_size")->valueint,
+            static_cast<int>(sizeof(TelemetryLogFrame)));
+  cJSON* fields = cJSON_GetObjectItem(schema, "fields");
+  ASSERT_EQ(cJSON_GetArraySize(fields),
+            static_cast<int>(rc_vehicle::kTelemetryLogFieldCount));
+  cJSON* marker = nullptr;
+  cJSON* f = nullptr;
+  cJSON_ArrayForEach(f, fields) {
+    if (std::strcmp(cJSON_GetObjectItem(f, "name")->valuestring,
+                    "test_marker") == 0) {
+      marker = f;
+    }
+  }
+  ASSERT_NE(marker, nullptr);
+  EXPECT_STREQ(cJSON_GetObjectItem(marker, "type")->valuestring, "u8");
+  EXPECT_EQ(cJSON_GetObjectItem(marker, "offset")->valueint,
+            static_cast<int>(offsetof(TelemetryLogFrame, test_marker)));
+  cJSON_Delete(schema);
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "telemetry_log_decoder.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+void AppendU32(std::vector<uint8_t>& buf, uint32_t v) {
+  const auto* p = reinterpret_cast<const uint8_t*>(&v);
+  buf.insert(buf.end(), p, p + sizeof(v));
+}
+
+template <typename T>
+void AppendRaw(std::vector<uint8_t>& buf, const T& v, size_t size = sizeof(T)) {
+  const auto* p = reinterpret_cast<const uint8_t*>(&v);
+  buf.insert(buf.end(), p, p + size);
+}
+
+/// Собрать лог в формате log_bin_handler
+std::vector<uint8_t> BuildLog(const std::vector<TelemetryLogFrame>& frames,
+                              const std::vector<TelemetryEvent>& events,
+                              bool with_events = true) {
+  std::vector<uint8_t> buf;
+  AppendU32(buf, static_cast<uint32_t>(frames.size()));
+  AppendU32(buf, sizeof(TelemetryLogFrame));
+  for (const auto& f : frames) AppendRaw(buf, f);
+  if (with_events) {
+    AppendU32(buf, static_cast<uint32_t>(events.size()));
+    AppendU32(buf, sizeof(TelemetryEvent));
+    for (const auto& e : events) AppendRaw(buf, e);
+  }
+  return buf;
+}
+
+TelemetryLogFrame MakeFrame(uint32_t ts) {
+  TelemetryLogFrame f{};
+  f.ts_ms = ts;
+  f.gz = static_cast<float>(ts) * 0.5f;
+  f.heading_rel_deg = -12.5f;
+  f.test_marker = 3;
+  return f;
+}
+
+}  // namespace
+
+TEST(TelemetryLogDecoderTest, DecodesFramesAndEvents) {
+  TelemetryEvent ev{};
+  ev.ts_ms = 20;
+  ev.type = TelemetryEventType::TestStart;
+  ev.param = 2;
+  ev.value1 = 0.1f;
+
+  const auto buf = BuildLog({MakeFrame(10), MakeFrame(20)}, {ev});
+  DecodedLog log;
+  ASSERT_EQ(DecodeLogBin(buf.data(), buf.size(), log), LogDecodeError::None);
+
+  ASSERT_EQ(log.frames.size(), 2u);
+  EXPECT_EQ(log.frames[1].ts_ms, 20u);
+  EXPECT_FLOAT_EQ(log.frames[1].gz, 10.0f);
+  EXPECT_FLOAT_EQ(log.frames[1].heading_rel_deg, -12.5f);
+  EXPECT_EQ(log.frames[1].test_marker, 3);
+  EXPECT_EQ(log.source_frame_size, sizeof(TelemetryLogFrame));
+
+  ASSERT_EQ(log.events.size(), 1u);
+  EXPECT_EQ(log.events[0].type, TelemetryEventType::TestStart);
+  EXPECT_EQ(log.events[0].param, 2);
+  EXPECT_FLOAT_EQ(log.events[0].value1, 0.1f);
+}
+
+TEST(TelemetryLogDecoderTest, MissingEventSectionIsAccepted) {
+  const auto buf = BuildLog({MakeFrame(1)}, {}, false);
+  DecodedLog log;
+  EXPECT_EQ(DecodeLogBin(buf.data(), buf.size(), log), LogDecodeError::None);
+  EXPECT_EQ(log.frames.size(), 1u);
+  EXPECT_TRUE(log.events.empty());
+}
+
+TEST(TelemetryLogDecoderTest, ShorterFramesFromOlderFirmwareZeroFillTail) {
+  // Старая прошивка: кадр 80 байт (ts_ms + 19 float)
+  constexpr uint32_t kOldFrameSize = 80;
+  std::vector<uint8_t> buf;
+  AppendU32(buf, 1);
+  AppendU32(buf, kOldFrameSize);
+  TelemetryLogFrame f = MakeFrame(42);
+  AppendRaw(buf, f, kOldFrameSize);
+
+  DecodedLog log;
+  ASSERT_EQ(DecodeLogBin(buf.data(), buf.size(), log), LogDecodeError::None);
+  ASSERT_EQ(log.frames.size(), 1u);
+  EXPECT_EQ(log.frames[0].ts_ms, 42u);
+  EXPECT_FLOAT_EQ(log.frames[0].gz, 21.0f);
+  EXPECT_FLOAT_EQ(log.frames[0].heading_rel_deg, 0.0f);
+  EXPECT_EQ(log.frames[0].test_marker, 0);
+  EXPECT_EQ(log.source_frame_size, kOldFrameSize);
+}
+
+TEST(TelemetryLogDecoderTest, TruncatedFramesAreRejected) {
+  auto buf = BuildLog({MakeFrame(1), MakeFrame(2)}, {});
+  buf.resize(8 + sizeof(TelemetryLogFrame) + 10);
+  DecodedLog log;
+  EXPECT_EQ(DecodeLogBin(buf.data(), buf.size(), log),
+            LogDecodeError::Truncated);
+  EXPECT_TRUE(log.frames.empty());
+}
+
+TEST(TelemetryLogDecoderTest, HugeFrameCountDoesNotOverflow) {
+  std::vector<uint8_t> buf;
+  AppendU32(buf, 0xFFFFFFFFu);
+  AppendU32(buf, 0xFFFFFFFFu);
+  DecodedLog log;
+  EXPECT_EQ(DecodeLogBin(buf.data(), buf.size(), log),
+            LogDecodeError::Truncated);
+}
+
+TEST(TelemetryLogDecoderTest, ZeroFrameSizeIsRejected) {
+  std::vector<uint8_t> buf;
+  AppendU32(buf, 5);
+  AppendU32(buf, 0);
+  DecodedLog log;
+  EXPECT_EQ(DecodeLogBin(buf.data(), buf.size(), log),
+            LogDecodeError::BadFrameSize);
+}
+
+TEST(TelemetryLogDecoderTest, EmptyInputIsTruncated) {
+  DecodedLog log;
+  EXPECT_EQ(DecodeLogBin(nullptr, 0, log), LogDecodeError::Truncated);
+  EXPECT_STREQ(LogDecodeErrorToString(LogDecodeError::Truncated),
+               "truncated log");
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DecodeLogSince
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(TelemetryLogDecoderTest, LogSince_RoundTripFromRing) {
+  TelemetryLog ring;
+  ASSERT_TRUE(ring.Init(4));
+  for (uint32_t ts = 1; ts <= 6; ++ts) ring.Push(MakeFrame(ts));
+
+  TelemetryLogFrame frames[4];
+  const TelemetryLogSpan span = ring.ReadSince(1, frames, 4);
+  const TelemetryLogSinceHeader h =
+      MakeLogSinceHeader(span, static_cast<uint32_t>(span.count));
+  std::vector<uint8_t> buf;
+  AppendRaw(buf, h);
+  for (size_t i = 0; i < span.count; ++i) AppendRaw(buf, frames[i]);
+
+  DecodedLogSince d;
+  ASSERT_EQ(DecodeLogSince(buf.data(), buf.size(), d), LogDecodeError::None);
+  EXPECT_EQ(d.header.first_seq, 2u);
+  EXPECT_EQ(d.header.next_seq, 6u);
+  EXPECT_EQ(d.header.dropped, 1u);
+  EXPECT_TRUE(d.header.flags & kLogSinceGap);
+  ASSERT_EQ(d.frames.size(), 4u);
+  EXPECT_EQ(d.frames[0].ts_ms, 3u);
+  EXPECT_FLOAT_EQ(d.frames[3].gz, 3.0f);
+}
+
+TEST(TelemetryLogDecoderTest, LogSince_RejectsForeignPayload) {
+  const auto log_bin = BuildLog({MakeFrame(1), MakeFrame(2)}, {});
+  DecodedLogSince d;
+  EXPECT_EQ(DecodeLogSince(log_bin.data(), log_bin.size(), d),
+            LogDecodeError::BadMagic);
+
+  TelemetryLogSinceHeader h;
+  h.frame_count = 3;  // кадров в буфере нет
+  std::vector<uint8_t> buf;
+  AppendRaw(buf, h);
+  EXPECT_EQ(DecodeLogSince(buf.data(), buf.size(), d),
+            LogDecodeError::Truncated);
+}
@@ -566,5 +566,54 @@ TEST_F(TestRunnerTest, GetStatus_PhaseElapsedResetOnTransition) {
   EXPECT_GE(s.phase_elapsed_sec, 0.0f);
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// 20. Result (потоковые метрики манёвра)
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST_F(TestRunnerTest, StepTest_Result_StepMetricsFromStreamedYawRate) {
+  runner.Start(MakeStep(0.8f));
+  float throttle = 0.0f, steering = 0.0f;
+  RunAccelPhase(throttle, steering);
+  ASSERT_EQ(runner.GetPhase(), Phase::Cruise);
+
+  // Первый порядок на yaw rate: 0 → 90 dps, τ = 0.1 с
+  float gz = 0.0f;
+  int guard = 0;
+  while (runner.GetPhase() != Phase::Brake && ++guard < 5000) {
+    if (runner.GetPhase() == Phase::StepExec) gz += kDt / 0.1f * (90.0f - gz);
+    runner.Update(0.0f, 0.5f, gz, kDt, throttle, steering, 2.0f, 3.0f);
+  }
+  ASSERT_EQ(runner.GetPhase(), Phase::Brake);
+
+  const TestRunner::Result& r = runner.GetResult();
+  EXPECT_TRUE(r.finished);
+  EXPECT_FALSE(r.valid);  // ещё Brake
+  EXPECT_EQ(r.type, TestType::Step);
+  ASSERT_TRUE(r.metrics.has_step);
+  EXPECT_TRUE(r.metrics.step.valid);
+  EXPECT_NEAR(r.metrics.step.baseline_dps, 0.0f, 1e-3f);
+  EXPECT_NEAR(r.metrics.step.steady_dps, 90.0f, 0.5f);
+  EXPECT_NEAR(r.metrics.step.rise_time_s, 0.1f * std::log(9.0f), 0.02f);
+  EXPECT_NEAR(r.metrics.speed_mean_ms, 2.0f, 1e-4f);
+  EXPECT_NEAR(r.metrics.slip_mean_deg, 3.0f, 1e-4f);
+
+  RunBrakePhase(throttle, steering);
+  ASSERT_EQ(runner.GetPhase(), Phase::Done);
+  EXPECT_TRUE(runner.GetResult().valid);
+}
+
+TEST_F(TestRunnerTest, Start_ClearsPreviousResult) {
+  runner.Start(MakeStraight(1.0f));
+  float throttle = 0.0f, steering = 0.0f;
+  RunAccelPhase(throttle, steering);
+  RunCruisePhase(throttle, steering, 600);
+  ASSERT_TRUE(runner.GetResult().finished);
+  runner.Stop();
+
+  runner.Start(MakeCircle());
+  EXPECT_FALSE(runner.GetResult().finished);
+  EXPECT_EQ(runner.GetResult().type, TestType::Circle);
+}
+
 }  // namespace
 }  // namespace rc_vehicle
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "udp_command.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+constexpr uint32_t kToken = 0xA5A5F00Du;
+
+UdpCommandVerdict Feed(UdpCommandFilter& f, uint32_t seq, uint32_t now_ms,
+                       float throttle = 0.5f, uint32_t token = kToken) {
+  const UdpCommandPacket pkt = MakeUdpCommand(seq, token, throttle, -0.25f);
+  UdpCommandPacket out{};
+  return f.Accept(&pkt, sizeof(pkt), now_ms, out);
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Формат датаграммы
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(UdpCommandTest, PacketLayoutIsLittleEndian) {
+  const UdpCommandPacket pkt = MakeUdpCommand(0x01020304u, kToken, 1.0f, 0.0f);
+  uint8_t raw[sizeof(pkt)];
+  std::memcpy(raw, &pkt, sizeof(pkt));
+  EXPECT_EQ(raw[0], 'R');
+  EXPECT_EQ(raw[1], 'C');
+  EXPECT_EQ(raw[2], kUdpCommandVersion);
+  EXPECT_EQ(raw[3], 0);
+  EXPECT_EQ(raw[4], 0x04);  // seq, младший байт первым
+  EXPECT_EQ(raw[7], 0x01);
+  float thr = 0.0f;
+  std::memcpy(&thr, raw + 12, sizeof(thr));
+  EXPECT_EQ(thr, 1.0f);
+}
+
+TEST(UdpCommandTest, AcceptsValidCommand) {
+  UdpCommandFilter f(kToken);
+  const UdpCommandPacket pkt = MakeUdpCommand(7, kToken, 0.3f, -0.4f);
+  UdpCommandPacket out{};
+  ASSERT_EQ(f.Accept(&pkt, sizeof(pkt), 10, out), UdpCommandVerdict::Accepted);
+  EXPECT_EQ(out.seq, 7u);
+  EXPECT_FLOAT_EQ(out.throttle, 0.3f);
+  EXPECT_FLOAT_EQ(out.steering, -0.4f);
+  EXPECT_EQ(f.LastSeq(), 7u);
+  EXPECT_EQ(f.Stats().accepted, 1u);
+}
+
+TEST(UdpCommandTest, RejectsMalformedAndForeignToken) {
+  UdpCommandFilter f(kToken);
+  UdpCommandPacket pkt = MakeUdpCommand(1, kToken, 0.0f, 0.0f);
+  UdpCommandPacket out{};
+
+  EXPECT_EQ(f.Accept(&pkt, sizeof(pkt) - 1, 0, out),
+            UdpCommandVerdict::Malformed);
+  uint8_t longer[sizeof(pkt) + 1] = {};
+  std::memcpy(longer, &pkt, sizeof(pkt));
+  EXPECT_EQ(f.Accept(longer, sizeof(longer), 0, out),
+            UdpCommandVerdict::Malformed);
+  EXPECT_EQ(f.Accept(nullptr, sizeof(pkt), 0, out),
+            UdpCommandVerdict::Malformed);
+
+  UdpCommandPacket bad = pkt;
+  bad.magic[1] = 'T';  // "RT" — пакет телеметрии
+  EXPECT_EQ(f.Accept(&bad, sizeof(bad), 0, out), UdpCommandVerdict::Malformed);
+  bad = pkt;
+  bad.version = 2;
+  EXPECT_EQ(f.Accept(&bad, sizeof(bad), 0, out), UdpCommandVerdict::Malformed);
+  bad = pkt;
+  bad.throttle = std::numeric_limits<float>::quiet_NaN();
+  EXPECT_EQ(f.Accept(&bad, sizeof(bad), 0, out), UdpCommandVerdict::Malformed);
+  bad = pkt;
+  bad.steering = std::numeric_limits<float>::infinity();
+  EXPECT_EQ(f.Accept(&bad, sizeof(bad), 0, out), UdpCommandVerdict::Malformed);
+
+  EXPECT_EQ(Feed(f, 1, 0, 0.5f, kToken ^ 1u), UdpCommandVerdict::BadToken);
+
+  EXPECT_EQ(f.Stats().malformed, 7u);
+  EXPECT_EQ(f.Stats().bad_token, 1u);
+  EXPECT_EQ(f.Stats().accepted, 0u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Побеждает последняя
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(UdpCommandTest, DropsDuplicatesAndReordered) {
+  UdpCommandFilter f(kToken);
+  EXPECT_EQ(Feed(f, 10, 0), UdpCommandVerdict::Accepted);
+  EXPECT_EQ(Feed(f, 10, 1), UdpCommandVerdict::Duplicate);  // --dup копия
+  EXPECT_EQ(Feed(f, 12, 40), UdpCommandVerdict::Accepted);  // 11 потерян
+  EXPECT_EQ(Feed(f, 11, 41), UdpCommandVerdict::Stale);     // опоздал
+  EXPECT_EQ(Feed(f, 12, 41), UdpCommandVerdict::Duplicate);
+  EXPECT_EQ(Feed(f, 13, 60), UdpCommandVerdict::Accepted);
+
+  EXPECT_EQ(f.LastSeq(), 13u);
+  EXPECT_EQ(f.Stats().accepted, 3u);
+  EXPECT_EQ(f.Stats().duplicate, 2u);
+  EXPECT_EQ(f.Stats().stale, 1u);
+}
+
+TEST(UdpCommandTest, SeqWrapsAround) {
+  UdpCommandFilter f(kToken);
+  EXPECT_EQ(Feed(f, 0xFFFFFFFEu, 0), UdpCommandVerdict::Accepted);
+  EXPECT_EQ(Feed(f, 0xFFFFFFFFu, 20), UdpCommandVerdict::Accepted);
+  EXPECT_EQ(Feed(f, 0u, 40), UdpCommandVerdict::Accepted);
+  EXPECT_EQ(Feed(f, 0xFFFFFFFFu, 41), UdpCommandVerdict::Stale);
+  EXPECT_EQ(Feed(f, 1u, 60), UdpCommandVerdict::Accepted);
+}
+
+TEST(UdpCommandTest, ResyncsAfterSilence) {
+  UdpCommandFilter f(kToken, 1000);
+  EXPECT_EQ(Feed(f, 5000, 0), UdpCommandVerdict::Accepted);
+  // Клиент перезапустился и начал с 1: в пределах окна — старый seq
+  EXPECT_EQ(Feed(f, 1, 1000), UdpCommandVerdict::Stale);
+  EXPECT_EQ(Feed(f, 1, 1001), UdpCommandVerdict::Accepted);
+  EXPECT_EQ(Feed(f, 2, 1020), UdpCommandVerdict::Accepted);
+  EXPECT_EQ(f.Stats().resyncs, 1u);
+}
+
+TEST(UdpCommandTest, VerdictNames) {
+  EXPECT_STREQ(UdpCommandVerdictName(UdpCommandVerdict::Accepted), "accepted");
+  EXPECT_STREQ(UdpCommandVerdictName(UdpCommandVerdict::BadToken),
+               "bad_token");
+}
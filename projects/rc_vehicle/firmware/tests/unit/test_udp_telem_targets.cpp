@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "udp_telem_targets.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+constexpr uint32_t kLaptop = 0xC0A80402u;   // 192.168.4.2
+constexpr uint32_t kTuning = 0xC0A80403u;   // 192.168.4.3
+constexpr uint32_t kGroup = 0xEF010203u;    // 239.1.2.3
+
+std::vector<UdpTelemTarget> Destinations(const UdpTelemTargetSet& set) {
+  std::vector<UdpTelemTarget> out;
+  set.ForEach([&](const UdpTelemTarget& t) { out.push_back(t); });
+  return out;
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Адреса
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(UdpTelemTargetsTest, ParseAndFormatIpv4) {
+  uint32_t addr = 0;
+  ASSERT_TRUE(ParseIpv4("192.168.4.2", addr));
+  EXPECT_EQ(addr, kLaptop);
+  ASSERT_TRUE(ParseIpv4("239.1.2.3", addr));
+  EXPECT_TRUE(IsMulticastIpv4(addr));
+  EXPECT_FALSE(IsMulticastIpv4(kLaptop));
+
+  char buf[16];
+  FormatIpv4(0xFFFFFFFFu, buf, sizeof(buf));
+  EXPECT_STREQ(buf, "255.255.255.255");
+  FormatIpv4(kLaptop, buf, sizeof(buf));
+  EXPECT_STREQ(buf, "192.168.4.2");
+
+  for (const char* bad : {"", "1.2.3", "1.2.3.4.5", "256.1.1.1", "1..2.3",
+                          "1.2.3.4 ", "a.b.c.d", "1.2.3.0004"}) {
+    EXPECT_FALSE(ParseIpv4(bad, addr)) << bad;
+  }
+  EXPECT_FALSE(ParseIpv4(nullptr, addr));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Набор получателей
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(UdpTelemTargetsTest, GroupGoesFirstThenUnicastInJoinOrder) {
+  UdpTelemTargetSet set;
+  EXPECT_TRUE(set.Empty());
+  ASSERT_TRUE(IsOk(set.AddUnicast(kLaptop, 5555)));
+  ASSERT_TRUE(IsOk(set.AddUnicast(kTuning, 5600)));
+  ASSERT_TRUE(IsOk(set.SetGroup(kGroup, 5555)));
+
+  const auto dst = Destinations(set);
+  ASSERT_EQ(dst.size(), 3u);
+  EXPECT_EQ(dst[0], (UdpTelemTarget{kGroup, 5555}));
+  EXPECT_EQ(dst[1], (UdpTelemTarget{kLaptop, 5555}));
+  EXPECT_EQ(dst[2], (UdpTelemTarget{kTuning, 5600}));
+  EXPECT_EQ(set.Size(), 3u);
+}
+
+TEST(UdpTelemTargetsTest, JoinIsIdempotentAndLeaveKeepsOrder) {
+  UdpTelemTargetSet set;
+  ASSERT_TRUE(IsOk(set.AddUnicast(kLaptop, 5555)));
+  ASSERT_TRUE(IsOk(set.AddUnicast(kLaptop, 5555)));  // повторный JOIN
+  EXPECT_EQ(set.UnicastCount(), 1u);
+  ASSERT_TRUE(IsOk(set.AddUnicast(kLaptop, 5556)));  // второй порт — отдельно
+  ASSERT_TRUE(IsOk(set.AddUnicast(kTuning, 5555)));
+
+  ASSERT_TRUE(IsOk(set.RemoveUnicast(kLaptop, 5555)));
+  ASSERT_EQ(set.UnicastCount(), 2u);
+  EXPECT_EQ(set.Unicast(0), (UdpTelemTarget{kLaptop, 5556}));
+  EXPECT_EQ(set.Unicast(1), (UdpTelemTarget{kTuning, 5555}));
+
+  auto r = set.RemoveUnicast(kLaptop, 5555);
+  ASSERT_FALSE(IsOk(r));
+  EXPECT_EQ(GetError(r), UdpTelemTargetError::NotFound);
+}
+
+TEST(UdpTelemTargetsTest, RejectsInvalidTargetsAndOverflow) {
+  UdpTelemTargetSet set;
+  EXPECT_EQ(GetError(set.AddUnicast(0, 5555)),
+            UdpTelemTargetError::InvalidAddress);
+  EXPECT_EQ(GetError(set.AddUnicast(0xFFFFFFFFu, 5555)),
+            UdpTelemTargetError::InvalidAddress);
+  EXPECT_EQ(GetError(set.AddUnicast(kGroup, 5555)),
+            UdpTelemTargetError::InvalidAddress);
+  EXPECT_EQ(GetError(set.AddUnicast(kLaptop, 80)),
+            UdpTelemTargetError::InvalidPort);
+  EXPECT_EQ(GetError(set.SetGroup(kLaptop, 5555)),
+            UdpTelemTargetError::InvalidAddress);
+  EXPECT_EQ(GetError(set.SetGroup(kGroup, 1000)),
+            UdpTelemTargetError::InvalidPort);
+  EXPECT_TRUE(set.Empty());
+
+  for (uint16_t i = 0; i < UdpTelemTargetSet::kMaxUnicast; ++i) {
+    ASSERT_TRUE(IsOk(set.AddUnicast(kLaptop, 6000 + i)));
+  }
+  EXPECT_EQ(GetError(set.AddUnicast(kTuning, 5555)),
+            UdpTelemTargetError::Full);
+  // Группа не занимает unicast-слот
+  EXPECT_TRUE(IsOk(set.SetGroup(kGroup, 5555)));
+  EXPECT_EQ(set.Size(), UdpTelemTargetSet::kMaxUnicast + 1);
+}
+
+TEST(UdpTelemTargetsTest, GroupReplaceAndClear) {
+  UdpTelemTargetSet set;
+  ASSERT_TRUE(IsOk(set.SetGroup(kGroup, 5555)));
+  ASSERT_TRUE(IsOk(set.SetGroup(kGroup + 1, 5600)));
+  ASSERT_TRUE(set.Group().has_value());
+  EXPECT_EQ(*set.Group(), (UdpTelemTarget{kGroup + 1, 5600}));
+  ASSERT_TRUE(IsOk(set.AddUnicast(kLaptop, 5555)));
+
+  set.ClearGroup();
+  EXPECT_FALSE(set.Group().has_value());
+  EXPECT_EQ(set.Size(), 1u);
+  set.Clear();
+  EXPECT_TRUE(set.Empty());
+}
+
+TEST(UdpTelemTargetsTest, ErrorNames) {
+  EXPECT_STREQ(UdpTelemTargetErrorName(UdpTelemTargetError::Full),
+               "target list full");
+  EXPECT_STREQ(UdpTelemTargetErrorName(UdpTelemTargetError::InvalidPort),
+               "port must be >= 1024");
+}
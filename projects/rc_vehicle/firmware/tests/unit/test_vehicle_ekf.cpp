@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <numbers>
+#include <vector>
 
 #include "vehicle_ekf.hpp"
 
@@ -483,3 +484,47 @@ TEST(VehicleEkfTest, Reset_ResetsYaw) {
   ekf.Reset();
   EXPECT_FLOAT_EQ(ekf.GetYawRad(), 0.0f);
 }
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Пакетный UpdateFromImuBatch
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(VehicleEkfTest, UpdateFromImuBatch_MatchesPerSampleExactly) {
+  constexpr size_t kN = 800;
+  std::vector<float> ax(kN), ay(kN), az(kN), gz(kN), thr(kN), zeros(kN);
+  for (size_t i = 0; i < kN; ++i) {
+    const float t = static_cast<float>(i) * 0.002f;
+    ax[i] = 0.2f * std::sin(0.9f * t);
+    ay[i] = 0.35f * std::sin(2.0f * t);
+    az[i] = 1.0f;
+    gz[i] = (i < 200) ? 0.5f : 70.0f * std::sin(2.0f * t);  // стоим → едем
+    thr[i] = (i < 200) ? 0.0f : 0.3f;
+  }
+  const float dt = 0.002f;
+  const ImuBatch batch{ax, ay, az, zeros, zeros, gz, {&dt, 1}};
+
+  VehicleEkf single, batched;
+  std::vector<float> vx(kN), vy(kN), r(kN), yaw(kN);
+  ASSERT_TRUE(batched.UpdateFromImuBatch(batch, thr, {vx, vy, r, yaw}));
+
+  for (size_t i = 0; i < kN; ++i) {
+    single.UpdateFromImu(ax[i], ay[i], az[i], gz[i], dt, thr[i]);
+    ASSERT_EQ(single.GetVx(), vx[i]) << "sample " << i;
+    ASSERT_EQ(single.GetVy(), vy[i]) << "sample " << i;
+    ASSERT_EQ(single.GetYawRate(), r[i]) << "sample " << i;
+    ASSERT_EQ(single.GetYawRad(), yaw[i]) << "sample " << i;
+  }
+  EXPECT_EQ(single.GetVxVariance(), batched.GetVxVariance());
+  EXPECT_EQ(single.GetRVariance(), batched.GetRVariance());
+}
+
+TEST(VehicleEkfTest, UpdateFromImuBatch_RejectsMismatchedSizes) {
+  std::vector<float> a(10, 0.0f), one(10, 1.0f), dt(4, 0.002f);
+  VehicleEkf ekf;
+  EXPECT_FALSE(ekf.UpdateFromImuBatch({a, a, one, a, a, a, dt}));
+
+  const float dt1 = 0.002f;
+  std::vector<float> thr(3, 0.0f);
+  EXPECT_FALSE(ekf.UpdateFromImuBatch({a, a, one, a, a, a, {&dt1, 1}}, thr));
+  EXPECT_FLOAT_EQ(ekf.GetVxVariance(), VehicleEkf{}.GetVxVariance());
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "ws_protocol.hpp"
+
+using namespace rc_vehicle;
+
+namespace {
+
+std::vector<uint8_t> Bytes(const std::string& s) {
+  return std::vector<uint8_t>(s.begin(), s.end());
+}
+
+std::string Text(std::span<const uint8_t> p) {
+  return std::string(p.begin(), p.end());
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Рукопожатие
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(WsProtocolTest, Sha1AndBase64KnownVectors) {
+  uint8_t digest[20];
+  Sha1("abc", digest);
+  EXPECT_EQ(Base64Encode(digest), "qZk+NkcGgWq6PiVxeFDCbJzQ2J0=");
+  // Два блока дополнения: 56 байт
+  Sha1("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", digest);
+  EXPECT_EQ(Base64Encode(digest), "hJg+RBw70m66rkqh+VEp5eVGcPE=");
+
+  const uint8_t two[] = {'a', 'b'};
+  EXPECT_EQ(Base64Encode(two), "YWI=");
+  EXPECT_EQ(Base64Encode(std::span<const uint8_t>(two, 1)), "YQ==");
+}
+
+TEST(WsProtocolTest, AcceptKeyMatchesRfc6455Example) {
+  EXPECT_EQ(WsAcceptKey("dGhlIHNhbXBsZSBub25jZQ=="),
+            "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+}
+
+TEST(WsProtocolTest, ParsesUpgradeRequestAndChecksResponse) {
+  const std::string key = "dGhlIHNhbXBsZSBub25jZQ==";
+  std::string req = WsClientHandshake("localhost:8080", "/ws", key);
+
+  WsUpgradeRequest parsed;
+  EXPECT_EQ(ParseWsUpgradeRequest(req.substr(0, req.size() - 2), parsed),
+            WsHandshakeStatus::NeedMore);
+  req += "\x81";  // Первый кадр сразу за заголовком
+  ASSERT_EQ(ParseWsUpgradeRequest(req, parsed), WsHandshakeStatus::Ok);
+  EXPECT_EQ(parsed.path, "/ws");
+  EXPECT_EQ(parsed.key, key);
+  EXPECT_EQ(parsed.header_len, req.size() - 1);
+
+  // Заголовки без учёта регистра, Connection со списком
+  const std::string browser =
+      "GET /telem HTTP/1.1\r\nhost: x\r\nconnection: keep-alive, Upgrade\r\n"
+      "upgrade: WebSocket\r\nsec-websocket-key:  abc== \r\n\r\n";
+  ASSERT_EQ(ParseWsUpgradeRequest(browser, parsed), WsHandshakeStatus::Ok);
+  EXPECT_EQ(parsed.key, "abc==");
+
+  EXPECT_EQ(ParseWsUpgradeRequest("GET / HTTP/1.1\r\nHost: x\r\n\r\n", parsed),
+            WsHandshakeStatus::BadRequest);
+  EXPECT_EQ(ParseWsUpgradeRequest("POST /ws HTTP/1.1\r\n\r\n", parsed),
+            WsHandshakeStatus::BadRequest);
+
+  size_t header_len = 0;
+  const std::string resp = WsUpgradeResponse(key);
+  EXPECT_EQ(CheckWsUpgradeResponse(resp, key, header_len),
+            WsHandshakeStatus::Ok);
+  EXPECT_EQ(header_len, resp.size());
+  EXPECT_EQ(CheckWsUpgradeResponse(resp, "b3RoZXIga2V5IDEyMzQ1Ng==",
+                                   header_len),
+            WsHandshakeStatus::BadRequest);
+  EXPECT_EQ(CheckWsUpgradeResponse("HTTP/1.1 404 Not Found\r\n\r\n", key,
+                                   header_len),
+            WsHandshakeStatus::BadRequest);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Кадры
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(WsProtocolTest, FrameRoundTripAllLengthEncodings) {
+  const uint8_t mask[4] = {0x37, 0xFA, 0x21, 0x3D};
+  for (size_t len : {0u, 5u, 125u, 126u, 200u, 65535u, 70000u}) {
+    for (const uint8_t* m : {static_cast<const uint8_t*>(nullptr), mask}) {
+      std::string payload(len, '\0');
+      for (size_t i = 0; i < len; ++i) payload[i] = static_cast<char>(i * 7);
+      std::string wire;
+      AppendWsFrame(wire, WsOpcode::Binary, payload, m);
+      wire += "tail";
+
+      auto buf = Bytes(wire);
+      WsFrame f;
+      ASSERT_EQ(DecodeWsFrame(buf, 1 << 20, f), WsFrameStatus::Ok) << len;
+      EXPECT_EQ(f.opcode, WsOpcode::Binary);
+      EXPECT_TRUE(f.fin);
+      EXPECT_EQ(f.masked, m != nullptr);
+      EXPECT_EQ(Text(f.payload), payload) << len;
+      EXPECT_EQ(f.frame_len, wire.size() - 4);
+    }
+  }
+}
+
+TEST(WsProtocolTest, MaskedTextMatchesRfcExample) {
+  // RFC 6455 §5.7: замаскированный "Hello"
+  std::vector<uint8_t> buf = {0x81, 0x85, 0x37, 0xfa, 0x21, 0x3d, 0x7f,
+                              0x9f, 0x4d, 0x51, 0x58};
+  WsFrame f;
+  ASSERT_EQ(DecodeWsFrame(buf, 125, f), WsFrameStatus::Ok);
+  EXPECT_EQ(f.opcode, WsOpcode::Text);
+  EXPECT_EQ(Text(f.payload), "Hello");
+
+  std::string wire;
+  const uint8_t mask[4] = {0x37, 0xfa, 0x21, 0x3d};
+  AppendWsFrame(wire, WsOpcode::Text, "Hello", mask);
+  EXPECT_EQ(Bytes(wire), (std::vector<uint8_t>{0x81, 0x85, 0x37, 0xfa, 0x21,
+                                               0x3d, 0x7f, 0x9f, 0x4d, 0x51,
+                                               0x58}));
+}
+
+TEST(WsProtocolTest, IncompleteOversizedAndInvalidFrames) {
+  std::string wire;
+  AppendWsFrame(wire, WsOpcode::Text, std::string(300, 'x'));
+  WsFrame f;
+  for (size_t n : {0u, 1u, 3u, 303u}) {
+    auto part = Bytes(wire.substr(0, n));
+    EXPECT_EQ(DecodeWsFrame(part, 1024, f), WsFrameStatus::NeedMore) << n;
+  }
+  auto full = Bytes(wire);
+  EXPECT_EQ(DecodeWsFrame(full, 299, f), WsFrameStatus::TooLarge);
+
+  std::vector<uint8_t> rsv = {0xC1, 0x00};  // RSV1 без расширения
+  EXPECT_EQ(DecodeWsFrame(rsv, 125, f), WsFrameStatus::Protocol);
+  std::vector<uint8_t> opcode = {0x83, 0x00};  // Зарезервированный opcode
+  EXPECT_EQ(DecodeWsFrame(opcode, 125, f), WsFrameStatus::Protocol);
+  std::vector<uint8_t> frag_ping = {0x09, 0x00};  // Ping без FIN
+  EXPECT_EQ(DecodeWsFrame(frag_ping, 125, f), WsFrameStatus::Protocol);
+  std::vector<uint8_t> long_ping = {0x89, 0x7E, 0x00, 0x80};
+  EXPECT_EQ(DecodeWsFrame(long_ping, 1024, f), WsFrameStatus::Protocol);
+}
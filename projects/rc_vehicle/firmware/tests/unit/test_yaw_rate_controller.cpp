@@ -241,3 +241,97 @@ TEST_F(YawRateControllerTest, AdaptivePid_Disabled_NoScaling) {
   EXPECT_FLOAT_EQ(steering1, steering2)
       << "Without adaptive PID, speed should not affect correction";
 }
+
+// ══════════════════════════════════════════════════════════════════════════════
+// Explicit MPC
+// ══════════════════════════════════════════════════════════════════════════════
+
+TEST_F(YawRateControllerTest, Mpc_FallsBackToPid_BelowSpeedGrid) {
+  cfg_.yaw_rate.mpc_enabled = true;
+  ekf_.SetState(0.1f, 0.0f, 0.0f);
+  float steering = 0.5f;
+  ctrl_.Process(steering, 1.0f, 1.0f, 2);
+  EXPECT_FALSE(ctrl_.IsMpcActive());
+  EXPECT_GT(steering, 0.5f) << "PID correction applies below MPC speed grid";
+}
+
+TEST_F(YawRateControllerTest, Mpc_FallsBackToPid_WhenReversing) {
+  cfg_.yaw_rate.mpc_enabled = true;
+  ekf_.SetState(-2.0f, 0.0f, 0.0f);
+  float steering = 0.5f;
+  ctrl_.Process(steering, 1.0f, 1.0f, 2);
+  EXPECT_FALSE(ctrl_.IsMpcActive());
+}
+
+TEST_F(YawRateControllerTest, Mpc_RespectsSteeringRateLimit) {
+  cfg_.yaw_rate.mpc_enabled = true;
+  cfg_.slew_steering = 3.0f;  // 0.006 за тик 2 мс
+  ekf_.SetState(2.0f, 0.0f, 0.0f);
+
+  float prev = 0.0f;
+  for (int i = 0; i < 20; ++i) {
+    float steering = 0.8f;  // резкий запрос поворота
+    ctrl_.Process(steering, 1.0f, 1.0f, 2);
+    ASSERT_TRUE(ctrl_.IsMpcActive());
+    EXPECT_LE(std::abs(steering - prev), 0.006f + 1e-5f) << "tick " << i;
+    EXPECT_GT(steering, prev) << "MPC steers towards requested yaw rate";
+    prev = steering;
+  }
+}
+
+TEST_F(YawRateControllerTest, Mpc_CountersOversteer) {
+  // Желаемая угловая скорость 0, фактическая +90 dps → руль в минус
+  cfg_.yaw_rate.mpc_enabled = true;
+  ekf_.SetState(3.0f, 0.0f, 0.0f);
+  SetGyroZ(90.0f);
+  float steering = 0.0f;
+  ctrl_.Process(steering, 1.0f, 1.0f, 2);
+  ASSERT_TRUE(ctrl_.IsMpcActive());
+  EXPECT_LT(steering, 0.0f);
+}
+
+TEST_F(YawRateControllerTest, Mpc_CountersUndersteer) {
+  // Запрос 0.5 → r_ref = 45 dps. Машина поворачивает слабее (|r| < |r_ref|)
+  // — установившийся руль больше, чем при точном следовании
+  cfg_.yaw_rate.mpc_enabled = true;
+  cfg_.slew_steering = 3.0f;
+  ekf_.SetState(3.0f, 0.0f, 0.0f);
+  auto settle = [&](float gz_dps) {
+    SetGyroZ(gz_dps);
+    ctrl_.Reset();
+    float steering = 0.0f;
+    for (int i = 0; i < 300; ++i) {
+      steering = 0.5f;
+      ctrl_.Process(steering, 1.0f, 1.0f, 2);
+      EXPECT_TRUE(ctrl_.IsMpcActive());
+    }
+    return steering;
+  };
+  const float tracking = settle(45.0f);
+  const float understeer = settle(10.0f);
+  EXPECT_GT(tracking, 0.0f);
+  EXPECT_GT(understeer, tracking + 0.05f);
+}
+
+TEST_F(YawRateControllerTest, Mpc_NoEffect_WhenModeWeightZero) {
+  cfg_.yaw_rate.mpc_enabled = true;
+  ekf_.SetState(2.0f, 0.0f, 0.0f);
+  float steering = 0.5f;
+  ctrl_.Process(steering, 1.0f, 0.0f, 2);
+  EXPECT_FLOAT_EQ(steering, 0.5f);
+}
+
+TEST_F(YawRateControllerTest, CycleStats_RecordPidAndMpcCost) {
+  cfg_.yaw_rate.mpc_enabled = true;
+  ekf_.SetState(2.0f, 0.0f, 0.0f);
+  for (int i = 0; i < 5; ++i) {
+    float steering = 0.3f;
+    ctrl_.Process(steering, 1.0f, 1.0f, 2);
+  }
+  EXPECT_EQ(ctrl_.GetPidCycles().count, 5u);
+  EXPECT_EQ(ctrl_.GetMpcCycles().count, 5u);
+
+  ctrl_.ResetCycleStats();
+  EXPECT_EQ(ctrl_.GetPidCycles().count, 0u);
+  EXPECT_EQ(ctrl_.GetMpcCycles().count, 0u);
+}
@@ -0,0 +1,405 @@
+#!/usr/bin/env python3
+"""
+Explicit MPC table generator for the yaw-rate controller.
+
+Solves the parametric QP of a receding-horizon yaw-rate MPC offline for the
+linear bicycle model and emits a C++ header with the piecewise-affine
+solution: per speed bin, a region table (affine law u = F·x + g) and a
+binary search tree over the region boundaries. On the device the controller
+does one tree descent plus one affine law per tick (see ExplicitMpc in
+firmware/common/explicit_mpc.hpp).
+
+QP (per speed bin, parameter x = [vy, r, r_ref, u_prev, du_max]):
+
+    min_du  sum_{k=1..N} q_r (r_k - r_ref)^2 + q_vy vy_k^2  +  rho du^2
+    s.t.    |du| <= du_max            (steering rate limit per Ts step)
+            |u_prev + du| <= 1        (steering range)
+
+where the input is held at u = u_prev + du over the horizon (move blocking).
+The decision variable is scalar, so the mpQP has exactly five critical
+regions (unconstrained, rate-limited ±, range-limited ±); their boundaries
+are hyperplanes in x, and the tree below is exact. Every generated bin is
+verified against the direct QP solution on random parameter samples.
+
+Usage:
+    python3 gen_yaw_mpc.py                       # writes common/yaw_mpc_table.hpp
+    python3 gen_yaw_mpc.py --out /tmp/table.hpp --horizon 75 --q-vy 1.0
+
+Ts must equal the control loop period: the controller passes the slew
+limiter's per-tick step as du_max.
+
+No external dependencies — uses only Python standard library.
+"""
+
+from __future__ import annotations
+
+import argparse
+import math
+import random
+import sys
+from dataclasses import dataclass
+from pathlib import Path
+
+# ---------------------------------------------------------------------------
+# Constants
+# ---------------------------------------------------------------------------
+
+PARAM_DIM = 5  # [vy, r, r_ref, u_prev, du_max]
+IDX_VY, IDX_R, IDX_RREF, IDX_UPREV, IDX_DUMAX = range(PARAM_DIM)
+
+DEFAULT_OUT = (
+    Path(__file__).resolve().parent.parent / "firmware" / "common" / "yaw_mpc_table.hpp"
+)
+DEFAULT_SPEED_GRID = [0.5, 1.0, 1.5, 2.0, 3.0, 4.0, 5.0, 6.0]
+
+Vec = list[float]
+Mat = list[list[float]]
+
+
+@dataclass
+class VehicleModel:
+    mass_kg: float
+    iz_kgm2: float
+    lf_m: float
+    lr_m: float
+    cf_n_rad: float
+    cr_n_rad: float
+    delta_max_rad: float
+
+
+@dataclass
+class MpcWeights:
+    q_r: float
+    q_vy: float
+    rho: float
+    horizon: int
+    ts_s: float
+
+
+@dataclass
+class Node:
+    h: Vec
+    c: float
+    yes: int  # >= 0: node index, < 0: leaf region -(idx + 1)
+    no: int
+
+
+@dataclass
+class Region:
+    name: str
+    f: Vec
+    g: float
+
+
+# ---------------------------------------------------------------------------
+# Small dense linear algebra (3x3 at most)
+# ---------------------------------------------------------------------------
+
+
+def mat_mul(a: Mat, b: Mat) -> Mat:
+    return [
+        [sum(a[i][k] * b[k][j] for k in range(len(b))) for j in range(len(b[0]))]
+        for i in range(len(a))
+    ]
+
+
+def mat_add(a: Mat, b: Mat) -> Mat:
+    return [[a[i][j] + b[i][j] for j in range(len(a[0]))] for i in range(len(a))]
+
+
+def mat_scale(a: Mat, s: float) -> Mat:
+    return [[v * s for v in row] for row in a]
+
+
+def identity(n: int) -> Mat:
+    return [[1.0 if i == j else 0.0 for j in range(n)] for i in range(n)]
+
+
+def expm(a: Mat) -> Mat:
+    """Matrix exponential by scaling and squaring + Taylor series."""
+    norm = max(sum(abs(v) for v in row) for row in a)
+    squarings = max(0, int(math.ceil(math.log2(norm))) + 1) if norm > 0.5 else 0
+    scaled = mat_scale(a, 1.0 / (2 ** squarings))
+    result = identity(len(a))
+    term = identity(len(a))
+    for k in range(1, 20):
+        term = mat_scale(mat_mul(term, scaled), 1.0 / k)
+        result = mat_add(result, term)
+    for _ in range(squarings):
+        result = mat_mul(result, result)
+    return result
+
+
+def dot(a: Vec, b: Vec) -> float:
+    return sum(x * y for x, y in zip(a, b))
+
+
+# ---------------------------------------------------------------------------
+# Model
+# ---------------------------------------------------------------------------
+
+
+def discretize(model: VehicleModel, vx: float, ts: float) -> tuple[Mat, Vec]:
+    """ZOH discretization of the linear bicycle model, state [vy, r].
+
+    Input is the normalized steering command u in [-1, 1]
+    (wheel angle = u * delta_max).
+    """
+    m, iz = model.mass_kg, model.iz_kgm2
+    lf, lr = model.lf_m, model.lr_m
+    cf, cr = model.cf_n_rad, model.cr_n_rad
+    a = [
+        [-(cf + cr) / (m * vx), -(lf * cf - lr * cr) / (m * vx) - vx],
+        [-(lf * cf - lr * cr) / (iz * vx), -(lf * lf * cf + lr * lr * cr) / (iz * vx)],
+    ]
+    b = [cf / m * model.delta_max_rad, lf * cf / iz * model.delta_max_rad]
+
+    # expm([[A, B], [0, 0]] * ts) = [[Ad, Bd], [0, 1]]
+    aug = [
+        [a[0][0] * ts, a[0][1] * ts, b[0] * ts],
+        [a[1][0] * ts, a[1][1] * ts, b[1] * ts],
+        [0.0, 0.0, 0.0],
+    ]
+    e = expm(aug)
+    ad = [[e[0][0], e[0][1]], [e[1][0], e[1][1]]]
+    bd = [e[0][2], e[1][2]]
+    return ad, bd
+
+
+def unconstrained_gain(ad: Mat, bd: Vec, w: MpcWeights) -> Vec:
+    """Gain K of the unconstrained optimum du* = K·x.
+
+    Predictions with u held at u_prev + du:
+        z_k = A^k z0 + S_k (u_prev + du),  S_k = sum_{j<k} A^j B
+    J(du) is a scalar quadratic; dJ/d(du) = 0 gives du* linear in x.
+    """
+    ak = identity(2)
+    sk = [0.0, 0.0]
+    num = [0.0] * PARAM_DIM  # du* = -(num·x) / den
+    den = w.rho
+    for _ in range(w.horizon):
+        sk = [sk[0] + dot(ak[0], bd), sk[1] + dot(ak[1], bd)]
+        ak = mat_mul(ad, ak)
+        # r_k - r_ref = ak[1]·z0 + sk[1] u_prev - r_ref + sk[1] du
+        e_r = [ak[1][0], ak[1][1], -1.0, sk[1], 0.0]
+        # vy_k = ak[0]·z0 + sk[0] u_prev + sk[0] du
+        e_vy = [ak[0][0], ak[0][1], 0.0, sk[0], 0.0]
+        for i in range(PARAM_DIM):
+            num[i] += w.q_r * sk[1] * e_r[i] + w.q_vy * sk[0] * e_vy[i]
+        den += w.q_r * sk[1] ** 2 + w.q_vy * sk[0] ** 2
+    return [-n / den for n in num]
+
+
+# ---------------------------------------------------------------------------
+# Explicit solution: regions + BST
+# ---------------------------------------------------------------------------
+
+
+def unit(i: int) -> Vec:
+    v = [0.0] * PARAM_DIM
+    v[i] = 1.0
+    return v
+
+
+def build_partition(k: Vec) -> tuple[list[Node], list[Region]]:
+    """Critical regions of the scalar mpQP and an exact BST over them.
+
+    s = K·x (unconstrained move), p = u_prev, d = du_max.
+    """
+    e_p, e_d = unit(IDX_UPREV), unit(IDX_DUMAX)
+    neg = lambda v: [-x for x in v]  # noqa: E731
+    add = lambda a, b: [x + y for x, y in zip(a, b)]  # noqa: E731
+
+    regions = [
+        Region("interior", add(k, e_p), 0.0),            # u = p + s
+        Region("rate_hi", add(e_p, e_d), 0.0),           # u = p + d
+        Region("rate_lo", add(e_p, neg(e_d)), 0.0),      # u = p - d
+        Region("range_hi", [0.0] * PARAM_DIM, 1.0),      # u = +1
+        Region("range_lo", [0.0] * PARAM_DIM, -1.0),     # u = -1
+    ]
+    leaf = lambda idx: -(idx + 1)  # noqa: E731
+
+    nodes = [
+        Node(add(k, neg(e_d)), 0.0, 1, 5),                   # 0: s <= d
+        Node(add(k, e_p), 1.0, 2, leaf(3)),                  # 1: s + p <= 1
+        Node(add(neg(k), neg(e_d)), 0.0, 3, 4),              # 2: s >= -d
+        Node(add(neg(k), neg(e_p)), 1.0, leaf(0), leaf(4)),  # 3: s + p >= -1
+        Node(add(neg(e_p), e_d), 1.0, leaf(2), leaf(4)),     # 4: p >= -1 + d
+        Node(add(e_p, e_d), 1.0, leaf(1), leaf(3)),          # 5: p + d <= 1
+    ]
+    return nodes, regions
+
+
+def evaluate(nodes: list[Node], regions: list[Region], x: Vec) -> float:
+    idx = 0
+    while idx >= 0:
+        n = nodes[idx]
+        idx = n.yes if dot(n.h, x) <= n.c else n.no
+    r = regions[-idx - 1]
+    return dot(r.f, x) + r.g
+
+
+def direct_solution(k: Vec, x: Vec) -> float:
+    p, d = x[IDX_UPREV], x[IDX_DUMAX]
+    lo = max(-d, -1.0 - p)
+    hi = min(d, 1.0 - p)
+    return p + min(max(dot(k, x), lo), hi)
+
+
+def verify(nodes: list[Node], regions: list[Region], k: Vec, samples: int,
+           rng: random.Random) -> float:
+    worst = 0.0
+    for _ in range(samples):
+        x = [
+            rng.uniform(-2.0, 2.0),     # vy, m/s
+            rng.uniform(-8.0, 8.0),     # r, rad/s
+            rng.uniform(-8.0, 8.0),     # r_ref, rad/s
+            rng.uniform(-1.0, 1.0),     # u_prev
+            rng.uniform(0.0, 0.05),     # du_max
+        ]
+        worst = max(worst, abs(evaluate(nodes, regions, x) - direct_solution(k, x)))
+    return worst
+
+
+# ---------------------------------------------------------------------------
+# Output
+# ---------------------------------------------------------------------------
+
+
+def fmt_f(v: float) -> str:
+    if v == 0.0:
+        v = 0.0  # no "-0.0f"
+    s = f"{v:.9g}"
+    if "e" not in s and "." not in s:
+        s += ".0"
+    return s + "f"
+
+
+def fmt_vec(v: Vec) -> str:
+    return "{" + ", ".join(fmt_f(x) for x in v) + "}"
+
+
+def emit_header(model: VehicleModel, w: MpcWeights,
+                bins: list[tuple[float, list[Node], list[Region]]]) -> str:
+    n_nodes = len(bins[0][1])
+    n_regions = len(bins[0][2])
+    out: list[str] = []
+    out.append("#pragma once")
+    out.append("")
+    out.append("// Сгенерировано tools/gen_yaw_mpc.py — не редактировать вручную.")
+    out.append("//")
+    out.append(f"// Модель: m={model.mass_kg} кг, Iz={model.iz_kgm2} кг·м², "
+               f"lf={model.lf_m} м, lr={model.lr_m} м,")
+    out.append(f"//         Cf={model.cf_n_rad} Н/рад, Cr={model.cr_n_rad} Н/рад, "
+               f"delta_max={math.degrees(model.delta_max_rad):.1f}°")
+    out.append(f"// MPC:    N={w.horizon}, Ts={w.ts_s * 1000:.0f} мс, q_r={w.q_r}, "
+               f"q_vy={w.q_vy}, rho={w.rho}")
+    out.append("")
+    out.append('#include "explicit_mpc.hpp"')
+    out.append("")
+    out.append("namespace rc_vehicle::yaw_mpc {")
+    out.append("")
+    out.append("/// Шаг модели, с (= период control loop): du_max = slew_steering · kTsS")
+    out.append(f"inline constexpr float kTsS = {fmt_f(w.ts_s)};")
+    out.append(f"inline constexpr int kSpeedBinCount = {len(bins)};")
+    out.append(f"inline constexpr int kNodesPerBin = {n_nodes};")
+    out.append(f"inline constexpr int kRegionsPerBin = {n_regions};")
+    out.append("")
+    out.append("/** Скорости узлов сетки (м/с), по возрастанию. */")
+    out.append("inline constexpr float kSpeedGridMs[kSpeedBinCount] = "
+               + fmt_vec([b[0] for b in bins]) + ";")
+    out.append("")
+    out.append("inline constexpr ExplicitMpcNode kNodes[kSpeedBinCount][kNodesPerBin] = {")
+    for vx, nodes, _ in bins:
+        out.append(f"    // vx = {vx} м/с")
+        out.append("    {")
+        for n in nodes:
+            out.append(f"        {{{fmt_vec(n.h)}, {fmt_f(n.c)}, {n.yes}, {n.no}}},")
+        out.append("    },")
+    out.append("};")
+    out.append("")
+    out.append(
+        "inline constexpr ExplicitMpcRegion kRegions[kSpeedBinCount][kRegionsPerBin] = {")
+    for vx, _, regions in bins:
+        out.append(f"    // vx = {vx} м/с")
+        out.append("    {")
+        for r in regions:
+            out.append(f"        {{{fmt_vec(r.f)}, {fmt_f(r.g)}}},  // {r.name}")
+        out.append("    },")
+    out.append("};")
+    out.append("")
+    out.append("}  // namespace rc_vehicle::yaw_mpc")
+    out.append("")
+    return "\n".join(out)
+
+
+# ---------------------------------------------------------------------------
+# CLI
+# ---------------------------------------------------------------------------
+
+
+def parse_args() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(
+        description="Generate the explicit yaw-rate MPC table header.",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+    )
+    parser.add_argument("--out", type=Path, default=DEFAULT_OUT,
+                        help="Output header (default: firmware/common/yaw_mpc_table.hpp)")
+    parser.add_argument("--speeds", type=float, nargs="+", default=DEFAULT_SPEED_GRID,
+                        help="Speed grid, m/s (ascending)")
+    parser.add_argument("--mass", type=float, default=1.6, help="Vehicle mass, kg")
+    parser.add_argument("--iz", type=float, default=0.025, help="Yaw inertia, kg*m^2")
+    parser.add_argument("--lf", type=float, default=0.13, help="CoG to front axle, m")
+    parser.add_argument("--lr", type=float, default=0.13, help="CoG to rear axle, m")
+    parser.add_argument("--cf", type=float, default=25.0, help="Front cornering stiffness, N/rad")
+    parser.add_argument("--cr", type=float, default=30.0, help="Rear cornering stiffness, N/rad")
+    parser.add_argument("--delta-max-deg", type=float, default=25.0,
+                        help="Wheel angle at full steering command, deg")
+    # Ts = control loop period (ControlLoopConfig::kPeriodMs): on the device
+    # du_max is the slew limiter's per-tick step. N·Ts = 100 ms.
+    parser.add_argument("--horizon", type=int, default=50, help="Prediction horizon, steps")
+    parser.add_argument("--ts", type=float, default=0.002,
+                        help="Prediction step, s (must equal the control loop period)")
+    parser.add_argument("--q-r", type=float, default=1.0, help="Yaw-rate error weight")
+    parser.add_argument("--q-vy", type=float, default=0.5, help="Lateral velocity weight")
+    # The cost sums over N steps: 2 ms steps give 5x the terms of 10 ms ones,
+    # so rho x5 keeps the tracking/move balance of the 10 ms table.
+    parser.add_argument("--rho", type=float, default=0.25, help="Steering move weight")
+    parser.add_argument("--verify-samples", type=int, default=20000,
+                        help="Random samples per bin checked against the direct QP solution")
+    return parser.parse_args()
+
+
+def main() -> int:
+    args = parse_args()
+    speeds = sorted(args.speeds)
+    if speeds[0] <= 0.0:
+        print("error: speed grid must be positive (model is singular at vx=0)",
+              file=sys.stderr)
+        return 1
+
+    model = VehicleModel(args.mass, args.iz, args.lf, args.lr, args.cf, args.cr,
+                         math.radians(args.delta_max_deg))
+    weights = MpcWeights(args.q_r, args.q_vy, args.rho, args.horizon, args.ts)
+    rng = random.Random(0)
+
+    bins = []
+    for vx in speeds:
+        ad, bd = discretize(model, vx, weights.ts_s)
+        k = unconstrained_gain(ad, bd, weights)
+        nodes, regions = build_partition(k)
+        err = verify(nodes, regions, k, args.verify_samples, rng)
+        if err > 1e-9:
+            print(f"error: vx={vx}: tree disagrees with QP solution (max err {err:.3g})",
+                  file=sys.stderr)
+            return 1
+        print(f"vx={vx:4.1f} m/s  K=[{', '.join(f'{v:+.4f}' for v in k)}]  ok")
+        bins.append((vx, nodes, regions))
+
+    args.out.write_text(emit_header(model, weights, bins), encoding="utf-8")
+    print(f"Wrote {args.out} ({len(bins)} bins)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
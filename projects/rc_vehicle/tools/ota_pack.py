@@ -0,0 +1,248 @@
+#!/usr/bin/env python3
+"""
+RC Vehicle OTA image packer and uploader.
+
+Wraps an ESP-IDF app image (build/rc_vehicle_esp32_s3.bin) into the OTA
+container accepted by POST /api/ota (see common/ota_update.hpp): a 32-byte
+header followed by an LZSS-compressed payload that the firmware decompresses
+incrementally into the inactive OTA slot.
+
+Usage:
+    # Pack only
+    python3 ota_pack.py pack build/rc_vehicle_esp32_s3.bin -o fw.rcota
+
+    # Pack (if given a .bin) and upload; the car must be standing still
+    python3 ota_pack.py upload fw.rcota --esp 192.168.4.1
+    python3 ota_pack.py upload build/rc_vehicle_esp32_s3.bin --esp 192.168.4.1
+
+    # Verify a container (decompress and check CRC)
+    python3 ota_pack.py verify fw.rcota
+
+No external dependencies — uses only Python standard library.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import struct
+import sys
+import time
+import urllib.error
+import urllib.request
+import zlib
+from pathlib import Path
+
+# ---------------------------------------------------------------------------
+# Container format (must match OtaImageHeader in common/ota_update.hpp)
+# ---------------------------------------------------------------------------
+
+MAGIC = 0x544F4352  # "RCOT"
+VERSION = 1
+CODEC_STORE = 0
+CODEC_LZSS = 1
+HEADER_FMT = "<IHBBIIIII"  # без header_crc32
+HEADER_SIZE = 32
+
+WINDOW = 4096
+MIN_MATCH = 3
+MAX_MATCH = 18
+MAX_CANDIDATES = 64  # Глубина поиска по хеш-цепочке
+
+
+def lzss_compress(data: bytes) -> bytes:
+    """Greedy LZSS: flag byte (LSB first, 1 = literal), 2-byte references
+    (12-bit offset-1, 4-bit length-3)."""
+    out = bytearray()
+    chains: dict[bytes, list[int]] = {}
+    i = 0
+    n = len(data)
+    flags_pos = -1
+    flag_bit = 8
+
+    def start_item() -> None:
+        nonlocal flags_pos, flag_bit
+        if flag_bit == 8:
+            flags_pos = len(out)
+            out.append(0)
+            flag_bit = 0
+
+    def insert(pos: int) -> None:
+        if pos + MIN_MATCH <= n:
+            chains.setdefault(data[pos:pos + MIN_MATCH], []).append(pos)
+
+    while i < n:
+        best_len = 0
+        best_off = 0
+        if i + MIN_MATCH <= n:
+            cands = chains.get(data[i:i + MIN_MATCH], [])
+            limit = min(MAX_MATCH, n - i)
+            for p in reversed(cands[-MAX_CANDIDATES:]):
+                off = i - p
+                if off > WINDOW:
+                    break
+                length = MIN_MATCH
+                while length < limit and data[p + length] == data[i + length]:
+                    length += 1
+                if length > best_len:
+                    best_len, best_off = length, off
+                    if length == limit:
+                        break
+        start_item()
+        if best_len >= MIN_MATCH:
+            ref = ((best_len - MIN_MATCH) << 12) | (best_off - 1)
+            out += struct.pack("<H", ref)
+            for k in range(best_len):
+                insert(i + k)
+            i += best_len
+        else:
+            out[flags_pos] |= 1 << flag_bit
+            out.append(data[i])
+            insert(i)
+            i += 1
+        flag_bit += 1
+    return bytes(out)
+
+
+def lzss_decompress(payload: bytes) -> bytes:
+    out = bytearray()
+    i = 0
+    while i < len(payload):
+        flags = payload[i]
+        i += 1
+        for bit in range(8):
+            if i >= len(payload):
+                break
+            if flags & (1 << bit):
+                out.append(payload[i])
+                i += 1
+            else:
+                (ref,) = struct.unpack_from("<H", payload, i)
+                i += 2
+                off = (ref & 0x0FFF) + 1
+                length = (ref >> 12) + MIN_MATCH
+                if off > len(out):
+                    raise ValueError("corrupt LZSS stream")
+                for _ in range(length):
+                    out.append(out[-off])
+    return bytes(out)
+
+
+def pack(raw: bytes, codec: int = CODEC_LZSS, build_id: int = 0) -> bytes:
+    payload = lzss_compress(raw) if codec == CODEC_LZSS else raw
+    head = struct.pack(HEADER_FMT, MAGIC, VERSION, codec, 0, len(raw),
+                       len(payload), zlib.crc32(raw), 0, build_id)
+    return head + struct.pack("<I", zlib.crc32(head)) + payload
+
+
+def unpack(image: bytes) -> tuple[dict, bytes]:
+    if len(image) < HEADER_SIZE:
+        raise ValueError("too short")
+    fields = struct.unpack_from(HEADER_FMT, image)
+    (magic, version, codec, _, raw_size, payload_size, raw_crc, _,
+     build_id) = fields
+    (head_crc,) = struct.unpack_from("<I", image, HEADER_SIZE - 4)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("not an RC vehicle OTA image")
+    if zlib.crc32(image[:HEADER_SIZE - 4]) != head_crc:
+        raise ValueError("header CRC mismatch")
+    payload = image[HEADER_SIZE:]
+    if len(payload) != payload_size:
+        raise ValueError("payload size mismatch")
+    raw = lzss_decompress(payload) if codec == CODEC_LZSS else payload
+    if len(raw) != raw_size or zlib.crc32(raw) != raw_crc:
+        raise ValueError("image CRC mismatch")
+    info = {"codec": codec, "raw_size": raw_size,
+            "payload_size": payload_size, "build_id": build_id}
+    return info, raw
+
+
+def load_image(path: Path, build_id: int) -> bytes:
+    data = path.read_bytes()
+    if data[:4] == struct.pack("<I", MAGIC):
+        return data
+    packed = pack(data, build_id=build_id)
+    print(f"Packed {len(data)} -> {len(packed)} bytes "
+          f"({100.0 * len(packed) / len(data):.1f} %)")
+    return packed
+
+
+# ---------------------------------------------------------------------------
+# Commands
+# ---------------------------------------------------------------------------
+
+def cmd_pack(args: argparse.Namespace) -> int:
+    raw = args.bin.read_bytes()
+    codec = CODEC_STORE if args.store else CODEC_LZSS
+    t0 = time.monotonic()
+    image = pack(raw, codec, args.build_id)
+    out = args.output or args.bin.with_suffix(".rcota")
+    out.write_bytes(image)
+    print(f"{args.bin} ({len(raw)} bytes) -> {out} ({len(image)} bytes, "
+          f"{100.0 * len(image) / len(raw):.1f} %, "
+          f"{time.monotonic() - t0:.1f} s)")
+    return 0
+
+
+def cmd_verify(args: argparse.Namespace) -> int:
+    try:
+        info, _ = unpack(args.image.read_bytes())
+    except ValueError as e:
+        print(f"{args.image}: {e}", file=sys.stderr)
+        return 1
+    print(f"{args.image}: OK {json.dumps(info)}")
+    return 0
+
+
+def cmd_upload(args: argparse.Namespace) -> int:
+    image = load_image(args.image, args.build_id)
+    url = f"http://{args.esp}/api/ota"
+    req = urllib.request.Request(
+        url, data=image, method="POST",
+        headers={"Content-Type": "application/octet-stream"})
+    t0 = time.monotonic()
+    try:
+        with urllib.request.urlopen(req, timeout=args.timeout) as resp:
+            body = resp.read().decode()
+    except urllib.error.HTTPError as e:
+        print(f"Update refused ({e.code}): {e.read().decode()}",
+              file=sys.stderr)
+        return 1
+    except urllib.error.URLError as e:
+        print(f"Upload failed: {e.reason}", file=sys.stderr)
+        return 1
+    print(f"Uploaded {len(image)} bytes in {time.monotonic() - t0:.1f} s: "
+          f"{body}")
+    print("Device reboots into the new image; it is confirmed after the "
+          "self-test passes (see /api/ota/status).")
+    return 0
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("pack", help="pack app .bin into an OTA image")
+    p.add_argument("bin", type=Path)
+    p.add_argument("-o", "--output", type=Path)
+    p.add_argument("--store", action="store_true", help="no compression")
+    p.add_argument("--build-id", type=int, default=0)
+    p.set_defaults(func=cmd_pack)
+
+    p = sub.add_parser("verify", help="check an OTA image")
+    p.add_argument("image", type=Path)
+    p.set_defaults(func=cmd_verify)
+
+    p = sub.add_parser("upload", help="POST an image (or .bin) to the car")
+    p.add_argument("image", type=Path)
+    p.add_argument("--esp", default="192.168.4.1")
+    p.add_argument("--build-id", type=int, default=0)
+    p.add_argument("--timeout", type=float, default=120.0)
+    p.set_defaults(func=cmd_upload)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
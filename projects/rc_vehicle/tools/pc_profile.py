@@ -0,0 +1,347 @@
+#!/usr/bin/env python3
+"""
+RC Vehicle statistical profiler client.
+
+Drives the on-device PC sampler (esp32_common/pc_sampler.*) over HTTP,
+downloads the per-core histogram (profile.bin) and symbolizes it against
+the firmware ELF into folded stacks ("task;root;...;leaf count") for
+flamegraph.pl, speedscope or inferno.
+
+Usage:
+    # Full cycle: start at 997 Hz, sample 10 s, stop, download, fold
+    python3 pc_profile.py record --esp 192.168.4.1 --seconds 10 \\
+        --elf ../firmware/esp32_s3/build/rc_vehicle_esp32_s3.elf \\
+        --out profile.folded
+
+    # Step by step
+    python3 pc_profile.py start --esp 192.168.4.1 --hz 2000 --depth 4
+    python3 pc_profile.py status --esp 192.168.4.1
+    python3 pc_profile.py stop --esp 192.168.4.1
+    python3 pc_profile.py download --esp 192.168.4.1 --bin profile.bin
+    python3 pc_profile.py fold profile.bin --elf app.elf --out profile.folded
+
+    # Flat per-function summary instead of folded stacks
+    python3 pc_profile.py fold profile.bin --elf app.elf --top 30
+
+Samples that hit a nested interrupt carry no stack and are reported as
+"[isr]". Without --elf the raw addresses are emitted.
+No external dependencies; addresses are resolved with
+xtensa-esp32s3-elf-addr2line if found.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import shutil
+import struct
+import subprocess
+import sys
+import time
+import urllib.error
+import urllib.request
+from collections import defaultdict
+from dataclasses import dataclass
+from pathlib import Path
+
+# ---------------------------------------------------------------------------
+# profile.bin format (common/pc_profile.hpp)
+# ---------------------------------------------------------------------------
+
+MAGIC = 0x46504350  # "PCPF"
+VERSION = 1
+HEADER_FMT = "<IHHIHHIIIIBBH"
+HEADER_SIZE = struct.calcsize(HEADER_FMT)  # 36
+MAX_DEPTH = 6
+ENTRY_FMT = f"<IIBBH{MAX_DEPTH}I"
+ENTRY_SIZE = struct.calcsize(ENTRY_FMT)  # 36
+TASK_FMT = "<I16s"
+TASK_SIZE = struct.calcsize(TASK_FMT)  # 20
+
+ISR_FRAME = "[isr]"
+DEFAULT_HZ = 997  # config::PcProfilerConfig::kDefaultHz
+
+
+@dataclass
+class Profile:
+    samples: int
+    dropped: int
+    hz: int
+    duration_ms: int
+    cores: int
+    # (count, task, core, [pc leaf→root])
+    entries: list[tuple[int, int, int, list[int]]]
+    tasks: dict[int, str]
+
+
+def parse_profile(data: bytes) -> Profile:
+    if len(data) < HEADER_SIZE:
+        raise ValueError("profile.bin: truncated header")
+    (magic, version, entry_size, entry_count, task_size, task_count, samples,
+     dropped, hz, duration_ms, _max_depth, cores, _) = struct.unpack_from(
+        HEADER_FMT, data, 0)
+    if magic != MAGIC:
+        raise ValueError(f"profile.bin: bad magic 0x{magic:08X}")
+    if version != VERSION or entry_size != ENTRY_SIZE or task_size != TASK_SIZE:
+        raise ValueError(f"profile.bin: unsupported version {version} "
+                         f"(entry {entry_size} B, task {task_size} B)")
+    need = HEADER_SIZE + entry_count * ENTRY_SIZE + task_count * TASK_SIZE
+    if len(data) < need:
+        raise ValueError(f"profile.bin: {len(data)} bytes, expected {need}")
+
+    entries = []
+    off = HEADER_SIZE
+    for _ in range(entry_count):
+        count, task, core, depth, _, *pcs = struct.unpack_from(ENTRY_FMT, data, off)
+        entries.append((count, task, core, pcs[:min(depth, MAX_DEPTH)]))
+        off += ENTRY_SIZE
+    tasks = {}
+    for _ in range(task_count):
+        task, name = struct.unpack_from(TASK_FMT, data, off)
+        tasks[task] = name.split(b"\0", 1)[0].decode("ascii", "replace")
+        off += TASK_SIZE
+    return Profile(samples, dropped, hz, duration_ms, cores, entries, tasks)
+
+
+# ---------------------------------------------------------------------------
+# Symbolization
+# ---------------------------------------------------------------------------
+
+def symbolize(pcs: set[int], elf: str | None) -> dict[int, str]:
+    """PC → function name (inlined frames joined root-first with ';')."""
+    names = {pc: f"0x{pc:08x}" for pc in pcs}
+    if not elf or not pcs:
+        return names
+    tool = next((t for t in ("xtensa-esp32s3-elf-addr2line", "addr2line")
+                 if shutil.which(t)), None)
+    if tool is None:
+        print("addr2line not found, emitting raw addresses", file=sys.stderr)
+        return names
+
+    ordered = sorted(pcs)
+    # -a печатает адрес перед каждой группой: по нему режем вывод на кадры
+    # с учётом инлайнинга (-i даёт несколько функций на один адрес)
+    try:
+        out = subprocess.run([tool, "-fiaC", "-e", elf],
+                             input="\n".join(f"0x{pc:x}" for pc in ordered),
+                             text=True, capture_output=True, check=True).stdout
+    except (OSError, subprocess.CalledProcessError) as e:
+        print(f"addr2line failed: {e}", file=sys.stderr)
+        return names
+
+    current: int | None = None
+    funcs: list[str] = []
+
+    def flush() -> None:
+        if current is not None and funcs:
+            # addr2line: самый глубокий инлайн первым → разворачиваем
+            names[current] = ";".join(reversed(funcs))
+
+    lines = out.splitlines()
+    i = 0
+    while i < len(lines):
+        line = lines[i]
+        if line.startswith("0x"):
+            flush()
+            current = int(line, 16)
+            funcs = []
+            i += 1
+            continue
+        func = line.strip()
+        if func and func != "??":
+            funcs.append(func)
+        i += 2  # function + file:line
+    flush()
+    return names
+
+
+# ---------------------------------------------------------------------------
+# Folding
+# ---------------------------------------------------------------------------
+
+def fold(profile: Profile, elf: str | None) -> dict[str, int]:
+    pcs = {pc for _, _, _, stack in profile.entries for pc in stack}
+    names = symbolize(pcs, elf)
+    folded: dict[str, int] = defaultdict(int)
+    for count, task, core, stack in profile.entries:
+        if task == 0 or not stack:
+            key = f"{ISR_FRAME} core{core}"
+        else:
+            task_name = profile.tasks.get(task, f"task_0x{task:08x}")
+            frames = [names[pc] for pc in reversed(stack)]
+            key = ";".join([task_name, *frames])
+        folded[key] += count
+    return folded
+
+
+def flat(folded: dict[str, int]) -> dict[str, int]:
+    """Self samples per leaf function."""
+    out: dict[str, int] = defaultdict(int)
+    for stack, count in folded.items():
+        out[stack.rsplit(";", 1)[-1]] += count
+    return out
+
+
+def print_summary(profile: Profile) -> None:
+    total = profile.samples + profile.dropped
+    pct = 100.0 * profile.dropped / total if total else 0.0
+    print(f"{profile.samples} samples ({profile.dropped} dropped, {pct:.1f}%), "
+          f"{len(profile.entries)} stacks, {len(profile.tasks)} tasks, "
+          f"{profile.hz} Hz x {profile.cores} cores, "
+          f"{profile.duration_ms / 1000:.1f} s", file=sys.stderr)
+
+
+# ---------------------------------------------------------------------------
+# HTTP
+# ---------------------------------------------------------------------------
+
+def http(esp: str, method: str, path: str, timeout: float = 10.0) -> bytes:
+    req = urllib.request.Request(f"http://{esp}{path}", method=method)
+    try:
+        with urllib.request.urlopen(req, timeout=timeout) as resp:
+            return resp.read()
+    except urllib.error.HTTPError as e:
+        body = e.read().decode("utf-8", "replace")
+        raise RuntimeError(f"{method} {path}: HTTP {e.code} {body}") from e
+
+
+def http_json(esp: str, method: str, path: str) -> dict:
+    return json.loads(http(esp, method, path))
+
+
+def print_status(st: dict) -> None:
+    if st.get("error"):
+        print(f"error: {st['error']}")
+    print(f"running={st['running']} hz={st['hz']} depth={st['depth']} "
+          f"samples={st['samples']} dropped={st['dropped']} "
+          f"stacks={st['entries']}/{st['capacity']} "
+          f"duration={st['duration_ms']} ms")
+
+
+def cmd_start(args: argparse.Namespace) -> int:
+    st = http_json(args.esp, "POST",
+                   f"/api/profile?action=start&hz={args.hz}&depth={args.depth}")
+    print_status(st)
+    return 0 if st.get("ok") else 1
+
+
+def cmd_stop(args: argparse.Namespace) -> int:
+    st = http_json(args.esp, "POST", "/api/profile?action=stop")
+    print_status(st)
+    return 0 if st.get("ok") else 1
+
+
+def cmd_status(args: argparse.Namespace) -> int:
+    print_status(http_json(args.esp, "GET", "/api/profile/status"))
+    return 0
+
+
+def cmd_download(args: argparse.Namespace) -> int:
+    data = http(args.esp, "GET", "/api/profile.bin", timeout=30.0)
+    Path(args.bin).write_bytes(data)
+    print(f"Saved {len(data)} bytes to {args.bin}", file=sys.stderr)
+    print_summary(parse_profile(data))
+    return 0
+
+
+def write_output(profile: Profile, args: argparse.Namespace) -> int:
+    print_summary(profile)
+    folded = fold(profile, args.elf)
+    if args.top:
+        total = sum(folded.values()) or 1
+        ranked = sorted(flat(folded).items(), key=lambda kv: -kv[1])
+        for name, count in ranked[:args.top]:
+            print(f"{100.0 * count / total:6.2f}% {count:8d}  {name}")
+        return 0
+    lines = [f"{stack} {count}" for stack, count in
+             sorted(folded.items(), key=lambda kv: -kv[1])]
+    text = "\n".join(lines) + "\n"
+    if args.out:
+        Path(args.out).write_text(text)
+        print(f"Wrote {len(lines)} folded stacks to {args.out}", file=sys.stderr)
+    else:
+        sys.stdout.write(text)
+    return 0
+
+
+def cmd_fold(args: argparse.Namespace) -> int:
+    return write_output(parse_profile(Path(args.bin).read_bytes()), args)
+
+
+def cmd_record(args: argparse.Namespace) -> int:
+    if cmd_start(args) != 0:
+        return 1
+    try:
+        time.sleep(args.seconds)
+    except KeyboardInterrupt:
+        print("\nInterrupted, stopping early", file=sys.stderr)
+    if cmd_stop(args) != 0:
+        return 1
+    data = http(args.esp, "GET", "/api/profile.bin", timeout=30.0)
+    if args.bin:
+        Path(args.bin).write_bytes(data)
+    return write_output(parse_profile(data), args)
+
+
+def add_output_args(p: argparse.ArgumentParser) -> None:
+    p.add_argument("--elf", help="Firmware ELF for symbolization")
+    p.add_argument("--out", help="Folded stacks file (default: stdout)")
+    p.add_argument("--top", type=int, default=0,
+                   help="Print top-N self functions instead of folded stacks")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="RC Vehicle statistical profiler client",
+    )
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    # record
+    p = sub.add_parser("record", help="Start, sample N seconds, stop, download, fold")
+    p.add_argument("--esp", required=True, help="ESP32 IP address")
+    p.add_argument("--hz", type=int, default=DEFAULT_HZ, help="Samples per second per core (default: 997)")
+    p.add_argument("--depth", type=int, default=MAX_DEPTH, help="Stack frames per sample (default: 6)")
+    p.add_argument("--seconds", type=float, default=10.0, help="Duration (default: 10)")
+    p.add_argument("--bin", help="Also keep the raw profile.bin")
+    add_output_args(p)
+    p.set_defaults(func=cmd_record)
+
+    # start
+    p = sub.add_parser("start", help="Clear and start sampling")
+    p.add_argument("--esp", required=True, help="ESP32 IP address")
+    p.add_argument("--hz", type=int, default=DEFAULT_HZ, help="Samples per second per core (default: 997)")
+    p.add_argument("--depth", type=int, default=MAX_DEPTH, help="Stack frames per sample (default: 6)")
+    p.set_defaults(func=cmd_start)
+
+    # stop
+    p = sub.add_parser("stop", help="Stop sampling (histogram is kept)")
+    p.add_argument("--esp", required=True, help="ESP32 IP address")
+    p.set_defaults(func=cmd_stop)
+
+    # status
+    p = sub.add_parser("status", help="Query profiler status")
+    p.add_argument("--esp", required=True, help="ESP32 IP address")
+    p.set_defaults(func=cmd_status)
+
+    # download
+    p = sub.add_parser("download", help="Download profile.bin (after stop)")
+    p.add_argument("--esp", required=True, help="ESP32 IP address")
+    p.add_argument("--bin", default="profile.bin", help="Output file (default: profile.bin)")
+    p.set_defaults(func=cmd_download)
+
+    # fold
+    p = sub.add_parser("fold", help="Symbolize profile.bin into folded stacks")
+    p.add_argument("bin", help="profile.bin")
+    add_output_args(p)
+    p.set_defaults(func=cmd_fold)
+
+    args = parser.parse_args()
+    try:
+        sys.exit(args.func(args))
+    except (RuntimeError, ValueError, OSError) as e:
+        print(f"error: {e}", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
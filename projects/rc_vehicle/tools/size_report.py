@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+"""
+RC Vehicle firmware size report from the GNU ld map file.
+
+Breaks the image down per component (static library) and per symbol
+(input section), split into flash-resident code/rodata, IRAM, initialised
+DRAM data and BSS, and checks the totals against a budget.
+
+Usage:
+    python3 size_report.py build/rc_vehicle_esp32_s3.map
+    python3 size_report.py build/rc_vehicle_esp32_s3.map --top 40
+    python3 size_report.py build/app.map --bin build/app.bin \\
+        --budget-flash-kb 1600 --budget-ram-kb 256
+
+Exit code 1 if a budget is exceeded (usable as a CI gate).
+No external dependencies; symbols are demangled with c++filt if found.
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+import shutil
+import subprocess
+import sys
+from collections import defaultdict
+from dataclasses import dataclass, field
+from pathlib import Path
+
+# ---------------------------------------------------------------------------
+# Output section → region
+# ---------------------------------------------------------------------------
+
+# Region names (columns of the report)
+FLASH_TEXT = "flash_text"
+FLASH_RODATA = "flash_rodata"
+IRAM = "iram"
+DRAM_DATA = "dram_data"
+BSS = "bss"
+REGIONS = [FLASH_TEXT, FLASH_RODATA, IRAM, DRAM_DATA, BSS]
+
+# Regions stored in the image (flash) and resident in internal RAM
+IMAGE_REGIONS = {FLASH_TEXT, FLASH_RODATA, IRAM, DRAM_DATA}
+RAM_REGIONS = {IRAM, DRAM_DATA, BSS}
+
+
+def classify_output_section(name: str) -> str | None:
+    """Map an ESP-IDF output section name to a report region."""
+    if name.startswith(".flash.text") or name == ".flash.appdesc":
+        return FLASH_TEXT
+    if name.startswith(".flash.") or name.startswith(".flash_rodata"):
+        return FLASH_RODATA
+    if name.startswith(".iram") or name.startswith(".rtc.text"):
+        return IRAM
+    if name.endswith(".bss") or name.endswith(".noinit"):
+        return BSS
+    if name.startswith(".dram") or name.startswith(".rtc"):
+        return DRAM_DATA
+    return None
+
+
+# ---------------------------------------------------------------------------
+# Map file parsing
+# ---------------------------------------------------------------------------
+
+# Output section header at column 0: ".flash.text  0x42000020  0x9a5c3"
+OUT_SECTION_RE = re.compile(r"^(\.\S+)(?:\s+0x[0-9a-f]+\s+0x[0-9a-f]+)?\s*$")
+# Input section, optionally with the name on the previous line:
+#   " .text.foo  0x42001234  0x58 esp-idf/main/libmain.a(main.cpp.obj)"
+INPUT_RE = re.compile(
+    r"^\s(\.\S+)?\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S.*)$")
+ARCHIVE_RE = re.compile(r"(?:^|/)lib([^/()]+)\.a\(([^)]+)\)$")
+
+
+@dataclass
+class SizeEntry:
+    sizes: dict[str, int] = field(
+        default_factory=lambda: {r: 0 for r in REGIONS})
+
+    def add(self, region: str, size: int) -> None:
+        self.sizes[region] += size
+
+    @property
+    def image(self) -> int:
+        return sum(self.sizes[r] for r in IMAGE_REGIONS)
+
+    @property
+    def ram(self) -> int:
+        return sum(self.sizes[r] for r in RAM_REGIONS)
+
+
+@dataclass
+class SizeReport:
+    components: dict[str, SizeEntry]
+    symbols: dict[tuple[str, str], SizeEntry]
+    total: SizeEntry
+
+
+def component_of(obj: str) -> str:
+    """'esp-idf/main/libmain.a(x.obj)' → 'main'; bare objects → file name."""
+    m = ARCHIVE_RE.search(obj)
+    if m:
+        return m.group(1)
+    return Path(obj.split("(")[0]).name or obj
+
+
+def symbol_of(section: str) -> str:
+    """'.text._ZN3fooEv' → '_ZN3fooEv'; plain '.text' kept as is."""
+    for prefix in (".text.", ".rodata.", ".data.", ".bss.", ".iram1.",
+                   ".dram1.", ".literal.", ".sbss.", ".sdata."):
+        if section.startswith(prefix) and len(section) > len(prefix):
+            return section[len(prefix):]
+    return section
+
+
+def parse_map(lines: list[str]) -> SizeReport:
+    components: dict[str, SizeEntry] = defaultdict(SizeEntry)
+    symbols: dict[tuple[str, str], SizeEntry] = defaultdict(SizeEntry)
+    total = SizeEntry()
+
+    in_memory_map = False
+    region: str | None = None
+    pending_section: str | None = None
+    for line in lines:
+        line = line.rstrip("\n")
+        if not in_memory_map:
+            in_memory_map = line.startswith("Linker script and memory map")
+            continue
+        if line.startswith("."):
+            m = OUT_SECTION_RE.match(line)
+            region = classify_output_section(m.group(1)) if m else None
+            pending_section = None
+            continue
+        if region is None:
+            continue
+        # Длинное имя входной секции — на отдельной строке
+        stripped = line.strip()
+        if line.startswith(" .") and len(stripped.split()) == 1:
+            pending_section = stripped
+            continue
+        m = INPUT_RE.match(line)
+        if not m:
+            pending_section = None
+            continue
+        section = m.group(1) or pending_section
+        pending_section = None
+        size = int(m.group(3), 16)
+        obj = m.group(4).strip()
+        if section is None or size == 0 or obj.startswith("*"):
+            continue
+        comp = component_of(obj)
+        components[comp].add(region, size)
+        symbols[(symbol_of(section), comp)].add(region, size)
+        total.add(region, size)
+    return SizeReport(dict(components), dict(symbols), total)
+
+
+def demangle(names: list[str]) -> dict[str, str]:
+    tool = next((t for t in ("xtensa-esp32s3-elf-c++filt", "c++filt")
+                 if shutil.which(t)), None)
+    if tool is None or not names:
+        return {n: n for n in names}
+    try:
+        out = subprocess.run([tool], input="\n".join(names), text=True,
+                             capture_output=True, check=True).stdout
+    except (OSError, subprocess.CalledProcessError):
+        return {n: n for n in names}
+    return dict(zip(names, out.splitlines()))
+
+
+# ---------------------------------------------------------------------------
+# Output
+# ---------------------------------------------------------------------------
+
+def print_table(title: str, rows: list[tuple[str, SizeEntry]],
+                name_width: int) -> None:
+    header = "".join(f"{r:>13}" for r in REGIONS)
+    print(f"\n{title}")
+    print(f"  {'name':<{name_width}}{header}{'image':>10}{'ram':>9}")
+    for name, e in rows:
+        cols = "".join(f"{e.sizes[r]:>13}" for r in REGIONS)
+        shown = name if len(name) <= name_width else name[:name_width - 1] + "…"
+        print(f"  {shown:<{name_width}}{cols}{e.image:>10}{e.ram:>9}")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("map", type=Path, help="linker map file")
+    parser.add_argument("--bin", type=Path, help="app .bin (actual image size)")
+    parser.add_argument("--top", type=int, default=25,
+                        help="symbols to list (default 25)")
+    parser.add_argument("--budget-flash-kb", type=float,
+                        help="fail if the app image exceeds this size")
+    parser.add_argument("--budget-ram-kb", type=float,
+                        help="fail if static internal RAM exceeds this size")
+    args = parser.parse_args()
+
+    report = parse_map(args.map.read_text(errors="replace").splitlines())
+    if not report.components:
+        print(f"No sections found in {args.map}", file=sys.stderr)
+        return 2
+
+    comps = sorted(report.components.items(),
+                   key=lambda kv: kv[1].image + kv[1].sizes[BSS],
+                   reverse=True)
+    print_table("Per component [bytes]", comps, 28)
+
+    top = sorted(report.symbols.items(),
+                 key=lambda kv: kv[1].image + kv[1].sizes[BSS],
+                 reverse=True)[:args.top]
+    names = demangle([sym for (sym, _), _ in top])
+    print_table(f"Top {len(top)} symbols [bytes]",
+                [(f"{names[sym]} [{comp}]", e) for (sym, comp), e in top], 60)
+
+    image = report.total.image
+    if args.bin and args.bin.exists():
+        image = args.bin.stat().st_size
+    ram = report.total.ram
+    print(f"\nImage: {image / 1024:.1f} KB   static RAM: {ram / 1024:.1f} KB")
+
+    ok = True
+    if args.budget_flash_kb is not None:
+        over = image / 1024 > args.budget_flash_kb
+        ok &= not over
+        print(f"  flash budget {args.budget_flash_kb:.0f} KB: "
+              f"{'EXCEEDED' if over else 'ok'}")
+    if args.budget_ram_kb is not None:
+        over = ram / 1024 > args.budget_ram_kb
+        ok &= not over
+        print(f"  RAM budget {args.budget_ram_kb:.0f} KB: "
+              f"{'EXCEEDED' if over else 'ok'}")
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
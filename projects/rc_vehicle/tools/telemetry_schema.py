@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""
+TelemetryLogFrame schema for host-side tools.
+
+Parses the single field registry RC_TELEMETRY_LOG_FIELDS in
+firmware/common/telemetry_fields.hpp, so Python decoders (UDP stream,
+log.bin) follow the firmware frame layout without a hand-copied field list.
+The device exposes the same schema at GET /api/log/schema.
+
+Usage:
+    from telemetry_schema import FIELD_NAMES, FRAME_FMT, FRAME_SIZE
+    values = struct.unpack_from(FRAME_FMT, data, offset)
+
+    python3 telemetry_schema.py          # print the field table
+
+No external dependencies — uses only Python standard library.
+"""
+
+from __future__ import annotations
+
+import re
+import struct
+from dataclasses import dataclass
+from pathlib import Path
+
+FIELDS_HEADER = (Path(__file__).resolve().parent.parent
+                 / "firmware" / "common" / "telemetry_fields.hpp")
+
+# C type -> (struct code, schema type name)
+_TYPES = {
+    "uint32_t": ("I", "u32"),
+    "float": ("f", "f32"),
+    "uint8_t": ("B", "u8"),
+}
+
+# X(type, name, "unit", group, "key")
+_FIELD_RE = re.compile(
+    r'X\(\s*(\w+)\s*,\s*(\w+)\s*,\s*"([^"]*)"\s*,\s*(\w+)\s*,\s*"([^"]*)"\s*\)')
+
+
+@dataclass(frozen=True)
+class Field:
+    name: str
+    type: str    # "u32" | "f32" | "u8"
+    offset: int  # byte offset in TelemetryLogFrame
+    unit: str
+
+
+def load_fields(header: Path = FIELDS_HEADER) -> list[Field]:
+    """Parse RC_TELEMETRY_LOG_FIELDS and compute packed field offsets."""
+    fields: list[Field] = []
+    offset = 0
+    for ctype, name, unit, _group, _key in _FIELD_RE.findall(header.read_text()):
+        code, type_name = _TYPES[ctype]
+        size = struct.calcsize("<" + code)
+        # Natural alignment, as in the C++ struct
+        offset = (offset + size - 1) // size * size
+        fields.append(Field(name, type_name, offset, unit))
+        offset += size
+    if not fields:
+        raise ValueError(f"no RC_TELEMETRY_LOG_FIELDS entries in {header}")
+    return fields
+
+
+def frame_size(fields: list[Field]) -> int:
+    """sizeof(TelemetryLogFrame): end of the last field, 4-byte aligned
+    (static_assert in telemetry_log.hpp)."""
+    codes = {t: c for c, t in _TYPES.values()}
+    last = fields[-1]
+    end = last.offset + struct.calcsize("<" + codes[last.type])
+    return (end + 3) // 4 * 4
+
+
+def frame_format(fields: list[Field], frame_size: int) -> str:
+    """struct format for the whole frame, tail padding included."""
+    codes = {t: c for c, t in _TYPES.values()}
+    fmt = "<"
+    pos = 0
+    for f in fields:
+        if f.offset > pos:
+            fmt += f"{f.offset - pos}x"
+        fmt += codes[f.type]
+        pos = f.offset + struct.calcsize("<" + codes[f.type])
+    if frame_size > pos:
+        fmt += f"{frame_size - pos}x"
+    return fmt
+
+
+FIELDS = load_fields()
+FRAME_SIZE = frame_size(FIELDS)
+FIELD_NAMES = [f.name for f in FIELDS]
+FRAME_FMT = frame_format(FIELDS, FRAME_SIZE)
+assert struct.calcsize(FRAME_FMT) == FRAME_SIZE, FRAME_FMT
+
+
+if __name__ == "__main__":
+    print(f"frame_size={FRAME_SIZE} fmt={FRAME_FMT}")
+    for f in FIELDS:
+        print(f"  {f.offset:4d}  {f.type:4s} {f.name:18s} {f.unit}")
@@ -3,7 +3,9 @@
 RC Vehicle UDP Telemetry Receiver & Controller.
 
 Receives binary telemetry frames from ESP32 over UDP and writes CSV.
-Also sends control commands (START/STOP/STATUS/PING) to ESP32.
+Also sends control commands (START/JOIN/LEAVE/MCAST/STOP/STATUS/PING) to
+ESP32 and can drive over the UDP command channel (port 5557, latest-wins
+datagrams).
 
 Usage:
     # Full cycle: start streaming, record to CSV, stop on Ctrl+C
@@ -12,12 +14,24 @@ Usage:
     # Just listen (streaming already started via WebSocket or other means)
     python3 udp_telem.py listen --csv output.csv
 
+    # Several receivers at once: each JOINs (logger, tuning UI, overlay box)
+    python3 udp_telem.py join --esp 192.168.4.1 --port 5555
+    python3 udp_telem.py leave --esp 192.168.4.1 --port 5555
+
+    # Or one multicast group for everyone: one radio transmission per frame
+    python3 udp_telem.py mcast --esp 192.168.4.1 --group 239.1.2.3 --port 5555
+    python3 udp_telem.py listen --group 239.1.2.3 --csv output.csv
+    python3 udp_telem.py mcast --esp 192.168.4.1 --off
+
     # Send commands only
     python3 udp_telem.py start --esp 192.168.4.1 --port 5555 --hz 100
     python3 udp_telem.py stop --esp 192.168.4.1
     python3 udp_telem.py status --esp 192.168.4.1
     python3 udp_telem.py ping --esp 192.168.4.1
 
+    # Drive over UDP: constant command at 50 Hz for 3 s, every packet sent twice
+    python3 udp_telem.py drive --esp 192.168.4.1 --throttle 0.2 --seconds 3 --dup 2
+
 No external dependencies — uses only Python standard library.
 """
 
@@ -33,6 +47,8 @@ import sys
 import time
 from pathlib import Path
 
+from telemetry_schema import FIELD_NAMES, FRAME_FMT, FRAME_SIZE
+
 # ---------------------------------------------------------------------------
 # Protocol constants
 # ---------------------------------------------------------------------------
@@ -40,32 +56,23 @@ from pathlib import Path
 MAGIC = b"\x52\x54"  # "RT"
 PACKET_VERSION = 1
 HEADER_SIZE = 7  # 2 magic + 1 version + 4 seq
-FRAME_SIZE = 80  # sizeof(TelemetryLogFrame)
-PACKET_SIZE = HEADER_SIZE + FRAME_SIZE  # 87 bytes
+PACKET_SIZE = HEADER_SIZE + FRAME_SIZE  # 143 bytes
 
 CONTROL_PORT = 5556
 DEFAULT_DATA_PORT = 5555
 
-# struct format for TelemetryLogFrame (little-endian):
-# uint32_t ts_ms + 19 x float
-FRAME_FMT = "<I19f"
+# UDP command channel (firmware/common/udp_command.hpp)
+CMD_MAGIC = b"\x52\x43"  # "RC"
+CMD_VERSION = 1
+CMD_FMT = "<2sBBIIff"  # magic, version, flags, seq, token, throttle, steering
+assert struct.calcsize(CMD_FMT) == 20
+
+# TelemetryLogFrame layout (FRAME_SIZE, FRAME_FMT, FIELD_NAMES) comes from
+# the firmware field registry, see telemetry_schema.py
 assert struct.calcsize(FRAME_FMT) == FRAME_SIZE
 
 HEADER_FMT = "<2sBIx"  # We'll parse header manually for clarity
 
-FIELD_NAMES = [
-    "ts_ms",
-    "ax", "ay", "az",
-    "gx", "gy", "gz",
-    "vx", "vy",
-    "slip_deg", "speed_ms",
-    "throttle", "steering",
-    "pitch_deg", "roll_deg", "yaw_deg",
-    "yaw_rate_dps",
-    "oversteer_active",
-    "rc_throttle", "rc_steering",
-]
-
 
 # ---------------------------------------------------------------------------
 # Decode
@@ -95,7 +102,7 @@ def send_command(esp_ip: str, command: str, timeout: float = 2.0) -> dict | None
     sock.settimeout(timeout)
     try:
         sock.sendto(command.encode(), (esp_ip, CONTROL_PORT))
-        data, _ = sock.recvfrom(512)
+        data, _ = sock.recvfrom(1024)
         return json.loads(data.decode())
     except socket.timeout:
         print(f"Timeout waiting for response from {esp_ip}:{CONTROL_PORT}", file=sys.stderr)
@@ -113,6 +120,38 @@ def cmd_start(args: argparse.Namespace) -> int:
     return 0 if resp.get("ok") else 1
 
 
+def cmd_join(args: argparse.Namespace) -> int:
+    cmd = f"JOIN {args.port}" + (f" {args.hz}" if args.hz else "")
+    resp = send_command(args.esp, cmd)
+    if resp is None:
+        return 1
+    print(json.dumps(resp, indent=2))
+    return 0 if resp.get("ok") else 1
+
+
+def cmd_leave(args: argparse.Namespace) -> int:
+    resp = send_command(args.esp, f"LEAVE {args.port}")
+    if resp is None:
+        return 1
+    print(json.dumps(resp, indent=2))
+    return 0 if resp.get("ok") else 1
+
+
+def cmd_mcast(args: argparse.Namespace) -> int:
+    if args.off:
+        cmd = "MCAST OFF"
+    elif args.group:
+        cmd = f"MCAST {args.group} {args.port}" + (f" {args.hz}" if args.hz else "")
+    else:
+        print("mcast: --group or --off required", file=sys.stderr)
+        return 2
+    resp = send_command(args.esp, cmd)
+    if resp is None:
+        return 1
+    print(json.dumps(resp, indent=2))
+    return 0 if resp.get("ok") else 1
+
+
 def cmd_stop(args: argparse.Namespace) -> int:
     resp = send_command(args.esp, "STOP")
     if resp is None:
@@ -139,13 +178,55 @@ def cmd_ping(args: argparse.Namespace) -> int:
     return 0
 
 
+def cmd_drive(args: argparse.Namespace) -> int:
+    """Send throttle/steering over the UDP command channel, then neutral."""
+    info = send_command(args.esp, "CMDINFO")
+    if info is None or not info.get("ok"):
+        print(f"CMDINFO failed: {info}", file=sys.stderr)
+        return 1
+    port, token = info["port"], info["token"]
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    period = 1.0 / args.hz
+    seq = 0
+
+    def send(throttle: float, steering: float) -> None:
+        nonlocal seq
+        seq = (seq + 1) & 0xFFFFFFFF
+        pkt = struct.pack(CMD_FMT, CMD_MAGIC, CMD_VERSION, 0, seq, token,
+                          throttle, steering)
+        for _ in range(args.dup):
+            sock.sendto(pkt, (args.esp, port))
+
+    print(f"Driving {args.esp}:{port} throttle={args.throttle} "
+          f"steering={args.steering} @ {args.hz} Hz x{args.dup}")
+    try:
+        deadline = time.monotonic() + args.seconds
+        next_t = time.monotonic()
+        while time.monotonic() < deadline:
+            send(args.throttle, args.steering)
+            next_t += period
+            time.sleep(max(0.0, next_t - time.monotonic()))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        for _ in range(5):
+            send(0.0, 0.0)
+            time.sleep(period)
+        sock.close()
+    print(f"Sent {seq} commands")
+    return 0
+
+
 # ---------------------------------------------------------------------------
 # Listen / Record
 # ---------------------------------------------------------------------------
 
 class Receiver:
-    def __init__(self, port: int, csv_path: str | None, quiet: bool = False):
+    def __init__(self, port: int, csv_path: str | None, quiet: bool = False,
+                 group: str | None = None):
         self.port = port
+        self.group = group
         self.csv_path = csv_path
         self.quiet = quiet
         self.count = 0
@@ -163,6 +244,10 @@ class Receiver:
         sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
         sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
         sock.bind(("0.0.0.0", self.port))
+        if self.group:
+            mreq = struct.pack("4s4s", socket.inet_aton(self.group),
+                               socket.inet_aton("0.0.0.0"))
+            sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, mreq)
         sock.settimeout(1.0)  # allow periodic check of _running
 
         if self.csv_path:
@@ -172,6 +257,7 @@ class Receiver:
 
         self.start_time = time.monotonic()
         print(f"Listening on UDP :{self.port}" +
+              (f" (group {self.group})" if self.group else "") +
               (f", writing to {self.csv_path}" if self.csv_path else ""))
 
         try:
@@ -239,7 +325,7 @@ class Receiver:
 
 
 def cmd_listen(args: argparse.Namespace) -> int:
-    receiver = Receiver(args.port, args.csv, args.quiet)
+    receiver = Receiver(args.port, args.csv, args.quiet, args.group)
     signal.signal(signal.SIGINT, lambda *_: receiver.stop())
     receiver.run()
     return 0
@@ -301,6 +387,7 @@ def main():
     p.add_argument("--port", type=int, default=DEFAULT_DATA_PORT, help="UDP data port (default: 5555)")
     p.add_argument("--csv", default=None, help="Output CSV file (optional)")
     p.add_argument("--quiet", "-q", action="store_true", help="Suppress progress output")
+    p.add_argument("--group", default=None, help="Join multicast group (e.g. 239.1.2.3)")
     p.set_defaults(func=cmd_listen)
 
     # start
@@ -310,6 +397,30 @@ def main():
     p.add_argument("--hz", type=int, default=100, choices=[10, 20, 50, 100])
     p.set_defaults(func=cmd_start)
 
+    # join
+    p = sub.add_parser("join", help="Add this host as a receiver (others keep streaming)")
+    p.add_argument("--esp", required=True, help="ESP32 IP address")
+    p.add_argument("--port", type=int, default=DEFAULT_DATA_PORT, help="UDP data port")
+    p.add_argument("--hz", type=int, default=0, choices=[0, 10, 20, 50, 100],
+                   help="Stream rate for all receivers (default: keep current)")
+    p.set_defaults(func=cmd_join)
+
+    # leave
+    p = sub.add_parser("leave", help="Remove this host from the receivers")
+    p.add_argument("--esp", required=True, help="ESP32 IP address")
+    p.add_argument("--port", type=int, default=DEFAULT_DATA_PORT, help="UDP data port")
+    p.set_defaults(func=cmd_leave)
+
+    # mcast
+    p = sub.add_parser("mcast", help="Set or clear the multicast group")
+    p.add_argument("--esp", required=True, help="ESP32 IP address")
+    p.add_argument("--group", default=None, help="Group address (224.0.0.0/4)")
+    p.add_argument("--port", type=int, default=DEFAULT_DATA_PORT, help="UDP data port")
+    p.add_argument("--hz", type=int, default=0, choices=[0, 10, 20, 50, 100],
+                   help="Stream rate for all receivers (default: keep current)")
+    p.add_argument("--off", action="store_true", help="Remove the group")
+    p.set_defaults(func=cmd_mcast)
+
     # stop
     p = sub.add_parser("stop", help="Send STOP command to ESP32")
     p.add_argument("--esp", required=True, help="ESP32 IP address")
@@ -325,6 +436,16 @@ def main():
     p.add_argument("--esp", required=True, help="ESP32 IP address")
     p.set_defaults(func=cmd_ping)
 
+    # drive
+    p = sub.add_parser("drive", help="Send throttle/steering over the UDP command channel")
+    p.add_argument("--esp", required=True, help="ESP32 IP address")
+    p.add_argument("--throttle", type=float, default=0.0, help="Throttle [-1..1]")
+    p.add_argument("--steering", type=float, default=0.0, help="Steering [-1..1]")
+    p.add_argument("--seconds", type=float, default=2.0, help="Duration (default: 2)")
+    p.add_argument("--hz", type=int, default=50, help="Command rate (default: 50)")
+    p.add_argument("--dup", type=int, default=1, help="Copies of each datagram (default: 1)")
+    p.set_defaults(func=cmd_drive)
+
     args = parser.parse_args()
     sys.exit(args.func(args))
 